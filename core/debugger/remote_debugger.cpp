@@ -39,6 +39,7 @@
 #include "core/io/resource_loader.h"
 #include "core/math/expression.h"
 #include "core/object/script_language.h"
+#include "core/os/heap_profiler.h"
 #include "core/os/os.h"
 #include "servers/display_server.h"
 
@@ -94,6 +95,20 @@ public:
 	}
 };
 
+// Samples heap allocations while enabled, snapshots are requested with "memory:snapshot".
+class RemoteDebugger::MemoryProfiler : public EngineProfiler {
+public:
+	void toggle(bool p_enable, const Array &p_opts) {
+		uint64_t interval = HeapProfiler::DEFAULT_SAMPLE_INTERVAL;
+		if (p_opts.size() > 0 && p_opts[0].is_num() && (int64_t)p_opts[0] > 0) {
+			interval = (int64_t)p_opts[0];
+		}
+		HeapProfiler::set_sampling(p_enable, interval);
+	}
+	void add(const Array &p_data) {}
+	void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {}
+};
+
 Error RemoteDebugger::_put_msg(const String &p_message, const Array &p_data) {
 	Array msg = { p_message, Thread::get_caller_id(), p_data };
 	Error err = peer->put_message(msg);
@@ -685,6 +700,17 @@ Error RemoteDebugger::_core_capture(const String &p_cmd, const Array &p_data, bo
 	return OK;
 }
 
+Error RemoteDebugger::_memory_capture(const String &p_cmd, const Array &p_data, bool &r_captured) {
+	r_captured = true;
+	if (p_cmd == "snapshot") {
+		HeapProfiler::Snapshot snapshot = HeapProfiler::take_snapshot();
+		send_message("memory:snapshot", snapshot.serialize());
+	} else {
+		r_captured = false;
+	}
+	return OK;
+}
+
 Error RemoteDebugger::_profiler_capture(const String &p_cmd, const Array &p_data, bool &r_captured) {
 	r_captured = false;
 	ERR_FAIL_COND_V(p_data.is_empty(), ERR_INVALID_DATA);
@@ -714,6 +740,10 @@ RemoteDebugger::RemoteDebugger(Ref<RemoteDebuggerPeer> p_peer) {
 		profiler_enable("performance", true);
 	}
 
+	// Memory Profiler
+	memory_profiler.instantiate();
+	memory_profiler->bind("memory");
+
 	// Core and profiler captures.
 	Capture core_cap(this,
 			[](void *p_user, const String &p_cmd, const Array &p_data, bool &r_captured) {
@@ -725,6 +755,11 @@ RemoteDebugger::RemoteDebugger(Ref<RemoteDebuggerPeer> p_peer) {
 				return static_cast<RemoteDebugger *>(p_user)->_profiler_capture(p_cmd, p_data, r_captured);
 			});
 	register_message_capture("profiler", profiler_cap);
+	Capture memory_cap(this,
+			[](void *p_user, const String &p_cmd, const Array &p_data, bool &r_captured) {
+				return static_cast<RemoteDebugger *>(p_user)->_memory_capture(p_cmd, p_data, r_captured);
+			});
+	register_message_capture("memory", memory_cap);
 
 	// Error handlers
 	phl.printfunc = _print_handler;
@@ -50,8 +50,10 @@ private:
 	typedef DebuggerMarshalls::OutputError ErrorMessage;
 
 	class PerformanceProfiler;
+	class MemoryProfiler;
 
 	Ref<PerformanceProfiler> performance_profiler;
+	Ref<MemoryProfiler> memory_profiler;
 
 	Ref<RemoteDebuggerPeer> peer;
 
@@ -106,6 +108,7 @@ private:
 
 	Error _profiler_capture(const String &p_cmd, const Array &p_data, bool &r_captured);
 	Error _core_capture(const String &p_cmd, const Array &p_data, bool &r_captured);
+	Error _memory_capture(const String &p_cmd, const Array &p_data, bool &r_captured);
 
 	template <typename T>
 	void _bind_profiler(const String &p_name, T *p_prof);
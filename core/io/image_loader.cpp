@@ -80,6 +80,9 @@ void ImageFormatLoaderExtension::_bind_methods() {
 
 Error ImageLoader::load_image(const String &p_file, Ref<Image> p_image, Ref<FileAccess> p_custom, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
 	ERR_FAIL_COND_V_MSG(p_image.is_null(), ERR_INVALID_PARAMETER, "Can't load an image: invalid Image object.");
+	static const uint32_t memory_tag = Memory::register_tag("Textures");
+	MemoryTagScope memory_tag_scope(memory_tag);
+
 	const String file = ResourceUID::ensure_path(p_file);
 
 	Ref<FileAccess> f = p_custom;
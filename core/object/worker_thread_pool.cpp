@@ -87,53 +87,38 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 #endif
 
-	if (p_task->group) {
-		// Handling a group
-		bool do_post = false;
-
-		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
-
-			if (work_index >= p_task->group->max) {
-				break;
-			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				p_task->callable.call(work_index);
-			}
+	// Allocations of the task are attributed like those of the code that added it.
+	MemoryTagScope memory_tag_scope(p_task->memory_tag);
 
-			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
-
-			if (completed_amount == p_task->group->max) {
-				do_post = true;
-			}
-		}
+	// Tasks this one completes the dependencies of, to be queued once done with it.
+	LocalVector<Task *> ready_dependents;
 
-		if (do_post && p_task->template_userdata) {
-			memdelete(p_task->template_userdata); // This is no longer needed at this point, so get rid of it.
-		}
+	if (p_task->group) {
+		// Handling a group
+		_process_group_elements(p_task, ready_dependents);
 
-		if (do_post) {
-			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
-		}
+		bool lock_free = p_task->group->lock_free; // Also read before the increment.
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
 
 		if (finished_users == max_users) {
 			// Get rid of the group, because nobody else is using it.
-			MutexLock task_lock(task_mutex);
-			group_allocator.free(p_task->group);
+			if (lock_free) {
+				memdelete(p_task->group);
+			} else {
+				MutexLock task_lock(task_mutex);
+				group_allocator.free(p_task->group);
+			}
 		}
 
 		// For groups, tasks get rid of themselves.
 
 		task_mutex.lock();
-		task_allocator.free(p_task);
+		if (lock_free) {
+			memdelete(p_task);
+		} else {
+			task_allocator.free(p_task);
+		}
 	} else {
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
@@ -157,6 +142,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
+		_release_dependents(p_task->dependents, ready_dependents);
 	}
 
 #ifdef THREADS_ENABLED
@@ -178,6 +164,52 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	if (!ready_dependents.is_empty()) {
+		_post_ready_dependents(ready_dependents);
+	}
+}
+
+void WorkerThreadPool::_process_group_elements(Task *p_task, LocalVector<Task *> &r_ready_dependents) {
+	Group *group = p_task->group;
+	// Empty groups only get a task when they have dependencies, and it has to complete them.
+	bool do_post = group->max == 0;
+
+	while (true) {
+		uint32_t work_index = group->index.postincrement();
+
+		if (work_index >= group->max) {
+			break;
+		}
+		if (p_task->native_group_func) {
+			p_task->native_group_func(p_task->native_func_userdata, work_index);
+		} else if (p_task->template_userdata) {
+			p_task->template_userdata->callback_indexed(work_index);
+		} else {
+			p_task->callable.call(work_index);
+		}
+
+		// This is the only way to ensure posting is done when all tasks are really complete.
+		uint32_t completed_amount = group->completed_index.increment();
+
+		if (completed_amount == group->max) {
+			do_post = true;
+		}
+	}
+
+	if (do_post && p_task->template_userdata) {
+		memdelete(p_task->template_userdata); // This is no longer needed at this point, so get rid of it.
+	}
+
+	if (do_post) {
+		{
+			// Under the lock, so no dependents are added after they have been released.
+			MutexLock task_lock(task_mutex);
+			group->completed.set_to(true);
+			_release_dependents(group->dependents, r_ready_dependents);
+		}
+		group->done_semaphore.post();
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
@@ -185,8 +217,9 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// High priority tasks don't need the lock, as long as there are some.
+		Task *task_to_process = thread_data->pool->_take_queued_task(thread_data);
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -199,22 +232,28 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				if (!thread_data->pool->_begin_sleep()) {
+					// Posted since it was checked, or another thread stole it first.
+					break;
+				}
+
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
+				thread_data->pool->sleeping_threads.decrement();
 			}
 		}
 
-		DEV_ASSERT(task_to_process);
-		thread_data->pool->_process_task(task_to_process);
+		if (task_to_process) {
+			thread_data->pool->_process_task(task_to_process);
+		}
 	}
 }
 
@@ -241,14 +280,23 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// Pool threads queue their own tasks, so they can run them back when waiting for them.
+	TaskQueue &queue = caller_pool_thread ? caller_pool_thread->queue : injected_queue;
+	if (p_high_priority && !caller_pool_thread) {
+		injected_queue_lock.lock();
+	}
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
-			if (!p_high_priority) {
-				low_priority_threads_used++;
+		if (p_high_priority) {
+			if (!queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
 			}
 			to_process++;
+		} else if (low_priority_threads_used < max_low_priority_threads) {
+			task_queue.add_last(&p_tasks[i]->task_elem);
+			low_priority_threads_used++;
+			to_process++;
 		} else {
 			// Too many threads using low priority, must go to queue.
 			low_priority_task_queue.add_last(&p_tasks[i]->task_elem);
@@ -256,9 +304,53 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 		}
 	}
 
+	if (p_high_priority && !caller_pool_thread) {
+		injected_queue_lock.unlock();
+	}
+
 	_notify_threads(caller_pool_thread, to_process, to_promote);
 }
 
+// Posts high priority tasks without task_mutex while there are no sleeping threads to wake up.
+void WorkerThreadPool::_post_tasks_lock_free(Task **p_tasks, uint32_t p_count) {
+	if (!lock_free_posting.is_set()) {
+		MutexLock<BinaryMutex> lock(task_mutex);
+		_post_tasks(p_tasks, p_count, true, lock);
+		return;
+	}
+
+	int caller_index = get_thread_index();
+	ThreadData *caller_pool_thread = caller_index != -1 ? &threads[caller_index] : nullptr;
+
+	// Only its own thread pushes to the queue of a pool thread, while the injected queue is
+	// shared by all others.
+	uint32_t pushed = 0;
+	if (caller_pool_thread) {
+		while (pushed < p_count && caller_pool_thread->queue.push(p_tasks[pushed])) {
+			pushed++;
+		}
+	} else {
+		injected_queue_lock.lock();
+		while (pushed < p_count && injected_queue.push(p_tasks[pushed])) {
+			pushed++;
+		}
+		injected_queue_lock.unlock();
+	}
+
+	// Pairs with the fence in _begin_sleep(): either the tasks are seen by a thread about to
+	// sleep, or that thread is counted here.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (pushed == p_count && sleeping_threads.get() == 0) {
+		return;
+	}
+
+	MutexLock<BinaryMutex> lock(task_mutex);
+	for (uint32_t i = pushed; i < p_count; i++) {
+		task_queue.add_last(&p_tasks[i]->task_elem);
+	}
+	_notify_threads(caller_pool_thread, p_count, 0);
+}
+
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
 	uint32_t to_process = p_process_count;
 	uint32_t to_promote = p_promote_count;
@@ -323,6 +415,19 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+// Called with the lock held, before waiting for a notification. Lock-free posts only take the
+// lock to wake threads up if there are sleeping ones, so the thread counts as one before
+// checking the queues a last time. Returns false, without counting it, if there are tasks.
+bool WorkerThreadPool::_begin_sleep() {
+	sleeping_threads.increment();
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_has_queued_tasks()) {
+		sleeping_threads.decrement();
+		return false;
+	}
+	return true;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -335,25 +440,112 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
-	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
+// Own queue first, since those are the most recent tasks of this thread, then the oldest
+// tasks of other threads.
+WorkerThreadPool::Task *WorkerThreadPool::_take_queued_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->queue.pop(task)) {
+		return task;
+	}
+	if (injected_queue.steal(task)) {
+		return task;
+	}
+	const uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		if (threads[(p_thread_data->index + i) % thread_count].queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_queued_tasks() const {
+	if (!injected_queue.is_empty()) {
+		return true;
+	}
+	for (const ThreadData &th : threads) {
+		if (!th.queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Returns how many of the dependencies are still to complete, which is zero if the tasks can be posted right away.
+uint32_t WorkerThreadPool::_add_dependencies(Task **p_tasks, uint32_t p_count, bool p_high_priority, Span<TaskID> p_dependencies) {
+	uint32_t pending = 0;
+	for (const TaskID &dependency : p_dependencies) {
+		LocalVector<Task *> *dependents = nullptr;
+		if (Task **taskp = tasks.getptr(dependency)) {
+			if (!(*taskp)->completed) {
+				dependents = &(*taskp)->dependents;
+			}
+		} else if (Group *group = _get_group(dependency)) {
+			if (!group->completed.is_set()) {
+				dependents = &group->dependents;
+			}
+		} else {
+			// Already waited for, so complete. Only IDs never handed out are errors.
+			if (dependency <= 0 || uint64_t(dependency) >= last_task.get()) {
+				ERR_PRINT(vformat("Invalid Task or Group ID %d given as dependency.", dependency));
+			}
+			continue;
+		}
+
+		if (dependents) {
+			for (uint32_t i = 0; i < p_count; i++) {
+				dependents->push_back(p_tasks[i]);
+			}
+			pending++;
+		}
+	}
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_tasks[i]->pending_dependencies = pending;
+		p_tasks[i]->low_priority = !p_high_priority; // Needed to post them later.
+	}
+	return pending;
+}
+
+void WorkerThreadPool::_release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready_dependents) {
+	for (Task *dependent : p_dependents) {
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			r_ready_dependents.push_back(dependent);
+		}
+	}
+	p_dependents.clear();
+}
+
+void WorkerThreadPool::_post_ready_dependents(const LocalVector<Task *> &p_ready_dependents) {
+	MutexLock<BinaryMutex> lock(task_mutex);
+	for (Task *task : p_ready_dependents) {
+		_post_tasks(&task, 1, !task->low_priority, lock);
+	}
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	// Get a free task
 	Task *task = task_allocator.alloc();
-	TaskID id = last_task++;
+	TaskID id = last_task.postincrement();
 	task->self = id;
 	task->callable = p_callable;
 	task->native_func = p_func;
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->memory_tag = Memory::get_thread_tag();
 	tasks.insert(id, task);
 
-	_post_tasks(&task, 1, p_high_priority, lock);
+	if (_add_dependencies(&task, 1, p_high_priority, p_dependencies) == 0) {
+		_post_tasks(&task, 1, p_high_priority, lock);
+	}
 
 	return id;
 }
@@ -490,7 +682,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = task_queue.first() || _has_queued_tasks() ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -508,12 +700,13 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			task_to_process = _take_queued_task(p_caller_pool_thread);
+			if (!task_to_process && p_caller_pool_thread->pool->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				task_queue.remove(task_queue.first());
 			}
 
-			if (!task_to_process) {
+			if (!task_to_process && _begin_sleep()) {
 				p_caller_pool_thread->awaited_task = p_task;
 
 				if (this == singleton) {
@@ -524,6 +717,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				p_caller_pool_thread->cond_var.wait(lock);
 
 				p_caller_pool_thread->awaited_task = nullptr;
+				sleeping_threads.decrement();
 			}
 		}
 
@@ -541,6 +735,7 @@ void WorkerThreadPool::_switch_runlevel(Runlevel p_runlevel) {
 	DEV_ASSERT(p_runlevel > runlevel);
 	runlevel = p_runlevel;
 	memset(&runlevel_data, 0, sizeof(runlevel_data));
+	lock_free_posting.clear();
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].cond_var.notify_one();
 		threads[i].signaled = true;
@@ -556,7 +751,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_queued_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -619,21 +814,70 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+// Must be called with the lock held, unless the group was added lock-free.
+WorkerThreadPool::Group *WorkerThreadPool::_get_group(GroupID p_group) const {
+	Group *group = lock_free_groups[uint64_t(p_group) % LOCK_FREE_GROUP_SLOTS].load(std::memory_order_acquire);
+	if (group && group->self == p_group) {
+		return group;
+	}
+	Group *const *groupp = groups.getptr(p_group);
+	return groupp ? *groupp : nullptr;
+}
+
+// Returns INVALID_TASK_ID if the slot for the group is taken, for it to be added with the lock.
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task_lock_free(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, const String &p_description) {
+	GroupID id = last_task.postincrement();
+	Group *group = memnew(Group);
+	group->self = id;
+	group->max = p_elements;
+	group->tasks_used = p_tasks;
+	group->lock_free = true;
+
+	Group *expected = nullptr;
+	if (!lock_free_groups[uint64_t(id) % LOCK_FREE_GROUP_SLOTS].compare_exchange_strong(expected, group, std::memory_order_acq_rel)) {
+		memdelete(group);
+		return INVALID_TASK_ID;
+	}
+
+	Task **tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
+	for (int i = 0; i < p_tasks; i++) {
+		Task *task = memnew(Task);
+		task->native_group_func = p_func;
+		task->native_func_userdata = p_userdata;
+		task->description = p_description;
+		task->group = group;
+		task->callable = p_callable;
+		task->template_userdata = p_template_userdata;
+		task->memory_tag = Memory::get_thread_tag();
+		tasks_posted[i] = task;
+	}
+
+	_post_tasks_lock_free(tasks_posted, p_tasks);
+	return id;
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
 	}
 
+	if (p_high_priority && p_elements > 0 && p_dependencies.is_empty() && !threads.is_empty()) {
+		GroupID id = _add_group_task_lock_free(p_callable, p_func, p_userdata, p_template_userdata, p_elements, p_tasks, p_description);
+		if (id != INVALID_TASK_ID) {
+			return id;
+		}
+	}
+
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	Group *group = group_allocator.alloc();
-	GroupID id = last_task++;
+	GroupID id = last_task.postincrement();
 	group->max = p_elements;
 	group->self = id;
 
 	Task **tasks_posted = nullptr;
-	if (p_elements == 0) {
+	if (p_elements == 0 && p_dependencies.is_empty()) {
 		// Should really not call it with zero Elements, but at least it should work.
 		group->completed.set_to(true);
 		group->done_semaphore.post();
@@ -644,6 +888,9 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		}
 
 	} else {
+		if (p_elements == 0) {
+			p_tasks = 1; // Still completes the group, but only after its dependencies.
+		}
 		group->tasks_used = p_tasks;
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
 		for (int i = 0; i < p_tasks; i++) {
@@ -654,6 +901,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->memory_tag = Memory::get_thread_tag();
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
@@ -661,13 +909,15 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock);
+	if (_add_dependencies(tasks_posted, p_tasks, p_high_priority, p_dependencies) == 0) {
+		_post_tasks(tasks_posted, p_tasks, p_high_priority, lock);
+	}
 
 	return id;
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
-	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description);
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 }
 
 WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
@@ -676,33 +926,32 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
-	const Group *const *groupp = groups.getptr(p_group);
-	if (!groupp) {
+	const Group *group = _get_group(p_group);
+	if (!group) {
 		ERR_FAIL_V_MSG(0, "Invalid Group ID");
 	}
-	return (*groupp)->completed_index.get();
+	return group->completed_index.get();
 }
 bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
-	const Group *const *groupp = groups.getptr(p_group);
-	if (!groupp) {
+	const Group *group = _get_group(p_group);
+	if (!group) {
 		ERR_FAIL_V_MSG(false, "Invalid Group ID");
 	}
-	return (*groupp)->completed.is_set();
+	return group->completed.is_set();
 }
 
 void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #ifdef THREADS_ENABLED
 	task_mutex.lock();
-	Group **groupp = groups.getptr(p_group);
+	Group *group = _get_group(p_group);
 	task_mutex.unlock();
-	if (!groupp) {
+	if (!group) {
 		ERR_FAIL_MSG("Invalid Group ID.");
 	}
 
+	bool lock_free = group->lock_free;
 	{
-		Group *group = *groupp;
-
 		if (this == singleton) {
 			_unlock_unlockable_mutexes();
 		}
@@ -711,21 +960,91 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			_lock_unlockable_mutexes();
 		}
 
+		if (lock_free) {
+			// Unregistered before it may be freed, so it's never found freed in its slot.
+			lock_free_groups[uint64_t(p_group) % LOCK_FREE_GROUP_SLOTS].store(nullptr, std::memory_order_release);
+		}
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
 		if (finished_users == max_users) {
 			// All tasks using this group are gone (finished before the group), so clear the group too.
-			MutexLock task_lock(task_mutex);
-			group_allocator.free(group);
+			if (lock_free) {
+				memdelete(group);
+			} else {
+				MutexLock task_lock(task_mutex);
+				group_allocator.free(group);
+			}
 		}
 	}
 
-	MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
+	if (!lock_free) {
+		MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+		groups.erase(p_group);
+	}
 #endif
 }
 
+uint32_t WorkerThreadPool::_get_grain_size(uint32_t p_elements) const {
+	// A few chunks per thread, so those done early can take over from those that are slower,
+	// without elements being handed out one by one.
+	uint32_t chunks = (threads.size() + 1) * PARALLEL_FOR_CHUNKS_PER_THREAD;
+	return MAX(1u, (p_elements + chunks - 1) / chunks);
+}
+
+void WorkerThreadPool::_parallel_for(BaseTemplateUserdata *p_template_userdata, uint32_t p_chunks, const String &p_description) {
+	uint32_t helper_count = MIN(p_chunks - 1, threads.size());
+	if (helper_count == 0) {
+		for (uint32_t i = 0; i < p_chunks; i++) {
+			p_template_userdata->callback_indexed(i);
+		}
+		memdelete(p_template_userdata);
+		return;
+	}
+
+	// Works like a group task added lock-free that the calling thread waits for, except that it
+	// isn't registered, since nobody else can refer to it, and the calling thread takes chunks as well.
+	Group *group = memnew(Group);
+	group->max = p_chunks;
+	group->tasks_used = helper_count;
+	group->lock_free = true;
+
+	Task **tasks_posted = (Task **)alloca(sizeof(Task *) * (helper_count + 1));
+	for (uint32_t i = 0; i < helper_count + 1; i++) {
+		Task *task = memnew(Task);
+		task->description = p_description;
+		task->group = group;
+		task->template_userdata = p_template_userdata;
+		task->memory_tag = Memory::get_thread_tag();
+		tasks_posted[i] = task;
+	}
+	Task *caller_task = tasks_posted[helper_count];
+
+	_post_tasks_lock_free(tasks_posted, helper_count);
+
+	LocalVector<Task *> ready_dependents;
+	_process_group_elements(caller_task, ready_dependents);
+	DEV_ASSERT(ready_dependents.is_empty());
+
+	// Only the chunks already being processed by other threads are left at this point.
+	if (this == singleton) {
+		_unlock_unlockable_mutexes();
+	}
+	group->done_semaphore.wait();
+	if (this == singleton) {
+		_lock_unlockable_mutexes();
+	}
+
+	uint32_t max_users = group->tasks_used + 1; // Add 1 because the calling thread is also a user.
+	uint32_t finished_users = group->finished.increment();
+
+	if (finished_users == max_users) {
+		memdelete(group);
+	}
+	memdelete(caller_task);
+}
+
 int WorkerThreadPool::get_thread_index() const {
 	Thread::ID tid = Thread::get_caller_id();
 	return thread_ids.has(tid) ? thread_ids[tid] : -1;
@@ -800,6 +1119,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i], settings);
 		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
+	lock_free_posting.set();
 }
 
 void WorkerThreadPool::exit_languages_threads() {
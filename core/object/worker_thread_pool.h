@@ -34,11 +34,14 @@
 #include "core/os/memory.h"
 #include "core/os/os.h"
 #include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/span.h"
+#include "core/templates/work_stealing_queue.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -68,6 +71,8 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		LocalVector<Task *> dependents; // Queued when the group completes.
+		bool lock_free = false; // It and its tasks come from memnew rather than the paged allocators, which need task_mutex.
 	};
 
 	struct Task {
@@ -87,6 +92,9 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t memory_tag = 0; // Of the thread that added it, see Memory::push_tag().
+		uint32_t pending_dependencies = 0; // Queued when it drops to zero.
+		LocalVector<Task *> dependents; // Queued when the task completes.
 
 		void free_template_userdata();
 		Task() :
@@ -97,12 +105,32 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t TASK_QUEUE_CAPACITY = 1024;
+	static const uint32_t PARALLEL_FOR_CHUNKS_PER_THREAD = 4;
+	static const uint32_t LOCK_FREE_GROUP_SLOTS = 256;
+
+	// High priority tasks, single or in groups, are queued in work-stealing queues, which
+	// threads take from without locking. High priority groups without dependencies are also
+	// added without task_mutex: they are registered in lock_free_groups and pushed directly,
+	// and the lock is only taken to wake sleeping threads up or if a queue is full. Other
+	// tasks and groups still take it to be allocated and registered.
+	// Low priority tasks go through the locked queues, since the number of threads running
+	// them is capped, and counted under task_mutex.
+	typedef WorkStealingQueue<Task *, TASK_QUEUE_CAPACITY> TaskQueue;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
+	SelfList<Task>::List task_queue; // Also takes high priority tasks that don't fit in a TaskQueue.
+	TaskQueue injected_queue; // High priority tasks posted by other than pool threads.
+	SpinLock injected_queue_lock; // Unlike pool thread queues, this one has several pushers.
+
+	// Groups added without task_mutex, by ID modulo the slot count. A group whose slot is
+	// still taken is added the usual way instead.
+	std::atomic<Group *> lock_free_groups[LOCK_FREE_GROUP_SLOTS] = {};
+	SafeFlag lock_free_posting; // Cleared once exiting, so posts go through _post_tasks().
+	SafeNumeric<uint32_t> sleeping_threads; // Waiting for a notification, or about to.
 
 	BinaryMutex task_mutex;
 
@@ -119,6 +147,7 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		TaskQueue queue; // High priority tasks posted by this thread.
 
 		ThreadData() :
 				signaled(false),
@@ -164,19 +193,29 @@ private:
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
 
-	uint64_t last_task = 1;
+	SafeNumeric<uint64_t> last_task{ 1 };
 
 	static HashMap<StringName, WorkerThreadPool *> named_pools;
 
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
+	void _process_group_elements(Task *p_task, LocalVector<Task *> &r_ready_dependents);
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock);
+	void _post_tasks_lock_free(Task **p_tasks, uint32_t p_count);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
+	bool _begin_sleep();
 
 	bool _try_promote_low_priority_task();
 
+	Task *_take_queued_task(ThreadData *p_thread_data);
+	bool _has_queued_tasks() const;
+
+	uint32_t _add_dependencies(Task **p_tasks, uint32_t p_count, bool p_high_priority, Span<TaskID> p_dependencies);
+	void _release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready_dependents);
+	void _post_ready_dependents(const LocalVector<Task *> &p_ready_dependents);
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -188,8 +227,13 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies = Span<TaskID>());
+	Group *_get_group(GroupID p_group) const;
+	GroupID _add_group_task_lock_free(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, const String &p_description);
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies = Span<TaskID>());
+
+	uint32_t _get_grain_size(uint32_t p_elements) const;
+	void _parallel_for(BaseTemplateUserdata *p_template_userdata, uint32_t p_chunks, const String &p_description);
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -211,6 +255,22 @@ private:
 		}
 	};
 
+	template <typename C, typename M, typename U>
+	struct ParallelForUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		uint32_t elements = 0;
+		uint32_t grain_size = 0;
+		virtual void callback_indexed(uint32_t p_chunk) override {
+			uint32_t from = p_chunk * grain_size;
+			uint32_t to = from + MIN(grain_size, elements - from);
+			for (uint32_t i = from; i < to; i++) {
+				(instance->*method)(i, userdata);
+			}
+		}
+	};
+
 	void _wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task);
 
 	void _switch_runlevel(Runlevel p_runlevel);
@@ -227,16 +287,21 @@ protected:
 	static void _bind_methods();
 
 public:
+	// Tasks and groups can be given dependencies, which are IDs of other tasks or groups. They are only
+	// queued once all of them are complete, so stages of work can be chained without waiting in between.
+	// Every task and group still has to be waited for at some point, dependencies included. Depending on
+	// one that was already waited for is fine, it counts as complete.
+
 	template <typename C, typename M, typename U>
-	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>()) {
 		typedef TaskUserData<C, M, U> TUD;
 		TUD *ud = memnew(TUD);
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description);
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies);
 	}
-	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
 	bool is_task_completed(TaskID p_task_id) const;
@@ -246,20 +311,43 @@ public:
 	void notify_yield_over(TaskID p_task_id);
 
 	template <typename C, typename M, typename U>
-	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>()) {
 		typedef GroupUserData<C, M, U> GroupUD;
 		GroupUD *ud = memnew(GroupUD);
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description);
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 	}
-	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// Calls the method for every element and returns once all are done. The calling thread takes part,
+	// and elements are handed out in chunks of the grain size, which is derived from the element and thread
+	// counts if zero. Pass a larger one for elements too cheap to be worth handing out in small numbers.
+	template <typename C, typename M, typename U>
+	void parallel_for(C *p_instance, M p_method, U p_userdata, uint32_t p_elements, uint32_t p_grain_size = 0, const String &p_description = String()) {
+		uint32_t grain_size = p_grain_size ? p_grain_size : _get_grain_size(p_elements);
+		if (p_elements <= grain_size) {
+			// A single chunk, not worth involving other threads.
+			for (uint32_t i = 0; i < p_elements; i++) {
+				(p_instance->*p_method)(i, p_userdata);
+			}
+			return;
+		}
+		typedef ParallelForUserData<C, M, U> ParallelForUD;
+		ParallelForUD *ud = memnew(ParallelForUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		ud->elements = p_elements;
+		ud->grain_size = grain_size;
+		_parallel_for(ud, (p_elements - 1) / grain_size + 1, p_description);
+	}
+
 	_FORCE_INLINE_ int get_thread_count() const {
 #ifdef THREADS_ENABLED
 		return threads.size();
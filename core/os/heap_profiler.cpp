@@ -0,0 +1,349 @@
+/**************************************************************************/
+/*  heap_profiler.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "heap_profiler.h"
+
+#include "core/os/os.h"
+#include "core/os/spin_lock.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/array.h"
+
+#include <cstdlib>
+#include <cstring>
+
+SafeFlag HeapProfiler::sampling;
+
+// Samples are kept in an open addressing table keyed by block, allocated with malloc and
+// never freed, so recording them doesn't allocate through Memory itself.
+static constexpr uint32_t TABLE_SIZE = HeapProfiler::MAX_SAMPLES * 2;
+static constexpr uint32_t TABLE_MASK = TABLE_SIZE - 1;
+
+struct SampleSlot {
+	void *ptr;
+	HeapProfiler::Sample sample;
+};
+
+static SampleSlot *slots = nullptr;
+static uint32_t sample_count = 0;
+static uint64_t dropped_count = 0;
+static SpinLock table_lock;
+
+static SafeNumeric<uint64_t> sample_interval(HeapProfiler::DEFAULT_SAMPLE_INTERVAL);
+
+static thread_local int64_t bytes_until_sample = 0;
+static thread_local uint32_t interval_seed = 0;
+
+_FORCE_INLINE_ static uint32_t _get_slot(const void *p_ptr) {
+	return hash_one_uint64((uint64_t)(uintptr_t)p_ptr) & TABLE_MASK;
+}
+
+// Must be called with the lock held.
+static bool _insert_sample(void *p_ptr, const HeapProfiler::Sample &p_sample) {
+	if (!slots || !HeapProfiler::is_sampling()) {
+		return false;
+	}
+	if (sample_count == HeapProfiler::MAX_SAMPLES) {
+		dropped_count++;
+		return false;
+	}
+
+	uint32_t idx = _get_slot(p_ptr);
+	while (slots[idx].ptr) {
+		idx = (idx + 1) & TABLE_MASK;
+	}
+	slots[idx].ptr = p_ptr;
+	slots[idx].sample = p_sample;
+	sample_count++;
+	return true;
+}
+
+void HeapProfiler::set_sampling(bool p_enabled, uint64_t p_interval) {
+#ifndef MEMORY_USAGE_ENABLED
+	ERR_FAIL_COND_MSG(p_enabled, "Heap profiling requires a build tracking memory usage, either a debug build or one with small_allocator=yes.");
+#endif
+	ERR_FAIL_COND(p_interval == 0);
+
+	table_lock.lock();
+	if (p_enabled && !slots) {
+		slots = (SampleSlot *)malloc(sizeof(SampleSlot) * TABLE_SIZE);
+	}
+	if (slots) {
+		// Blocks sampled before are still marked as such, but are no longer found once freed.
+		memset((void *)slots, 0, sizeof(SampleSlot) * TABLE_SIZE);
+	}
+	sample_count = 0;
+	dropped_count = 0;
+	sample_interval.set(p_interval);
+	sampling.set_to(p_enabled && slots);
+	table_lock.unlock();
+}
+
+bool HeapProfiler::should_sample(uint64_t p_bytes) {
+	bytes_until_sample -= (int64_t)p_bytes;
+	if (likely(bytes_until_sample > 0)) {
+		return false;
+	}
+
+	// Randomized so allocations repeating at the interval aren't always (or never) sampled.
+	uint32_t seed = interval_seed ? interval_seed : (uint32_t)(uintptr_t)&interval_seed | 1;
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	interval_seed = seed;
+
+	const uint64_t interval = sample_interval.get();
+	bytes_until_sample = (int64_t)(interval / 2 + seed % interval);
+	return true;
+}
+
+bool HeapProfiler::add_sample(void *p_ptr, uint64_t p_bytes) {
+	Sample sample;
+	sample.bytes = p_bytes;
+	sample.weight = MAX(p_bytes, sample_interval.get());
+
+	uint32_t tags[MAX_STACK_DEPTH];
+	sample.depth = Memory::get_thread_tag_stack(tags, MAX_STACK_DEPTH);
+	for (uint32_t i = 0; i < sample.depth; i++) {
+		sample.tags[i] = tags[i];
+	}
+
+	table_lock.lock();
+	const bool inserted = _insert_sample(p_ptr, sample);
+	table_lock.unlock();
+	return inserted;
+}
+
+bool HeapProfiler::restore_sample(void *p_ptr, const Sample &p_sample) {
+	Sample sample = p_sample;
+	sample.weight = MAX(sample.weight, sample.bytes);
+
+	table_lock.lock();
+	const bool inserted = _insert_sample(p_ptr, sample);
+	table_lock.unlock();
+	return inserted;
+}
+
+bool HeapProfiler::remove_sample(void *p_ptr, Sample *r_sample) {
+	table_lock.lock();
+	if (!slots) {
+		table_lock.unlock();
+		return false;
+	}
+
+	uint32_t idx = _get_slot(p_ptr);
+	while (slots[idx].ptr != p_ptr) {
+		if (!slots[idx].ptr) {
+			table_lock.unlock();
+			return false;
+		}
+		idx = (idx + 1) & TABLE_MASK;
+	}
+	if (r_sample) {
+		*r_sample = slots[idx].sample;
+	}
+
+	// Shift back the following entries which would no longer be reachable.
+	uint32_t next = idx;
+	while (true) {
+		next = (next + 1) & TABLE_MASK;
+		if (!slots[next].ptr) {
+			break;
+		}
+		const uint32_t home = _get_slot(slots[next].ptr);
+		if (((next - home) & TABLE_MASK) >= ((next - idx) & TABLE_MASK)) {
+			slots[idx] = slots[next];
+			idx = next;
+		}
+	}
+	slots[idx].ptr = nullptr;
+	sample_count--;
+
+	table_lock.unlock();
+	return true;
+}
+
+HeapProfiler::Snapshot HeapProfiler::take_snapshot() {
+	Snapshot snapshot;
+	snapshot.ticks_usec = OS::get_singleton()->get_ticks_usec();
+	snapshot.sample_interval = sample_interval.get();
+	snapshot.usage = Memory::get_mem_usage();
+
+	for (uint32_t i = 0; i < Memory::get_tag_count(); i++) {
+		const uint64_t bytes = Memory::get_tag_usage(i);
+		if (bytes) {
+			Snapshot::Entry entry;
+			entry.name = Memory::get_tag_name(i);
+			entry.bytes = bytes;
+			snapshot.tags.push_back(entry);
+		}
+	}
+
+	// Reserved beforehand, so nothing is allocated with the lock held.
+	LocalVector<Sample> samples;
+	samples.reserve(MAX_SAMPLES);
+
+	table_lock.lock();
+	if (slots) {
+		for (uint32_t i = 0; i < TABLE_SIZE; i++) {
+			if (slots[i].ptr) {
+				samples.push_back(slots[i].sample);
+			}
+		}
+	}
+	snapshot.dropped = dropped_count;
+	table_lock.unlock();
+
+	// Tags are below 255, so a stack fits in a 64 bit key with one byte per tag.
+	static_assert(Memory::MAX_TAGS < 255 && MAX_STACK_DEPTH <= 8);
+	HashMap<uint64_t, int> site_indices;
+	for (const Sample &sample : samples) {
+		uint64_t key = 0;
+		for (uint32_t i = 0; i < sample.depth; i++) {
+			key = (key << 8) | (sample.tags[i] + 1);
+		}
+
+		HashMap<uint64_t, int>::Iterator E = site_indices.find(key);
+		if (!E) {
+			Snapshot::Entry entry;
+			if (sample.depth == 0) {
+				entry.name = Memory::get_tag_name(0);
+			}
+			for (uint32_t i = 0; i < sample.depth; i++) {
+				if (i > 0) {
+					entry.name += " > ";
+				}
+				entry.name += Memory::get_tag_name(sample.tags[i]);
+			}
+			snapshot.sites.push_back(entry);
+			E = site_indices.insert(key, snapshot.sites.size() - 1);
+		}
+
+		Snapshot::Entry &entry = snapshot.sites.write[E->value];
+		entry.bytes += sample.weight;
+		entry.count++;
+		snapshot.sampled += sample.weight;
+	}
+
+	return snapshot;
+}
+
+static void _diff_entries(const Vector<HeapProfiler::Snapshot::Entry> &p_from, const Vector<HeapProfiler::Snapshot::Entry> &p_to, Vector<HeapProfiler::Snapshot::Entry> &r_diff) {
+	HashMap<String, int> from_indices;
+	for (int i = 0; i < p_from.size(); i++) {
+		from_indices.insert(p_from[i].name, i);
+	}
+
+	for (const HeapProfiler::Snapshot::Entry &to : p_to) {
+		HeapProfiler::Snapshot::Entry entry = to;
+		HashMap<String, int>::Iterator E = from_indices.find(to.name);
+		if (E) {
+			entry.bytes -= p_from[E->value].bytes;
+			entry.count -= p_from[E->value].count;
+			from_indices.remove(E);
+		}
+		if (entry.bytes || entry.count) {
+			r_diff.push_back(entry);
+		}
+	}
+
+	// What is left was freed entirely.
+	for (const KeyValue<String, int> &E : from_indices) {
+		HeapProfiler::Snapshot::Entry entry = p_from[E.value];
+		entry.bytes = -entry.bytes;
+		entry.count = -entry.count;
+		r_diff.push_back(entry);
+	}
+}
+
+HeapProfiler::Snapshot HeapProfiler::Snapshot::diff(const Snapshot &p_base) const {
+	Snapshot result;
+	result.ticks_usec = ticks_usec;
+	result.sample_interval = sample_interval;
+	result.usage = usage - p_base.usage;
+	result.sampled = sampled - p_base.sampled;
+	result.dropped = dropped - p_base.dropped;
+	_diff_entries(p_base.tags, tags, result.tags);
+	_diff_entries(p_base.sites, sites, result.sites);
+	return result;
+}
+
+#define CHECK_SIZE(arr, expected, what) ERR_FAIL_COND_V_MSG((uint32_t)arr.size() < (uint32_t)(expected), false, String("Malformed ") + what + " message from script debugger, message too short. Expected size: " + itos(expected) + ", actual size: " + itos(arr.size()))
+#define CHECK_END(arr, expected, what) ERR_FAIL_COND_V_MSG((uint32_t)arr.size() > (uint32_t)expected, false, String("Malformed ") + what + " message from script debugger, message too long. Expected size: " + itos(expected) + ", actual size: " + itos(arr.size()))
+
+Array HeapProfiler::Snapshot::serialize() {
+	Array arr = { ticks_usec, sample_interval, usage, sampled, dropped, tags.size() * 3 };
+	for (const Entry &E : tags) {
+		arr.push_back(E.name);
+		arr.push_back(E.bytes);
+		arr.push_back(E.count);
+	}
+	arr.push_back(sites.size() * 3);
+	for (const Entry &E : sites) {
+		arr.push_back(E.name);
+		arr.push_back(E.bytes);
+		arr.push_back(E.count);
+	}
+	return arr;
+}
+
+static bool _deserialize_entries(const Array &p_arr, uint32_t &r_idx, Vector<HeapProfiler::Snapshot::Entry> &r_entries) {
+	CHECK_SIZE(p_arr, r_idx + 1, "HeapSnapshot");
+	uint32_t size = p_arr[r_idx];
+	ERR_FAIL_COND_V(size % 3, false);
+	r_idx++;
+	CHECK_SIZE(p_arr, r_idx + size, "HeapSnapshot");
+	const uint32_t end = r_idx + size;
+	while (r_idx < end) {
+		HeapProfiler::Snapshot::Entry entry;
+		entry.name = p_arr[r_idx];
+		entry.bytes = p_arr[r_idx + 1];
+		entry.count = p_arr[r_idx + 2];
+		r_entries.push_back(entry);
+		r_idx += 3;
+	}
+	return true;
+}
+
+bool HeapProfiler::Snapshot::deserialize(const Array &p_arr) {
+	CHECK_SIZE(p_arr, 5, "HeapSnapshot");
+	ticks_usec = p_arr[0];
+	sample_interval = p_arr[1];
+	usage = p_arr[2];
+	sampled = p_arr[3];
+	dropped = p_arr[4];
+	uint32_t idx = 5;
+	if (!_deserialize_entries(p_arr, idx, tags) || !_deserialize_entries(p_arr, idx, sites)) {
+		return false;
+	}
+	CHECK_END(p_arr, idx, "HeapSnapshot");
+	return true;
+}
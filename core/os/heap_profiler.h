@@ -0,0 +1,99 @@
+/**************************************************************************/
+/*  heap_profiler.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/vector.h"
+
+class Array;
+
+// Samples live heap allocations to estimate where memory goes, by the memory tag stack that
+// was current when they were made (see MemoryTagScope). Roughly one allocation is sampled
+// every sample interval bytes, and stands for that many bytes in snapshots, so the overhead
+// doesn't depend on how many allocations are made.
+// Samples are recorded by Memory, which only has room to mark them in the allocation header
+// when MEMORY_USAGE_ENABLED is defined.
+class HeapProfiler {
+public:
+	static constexpr uint32_t MAX_STACK_DEPTH = 8;
+	static constexpr uint32_t MAX_SAMPLES = 8192;
+	static constexpr uint64_t DEFAULT_SAMPLE_INTERVAL = 512 * 1024;
+
+	struct Sample {
+		uint64_t bytes = 0;
+		// Bytes allocated that the sample stands for.
+		uint64_t weight = 0;
+		uint8_t depth = 0;
+		uint8_t tags[MAX_STACK_DEPTH] = {};
+	};
+
+	struct Snapshot {
+		struct Entry {
+			String name;
+			int64_t bytes = 0;
+			int64_t count = 0;
+		};
+
+		uint64_t ticks_usec = 0;
+		uint64_t sample_interval = 0;
+		int64_t usage = 0;
+		// Sum of the sites, i.e. the estimated live memory.
+		int64_t sampled = 0;
+		int64_t dropped = 0;
+		// Exact usage of each memory tag.
+		Vector<Entry> tags;
+		// Estimated usage of each tag stack, named like "Resources > GDScript".
+		Vector<Entry> sites;
+
+		// Change from `p_base` to this snapshot. Entries that didn't change are left out.
+		Snapshot diff(const Snapshot &p_base) const;
+
+		Array serialize();
+		bool deserialize(const Array &p_arr);
+	};
+
+private:
+	static SafeFlag sampling;
+
+public:
+	static void set_sampling(bool p_enabled, uint64_t p_interval = DEFAULT_SAMPLE_INTERVAL);
+	_FORCE_INLINE_ static bool is_sampling() { return sampling.is_set(); }
+
+	// Called by Memory for each allocation of `p_bytes` while sampling.
+	static bool should_sample(uint64_t p_bytes);
+	// These return whether the block is sampled, which fails when too many are.
+	static bool add_sample(void *p_ptr, uint64_t p_bytes);
+	static bool restore_sample(void *p_ptr, const Sample &p_sample);
+	static bool remove_sample(void *p_ptr, Sample *r_sample = nullptr);
+
+	static Snapshot take_snapshot();
+};
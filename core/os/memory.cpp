@@ -30,9 +30,13 @@
 
 #include "memory.h"
 
+#include "core/os/heap_profiler.h"
+#include "core/os/small_allocator.h"
+#include "core/os/spin_lock.h"
 #include "core/templates/safe_refcount.h"
 
 #include <cstdlib>
+#include <cstring>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -56,10 +60,163 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 }
 #endif
 
-#ifdef DEBUG_ENABLED
-SafeNumeric<uint64_t> Memory::mem_usage;
-SafeNumeric<uint64_t> Memory::max_usage;
+// The size stored in the allocation header shares its word with the tag, a flag marking
+// allocations sampled by the HeapProfiler, and a flag marking blocks of the small allocator.
+static constexpr uint32_t HEADER_TAG_SHIFT = 56;
+static constexpr uint64_t HEADER_SAMPLED = uint64_t(1) << (HEADER_TAG_SHIFT - 1);
+static constexpr uint64_t HEADER_SMALL = uint64_t(1) << (HEADER_TAG_SHIFT - 2);
+static constexpr uint64_t HEADER_SIZE_MASK = HEADER_SMALL - 1;
+
+struct TagStack {
+	uint32_t tags[Memory::MAX_TAG_DEPTH];
+	uint32_t depth;
+};
+
+static thread_local TagStack tag_stack;
+// Innermost tag of the stack, cached for allocations.
+static thread_local uint32_t thread_tag = 0;
+
+static const char *tag_names[Memory::MAX_TAGS] = { "Default" };
+static SafeNumeric<uint32_t> tag_count(1);
+static SpinLock tag_lock;
+
+#ifdef MEMORY_USAGE_ENABLED
+static SafeNumeric<uint64_t> mem_usage;
+static SafeNumeric<uint64_t> max_usage;
+static SafeNumeric<uint64_t> tag_usage[Memory::MAX_TAGS];
+
+// Usage is accumulated per thread and only published to the shared counters once it drifts
+// by USAGE_BATCH bytes, so threads allocating at a high rate don't contend on them. Other
+// threads' usage, including the peak, is thus only as precise as the batch size.
+static constexpr int64_t USAGE_BATCH = 64 * 1024;
+
+struct ThreadUsage {
+	int64_t total;
+	int64_t tags[Memory::MAX_TAGS];
+	bool registered;
+	bool exited;
+};
+
+static thread_local ThreadUsage thread_usage;
+
+static void _publish_usage(int64_t p_bytes, uint32_t p_tag) {
+	tag_usage[p_tag].add((uint64_t)p_bytes);
+	const uint64_t new_mem_usage = mem_usage.add((uint64_t)p_bytes);
+	if (p_bytes > 0) {
+		max_usage.exchange_if_greater(new_mem_usage);
+	}
+}
+
+static void _flush_thread_usage(ThreadUsage &r_usage) {
+	for (uint32_t i = 0; i < Memory::MAX_TAGS; i++) {
+		if (r_usage.tags[i]) {
+			tag_usage[i].add((uint64_t)r_usage.tags[i]);
+			r_usage.tags[i] = 0;
+		}
+	}
+	const uint64_t new_mem_usage = mem_usage.add((uint64_t)r_usage.total);
+	if (r_usage.total > 0) {
+		max_usage.exchange_if_greater(new_mem_usage);
+	}
+	r_usage.total = 0;
+}
+
+struct ThreadUsageRelease {
+	~ThreadUsageRelease() {
+		_flush_thread_usage(thread_usage);
+		thread_usage.exited = true;
+	}
+};
+
+static thread_local ThreadUsageRelease thread_usage_release;
+
+_FORCE_INLINE_ static void _add_usage(int64_t p_bytes, uint32_t p_tag) {
+	ThreadUsage &usage = thread_usage;
+	if (unlikely(!usage.registered)) {
+		usage.registered = true;
+		// Odr-use, so the release object is constructed and its destructor registered.
+		(void)&thread_usage_release;
+	}
+	if (unlikely(usage.exited)) {
+		_publish_usage(p_bytes, p_tag);
+		return;
+	}
+
+	usage.total += p_bytes;
+	usage.tags[p_tag] += p_bytes;
+	if (unlikely(std::abs(usage.total) >= USAGE_BATCH || std::abs(usage.tags[p_tag]) >= USAGE_BATCH)) {
+		_flush_thread_usage(usage);
+	}
+}
+
+// Shared counters plus what this thread hasn't published yet. Counters can transiently be
+// "negative" when a thread publishes frees of blocks whose allocation is still pending in
+// another thread.
+static uint64_t _get_usage(const SafeNumeric<uint64_t> &p_counter, int64_t p_pending) {
+	const int64_t usage = (int64_t)p_counter.get() + (thread_usage.exited ? 0 : p_pending);
+	return (uint64_t)MAX(usage, 0);
+}
+
+// A resized block keeps its sample, if it had one. Otherwise growing it counts towards the
+// next sample like a new allocation of the added bytes would.
+static void _resample(uint8_t *p_mem, uint64_t p_bytes, uint64_t p_prev_bytes, HeapProfiler::Sample *p_sample) {
+	bool sampled;
+	if (p_sample) {
+		p_sample->bytes = p_bytes;
+		sampled = HeapProfiler::restore_sample(p_mem, *p_sample);
+	} else {
+		sampled = unlikely(HeapProfiler::is_sampling()) && p_bytes > p_prev_bytes && HeapProfiler::should_sample(p_bytes - p_prev_bytes) && HeapProfiler::add_sample(p_mem, p_bytes);
+	}
+	if (sampled) {
+		*(uint64_t *)(p_mem + Memory::SIZE_OFFSET) |= HEADER_SAMPLED;
+	}
+}
+#endif // MEMORY_USAGE_ENABLED
+
+#ifdef SMALL_ALLOCATOR_ENABLED
+static std::atomic<bool> small_allocator_enabled(true);
+#endif
+
+// `p_bytes` includes the header. Blocks are only served by the small allocator when they
+// have a header to record it in.
+_FORCE_INLINE_ static bool _use_small_allocator(size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	return SmallAllocator::is_small(p_bytes) && small_allocator_enabled.load(std::memory_order_relaxed);
+#else
+	return false;
+#endif
+}
+
+// `p_bytes` includes the header, if any.
+template <bool p_ensure_zero>
+_FORCE_INLINE_ static void *_alloc_block(size_t p_bytes, bool p_small) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	if (p_small) {
+		void *mem = SmallAllocator::alloc(p_bytes);
+		if constexpr (p_ensure_zero) {
+			if (mem) {
+				memset(mem, 0, p_bytes);
+			}
+		}
+		return mem;
+	}
+#endif
+	if constexpr (p_ensure_zero) {
+		return calloc(1, p_bytes);
+	} else {
+		return malloc(p_bytes);
+	}
+}
+
+_FORCE_INLINE_ static void _free_block(void *p_mem, size_t p_bytes, bool p_small) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	if (p_small) {
+		SmallAllocator::free(p_mem, p_bytes);
+		return;
+	}
 #endif
+	free(p_mem);
+}
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
 	DEV_ASSERT(is_power_of_2(p_alignment));
@@ -95,18 +252,14 @@ void Memory::free_aligned_static(void *p_memory) {
 
 template <bool p_ensure_zero>
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#ifdef MEMORY_USAGE_ENABLED
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem;
-	if constexpr (p_ensure_zero) {
-		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
-	} else {
-		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
-	}
+	const bool small = prepad && _use_small_allocator(p_bytes + DATA_OFFSET);
+	void *mem = _alloc_block<p_ensure_zero>(p_bytes + (prepad ? DATA_OFFSET : 0), small);
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
@@ -114,11 +267,14 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint8_t *s8 = (uint8_t *)mem;
 
 		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
-		*s = p_bytes;
+		*s = p_bytes | (small ? HEADER_SMALL : 0) | ((uint64_t)thread_tag << HEADER_TAG_SHIFT);
 
-#ifdef DEBUG_ENABLED
-		uint64_t new_mem_usage = mem_usage.add(p_bytes);
-		max_usage.exchange_if_greater(new_mem_usage);
+#ifdef MEMORY_USAGE_ENABLED
+		_add_usage(p_bytes, thread_tag);
+
+		if (unlikely(HeapProfiler::is_sampling()) && HeapProfiler::should_sample(p_bytes) && HeapProfiler::add_sample(mem, p_bytes)) {
+			*s |= HEADER_SAMPLED;
+		}
 #endif
 		return s8 + DATA_OFFSET;
 	} else {
@@ -136,7 +292,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#ifdef MEMORY_USAGE_ENABLED
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -145,31 +301,56 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-
-#ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
-			max_usage.exchange_if_greater(new_mem_usage);
-		} else {
-			mem_usage.sub(*s - p_bytes);
-		}
+		const uint64_t prev_bytes = *s & HEADER_SIZE_MASK;
+		const bool prev_small = *s & HEADER_SMALL;
+		const uint64_t tag = *s >> HEADER_TAG_SHIFT;
+#ifdef MEMORY_USAGE_ENABLED
+		_add_usage((int64_t)p_bytes - (int64_t)prev_bytes, tag);
+
+		// Taken out before the block may be freed, so the address can't be reused meanwhile.
+		HeapProfiler::Sample sample;
+		const bool sampled = (*s & HEADER_SAMPLED) && HeapProfiler::remove_sample(mem, &sample);
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_free_block(mem, prev_bytes + DATA_OFFSET, prev_small);
 			return nullptr;
-		} else {
-			*s = p_bytes;
+		}
+
+#ifdef SMALL_ALLOCATOR_ENABLED
+		const bool small = _use_small_allocator(p_bytes + DATA_OFFSET);
+		if (prev_small || small) {
+			// Blocks of the small allocator can't grow, but may already be big enough.
+			uint8_t *new_mem = mem;
+			if (!prev_small || !small || SmallAllocator::get_block_size(prev_bytes + DATA_OFFSET) != SmallAllocator::get_block_size(p_bytes + DATA_OFFSET)) {
+				new_mem = (uint8_t *)_alloc_block<false>(p_bytes + DATA_OFFSET, small);
+				ERR_FAIL_NULL_V(new_mem, nullptr);
+
+				memcpy(new_mem, mem, MIN(prev_bytes, (uint64_t)p_bytes) + DATA_OFFSET);
+				_free_block(mem, prev_bytes + DATA_OFFSET, prev_small);
+			}
+
+			s = (uint64_t *)(new_mem + SIZE_OFFSET);
+			*s = p_bytes | (small ? HEADER_SMALL : 0) | (tag << HEADER_TAG_SHIFT);
+#ifdef MEMORY_USAGE_ENABLED
+			_resample(new_mem, p_bytes, prev_bytes, sampled ? &sample : nullptr);
+#endif
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
-			ERR_FAIL_NULL_V(mem, nullptr);
+			return new_mem + DATA_OFFSET;
+		}
+#endif
 
-			s = (uint64_t *)(mem + SIZE_OFFSET);
+		mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+		ERR_FAIL_NULL_V(mem, nullptr);
 
-			*s = p_bytes;
+		s = (uint64_t *)(mem + SIZE_OFFSET);
 
-			return mem + DATA_OFFSET;
-		}
+		*s = p_bytes | (tag << HEADER_TAG_SHIFT);
+#ifdef MEMORY_USAGE_ENABLED
+		_resample(mem, p_bytes, prev_bytes, sampled ? &sample : nullptr);
+#endif
+
+		return mem + DATA_OFFSET;
 	} else {
 		mem = (uint8_t *)realloc(mem, p_bytes);
 
@@ -184,7 +365,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#ifdef MEMORY_USAGE_ENABLED
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -193,37 +374,128 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
-#ifdef DEBUG_ENABLED
-		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		mem_usage.sub(*s);
+		const uint64_t header = *(uint64_t *)(mem + SIZE_OFFSET);
+		const uint64_t bytes = header & HEADER_SIZE_MASK;
+
+#ifdef MEMORY_USAGE_ENABLED
+		_add_usage(-(int64_t)bytes, header >> HEADER_TAG_SHIFT);
+
+		if (header & HEADER_SAMPLED) {
+			HeapProfiler::remove_sample(mem);
+		}
 #endif
 
-		free(mem);
+		_free_block(mem, bytes + DATA_OFFSET, header & HEADER_SMALL);
 	} else {
 		free(mem);
 	}
 }
 
+#ifdef SMALL_ALLOCATOR_ENABLED
+void Memory::set_small_allocator_enabled(bool p_enabled) {
+	small_allocator_enabled.store(p_enabled, std::memory_order_relaxed);
+}
+
+bool Memory::is_small_allocator_enabled() {
+	return small_allocator_enabled.load(std::memory_order_relaxed);
+}
+#endif
+
 uint64_t Memory::get_mem_available() {
 	return -1; // 0xFFFF...
 }
 
 uint64_t Memory::get_mem_usage() {
-#ifdef DEBUG_ENABLED
-	return mem_usage.get();
+#ifdef MEMORY_USAGE_ENABLED
+	return _get_usage(mem_usage, thread_usage.total);
 #else
 	return 0;
 #endif
 }
 
 uint64_t Memory::get_mem_max_usage() {
-#ifdef DEBUG_ENABLED
-	return max_usage.get();
+#ifdef MEMORY_USAGE_ENABLED
+	return MAX(max_usage.get(), get_mem_usage());
+#else
+	return 0;
+#endif
+}
+
+uint32_t Memory::register_tag(const char *p_name) {
+	ERR_FAIL_NULL_V(p_name, 0);
+
+	tag_lock.lock();
+	const uint32_t count = tag_count.get();
+	for (uint32_t i = 0; i < count; i++) {
+		if (strcmp(tag_names[i], p_name) == 0) {
+			tag_lock.unlock();
+			return i;
+		}
+	}
+	if (count == MAX_TAGS) {
+		tag_lock.unlock();
+		ERR_FAIL_V_MSG(0, "Too many memory tags registered.");
+	}
+	tag_names[count] = p_name;
+	tag_count.set(count + 1);
+	tag_lock.unlock();
+
+	return count;
+}
+
+uint32_t Memory::get_tag_count() {
+	return tag_count.get();
+}
+
+const char *Memory::get_tag_name(uint32_t p_tag) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_tag, tag_count.get(), nullptr);
+	return tag_names[p_tag];
+}
+
+uint64_t Memory::get_tag_usage(uint32_t p_tag) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_tag, MAX_TAGS, 0);
+#ifdef MEMORY_USAGE_ENABLED
+	return _get_usage(tag_usage[p_tag], thread_usage.tags[p_tag]);
 #else
 	return 0;
 #endif
 }
 
+void Memory::push_tag(uint32_t p_tag) {
+	if (unlikely(p_tag >= tag_count.get())) {
+		// Still push, so the matching pop stays balanced.
+		ERR_PRINT("Invalid memory tag.");
+		p_tag = 0;
+	}
+	TagStack &stack = tag_stack;
+	if (stack.depth < MAX_TAG_DEPTH) {
+		stack.tags[stack.depth] = p_tag;
+	}
+	stack.depth++;
+	thread_tag = p_tag;
+}
+
+void Memory::pop_tag() {
+	TagStack &stack = tag_stack;
+	ERR_FAIL_COND_MSG(stack.depth == 0, "Memory tag stack underflow.");
+	stack.depth--;
+	thread_tag = stack.depth ? stack.tags[MIN(stack.depth, MAX_TAG_DEPTH) - 1] : 0;
+}
+
+uint32_t Memory::get_thread_tag() {
+	return thread_tag;
+}
+
+uint32_t Memory::get_thread_tag_stack(uint32_t *r_tags, uint32_t p_max) {
+	const TagStack &stack = tag_stack;
+	const uint32_t stored = MIN(stack.depth, MAX_TAG_DEPTH);
+	const uint32_t count = MIN(stored, p_max);
+	for (uint32_t i = 0; i < count; i++) {
+		r_tags[i] = stack.tags[stored - count + i];
+	}
+	return count;
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
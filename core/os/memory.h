@@ -36,12 +36,13 @@
 #include <new> // IWYU pragma: keep // `new` operators.
 #include <type_traits>
 
-class Memory {
-#ifdef DEBUG_ENABLED
-	static SafeNumeric<uint64_t> mem_usage;
-	static SafeNumeric<uint64_t> max_usage;
+// Allocations always carry a header with their size when usage is tracked, which the
+// small allocator also relies on to know which size class a block is freed to.
+#if defined(DEBUG_ENABLED) || defined(SMALL_ALLOCATOR_ENABLED)
+#define MEMORY_USAGE_ENABLED
 #endif
 
+class Memory {
 public:
 	// Alignment:  ↓ max_align_t        ↓ uint64_t          ↓ max_align_t
 	//             ┌─────────────────┬──┬────────────────┬──┬───────────...
@@ -84,9 +85,45 @@ public:
 	//  free_aligned_static( data );
 	static void free_aligned_static(void *p_memory);
 
+#ifdef SMALL_ALLOCATOR_ENABLED
+	// Blocks record whether they came from the small allocator, so it can be turned off and
+	// on at any time, e.g. to compare both paths. It is on by default.
+	static void set_small_allocator_enabled(bool p_enabled);
+	static bool is_small_allocator_enabled();
+#endif
+
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+
+	// Tags attribute live memory to engine subsystems. Allocations take the tag current on
+	// their thread when made, and it is stored in the allocation header, so usage is only
+	// tracked per tag when MEMORY_USAGE_ENABLED is defined. Tag 0 is the default.
+	static constexpr uint32_t MAX_TAGS = 64;
+
+	// `p_name` is not copied and must outlive the engine, e.g. a string literal. Registering
+	// the same name again returns the existing tag.
+	static uint32_t register_tag(const char *p_name);
+	static uint32_t get_tag_count();
+	static const char *get_tag_name(uint32_t p_tag);
+	static uint64_t get_tag_usage(uint32_t p_tag);
+
+	// Each thread has a stack of tags, the innermost one being applied to allocations. Only
+	// the first MAX_TAG_DEPTH levels are kept, deeper pushes still apply until popped.
+	static constexpr uint32_t MAX_TAG_DEPTH = 32;
+
+	static void push_tag(uint32_t p_tag);
+	static void pop_tag();
+	static uint32_t get_thread_tag();
+	// Copies up to `p_max` of the innermost tags into `r_tags`, outermost first, and returns
+	// how many were copied.
+	static uint32_t get_thread_tag_stack(uint32_t *r_tags, uint32_t p_max);
+};
+
+class MemoryTagScope {
+public:
+	_FORCE_INLINE_ explicit MemoryTagScope(uint32_t p_tag) { Memory::push_tag(p_tag); }
+	_FORCE_INLINE_ ~MemoryTagScope() { Memory::pop_tag(); }
 };
 
 class DefaultAllocator {
@@ -0,0 +1,261 @@
+/**************************************************************************/
+/*  small_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_allocator.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/spin_lock.h"
+#include "core/templates/safe_refcount.h"
+
+#include <cstdlib>
+
+static constexpr uint32_t size_classes[SmallAllocator::SIZE_CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128, // Step 16.
+	160, 192, 224, 256, // Step 32.
+	320, 384, 448, 512, // Step 64.
+	640, 768, 896, 1024, // Step 128.
+};
+
+// Maps sizes, in steps of 16 bytes, to the smallest class that fits them.
+struct SizeClassIndex {
+	uint8_t index[(SmallAllocator::MAX_SIZE >> 4) + 1] = {};
+
+	constexpr SizeClassIndex() {
+		uint32_t size_class = 0;
+		for (uint32_t i = 0; i <= (SmallAllocator::MAX_SIZE >> 4); i++) {
+			while (size_classes[size_class] < i << 4) {
+				size_class++;
+			}
+			index[i] = size_class;
+		}
+	}
+};
+
+static constexpr SizeClassIndex size_class_index;
+
+_FORCE_INLINE_ static uint32_t _get_size_class(size_t p_bytes) {
+	return size_class_index.index[(p_bytes + 15) >> 4];
+}
+
+// Blocks moved between a thread cache and the central list at once: about 8 KiB worth.
+_FORCE_INLINE_ static uint32_t _get_batch_size(uint32_t p_size_class) {
+	return CLAMP(8192u / size_classes[p_size_class], 8u, 64u);
+}
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+// Spans are linked through their first bytes, which are skipped when carving blocks so
+// these keep the alignment of the span.
+static constexpr size_t SPAN_SIZE = 64 * 1024;
+static constexpr size_t SPAN_HEADER_SIZE = 16;
+
+struct CentralList {
+	SpinLock lock;
+	FreeBlock *head = nullptr;
+	uint8_t *span_pos = nullptr;
+	uint8_t *span_end = nullptr;
+};
+
+static CentralList central_lists[SmallAllocator::SIZE_CLASS_COUNT];
+static SpinLock span_lock;
+static void *spans = nullptr;
+static SafeNumeric<uint64_t> reserved_bytes;
+static SafeNumeric<uint64_t> refill_count;
+
+// Must be called with the list locked. Returns how many blocks were linked into `r_head`.
+static uint32_t _central_take(uint32_t p_size_class, uint32_t p_count, FreeBlock *&r_head) {
+	CentralList &list = central_lists[p_size_class];
+	const uint32_t block_size = size_classes[p_size_class];
+
+	uint32_t taken = 0;
+	while (taken < p_count) {
+		FreeBlock *block = list.head;
+		if (block) {
+			list.head = block->next;
+		} else {
+			if (list.span_pos + block_size > list.span_end) {
+				uint8_t *span = (uint8_t *)malloc(SPAN_SIZE);
+				if (!span) {
+					break;
+				}
+				span_lock.lock();
+				*(void **)span = spans;
+				spans = span;
+				span_lock.unlock();
+				reserved_bytes.add(SPAN_SIZE);
+
+				list.span_pos = span + SPAN_HEADER_SIZE;
+				list.span_end = span + SPAN_SIZE;
+			}
+			block = (FreeBlock *)list.span_pos;
+			list.span_pos += block_size;
+		}
+
+		block->next = r_head;
+		r_head = block;
+		taken++;
+	}
+
+	return taken;
+}
+
+// `p_tail` must end the chain starting at `p_head`.
+static void _central_give(uint32_t p_size_class, FreeBlock *p_head, FreeBlock *p_tail) {
+	CentralList &list = central_lists[p_size_class];
+	list.lock.lock();
+	p_tail->next = list.head;
+	list.head = p_head;
+	list.lock.unlock();
+}
+
+struct ThreadCache {
+	struct Bin {
+		FreeBlock *head;
+		uint32_t count;
+	};
+
+	Bin bins[SmallAllocator::SIZE_CLASS_COUNT];
+	bool registered;
+	bool exited;
+};
+
+// Trivially destructible, so it remains usable while other thread-local objects are being
+// destroyed. The release object below hands the cached blocks back when the thread exits,
+// after which the thread goes straight to the central lists.
+static thread_local ThreadCache thread_cache;
+
+struct ThreadCacheRelease {
+	~ThreadCacheRelease() {
+		for (uint32_t i = 0; i < SmallAllocator::SIZE_CLASS_COUNT; i++) {
+			ThreadCache::Bin &bin = thread_cache.bins[i];
+			if (bin.head) {
+				FreeBlock *tail = bin.head;
+				while (tail->next) {
+					tail = tail->next;
+				}
+				_central_give(i, bin.head, tail);
+			}
+			bin.head = nullptr;
+			bin.count = 0;
+		}
+		thread_cache.exited = true;
+	}
+};
+
+static thread_local ThreadCacheRelease thread_cache_release;
+
+_FORCE_INLINE_ static ThreadCache &_get_thread_cache() {
+	ThreadCache &cache = thread_cache;
+	if (unlikely(!cache.registered)) {
+		cache.registered = true;
+		// Odr-use, so the release object is constructed and its destructor registered.
+		(void)&thread_cache_release;
+	}
+	return cache;
+}
+
+void *SmallAllocator::alloc(size_t p_bytes) {
+	const uint32_t size_class = _get_size_class(p_bytes);
+	ThreadCache &cache = _get_thread_cache();
+
+	if (unlikely(cache.exited)) {
+		FreeBlock *block = nullptr;
+		central_lists[size_class].lock.lock();
+		_central_take(size_class, 1, block);
+		central_lists[size_class].lock.unlock();
+		return block;
+	}
+
+	ThreadCache::Bin &bin = cache.bins[size_class];
+	if (unlikely(!bin.head)) {
+		central_lists[size_class].lock.lock();
+		bin.count = _central_take(size_class, _get_batch_size(size_class), bin.head);
+		central_lists[size_class].lock.unlock();
+		refill_count.increment();
+
+		if (unlikely(!bin.head)) {
+			return nullptr;
+		}
+	}
+
+	FreeBlock *block = bin.head;
+	bin.head = block->next;
+	bin.count--;
+	return block;
+}
+
+void SmallAllocator::free(void *p_ptr, size_t p_bytes) {
+	const uint32_t size_class = _get_size_class(p_bytes);
+	ThreadCache &cache = _get_thread_cache();
+	FreeBlock *block = (FreeBlock *)p_ptr;
+
+	if (unlikely(cache.exited)) {
+		_central_give(size_class, block, block);
+		return;
+	}
+
+	ThreadCache::Bin &bin = cache.bins[size_class];
+	block->next = bin.head;
+	bin.head = block;
+	bin.count++;
+
+	// Keep the most recently freed batch, which is likely still in cache, so alternating
+	// allocations and frees don't go back and forth to the central list. Give the rest back.
+	const uint32_t batch_size = _get_batch_size(size_class);
+	if (unlikely(bin.count >= batch_size * 2)) {
+		FreeBlock *last_kept = bin.head;
+		for (uint32_t i = 1; i < batch_size; i++) {
+			last_kept = last_kept->next;
+		}
+		FreeBlock *head = last_kept->next;
+		FreeBlock *tail = head;
+		while (tail->next) {
+			tail = tail->next;
+		}
+		last_kept->next = nullptr;
+		bin.count = batch_size;
+		_central_give(size_class, head, tail);
+	}
+}
+
+size_t SmallAllocator::get_block_size(size_t p_bytes) {
+	DEV_ASSERT(is_small(p_bytes));
+	return size_classes[_get_size_class(p_bytes)];
+}
+
+uint64_t SmallAllocator::get_reserved_bytes() {
+	return reserved_bytes.get();
+}
+
+uint64_t SmallAllocator::get_refill_count() {
+	return refill_count.get();
+}
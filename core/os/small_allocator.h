@@ -0,0 +1,59 @@
+/**************************************************************************/
+/*  small_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <cstddef>
+
+// Allocator for small blocks, served from thread-local caches of fixed size classes.
+// Each cache is refilled from, and drained back to, a central free list per size class in
+// batches, so most allocations and frees touch no shared state at all.
+//
+// Freeing must pass the size given when allocating. Memory always knows it from the
+// allocation header, which is why it can route blocks here when built with
+// `small_allocator=yes`. Blocks are carved from spans reserved from the system, which are
+// never released: the footprint is the high-water mark of small allocations.
+class SmallAllocator {
+public:
+	static constexpr size_t MAX_SIZE = 1024;
+	static constexpr uint32_t SIZE_CLASS_COUNT = 20;
+
+	static void *alloc(size_t p_bytes);
+	static void free(void *p_ptr, size_t p_bytes);
+
+	_FORCE_INLINE_ static bool is_small(size_t p_bytes) { return p_bytes <= MAX_SIZE; }
+	// Size actually reserved for a block of `p_bytes`, which must be small.
+	static size_t get_block_size(size_t p_bytes);
+
+	static uint64_t get_reserved_bytes();
+	static uint64_t get_refill_count();
+};
@@ -39,30 +39,205 @@ struct StringName::Table {
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
-	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	// Buckets are split into contiguous shards, each with its own mutex, so threads interning
+	// unrelated names don't serialize on a single lock. The mutex is only needed to insert or
+	// unlink; names that already exist are found without locking (see `find()`).
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_LEN = 1 << SHARD_BITS;
+
+	struct alignas(64) Shard {
+		BinaryMutex mutex;
+		// Bumped whenever a node is unlinked, so lock-free readers can tell a clean miss
+		// from one where the chain changed under them.
+		SafeNumeric<uint32_t> removals;
+	};
+
+	struct ShardLock {
+		const Shard &shard;
+
+		explicit ShardLock(const Shard &p_shard) :
+				shard(p_shard) {
+			if (!shard.mutex.try_lock()) {
+				contention_count.increment();
+				shard.mutex.lock();
+			}
+		}
+		~ShardLock() {
+			shard.mutex.unlock();
+		}
+	};
+
+	static inline std::atomic<_Data *> table[TABLE_LEN];
+	static inline Shard shards[SHARD_LEN];
+	// Nodes are never handed back to the system while the table is configured, only recycled
+	// as `_Data` again. This is what makes walking a chain without the lock safe.
+	static inline PagedAllocator<_Data, true> allocator;
+	static inline SafeNumeric<uint64_t> contention_count{ 0 };
+
+	_FORCE_INLINE_ static Shard &get_shard(uint32_t p_hash) {
+		return shards[(p_hash & TABLE_MASK) >> (TABLE_BITS - SHARD_BITS)];
+	}
+
+	// Lock-free lookup. Returns true if the result can be trusted: either a match, already
+	// referenced, in `r_data`, or a miss while no node was unlinked from the shard. Otherwise
+	// the caller must retry with the shard locked.
+	template <typename T>
+	static bool find(uint32_t p_hash, const T &p_name, _Data *&r_data) {
+		r_data = nullptr;
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			// Reference ranking is only kept under the lock.
+			return false;
+		}
+#endif
+		const Shard &shard = get_shard(p_hash);
+		const uint32_t removals = shard.removals.get();
+
+		_Data *data = table[p_hash & TABLE_MASK].load(std::memory_order_acquire);
+		while (data) {
+			// The node may be recycled at any time until we hold a reference, so only the hash
+			// is used as a filter, and both are compared again once it's pinned.
+			if (data->hash == p_hash && data->refcount.ref()) {
+				if (data->hash == p_hash && data->name == p_name) {
+					r_data = data;
+					return true;
+				}
+				_Data *next = data->next.load(std::memory_order_acquire);
+				release(data);
+				data = next;
+				continue;
+			}
+			data = data->next.load(std::memory_order_acquire);
+		}
+
+		return shard.removals.get() == removals;
+	}
+
+	// Must be called with the shard of `p_hash` locked.
+	template <typename T>
+	static _Data *find_locked(uint32_t p_hash, const T &p_name) {
+		_Data *data = table[p_hash & TABLE_MASK].load(std::memory_order_relaxed);
+
+		while (data) {
+			// compare hash first
+			if (data->hash == p_hash && data->name == p_name) {
+				break;
+			}
+			data = data->next.load(std::memory_order_relaxed);
+		}
+
+		if (data && data->refcount.ref()) {
+#ifdef DEBUG_ENABLED
+			if (unlikely(debug_stringname)) {
+				data->debug_references++;
+			}
+#endif
+			return data;
+		}
+
+		return nullptr;
+	}
+
+	template <typename T>
+	static _Data *intern(uint32_t p_hash, const T &p_name, bool p_static) {
+		_Data *data = nullptr;
+		find(p_hash, p_name, data);
+		if (!data) {
+			// Inserting always needs the lock, and the name may have appeared meanwhile.
+			ShardLock lock(get_shard(p_hash));
+			data = find_locked(p_hash, p_name);
+
+			if (!data) {
+				const uint32_t idx = p_hash & TABLE_MASK;
+				data = allocator.alloc();
+				data->name = p_name;
+				data->hash = p_hash;
+				data->static_count.set(p_static ? 1 : 0);
+				data->prev = nullptr;
+				data->next.store(table[idx].load(std::memory_order_relaxed), std::memory_order_release);
+				// Initialized last: a reader holding a stale pointer to this node can only
+				// reference it once the name and hash above are visible.
+				data->refcount.init();
+#ifdef DEBUG_ENABLED
+				if (unlikely(debug_stringname)) {
+					// Keep in memory, force static.
+					data->refcount.ref();
+					data->static_count.increment();
+				}
+#endif
+				if (data->next.load(std::memory_order_relaxed)) {
+					data->next.load(std::memory_order_relaxed)->prev = data;
+				}
+				table[idx].store(data, std::memory_order_release);
+				return data;
+			}
+		}
+
+		// exists
+		if (p_static) {
+			data->static_count.increment();
+		}
+		return data;
+	}
+
+	template <typename T>
+	static _Data *search(uint32_t p_hash, const T &p_name) {
+		_Data *data = nullptr;
+		if (!find(p_hash, p_name, data)) {
+			ShardLock lock(get_shard(p_hash));
+			data = find_locked(p_hash, p_name);
+		}
+		return data;
+	}
+
+	static void release(_Data *p_data) {
+		if (!p_data->refcount.unref()) {
+			return;
+		}
+
+		Shard &shard = get_shard(p_data->hash);
+		ShardLock lock(shard);
+
+		if (CoreGlobals::leak_reporting_enabled && p_data->static_count.get() > 0) {
+			ERR_PRINT("BUG: Unreferenced static string to 0: " + p_data->name);
+		}
+		shard.removals.increment();
+
+		_Data *next = p_data->next.load(std::memory_order_relaxed);
+		if (p_data->prev) {
+			p_data->prev->next.store(next, std::memory_order_release);
+		} else {
+			table[p_data->hash & TABLE_MASK].store(next, std::memory_order_release);
+		}
+
+		if (next) {
+			next->prev = p_data->prev;
+		}
+		allocator.free(p_data);
+	}
 };
 
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		Table::table[i] = nullptr;
+		Table::table[i].store(nullptr, std::memory_order_relaxed);
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
+	for (uint32_t i = 0; i < Table::SHARD_LEN; i++) {
+		Table::shards[i].mutex.lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-			_Data *d = Table::table[i];
+			_Data *d = Table::table[i].load(std::memory_order_relaxed);
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load(std::memory_order_relaxed);
 			}
 		}
 
@@ -86,8 +261,8 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		while (Table::table[i]) {
-			_Data *d = Table::table[i];
+		_Data *d = Table::table[i].load(std::memory_order_relaxed);
+		while (d) {
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -96,41 +271,36 @@ void StringName::cleanup() {
 				}
 			}
 
-			Table::table[i] = Table::table[i]->next;
+			_Data *next = d->next.load(std::memory_order_relaxed);
 			Table::allocator.free(d);
+			d = next;
 		}
+		Table::table[i].store(nullptr, std::memory_order_relaxed);
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
+
+	for (uint32_t i = 0; i < Table::SHARD_LEN; i++) {
+		Table::shards[i].mutex.unlock();
+	}
 }
 
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
-	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
-
-		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
-			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
-		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
-			Table::table[idx] = _data->next;
-		}
-
-		if (_data->next) {
-			_data->next->prev = _data->prev;
-		}
-		Table::allocator.free(_data);
+	if (_data) {
+		Table::release(_data);
 	}
 
 	_data = nullptr;
 }
 
+uint64_t StringName::get_contention_count() {
+	return Table::contention_count.get();
+}
+
 uint32_t StringName::get_empty_hash() {
 	static uint32_t empty_hash = String::hash("");
 	return empty_hash;
@@ -210,52 +380,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(String::hash(p_name), p_name, p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -267,51 +392,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name.hash(), p_name, p_static);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -322,31 +403,8 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_Data *_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	// An empty StringName if it does not exist.
+	return StringName(Table::search(String::hash(p_name), p_name));
 }
 
 StringName StringName::search(const char32_t *p_name) {
@@ -357,54 +415,13 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_Data *_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	return StringName(Table::search(String::hash(p_name), p_name));
 }
 
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_Data *_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	return StringName(Table::search(p_name.hash(), p_name));
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
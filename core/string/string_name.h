@@ -50,7 +50,7 @@ class [[nodiscard]] StringName {
 
 		uint32_t hash = 0;
 		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		std::atomic<_Data *> next = nullptr;
 		_Data() {}
 	};
 
@@ -138,6 +138,9 @@ public:
 	static StringName search(const char32_t *p_name);
 	static StringName search(const String &p_name);
 
+	// Number of times a thread had to wait for a shard of the table to be unlocked.
+	static uint64_t get_contention_count();
+
 	struct AlphCompare {
 		template <typename LT, typename RT>
 		_FORCE_INLINE_ bool operator()(const LT &l, const RT &r) const {
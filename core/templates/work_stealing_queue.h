@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*  work_stealing_queue.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Bounded work-stealing deque (Chase-Lev), with the memory ordering from "Correct and
+// Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+// One owner pushes and pops at the bottom, LIFO, while any thread may steal from the top,
+// FIFO. Pushes must not run concurrently with each other or with pops, which also allows
+// several threads to push under a common lock, as long as nobody pops.
+
+template <typename T, uint32_t t_capacity>
+class WorkStealingQueue {
+	static_assert(std::atomic<T>::is_always_lock_free);
+	static_assert(t_capacity && !(t_capacity & (t_capacity - 1)), "Capacity must be a power of 2.");
+
+	static constexpr int64_t MASK = t_capacity - 1;
+
+	// Padded rather than aligned, like SpinLock, so it can live in memory from Memory.
+	union {
+		std::atomic<int64_t> top = 0;
+		char top_aligner[Thread::CACHE_LINE_BYTES];
+	};
+	union {
+		std::atomic<int64_t> bottom = 0;
+		char bottom_aligner[Thread::CACHE_LINE_BYTES];
+	};
+	std::atomic<T> buffer[t_capacity];
+
+public:
+	// Returns false if the queue is full.
+	bool push(T p_value) {
+		const int64_t b = bottom.load(std::memory_order_relaxed);
+		const int64_t t = top.load(std::memory_order_acquire);
+		if (b - t >= (int64_t)t_capacity) {
+			return false;
+		}
+		buffer[b & MASK].store(p_value, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool pop(T &r_value) {
+		const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// Empty.
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		r_value = buffer[b & MASK].load(std::memory_order_relaxed);
+		if (t < b) {
+			return true;
+		}
+
+		// Last element, race against thieves for it.
+		const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	// May fail spuriously when racing with others, so a failure doesn't mean it's empty.
+	bool steal(T &r_value) {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return false;
+		}
+
+		const T value = buffer[t & MASK].load(std::memory_order_relaxed);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return false;
+		}
+		r_value = value;
+		return true;
+	}
+
+	// Only a hint while other threads use the queue.
+	_FORCE_INLINE_ bool is_empty() const {
+		return bottom.load(std::memory_order_acquire) <= top.load(std::memory_order_acquire);
+	}
+};
@@ -50,6 +50,12 @@ struct ArrayPrivate {
 			array(p_init) {}
 };
 
+// Tags element storage, the only part of an array that grows.
+static uint32_t _get_memory_tag() {
+	static const uint32_t memory_tag = Memory::register_tag("Arrays");
+	return memory_tag;
+}
+
 void Array::_ref(const Array &p_from) const {
 	ArrayPrivate *_fp = p_from._p;
 
@@ -212,6 +218,7 @@ void Array::operator=(const Array &p_array) {
 }
 
 void Array::assign(const Array &p_array) {
+	MemoryTagScope memory_tag_scope(_get_memory_tag());
 	const ContainerTypeValidate &typed = _p->typed;
 	const ContainerTypeValidate &source_typed = p_array._p->typed;
 
@@ -280,11 +287,13 @@ void Array::push_back(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "push_back"));
+	MemoryTagScope memory_tag_scope(_get_memory_tag());
 	_p->array.push_back(std::move(value));
 }
 
 void Array::append_array(const Array &p_array) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	MemoryTagScope memory_tag_scope(_get_memory_tag());
 
 	if (!is_typed() || _p->typed.can_reference(p_array._p->typed)) {
 		_p->array.append_array(p_array._p->array);
@@ -302,6 +311,7 @@ void Array::append_array(const Array &p_array) {
 
 Error Array::resize(int p_new_size) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, ERR_LOCKED, "Array is in read-only state.");
+	MemoryTagScope memory_tag_scope(_get_memory_tag());
 	Variant::Type &variant_type = _p->typed.type;
 	int old_size = _p->array.size();
 	Error err = _p->array.resize_zeroed(p_new_size);
@@ -325,6 +335,7 @@ Error Array::insert(int p_pos, const Variant &p_value) {
 
 	ERR_FAIL_INDEX_V_MSG(p_pos, _p->array.size() + 1, ERR_INVALID_PARAMETER, vformat("The calculated index %d is out of bounds (the array has %d elements). Leaving the array untouched.", p_pos, _p->array.size()));
 
+	MemoryTagScope memory_tag_scope(_get_memory_tag());
 	return _p->array.insert(p_pos, std::move(value));
 }
 
@@ -755,6 +766,7 @@ void Array::push_front(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "push_front"));
+	MemoryTagScope memory_tag_scope(_get_memory_tag());
 	_p->array.insert(0, std::move(value));
 }
 
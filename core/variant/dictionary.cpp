@@ -49,6 +49,12 @@ struct DictionaryPrivate {
 	Variant *typed_fallback = nullptr; // Allows a typed dictionary to return dummy values when attempting an invalid access.
 };
 
+// Tags the entries, the only part of a dictionary that grows.
+static uint32_t _get_memory_tag() {
+	static const uint32_t memory_tag = Memory::register_tag("Dictionaries");
+	return memory_tag;
+}
+
 Dictionary::ConstIterator Dictionary::begin() const {
 	return _p->variant_map.begin();
 }
@@ -109,6 +115,7 @@ Variant &Dictionary::operator[](const Variant &p_key) {
 		}
 		return *_p->read_only;
 	} else {
+		MemoryTagScope memory_tag_scope(_get_memory_tag());
 		const uint32_t old_size = _p->variant_map.size();
 		Variant &value = _p->variant_map[key];
 		if (_p->variant_map.size() > old_size) {
@@ -203,6 +210,7 @@ bool Dictionary::set(const Variant &p_key, const Variant &p_value) {
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "set"), false);
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed_value.validate(value, "set"), false);
+	MemoryTagScope memory_tag_scope(_get_memory_tag());
 	_p->variant_map[key] = value;
 	return true;
 }
@@ -404,6 +412,7 @@ Array Dictionary::values() const {
 }
 
 void Dictionary::assign(const Dictionary &p_dictionary) {
+	MemoryTagScope memory_tag_scope(_get_memory_tag());
 	const ContainerTypeValidate &typed_key = _p->typed_key;
 	const ContainerTypeValidate &typed_key_source = p_dictionary._p->typed_key;
 
@@ -0,0 +1,282 @@
+/**************************************************************************/
+/*  editor_heap_profiler.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "editor_heap_profiler.h"
+
+#include "editor/themes/editor_scale.h"
+#include "scene/gui/button.h"
+#include "scene/gui/label.h"
+#include "scene/gui/option_button.h"
+#include "scene/gui/spin_box.h"
+#include "scene/gui/tree.h"
+
+struct HeapEntrySort {
+	bool operator()(const HeapProfiler::Snapshot::Entry &p_a, const HeapProfiler::Snapshot::Entry &p_b) const {
+		return Math::abs(p_a.bytes) > Math::abs(p_b.bytes);
+	}
+};
+
+String EditorHeapProfiler::_format_bytes(int64_t p_bytes, bool p_signed) {
+	const String size = String::humanize_size(Math::abs(p_bytes));
+	if (!p_signed) {
+		return size;
+	}
+	return (p_bytes < 0 ? "-" : "+") + size;
+}
+
+void EditorHeapProfiler::_add_entries(TreeItem *p_parent, const Vector<HeapProfiler::Snapshot::Entry> &p_entries, bool p_signed) {
+	Vector<HeapProfiler::Snapshot::Entry> entries = p_entries;
+	entries.sort_custom<HeapEntrySort>();
+
+	for (const HeapProfiler::Snapshot::Entry &E : entries) {
+		TreeItem *item = tree->create_item(p_parent);
+		item->set_text(0, E.name);
+		item->set_tooltip_text(0, E.name);
+		item->set_text(1, _format_bytes(E.bytes, p_signed));
+		item->set_text_alignment(1, HORIZONTAL_ALIGNMENT_RIGHT);
+		if (E.count) {
+			item->set_text(2, p_signed && E.count > 0 ? "+" + itos(E.count) : itos(E.count));
+			item->set_text_alignment(2, HORIZONTAL_ALIGNMENT_RIGHT);
+		}
+	}
+}
+
+void EditorHeapProfiler::_update_button_text() {
+	if (activate->is_pressed()) {
+		activate->set_button_icon(get_editor_theme_icon(SNAME("Stop")));
+		activate->set_text(TTR("Stop Sampling"));
+	} else {
+		activate->set_button_icon(get_editor_theme_icon(SNAME("Play")));
+		activate->set_text(TTR("Start Sampling"));
+	}
+	interval->set_editable(!activate->is_pressed());
+}
+
+void EditorHeapProfiler::_update_snapshot_list() {
+	const int selected = snapshot_select->get_selected();
+	const int compared = compare_select->get_selected();
+
+	snapshot_select->clear();
+	compare_select->clear();
+	compare_select->add_item(TTR("None"));
+	for (int i = 0; i < snapshots.size(); i++) {
+		const String name = vformat(TTR("Snapshot %d (%s s)"), i + 1, String::num(snapshots[i].ticks_usec / 1000000.0, 1));
+		snapshot_select->add_item(name);
+		compare_select->add_item(name);
+	}
+
+	if (selected >= 0 && selected < snapshots.size()) {
+		snapshot_select->select(selected);
+	}
+	compare_select->select(compared >= 0 && compared <= snapshots.size() ? compared : 0);
+	snapshot_select->set_disabled(snapshots.is_empty());
+	compare_select->set_disabled(snapshots.size() < 2);
+	clear_button->set_disabled(snapshots.is_empty());
+}
+
+void EditorHeapProfiler::_update_tree() {
+	tree->clear();
+
+	const int selected = snapshot_select->get_selected();
+	if (selected < 0 || selected >= snapshots.size()) {
+		info->set_text(TTR("Take a snapshot to see what the running project's memory is used for."));
+		return;
+	}
+
+	const int compared = compare_select->get_selected() - 1;
+	const bool diff = compared >= 0 && compared != selected;
+	const HeapProfiler::Snapshot snapshot = diff ? snapshots[selected].diff(snapshots[compared]) : snapshots[selected];
+
+	String text = vformat(TTR("Static memory: %s, estimated from samples: %s."), _format_bytes(snapshot.usage, diff), _format_bytes(snapshot.sampled, diff));
+	if (snapshot.dropped > 0) {
+		text += " " + vformat(TTR("%d allocations could not be sampled, increase the interval."), snapshot.dropped);
+	}
+	info->set_text(text);
+
+	TreeItem *root = tree->create_item();
+
+	TreeItem *tags = tree->create_item(root);
+	tags->set_text(0, TTR("Memory Tags"));
+	tags->set_text(1, _format_bytes(snapshot.usage, diff));
+	tags->set_text_alignment(1, HORIZONTAL_ALIGNMENT_RIGHT);
+	_add_entries(tags, snapshot.tags, diff);
+
+	TreeItem *sites = tree->create_item(root);
+	sites->set_text(0, TTR("Sampled Tag Stacks"));
+	sites->set_text(1, _format_bytes(snapshot.sampled, diff));
+	sites->set_text_alignment(1, HORIZONTAL_ALIGNMENT_RIGHT);
+	_add_entries(sites, snapshot.sites, diff);
+}
+
+void EditorHeapProfiler::_activate_pressed() {
+	_update_button_text();
+	emit_signal(SNAME("enable_profiling"), activate->is_pressed());
+}
+
+void EditorHeapProfiler::_snapshot_pressed() {
+	emit_signal(SNAME("snapshot_requested"));
+}
+
+void EditorHeapProfiler::_clear_pressed() {
+	clear();
+}
+
+void EditorHeapProfiler::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_THEME_CHANGED: {
+			_update_button_text();
+			snapshot_button->set_button_icon(get_editor_theme_icon(SNAME("Add")));
+			clear_button->set_button_icon(get_editor_theme_icon(SNAME("Clear")));
+		} break;
+	}
+}
+
+void EditorHeapProfiler::_bind_methods() {
+	ADD_SIGNAL(MethodInfo("enable_profiling", PropertyInfo(Variant::BOOL, "enable")));
+	ADD_SIGNAL(MethodInfo("snapshot_requested"));
+}
+
+void EditorHeapProfiler::add_snapshot(const HeapProfiler::Snapshot &p_snapshot) {
+	snapshots.push_back(p_snapshot);
+	_update_snapshot_list();
+	snapshot_select->select(snapshots.size() - 1);
+	if (snapshots.size() == 2 && compare_select->get_selected() == 0) {
+		// Comparing is the point of a second snapshot.
+		compare_select->select(1);
+	}
+	_update_tree();
+}
+
+void EditorHeapProfiler::set_enabled(bool p_enable, bool p_clear) {
+	activate->set_disabled(!p_enable);
+	snapshot_button->set_disabled(!p_enable);
+	if (p_clear) {
+		clear();
+	}
+}
+
+void EditorHeapProfiler::set_profiling(bool p_pressed) {
+	activate->set_pressed(p_pressed);
+	_update_button_text();
+	emit_signal(SNAME("enable_profiling"), activate->is_pressed());
+}
+
+bool EditorHeapProfiler::is_profiling() {
+	return activate->is_pressed();
+}
+
+int EditorHeapProfiler::get_sample_interval() const {
+	return (int)interval->get_value() * 1024;
+}
+
+void EditorHeapProfiler::clear() {
+	snapshots.clear();
+	_update_snapshot_list();
+	_update_tree();
+}
+
+EditorHeapProfiler::EditorHeapProfiler() {
+	HBoxContainer *hb = memnew(HBoxContainer);
+	hb->add_theme_constant_override(SNAME("separation"), 8 * EDSCALE);
+	add_child(hb);
+
+	activate = memnew(Button);
+	activate->set_toggle_mode(true);
+	activate->set_disabled(true);
+	activate->set_text(TTR("Start Sampling"));
+	activate->set_tooltip_text(TTR("Sample allocations to estimate which memory tags they were made under.\nSnapshots always include the usage of each tag, but only debug builds track it."));
+	activate->connect(SceneStringName(pressed), callable_mp(this, &EditorHeapProfiler::_activate_pressed));
+	hb->add_child(activate);
+
+	hb->add_child(memnew(Label(TTR("Interval:"))));
+	interval = memnew(SpinBox);
+	interval->set_min(4);
+	interval->set_max(64 * 1024);
+	interval->set_step(4);
+	interval->set_value(HeapProfiler::DEFAULT_SAMPLE_INTERVAL / 1024);
+	interval->set_suffix(TTR("KiB"));
+	interval->set_tooltip_text(TTR("Roughly one allocation is sampled every this many bytes allocated."));
+	interval->set_accessibility_name(TTRC("Sample Interval"));
+	hb->add_child(interval);
+
+	snapshot_button = memnew(Button);
+	snapshot_button->set_text(TTR("Take Snapshot"));
+	snapshot_button->set_disabled(true);
+	snapshot_button->connect(SceneStringName(pressed), callable_mp(this, &EditorHeapProfiler::_snapshot_pressed));
+	hb->add_child(snapshot_button);
+
+	clear_button = memnew(Button);
+	clear_button->set_text(TTR("Clear"));
+	clear_button->set_disabled(true);
+	clear_button->connect(SceneStringName(pressed), callable_mp(this, &EditorHeapProfiler::_clear_pressed));
+	hb->add_child(clear_button);
+
+	{ // Add some space to move the rest of the controls to the right.
+		Control *space = memnew(Control);
+		space->set_h_size_flags(SIZE_EXPAND_FILL);
+		hb->add_child(space);
+	}
+
+	hb->add_child(memnew(Label(TTR("Snapshot:"))));
+	snapshot_select = memnew(OptionButton);
+	snapshot_select->set_accessibility_name(TTRC("Snapshot"));
+	snapshot_select->set_custom_minimum_size(Size2(150, 0) * EDSCALE);
+	snapshot_select->connect(SceneStringName(item_selected), callable_mp(this, &EditorHeapProfiler::_update_tree).unbind(1));
+	hb->add_child(snapshot_select);
+
+	hb->add_child(memnew(Label(TTR("Compare With:"))));
+	compare_select = memnew(OptionButton);
+	compare_select->set_accessibility_name(TTRC("Compare With"));
+	compare_select->set_custom_minimum_size(Size2(150, 0) * EDSCALE);
+	compare_select->connect(SceneStringName(item_selected), callable_mp(this, &EditorHeapProfiler::_update_tree).unbind(1));
+	hb->add_child(compare_select);
+
+	info = memnew(Label);
+	info->set_autowrap_mode(TextServer::AUTOWRAP_WORD_SMART);
+	add_child(info);
+
+	tree = memnew(Tree);
+	tree->set_v_size_flags(SIZE_EXPAND_FILL);
+	tree->set_columns(3);
+	tree->set_column_titles_visible(true);
+	tree->set_column_title(0, TTR("Tag Stack"));
+	tree->set_column_expand(0, true);
+	tree->set_column_title(1, TTR("Size"));
+	tree->set_column_expand(1, false);
+	tree->set_column_custom_minimum_width(1, 100 * EDSCALE);
+	tree->set_column_title(2, TTR("Samples"));
+	tree->set_column_expand(2, false);
+	tree->set_column_custom_minimum_width(2, 80 * EDSCALE);
+	tree->set_hide_root(true);
+	add_child(tree);
+
+	_update_snapshot_list();
+	_update_tree();
+}
@@ -0,0 +1,80 @@
+/**************************************************************************/
+/*  editor_heap_profiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/heap_profiler.h"
+#include "scene/gui/box_container.h"
+
+class Button;
+class Label;
+class OptionButton;
+class SpinBox;
+class Tree;
+class TreeItem;
+
+class EditorHeapProfiler : public VBoxContainer {
+	GDCLASS(EditorHeapProfiler, VBoxContainer);
+
+	Button *activate = nullptr;
+	SpinBox *interval = nullptr;
+	Button *snapshot_button = nullptr;
+	Button *clear_button = nullptr;
+	OptionButton *snapshot_select = nullptr;
+	OptionButton *compare_select = nullptr;
+	Label *info = nullptr;
+	Tree *tree = nullptr;
+
+	Vector<HeapProfiler::Snapshot> snapshots;
+
+	static String _format_bytes(int64_t p_bytes, bool p_signed);
+	void _add_entries(TreeItem *p_parent, const Vector<HeapProfiler::Snapshot::Entry> &p_entries, bool p_signed);
+	void _update_button_text();
+	void _update_snapshot_list();
+	void _update_tree();
+
+	void _activate_pressed();
+	void _snapshot_pressed();
+	void _clear_pressed();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void add_snapshot(const HeapProfiler::Snapshot &p_snapshot);
+	void set_enabled(bool p_enable, bool p_clear = true);
+	void set_profiling(bool p_pressed);
+	bool is_profiling();
+	int get_sample_interval() const;
+	void clear();
+
+	EditorHeapProfiler();
+};
@@ -35,6 +35,7 @@
 #include "core/string/ustring.h"
 #include "core/version.h"
 #include "editor/debugger/editor_expression_evaluator.h"
+#include "editor/debugger/editor_heap_profiler.h"
 #include "editor/debugger/editor_performance_profiler.h"
 #include "editor/debugger/editor_profiler.h"
 #include "editor/debugger/editor_visual_profiler.h"
@@ -305,6 +306,10 @@ void ScriptEditorDebugger::_video_mem_request() {
 	_put_msg("servers:memory", Array());
 }
 
+void ScriptEditorDebugger::_heap_snapshot_request() {
+	_put_msg("memory:snapshot", Array());
+}
+
 void ScriptEditorDebugger::_video_mem_export() {
 	file_dialog->set_file_mode(EditorFileDialog::FILE_MODE_SAVE_FILE);
 	file_dialog->set_access(EditorFileDialog::ACCESS_FILESYSTEM);
@@ -435,6 +440,12 @@ void ScriptEditorDebugger::_msg_scene_inspect_objects(uint64_t p_thread_id, cons
 	}
 }
 
+void ScriptEditorDebugger::_msg_memory_snapshot(uint64_t p_thread_id, const Array &p_data) {
+	HeapProfiler::Snapshot snapshot;
+	ERR_FAIL_COND(!snapshot.deserialize(p_data));
+	heap_profiler->add_snapshot(snapshot);
+}
+
 void ScriptEditorDebugger::_msg_servers_memory_usage(uint64_t p_thread_id, const Array &p_data) {
 	vmem_tree->clear();
 	TreeItem *root = vmem_tree->create_item();
@@ -953,6 +964,7 @@ void ScriptEditorDebugger::_init_parse_message_handlers() {
 	parse_message_handlers["scene:inspect_objects"] = &ScriptEditorDebugger::_msg_scene_inspect_objects;
 	parse_message_handlers["servers:memory_usage"] = &ScriptEditorDebugger::_msg_servers_memory_usage;
 	parse_message_handlers["servers:drawn"] = &ScriptEditorDebugger::_msg_servers_drawn;
+	parse_message_handlers["memory:snapshot"] = &ScriptEditorDebugger::_msg_memory_snapshot;
 	parse_message_handlers["stack_dump"] = &ScriptEditorDebugger::_msg_stack_dump;
 	parse_message_handlers["stack_frame_vars"] = &ScriptEditorDebugger::_msg_stack_frame_vars;
 	parse_message_handlers["stack_frame_var"] = &ScriptEditorDebugger::_msg_stack_frame_var;
@@ -1165,6 +1177,7 @@ void ScriptEditorDebugger::start(Ref<RemoteDebuggerPeer> p_peer) {
 
 	profiler->set_enabled(true, true);
 	visual_profiler->set_enabled(true);
+	heap_profiler->set_enabled(true, true);
 
 	peer = p_peer;
 	ERR_FAIL_COND(p_peer.is_null());
@@ -1257,6 +1270,9 @@ void ScriptEditorDebugger::stop() {
 	visual_profiler->set_enabled(false);
 	visual_profiler->set_profiling(false);
 
+	heap_profiler->set_enabled(false, false);
+	heap_profiler->set_profiling(false);
+
 	inspector->edit(nullptr);
 	_update_buttons_state();
 }
@@ -1279,6 +1295,13 @@ void ScriptEditorDebugger::_profiler_activate(bool p_enable, int p_type) {
 			}
 			_put_msg("profiler:servers", msg_data);
 			break;
+		case PROFILER_MEMORY:
+			if (p_enable) {
+				Array opts = { heap_profiler->get_sample_interval() };
+				msg_data.push_back(opts);
+			}
+			_put_msg("profiler:memory", msg_data);
+			break;
 		default:
 			ERR_FAIL_MSG("Invalid profiler type");
 	}
@@ -2205,6 +2228,14 @@ ScriptEditorDebugger::ScriptEditorDebugger() {
 		tabs->add_child(performance_profiler);
 	}
 
+	{ //heap
+		heap_profiler = memnew(EditorHeapProfiler);
+		heap_profiler->set_name(TTR("Heap"));
+		tabs->add_child(heap_profiler);
+		heap_profiler->connect("enable_profiling", callable_mp(this, &ScriptEditorDebugger::_profiler_activate).bind(PROFILER_MEMORY));
+		heap_profiler->connect("snapshot_requested", callable_mp(this, &ScriptEditorDebugger::_heap_snapshot_request));
+	}
+
 	{ //vmem inspect
 		VBoxContainer *vmem_vb = memnew(VBoxContainer);
 		HBoxContainer *vmem_hb = memnew(HBoxContainer);
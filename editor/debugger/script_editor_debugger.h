@@ -50,6 +50,7 @@ class EditorProfiler;
 class EditorFileDialog;
 class EditorVisualProfiler;
 class EditorPerformanceProfiler;
+class EditorHeapProfiler;
 class SceneDebuggerTree;
 class EditorDebuggerPlugin;
 class DebugAdapterProtocol;
@@ -72,7 +73,8 @@ private:
 
 	enum ProfilerType {
 		PROFILER_VISUAL,
-		PROFILER_SCRIPTS_SERVERS
+		PROFILER_SCRIPTS_SERVERS,
+		PROFILER_MEMORY
 	};
 
 	enum Actions {
@@ -154,6 +156,7 @@ private:
 	EditorProfiler *profiler = nullptr;
 	EditorVisualProfiler *visual_profiler = nullptr;
 	EditorPerformanceProfiler *performance_profiler = nullptr;
+	EditorHeapProfiler *heap_profiler = nullptr;
 	EditorExpressionEvaluator *expression_evaluator = nullptr;
 
 	OS::ProcessID remote_pid = 0;
@@ -205,6 +208,7 @@ private:
 	void _msg_scene_inspect_objects(uint64_t p_thread_id, const Array &p_data);
 	void _msg_servers_memory_usage(uint64_t p_thread_id, const Array &p_data);
 	void _msg_servers_drawn(uint64_t p_thread_id, const Array &p_data);
+	void _msg_memory_snapshot(uint64_t p_thread_id, const Array &p_data);
 	void _msg_stack_dump(uint64_t p_thread_id, const Array &p_data);
 	void _msg_stack_frame_vars(uint64_t p_thread_id, const Array &p_data);
 	void _msg_stack_frame_var(uint64_t p_thread_id, const Array &p_data);
@@ -237,6 +241,7 @@ private:
 	void _remote_object_property_updated(ObjectID p_id, const String &p_property);
 
 	void _video_mem_request();
+	void _heap_snapshot_request();
 	void _video_mem_export();
 
 	void _resources_reimported(const PackedStringArray &p_resources);
@@ -1,13 +1,22 @@
 #include "lupine_asset_manager.h"
 #include "editor/editor_node.h"
+#include "editor/editor_paths.h"
 #include "editor/editor_resource_preview.h"
+#include "editor/plugins/editor_preview_plugins.h"
 #include "scene/gui/separator.h"
 #include "scene/gui/label.h"
 #include "scene/gui/button.h"
+#include "scene/resources/image_texture.h"
 #include "core/io/json.h"
 #include "core/os/time.h"
 #include "core/io/file_access.h"
 
+#define ASSET_INDEX_CACHE_FILE "lupine_asset_index.cache"
+#define ASSET_INDEX_CACHE_VERSION "lupine_asset_index 1"
+
+static const Size2i LIST_THUMBNAIL_SIZE = Size2i(64, 64);
+static const Size2i PREVIEW_THUMBNAIL_SIZE = Size2i(200, 200);
+
 // Asset sorting comparators
 struct _AssetNameComparator {
 	bool operator()(const LupineAssetInfo *a, const LupineAssetInfo *b) const {
@@ -78,10 +87,13 @@ LupineAssetManager::LupineAssetManager() {
 	current_category_id = "";
 	selected_asset_path = "";
 	is_loading_assets = false;
+
+	asset_index = memnew((HashMap<String, LupineAssetInfo>));
 }
 
 LupineAssetManager::~LupineAssetManager() {
 	cleanup();
+	memdelete(asset_index);
 }
 
 void LupineAssetManager::initialize() {
@@ -93,14 +105,30 @@ void LupineAssetManager::initialize() {
 	_setup_asset_categories();
 	_populate_category_tree();
 
+	// Show the index from the last session right away; the first build only
+	// has to look at files that changed since.
+	_load_index_cache();
+	_update_asset_list();
+
 	// Connect to file system changes
 	EditorFileSystem *efs = EditorFileSystem::get_singleton();
 	if (efs) {
 		efs->connect("filesystem_changed", callable_mp(this, &LupineAssetManager::refresh_assets));
+		efs->connect("resources_reimported", callable_mp(this, &LupineAssetManager::_on_resources_reimported));
 	}
+	LupineAssetPreviewGenerator::get_singleton()->connect("thumbnail_ready", callable_mp(this, &LupineAssetManager::_on_thumbnail_ready));
+
+	_queue_index_update();
 }
 
 void LupineAssetManager::cleanup() {
+	_wait_for_index_task();
+
+	LupineAssetPreviewGenerator *previews = LupineAssetPreviewGenerator::get_singleton();
+	if (previews->is_connected("thumbnail_ready", callable_mp(this, &LupineAssetManager::_on_thumbnail_ready))) {
+		previews->disconnect("thumbnail_ready", callable_mp(this, &LupineAssetManager::_on_thumbnail_ready));
+	}
+
 	if (tool_panel && tool_panel->get_parent()) {
 		tool_panel->get_parent()->remove_child(tool_panel);
 	}
@@ -124,6 +152,7 @@ void LupineAssetManager::cleanup() {
 	asset_details = nullptr;
 	import_button = nullptr;
 	export_button = nullptr;
+	asset_list_items.clear();
 }
 
 void LupineAssetManager::_create_ui() {
@@ -373,7 +402,7 @@ void LupineAssetManager::_on_category_selected() {
 	}
 
 	current_category_id = selected->get_metadata(0);
-	_scan_assets_for_category(current_category_id);
+	_update_asset_list();
 }
 
 void LupineAssetManager::_on_search_changed(const String &p_text) {
@@ -426,107 +455,208 @@ void LupineAssetManager::_on_export_pressed() {
 	_export_asset(selected_asset_path);
 }
 
-void LupineAssetManager::_scan_assets_for_category(const String &p_category_id) {
-	if (is_loading_assets) {
+bool LupineAssetManager::_asset_matches_category(const LupineAssetInfo &p_asset, const String &p_category_id) {
+	if (p_category_id == "all") {
+		return true;
+	}
+	if (p_asset.category_id != p_category_id) {
+		return false;
+	}
+
+	LupineAssetCategory *category = get_asset_category(p_category_id);
+	if (!category) {
+		return false;
+	}
+	return category->file_extensions.has(p_asset.path.get_extension().to_lower());
+}
+
+void LupineAssetManager::_queue_index_update() {
+	if (index_build) {
+		// A build is already running; start another one when it lands
+		index_update_queued = true;
 		return;
 	}
 
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	if (!efs) {
+		return;
+	}
+
+	// Snapshot the editor's file tree on the main thread. It is already in
+	// memory, so this costs no disk access.
+	index_build = memnew(IndexBuild);
+	HashSet<String> seen;
+	for (const LupineAssetCategory &category : asset_categories) {
+		EditorFileSystemDirectory *dir = efs->get_filesystem_path("res://" + category.folder_path);
+		if (dir) {
+			_collect_index_sources(dir, category.id, seen, index_build->sources);
+		}
+	}
+
+	for (IndexSource &source : index_build->sources) {
+		source.force_update = changed_paths.has(source.path);
+	}
+	changed_paths.clear();
+
+	index_build->previous = asset_index;
+	index_build->result = memnew((HashMap<String, LupineAssetInfo>));
+
 	is_loading_assets = true;
-	loading_progress->set_visible(true);
-	asset_list->clear();
+	if (loading_progress) {
+		loading_progress->set_visible(true);
+	}
 
-	// Clear asset cache for this category
-	asset_cache.clear();
-	asset_map.clear();
+	index_task = WorkerThreadPool::get_singleton()->add_template_task(this, &LupineAssetManager::_build_index_task, index_build, false, SNAME("LupineAssetIndex"));
+}
 
-	Vector<String> scan_paths;
+void LupineAssetManager::_collect_index_sources(EditorFileSystemDirectory *p_dir, const String &p_category_id, HashSet<String> &r_seen, LocalVector<IndexSource> &r_sources) {
+	for (int i = 0; i < p_dir->get_file_count(); i++) {
+		String path = p_dir->get_file_path(i);
+		if (r_seen.has(path)) {
+			continue;
+		}
+		r_seen.insert(path);
 
-	if (p_category_id == "all") {
-		// Scan all categories
-		for (const LupineAssetCategory &category : asset_categories) {
-			scan_paths.push_back(category.folder_path);
+		IndexSource source;
+		source.path = path;
+		source.category_id = p_category_id;
+		source.modified_time = p_dir->get_file_modified_time(i);
+		r_sources.push_back(source);
+	}
+
+	for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+		_collect_index_sources(p_dir->get_subdir(i), p_category_id, r_seen, r_sources);
+	}
+}
+
+void LupineAssetManager::_build_index_task(IndexBuild *p_build) {
+	p_build->result->reserve(p_build->sources.size());
+
+	for (const IndexSource &source : p_build->sources) {
+		const LupineAssetInfo *previous = p_build->previous->getptr(source.path);
+		if (previous && previous->modified_time == source.modified_time && previous->category_id == source.category_id && !source.force_update) {
+			p_build->result->insert(source.path, *previous);
+			continue;
 		}
-	} else {
-		// Scan specific category
-		LupineAssetCategory *category = get_asset_category(p_category_id);
-		if (category) {
-			scan_paths.push_back(category->folder_path);
+
+		// Only new or modified files touch the disk, and only for their size
+		LupineAssetInfo asset_info;
+		if (previous) {
+			asset_info = *previous;
 		}
+		asset_info.path = source.path;
+		asset_info.name = source.path.get_file().get_basename();
+		asset_info.category_id = source.category_id;
+		asset_info.file_size = MAX(FileAccess::get_size(source.path), 0);
+		asset_info.modified_time = source.modified_time;
+		asset_info.thumbnail = Ref<Texture2D>();
+		asset_info.resource = Ref<Resource>();
+
+		p_build->result->insert(source.path, asset_info);
 	}
 
-	// Scan directories for assets
-	for (const String &scan_path : scan_paths) {
-		_scan_directory_recursive(scan_path, p_category_id);
+	callable_mp(this, &LupineAssetManager::_on_index_built).call_deferred();
+}
+
+void LupineAssetManager::_on_index_built() {
+	if (!index_build) {
+		return; // Discarded by cleanup()
 	}
 
-	_update_asset_list();
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(index_task);
+	index_task = WorkerThreadPool::INVALID_TASK_ID;
+
+	memdelete(asset_index);
+	asset_index = index_build->result;
+	memdelete(index_build);
+	index_build = nullptr;
 
-	loading_progress->set_visible(false);
 	is_loading_assets = false;
-}
+	if (loading_progress) {
+		loading_progress->set_visible(false);
+	}
 
-void LupineAssetManager::_scan_directory_recursive(const String &p_path, const String &p_category_id) {
-	Ref<DirAccess> dir = DirAccess::open(p_path);
-	if (!dir.is_valid()) {
-		return;
+	_save_index_cache();
+	_update_asset_list();
+	_update_asset_preview();
+
+	if (index_update_queued) {
+		index_update_queued = false;
+		_queue_index_update();
 	}
+}
 
-	dir->list_dir_begin();
-	String file_name = dir->get_next();
+void LupineAssetManager::_on_resources_reimported(const PackedStringArray &p_resources) {
+	// A reimport can change a file's size without EditorFileSystem reporting a new modification time.
+	for (const String &path : p_resources) {
+		changed_paths.insert(path);
+	}
+	_queue_index_update();
+}
 
-	while (!file_name.is_empty()) {
-		if (file_name.begins_with(".")) {
-			file_name = dir->get_next();
-			continue;
+void LupineAssetManager::_on_thumbnail_ready(const String &p_path, const Vector2i &p_size, const Ref<Texture2D> &p_thumbnail) {
+	if (p_size == LIST_THUMBNAIL_SIZE && asset_list) {
+		const int *item_index = asset_list_items.getptr(p_path);
+		if (item_index && *item_index < asset_list->get_item_count()) {
+			asset_list->set_item_icon(*item_index, p_thumbnail);
 		}
+	}
 
-		String full_path = p_path + "/" + file_name;
+	if (p_size == PREVIEW_THUMBNAIL_SIZE && p_path == selected_asset_path && preview_image) {
+		preview_image->set_texture(p_thumbnail);
+	}
+}
 
-		if (dir->current_is_dir()) {
-			// Recursively scan subdirectories
-			_scan_directory_recursive(full_path, p_category_id);
-		} else {
-			// Process file
-			String extension = file_name.get_extension().to_lower();
-
-			// Check if file matches category extensions
-			bool matches_category = false;
-			if (p_category_id == "all") {
-				matches_category = true;
-			} else {
-				LupineAssetCategory *category = get_asset_category(p_category_id);
-				if (category) {
-					for (const String &ext : category->file_extensions) {
-						if (extension == ext) {
-							matches_category = true;
-							break;
-						}
-					}
-				}
-			}
+void LupineAssetManager::_wait_for_index_task() {
+	if (index_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(index_task);
+		index_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
 
-			if (matches_category) {
-				LupineAssetInfo asset_info;
-				asset_info.path = full_path;
-				asset_info.name = file_name.get_basename();
-				asset_info.category_id = p_category_id;
+	if (index_build) {
+		memdelete(index_build->result);
+		memdelete(index_build);
+		index_build = nullptr;
+	}
+	index_update_queued = false;
+	is_loading_assets = false;
+}
 
-				// Get file info
-				Ref<FileAccess> file = FileAccess::open(full_path, FileAccess::READ);
-				if (file.is_valid()) {
-					asset_info.file_size = file->get_length();
-					asset_info.modified_time = FileAccess::get_modified_time(full_path);
-				}
+String LupineAssetManager::_get_index_cache_path() const {
+	return EditorPaths::get_singleton()->get_project_settings_dir().path_join(ASSET_INDEX_CACHE_FILE);
+}
 
-				// Generate thumbnail
-				asset_info.thumbnail = LupineAssetPreviewGenerator::get_singleton()->generate_thumbnail(full_path);
+void LupineAssetManager::_load_index_cache() {
+	Ref<FileAccess> f = FileAccess::open(_get_index_cache_path(), FileAccess::READ);
+	if (f.is_null() || f->get_line() != ASSET_INDEX_CACHE_VERSION) {
+		return;
+	}
 
-				asset_cache.push_back(asset_info);
-				asset_map[full_path] = const_cast<LupineAssetInfo*>(&asset_cache[asset_cache.size() - 1]);
-			}
+	asset_index->clear();
+	while (!f->eof_reached()) {
+		Vector<String> fields = f->get_line().split("::");
+		if (fields.size() != 4) {
+			continue;
 		}
 
-		file_name = dir->get_next();
+		LupineAssetInfo asset_info;
+		asset_info.path = fields[0];
+		asset_info.name = asset_info.path.get_file().get_basename();
+		asset_info.category_id = fields[1];
+		asset_info.file_size = fields[2].to_int();
+		asset_info.modified_time = fields[3].to_int();
+		asset_index->insert(asset_info.path, asset_info);
+	}
+}
+
+void LupineAssetManager::_save_index_cache() const {
+	const String cache_path = _get_index_cache_path();
+	Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), "Cannot save asset index cache: " + cache_path);
+
+	f->store_line(ASSET_INDEX_CACHE_VERSION);
+	for (const KeyValue<String, LupineAssetInfo> &E : *asset_index) {
+		f->store_line(E.key + "::" + E.value.category_id + "::" + itos(E.value.file_size) + "::" + itos(E.value.modified_time));
 	}
 }
 
@@ -536,6 +666,7 @@ void LupineAssetManager::_update_asset_list() {
 	}
 
 	asset_list->clear();
+	asset_list_items.clear();
 
 	String search_text = search_filter ? search_filter->get_text().to_lower() : "";
 	int sort_mode = sort_options ? sort_options->get_selected() : 0;
@@ -543,7 +674,12 @@ void LupineAssetManager::_update_asset_list() {
 	// Filter and sort assets
 	Vector<LupineAssetInfo*> filtered_assets;
 
-	for (LupineAssetInfo &asset : asset_cache) {
+	for (KeyValue<String, LupineAssetInfo> &E : *asset_index) {
+		LupineAssetInfo &asset = E.value;
+		if (!_asset_matches_category(asset, current_category_id)) {
+			continue;
+		}
+
 		bool matches_search = search_text.is_empty() ||
 			asset.name.to_lower().contains(search_text) ||
 			asset.description.to_lower().contains(search_text);
@@ -574,8 +710,12 @@ void LupineAssetManager::_update_asset_list() {
 		int item_index = asset_list->add_item(asset->name);
 		asset_list->set_item_metadata(item_index, asset->path);
 
-		if (asset->thumbnail.is_valid()) {
-			asset_list->set_item_icon(item_index, asset->thumbnail);
+		asset_list_items[asset->path] = item_index;
+
+		// Missing thumbnails arrive later through thumbnail_ready
+		Ref<Texture2D> thumbnail = LupineAssetPreviewGenerator::get_singleton()->request_thumbnail(asset->path, asset->modified_time, LIST_THUMBNAIL_SIZE);
+		if (thumbnail.is_valid()) {
+			asset_list->set_item_icon(item_index, thumbnail);
 		}
 
 		// Set tooltip with asset info
@@ -604,12 +744,8 @@ void LupineAssetManager::_update_asset_preview() {
 		return;
 	}
 
-	// Set preview image
-	if (asset->thumbnail.is_valid()) {
-		preview_image->set_texture(asset->thumbnail);
-	} else {
-		preview_image->set_texture(Ref<Texture2D>());
-	}
+	// Set preview image; a missing one arrives later through thumbnail_ready
+	preview_image->set_texture(LupineAssetPreviewGenerator::get_singleton()->request_thumbnail(asset->path, asset->modified_time, PREVIEW_THUMBNAIL_SIZE));
 
 	// Set asset details
 	String details_text = "[b]" + asset->name + "[/b]\n\n";
@@ -634,17 +770,14 @@ void LupineAssetManager::_update_asset_preview() {
 }
 
 LupineAssetInfo *LupineAssetManager::get_asset_info(const String &p_path) {
-	if (asset_map.has(p_path)) {
-		return asset_map[p_path];
-	}
-	return nullptr;
+	return asset_index->getptr(p_path);
 }
 
 Vector<LupineAssetInfo> LupineAssetManager::get_assets_by_category(const String &p_category_id) {
 	Vector<LupineAssetInfo> result;
-	for (const LupineAssetInfo &asset : asset_cache) {
-		if (asset.category_id == p_category_id) {
-			result.push_back(asset);
+	for (const KeyValue<String, LupineAssetInfo> &E : *asset_index) {
+		if (_asset_matches_category(E.value, p_category_id)) {
+			result.push_back(E.value);
 		}
 	}
 	return result;
@@ -654,7 +787,8 @@ Vector<LupineAssetInfo> LupineAssetManager::search_assets(const String &p_query)
 	Vector<LupineAssetInfo> result;
 	String query_lower = p_query.to_lower();
 
-	for (const LupineAssetInfo &asset : asset_cache) {
+	for (const KeyValue<String, LupineAssetInfo> &E : *asset_index) {
+		const LupineAssetInfo &asset = E.value;
 		if (asset.name.to_lower().contains(query_lower) ||
 			asset.description.to_lower().contains(query_lower) ||
 			asset.path.to_lower().contains(query_lower)) {
@@ -666,9 +800,7 @@ Vector<LupineAssetInfo> LupineAssetManager::search_assets(const String &p_query)
 }
 
 void LupineAssetManager::refresh_assets() {
-	if (!current_category_id.is_empty()) {
-		_scan_assets_for_category(current_category_id);
-	}
+	_queue_index_update();
 }
 
 void LupineAssetManager::_import_asset_to_category(const String &p_source_path, const String &p_category_id) {
@@ -694,8 +826,11 @@ void LupineAssetManager::_import_asset_to_category(const String &p_source_path,
 		return;
 	}
 
-	// Refresh assets
-	refresh_assets();
+	// The index follows EditorFileSystem, which reports back through filesystem_changed
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	if (efs) {
+		efs->scan_changes();
+	}
 }
 
 void LupineAssetManager::_export_asset(const String &p_asset_path) {
@@ -723,14 +858,40 @@ void LupineAssetManager::_perform_export(const String &p_target_path, const Stri
 	}
 }
 
-// Missing LupineAssetPreviewGenerator implementation
+// LupineAssetPreviewGenerator Implementation
 LupineAssetPreviewGenerator *LupineAssetPreviewGenerator::singleton = nullptr;
 
-LupineAssetPreviewGenerator::LupineAssetPreviewGenerator() {
+LupineAssetPreviewGenerator::LupineAssetPreviewGenerator() :
+		thumbnail_cache(MEMORY_CACHE_SIZE) {
 	singleton = this;
+
+	for (int i = 0; i < MAX_WORKERS; i++) {
+		worker_tasks[i] = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	texture_preview = Ref<EditorTexturePreviewPlugin>(memnew(EditorTexturePreviewPlugin));
+	scene_preview = Ref<EditorPackedScenePreviewPlugin>(memnew(EditorPackedScenePreviewPlugin));
+	script_preview = Ref<EditorScriptPreviewPlugin>(memnew(EditorScriptPreviewPlugin));
+	audio_preview = Ref<EditorAudioStreamPreviewPlugin>(memnew(EditorAudioStreamPreviewPlugin));
+
+	disk_cache_dir = EditorPaths::get_singleton()->get_cache_dir().path_join("lupine_thumbnails");
+	DirAccess::make_dir_recursive_absolute(disk_cache_dir);
 }
 
 LupineAssetPreviewGenerator::~LupineAssetPreviewGenerator() {
+	{
+		MutexLock lock(mutex);
+		request_queue.clear();
+		queued_requests.clear();
+	}
+
+	for (int i = 0; i < MAX_WORKERS; i++) {
+		if (worker_tasks[i] != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(worker_tasks[i]);
+			worker_tasks[i] = WorkerThreadPool::INVALID_TASK_ID;
+		}
+	}
+
 	singleton = nullptr;
 }
 
@@ -741,12 +902,222 @@ LupineAssetPreviewGenerator *LupineAssetPreviewGenerator::get_singleton() {
 	return singleton;
 }
 
-Ref<Texture2D> LupineAssetPreviewGenerator::generate_thumbnail(const String &p_path, const Vector2i &p_size) {
-	// Simple implementation - just return a default icon for now
-	// In a full implementation, this would generate actual thumbnails based on file type
+String LupineAssetPreviewGenerator::_get_request_key(const String &p_path, const Size2i &p_size) {
+	return p_path + "::" + itos(p_size.width) + "x" + itos(p_size.height);
+}
+
+String LupineAssetPreviewGenerator::_get_disk_cache_path(const String &p_path, uint64_t p_modified_time, const Size2i &p_size) const {
+	const String key = _get_request_key(p_path, p_size) + "::" + itos(p_modified_time);
+	return disk_cache_dir.path_join(key.md5_text() + ".png");
+}
+
+Ref<Texture2D> LupineAssetPreviewGenerator::request_thumbnail(const String &p_path, uint64_t p_modified_time, const Size2i &p_size) {
+	const String key = _get_request_key(p_path, p_size);
+	{
+		MutexLock lock(mutex);
+		const CachedThumbnail *cached = thumbnail_cache.getptr(key);
+		if (cached && cached->modified_time == p_modified_time) {
+			return cached->texture;
+		}
+
+		if (!queued_requests.has(key)) {
+			ThumbnailRequest request;
+			request.path = p_path;
+			request.modified_time = p_modified_time;
+			request.size = p_size;
+			request_queue.push_back(request);
+			queued_requests.insert(key);
+
+			// Keep the queue bounded; the oldest requests are the least likely to still be on screen
+			while (request_queue.size() > MAX_QUEUED_REQUESTS) {
+				const ThumbnailRequest &dropped = request_queue.front()->get();
+				queued_requests.erase(_get_request_key(dropped.path, dropped.size));
+				request_queue.pop_front();
+			}
+		}
+	}
+
+	_start_workers();
 	return Ref<Texture2D>();
 }
 
+Ref<Texture2D> LupineAssetPreviewGenerator::generate_thumbnail(const String &p_path, const Size2i &p_size) {
+	ThumbnailRequest request;
+	request.path = p_path;
+	request.modified_time = FileAccess::get_modified_time(p_path);
+	request.size = p_size;
+
+	{
+		MutexLock lock(mutex);
+		const CachedThumbnail *cached = thumbnail_cache.getptr(_get_request_key(p_path, p_size));
+		if (cached && cached->modified_time == request.modified_time) {
+			return cached->texture;
+		}
+	}
+
+	return _produce_thumbnail(request);
+}
+
+Ref<Texture2D> LupineAssetPreviewGenerator::get_cached_thumbnail(const String &p_path, const Size2i &p_size) {
+	MutexLock lock(mutex);
+	const CachedThumbnail *cached = thumbnail_cache.getptr(_get_request_key(p_path, p_size));
+	return cached ? cached->texture : Ref<Texture2D>();
+}
+
+void LupineAssetPreviewGenerator::clear_thumbnail_cache() {
+	MutexLock lock(mutex);
+	thumbnail_cache.clear();
+	default_thumbnails.clear();
+}
+
+Ref<Texture2D> LupineAssetPreviewGenerator::_produce_thumbnail(const ThumbnailRequest &p_request) {
+	const String disk_path = _get_disk_cache_path(p_request.path, p_request.modified_time, p_request.size);
+
+	Ref<Texture2D> thumbnail;
+	if (FileAccess::exists(disk_path)) {
+		Ref<Image> image;
+		image.instantiate();
+		if (image->load(disk_path) == OK) {
+			thumbnail = ImageTexture::create_from_image(image);
+		}
+	}
+
+	if (thumbnail.is_null()) {
+		thumbnail = _generate_uncached(p_request.path, p_request.size);
+		if (thumbnail.is_valid()) {
+			Ref<Image> image = thumbnail->get_image();
+			if (image.is_valid()) {
+				image->save_png(disk_path);
+			}
+		} else {
+			// Fallbacks are cheap and not worth a file on disk
+			thumbnail = generate_default_thumbnail(p_request.path.get_extension().to_lower(), p_request.size);
+		}
+	}
+
+	CachedThumbnail cached;
+	cached.texture = thumbnail;
+	cached.modified_time = p_request.modified_time;
+
+	MutexLock lock(mutex);
+	thumbnail_cache.insert(_get_request_key(p_request.path, p_request.size), cached);
+	return thumbnail;
+}
+
+Ref<Texture2D> LupineAssetPreviewGenerator::_generate_uncached(const String &p_path, const Size2i &p_size) {
+	const String type = ResourceLoader::get_resource_type(p_path);
+	if (type.is_empty()) {
+		return Ref<Texture2D>();
+	}
+
+	if (ClassDB::is_parent_class(type, "Texture2D")) {
+		return generate_texture_thumbnail(p_path, p_size);
+	} else if (ClassDB::is_parent_class(type, "PackedScene")) {
+		return generate_scene_thumbnail(p_path, p_size);
+	} else if (ClassDB::is_parent_class(type, "Script")) {
+		return generate_script_thumbnail(p_path, p_size);
+	} else if (ClassDB::is_parent_class(type, "AudioStream")) {
+		return generate_audio_thumbnail(p_path, p_size);
+	}
+	return Ref<Texture2D>();
+}
+
+void LupineAssetPreviewGenerator::_start_workers() {
+	MutexLock lock(mutex);
+	int pending = request_queue.size();
+	for (int i = 0; i < MAX_WORKERS && pending > 0; i++) {
+		if (worker_tasks[i] == WorkerThreadPool::INVALID_TASK_ID) {
+			worker_tasks[i] = WorkerThreadPool::get_singleton()->add_template_task(this, &LupineAssetPreviewGenerator::_thumbnail_worker, i, false, SNAME("LupineThumbnails"));
+			pending--;
+		}
+	}
+}
+
+void LupineAssetPreviewGenerator::_thumbnail_worker(int p_slot) {
+	while (true) {
+		ThumbnailRequest request;
+		{
+			MutexLock lock(mutex);
+			if (request_queue.is_empty()) {
+				break;
+			}
+			// Newest first: those belong to what the user is looking at right now
+			request = request_queue.back()->get();
+			request_queue.pop_back();
+		}
+
+		Ref<Texture2D> thumbnail = _produce_thumbnail(request);
+
+		{
+			MutexLock lock(mutex);
+			queued_requests.erase(_get_request_key(request.path, request.size));
+		}
+		callable_mp(this, &LupineAssetPreviewGenerator::_emit_thumbnail_ready).call_deferred(request.path, Vector2i(request.size), thumbnail);
+	}
+
+	callable_mp(this, &LupineAssetPreviewGenerator::_on_worker_finished).call_deferred(p_slot);
+}
+
+void LupineAssetPreviewGenerator::_on_worker_finished(int p_slot) {
+	ERR_FAIL_INDEX(p_slot, MAX_WORKERS);
+	if (worker_tasks[p_slot] != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(worker_tasks[p_slot]);
+		worker_tasks[p_slot] = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	// Requests may have arrived after the worker found the queue empty
+	_start_workers();
+}
+
+void LupineAssetPreviewGenerator::_emit_thumbnail_ready(const String &p_path, const Vector2i &p_size, const Ref<Texture2D> &p_thumbnail) {
+	emit_signal(SNAME("thumbnail_ready"), p_path, p_size, p_thumbnail);
+}
+
+Ref<Texture2D> LupineAssetPreviewGenerator::generate_texture_thumbnail(const String &p_path, const Size2i &p_size) {
+	Dictionary metadata;
+	return texture_preview->generate_from_path(p_path, p_size, metadata);
+}
+
+Ref<Texture2D> LupineAssetPreviewGenerator::generate_scene_thumbnail(const String &p_path, const Size2i &p_size) {
+	// Uses the thumbnail the editor stores whenever the scene is saved
+	Dictionary metadata;
+	return scene_preview->generate_from_path(p_path, p_size, metadata);
+}
+
+Ref<Texture2D> LupineAssetPreviewGenerator::generate_script_thumbnail(const String &p_path, const Size2i &p_size) {
+	Dictionary metadata;
+	return script_preview->generate_from_path(p_path, p_size, metadata);
+}
+
+Ref<Texture2D> LupineAssetPreviewGenerator::generate_audio_thumbnail(const String &p_path, const Size2i &p_size) {
+	// Draws the stream's waveform
+	Dictionary metadata;
+	return audio_preview->generate_from_path(p_path, p_size, metadata);
+}
+
+Ref<Texture2D> LupineAssetPreviewGenerator::generate_default_thumbnail(const String &p_extension, const Size2i &p_size) {
+	const String key = _get_request_key(p_extension, p_size);
+	{
+		MutexLock lock(mutex);
+		const Ref<Texture2D> *existing = default_thumbnails.getptr(key);
+		if (existing) {
+			return *existing;
+		}
+	}
+
+	// A flat tile tinted per extension, with a darker label band at the bottom
+	const Color color = Color::from_hsv((p_extension.hash() % 360) / 360.0, 0.45, 0.55);
+	Ref<Image> image = Image::create_empty(MAX(p_size.width, 1), MAX(p_size.height, 1), false, Image::FORMAT_RGBA8);
+	image->fill(color);
+	const int band_height = image->get_height() / 4;
+	image->fill_rect(Rect2i(0, image->get_height() - band_height, image->get_width(), band_height), color.darkened(0.35));
+	Ref<Texture2D> thumbnail = ImageTexture::create_from_image(image);
+
+	MutexLock lock(mutex);
+	default_thumbnails[key] = thumbnail;
+	return thumbnail;
+}
+
 // Missing LupineAssetImportDialog implementation
 LupineAssetImportDialog::LupineAssetImportDialog(LupineAssetManager *p_manager) {
 	asset_manager = p_manager;
@@ -769,7 +1140,7 @@ LupineAssetImportDialog::~LupineAssetImportDialog() {
 
 // Missing _bind_methods implementations
 void LupineAssetPreviewGenerator::_bind_methods() {
-	// Bind methods for LupineAssetPreviewGenerator
+	ADD_SIGNAL(MethodInfo("thumbnail_ready", PropertyInfo(Variant::STRING, "path"), PropertyInfo(Variant::VECTOR2I, "size"), PropertyInfo(Variant::OBJECT, "thumbnail", PROPERTY_HINT_RESOURCE_TYPE, "Texture2D")));
 }
 
 void LupineAssetImportDialog::_bind_methods() {
@@ -17,8 +17,16 @@
 #include "scene/resources/texture.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/lru.h"
 #include "editor/editor_file_system.h"
 
+class EditorResourcePreviewGenerator;
+
 // Asset category definitions for Lupine-specific organization
 struct LupineAssetCategory {
 	String id;
@@ -76,11 +84,35 @@ private:
 	Button *import_button = nullptr;
 	Button *export_button = nullptr;
 
+	// A file listed by EditorFileSystem, as seen when an index build was queued
+	struct IndexSource {
+		String path;
+		String category_id;
+		uint64_t modified_time = 0;
+		bool force_update = false;
+	};
+
+	// Work handed to the background index task. The worker only reads the
+	// previous index, and the finished one replaces it on the main thread.
+	struct IndexBuild {
+		LocalVector<IndexSource> sources;
+		const HashMap<String, LupineAssetInfo> *previous = nullptr;
+		HashMap<String, LupineAssetInfo> *result = nullptr;
+	};
+
 	// Asset management
 	Vector<LupineAssetCategory> asset_categories;
 	HashMap<String, LupineAssetCategory*> category_map;
-	Vector<LupineAssetInfo> asset_cache;
-	HashMap<String, LupineAssetInfo*> asset_map;
+	HashMap<String, LupineAssetInfo> *asset_index = nullptr;
+
+	// Background indexing
+	IndexBuild *index_build = nullptr;
+	WorkerThreadPool::TaskID index_task = WorkerThreadPool::INVALID_TASK_ID;
+	HashSet<String> changed_paths;
+	bool index_update_queued = false;
+
+	// Listed items, so finished thumbnails can find their row
+	HashMap<String, int> asset_list_items;
 
 	// State
 	String current_category_id;
@@ -91,7 +123,6 @@ private:
 	void _create_ui();
 	void _setup_asset_categories();
 	void _populate_category_tree();
-	void _scan_assets_for_category(const String &p_category_id);
 	void _update_asset_list();
 	void _update_asset_preview();
 	void _generate_thumbnail(const String &p_path);
@@ -109,8 +140,19 @@ private:
 	void _import_asset_to_category(const String &p_source_path, const String &p_category_id);
 	void _export_asset(const String &p_asset_path);
 	void _perform_export(const String &p_target_path, const String &p_source_path);
-	void _refresh_asset_cache();
-	void _scan_directory_recursive(const String &p_path, const String &p_category_id);
+	bool _asset_matches_category(const LupineAssetInfo &p_asset, const String &p_category_id);
+
+	// Asset index
+	void _queue_index_update();
+	void _collect_index_sources(EditorFileSystemDirectory *p_dir, const String &p_category_id, HashSet<String> &r_seen, LocalVector<IndexSource> &r_sources);
+	void _build_index_task(IndexBuild *p_build);
+	void _on_index_built();
+	void _on_resources_reimported(const PackedStringArray &p_resources);
+	void _on_thumbnail_ready(const String &p_path, const Vector2i &p_size, const Ref<Texture2D> &p_thumbnail);
+	void _wait_for_index_task();
+	String _get_index_cache_path() const;
+	void _load_index_cache();
+	void _save_index_cache() const;
 
 protected:
 	static void _bind_methods();
@@ -144,13 +186,54 @@ public:
 	void import_template_assets(const String &p_template_path);
 };
 
-// Asset Preview Generator - creates thumbnails for different asset types
+// Asset Preview Generator - creates thumbnails for different asset types.
+// Requests are served from an LRU memory cache, then from a disk cache keyed by
+// path and modification time, and only then generated on a bounded set of
+// WorkerThreadPool tasks. Results are announced with the thumbnail_ready signal.
 class LupineAssetPreviewGenerator : public RefCounted {
 	GDCLASS(LupineAssetPreviewGenerator, RefCounted);
 
+public:
+	static const int MEMORY_CACHE_SIZE = 512;
+	static const int MAX_QUEUED_REQUESTS = 256;
+	static const int MAX_WORKERS = 2;
+
 private:
+	struct ThumbnailRequest {
+		String path;
+		uint64_t modified_time = 0;
+		Size2i size;
+	};
+
+	struct CachedThumbnail {
+		Ref<Texture2D> texture;
+		uint64_t modified_time = 0;
+	};
+
 	static LupineAssetPreviewGenerator *singleton;
-	HashMap<String, Ref<Texture2D>> thumbnail_cache;
+
+	Mutex mutex;
+	LRUCache<String, CachedThumbnail> thumbnail_cache;
+	List<ThumbnailRequest> request_queue;
+	HashSet<String> queued_requests;
+	WorkerThreadPool::TaskID worker_tasks[MAX_WORKERS];
+	HashMap<String, Ref<Texture2D>> default_thumbnails;
+	String disk_cache_dir;
+
+	// EditorResourcePreview's own generators, reused off the main thread
+	Ref<EditorResourcePreviewGenerator> texture_preview;
+	Ref<EditorResourcePreviewGenerator> scene_preview;
+	Ref<EditorResourcePreviewGenerator> script_preview;
+	Ref<EditorResourcePreviewGenerator> audio_preview;
+
+	static String _get_request_key(const String &p_path, const Size2i &p_size);
+	String _get_disk_cache_path(const String &p_path, uint64_t p_modified_time, const Size2i &p_size) const;
+	Ref<Texture2D> _generate_uncached(const String &p_path, const Size2i &p_size);
+	Ref<Texture2D> _produce_thumbnail(const ThumbnailRequest &p_request);
+	void _start_workers();
+	void _thumbnail_worker(int p_slot);
+	void _on_worker_finished(int p_slot);
+	void _emit_thumbnail_ready(const String &p_path, const Vector2i &p_size, const Ref<Texture2D> &p_thumbnail);
 
 protected:
 	static void _bind_methods();
@@ -162,8 +245,9 @@ public:
 	virtual ~LupineAssetPreviewGenerator();
 
 	// Thumbnail generation
+	Ref<Texture2D> request_thumbnail(const String &p_path, uint64_t p_modified_time, const Size2i &p_size = Size2i(64, 64));
 	Ref<Texture2D> generate_thumbnail(const String &p_path, const Size2i &p_size = Size2i(64, 64));
-	Ref<Texture2D> get_cached_thumbnail(const String &p_path);
+	Ref<Texture2D> get_cached_thumbnail(const String &p_path, const Size2i &p_size = Size2i(64, 64));
 	void clear_thumbnail_cache();
 
 	// Type-specific generators
@@ -4,11 +4,22 @@
 #include "scene/gui/line_edit.h"
 #include "scene/gui/separator.h"
 #include "scene/gui/box_container.h"
+#include "core/io/resource_saver.h"
+#include "editor/editor_node.h"
+#include "editor/editor_file_system.h"
+
+#include "modules/modules_enabled.gen.h" // For lupine.
+
+#ifdef MODULE_LUPINE_ENABLED
+#include "modules/lupine/dialogue_program.h"
+#endif
 
 void LupineDialogueEditor::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_on_add_node_pressed"), &LupineDialogueEditor::_on_add_node_pressed);
 	ClassDB::bind_method(D_METHOD("_on_connection_request"), &LupineDialogueEditor::_on_connection_request);
 	ClassDB::bind_method(D_METHOD("_on_disconnection_request"), &LupineDialogueEditor::_on_disconnection_request);
+	ClassDB::bind_method(D_METHOD("_on_export_pressed"), &LupineDialogueEditor::_on_export_pressed);
+	ClassDB::bind_method(D_METHOD("_on_export_file_selected"), &LupineDialogueEditor::_on_export_file_selected);
 }
 
 LupineDialogueEditor::LupineDialogueEditor() {
@@ -19,6 +30,7 @@ LupineDialogueEditor::LupineDialogueEditor() {
 	main_split = nullptr;
 	left_panel = nullptr;
 	dialogue_graph = nullptr;
+	export_dialog = nullptr;
 	next_node_id = 1;
 }
 
@@ -47,6 +59,7 @@ void LupineDialogueEditor::cleanup() {
 	main_split = nullptr;
 	left_panel = nullptr;
 	dialogue_graph = nullptr;
+	export_dialog = nullptr;
 	dialogue_nodes.clear();
 }
 
@@ -80,6 +93,23 @@ void LupineDialogueEditor::_create_ui() {
 	add_node_btn->connect("pressed", callable_mp(this, &LupineDialogueEditor::_on_add_node_pressed));
 	left_panel->add_child(add_node_btn);
 
+#ifdef MODULE_LUPINE_ENABLED
+	// Add compiled export button
+	Button *export_btn = memnew(Button);
+	export_btn->set_text("Export Compiled Dialogue...");
+	export_btn->set_tooltip_text("Save the graph as a compiled DialogueProgram resource that the game loads without parsing");
+	export_btn->connect("pressed", callable_mp(this, &LupineDialogueEditor::_on_export_pressed));
+	left_panel->add_child(export_btn);
+
+	export_dialog = memnew(FileDialog);
+	export_dialog->set_file_mode(FileDialog::FILE_MODE_SAVE_FILE);
+	export_dialog->set_access(FileDialog::ACCESS_RESOURCES);
+	export_dialog->set_title("Export Compiled Dialogue");
+	export_dialog->add_filter("*.res", "Compiled Dialogue");
+	export_dialog->connect("file_selected", callable_mp(this, &LupineDialogueEditor::_on_export_file_selected));
+	tool_panel->add_child(export_dialog);
+#endif
+
 	// Create graph edit
 	dialogue_graph = memnew(GraphEdit);
 	dialogue_graph->set_h_size_flags(Control::SIZE_EXPAND_FILL);
@@ -100,6 +130,7 @@ void LupineDialogueEditor::_create_dialogue_node(Vector2 p_position) {
 
 	// Create content container
 	VBoxContainer *content = memnew(VBoxContainer);
+	content->set_name("Content");
 	node->add_child(content);
 
 	// Add character name field
@@ -108,6 +139,7 @@ void LupineDialogueEditor::_create_dialogue_node(Vector2 p_position) {
 	content->add_child(char_label);
 
 	LineEdit *char_name = memnew(LineEdit);
+	char_name->set_name("Character");
 	char_name->set_placeholder("Character Name");
 	content->add_child(char_name);
 
@@ -117,6 +149,7 @@ void LupineDialogueEditor::_create_dialogue_node(Vector2 p_position) {
 	content->add_child(text_label);
 
 	TextEdit *dialogue_text = memnew(TextEdit);
+	dialogue_text->set_name("Text");
 	dialogue_text->set_custom_minimum_size(Size2(180, 80));
 	dialogue_text->set_placeholder("Enter dialogue text...");
 	content->add_child(dialogue_text);
@@ -144,3 +177,137 @@ void LupineDialogueEditor::_on_connection_request(const String &p_from, int p_fr
 void LupineDialogueEditor::_on_disconnection_request(const String &p_from, int p_from_port, const String &p_to, int p_to_port) {
 	dialogue_graph->disconnect_node(p_from, p_from_port, p_to, p_to_port);
 }
+
+void LupineDialogueEditor::_on_export_pressed() {
+	if (!export_dialog) {
+		return;
+	}
+	export_dialog->set_current_path("res://data/dialogues/dialogue.res");
+	export_dialog->popup_file_dialog();
+}
+
+void LupineDialogueEditor::_on_export_file_selected(const String &p_path) {
+	Error err = _export_compiled_dialogue(p_path);
+	if (err == OK) {
+		EditorNode::get_singleton()->show_accept("Dialogue exported to " + p_path, "Export Complete");
+	}
+}
+
+Dictionary LupineDialogueEditor::_build_dialogue() const {
+	// Successors of every node, in connection order
+	HashMap<StringName, LocalVector<StringName>> successors;
+	HashSet<StringName> has_predecessor;
+	for (const Ref<GraphEdit::Connection> &connection : dialogue_graph->get_connections()) {
+		successors[connection->from_node].push_back(connection->to_node);
+		has_predecessor.insert(connection->to_node);
+	}
+
+	HashMap<StringName, GraphNode *> nodes_by_name;
+	LocalVector<GraphNode *> roots;
+	LocalVector<GraphNode *> others;
+	for (const KeyValue<int, GraphNode *> &E : dialogue_nodes) {
+		nodes_by_name[E.value->get_name()] = E.value;
+		if (has_predecessor.has(E.value->get_name())) {
+			others.push_back(E.value);
+		} else {
+			roots.push_back(E.value);
+		}
+	}
+
+	// Lay lines out depth first, so that chains of lines stay next to each
+	// other and the first root becomes line 0. Nodes only reachable through
+	// cycles are appended after the roots.
+	LocalVector<GraphNode *> order;
+	HashSet<StringName> visited;
+	LocalVector<GraphNode *> stack;
+	for (LocalVector<GraphNode *> *starts : { &roots, &others }) {
+		for (GraphNode *start : *starts) {
+			stack.push_back(start);
+			while (!stack.is_empty()) {
+				GraphNode *node = stack[stack.size() - 1];
+				stack.resize(stack.size() - 1);
+				if (visited.has(node->get_name())) {
+					continue;
+				}
+				visited.insert(node->get_name());
+				order.push_back(node);
+
+				const LocalVector<StringName> *next_nodes = successors.getptr(node->get_name());
+				if (!next_nodes) {
+					continue;
+				}
+				for (int i = next_nodes->size() - 1; i >= 0; i--) {
+					GraphNode **next = nodes_by_name.getptr((*next_nodes)[i]);
+					if (next) {
+						stack.push_back(*next);
+					}
+				}
+			}
+		}
+	}
+
+	Array lines;
+	for (GraphNode *node : order) {
+		Dictionary line;
+		line["id"] = String(node->get_name());
+
+		LineEdit *character = Object::cast_to<LineEdit>(node->get_node_or_null(NodePath("Content/Character")));
+		TextEdit *text = Object::cast_to<TextEdit>(node->get_node_or_null(NodePath("Content/Text")));
+		line["speaker"] = character ? character->get_text() : String();
+		line["text"] = text ? text->get_text() : String();
+
+		// A single connection continues the conversation, several become
+		// choices that reply with the text of the node they lead to.
+		const LocalVector<StringName> *next_nodes = successors.getptr(node->get_name());
+		if (!next_nodes || next_nodes->is_empty()) {
+			line["next"] = -1;
+		} else if (next_nodes->size() == 1) {
+			line["next"] = String((*next_nodes)[0]);
+		} else {
+			Array choices;
+			for (const StringName &next_name : *next_nodes) {
+				GraphNode *const *next = nodes_by_name.getptr(next_name);
+				TextEdit *next_text = next ? Object::cast_to<TextEdit>((*next)->get_node_or_null(NodePath("Content/Text"))) : nullptr;
+				Dictionary choice;
+				choice["text"] = next_text ? next_text->get_text().get_slicec('\n', 0) : String(next_name);
+				choice["jump_to"] = String(next_name);
+				choices.push_back(choice);
+			}
+			line["choices"] = choices;
+			line["next"] = -1;
+		}
+		lines.push_back(line);
+	}
+
+	Dictionary dialogue;
+	dialogue["lines"] = lines;
+	return dialogue;
+}
+
+Error LupineDialogueEditor::_export_compiled_dialogue(const String &p_path) {
+#ifdef MODULE_LUPINE_ENABLED
+	ERR_FAIL_NULL_V(dialogue_graph, ERR_UNCONFIGURED);
+
+	Ref<DialogueProgram> program;
+	program.instantiate();
+	Error err = program->compile(_build_dialogue());
+	if (err != OK) {
+		EditorNode::get_singleton()->show_warning("Failed to compile dialogue: " + program->get_error_string(), "Export Error");
+		return err;
+	}
+
+	err = ResourceSaver::save(program, p_path);
+	if (err != OK) {
+		EditorNode::get_singleton()->show_warning("Failed to save compiled dialogue to " + p_path, "Export Error");
+		return err;
+	}
+
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	if (efs) {
+		efs->update_file(p_path);
+	}
+	return OK;
+#else
+	return ERR_UNAVAILABLE;
+#endif
+}
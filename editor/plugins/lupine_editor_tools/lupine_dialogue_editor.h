@@ -8,6 +8,7 @@
 #include "scene/gui/option_button.h"
 #include "scene/gui/split_container.h"
 #include "scene/gui/box_container.h"
+#include "scene/gui/file_dialog.h"
 
 // Node-based dialogue editor for visual conversation design
 class LupineDialogueEditor : public LupineEditorTool {
@@ -22,11 +23,19 @@ private:
 	int next_node_id = 1;
 	HashMap<int, GraphNode*> dialogue_nodes;
 
+	// Compiled export
+	FileDialog *export_dialog = nullptr;
+
 	void _create_ui();
 	void _create_dialogue_node(Vector2 p_position);
 	void _on_add_node_pressed();
 	void _on_connection_request(const String &p_from, int p_from_port, const String &p_to, int p_to_port);
 	void _on_disconnection_request(const String &p_from, int p_from_port, const String &p_to, int p_to_port);
+	void _on_export_pressed();
+	void _on_export_file_selected(const String &p_path);
+
+	Dictionary _build_dialogue() const;
+	Error _export_compiled_dialogue(const String &p_path);
 
 protected:
 	static void _bind_methods();
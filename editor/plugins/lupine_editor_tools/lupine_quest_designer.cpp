@@ -755,3 +755,142 @@ void LupineQuestDesigner::_on_add_flow_node_pressed() {
 	// Add new flow node to quest flow graph
 	print_line("Add flow node pressed");
 }
+
+// Export functionality
+// The dictionary layout matches what QuestRuntime::add_quest() reads, so
+// exported databases can be loaded by the quest runtime as they are.
+Dictionary LupineQuestDesigner::quest_to_dictionary(const LupineQuest &p_quest) {
+	Dictionary quest_dict;
+	quest_dict["id"] = p_quest.id;
+	quest_dict["title"] = p_quest.title;
+	quest_dict["description"] = p_quest.description;
+	quest_dict["category"] = p_quest.category;
+	quest_dict["level_requirement"] = p_quest.level_requirement;
+	quest_dict["status"] = (int)p_quest.status;
+
+	Array objectives_array;
+	for (int i = 0; i < p_quest.objectives.size(); i++) {
+		const LupineQuestObjective &objective = p_quest.objectives[i];
+		Dictionary objective_dict;
+		objective_dict["id"] = objective.id;
+		objective_dict["title"] = objective.title;
+		objective_dict["description"] = objective.description;
+		objective_dict["type"] = (int)objective.type;
+		objective_dict["parameters"] = objective.parameters;
+		objective_dict["is_optional"] = objective.is_optional;
+
+		Array prerequisites_array;
+		for (int j = 0; j < objective.prerequisites.size(); j++) {
+			prerequisites_array.push_back(objective.prerequisites[j]);
+		}
+		objective_dict["prerequisites"] = prerequisites_array;
+		objectives_array.push_back(objective_dict);
+	}
+	quest_dict["objectives"] = objectives_array;
+
+	Array rewards_array;
+	for (int i = 0; i < p_quest.rewards.size(); i++) {
+		const LupineQuestReward &reward = p_quest.rewards[i];
+		Dictionary reward_dict;
+		reward_dict["type"] = reward.type;
+		reward_dict["item_id"] = reward.item_id;
+		reward_dict["quantity"] = reward.quantity;
+		reward_dict["custom_data"] = reward.custom_data;
+		rewards_array.push_back(reward_dict);
+	}
+	quest_dict["rewards"] = rewards_array;
+
+	Array prerequisites_array;
+	for (int i = 0; i < p_quest.prerequisites.size(); i++) {
+		prerequisites_array.push_back(p_quest.prerequisites[i]);
+	}
+	quest_dict["prerequisites"] = prerequisites_array;
+	quest_dict["metadata"] = p_quest.metadata;
+
+	return quest_dict;
+}
+
+LupineQuest LupineQuestDesigner::quest_from_dictionary(const Dictionary &p_dict) {
+	LupineQuest quest;
+	quest.id = p_dict.get("id", "");
+	quest.title = p_dict.get("title", "");
+	quest.description = p_dict.get("description", "");
+	quest.category = p_dict.get("category", "");
+	quest.level_requirement = p_dict.get("level_requirement", 1);
+	quest.status = (LupineQuestStatus)CLAMP((int)p_dict.get("status", QUEST_STATUS_INACTIVE), (int)QUEST_STATUS_INACTIVE, (int)QUEST_STATUS_FAILED);
+
+	Array objectives_array = p_dict.get("objectives", Array());
+	for (int i = 0; i < objectives_array.size(); i++) {
+		Dictionary objective_dict = objectives_array[i];
+		LupineQuestObjective objective;
+		objective.id = objective_dict.get("id", "");
+		objective.title = objective_dict.get("title", "");
+		objective.description = objective_dict.get("description", "");
+		objective.type = (LupineQuestObjectiveType)CLAMP((int)objective_dict.get("type", QUEST_OBJECTIVE_CUSTOM), (int)QUEST_OBJECTIVE_TALK, (int)QUEST_OBJECTIVE_CUSTOM);
+		objective.parameters = objective_dict.get("parameters", Dictionary());
+		objective.is_optional = objective_dict.get("is_optional", false);
+
+		Array prerequisites_array = objective_dict.get("prerequisites", Array());
+		for (int j = 0; j < prerequisites_array.size(); j++) {
+			objective.prerequisites.push_back(prerequisites_array[j]);
+		}
+		quest.objectives.push_back(objective);
+	}
+
+	Array rewards_array = p_dict.get("rewards", Array());
+	for (int i = 0; i < rewards_array.size(); i++) {
+		Dictionary reward_dict = rewards_array[i];
+		LupineQuestReward reward;
+		reward.type = reward_dict.get("type", "");
+		reward.item_id = reward_dict.get("item_id", "");
+		reward.quantity = reward_dict.get("quantity", 1);
+		reward.custom_data = reward_dict.get("custom_data", Dictionary());
+		quest.rewards.push_back(reward);
+	}
+
+	Array prerequisites_array = p_dict.get("prerequisites", Array());
+	for (int i = 0; i < prerequisites_array.size(); i++) {
+		quest.prerequisites.push_back(prerequisites_array[i]);
+	}
+	quest.metadata = p_dict.get("metadata", Dictionary());
+
+	return quest;
+}
+
+void LupineQuestDesigner::export_quest_data(const String &p_path) {
+	// Keyed by quest id, like the res://data/quests.json read by QuestSystem.gd
+	Dictionary quests_dict;
+	for (int i = 0; i < quest_database.size(); i++) {
+		quests_dict[quest_database[i].id] = quest_to_dictionary(quest_database[i]);
+	}
+
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(file.is_null(), "Cannot write quest data to " + p_path);
+	file->store_string(JSON::stringify(quests_dict, "\t"));
+}
+
+void LupineQuestDesigner::import_quest_data(const String &p_path) {
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_MSG(file.is_null(), "Cannot read quest data from " + p_path);
+
+	Ref<JSON> json;
+	json.instantiate();
+	Error parse_result = json->parse(file->get_as_text());
+	ERR_FAIL_COND_MSG(parse_result != OK, vformat("Invalid quest data in %s: %s", p_path, json->get_error_message()));
+
+	Dictionary quests_dict = json->get_data();
+	for (const KeyValue<Variant, Variant> &kv : quests_dict) {
+		LupineQuest quest = quest_from_dictionary(kv.value);
+		if (quest.id.is_empty()) {
+			quest.id = kv.key;
+		}
+		delete_quest(quest.id);
+		quest_database.push_back(quest);
+	}
+
+	// Adding quests can move the database, so rebuild the lookup afterwards.
+	quest_map.clear();
+	for (int i = 0; i < quest_database.size(); i++) {
+		quest_map[quest_database[i].id] = const_cast<LupineQuest *>(&quest_database[i]);
+	}
+}
@@ -388,6 +388,11 @@ void LupineWorldBuilder::_place_entity_at_position(Vector2 p_position) {
 	current_scene->add_child(entity_instance);
 	entity_instance->set_owner(current_scene);
 
+	// Scenes outside the tree send no node_added, so index explicitly
+	if (scene_canvas) {
+		scene_canvas->update_node(entity_instance);
+	}
+
 	// Select the new entity
 	on_node_selected(entity_instance);
 
@@ -584,7 +589,6 @@ LupineSceneCanvas::LupineSceneCanvas(LupineWorldBuilder *p_builder) {
 	show_gizmos = true;
 	grid_color = Color(0.3, 0.3, 0.3, 0.5);
 	selection_color = Color(1.0, 0.5, 0.0, 0.8);
-	hovered_node = nullptr;
 	is_dragging = false;
 
 	set_focus_mode(Control::FOCUS_ALL);
@@ -592,10 +596,20 @@ LupineSceneCanvas::LupineSceneCanvas(LupineWorldBuilder *p_builder) {
 }
 
 LupineSceneCanvas::~LupineSceneCanvas() {
+	_disconnect_tree_signals();
 }
 
 void LupineSceneCanvas::_notification(int p_what) {
 	switch (p_what) {
+		case NOTIFICATION_ENTER_TREE:
+		case NOTIFICATION_VISIBILITY_CHANGED: {
+			set_process_internal(is_visible_in_tree() && scene_root);
+		} break;
+
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			_sync_index_transforms();
+		} break;
+
 		case NOTIFICATION_DRAW: {
 			if (show_grid) {
 				_draw_grid();
@@ -629,8 +643,9 @@ void LupineSceneCanvas::_gui_input(const Ref<InputEvent> &p_event) {
 		Vector2 mouse_pos = _canvas_to_world(mm->get_position());
 		Node *node_under_mouse = _get_node_at_position(mouse_pos);
 
-		if (node_under_mouse != hovered_node) {
-			hovered_node = node_under_mouse;
+		ObjectID node_under_mouse_id = node_under_mouse ? node_under_mouse->get_instance_id() : ObjectID();
+		if (node_under_mouse_id != hovered_node_id) {
+			hovered_node_id = node_under_mouse_id;
 			queue_redraw();
 		}
 
@@ -639,10 +654,206 @@ void LupineSceneCanvas::_gui_input(const Ref<InputEvent> &p_event) {
 }
 
 void LupineSceneCanvas::set_scene_root(Node *p_scene) {
+	_disconnect_tree_signals();
+	_clear_index();
+
 	scene_root = p_scene;
+	hovered_node_id = ObjectID();
+
+	if (scene_root) {
+		_index_subtree(scene_root);
+		_connect_tree_signals();
+	}
+	set_process_internal(is_visible_in_tree() && scene_root);
+	queue_redraw();
+}
+
+void LupineSceneCanvas::update_node(Node *p_node) {
+	if (!_is_tracked_node(p_node)) {
+		return;
+	}
+
+	// Moving a node moves its descendants as well
+	_index_subtree(p_node);
 	queue_redraw();
 }
 
+bool LupineSceneCanvas::_is_tracked_node(Node *p_node) const {
+	return p_node && scene_root && (p_node == scene_root || scene_root->is_ancestor_of(p_node));
+}
+
+AABB LupineSceneCanvas::_get_gizmo_box(const Vector2 &p_position) {
+	return AABB(Vector3(p_position.x - PICK_RADIUS, p_position.y - PICK_RADIUS, 0), Vector3(PICK_RADIUS * 2, PICK_RADIUS * 2, 0));
+}
+
+void LupineSceneCanvas::_index_subtree(Node *p_node) {
+	_index_node(p_node);
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_index_subtree(p_node->get_child(i));
+	}
+}
+
+void LupineSceneCanvas::_index_node(Node *p_node) {
+	Node2D *node_2d = Object::cast_to<Node2D>(p_node);
+	if (!node_2d) {
+		return;
+	}
+
+	const Vector2 position = node_2d->get_global_position();
+	const AABB box = _get_gizmo_box(position);
+
+	const uint32_t *existing = gizmo_lookup.getptr(p_node->get_instance_id());
+	if (existing) {
+		GizmoEntry &entry = gizmo_entries[*existing];
+		entry.position = position;
+		entry.label = p_node->get_name();
+		gizmo_bvh.update(entry.bvh_id, box);
+		return;
+	}
+
+	uint32_t index;
+	if (!free_gizmo_entries.is_empty()) {
+		index = free_gizmo_entries[free_gizmo_entries.size() - 1];
+		free_gizmo_entries.remove_at(free_gizmo_entries.size() - 1);
+	} else {
+		index = gizmo_entries.size();
+		gizmo_entries.push_back(GizmoEntry());
+	}
+
+	GizmoEntry &entry = gizmo_entries[index];
+	entry.node_id = p_node->get_instance_id();
+	entry.position = position;
+	entry.label = p_node->get_name();
+	entry.bvh_id = gizmo_bvh.insert(box, (void *)(uintptr_t)index);
+	gizmo_lookup.insert(entry.node_id, index);
+}
+
+void LupineSceneCanvas::_unindex_node(ObjectID p_node_id) {
+	const uint32_t *existing = gizmo_lookup.getptr(p_node_id);
+	if (!existing) {
+		return;
+	}
+
+	const uint32_t index = *existing;
+	GizmoEntry &entry = gizmo_entries[index];
+	gizmo_bvh.remove(entry.bvh_id);
+	entry = GizmoEntry();
+	free_gizmo_entries.push_back(index);
+	gizmo_lookup.erase(p_node_id);
+}
+
+void LupineSceneCanvas::_clear_index() {
+	gizmo_bvh.clear();
+	gizmo_entries.clear();
+	free_gizmo_entries.clear();
+	gizmo_lookup.clear();
+}
+
+void LupineSceneCanvas::_query_gizmos(const Rect2 &p_world_rect, LocalVector<uint32_t> &r_entries) {
+	struct Collector {
+		LocalVector<uint32_t> *entries = nullptr;
+
+		bool operator()(void *p_data) {
+			entries->push_back((uint32_t)(uintptr_t)p_data);
+			return false; // Keep going
+		}
+	};
+
+	Collector collector;
+	collector.entries = &r_entries;
+	const AABB box(Vector3(p_world_rect.position.x, p_world_rect.position.y, 0), Vector3(p_world_rect.size.x, p_world_rect.size.y, 0));
+	gizmo_bvh.aabb_query(box, collector);
+}
+
+void LupineSceneCanvas::_connect_tree_signals() {
+	if (!scene_root || !scene_root->is_inside_tree()) {
+		return;
+	}
+
+	connected_tree = scene_root->get_tree();
+	connected_tree->connect("node_added", callable_mp(this, &LupineSceneCanvas::_on_node_added));
+	connected_tree->connect("node_removed", callable_mp(this, &LupineSceneCanvas::_on_node_removed));
+	connected_tree->connect("node_renamed", callable_mp(this, &LupineSceneCanvas::_on_node_renamed));
+}
+
+void LupineSceneCanvas::_disconnect_tree_signals() {
+	if (!connected_tree) {
+		return;
+	}
+
+	connected_tree->disconnect("node_added", callable_mp(this, &LupineSceneCanvas::_on_node_added));
+	connected_tree->disconnect("node_removed", callable_mp(this, &LupineSceneCanvas::_on_node_removed));
+	connected_tree->disconnect("node_renamed", callable_mp(this, &LupineSceneCanvas::_on_node_renamed));
+	connected_tree = nullptr;
+}
+
+void LupineSceneCanvas::_on_node_added(Node *p_node) {
+	// Children report themselves, so only this node is indexed
+	if (_is_tracked_node(p_node)) {
+		_index_node(p_node);
+		queue_redraw();
+	}
+}
+
+void LupineSceneCanvas::_on_node_removed(Node *p_node) {
+	if (p_node == scene_root) {
+		set_scene_root(nullptr);
+		return;
+	}
+
+	const ObjectID node_id = p_node->get_instance_id();
+	if (gizmo_lookup.has(node_id)) {
+		_unindex_node(node_id);
+		if (node_id == hovered_node_id) {
+			hovered_node_id = ObjectID();
+		}
+		queue_redraw();
+	}
+}
+
+void LupineSceneCanvas::_on_node_renamed(Node *p_node) {
+	const uint32_t *existing = gizmo_lookup.getptr(p_node->get_instance_id());
+	if (existing) {
+		gizmo_entries[*existing].label = p_node->get_name();
+		queue_redraw();
+	}
+}
+
+void LupineSceneCanvas::_sync_index_transforms() {
+	// Undo/redo, scripts, animations and other tools can all move nodes, and
+	// none of them tell us. Global transforms are cached by the nodes, so
+	// comparing positions once a frame is cheap; only moved nodes touch the BVH.
+	LocalVector<ObjectID> freed;
+	bool moved = false;
+	for (const KeyValue<ObjectID, uint32_t> &E : gizmo_lookup) {
+		Node2D *node_2d = ObjectDB::get_instance<Node2D>(E.key);
+		if (!node_2d) {
+			// Scenes outside the tree send no node_removed
+			freed.push_back(E.key);
+			continue;
+		}
+
+		GizmoEntry &entry = gizmo_entries[E.value];
+		const Vector2 position = node_2d->get_global_position();
+		if (position != entry.position) {
+			entry.position = position;
+			gizmo_bvh.update(entry.bvh_id, _get_gizmo_box(position));
+			moved = true;
+		}
+	}
+
+	for (const ObjectID &node_id : freed) {
+		_unindex_node(node_id);
+		if (node_id == hovered_node_id) {
+			hovered_node_id = ObjectID();
+		}
+	}
+
+	if (moved || !freed.is_empty()) {
+		queue_redraw();
+	}
+}
+
 void LupineSceneCanvas::emit_canvas_clicked(Vector2 p_position) {
 	emit_signal("canvas_clicked", p_position);
 	if (world_builder) {
@@ -677,39 +888,100 @@ void LupineSceneCanvas::_draw_grid() {
 }
 
 void LupineSceneCanvas::_draw_gizmos() {
-	if (!scene_root) {
+	if (!scene_root || gizmo_lookup.is_empty()) {
 		return;
 	}
 
-	// Draw gizmos for all child nodes
-	_draw_node_gizmos(scene_root);
-}
-
-void LupineSceneCanvas::_draw_node_gizmos(Node *p_node) {
-	if (!p_node) {
+	// Only gizmos overlapping the visible area are touched
+	const Vector2 view_begin = _canvas_to_world(Vector2());
+	const Rect2 view_rect(view_begin, _canvas_to_world(get_size()) - view_begin);
+	LocalVector<uint32_t> visible;
+	_query_gizmos(view_rect.grow(PICK_RADIUS), visible);
+	if (visible.is_empty()) {
 		return;
 	}
 
-	// Draw gizmo for 2D nodes
-	Node2D *node_2d = Object::cast_to<Node2D>(p_node);
-	if (node_2d) {
-		Vector2 world_pos = node_2d->get_global_position();
-		Vector2 canvas_pos = _world_to_canvas(world_pos);
+	Vector2 circle[GIZMO_SEGMENTS];
+	for (int i = 0; i < GIZMO_SEGMENTS; i++) {
+		circle[i] = Vector2(GIZMO_RADIUS, 0).rotated(Math::TAU * i / GIZMO_SEGMENTS);
+	}
+
+	// All discs go into a single triangle array and all outlines into a single multiline
+	const int vertex_count = visible.size() * (GIZMO_SEGMENTS + 1);
+	Vector<Point2> disc_points;
+	Vector<Color> disc_colors;
+	Vector<int> disc_indices;
+	Vector<Vector2> outline_points;
+	disc_points.resize(vertex_count);
+	disc_colors.resize(vertex_count);
+	disc_indices.resize(visible.size() * GIZMO_SEGMENTS * 3);
+	outline_points.resize(visible.size() * GIZMO_SEGMENTS * 2);
+
+	Point2 *points_w = disc_points.ptrw();
+	Color *colors_w = disc_colors.ptrw();
+	int *indices_w = disc_indices.ptrw();
+	Vector2 *outline_w = outline_points.ptrw();
+
+	LocalVector<uint32_t> labeled;
+	LocalVector<ObjectID> stale;
+	const bool draw_all_labels = visible.size() <= (uint32_t)MAX_GIZMO_LABELS;
+	int drawn = 0;
+
+	for (uint32_t index : visible) {
+		const GizmoEntry &entry = gizmo_entries[index];
+		if (!ObjectDB::get_instance(entry.node_id)) {
+			stale.push_back(entry.node_id);
+			continue;
+		}
 
-		// Draw position indicator
-		Color gizmo_color = (p_node == hovered_node) ? selection_color : Color(1, 1, 1);
-		draw_circle(canvas_pos, 4, gizmo_color);
-		draw_circle(canvas_pos, 4, Color(0, 0, 0), false, 1.0);
+		const bool hovered = entry.node_id == hovered_node_id;
+		const Color gizmo_color = hovered ? selection_color : Color(1, 1, 1);
+		const Vector2 canvas_pos = _world_to_canvas(entry.position);
+
+		const int base = drawn * (GIZMO_SEGMENTS + 1);
+		points_w[base] = canvas_pos;
+		colors_w[base] = gizmo_color;
+		for (int i = 0; i < GIZMO_SEGMENTS; i++) {
+			const int next = (i + 1) % GIZMO_SEGMENTS;
+			points_w[base + 1 + i] = canvas_pos + circle[i];
+			colors_w[base + 1 + i] = gizmo_color;
+
+			const int triangle = (drawn * GIZMO_SEGMENTS + i) * 3;
+			indices_w[triangle + 0] = base;
+			indices_w[triangle + 1] = base + 1 + i;
+			indices_w[triangle + 2] = base + 1 + next;
+
+			const int segment = (drawn * GIZMO_SEGMENTS + i) * 2;
+			outline_w[segment + 0] = canvas_pos + circle[i];
+			outline_w[segment + 1] = canvas_pos + circle[next];
+		}
+		drawn++;
 
-		// Draw name label
-		String name = p_node->get_name();
-		Vector2 text_pos = canvas_pos + Vector2(8, -8);
-		draw_string(get_theme_default_font(), text_pos, name, HORIZONTAL_ALIGNMENT_LEFT, -1, 12, gizmo_color);
+		// Text cannot be batched, so crowded views only label the hovered node
+		if (draw_all_labels || hovered) {
+			labeled.push_back(index);
+		}
 	}
 
-	// Recursively draw gizmos for children
-	for (int i = 0; i < p_node->get_child_count(); i++) {
-		_draw_node_gizmos(p_node->get_child(i));
+	for (const ObjectID &node_id : stale) {
+		_unindex_node(node_id);
+	}
+
+	if (drawn > 0) {
+		disc_points.resize(drawn * (GIZMO_SEGMENTS + 1));
+		disc_colors.resize(drawn * (GIZMO_SEGMENTS + 1));
+		disc_indices.resize(drawn * GIZMO_SEGMENTS * 3);
+		outline_points.resize(drawn * GIZMO_SEGMENTS * 2);
+
+		RenderingServer::get_singleton()->canvas_item_add_triangle_array(get_canvas_item(), disc_indices, disc_points, disc_colors);
+		draw_multiline(outline_points, Color(0, 0, 0), 1.0);
+	}
+
+	Ref<Font> font = get_theme_default_font();
+	for (uint32_t index : labeled) {
+		const GizmoEntry &entry = gizmo_entries[index];
+		const Color gizmo_color = (entry.node_id == hovered_node_id) ? selection_color : Color(1, 1, 1);
+		draw_string(font, _world_to_canvas(entry.position) + Vector2(8, -8), entry.label, HORIZONTAL_ALIGNMENT_LEFT, -1, 12, gizmo_color);
 	}
 }
 
@@ -723,35 +995,27 @@ Node *LupineSceneCanvas::_get_node_at_position(Vector2 p_position) {
 		return nullptr;
 	}
 
-	return _find_node_at_position(scene_root, p_position);
-}
-
-Node *LupineSceneCanvas::_find_node_at_position(Node *p_node, Vector2 p_position) {
-	if (!p_node) {
-		return nullptr;
-	}
-
-	// Check 2D nodes
-	Node2D *node_2d = Object::cast_to<Node2D>(p_node);
-	if (node_2d) {
-		Vector2 node_pos = node_2d->get_global_position();
-		float distance = node_pos.distance_to(p_position);
-
-		// Check if position is within a reasonable selection radius
-		if (distance < 16.0) {
-			return p_node;
+	LocalVector<uint32_t> candidates;
+	_query_gizmos(Rect2(p_position - Vector2(PICK_RADIUS, PICK_RADIUS), Vector2(PICK_RADIUS, PICK_RADIUS) * 2), candidates);
+
+	// Closest gizmo within the selection radius wins
+	Node *closest = nullptr;
+	float closest_distance = PICK_RADIUS;
+	for (uint32_t index : candidates) {
+		const GizmoEntry &entry = gizmo_entries[index];
+		const float distance = entry.position.distance_to(p_position);
+		if (distance >= closest_distance) {
+			continue;
 		}
-	}
 
-	// Check children
-	for (int i = 0; i < p_node->get_child_count(); i++) {
-		Node *found = _find_node_at_position(p_node->get_child(i), p_position);
-		if (found) {
-			return found;
+		Node *node = ObjectDB::get_instance<Node>(entry.node_id);
+		if (node) {
+			closest = node;
+			closest_distance = distance;
 		}
 	}
 
-	return nullptr;
+	return closest;
 }
 
 Vector2 LupineSceneCanvas::_world_to_canvas(Vector2 p_world_pos) {
@@ -982,6 +1246,10 @@ void LupinePropertyPanel::_on_property_control_changed(const String &p_name, con
 		} else if (node_3d) {
 			node_3d->set_position(p_value);
 		}
+
+		if (world_builder->get_scene_canvas()) {
+			world_builder->get_scene_canvas()->update_node(current_node);
+		}
 	} else {
 		// Set as metadata
 		current_node->set_meta(p_name, p_value);
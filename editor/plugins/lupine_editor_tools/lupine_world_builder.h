@@ -19,6 +19,8 @@
 #include "scene/resources/texture.h"
 #include "scene/resources/packed_scene.h"
 #include "core/io/resource_loader.h"
+#include "core/math/dynamic_bvh.h"
+#include "core/templates/local_vector.h"
 
 class LupineEntityPalette;
 class LupineSceneCanvas;
@@ -115,6 +117,7 @@ public:
 	LupineEntity *get_entity_type(const String &p_id);
 	Vector<LupineEntity> get_entities_by_category(const String &p_category);
 	const Vector<LupineEntity> &get_entity_library() const { return entity_library; }
+	LupineSceneCanvas *get_scene_canvas() const { return scene_canvas; }
 
 	// Tool settings
 	void set_snap_to_grid(bool p_enabled) { snap_to_grid = p_enabled; }
@@ -153,14 +156,36 @@ public:
 	void set_selected_entity(const LupineEntity *p_entity);
 };
 
-// Scene Canvas - visual representation of the scene with placement tools
+// Scene Canvas - visual representation of the scene with placement tools.
+// Node2D gizmos live in a DynamicBVH that follows tree changes through the
+// SceneTree signals and transform changes through a per-frame position check,
+// so picking and culling never walk the whole scene.
 class LupineSceneCanvas : public Control {
 	GDCLASS(LupineSceneCanvas, Control);
 
+public:
+	static constexpr float PICK_RADIUS = 16.0;
+	static constexpr float GIZMO_RADIUS = 4.0;
+	static constexpr int GIZMO_SEGMENTS = 8;
+	static constexpr int MAX_GIZMO_LABELS = 256;
+
 private:
+	struct GizmoEntry {
+		ObjectID node_id;
+		DynamicBVH::ID bvh_id;
+		Vector2 position;
+		String label;
+	};
+
 	LupineWorldBuilder *world_builder = nullptr;
 	Node *scene_root = nullptr;
 
+	// Spatial index
+	DynamicBVH gizmo_bvh;
+	LocalVector<GizmoEntry> gizmo_entries;
+	LocalVector<uint32_t> free_gizmo_entries;
+	HashMap<ObjectID, uint32_t> gizmo_lookup;
+
 	// Visual state
 	bool show_grid = true;
 	bool show_gizmos = true;
@@ -168,19 +193,33 @@ private:
 	Color selection_color = Color(1.0, 0.5, 0.0, 0.8);
 
 	// Interaction state
-	Node *hovered_node = nullptr;
+	ObjectID hovered_node_id;
+	SceneTree *connected_tree = nullptr;
 	Vector2 last_mouse_position;
 	bool is_dragging = false;
 
 	void _draw_grid();
 	void _draw_gizmos();
-	void _draw_node_gizmos(Node *p_node);
 	void _draw_selection();
 	Node *_get_node_at_position(Vector2 p_position);
-	Node *_find_node_at_position(Node *p_node, Vector2 p_position);
 	Vector2 _world_to_canvas(Vector2 p_world_pos);
 	Vector2 _canvas_to_world(Vector2 p_canvas_pos);
 
+	// Spatial index maintenance
+	static AABB _get_gizmo_box(const Vector2 &p_position);
+	bool _is_tracked_node(Node *p_node) const;
+	void _index_subtree(Node *p_node);
+	void _index_node(Node *p_node);
+	void _unindex_node(ObjectID p_node_id);
+	void _clear_index();
+	void _query_gizmos(const Rect2 &p_world_rect, LocalVector<uint32_t> &r_entries);
+	void _connect_tree_signals();
+	void _disconnect_tree_signals();
+	void _on_node_added(Node *p_node);
+	void _on_node_removed(Node *p_node);
+	void _on_node_renamed(Node *p_node);
+	void _sync_index_transforms();
+
 protected:
 	static void _bind_methods();
 	virtual void _notification(int p_what);
@@ -193,6 +232,9 @@ public:
 	void set_scene_root(Node *p_scene);
 	Node *get_scene_root() const { return scene_root; }
 
+	// Re-index a node and its descendants after their transforms changed
+	void update_node(Node *p_node);
+
 	// Visual settings
 	void set_show_grid(bool p_show) { show_grid = p_show; queue_redraw(); }
 	bool get_show_grid() const { return show_grid; }
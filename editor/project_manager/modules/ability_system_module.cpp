@@ -13,24 +13,30 @@ void AbilitySystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("signal ability_upgraded(ability_id: String, new_level: int)");
 	p_file->store_line("signal cooldown_started(ability_id: String, duration: float)");
 	p_file->store_line("signal cooldown_finished(ability_id: String)");
+	p_file->store_line("signal buff_expired(ability_id: String, target: Node)");
 	p_file->store_line("");
 	p_file->store_line("# Ability data");
 	p_file->store_line("var ability_database: Dictionary = {}");
 	p_file->store_line("var learned_abilities: Dictionary = {}");
-	p_file->store_line("var ability_cooldowns: Dictionary = {}");
-	p_file->store_line("var active_buffs: Array[Dictionary] = []");
+	p_file->store_line("");
+	p_file->store_line("# Cooldowns, buffs and damage over time run in a native timer wheel, so");
+	p_file->store_line("# frames only pay for the timers that expire in them");
+	p_file->store_line("var scheduler: EffectScheduler");
 	p_file->store_line("");
 	p_file->store_line("# Hotbar abilities");
 	p_file->store_line("var hotbar_abilities: Array[String] = [\"\", \"\", \"\", \"\", \"\"]");
 	p_file->store_line("");
 	p_file->store_line("func _ready():");
+	p_file->store_line("\tscheduler = EffectScheduler.new()");
+	p_file->store_line("\tscheduler.cooldown_finished.connect(_on_cooldown_finished)");
+	p_file->store_line("\tscheduler.effect_expired.connect(_on_effect_expired)");
+	p_file->store_line("\tscheduler.effect_ticked.connect(_on_effect_ticked)");
+	p_file->store_line("\tscheduler.stat_modifiers_changed.connect(_on_stat_modifiers_changed)");
+	p_file->store_line("\tadd_child(scheduler)");
+	p_file->store_line("\t");
 	p_file->store_line("\t_load_ability_database()");
 	p_file->store_line("\t_setup_default_abilities()");
 	p_file->store_line("");
-	p_file->store_line("func _process(delta):");
-	p_file->store_line("\t_update_cooldowns(delta)");
-	p_file->store_line("\t_update_buffs(delta)");
-	p_file->store_line("");
 	p_file->store_line("func use_ability(ability_id: String, caster: Node, target_position: Vector2 = Vector2.ZERO) -> bool:");
 	p_file->store_line("\t# Check if ability exists and is learned");
 	p_file->store_line("\tif not learned_abilities.has(ability_id):");
@@ -120,16 +126,17 @@ void AbilitySystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\tattack_area.queue_free()");
 	p_file->store_line("");
 	p_file->store_line("func _cast_buff_ability(ability_id: String, data: Dictionary, level: int, caster: Node):");
-	p_file->store_line("\tvar buff = {");
-	p_file->store_line("\t\t\"id\": ability_id,");
-	p_file->store_line("\t\t\"duration\": _get_ability_stat(data, \"duration\", level),");
-	p_file->store_line("\t\t\"effects\": data.effects,");
-	p_file->store_line("\t\t\"level\": level,");
-	p_file->store_line("\t\t\"target\": caster");
-	p_file->store_line("\t}");
+	p_file->store_line("\t# Each effect is {\"stat\": name, \"value\": amount, \"value_scaling\": amount per level}");
+	p_file->store_line("\tvar modifiers = {}");
+	p_file->store_line("\tfor effect in data.get(\"effects\", []):");
+	p_file->store_line("\t\tvar value = effect.get(\"value\", 0.0) + effect.get(\"value_scaling\", 0.0) * (level - 1)");
+	p_file->store_line("\t\tmodifiers[effect.stat] = modifiers.get(effect.stat, 0.0) + value");
 	p_file->store_line("\t");
-	p_file->store_line("\tactive_buffs.append(buff)");
-	p_file->store_line("\t_apply_buff_effects(buff, true)");
+	p_file->store_line("\tscheduler.add_buff(caster, ability_id, _get_ability_stat(data, \"duration\", level), modifiers)");
+	p_file->store_line("");
+	p_file->store_line("# Deals damage to target every interval seconds for duration seconds");
+	p_file->store_line("func apply_damage_over_time(target: Node, effect_id: String, duration: float, interval: float, damage: float) -> int:");
+	p_file->store_line("\treturn scheduler.add_dot(target, effect_id, duration, interval, damage)");
 	p_file->store_line("");
 	p_file->store_line("func _cast_heal_ability(ability_id: String, data: Dictionary, level: int, caster: Node):");
 	p_file->store_line("\tvar heal_amount = _get_ability_stat(data, \"heal_amount\", level)");
@@ -161,39 +168,30 @@ void AbilitySystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\treturn true");
 	p_file->store_line("");
 	p_file->store_line("func start_cooldown(ability_id: String, duration: float):");
-	p_file->store_line("\tability_cooldowns[ability_id] = duration");
+	p_file->store_line("\tscheduler.start_cooldown(null, ability_id, duration)");
 	p_file->store_line("\tcooldown_started.emit(ability_id, duration)");
 	p_file->store_line("");
 	p_file->store_line("func is_on_cooldown(ability_id: String) -> bool:");
-	p_file->store_line("\treturn ability_cooldowns.has(ability_id) and ability_cooldowns[ability_id] > 0");
+	p_file->store_line("\treturn scheduler.is_on_cooldown(null, ability_id)");
 	p_file->store_line("");
 	p_file->store_line("func get_cooldown_remaining(ability_id: String) -> float:");
-	p_file->store_line("\treturn ability_cooldowns.get(ability_id, 0.0)");
+	p_file->store_line("\treturn scheduler.get_cooldown_remaining(null, ability_id)");
+	p_file->store_line("");
+	p_file->store_line("func _on_cooldown_finished(ability_id: StringName, _owner: Object):");
+	p_file->store_line("\tcooldown_finished.emit(ability_id)");
 	p_file->store_line("");
-	p_file->store_line("func _update_cooldowns(delta: float):");
-	p_file->store_line("\tfor ability_id in ability_cooldowns.keys():");
-	p_file->store_line("\t\tability_cooldowns[ability_id] -= delta");
-	p_file->store_line("\t\tif ability_cooldowns[ability_id] <= 0:");
-	p_file->store_line("\t\t\tability_cooldowns.erase(ability_id)");
-	p_file->store_line("\t\t\tcooldown_finished.emit(ability_id)");
+	p_file->store_line("func _on_effect_expired(_id: int, effect_id: StringName, target: Object):");
+	p_file->store_line("\tbuff_expired.emit(effect_id, target)");
 	p_file->store_line("");
-	p_file->store_line("func _update_buffs(delta: float):");
-	p_file->store_line("\tfor i in range(active_buffs.size() - 1, -1, -1):");
-	p_file->store_line("\t\tvar buff = active_buffs[i]");
-	p_file->store_line("\t\tbuff.duration -= delta");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\tif buff.duration <= 0:");
-	p_file->store_line("\t\t\t_apply_buff_effects(buff, false)");
-	p_file->store_line("\t\t\tactive_buffs.remove_at(i)");
+	p_file->store_line("func _on_effect_ticked(_id: int, _effect_id: StringName, target: Object, damage: float):");
+	p_file->store_line("\tif target.has_method(\"take_damage\"):");
+	p_file->store_line("\t\ttarget.take_damage(damage)");
 	p_file->store_line("");
-	p_file->store_line("func _apply_buff_effects(buff: Dictionary, apply: bool):");
-	p_file->store_line("\tfor effect in buff.effects:");
-	p_file->store_line("\t\tvar value = _get_ability_stat({\"effects\": buff.effects}, effect.stat, buff.level)");
-	p_file->store_line("\t\tif not apply:");
-	p_file->store_line("\t\t\tvalue = -value");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\tif PlayerStats and PlayerStats.has_method(\"modify_stat\"):");
-	p_file->store_line("\t\t\tPlayerStats.modify_stat(effect.stat, value)");
+	p_file->store_line("# All buffs that started or ended this frame arrive as one net change per target");
+	p_file->store_line("func _on_stat_modifiers_changed(_target: Object, changes: Dictionary):");
+	p_file->store_line("\tif PlayerStats and PlayerStats.has_method(\"modify_stat\"):");
+	p_file->store_line("\t\tfor stat in changes:");
+	p_file->store_line("\t\t\tPlayerStats.modify_stat(stat, changes[stat])");
 	p_file->store_line("");
 	p_file->store_line("func _get_ability_stat(ability_data: Dictionary, stat_name: String, level: int) -> float:");
 	p_file->store_line("\tvar base_value = ability_data.get(stat_name, 0.0)");
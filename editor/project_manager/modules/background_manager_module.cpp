@@ -24,8 +24,8 @@ void BackgroundManagerModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("var background_display: Control = null");
 	p_file->store_line("var key_image_display: Control = null");
 	p_file->store_line("");
-	p_file->store_line("# Asset cache");
-	p_file->store_line("var background_cache = {}");
+	p_file->store_line("# Asset streaming, shared with the script parser so it can prefetch");
+	p_file->store_line("var asset_streamer: VNAssetStreamer = null");
 	p_file->store_line("var backgrounds_path = \"assets/backgrounds\"");
 	p_file->store_line("");
 	p_file->store_line("# Transition settings");
@@ -36,6 +36,9 @@ void BackgroundManagerModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t# Connect to VN Script Parser commands");
 	p_file->store_line("\tif VNScriptParser:");
 	p_file->store_line("\t\tVNScriptParser.command_executed.connect(_on_command_executed)");
+	p_file->store_line("\t\tasset_streamer = VNScriptParser.asset_streamer");
+	p_file->store_line("\telse:");
+	p_file->store_line("\t\tasset_streamer = VNAssetStreamer.new()");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Scan for available backgrounds");
 	p_file->store_line("\tscan_backgrounds()");
@@ -110,55 +113,21 @@ void BackgroundManagerModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\tkey_image_cleared.emit()");
 	p_file->store_line("");
 	p_file->store_line("# Find background texture");
+	p_file->store_line("# Names or full paths; usually already prefetched by the script parser");
 	p_file->store_line("func find_background_texture(background_name: String) -> Texture2D:");
-	p_file->store_line("\t# Check cache first");
-	p_file->store_line("\tif background_cache.has(background_name):");
-	p_file->store_line("\t\treturn background_cache[background_name]");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Try to load as direct path");
-	p_file->store_line("\tif FileAccess.file_exists(background_name):");
-	p_file->store_line("\t\tvar texture = load(background_name) as Texture2D");
-	p_file->store_line("\t\tif texture:");
-	p_file->store_line("\t\t\tbackground_cache[background_name] = texture");
-	p_file->store_line("\t\t\treturn texture");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Try common extensions");
-	p_file->store_line("\tvar extensions = [\".png\", \".jpg\", \".jpeg\", \".webp\", \".bmp\"]");
-	p_file->store_line("\tfor ext in extensions:");
-	p_file->store_line("\t\tvar full_path = backgrounds_path + \"/\" + background_name + ext");
-	p_file->store_line("\t\tif FileAccess.file_exists(full_path):");
-	p_file->store_line("\t\t\tvar texture = load(full_path) as Texture2D");
-	p_file->store_line("\t\t\tif texture:");
-	p_file->store_line("\t\t\t\tbackground_cache[background_name] = texture");
-	p_file->store_line("\t\t\t\treturn texture");
-	p_file->store_line("\t");
-	p_file->store_line("\treturn null");
+	p_file->store_line("\treturn asset_streamer.get_texture(\"backgrounds\", background_name)");
 	p_file->store_line("");
-	p_file->store_line("# Scan backgrounds directory");
+	p_file->store_line("# Index backgrounds directory");
+	p_file->store_line("# Textures are not loaded here, only when shown or prefetched");
 	p_file->store_line("func scan_backgrounds():");
-	p_file->store_line("\tbackground_cache.clear()");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar dir = DirAccess.open(backgrounds_path)");
-	p_file->store_line("\tif not dir:");
+	p_file->store_line("\tif asset_streamer.add_directory(\"backgrounds\", backgrounds_path) != OK:");
 	p_file->store_line("\t\tprint(\"Backgrounds directory not found: \", backgrounds_path)");
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
-	p_file->store_line("\tdir.list_dir_begin()");
-	p_file->store_line("\tvar file_name = dir.get_next()");
-	p_file->store_line("\t");
-	p_file->store_line("\twhile file_name != \"\":");
-	p_file->store_line("\t\tif not dir.current_is_dir() and is_image_file(file_name):");
-	p_file->store_line("\t\t\tvar full_path = backgrounds_path + \"/\" + file_name");
-	p_file->store_line("\t\t\tvar texture = load(full_path) as Texture2D");
-	p_file->store_line("\t\t\tif texture:");
-	p_file->store_line("\t\t\t\tvar key = file_name.get_basename()");
-	p_file->store_line("\t\t\t\tbackground_cache[key] = texture");
-	p_file->store_line("\t\t\t\tprint(\"Cached background: \", key)");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\tfile_name = dir.get_next()");
-	p_file->store_line("\t");
-	p_file->store_line("\tdir.list_dir_end()");
-	p_file->store_line("\tprint(\"Scanned \", background_cache.size(), \" backgrounds\")");
+	p_file->store_line("\t# Let the streamer prefetch backgrounds named by upcoming commands");
+	p_file->store_line("\tasset_streamer.set_command_category(\"background\", \"backgrounds\")");
+	p_file->store_line("\tasset_streamer.set_command_category(\"showKeyImage\", \"backgrounds\")");
+	p_file->store_line("\tprint(\"Indexed \", asset_streamer.get_asset_names(\"backgrounds\").size(), \" backgrounds\")");
 	p_file->store_line("");
 	p_file->store_line("# Check if file is an image");
 	p_file->store_line("func is_image_file(filename: String) -> bool:");
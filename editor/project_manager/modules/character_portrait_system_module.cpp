@@ -29,14 +29,17 @@ void CharacterPortraitSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("# Portrait display references");
 	p_file->store_line("var portrait_displays = {}");
 	p_file->store_line("");
-	p_file->store_line("# Asset discovery");
-	p_file->store_line("var portrait_cache = {}");
+	p_file->store_line("# Asset streaming, shared with the script parser so it can prefetch");
+	p_file->store_line("var asset_streamer: VNAssetStreamer = null");
 	p_file->store_line("var portraits_path = \"assets/portraits\"");
 	p_file->store_line("");
 	p_file->store_line("func _ready():");
 	p_file->store_line("\t# Connect to VN Script Parser commands");
 	p_file->store_line("\tif VNScriptParser:");
 	p_file->store_line("\t\tVNScriptParser.command_executed.connect(_on_command_executed)");
+	p_file->store_line("\t\tasset_streamer = VNScriptParser.asset_streamer");
+	p_file->store_line("\telse:");
+	p_file->store_line("\t\tasset_streamer = VNAssetStreamer.new()");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Scan for available portraits");
 	p_file->store_line("\tscan_portraits()");
@@ -117,48 +120,33 @@ void CharacterPortraitSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("func find_portrait_texture(character: String, emotion: String) -> Texture2D:");
 	p_file->store_line("\t# Try specific emotion first");
 	p_file->store_line("\tvar portrait_key = character + \"_\" + emotion");
-	p_file->store_line("\tif portrait_cache.has(portrait_key):");
-	p_file->store_line("\t\treturn portrait_cache[portrait_key]");
+	p_file->store_line("\tif asset_streamer.has_asset(\"portraits\", portrait_key):");
+	p_file->store_line("\t\treturn asset_streamer.get_texture(\"portraits\", portrait_key)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Fallback to neutral");
 	p_file->store_line("\tvar neutral_key = character + \"_neutral\"");
-	p_file->store_line("\tif portrait_cache.has(neutral_key):");
+	p_file->store_line("\tif asset_streamer.has_asset(\"portraits\", neutral_key):");
 	p_file->store_line("\t\tprint(\"Using neutral fallback for: \", portrait_key)");
-	p_file->store_line("\t\treturn portrait_cache[neutral_key]");
+	p_file->store_line("\t\treturn asset_streamer.get_texture(\"portraits\", neutral_key)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Try character name without emotion");
-	p_file->store_line("\tif portrait_cache.has(character):");
+	p_file->store_line("\tif asset_streamer.has_asset(\"portraits\", character):");
 	p_file->store_line("\t\tprint(\"Using base portrait for: \", portrait_key)");
-	p_file->store_line("\t\treturn portrait_cache[character]");
+	p_file->store_line("\t\treturn asset_streamer.get_texture(\"portraits\", character)");
 	p_file->store_line("\t");
 	p_file->store_line("\treturn null");
 	p_file->store_line("");
-	p_file->store_line("# Scan portraits directory and cache textures");
+	p_file->store_line("# Index portraits directory");
+	p_file->store_line("# Textures are not loaded here, only when shown or prefetched");
 	p_file->store_line("func scan_portraits():");
-	p_file->store_line("\tportrait_cache.clear()");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar dir = DirAccess.open(portraits_path)");
-	p_file->store_line("\tif not dir:");
+	p_file->store_line("\tif asset_streamer.add_directory(\"portraits\", portraits_path) != OK:");
 	p_file->store_line("\t\tprint(\"Portraits directory not found: \", portraits_path)");
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
-	p_file->store_line("\tdir.list_dir_begin()");
-	p_file->store_line("\tvar file_name = dir.get_next()");
-	p_file->store_line("\t");
-	p_file->store_line("\twhile file_name != \"\":");
-	p_file->store_line("\t\tif not dir.current_is_dir() and is_image_file(file_name):");
-	p_file->store_line("\t\t\tvar full_path = portraits_path + \"/\" + file_name");
-	p_file->store_line("\t\t\tvar texture = load(full_path) as Texture2D");
-	p_file->store_line("\t\t\tif texture:");
-	p_file->store_line("\t\t\t\t# Remove file extension for key");
-	p_file->store_line("\t\t\t\tvar key = file_name.get_basename()");
-	p_file->store_line("\t\t\t\tportrait_cache[key] = texture");
-	p_file->store_line("\t\t\t\tprint(\"Cached portrait: \", key)");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\tfile_name = dir.get_next()");
-	p_file->store_line("\t");
-	p_file->store_line("\tdir.list_dir_end()");
-	p_file->store_line("\tprint(\"Scanned \", portrait_cache.size(), \" portraits\")");
+	p_file->store_line("\t# Let the streamer prefetch portraits named by upcoming commands");
+	p_file->store_line("\tfor command in [\"setLeft\", \"setCenter\", \"setRight\"]:");
+	p_file->store_line("\t\tasset_streamer.set_command_category(command, \"portraits\")");
+	p_file->store_line("\tprint(\"Indexed \", asset_streamer.get_asset_names(\"portraits\").size(), \" portraits\")");
 	p_file->store_line("");
 	p_file->store_line("# Check if file is an image");
 	p_file->store_line("func is_image_file(filename: String) -> bool:");
@@ -4,6 +4,7 @@ void CollectibleSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("# CollectibleBase.gd");
 	p_file->store_line("# Generated by Lupine Engine - Collectible Base Class");
 	p_file->store_line("# Base class for all collectible items");
+	p_file->store_line("# Levels with many coins should use CoinField, which handles all of them from one node");
 	p_file->store_line("");
 	p_file->store_line("extends Area2D");
 	p_file->store_line("class_name CollectibleBase");
@@ -119,6 +120,60 @@ void CollectibleSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\treturn collectible_type");
 }
 
+void CollectibleSystemModule::generate_file(Ref<FileAccess> p_file, const String &p_relative_path) {
+	String filename = p_relative_path.get_file();
+
+	if (filename == "CoinField.gd") {
+		// Generate the batched coin field script
+		p_file->store_line("# CoinField.gd");
+		p_file->store_line("# Generated by Lupine Engine - Coin Field");
+		p_file->store_line("# Draws and collects all the coins of a level from one node.");
+		p_file->store_line("# Use this instead of Coin.tscn when a level has more than a few dozen coins.");
+		p_file->store_line("");
+		p_file->store_line("extends CollectibleField");
+		p_file->store_line("class_name CoinField");
+		p_file->store_line("");
+		p_file->store_line("@export var collect_sound: AudioStream");
+		p_file->store_line("@export var collect_effect_scene: PackedScene");
+		p_file->store_line("");
+		p_file->store_line("@onready var audio_player: AudioStreamPlayer2D = $AudioStreamPlayer2D");
+		p_file->store_line("");
+		p_file->store_line("func _ready():");
+		p_file->store_line("\t# Turn placeholder children into coins, so levels can be laid out in the editor.");
+		p_file->store_line("\t# A \"value\" metadata entry overrides the default coin value.");
+		p_file->store_line("\tfor child in get_children():");
+		p_file->store_line("\t\tif child is Node2D and child != audio_player:");
+		p_file->store_line("\t\t\tadd_collectible(child.position, child.get_meta(\"value\", 10))");
+		p_file->store_line("\t\t\tchild.queue_free()");
+		p_file->store_line("\t");
+		p_file->store_line("\tcollected.connect(_on_collected)");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Setup audio");
+		p_file->store_line("\tif collect_sound:");
+		p_file->store_line("\t\taudio_player.stream = collect_sound");
+		p_file->store_line("");
+		p_file->store_line("func _on_collected(collector: Node2D, id: int, value: int, coin_position: Vector2):");
+		p_file->store_line("\t_apply_collection_effect(collector, value)");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Play sound");
+		p_file->store_line("\tif collect_sound:");
+		p_file->store_line("\t\taudio_player.position = coin_position");
+		p_file->store_line("\t\taudio_player.play()");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Spawn visual effect");
+		p_file->store_line("\tif collect_effect_scene:");
+		p_file->store_line("\t\tvar effect = collect_effect_scene.instantiate()");
+		p_file->store_line("\t\tget_tree().current_scene.add_child(effect)");
+		p_file->store_line("\t\teffect.global_position = to_global(coin_position)");
+		p_file->store_line("");
+		p_file->store_line("func _apply_collection_effect(collector: Node2D, value: int):");
+		p_file->store_line("\t# Override in derived classes");
+		p_file->store_line("\tpass");
+	} else {
+		LupineModuleBase::generate_file(p_file, p_relative_path);
+	}
+}
+
 void CollectibleSystemModule::generate_scene(Ref<FileAccess> p_file, const String &p_scene_name) {
 	if (p_scene_name == "Coin") {
 		// Generate coin collectible scene
@@ -142,6 +197,19 @@ void CollectibleSystemModule::generate_scene(Ref<FileAccess> p_file, const Strin
 		p_file->store_line("shape = SubResource(\"CircleShape2D_1\")");
 		p_file->store_line("");
 		p_file->store_line("[node name=\"AudioStreamPlayer2D\" type=\"AudioStreamPlayer2D\" parent=\".\"]");
+	} else if (p_scene_name == "CoinField") {
+		// Generate batched coin field scene
+		p_file->store_line("[gd_scene load_steps=2 format=3 uid=\"uid://coin_field\"]");
+		p_file->store_line("");
+		p_file->store_line("[ext_resource type=\"Script\" path=\"res://scripts/collectibles/CoinField.gd\" id=\"1_coin_field_script\"]");
+		p_file->store_line("");
+		p_file->store_line("[node name=\"CoinField\" type=\"CollectibleField\"]");
+		p_file->store_line("script = ExtResource(\"1_coin_field_script\")");
+		p_file->store_line("color = Color(1, 1, 0, 1)");
+		p_file->store_line("collectible_type = &\"coin\"");
+		p_file->store_line("pickup_radius = 20.0");
+		p_file->store_line("");
+		p_file->store_line("[node name=\"AudioStreamPlayer2D\" type=\"AudioStreamPlayer2D\" parent=\".\"]");
 	} else if (p_scene_name == "HealthPickup") {
 		// Generate health pickup scene
 		p_file->store_line("[gd_scene load_steps=3 format=3 uid=\"uid://health_pickup\"]");
@@ -5,6 +5,7 @@
 
 class CollectibleSystemModule : public LupineModuleBase {
 public:
+	void generate_file(Ref<FileAccess> p_file, const String &p_relative_path) override;
 	void generate_script(Ref<FileAccess> p_file) override;
 	void generate_scene(Ref<FileAccess> p_file, const String &p_scene_name) override;
 
@@ -15,10 +16,12 @@ public:
 		Vector<String> files;
 		files.push_back("scripts/collectibles/CollectibleBase.gd");
 		files.push_back("scripts/collectibles/Coin.gd");
+		files.push_back("scripts/collectibles/CoinField.gd");
 		files.push_back("scripts/collectibles/HealthPickup.gd");
 		files.push_back("scripts/collectibles/PowerUp.gd");
 		files.push_back("scripts/collectibles/TreasureChest.gd");
 		files.push_back("scenes/collectibles/Coin.tscn");
+		files.push_back("scenes/collectibles/CoinField.tscn");
 		files.push_back("scenes/collectibles/HealthPickup.tscn");
 		files.push_back("scenes/collectibles/PowerUp.tscn");
 		files.push_back("scenes/collectibles/TreasureChest.tscn");
@@ -160,14 +160,31 @@ void DialogueSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("signal choice_presented(choices: Array)");
 	p_file->store_line("signal quest_triggered(quest_id: String)");
 	p_file->store_line("");
+	p_file->store_line("# Variables that are read from other systems, mapped to PlayerStats properties");
+	p_file->store_line("const PLAYER_STAT_VARIABLES = {");
+	p_file->store_line("\t\"player_name\": \"player_name\",");
+	p_file->store_line("\t\"level\": \"level\",");
+	p_file->store_line("\t\"gold\": \"gold\",");
+	p_file->store_line("\t\"health\": \"current_health\",");
+	p_file->store_line("\t\"max_health\": \"max_health\"");
+	p_file->store_line("}");
+	p_file->store_line("");
 	p_file->store_line("# Current dialogue state");
-	p_file->store_line("var current_dialogue: Dictionary = {}");
+	p_file->store_line("var current_program: DialogueProgram = null");
+	p_file->store_line("var current_line_index: int = 0");
 	p_file->store_line("var current_npc: Node = null");
 	p_file->store_line("var dialogue_active: bool = false");
 	p_file->store_line("var dialogue_ui: Control = null");
 	p_file->store_line("");
 	p_file->store_line("# Dialogue data storage");
+	p_file->store_line("# Dialogues are compiled once when loaded; conditions, actions and {variables}");
+	p_file->store_line("# in texts then run against a single shared variable table");
+	p_file->store_line("# Dialogues exported from the dialogue editor are already compiled and are");
+	p_file->store_line("# loaded on first use, shared by every NPC through the resource cache");
 	p_file->store_line("var dialogue_data: Dictionary = {}");
+	p_file->store_line("var dialogue_paths: Dictionary = {}");
+	p_file->store_line("var dialogue_programs: Dictionary = {}");
+	p_file->store_line("var variables := DialogueVariables.new()");
 	p_file->store_line("var npc_states: Dictionary = {}");
 	p_file->store_line("");
 	p_file->store_line("func _ready():");
@@ -184,21 +201,22 @@ void DialogueSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t# Load dialogue data");
 	p_file->store_line("\t_load_dialogue_data()");
 	p_file->store_line("");
-	p_file->store_line("func start_dialogue(npc: Node, dialogue_id: String = \"\"):");
+	p_file->store_line("func start_dialogue(npc: Node, dialogue_id: String = \"\", start_line: String = \"\"):");
 	p_file->store_line("\tif dialogue_active:");
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
-	p_file->store_line("\tcurrent_npc = npc");
-	p_file->store_line("\tdialogue_active = true");
-	p_file->store_line("\t");
 	p_file->store_line("\t# Use provided dialogue_id or get from NPC");
 	p_file->store_line("\tvar npc_dialogue_id = dialogue_id if dialogue_id != \"\" else npc.dialogue_id");
 	p_file->store_line("\t");
-	p_file->store_line("\tif not dialogue_data.has(npc_dialogue_id):");
+	p_file->store_line("\tvar program = get_dialogue_program(npc_dialogue_id)");
+	p_file->store_line("\tif not program:");
 	p_file->store_line("\t\tprint(\"Dialogue not found: \", npc_dialogue_id)");
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
-	p_file->store_line("\tcurrent_dialogue = dialogue_data[npc_dialogue_id]");
+	p_file->store_line("\tcurrent_npc = npc");
+	p_file->store_line("\tdialogue_active = true");
+	p_file->store_line("\tcurrent_program = program");
+	p_file->store_line("\trefresh_variables(current_program)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Pause player");
 	p_file->store_line("\tget_tree().paused = true");
@@ -206,8 +224,14 @@ void DialogueSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t# Show dialogue UI");
 	p_file->store_line("\tdialogue_ui.visible = true");
 	p_file->store_line("\t");
-	p_file->store_line("\t# Start first line");
-	p_file->store_line("\t_display_dialogue_line(0)");
+	p_file->store_line("\t# Start at the first line, or at the given line id");
+	p_file->store_line("\tvar first_line = 0");
+	p_file->store_line("\tif start_line != \"\":");
+	p_file->store_line("\t\tfirst_line = current_program.find_line(start_line)");
+	p_file->store_line("\t\tif first_line == DialogueProgram.LINE_END:");
+	p_file->store_line("\t\t\tprint(\"Dialogue line not found: \", start_line)");
+	p_file->store_line("\t\t\tfirst_line = 0");
+	p_file->store_line("\t_display_dialogue_line(first_line)");
 	p_file->store_line("\t");
 	p_file->store_line("\tdialogue_started.emit(npc.npc_name)");
 	p_file->store_line("");
@@ -216,7 +240,7 @@ void DialogueSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
 	p_file->store_line("\tdialogue_active = false");
-	p_file->store_line("\tcurrent_dialogue = {}");
+	p_file->store_line("\tcurrent_program = null");
 	p_file->store_line("\tcurrent_npc = null");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Hide dialogue UI");
@@ -228,118 +252,126 @@ void DialogueSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\tdialogue_ended.emit()");
 	p_file->store_line("");
 	p_file->store_line("func _display_dialogue_line(line_index: int):");
-	p_file->store_line("\tif not current_dialogue.has(\"lines\") or line_index >= current_dialogue.lines.size():");
+	p_file->store_line("\tif not current_program or line_index == DialogueProgram.LINE_END:");
 	p_file->store_line("\t\tend_dialogue()");
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
-	p_file->store_line("\tvar line = current_dialogue.lines[line_index]");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Check conditions if present");
-	p_file->store_line("\tif line.has(\"condition\") and not _check_condition(line.condition):");
-	p_file->store_line("\t\t_display_dialogue_line(line_index + 1)");
+	p_file->store_line("\t# Skip lines whose condition fails");
+	p_file->store_line("\tline_index = current_program.find_next_line(line_index, variables)");
+	p_file->store_line("\tif line_index == DialogueProgram.LINE_END:");
+	p_file->store_line("\t\tend_dialogue()");
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
-	p_file->store_line("\t# Process inline variables in text");
-	p_file->store_line("\tvar processed_text = _process_inline_variables(line.text)");
+	p_file->store_line("\tcurrent_line_index = line_index");
+	p_file->store_line("\tvar speaker = current_program.get_line_speaker(line_index)");
+	p_file->store_line("\tvar processed_text = current_program.format_line_text(line_index, variables)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Display the line");
-	p_file->store_line("\tdialogue_ui.display_line(line.speaker, processed_text)");
-	p_file->store_line("\tdialogue_line_displayed.emit(line.speaker, processed_text)");
+	p_file->store_line("\tdialogue_ui.display_line(speaker, processed_text)");
+	p_file->store_line("\tdialogue_line_displayed.emit(speaker, processed_text)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Handle choices");
-	p_file->store_line("\tif line.has(\"choices\"):");
-	p_file->store_line("\t\tdialogue_ui.show_choices(line.choices)");
-	p_file->store_line("\t\tchoice_presented.emit(line.choices)");
+	p_file->store_line("\tvar choice_count = current_program.get_line_choice_count(line_index)");
+	p_file->store_line("\tif choice_count > 0:");
+	p_file->store_line("\t\tvar choices = []");
+	p_file->store_line("\t\tfor i in range(choice_count):");
+	p_file->store_line("\t\t\tchoices.append({\"text\": current_program.format_choice_text(line_index, i, variables)})");
+	p_file->store_line("\t\tdialogue_ui.show_choices(choices)");
+	p_file->store_line("\t\tchoice_presented.emit(choices)");
 	p_file->store_line("\telse:");
 	p_file->store_line("\t\tdialogue_ui.current_line_index = line_index");
 	p_file->store_line("");
 	p_file->store_line("func _on_dialogue_advanced():");
-	p_file->store_line("\tvar next_index = dialogue_ui.current_line_index + 1");
-	p_file->store_line("\t_display_dialogue_line(next_index)");
+	p_file->store_line("\t_display_dialogue_line(current_program.get_line_next(current_line_index))");
 	p_file->store_line("");
 	p_file->store_line("func _on_choice_selected(choice_index: int):");
-	p_file->store_line("\tvar current_line = current_dialogue.lines[dialogue_ui.current_line_index]");
-	p_file->store_line("\tvar choice = current_line.choices[choice_index]");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Execute choice action");
-	p_file->store_line("\tif choice.has(\"action\"):");
-	p_file->store_line("\t\t_execute_action(choice.action)");
+	p_file->store_line("\t# Execute choice action; variable changes are applied by the program itself");
+	p_file->store_line("\tcurrent_program.run_choice_action(current_line_index, choice_index, variables, _execute_action)");
+	p_file->store_line("\trefresh_variables(current_program)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Continue to next line or jump");
-	p_file->store_line("\tif choice.has(\"jump_to\"):");
-	p_file->store_line("\t\t_display_dialogue_line(choice.jump_to)");
+	p_file->store_line("\tvar jump_to = current_program.get_choice_jump(current_line_index, choice_index)");
+	p_file->store_line("\tif jump_to != DialogueProgram.LINE_END:");
+	p_file->store_line("\t\t_display_dialogue_line(jump_to)");
 	p_file->store_line("\telse:");
-	p_file->store_line("\t\t_display_dialogue_line(dialogue_ui.current_line_index + 1)");
+	p_file->store_line("\t\t_display_dialogue_line(current_program.get_line_next(current_line_index))");
 	p_file->store_line("");
-	p_file->store_line("func _check_condition(condition: Dictionary) -> bool:");
-	p_file->store_line("\t# Check various conditions (quest status, items, etc.)");
-	p_file->store_line("\tmatch condition.type:");
-	p_file->store_line("\t\t\"quest_completed\":");
-	p_file->store_line("\t\t\treturn QuestSystem.is_quest_completed(condition.quest_id) if QuestSystem else false");
-	p_file->store_line("\t\t\"has_item\":");
-	p_file->store_line("\t\t\treturn InventorySystem.has_item(condition.item_id) if InventorySystem else false");
-	p_file->store_line("\t\t\"player_level\":");
-	p_file->store_line("\t\t\treturn PlayerStats.level >= condition.level if PlayerStats else false");
-	p_file->store_line("\t\t_:");
-	p_file->store_line("\t\t\treturn true");
-	p_file->store_line("");
-	p_file->store_line("func _execute_action(action: Dictionary):");
+	p_file->store_line("func _execute_action(type: StringName, action: Dictionary):");
 	p_file->store_line("\t# Execute various actions");
-	p_file->store_line("\tmatch action.type:");
-	p_file->store_line("\t\t\"give_item\":");
+	p_file->store_line("\tmatch type:");
+	p_file->store_line("\t\t&\"give_item\":");
 	p_file->store_line("\t\t\tif InventorySystem:");
 	p_file->store_line("\t\t\t\tInventorySystem.add_item(action.item_id, action.get(\"quantity\", 1))");
-	p_file->store_line("\t\t\"start_quest\":");
+	p_file->store_line("\t\t&\"start_quest\":");
 	p_file->store_line("\t\t\tif QuestSystem:");
 	p_file->store_line("\t\t\t\tQuestSystem.start_quest(action.quest_id)");
 	p_file->store_line("\t\t\t\tquest_triggered.emit(action.quest_id)");
-	p_file->store_line("\t\t\"give_experience\":");
+	p_file->store_line("\t\t&\"give_experience\":");
 	p_file->store_line("\t\t\tif PlayerStats:");
 	p_file->store_line("\t\t\t\tPlayerStats.add_experience(action.amount)");
-	p_file->store_line("\t\t\"set_npc_state\":");
+	p_file->store_line("\t\t&\"set_npc_state\":");
 	p_file->store_line("\t\t\tnpc_states[current_npc.get_instance_id()] = action.state");
 	p_file->store_line("");
-	p_file->store_line("func _process_inline_variables(text: String) -> String:");
-	p_file->store_line("\t# Process inline variables like {player_name}, {gold}, etc.");
-	p_file->store_line("\tvar processed_text = text");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Replace player stats variables");
-	p_file->store_line("\tif PlayerStats:");
-	p_file->store_line("\t\tprocessed_text = processed_text.replace(\"{player_name}\", PlayerStats.player_name)");
-	p_file->store_line("\t\tprocessed_text = processed_text.replace(\"{level}\", str(PlayerStats.level))");
-	p_file->store_line("\t\tprocessed_text = processed_text.replace(\"{gold}\", str(PlayerStats.gold))");
-	p_file->store_line("\t\tprocessed_text = processed_text.replace(\"{health}\", str(PlayerStats.current_health))");
-	p_file->store_line("\t\tprocessed_text = processed_text.replace(\"{max_health}\", str(PlayerStats.max_health))");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Replace quest variables");
-	p_file->store_line("\tif QuestSystem:");
-	p_file->store_line("\t\tprocessed_text = processed_text.replace(\"{quest_count}\", str(QuestSystem.active_quests.size()))");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Replace inventory variables");
-	p_file->store_line("\tif InventorySystem:");
-	p_file->store_line("\t\tvar regex = RegEx.new()");
-	p_file->store_line("\t\tregex.compile(\"\\\\{item_count:([^}]+)\\\\}\")");
-	p_file->store_line("\t\tvar result = regex.search(processed_text)");
-	p_file->store_line("\t\twhile result:");
-	p_file->store_line("\t\t\tvar item_id = result.get_string(1)");
-	p_file->store_line("\t\t\tvar count = 0");
-	p_file->store_line("\t\t\tfor item in InventorySystem.items:");
-	p_file->store_line("\t\t\t\tif item.has(\"id\") and item.id == item_id:");
-	p_file->store_line("\t\t\t\t\tcount += item.get(\"quantity\", 1)");
-	p_file->store_line("\t\t\tprocessed_text = processed_text.replace(result.get_string(0), str(count))");
-	p_file->store_line("\t\t\tresult = regex.search(processed_text)");
+	p_file->store_line("# Update the variables a dialogue uses from the game systems");
+	p_file->store_line("# Call this when game state changes, e.g. once per frame for NPC barks, rather than per check");
+	p_file->store_line("func refresh_variables(program: DialogueProgram):");
+	p_file->store_line("\tfor var_name in program.get_variable_names():");
+	p_file->store_line("\t\tif var_name.begins_with(\"quest_completed:\"):");
+	p_file->store_line("\t\t\tif QuestSystem:");
+	p_file->store_line("\t\t\t\tvariables.set_value(var_name, QuestSystem.is_quest_completed(var_name.get_slice(\":\", 1)))");
+	p_file->store_line("\t\telif var_name.begins_with(\"item_count:\"):");
+	p_file->store_line("\t\t\tif InventorySystem:");
+	p_file->store_line("\t\t\t\tvariables.set_value(var_name, _count_item(var_name.get_slice(\":\", 1)))");
+	p_file->store_line("\t\telif PLAYER_STAT_VARIABLES.has(var_name):");
+	p_file->store_line("\t\t\tif PlayerStats:");
+	p_file->store_line("\t\t\t\tvariables.set_value(var_name, PlayerStats.get(PLAYER_STAT_VARIABLES[var_name]))");
+	p_file->store_line("\t\telif var_name == \"quest_count\":");
+	p_file->store_line("\t\t\tif QuestSystem:");
+	p_file->store_line("\t\t\t\tvariables.set_value(var_name, QuestSystem.active_quests.size())");
+	p_file->store_line("");
+	p_file->store_line("func _count_item(item_id: String) -> int:");
+	p_file->store_line("\tif not InventorySystem:");
+	p_file->store_line("\t\treturn 0");
+	p_file->store_line("\treturn InventorySystem.get_item_count(item_id)");
+	p_file->store_line("");
+	p_file->store_line("func set_variable(var_name: String, value):");
+	p_file->store_line("\tvariables.set_value(var_name, value)");
+	p_file->store_line("");
+	p_file->store_line("func get_variable(var_name: String, default_value = null):");
+	p_file->store_line("\treturn variables.get_value(var_name, default_value)");
+	p_file->store_line("");
+	p_file->store_line("func get_dialogue_program(dialogue_id: String) -> DialogueProgram:");
+	p_file->store_line("\tif dialogue_programs.has(dialogue_id):");
+	p_file->store_line("\t\treturn dialogue_programs[dialogue_id]");
+	p_file->store_line("\tif dialogue_paths.has(dialogue_id):");
+	p_file->store_line("\t\tvar compiled = load(dialogue_paths[dialogue_id]) as DialogueProgram");
+	p_file->store_line("\t\tif compiled:");
+	p_file->store_line("\t\t\tdialogue_programs[dialogue_id] = compiled");
+	p_file->store_line("\t\t\treturn compiled");
+	p_file->store_line("\t\tprint(\"Failed to load compiled dialogue \", dialogue_id)");
+	p_file->store_line("\tif not dialogue_data.has(dialogue_id):");
+	p_file->store_line("\t\treturn null");
 	p_file->store_line("\t");
-	p_file->store_line("\treturn processed_text");
+	p_file->store_line("\tvar program = DialogueProgram.new()");
+	p_file->store_line("\tif program.compile(dialogue_data[dialogue_id]) != OK:");
+	p_file->store_line("\t\tprint(\"Failed to compile dialogue \", dialogue_id, \": \", program.get_error_string())");
+	p_file->store_line("\t\treturn null");
+	p_file->store_line("\tdialogue_programs[dialogue_id] = program");
+	p_file->store_line("\treturn program");
 	p_file->store_line("");
 	p_file->store_line("func _load_dialogue_data():");
-	p_file->store_line("\t# Load dialogue from JSON files");
+	p_file->store_line("\t# Index compiled dialogues and load dialogue from JSON files");
 	p_file->store_line("\tvar dialogue_dir = \"res://data/dialogues/\"");
 	p_file->store_line("\tvar dir = DirAccess.open(dialogue_dir)");
 	p_file->store_line("\tif dir:");
 	p_file->store_line("\t\tdir.list_dir_begin()");
 	p_file->store_line("\t\tvar file_name = dir.get_next()");
 	p_file->store_line("\t\twhile file_name != \"\":");
-	p_file->store_line("\t\t\tif file_name.ends_with(\".json\"):");
+	p_file->store_line("\t\t\t# Exported projects list remapped resources with a .remap suffix");
+	p_file->store_line("\t\t\tvar resource_name = file_name.trim_suffix(\".remap\")");
+	p_file->store_line("\t\t\tif resource_name.ends_with(\".res\") or resource_name.ends_with(\".tres\"):");
+	p_file->store_line("\t\t\t\tdialogue_paths[resource_name.get_basename()] = dialogue_dir + resource_name");
+	p_file->store_line("\t\t\telif file_name.ends_with(\".json\"):");
 	p_file->store_line("\t\t\t\tvar file_path = dialogue_dir + file_name");
 	p_file->store_line("\t\t\t\tvar file = FileAccess.open(file_path, FileAccess.READ)");
 	p_file->store_line("\t\t\t\tif file:");
@@ -350,6 +382,13 @@ void DialogueSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t\t\t\t\tif parse_result == OK:");
 	p_file->store_line("\t\t\t\t\t\tdialogue_data.merge(json.data)");
 	p_file->store_line("\t\t\tfile_name = dir.get_next()");
+	p_file->store_line("\t");
+	p_file->store_line("\t# Compile JSON dialogues up front so starting one never parses anything;");
+	p_file->store_line("\t# compiled dialogues take precedence and load on first use");
+	p_file->store_line("\tdialogue_programs.clear()");
+	p_file->store_line("\tfor dialogue_id in dialogue_data:");
+	p_file->store_line("\t\tif not dialogue_paths.has(dialogue_id):");
+	p_file->store_line("\t\t\tget_dialogue_program(dialogue_id)");
 	p_file->store_line("");
 	p_file->store_line("func get_npc_state(npc: Node) -> String:");
 	p_file->store_line("\treturn npc_states.get(npc.get_instance_id(), \"default\")");
@@ -19,47 +19,108 @@ void EnemyAIModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("@export var move_speed: float = 100.0");
 	p_file->store_line("@export var attack_damage: float = 20.0");
 	p_file->store_line("@export var attack_range: float = 50.0");
+	p_file->store_line("@export var attack_cooldown: float = 1.0");
 	p_file->store_line("@export var detection_range: float = 150.0");
+	p_file->store_line("@export var patrol_range: float = 100.0");
 	p_file->store_line("@export var experience_reward: int = 10");
 	p_file->store_line("");
+	p_file->store_line("# All enemies are moved by one shared crowd instead of their own physics");
+	p_file->store_line("# process. The crowd tracks the player through a spatial hash and only");
+	p_file->store_line("# writes positions back; state changes come through _on_crowd_state_changed.");
+	p_file->store_line("static var shared_crowd: Crowd2D = null");
+	p_file->store_line("");
 	p_file->store_line("# Current state");
 	p_file->store_line("var current_health: float");
 	p_file->store_line("var is_dead: bool = false");
 	p_file->store_line("var player_target: Node = null");
 	p_file->store_line("var last_known_player_position: Vector2");
+	p_file->store_line("var crowd: Crowd2D");
+	p_file->store_line("var agent: int = -1");
+	p_file->store_line("var attack_timer: Timer");
 	p_file->store_line("");
 	p_file->store_line("# AI State");
 	p_file->store_line("enum AIState { IDLE, PATROL, CHASE, ATTACK, RETURN, STUNNED }");
 	p_file->store_line("var current_state: AIState = AIState.IDLE");
-	p_file->store_line("var state_timer: float = 0.0");
 	p_file->store_line("");
 	p_file->store_line("# Components");
 	p_file->store_line("@onready var sprite: Sprite2D = $Sprite2D");
 	p_file->store_line("@onready var collision: CollisionShape2D = $CollisionShape2D");
-	p_file->store_line("@onready var detection_area: Area2D = $DetectionArea");
-	p_file->store_line("@onready var attack_area: Area2D = $AttackArea");
 	p_file->store_line("@onready var health_bar: ProgressBar = $HealthBar");
 	p_file->store_line("");
 	p_file->store_line("func _ready():");
 	p_file->store_line("\tcurrent_health = max_health");
-	p_file->store_line("\t_setup_detection_area()");
-	p_file->store_line("\t_setup_attack_area()");
 	p_file->store_line("\t_update_health_bar()");
+	p_file->store_line("\t");
+	p_file->store_line("\tattack_timer = Timer.new()");
+	p_file->store_line("\tattack_timer.wait_time = attack_cooldown");
+	p_file->store_line("\tattack_timer.timeout.connect(attack_player)");
+	p_file->store_line("\tadd_child(attack_timer)");
+	p_file->store_line("\t");
+	p_file->store_line("\t# Derived classes may change stats after super._ready(), so join the crowd once they are done");
+	p_file->store_line("\t_join_crowd.call_deferred()");
 	p_file->store_line("");
-	p_file->store_line("func _physics_process(delta):");
+	p_file->store_line("func _exit_tree():");
+	p_file->store_line("\t_leave_crowd()");
+	p_file->store_line("");
+	p_file->store_line("static func get_crowd(tree: SceneTree) -> Crowd2D:");
+	p_file->store_line("\tif not is_instance_valid(shared_crowd):");
+	p_file->store_line("\t\tshared_crowd = Crowd2D.new()");
+	p_file->store_line("\t\tshared_crowd.name = \"EnemyCrowd\"");
+	p_file->store_line("\t\ttree.current_scene.add_child.call_deferred(shared_crowd)");
+	p_file->store_line("\treturn shared_crowd");
+	p_file->store_line("");
+	p_file->store_line("func _join_crowd():");
 	p_file->store_line("\tif is_dead:");
 	p_file->store_line("\t\treturn");
-	p_file->store_line("\t");
-	p_file->store_line("\tstate_timer += delta");
-	p_file->store_line("\t_update_ai_state(delta)");
-	p_file->store_line("\t_handle_movement(delta)");
-	p_file->store_line("\tmove_and_slide()");
+	p_file->store_line("\tcrowd = get_crowd(get_tree())");
+	p_file->store_line("\tagent = crowd.add_agent(global_position, Crowd2D.REACTION_CHASE, self)");
+	p_file->store_line("\tcrowd.set_agent_speed(agent, move_speed)");
+	p_file->store_line("\tcrowd.set_agent_perception_radius(agent, detection_range)");
+	p_file->store_line("\tcrowd.set_agent_reach(agent, attack_range)");
+	p_file->store_line("\tcrowd.set_agent_wander_radius(agent, patrol_range)");
+	p_file->store_line("\tcrowd.set_agent_callback(agent, _on_crowd_state_changed)");
 	p_file->store_line("");
-	p_file->store_line("func _update_ai_state(delta: float):");
-	p_file->store_line("\t# Override in derived classes");
-	p_file->store_line("\tpass");
+	p_file->store_line("func _leave_crowd():");
+	p_file->store_line("\tif crowd and crowd.has_agent(agent):");
+	p_file->store_line("\t\tcrowd.remove_agent(agent)");
+	p_file->store_line("\tagent = -1");
 	p_file->store_line("");
-	p_file->store_line("func _handle_movement(delta: float):");
+	p_file->store_line("func _on_crowd_state_changed(state: int, facing_left: bool):");
+	p_file->store_line("\tsprite.flip_h = facing_left");
+	p_file->store_line("\t");
+	p_file->store_line("\tvar previous_state = current_state");
+	p_file->store_line("\tmatch state:");
+	p_file->store_line("\t\tCrowd2D.STATE_CHASE:");
+	p_file->store_line("\t\t\tcurrent_state = AIState.CHASE");
+	p_file->store_line("\t\tCrowd2D.STATE_ATTACK:");
+	p_file->store_line("\t\t\tcurrent_state = AIState.ATTACK");
+	p_file->store_line("\t\tCrowd2D.STATE_RETURN:");
+	p_file->store_line("\t\t\tcurrent_state = AIState.RETURN");
+	p_file->store_line("\t\tCrowd2D.STATE_WANDER:");
+	p_file->store_line("\t\t\tcurrent_state = AIState.PATROL");
+	p_file->store_line("\t\t_:");
+	p_file->store_line("\t\t\tcurrent_state = AIState.IDLE");
+	p_file->store_line("\t");
+	p_file->store_line("\tvar engaged = current_state == AIState.CHASE or current_state == AIState.ATTACK");
+	p_file->store_line("\tif engaged and player_target == null:");
+	p_file->store_line("\t\tplayer_target = crowd.get_agent_target(agent)");
+	p_file->store_line("\t\tplayer_detected.emit(player_target)");
+	p_file->store_line("\telif not engaged and player_target != null:");
+	p_file->store_line("\t\tplayer_target = null");
+	p_file->store_line("\t\tplayer_lost.emit()");
+	p_file->store_line("\tif player_target:");
+	p_file->store_line("\t\tlast_known_player_position = player_target.global_position");
+	p_file->store_line("\t");
+	p_file->store_line("\t# Attack right away, then on every cooldown while in reach");
+	p_file->store_line("\tif current_state == AIState.ATTACK and previous_state != AIState.ATTACK:");
+	p_file->store_line("\t\tattack_player()");
+	p_file->store_line("\t\tattack_timer.start()");
+	p_file->store_line("\telif current_state != AIState.ATTACK:");
+	p_file->store_line("\t\tattack_timer.stop()");
+	p_file->store_line("\t");
+	p_file->store_line("\t_on_ai_state_changed(previous_state, current_state)");
+	p_file->store_line("");
+	p_file->store_line("func _on_ai_state_changed(previous_state: AIState, new_state: AIState):");
 	p_file->store_line("\t# Override in derived classes");
 	p_file->store_line("\tpass");
 	p_file->store_line("");
@@ -71,8 +132,8 @@ void EnemyAIModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\tcurrent_health = max(0, current_health)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Apply knockback");
-	p_file->store_line("\tif knockback_force != Vector2.ZERO:");
-	p_file->store_line("\t\tvelocity += knockback_force");
+	p_file->store_line("\tif knockback_force != Vector2.ZERO and crowd and crowd.has_agent(agent):");
+	p_file->store_line("\t\tcrowd.set_agent_position(agent, global_position + knockback_force * 0.1)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Flash effect");
 	p_file->store_line("\t_flash_damage()");
@@ -86,6 +147,8 @@ void EnemyAIModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("func _die():");
 	p_file->store_line("\tis_dead = true");
 	p_file->store_line("\tcurrent_state = AIState.STUNNED");
+	p_file->store_line("\tattack_timer.stop()");
+	p_file->store_line("\t_leave_crowd()");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Give experience to player");
 	p_file->store_line("\tif PlayerStats:");
@@ -110,42 +173,14 @@ void EnemyAIModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\ttween.tween_property(sprite, \"modulate\", Color.RED, 0.1)");
 	p_file->store_line("\ttween.tween_property(sprite, \"modulate\", Color.WHITE, 0.1)");
 	p_file->store_line("");
-	p_file->store_line("func _setup_detection_area():");
-	p_file->store_line("\tif detection_area:");
-	p_file->store_line("\t\tdetection_area.body_entered.connect(_on_player_detected)");
-	p_file->store_line("\t\tdetection_area.body_exited.connect(_on_player_lost)");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Set detection range");
-	p_file->store_line("\t\tvar detection_shape = detection_area.get_child(0) as CollisionShape2D");
-	p_file->store_line("\t\tif detection_shape and detection_shape.shape is CircleShape2D:");
-	p_file->store_line("\t\t\t(detection_shape.shape as CircleShape2D).radius = detection_range");
-	p_file->store_line("");
-	p_file->store_line("func _setup_attack_area():");
-	p_file->store_line("\tif attack_area:");
-	p_file->store_line("\t\t# Set attack range");
-	p_file->store_line("\t\tvar attack_shape = attack_area.get_child(0) as CollisionShape2D");
-	p_file->store_line("\t\tif attack_shape and attack_shape.shape is CircleShape2D:");
-	p_file->store_line("\t\t\t(attack_shape.shape as CircleShape2D).radius = attack_range");
-	p_file->store_line("");
-	p_file->store_line("func _on_player_detected(body: Node):");
-	p_file->store_line("\tif body.has_method(\"take_damage\") and body.name.contains(\"Player\"):");
-	p_file->store_line("\t\tplayer_target = body");
-	p_file->store_line("\t\tlast_known_player_position = body.global_position");
-	p_file->store_line("\t\tplayer_detected.emit(body)");
-	p_file->store_line("");
-	p_file->store_line("func _on_player_lost(body: Node):");
-	p_file->store_line("\tif body == player_target:");
-	p_file->store_line("\t\tplayer_target = null");
-	p_file->store_line("\t\tplayer_lost.emit()");
-	p_file->store_line("");
 	p_file->store_line("func _update_health_bar():");
 	p_file->store_line("\tif health_bar:");
 	p_file->store_line("\t\thealth_bar.value = (current_health / max_health) * 100");
 	p_file->store_line("\t\thealth_bar.visible = current_health < max_health");
 	p_file->store_line("");
 	p_file->store_line("func get_distance_to_player() -> float:");
-	p_file->store_line("\tif player_target:");
-	p_file->store_line("\t\treturn global_position.distance_to(player_target.global_position)");
+	p_file->store_line("\tif player_target and crowd and crowd.has_agent(agent):");
+	p_file->store_line("\t\treturn crowd.get_agent_target_distance(agent)");
 	p_file->store_line("\treturn INF");
 	p_file->store_line("");
 	p_file->store_line("func get_direction_to_player() -> Vector2:");
@@ -166,21 +201,17 @@ void EnemyAIModule::generate_script(Ref<FileAccess> p_file) {
 void EnemyAIModule::generate_scene(Ref<FileAccess> p_file, const String &p_scene_name) {
 	if (p_scene_name == "EnemyPatrol") {
 		// Generate patrol enemy scene
-		p_file->store_line("[gd_scene load_steps=4 format=3 uid=\"uid://enemy_patrol\"]");
+		p_file->store_line("[gd_scene load_steps=2 format=3 uid=\"uid://enemy_patrol\"]");
 		p_file->store_line("");
 		p_file->store_line("[ext_resource type=\"Script\" path=\"res://scripts/enemies/EnemyPatrol.gd\" id=\"1_enemy_patrol_script\"]");
 		p_file->store_line("");
 		p_file->store_line("[sub_resource type=\"RectangleShape2D\" id=\"RectangleShape2D_1\"]");
 		p_file->store_line("size = Vector2(32, 32)");
 		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_1\"]");
-		p_file->store_line("radius = 150.0");
-		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_2\"]");
-		p_file->store_line("radius = 50.0");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"EnemyPatrol\" type=\"CharacterBody2D\"]");
 		p_file->store_line("script = ExtResource(\"1_enemy_patrol_script\")");
+		p_file->store_line("detection_range = 150.0");
+		p_file->store_line("attack_range = 50.0");
 		p_file->store_line("");
 		p_file->store_line("[node name=\"Sprite2D\" type=\"Sprite2D\" parent=\".\"]");
 		p_file->store_line("modulate = Color(1, 0.5, 0.5, 1)");
@@ -189,16 +220,6 @@ void EnemyAIModule::generate_scene(Ref<FileAccess> p_file, const String &p_scene
 		p_file->store_line("[node name=\"CollisionShape2D\" type=\"CollisionShape2D\" parent=\".\"]");
 		p_file->store_line("shape = SubResource(\"RectangleShape2D_1\")");
 		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionShape\" type=\"CollisionShape2D\" parent=\"DetectionArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_1\")");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"AttackArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"AttackShape\" type=\"CollisionShape2D\" parent=\"AttackArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_2\")");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"HealthBar\" type=\"ProgressBar\" parent=\".\"]");
 		p_file->store_line("offset_left = -20.0");
 		p_file->store_line("offset_top = -30.0");
@@ -208,21 +229,17 @@ void EnemyAIModule::generate_scene(Ref<FileAccess> p_file, const String &p_scene
 		p_file->store_line("show_percentage = false");
 	} else if (p_scene_name == "EnemyChaser") {
 		// Generate chaser enemy scene
-		p_file->store_line("[gd_scene load_steps=4 format=3 uid=\"uid://enemy_chaser\"]");
+		p_file->store_line("[gd_scene load_steps=2 format=3 uid=\"uid://enemy_chaser\"]");
 		p_file->store_line("");
 		p_file->store_line("[ext_resource type=\"Script\" path=\"res://scripts/enemies/EnemyChaser.gd\" id=\"1_enemy_chaser_script\"]");
 		p_file->store_line("");
 		p_file->store_line("[sub_resource type=\"RectangleShape2D\" id=\"RectangleShape2D_1\"]");
 		p_file->store_line("size = Vector2(28, 28)");
 		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_1\"]");
-		p_file->store_line("radius = 200.0");
-		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_2\"]");
-		p_file->store_line("radius = 40.0");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"EnemyChaser\" type=\"CharacterBody2D\"]");
 		p_file->store_line("script = ExtResource(\"1_enemy_chaser_script\")");
+		p_file->store_line("detection_range = 200.0");
+		p_file->store_line("attack_range = 40.0");
 		p_file->store_line("");
 		p_file->store_line("[node name=\"Sprite2D\" type=\"Sprite2D\" parent=\".\"]");
 		p_file->store_line("modulate = Color(1, 0.3, 0.3, 1)");
@@ -231,16 +248,6 @@ void EnemyAIModule::generate_scene(Ref<FileAccess> p_file, const String &p_scene
 		p_file->store_line("[node name=\"CollisionShape2D\" type=\"CollisionShape2D\" parent=\".\"]");
 		p_file->store_line("shape = SubResource(\"RectangleShape2D_1\")");
 		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionShape\" type=\"CollisionShape2D\" parent=\"DetectionArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_1\")");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"AttackArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"AttackShape\" type=\"CollisionShape2D\" parent=\"AttackArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_2\")");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"HealthBar\" type=\"ProgressBar\" parent=\".\"]");
 		p_file->store_line("offset_left = -20.0");
 		p_file->store_line("offset_top = -30.0");
@@ -250,21 +257,17 @@ void EnemyAIModule::generate_scene(Ref<FileAccess> p_file, const String &p_scene
 		p_file->store_line("show_percentage = false");
 	} else if (p_scene_name == "EnemyFlying") {
 		// Generate flying enemy scene
-		p_file->store_line("[gd_scene load_steps=4 format=3 uid=\"uid://enemy_flying\"]");
+		p_file->store_line("[gd_scene load_steps=2 format=3 uid=\"uid://enemy_flying\"]");
 		p_file->store_line("");
 		p_file->store_line("[ext_resource type=\"Script\" path=\"res://scripts/enemies/EnemyFlying.gd\" id=\"1_enemy_flying_script\"]");
 		p_file->store_line("");
 		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_1\"]");
 		p_file->store_line("radius = 16.0");
 		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_2\"]");
-		p_file->store_line("radius = 180.0");
-		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_3\"]");
-		p_file->store_line("radius = 45.0");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"EnemyFlying\" type=\"CharacterBody2D\"]");
 		p_file->store_line("script = ExtResource(\"1_enemy_flying_script\")");
+		p_file->store_line("detection_range = 180.0");
+		p_file->store_line("attack_range = 45.0");
 		p_file->store_line("");
 		p_file->store_line("[node name=\"Sprite2D\" type=\"Sprite2D\" parent=\".\"]");
 		p_file->store_line("modulate = Color(0.8, 0.8, 1, 1)");
@@ -273,16 +276,6 @@ void EnemyAIModule::generate_scene(Ref<FileAccess> p_file, const String &p_scene
 		p_file->store_line("[node name=\"CollisionShape2D\" type=\"CollisionShape2D\" parent=\".\"]");
 		p_file->store_line("shape = SubResource(\"CircleShape2D_1\")");
 		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionShape\" type=\"CollisionShape2D\" parent=\"DetectionArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_2\")");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"AttackArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"AttackShape\" type=\"CollisionShape2D\" parent=\"AttackArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_3\")");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"HealthBar\" type=\"ProgressBar\" parent=\".\"]");
 		p_file->store_line("offset_left = -20.0");
 		p_file->store_line("offset_top = -30.0");
@@ -17,15 +17,19 @@ void HUDBuilderModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("var active_components: Dictionary = {}");
 	p_file->store_line("var hud_container: Control");
 	p_file->store_line("");
-	p_file->store_line("# Data binding");
-	p_file->store_line("var bound_data: Dictionary = {}");
-	p_file->store_line("var data_bindings: Dictionary = {}");
+	p_file->store_line("# Data binding: values are pushed to bound widgets once per frame, and only");
+	p_file->store_line("# the widgets bound to values that changed are updated");
+	p_file->store_line("var data_model: HUDDataModel");
 	p_file->store_line("");
 	p_file->store_line("# Configuration");
 	p_file->store_line("var hud_config: Dictionary = {}");
 	p_file->store_line("var current_layout: String = \"default\"");
 	p_file->store_line("");
 	p_file->store_line("func _ready():");
+	p_file->store_line("\tdata_model = HUDDataModel.new()");
+	p_file->store_line("\tdata_model.value_changed.connect(func(data_key, value): hud_data_updated.emit(data_key, value))");
+	p_file->store_line("\tadd_child(data_model)");
+	p_file->store_line("\t");
 	p_file->store_line("\t# Load HUD configuration");
 	p_file->store_line("\tload_hud_config()");
 	p_file->store_line("\t");
@@ -88,6 +92,7 @@ void HUDBuilderModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
 	p_file->store_line("\tvar component = active_components[component_name]");
+	p_file->store_line("\tdata_model.unbind_object(component)");
 	p_file->store_line("\tcomponent.queue_free()");
 	p_file->store_line("\tactive_components.erase(component_name)");
 	p_file->store_line("\t");
@@ -98,33 +103,19 @@ void HUDBuilderModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\treturn active_components.get(component_name, null)");
 	p_file->store_line("");
 	p_file->store_line("# Update data for bound components");
+	p_file->store_line("# Cheap to call every frame: unchanged values are ignored, and changes are");
+	p_file->store_line("# coalesced until the end of the frame");
 	p_file->store_line("func update_data(data_key: String, value: Variant):");
-	p_file->store_line("\tbound_data[data_key] = value");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Update all bound components");
-	p_file->store_line("\tif data_bindings.has(data_key):");
-	p_file->store_line("\t\tfor binding in data_bindings[data_key]:");
-	p_file->store_line("\t\t\tvar component = binding.component");
-	p_file->store_line("\t\t\tvar method = binding.method");
-	p_file->store_line("\t\t\tif is_instance_valid(component) and component.has_method(method):");
-	p_file->store_line("\t\t\t\tcomponent.call(method, value)");
-	p_file->store_line("\t");
-	p_file->store_line("\temit_signal(\"hud_data_updated\", data_key, value)");
+	p_file->store_line("\tdata_model.set_value(data_key, value)");
 	p_file->store_line("");
-	p_file->store_line("# Bind component to data");
+	p_file->store_line("# Bind a component method to data");
 	p_file->store_line("func bind_component_data(component: Control, data_key: String, update_method: String):");
-	p_file->store_line("\tif not data_bindings.has(data_key):");
-	p_file->store_line("\t\tdata_bindings[data_key] = []");
-	p_file->store_line("\t");
-	p_file->store_line("\tdata_bindings[data_key].append({");
-	p_file->store_line("\t\t\"component\": component,");
-	p_file->store_line("\t\t\"method\": update_method");
-	p_file->store_line("\t})");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Send current value if available");
-	p_file->store_line("\tif bound_data.has(data_key):");
-	p_file->store_line("\t\tif component.has_method(update_method):");
-	p_file->store_line("\t\t\tcomponent.call(update_method, bound_data[data_key])");
+	p_file->store_line("\tif component.has_method(update_method):");
+	p_file->store_line("\t\tdata_model.bind_callable(data_key, Callable(component, update_method))");
+	p_file->store_line("");
+	p_file->store_line("# Bind a component property to data, e.g. a ProgressBar's \"value\"");
+	p_file->store_line("func bind_component_property(component: Control, data_key: String, property: NodePath):");
+	p_file->store_line("\tdata_model.bind_property(data_key, component, property)");
 	p_file->store_line("");
 	p_file->store_line("# Setup data binding for a component");
 	p_file->store_line("func setup_component_data_binding(component_name: String, component: Control):");
@@ -175,7 +166,7 @@ void HUDBuilderModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("");
 	p_file->store_line("# Get current data value");
 	p_file->store_line("func get_data(data_key: String) -> Variant:");
-	p_file->store_line("\treturn bound_data.get(data_key, null)");
+	p_file->store_line("\treturn data_model.get_value(data_key)");
 	p_file->store_line("");
 	p_file->store_line("# Clear all components");
 	p_file->store_line("func clear_all_components():");
@@ -443,6 +434,7 @@ void HUDBuilderModule::generate_file(Ref<FileAccess> p_file, const String &p_rel
 		p_file->store_line("\tupdate_display()");
 		p_file->store_line("");
 		p_file->store_line("func update_display():");
+		p_file->store_line("\t# Range clamps the value to max_value, so max_value has to be set first");
 		p_file->store_line("\tif health_progress:");
 		p_file->store_line("\t\thealth_progress.max_value = max_health");
 		p_file->store_line("\t\thealth_progress.value = current_health");
@@ -13,10 +13,11 @@ void InventorySystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("signal item_used(item: Dictionary)");
 	p_file->store_line("signal equipment_changed(slot: String, item: Dictionary)");
 	p_file->store_line("signal inventory_full()");
+	p_file->store_line("signal slots_changed(slots: PackedInt32Array)");
 	p_file->store_line("");
 	p_file->store_line("# Inventory data");
 	p_file->store_line("var inventory_slots: int = 30");
-	p_file->store_line("var items: Array[Dictionary] = []");
+	p_file->store_line("var container := InventoryContainer.new()");
 	p_file->store_line("var equipped_items: Dictionary = {}");
 	p_file->store_line("");
 	p_file->store_line("# Item database");
@@ -33,73 +34,35 @@ void InventorySystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("");
 	p_file->store_line("func _initialize_inventory():");
 	p_file->store_line("\t# Initialize empty inventory");
-	p_file->store_line("\titems.resize(inventory_slots)");
-	p_file->store_line("\tfor i in range(inventory_slots):");
-	p_file->store_line("\t\titems[i] = {}");
+	p_file->store_line("\tcontainer.slot_count = inventory_slots");
+	p_file->store_line("\tcontainer.slots_changed.connect(slots_changed.emit)");
+	p_file->store_line("\t_register_stack_sizes()");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Initialize equipment slots");
 	p_file->store_line("\tfor slot in equipment_slots:");
 	p_file->store_line("\t\tequipped_items[slot] = {}");
 	p_file->store_line("");
+	p_file->store_line("func _register_stack_sizes():");
+	p_file->store_line("\tfor item_id in item_database:");
+	p_file->store_line("\t\tvar item_data = item_database[item_id]");
+	p_file->store_line("\t\tvar max_stack = item_data.get(\"max_stack\", 99) if item_data.get(\"stackable\", false) else 1");
+	p_file->store_line("\t\tcontainer.set_item_max_stack(item_id, max_stack)");
+	p_file->store_line("");
 	p_file->store_line("func add_item(item_id: String, quantity: int = 1) -> bool:");
 	p_file->store_line("\tif not item_database.has(item_id):");
 	p_file->store_line("\t\tprint(\"Item not found in database: \", item_id)");
 	p_file->store_line("\t\treturn false");
 	p_file->store_line("\t");
-	p_file->store_line("\tvar item_data = item_database[item_id].duplicate()");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Check if item is stackable");
-	p_file->store_line("\tif item_data.get(\"stackable\", false):");
-	p_file->store_line("\t\t# Try to stack with existing items");
-	p_file->store_line("\t\tfor i in range(inventory_slots):");
-	p_file->store_line("\t\t\tif items[i].has(\"id\") and items[i].id == item_id:");
-	p_file->store_line("\t\t\t\tvar max_stack = item_data.get(\"max_stack\", 99)");
-	p_file->store_line("\t\t\t\tvar current_quantity = items[i].get(\"quantity\", 1)");
-	p_file->store_line("\t\t\t\tvar can_add = min(quantity, max_stack - current_quantity)");
-	p_file->store_line("\t\t\t\t");
-	p_file->store_line("\t\t\t\tif can_add > 0:");
-	p_file->store_line("\t\t\t\t\titems[i].quantity = current_quantity + can_add");
-	p_file->store_line("\t\t\t\t\tquantity -= can_add");
-	p_file->store_line("\t\t\t\t\titem_added.emit(item_data, can_add)");
-	p_file->store_line("\t\t\t\t\t");
-	p_file->store_line("\t\t\t\t\tif quantity <= 0:");
-	p_file->store_line("\t\t\t\t\t\treturn true");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Add to empty slots");
-	p_file->store_line("\twhile quantity > 0:");
-	p_file->store_line("\t\tvar empty_slot = _find_empty_slot()");
-	p_file->store_line("\t\tif empty_slot == -1:");
-	p_file->store_line("\t\t\tinventory_full.emit()");
-	p_file->store_line("\t\t\treturn false");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\tvar max_stack = item_data.get(\"max_stack\", 1) if item_data.get(\"stackable\", false) else 1");
-	p_file->store_line("\t\tvar add_quantity = min(quantity, max_stack)");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\titems[empty_slot] = item_data.duplicate()");
-	p_file->store_line("\t\titems[empty_slot].quantity = add_quantity");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\tquantity -= add_quantity");
-	p_file->store_line("\t\titem_added.emit(item_data, add_quantity)");
-	p_file->store_line("\t");
+	p_file->store_line("\tvar leftover = container.add_item(item_id, quantity)");
+	p_file->store_line("\tif leftover < quantity:");
+	p_file->store_line("\t\titem_added.emit(item_database[item_id], quantity - leftover)");
+	p_file->store_line("\tif leftover > 0:");
+	p_file->store_line("\t\tinventory_full.emit()");
+	p_file->store_line("\t\treturn false");
 	p_file->store_line("\treturn true");
 	p_file->store_line("");
 	p_file->store_line("func remove_item(item_id: String, quantity: int = 1) -> bool:");
-	p_file->store_line("\tvar removed_quantity = 0");
-	p_file->store_line("\t");
-	p_file->store_line("\tfor i in range(inventory_slots):");
-	p_file->store_line("\t\tif items[i].has(\"id\") and items[i].id == item_id:");
-	p_file->store_line("\t\t\tvar current_quantity = items[i].get(\"quantity\", 1)");
-	p_file->store_line("\t\t\tvar remove_amount = min(quantity - removed_quantity, current_quantity)");
-	p_file->store_line("\t\t\t");
-	p_file->store_line("\t\t\titems[i].quantity = current_quantity - remove_amount");
-	p_file->store_line("\t\t\tremoved_quantity += remove_amount");
-	p_file->store_line("\t\t\t");
-	p_file->store_line("\t\t\tif items[i].quantity <= 0:");
-	p_file->store_line("\t\t\t\titems[i] = {}");
-	p_file->store_line("\t\t\t");
-	p_file->store_line("\t\t\tif removed_quantity >= quantity:");
-	p_file->store_line("\t\t\t\tbreak");
-	p_file->store_line("\t");
+	p_file->store_line("\tvar removed_quantity = container.remove_item(item_id, quantity)");
 	p_file->store_line("\tif removed_quantity > 0:");
 	p_file->store_line("\t\tvar item_data = item_database.get(item_id, {})");
 	p_file->store_line("\t\titem_removed.emit(item_data, removed_quantity)");
@@ -108,19 +71,21 @@ void InventorySystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\treturn false");
 	p_file->store_line("");
 	p_file->store_line("func has_item(item_id: String, quantity: int = 1) -> bool:");
-	p_file->store_line("\tvar total_quantity = 0");
-	p_file->store_line("\t");
-	p_file->store_line("\tfor item in items:");
-	p_file->store_line("\t\tif item.has(\"id\") and item.id == item_id:");
-	p_file->store_line("\t\t\ttotal_quantity += item.get(\"quantity\", 1)");
-	p_file->store_line("\t");
-	p_file->store_line("\treturn total_quantity >= quantity");
+	p_file->store_line("\treturn container.has_item(item_id, quantity)");
+	p_file->store_line("");
+	p_file->store_line("func get_item_count(item_id: String) -> int:");
+	p_file->store_line("\treturn container.get_item_count(item_id)");
+	p_file->store_line("");
+	p_file->store_line("func get_slot(slot_index: int) -> Dictionary:");
+	p_file->store_line("\t# Item data with the slot quantity, or an empty dictionary");
+	p_file->store_line("\tif slot_index < 0 or slot_index >= inventory_slots or container.is_slot_empty(slot_index):");
+	p_file->store_line("\t\treturn {}");
+	p_file->store_line("\tvar item = item_database.get(container.get_slot_item(slot_index), {}).duplicate()");
+	p_file->store_line("\titem.quantity = container.get_slot_quantity(slot_index)");
+	p_file->store_line("\treturn item");
 	p_file->store_line("");
 	p_file->store_line("func use_item(slot_index: int) -> bool:");
-	p_file->store_line("\tif slot_index < 0 or slot_index >= inventory_slots:");
-	p_file->store_line("\t\treturn false");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar item = items[slot_index]");
+	p_file->store_line("\tvar item = get_slot(slot_index)");
 	p_file->store_line("\tif not item.has(\"id\"):");
 	p_file->store_line("\t\treturn false");
 	p_file->store_line("\t");
@@ -158,13 +123,13 @@ void InventorySystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\tif equipment_slot == \"\":");
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
-	p_file->store_line("\t# Unequip current item if any");
-	p_file->store_line("\tif equipped_items[equipment_slot].has(\"id\"):");
-	p_file->store_line("\t\tadd_item(equipped_items[equipment_slot].id, 1)");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Equip new item");
+	p_file->store_line("\t# Equip new item, swapping the current one into its slot");
+	p_file->store_line("\tvar previous = equipped_items[equipment_slot]");
 	p_file->store_line("\tequipped_items[equipment_slot] = item.duplicate()");
-	p_file->store_line("\titems[slot_index] = {}");
+	p_file->store_line("\tequipped_items[equipment_slot].erase(\"quantity\")");
+	p_file->store_line("\tcontainer.clear_slot(slot_index)");
+	p_file->store_line("\tif previous.has(\"id\"):");
+	p_file->store_line("\t\tcontainer.set_slot(slot_index, previous.id, 1)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Apply equipment stats");
 	p_file->store_line("\t_apply_equipment_stats()");
@@ -183,10 +148,7 @@ void InventorySystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t\t\t\t\tPlayerStats.add_equipment_bonus(stat, item.stats[stat])");
 	p_file->store_line("");
 	p_file->store_line("func _find_empty_slot() -> int:");
-	p_file->store_line("\tfor i in range(inventory_slots):");
-	p_file->store_line("\t\tif not items[i].has(\"id\"):");
-	p_file->store_line("\t\t\treturn i");
-	p_file->store_line("\treturn -1");
+	p_file->store_line("\treturn container.find_empty_slot()");
 	p_file->store_line("");
 	p_file->store_line("func _load_item_database():");
 	p_file->store_line("\t# Load item data from JSON");
@@ -227,13 +189,23 @@ void InventorySystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("");
 	p_file->store_line("func get_inventory_data() -> Dictionary:");
 	p_file->store_line("\treturn {");
-	p_file->store_line("\t\t\"items\": items,");
+	p_file->store_line("\t\t# Base64 keeps the data intact in JSON save files");
+	p_file->store_line("\t\t\"container\": Marshalls.raw_to_base64(container.to_bytes()),");
 	p_file->store_line("\t\t\"equipped_items\": equipped_items");
 	p_file->store_line("\t}");
 	p_file->store_line("");
 	p_file->store_line("func load_inventory_data(data: Dictionary):");
-	p_file->store_line("\tif data.has(\"items\"):");
-	p_file->store_line("\t\titems = data.items");
+	p_file->store_line("\tif data.has(\"container\"):");
+	p_file->store_line("\t\tcontainer.from_bytes(Marshalls.base64_to_raw(data.container))");
+	p_file->store_line("\t\tcontainer.slot_count = inventory_slots");
+	p_file->store_line("\t\t_register_stack_sizes()");
+	p_file->store_line("\telif data.has(\"items\"):");
+	p_file->store_line("\t\t# Saves from before the inventory used a container");
+	p_file->store_line("\t\tcontainer.clear()");
+	p_file->store_line("\t\tfor i in range(mini(data.items.size(), inventory_slots)):");
+	p_file->store_line("\t\t\tvar item = data.items[i]");
+	p_file->store_line("\t\t\tif item.has(\"id\"):");
+	p_file->store_line("\t\t\t\tcontainer.set_slot(i, item.id, item.get(\"quantity\", 1))");
 	p_file->store_line("\tif data.has(\"equipped_items\"):");
 	p_file->store_line("\t\tequipped_items = data.equipped_items");
 	p_file->store_line("\t\t_apply_equipment_stats()");
@@ -30,6 +30,12 @@ void JRPGCombatSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("var current_turn_index: int = 0");
 		p_file->store_line("var pending_actions: Array[CombatAction] = []");
 		p_file->store_line("");
+		p_file->store_line("# Native battle engine: turn order, basic attack damage and enemy targeting.");
+		p_file->store_line("# Combatant ids index into combatants; combatant_ids maps back from each node.");
+		p_file->store_line("var simulator: BattleSimulator");
+		p_file->store_line("var combatants: Array = []");
+		p_file->store_line("var combatant_ids: Dictionary = {}");
+		p_file->store_line("");
 		p_file->store_line("# Combat settings");
 		p_file->store_line("@export var auto_battle_speed: float = 1.5");
 		p_file->store_line("@export var animation_speed: float = 1.0");
@@ -50,6 +56,14 @@ void JRPGCombatSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t# Setup battle scene");
 		p_file->store_line("\t_setup_battle_scene()");
 		p_file->store_line("\t");
+		p_file->store_line("\t# Mirror the battle in the simulator");
+		p_file->store_line("\tcombatants.clear()");
+		p_file->store_line("\tcombatant_ids.clear()");
+		p_file->store_line("\tsimulator = _create_simulator(encounter, combatants)");
+		p_file->store_line("\tfor i in range(combatants.size()):");
+		p_file->store_line("\t\tcombatant_ids[combatants[i]] = i");
+		p_file->store_line("\tsimulator.start(randi())");
+		p_file->store_line("\t");
 		p_file->store_line("\t# Initialize turn order");
 		p_file->store_line("\t_calculate_turn_order()");
 		p_file->store_line("\t");
@@ -78,6 +92,9 @@ void JRPGCombatSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tcurrent_encounter = null");
 		p_file->store_line("\tturn_queue.clear()");
 		p_file->store_line("\tpending_actions.clear()");
+		p_file->store_line("\tsimulator = null");
+		p_file->store_line("\tcombatants.clear()");
+		p_file->store_line("\tcombatant_ids.clear()");
 		p_file->store_line("\tcurrent_state = CombatState.NONE");
 		p_file->store_line("");
 		p_file->store_line("func queue_action(action: CombatAction):");
@@ -96,29 +113,62 @@ void JRPGCombatSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\t\t# Position member sprite in battle formation");
 		p_file->store_line("\t\t\t# This would be handled by the battle scene");
 		p_file->store_line("");
-		p_file->store_line("func _calculate_turn_order():");
-		p_file->store_line("\tturn_queue.clear()");
+		p_file->store_line("func _create_simulator(encounter: CombatEncounter, r_combatants: Array) -> BattleSimulator:");
+		p_file->store_line("\tvar sim = BattleSimulator.new()");
+		p_file->store_line("\tsim.mode = BattleSimulator.MODE_PARTY");
+		p_file->store_line("\tsim.damage_formula = BattleSimulator.DAMAGE_FORMULA_SUBTRACTIVE");
+		p_file->store_line("\tsim.crit_chance = 0.0");
+		p_file->store_line("\tsim.stab_multiplier = 1.0");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Full power basic attack: max(1, attack - defense / 2) with 85-115% variance");
+		p_file->store_line("\tsim.add_move(\"attack\", {\"power\": 100})");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Add party members");
 		p_file->store_line("\tif PartyManager:");
-		p_file->store_line("\t\tfor member in PartyManager.get_living_party_members():");
-		p_file->store_line("\t\t\tturn_queue.append(member)");
+		p_file->store_line("\t\tfor member in PartyManager.get_active_party():");
+		p_file->store_line("\t\t\t_add_combatant(sim, 0, member)");
+		p_file->store_line("\t\t\tr_combatants.append(member)");
+		p_file->store_line("\tif encounter:");
+		p_file->store_line("\t\tfor enemy in encounter.enemies:");
+		p_file->store_line("\t\t\t_add_combatant(sim, 1, enemy)");
+		p_file->store_line("\t\t\tr_combatants.append(enemy)");
+		p_file->store_line("\treturn sim");
+		p_file->store_line("");
+		p_file->store_line("func _add_combatant(sim: BattleSimulator, team: int, combatant) -> int:");
+		p_file->store_line("\treturn sim.add_combatant(team, {");
+		p_file->store_line("\t\t\"hp\": combatant.get_max_health() if combatant.has_method(\"get_max_health\") else 100,");
+		p_file->store_line("\t\t\"attack\": combatant.get_attack() if combatant.has_method(\"get_attack\") else 20,");
+		p_file->store_line("\t\t\"defense\": combatant.get_defense() if combatant.has_method(\"get_defense\") else 10,");
+		p_file->store_line("\t\t\"sp_attack\": combatant.get_magic_attack() if combatant.has_method(\"get_magic_attack\") else 15,");
+		p_file->store_line("\t\t\"sp_defense\": combatant.get_magic_defense() if combatant.has_method(\"get_magic_defense\") else 12,");
+		p_file->store_line("\t\t\"speed\": combatant.get_speed() if combatant.has_method(\"get_speed\") else 10,");
+		p_file->store_line("\t\t\"moves\": [\"attack\"]");
+		p_file->store_line("\t})");
+		p_file->store_line("");
+		p_file->store_line("# Skills, items and healing change health outside the simulator");
+		p_file->store_line("func _sync_simulator_health():");
+		p_file->store_line("\tfor i in range(combatants.size()):");
+		p_file->store_line("\t\tvar combatant = combatants[i]");
+		p_file->store_line("\t\tif combatant.has_method(\"is_dead\") and combatant.is_dead():");
+		p_file->store_line("\t\t\tsimulator.set_combatant_hp(i, 0)");
+		p_file->store_line("\t\telif \"current_health\" in combatant:");
+		p_file->store_line("\t\t\tsimulator.set_combatant_hp(i, combatant.current_health)");
+		p_file->store_line("");
+		p_file->store_line("# Balance testing: plays the encounter against the active party with the AI on");
+		p_file->store_line("# both sides. Battles run natively and in parallel, from full health.");
+		p_file->store_line("func simulate_encounter(encounter: CombatEncounter, count: int = 1000, seed: int = 1) -> Dictionary:");
+		p_file->store_line("\treturn _create_simulator(encounter, []).simulate_batch(count, seed)");
+		p_file->store_line("");
+		p_file->store_line("func _calculate_turn_order():");
+		p_file->store_line("\tturn_queue.clear()");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Add enemies");
-		p_file->store_line("\tif current_encounter:");
-		p_file->store_line("\t\tfor enemy in current_encounter.enemies:");
-		p_file->store_line("\t\t\tif not enemy.is_dead():");
-		p_file->store_line("\t\t\t\tturn_queue.append(enemy)");
+		p_file->store_line("\t# Living party members and enemies, fastest first; the simulator breaks");
+		p_file->store_line("\t# speed ties with its seeded generator instead of list order");
+		p_file->store_line("\t_sync_simulator_health()");
+		p_file->store_line("\tfor id in simulator.get_turn_order():");
+		p_file->store_line("\t\tturn_queue.append(combatants[id])");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Sort by speed (highest first)");
-		p_file->store_line("\tturn_queue.sort_custom(_compare_speed)");
 		p_file->store_line("\tcurrent_turn_index = 0");
 		p_file->store_line("");
-		p_file->store_line("func _compare_speed(a, b) -> bool:");
-		p_file->store_line("\tvar speed_a = a.get_speed() if a.has_method(\"get_speed\") else 10");
-		p_file->store_line("\tvar speed_b = b.get_speed() if b.has_method(\"get_speed\") else 10");
-		p_file->store_line("\treturn speed_a > speed_b");
-		p_file->store_line("");
 		p_file->store_line("func _start_next_turn():");
 		p_file->store_line("\tif current_turn_index >= turn_queue.size():");
 		p_file->store_line("\t\t# End of round, start new round");
@@ -150,8 +200,13 @@ void JRPGCombatSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("");
 		p_file->store_line("func _handle_enemy_turn(enemy):");
 		p_file->store_line("\tcurrent_state = CombatState.AI_TURN");
-		p_file->store_line("\t# Enemy AI chooses action");
-		p_file->store_line("\tvar ai_action = CombatAI.choose_enemy_action(enemy, PartyManager.get_active_party())");
+		p_file->store_line("\t# Enemy AI: the simulator picks the party member its attack works best against");
+		p_file->store_line("\t_sync_simulator_health()");
+		p_file->store_line("\tvar id = combatant_ids[enemy]");
+		p_file->store_line("\tvar ai_action = CombatAction.new()");
+		p_file->store_line("\tai_action.type = \"attack\"");
+		p_file->store_line("\tai_action.user = enemy");
+		p_file->store_line("\tai_action.target = combatants[simulator.choose_target(id, simulator.choose_move(id))]");
 		p_file->store_line("\tqueue_action(ai_action)");
 		p_file->store_line("");
 		p_file->store_line("func _all_party_actions_queued() -> bool:");
@@ -196,7 +251,12 @@ void JRPGCombatSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tvar target = action.target");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Calculate damage");
-		p_file->store_line("\tvar damage = _calculate_physical_damage(attacker, target)");
+		p_file->store_line("\tvar damage: int");
+		p_file->store_line("\tif combatant_ids.has(attacker) and combatant_ids.has(target):");
+		p_file->store_line("\t\t_sync_simulator_health()");
+		p_file->store_line("\t\tdamage = simulator.use_move(combatant_ids[attacker], 0, combatant_ids[target]).damage");
+		p_file->store_line("\telse:");
+		p_file->store_line("\t\tdamage = _calculate_physical_damage(attacker, target)");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Apply damage");
 		p_file->store_line("\ttarget.take_damage(damage)");
@@ -0,0 +1,20 @@
+#include "lupine_generated_file.h"
+
+bool LupineGeneratedFile::store_string(const String &p_string) {
+	builder.append(p_string);
+	length += p_string.length();
+	return true;
+}
+
+bool LupineGeneratedFile::store_line(const String &p_line) {
+	builder.append(p_line);
+	builder.append("\n");
+	length += p_line.length() + 1;
+	return true;
+}
+
+bool LupineGeneratedFile::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_COND_V(!p_src && p_length > 0, false);
+	// Generators only emit text, so raw bytes are treated as UTF-8.
+	return store_string(String::utf8((const char *)p_src, p_length));
+}
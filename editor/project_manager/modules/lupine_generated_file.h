@@ -0,0 +1,61 @@
+#ifndef LUPINE_GENERATED_FILE_H
+#define LUPINE_GENERATED_FILE_H
+
+#include "core/io/file_access.h"
+#include "core/string/string_builder.h"
+
+// Write-only FileAccess that collects generator output in memory.
+// Module generators keep emitting one store_line per line, but nothing touches
+// the disk until the finished text is flushed with a single write.
+class LupineGeneratedFile : public FileAccess {
+	GDSOFTCLASS(LupineGeneratedFile, FileAccess);
+
+	String path;
+	StringBuilder builder;
+	uint64_t length = 0;
+
+public:
+	void set_target_path(const String &p_path) { path = p_path; }
+	String get_text() const { return builder.as_string(); }
+
+	virtual Error open_internal(const String &p_path, int p_mode_flags) override { return ERR_UNAVAILABLE; }
+	virtual bool is_open() const override { return true; }
+
+	virtual String get_path() const override { return path; }
+	virtual String get_path_absolute() const override { return path; }
+
+	virtual void seek(uint64_t p_position) override {}
+	virtual void seek_end(int64_t p_position) override {}
+	virtual uint64_t get_position() const override { return length; }
+	virtual uint64_t get_length() const override { return length; }
+
+	virtual bool eof_reached() const override { return true; }
+
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override { return 0; }
+
+	virtual Error get_error() const override { return OK; }
+
+	virtual Error resize(int64_t p_length) override { return ERR_UNAVAILABLE; }
+	virtual void flush() override {}
+	virtual bool store_string(const String &p_string) override;
+	virtual bool store_line(const String &p_line) override;
+	virtual bool store_buffer(const uint8_t *p_src, uint64_t p_length) override;
+
+	virtual bool file_exists(const String &p_name) override { return false; }
+
+	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
+	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
+	virtual int64_t _get_size(const String &p_file) override { return -1; }
+
+	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
+	virtual Error _set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions) override { return FAILED; }
+
+	virtual bool _get_hidden_attribute(const String &p_file) override { return false; }
+	virtual Error _set_hidden_attribute(const String &p_file, bool p_hidden) override { return ERR_UNAVAILABLE; }
+	virtual bool _get_read_only_attribute(const String &p_file) override { return false; }
+	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override { return ERR_UNAVAILABLE; }
+
+	virtual void close() override {}
+};
+
+#endif // LUPINE_GENERATED_FILE_H
@@ -1,5 +1,6 @@
 #include "lupine_module_manager.h"
 #include "lupine_module_base.h"
+#include "lupine_generated_file.h"
 #include "player_stats_module.h"
 #include "player_controller_2d_topdown_8dir_module.h"
 #include "topdown_rpg_8dir_main_scene_module.h"
@@ -54,6 +55,10 @@
 #include "monster_system_module.h"
 #include "monster_capture_system_module.h"
 
+#include "core/io/dir_access.h"
+#include "core/io/resource_uid.h"
+#include "core/object/worker_thread_pool.h"
+
 LupineModuleManager::LupineModuleManager() {
 	initialize_modules();
 }
@@ -717,18 +722,64 @@ void LupineModuleManager::register_module(const String &p_id, LupineModuleBase*
 }
 
 void LupineModuleManager::create_module_file(const String &p_file_path, const String &p_module_id, const String &p_relative_path) {
-	Ref<FileAccess> file = FileAccess::open(p_file_path, FileAccess::WRITE);
-	if (!file.is_valid()) {
-		ERR_PRINT("Failed to create file: " + p_file_path);
+	_write_generated_file(p_file_path, _generate_file_content(p_file_path, p_module_id, p_relative_path));
+}
+
+void LupineModuleManager::create_module_files(const String &p_project_path, const Vector<String> &p_selected_modules) {
+	LocalVector<GenerationJob> jobs;
+	for (const String &module_id : p_selected_modules) {
+		for (const ProjectModule &mod : available_modules) {
+			if (mod.id == module_id) {
+				GenerationJob job;
+				job.module_id = mod.id;
+				job.project_path = p_project_path;
+				job.files_to_create = mod.files_to_create;
+				jobs.push_back(job);
+				break;
+			}
+		}
+	}
+
+	if (jobs.is_empty()) {
 		return;
 	}
 
+	// Generators only build text, so each module can run on its own worker.
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &LupineModuleManager::_generate_module_task, jobs.ptr(), jobs.size(), -1, true, SNAME("LupineGenerateModules"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	// Flush in selection order so files shared by several modules end up as before.
+	Ref<DirAccess> dir = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	for (const GenerationJob &job : jobs) {
+		for (const GeneratedFile &file : job.files) {
+			dir->make_dir_recursive(file.path.get_base_dir());
+			_write_generated_file(file.path, file.content);
+		}
+	}
+}
+
+void LupineModuleManager::_generate_module_task(uint32_t p_index, GenerationJob *p_jobs) {
+	GenerationJob &job = p_jobs[p_index];
+	job.files.reserve(job.files_to_create.size());
+	for (const String &relative_path : job.files_to_create) {
+		GeneratedFile file;
+		file.path = job.project_path.path_join(relative_path);
+		file.content = _generate_file_content(file.path, job.module_id, relative_path);
+		job.files.push_back(file);
+	}
+}
+
+String LupineModuleManager::_generate_file_content(const String &p_file_path, const String &p_module_id, const String &p_relative_path) {
+	Ref<LupineGeneratedFile> file;
+	file.instantiate();
+	file->set_target_path(p_file_path);
+
 	String filename = p_relative_path.get_file();
 
 	// Check if we have a specialized generator for this module
-	if (module_generators.has(p_module_id)) {
-		LupineModuleBase* generator = module_generators[p_module_id];
-		generator->generate_file(file, p_relative_path);
+	LupineModuleBase *const *generator = module_generators.getptr(p_module_id);
+	if (generator) {
+		(*generator)->generate_file(file, p_relative_path);
 	} else {
 		// Handle legacy player controllers and other modules
 		if (p_relative_path.ends_with(".gd")) {
@@ -738,7 +789,57 @@ void LupineModuleManager::create_module_file(const String &p_file_path, const St
 		}
 	}
 
+	return file->get_text();
+}
+
+void LupineModuleManager::_write_generated_file(const String &p_file_path, const String &p_content) {
+	const bool is_scene = p_file_path.ends_with(".tscn");
+	Ref<FileAccess> file = FileAccess::open(p_file_path, FileAccess::WRITE);
+	if (!file.is_valid()) {
+		ERR_PRINT("Failed to create file: " + p_file_path);
+		return;
+	}
+	file->store_string(is_scene ? _ensure_scene_uid(p_content) : p_content);
 	file->close();
+
+	// Scripts keep their UID in a sidecar file. Writing it here means the
+	// editor's first scan finds every script already registered.
+	if (p_file_path.ends_with(".gd") && !FileAccess::exists(p_file_path + ".uid")) {
+		Ref<FileAccess> uid_file = FileAccess::open(p_file_path + ".uid", FileAccess::WRITE);
+		if (uid_file.is_valid()) {
+			uid_file->store_line(ResourceUID::get_singleton()->id_to_text(ResourceUID::get_singleton()->create_id()));
+		}
+	}
+}
+
+String LupineModuleManager::_ensure_scene_uid(const String &p_content) const {
+	// Scenes carry their UID in the header. Placeholder UIDs such as
+	// "uid://player_3d" do not parse, so they are replaced as well.
+	if (!p_content.begins_with("[gd_scene")) {
+		return p_content;
+	}
+	int header_end = p_content.find_char(']');
+	if (header_end < 0) {
+		return p_content;
+	}
+
+	String header = p_content.substr(0, header_end);
+	const String uid_text = ResourceUID::get_singleton()->id_to_text(ResourceUID::get_singleton()->create_id());
+	int uid_pos = header.find(" uid=\"");
+	if (uid_pos < 0) {
+		header += " uid=\"" + uid_text + "\"";
+	} else {
+		int value_begin = uid_pos + 6;
+		int value_end = header.find_char('"', value_begin);
+		if (value_end < 0) {
+			return p_content;
+		}
+		if (ResourceUID::get_singleton()->text_to_id(header.substr(value_begin, value_end - value_begin)) != ResourceUID::INVALID_ID) {
+			return p_content;
+		}
+		header = header.substr(0, value_begin) + uid_text + header.substr(value_end);
+	}
+	return header + p_content.substr(header_end);
 }
 
 void LupineModuleManager::register_autoloads(const String &p_project_path, const Vector<String> &p_selected_modules) {
@@ -778,11 +879,9 @@ void LupineModuleManager::register_autoloads(const String &p_project_path, const
 
 void LupineModuleManager::create_main_scene(const String &p_project_path, const Vector<String> &p_selected_modules) {
 	String main_scene_path = p_project_path.path_join("scenes/Main.tscn");
-	Ref<FileAccess> file = FileAccess::open(main_scene_path, FileAccess::WRITE);
-	if (!file.is_valid()) {
-		ERR_PRINT("Failed to create main scene file: " + main_scene_path);
-		return;
-	}
+	Ref<LupineGeneratedFile> file;
+	file.instantiate();
+	file->set_target_path(main_scene_path);
 
 	// Determine scene type based on selected modules
 	bool is_3d = false;
@@ -831,7 +930,7 @@ void LupineModuleManager::create_main_scene(const String &p_project_path, const
 		_create_2d_main_scene(file, player_scene, camera_scene);
 	}
 
-	file->close();
+	_write_generated_file(main_scene_path, file->get_text());
 }
 
 void LupineModuleManager::_generate_legacy_script(Ref<FileAccess> p_file, const String &p_module_id, const String &p_filename) {
@@ -848,8 +947,9 @@ void LupineModuleManager::_generate_legacy_script(Ref<FileAccess> p_file, const
 		_create_3d_first_person_controller(p_file);
 	} else if (p_filename == "PlayerStats.gd") {
 		// Use the PlayerStats module
-		if (module_generators.has("player_stats")) {
-			module_generators["player_stats"]->generate_script(p_file);
+		LupineModuleBase *const *player_stats = module_generators.getptr("player_stats");
+		if (player_stats) {
+			(*player_stats)->generate_script(p_file);
 		}
 	} else {
 		// Default script template
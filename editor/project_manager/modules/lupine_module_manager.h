@@ -6,6 +6,7 @@
 #include "core/variant/variant.h"
 #include "core/io/file_access.h"
 #include "core/io/config_file.h"
+#include "core/templates/local_vector.h"
 #include "../lupine_project_types.h"
 
 // Forward declarations
@@ -15,6 +16,20 @@ class LupineModuleManager : public RefCounted {
 	GDCLASS(LupineModuleManager, RefCounted);
 
 private:
+	// A file produced in memory, waiting to be flushed to disk.
+	struct GeneratedFile {
+		String path;
+		String content;
+	};
+
+	// All files of one module; modules are generated in parallel.
+	struct GenerationJob {
+		String module_id;
+		String project_path;
+		Vector<String> files_to_create;
+		LocalVector<GeneratedFile> files;
+	};
+
 	Vector<ProjectModule> available_modules;
 	HashMap<String, LupineModuleBase*> module_generators;
 
@@ -30,6 +45,7 @@ public:
 
 	// Create module files
 	void create_module_file(const String &p_file_path, const String &p_module_id, const String &p_relative_path);
+	void create_module_files(const String &p_project_path, const Vector<String> &p_selected_modules);
 
 	// Module registration
 	void register_module(const String &p_id, LupineModuleBase* p_generator);
@@ -39,6 +55,12 @@ public:
 	void create_main_scene(const String &p_project_path, const Vector<String> &p_selected_modules);
 
 private:
+	// In-memory generation
+	String _generate_file_content(const String &p_file_path, const String &p_module_id, const String &p_relative_path);
+	void _generate_module_task(uint32_t p_index, GenerationJob *p_jobs);
+	void _write_generated_file(const String &p_file_path, const String &p_content);
+	String _ensure_scene_uid(const String &p_content) const;
+
 	void _register_player_controllers();
 	void _register_camera_controllers();
 	void _register_core_systems();
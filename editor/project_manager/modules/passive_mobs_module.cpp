@@ -20,20 +20,21 @@ void PassiveMobsModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("@export var bark_cooldown: float = 3.0");
 		p_file->store_line("@export var move_speed: float = 30.0");
 		p_file->store_line("@export var wander_range: float = 100.0");
+		p_file->store_line("@export var flee_from_player: bool = false");
+		p_file->store_line("");
+		p_file->store_line("# All passive mobs are moved by one shared crowd instead of their own");
+		p_file->store_line("# physics process. The crowd only writes their position; state changes");
+		p_file->store_line("# come back through _on_crowd_state_changed.");
+		p_file->store_line("static var shared_crowd: Crowd2D = null");
 		p_file->store_line("");
 		p_file->store_line("# State");
 		p_file->store_line("var player_nearby: bool = false");
-		p_file->store_line("var can_bark: bool = true");
-		p_file->store_line("var bark_timer: float = 0.0");
-		p_file->store_line("var initial_position: Vector2");
-		p_file->store_line("var wander_target: Vector2");
-		p_file->store_line("var wander_timer: float = 0.0");
-		p_file->store_line("var idle_time: float = 0.0");
+		p_file->store_line("var next_bark_time: int = 0");
+		p_file->store_line("var crowd: Crowd2D");
+		p_file->store_line("var agent: int = -1");
 		p_file->store_line("");
 		p_file->store_line("# Components");
 		p_file->store_line("@onready var sprite: Sprite2D = $Sprite2D");
-		p_file->store_line("@onready var detection_area: Area2D = $DetectionArea");
-		p_file->store_line("@onready var interaction_area: Area2D = $InteractionArea");
 		p_file->store_line("@onready var interaction_prompt: Label = $InteractionPrompt");
 		p_file->store_line("");
 		p_file->store_line("# Effect scenes");
@@ -41,99 +42,64 @@ void PassiveMobsModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("var heart_effect_scene: PackedScene");
 		p_file->store_line("");
 		p_file->store_line("func _ready():");
-		p_file->store_line("\tinitial_position = global_position");
-		p_file->store_line("\twander_target = global_position");
-		p_file->store_line("\t");
 		p_file->store_line("\t# Load effect scenes");
 		p_file->store_line("\tbark_bubble_scene = preload(\"res://scenes/effects/BarkBubble.tscn\")");
 		p_file->store_line("\theart_effect_scene = preload(\"res://scenes/effects/HeartEffect.tscn\")");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Setup areas");
-		p_file->store_line("\tif detection_area:");
-		p_file->store_line("\t\tdetection_area.body_entered.connect(_on_player_detected)");
-		p_file->store_line("\t\tdetection_area.body_exited.connect(_on_player_left)");
-		p_file->store_line("\t\t_setup_detection_area()");
+		p_file->store_line("\tif interaction_prompt:");
+		p_file->store_line("\t\tinteraction_prompt.visible = false");
 		p_file->store_line("\t");
-		p_file->store_line("\tif interaction_area:");
-		p_file->store_line("\t\tinteraction_area.body_entered.connect(_on_interaction_range_entered)");
-		p_file->store_line("\t\tinteraction_area.body_exited.connect(_on_interaction_range_exited)");
-		p_file->store_line("\t\t_setup_interaction_area()");
+		p_file->store_line("\t# Mobs only need per-frame work while the player is around");
+		p_file->store_line("\tset_process(false)");
+		p_file->store_line("\tset_process_input(false)");
 		p_file->store_line("\t");
+		p_file->store_line("\t# Subclasses set their properties after super._ready(), so join the crowd once they are done");
+		p_file->store_line("\t_join_crowd.call_deferred()");
+		p_file->store_line("");
+		p_file->store_line("func _exit_tree():");
+		p_file->store_line("\tif crowd and crowd.has_agent(agent):");
+		p_file->store_line("\t\tcrowd.remove_agent(agent)");
+		p_file->store_line("\tagent = -1");
+		p_file->store_line("");
+		p_file->store_line("static func get_crowd(tree: SceneTree) -> Crowd2D:");
+		p_file->store_line("\tif not is_instance_valid(shared_crowd):");
+		p_file->store_line("\t\tshared_crowd = Crowd2D.new()");
+		p_file->store_line("\t\tshared_crowd.name = \"PassiveMobCrowd\"");
+		p_file->store_line("\t\ttree.current_scene.add_child.call_deferred(shared_crowd)");
+		p_file->store_line("\treturn shared_crowd");
+		p_file->store_line("");
+		p_file->store_line("func _join_crowd():");
+		p_file->store_line("\tcrowd = get_crowd(get_tree())");
+		p_file->store_line("\tvar reaction = Crowd2D.REACTION_FLEE if flee_from_player else Crowd2D.REACTION_NONE");
+		p_file->store_line("\tagent = crowd.add_agent(global_position, reaction, self)");
+		p_file->store_line("\tcrowd.set_agent_speed(agent, move_speed)");
+		p_file->store_line("\tcrowd.set_agent_perception_radius(agent, detection_range)");
+		p_file->store_line("\tcrowd.set_agent_wander_radius(agent, wander_range)");
+		p_file->store_line("\tcrowd.set_agent_callback(agent, _on_crowd_state_changed)");
+		p_file->store_line("");
+		p_file->store_line("func _on_crowd_state_changed(state: int, facing_left: bool):");
+		p_file->store_line("\tsprite.flip_h = facing_left");
+		p_file->store_line("\t");
+		p_file->store_line("\tvar nearby = state == Crowd2D.STATE_ALERT or state == Crowd2D.STATE_FLEE");
+		p_file->store_line("\tif nearby != player_nearby:");
+		p_file->store_line("\t\tplayer_nearby = nearby");
+		p_file->store_line("\t\tset_process(nearby)");
+		p_file->store_line("\t\tset_process_input(nearby)");
+		p_file->store_line("\t\tif nearby:");
+		p_file->store_line("\t\t\t_try_bark()");
+		p_file->store_line("\t\telif interaction_prompt:");
+		p_file->store_line("\t\t\tinteraction_prompt.visible = false");
+		p_file->store_line("");
+		p_file->store_line("func _process(delta):");
 		p_file->store_line("\tif interaction_prompt:");
-		p_file->store_line("\t\tinteraction_prompt.visible = false");
-		p_file->store_line("");
-		p_file->store_line("func _physics_process(delta):");
-		p_file->store_line("\t_update_timers(delta)");
-		p_file->store_line("\t_handle_movement(delta)");
-		p_file->store_line("\tmove_and_slide()");
+		p_file->store_line("\t\tinteraction_prompt.visible = _can_interact()");
 		p_file->store_line("");
 		p_file->store_line("func _input(event):");
 		p_file->store_line("\tif event.is_action_pressed(\"interact\") and _can_interact():");
 		p_file->store_line("\t\t_interact()");
 		p_file->store_line("");
-		p_file->store_line("func _update_timers(delta: float):");
-		p_file->store_line("\tbark_timer -= delta");
-		p_file->store_line("\tif bark_timer <= 0:");
-		p_file->store_line("\t\tcan_bark = true");
-		p_file->store_line("\t");
-		p_file->store_line("\twander_timer -= delta");
-		p_file->store_line("\tidle_time += delta");
-		p_file->store_line("");
-		p_file->store_line("func _handle_movement(delta: float):");
-		p_file->store_line("\tif player_nearby:");
-		p_file->store_line("\t\t# Face the player");
-		p_file->store_line("\t\tvar player = get_tree().get_first_node_in_group(\"player\")");
-		p_file->store_line("\t\tif player:");
-		p_file->store_line("\t\t\tvar direction = (player.global_position - global_position).normalized()");
-		p_file->store_line("\t\t\tsprite.flip_h = direction.x < 0");
-		p_file->store_line("\t\t\tvelocity = Vector2.ZERO");
-		p_file->store_line("\t\treturn");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Wander behavior");
-		p_file->store_line("\tif wander_timer <= 0:");
-		p_file->store_line("\t\t_choose_new_wander_target()");
-		p_file->store_line("\t\twander_timer = randf_range(2.0, 5.0)");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Move towards wander target");
-		p_file->store_line("\tvar distance_to_target = global_position.distance_to(wander_target)");
-		p_file->store_line("\tif distance_to_target > 10.0:");
-		p_file->store_line("\t\tvar direction = (wander_target - global_position).normalized()");
-		p_file->store_line("\t\tvelocity = direction * move_speed");
-		p_file->store_line("\t\tsprite.flip_h = direction.x < 0");
-		p_file->store_line("\telse:");
-		p_file->store_line("\t\tvelocity = Vector2.ZERO");
-		p_file->store_line("");
-		p_file->store_line("func _choose_new_wander_target():");
-		p_file->store_line("\tvar angle = randf() * TAU");
-		p_file->store_line("\tvar distance = randf() * wander_range");
-		p_file->store_line("\twander_target = initial_position + Vector2(cos(angle), sin(angle)) * distance");
-		p_file->store_line("");
-		p_file->store_line("func _on_player_detected(body: Node):");
-		p_file->store_line("\tif body.name.contains(\"Player\"):");
-		p_file->store_line("\t\tplayer_nearby = true");
-		p_file->store_line("\t\t_try_bark()");
-		p_file->store_line("");
-		p_file->store_line("func _on_player_left(body: Node):");
-		p_file->store_line("\tif body.name.contains(\"Player\"):");
-		p_file->store_line("\t\tplayer_nearby = false");
-		p_file->store_line("");
-		p_file->store_line("func _on_interaction_range_entered(body: Node):");
-		p_file->store_line("\tif body.name.contains(\"Player\") and interaction_prompt:");
-		p_file->store_line("\t\tinteraction_prompt.visible = true");
-		p_file->store_line("");
-		p_file->store_line("func _on_interaction_range_exited(body: Node):");
-		p_file->store_line("\tif body.name.contains(\"Player\") and interaction_prompt:");
-		p_file->store_line("\t\tinteraction_prompt.visible = false");
-		p_file->store_line("");
 		p_file->store_line("func _can_interact() -> bool:");
-		p_file->store_line("\tif not interaction_area:");
-		p_file->store_line("\t\treturn false");
-		p_file->store_line("\t");
-		p_file->store_line("\tvar bodies = interaction_area.get_overlapping_bodies()");
-		p_file->store_line("\tfor body in bodies:");
-		p_file->store_line("\t\tif body.name.contains(\"Player\"):");
-		p_file->store_line("\t\t\treturn true");
-		p_file->store_line("\treturn false");
+		p_file->store_line("\treturn player_nearby and crowd.get_agent_target_distance(agent) <= interaction_range");
 		p_file->store_line("");
 		p_file->store_line("func _interact():");
 		p_file->store_line("\t# Show heart effect");
@@ -145,11 +111,11 @@ void PassiveMobsModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\t_show_bark(message)");
 		p_file->store_line("");
 		p_file->store_line("func _try_bark():");
-		p_file->store_line("\tif can_bark and bark_messages.size() > 0:");
+		p_file->store_line("\tvar now = Time.get_ticks_msec()");
+		p_file->store_line("\tif now >= next_bark_time and bark_messages.size() > 0:");
 		p_file->store_line("\t\tvar message = bark_messages[randi() % bark_messages.size()]");
 		p_file->store_line("\t\t_show_bark(message)");
-		p_file->store_line("\t\tcan_bark = false");
-		p_file->store_line("\t\tbark_timer = bark_cooldown");
+		p_file->store_line("\t\tnext_bark_time = now + int(bark_cooldown * 1000)");
 		p_file->store_line("");
 		p_file->store_line("func _show_bark(message: String):");
 		p_file->store_line("\tif bark_bubble_scene:");
@@ -164,16 +130,6 @@ void PassiveMobsModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\tvar heart = heart_effect_scene.instantiate()");
 		p_file->store_line("\t\tget_tree().current_scene.add_child(heart)");
 		p_file->store_line("\t\theart.global_position = global_position + Vector2(0, -30)");
-		p_file->store_line("");
-		p_file->store_line("func _setup_detection_area():");
-		p_file->store_line("\tvar detection_shape = detection_area.get_child(0) as CollisionShape2D");
-		p_file->store_line("\tif detection_shape and detection_shape.shape is CircleShape2D:");
-		p_file->store_line("\t\t(detection_shape.shape as CircleShape2D).radius = detection_range");
-		p_file->store_line("");
-		p_file->store_line("func _setup_interaction_area():");
-		p_file->store_line("\tvar interaction_shape = interaction_area.get_child(0) as CollisionShape2D");
-		p_file->store_line("\tif interaction_shape and interaction_shape.shape is CircleShape2D:");
-		p_file->store_line("\t\t(interaction_shape.shape as CircleShape2D).radius = interaction_range");
 	} else if (filename == "Cow.gd") {
 		p_file->store_line("# Cow.gd");
 		p_file->store_line("# Generated by Lupine Engine - Cow Passive Mob");
@@ -232,19 +188,13 @@ void PassiveMobsModule::generate_script(Ref<FileAccess> p_file) {
 
 void PassiveMobsModule::generate_scene(Ref<FileAccess> p_file, const String &p_scene_name) {
 	if (p_scene_name == "Cow") {
-		p_file->store_line("[gd_scene load_steps=4 format=3 uid=\"uid://cow_mob\"]");
+		p_file->store_line("[gd_scene load_steps=2 format=3 uid=\"uid://cow_mob\"]");
 		p_file->store_line("");
 		p_file->store_line("[ext_resource type=\"Script\" path=\"res://scripts/mobs/Cow.gd\" id=\"1_cow_script\"]");
 		p_file->store_line("");
 		p_file->store_line("[sub_resource type=\"RectangleShape2D\" id=\"RectangleShape2D_1\"]");
 		p_file->store_line("size = Vector2(40, 30)");
 		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_1\"]");
-		p_file->store_line("radius = 80.0");
-		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_2\"]");
-		p_file->store_line("radius = 50.0");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"Cow\" type=\"CharacterBody2D\"]");
 		p_file->store_line("script = ExtResource(\"1_cow_script\")");
 		p_file->store_line("");
@@ -255,16 +205,6 @@ void PassiveMobsModule::generate_scene(Ref<FileAccess> p_file, const String &p_s
 		p_file->store_line("[node name=\"CollisionShape2D\" type=\"CollisionShape2D\" parent=\".\"]");
 		p_file->store_line("shape = SubResource(\"RectangleShape2D_1\")");
 		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionShape\" type=\"CollisionShape2D\" parent=\"DetectionArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_1\")");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"InteractionArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"InteractionShape\" type=\"CollisionShape2D\" parent=\"InteractionArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_2\")");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"InteractionPrompt\" type=\"Label\" parent=\".\"]");
 		p_file->store_line("offset_left = -25.0");
 		p_file->store_line("offset_top = -50.0");
@@ -273,19 +213,13 @@ void PassiveMobsModule::generate_scene(Ref<FileAccess> p_file, const String &p_s
 		p_file->store_line("text = \"Press E\"");
 		p_file->store_line("horizontal_alignment = 1");
 	} else if (p_scene_name == "Cat") {
-		p_file->store_line("[gd_scene load_steps=4 format=3 uid=\"uid://cat_mob\"]");
+		p_file->store_line("[gd_scene load_steps=2 format=3 uid=\"uid://cat_mob\"]");
 		p_file->store_line("");
 		p_file->store_line("[ext_resource type=\"Script\" path=\"res://scripts/mobs/Cat.gd\" id=\"1_cat_script\"]");
 		p_file->store_line("");
 		p_file->store_line("[sub_resource type=\"RectangleShape2D\" id=\"RectangleShape2D_1\"]");
 		p_file->store_line("size = Vector2(24, 16)");
 		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_1\"]");
-		p_file->store_line("radius = 80.0");
-		p_file->store_line("");
-		p_file->store_line("[sub_resource type=\"CircleShape2D\" id=\"CircleShape2D_2\"]");
-		p_file->store_line("radius = 50.0");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"Cat\" type=\"CharacterBody2D\"]");
 		p_file->store_line("script = ExtResource(\"1_cat_script\")");
 		p_file->store_line("");
@@ -296,16 +230,6 @@ void PassiveMobsModule::generate_scene(Ref<FileAccess> p_file, const String &p_s
 		p_file->store_line("[node name=\"CollisionShape2D\" type=\"CollisionShape2D\" parent=\".\"]");
 		p_file->store_line("shape = SubResource(\"RectangleShape2D_1\")");
 		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"DetectionShape\" type=\"CollisionShape2D\" parent=\"DetectionArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_1\")");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"InteractionArea\" type=\"Area2D\" parent=\".\"]");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"InteractionShape\" type=\"CollisionShape2D\" parent=\"InteractionArea\"]");
-		p_file->store_line("shape = SubResource(\"CircleShape2D_2\")");
-		p_file->store_line("");
 		p_file->store_line("[node name=\"InteractionPrompt\" type=\"Label\" parent=\".\"]");
 		p_file->store_line("offset_left = -25.0");
 		p_file->store_line("offset_top = -40.0");
@@ -36,6 +36,12 @@ void PokemonBattleSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("var battle_calculator: BattleCalculator");
 		p_file->store_line("var battle_ai: BattleAI");
 		p_file->store_line("");
+		p_file->store_line("# Native battle engine: turn order, damage, status effects and enemy AI.");
+		p_file->store_line("# Combatant ids index into combatants; combatant_ids maps back from each Pokemon.");
+		p_file->store_line("var simulator: BattleSimulator");
+		p_file->store_line("var combatants: Array[Pokemon] = []");
+		p_file->store_line("var combatant_ids: Dictionary = {}");
+		p_file->store_line("");
 		p_file->store_line("# Player and enemy teams");
 		p_file->store_line("var player_team: Array[Pokemon] = []");
 		p_file->store_line("var enemy_team: Array[Pokemon] = []");
@@ -51,11 +57,13 @@ void PokemonBattleSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("@export var auto_battle_speed: float = 2.0");
 		p_file->store_line("@export var allow_escape: bool = true");
 		p_file->store_line("@export var wild_pokemon_escape_chance: float = 0.1");
+		p_file->store_line("@export var battle_seed: int = 0  # Replays the same battle when non-zero");
 		p_file->store_line("");
 		p_file->store_line("func _ready():");
 		p_file->store_line("\t# Initialize systems");
 		p_file->store_line("\tbattle_calculator = BattleCalculator.new()");
 		p_file->store_line("\tbattle_ai = BattleAI.new()");
+		p_file->store_line("\tsimulator = _create_simulator()");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Load battle UI");
 		p_file->store_line("\tvar ui_scene = preload(\"res://scenes/ui/PokemonBattleUI.tscn\")");
@@ -84,6 +92,8 @@ void PokemonBattleSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tbattle_ui.visible = true");
 		p_file->store_line("\tbattle_ui.setup_battle(current_player_pokemon, current_enemy_pokemon)");
 		p_file->store_line("\t");
+		p_file->store_line("\t_setup_simulator()");
+		p_file->store_line("\t");
 		p_file->store_line("\tbattle_started.emit(player_team, enemy_team)");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Start first turn");
@@ -95,6 +105,86 @@ void PokemonBattleSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\t\treturn pokemon");
 		p_file->store_line("\treturn null");
 		p_file->store_line("");
+		p_file->store_line("func _create_simulator() -> BattleSimulator:");
+		p_file->store_line("\tvar sim = BattleSimulator.new()");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Type chart: rows are defending types");
+		p_file->store_line("\tfor defending_type in PokemonType.TYPE_CHART:");
+		p_file->store_line("\t\tvar data = PokemonType.TYPE_CHART[defending_type]");
+		p_file->store_line("\t\tfor attacking_type in data.weak_to:");
+		p_file->store_line("\t\t\tsim.set_type_effectiveness(attacking_type, defending_type, 2.0)");
+		p_file->store_line("\t\tfor attacking_type in data.resists:");
+		p_file->store_line("\t\t\tsim.set_type_effectiveness(attacking_type, defending_type, 0.5)");
+		p_file->store_line("\t\tfor attacking_type in data.immune_to:");
+		p_file->store_line("\t\t\tsim.set_type_effectiveness(attacking_type, defending_type, 0.0)");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Status effects, matching BattleCalculator._create_status_effect()");
+		p_file->store_line("\tsim.add_effect(\"poison\", {\"damage\": 1.0 / 8.0})");
+		p_file->store_line("\tsim.add_effect(\"burn\", {\"damage\": 1.0 / 16.0, \"attack_scale\": 0.5})");
+		p_file->store_line("\tsim.add_effect(\"paralysis\", {\"speed_scale\": 0.25, \"skip_chance\": 0.25})");
+		p_file->store_line("\tsim.add_effect(\"sleep\", {\"min_turns\": 1, \"max_turns\": 3, \"skip_chance\": 1.0})");
+		p_file->store_line("\tsim.add_effect(\"freeze\", {\"skip_chance\": 1.0})");
+		p_file->store_line("\treturn sim");
+		p_file->store_line("");
+		p_file->store_line("func _add_combatant(sim: BattleSimulator, team: int, pokemon: Pokemon) -> int:");
+		p_file->store_line("\tvar move_names = []");
+		p_file->store_line("\tfor move in pokemon.moves.slice(0, BattleSimulator.MAX_MOVES):");
+		p_file->store_line("\t\tif not sim.has_move(move.move_name):");
+		p_file->store_line("\t\t\tsim.add_move(move.move_name, {");
+		p_file->store_line("\t\t\t\t\"type\": move.move_type,");
+		p_file->store_line("\t\t\t\t\"power\": move.power,");
+		p_file->store_line("\t\t\t\t\"accuracy\": move.accuracy,");
+		p_file->store_line("\t\t\t\t\"pp\": move.pp,");
+		p_file->store_line("\t\t\t\t\"priority\": move.priority,");
+		p_file->store_line("\t\t\t\t\"category\": move.category,");
+		p_file->store_line("\t\t\t\t\"target\": \"self\" if move.target == \"self\" else \"enemy\",");
+		p_file->store_line("\t\t\t\t\"effect\": move.status_effect if sim.has_effect(move.status_effect) else \"\",");
+		p_file->store_line("\t\t\t\t\"effect_chance\": move.status_chance");
+		p_file->store_line("\t\t\t})");
+		p_file->store_line("\t\tmove_names.append(move.move_name)");
+		p_file->store_line("\t");
+		p_file->store_line("\treturn sim.add_combatant(team, {");
+		p_file->store_line("\t\t\"level\": pokemon.level,");
+		p_file->store_line("\t\t\"hp\": pokemon.max_hp,");
+		p_file->store_line("\t\t\"attack\": pokemon.current_stats.get(\"attack\", 50),");
+		p_file->store_line("\t\t\"defense\": pokemon.current_stats.get(\"defense\", 50),");
+		p_file->store_line("\t\t\"sp_attack\": pokemon.current_stats.get(\"sp_attack\", 50),");
+		p_file->store_line("\t\t\"sp_defense\": pokemon.current_stats.get(\"sp_defense\", 50),");
+		p_file->store_line("\t\t\"speed\": pokemon.current_stats.get(\"speed\", 50),");
+		p_file->store_line("\t\t\"type1\": pokemon.type1,");
+		p_file->store_line("\t\t\"type2\": pokemon.type2,");
+		p_file->store_line("\t\t\"moves\": move_names");
+		p_file->store_line("\t})");
+		p_file->store_line("");
+		p_file->store_line("func _setup_simulator():");
+		p_file->store_line("\tsimulator.clear_combatants()");
+		p_file->store_line("\tcombatants.clear()");
+		p_file->store_line("\tcombatant_ids.clear()");
+		p_file->store_line("\tfor pokemon in player_team:");
+		p_file->store_line("\t\tcombatant_ids[pokemon] = _add_combatant(simulator, 0, pokemon)");
+		p_file->store_line("\t\tcombatants.append(pokemon)");
+		p_file->store_line("\tfor pokemon in enemy_team:");
+		p_file->store_line("\t\tcombatant_ids[pokemon] = _add_combatant(simulator, 1, pokemon)");
+		p_file->store_line("\t\tcombatants.append(pokemon)");
+		p_file->store_line("\t");
+		p_file->store_line("\tsimulator.start(battle_seed if battle_seed != 0 else randi())");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Carry over damage from earlier battles");
+		p_file->store_line("\tfor pokemon in combatants:");
+		p_file->store_line("\t\tsimulator.set_combatant_hp(combatant_ids[pokemon], pokemon.current_hp)");
+		p_file->store_line("\tsimulator.set_active_combatant(0, combatant_ids[current_player_pokemon])");
+		p_file->store_line("\tsimulator.set_active_combatant(1, combatant_ids[current_enemy_pokemon])");
+		p_file->store_line("");
+		p_file->store_line("# Balance testing: plays the teams against each other with the AI on both sides.");
+		p_file->store_line("# Battles run natively and in parallel, so thousands take well under a second.");
+		p_file->store_line("func simulate_battles(player_pokemon: Array[Pokemon], enemy_pokemon: Array[Pokemon], count: int = 1000, seed: int = 1) -> Dictionary:");
+		p_file->store_line("\tvar sim = _create_simulator()");
+		p_file->store_line("\tfor pokemon in player_pokemon:");
+		p_file->store_line("\t\t_add_combatant(sim, 0, pokemon)");
+		p_file->store_line("\tfor pokemon in enemy_pokemon:");
+		p_file->store_line("\t\t_add_combatant(sim, 1, pokemon)");
+		p_file->store_line("\treturn sim.simulate_batch(count, seed)");
+		p_file->store_line("");
 		p_file->store_line("func _start_turn():");
 		p_file->store_line("\tif current_state == BattleState.ENDED:");
 		p_file->store_line("\t\treturn");
@@ -112,56 +202,94 @@ void PokemonBattleSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tbattle_ui.show_action_menu()");
 		p_file->store_line("");
 		p_file->store_line("func _calculate_turn_order():");
-		p_file->store_line("\t# Simple speed-based turn order");
-		p_file->store_line("\t# In a full implementation, this would consider move priority, items, abilities, etc.");
+		p_file->store_line("\t# Priority, speed, paralysis and speed ties are resolved by the simulator,");
+		p_file->store_line("\t# using the enemy's planned move (the player's move isn't known yet)");
 		p_file->store_line("\tturn_queue.clear()");
-		p_file->store_line("\t");
-		p_file->store_line("\tvar player_speed = current_player_pokemon.get_effective_speed()");
-		p_file->store_line("\tvar enemy_speed = current_enemy_pokemon.get_effective_speed()");
-		p_file->store_line("\t");
-		p_file->store_line("\tif player_speed >= enemy_speed:");
-		p_file->store_line("\t\tturn_queue = [current_player_pokemon, current_enemy_pokemon]");
-		p_file->store_line("\telse:");
-		p_file->store_line("\t\tturn_queue = [current_enemy_pokemon, current_player_pokemon]");
+		p_file->store_line("\tfor id in simulator.get_turn_order():");
+		p_file->store_line("\t\tturn_queue.append(combatants[id])");
 		p_file->store_line("");
 		p_file->store_line("func use_move(user: Pokemon, target: Pokemon, move: PokemonMove):");
 		p_file->store_line("\tcurrent_state = BattleState.PROCESSING");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Calculate damage and effects");
-		p_file->store_line("\tvar result = battle_calculator.calculate_move_damage(user, target, move)");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Apply damage");
-		p_file->store_line("\ttarget.take_damage(result.damage)");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Apply status effects");
-		p_file->store_line("\tif result.status_effect:");
-		p_file->store_line("\t\ttarget.apply_status_effect(result.status_effect)");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Emit signal");
-		p_file->store_line("\tmove_used.emit(user, target, move)");
+		p_file->store_line("\t# Queue the player's move; the simulator picks the enemy's move and");
+		p_file->store_line("\t# resolves the whole turn, including end-of-turn status damage");
+		p_file->store_line("\tvar slot = user.moves.find(move)");
+		p_file->store_line("\tsimulator.set_choice(combatant_ids[user], slot if slot < BattleSimulator.MAX_MOVES else -1, combatant_ids.get(target, -1))");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Update UI");
-		p_file->store_line("\tbattle_ui.show_move_result(user, target, move, result)");
+		p_file->store_line("\tfor event in simulator.step_turn():");
+		p_file->store_line("\t\tawait _apply_battle_event(event)");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Check if target fainted");
-		p_file->store_line("\tif target.current_hp <= 0:");
-		p_file->store_line("\t\ttarget.faint()");
-		p_file->store_line("\t\tpokemon_fainted.emit(target)");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Continue to next turn or end battle");
-		p_file->store_line("\tawait get_tree().create_timer(1.0).timeout");
 		p_file->store_line("\t_next_turn()");
 		p_file->store_line("");
 		p_file->store_line("func switch_pokemon(new_pokemon: Pokemon):");
 		p_file->store_line("\tvar old_pokemon = current_player_pokemon");
 		p_file->store_line("\tcurrent_player_pokemon = new_pokemon");
+		p_file->store_line("\tsimulator.set_active_combatant(0, combatant_ids[new_pokemon])");
 		p_file->store_line("\t");
 		p_file->store_line("\tpokemon_switched.emit(old_pokemon, new_pokemon)");
 		p_file->store_line("\tbattle_ui.update_player_pokemon(new_pokemon)");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Switching takes the turn");
+		p_file->store_line("\t# Switching takes the turn: only the enemy acts");
+		p_file->store_line("\tcurrent_state = BattleState.ENEMY_TURN");
+		p_file->store_line("\tturn_started.emit(current_enemy_pokemon)");
+		p_file->store_line("\tvar enemy_id = combatant_ids[current_enemy_pokemon]");
+		p_file->store_line("\tvar enemy_slot = simulator.choose_move(enemy_id)");
+		p_file->store_line("\tvar events = [simulator.use_move(enemy_id, enemy_slot, simulator.choose_target(enemy_id, enemy_slot))]");
+		p_file->store_line("\tevents.append_array(simulator.end_turn())");
+		p_file->store_line("\t");
+		p_file->store_line("\tfor event in events:");
+		p_file->store_line("\t\tawait _apply_battle_event(event)");
+		p_file->store_line("\t");
 		p_file->store_line("\t_next_turn()");
 		p_file->store_line("");
+		p_file->store_line("# Mirrors a simulator event onto the Pokemon nodes, signals and UI");
+		p_file->store_line("func _apply_battle_event(event: Dictionary):");
+		p_file->store_line("\tmatch event.type:");
+		p_file->store_line("\t\t\"move\":");
+		p_file->store_line("\t\t\tvar user = combatants[event.user]");
+		p_file->store_line("\t\t\tvar target = combatants[event.target]");
+		p_file->store_line("\t\t\tvar move = user.moves[event.slot] if event.slot >= 0 else battle_ai._get_struggle_move()");
+		p_file->store_line("\t\t\tif event.skipped:");
+		p_file->store_line("\t\t\t\treturn");
+		p_file->store_line("\t\t\tif event.slot >= 0:");
+		p_file->store_line("\t\t\t\tmove.use_move()");
+		p_file->store_line("\t\t\t");
+		p_file->store_line("\t\t\ttarget.take_damage(event.damage)");
+		p_file->store_line("\t\t\tif event.heal > 0:");
+		p_file->store_line("\t\t\t\ttarget.heal(event.heal)");
+		p_file->store_line("\t\t\tevent[\"status_effect\"] = null");
+		p_file->store_line("\t\t\tif event.effect != &\"\":");
+		p_file->store_line("\t\t\t\tevent.status_effect = battle_calculator._create_status_effect(event.effect)");
+		p_file->store_line("\t\t\t\ttarget.apply_status_effect(event.status_effect)");
+		p_file->store_line("\t\t\t");
+		p_file->store_line("\t\t\tmove_used.emit(user, target, move)");
+		p_file->store_line("\t\t\tbattle_ui.show_move_result(user, target, move, event)");
+		p_file->store_line("\t\t\t");
+		p_file->store_line("\t\t\tif event.fainted:");
+		p_file->store_line("\t\t\t\ttarget.faint()");
+		p_file->store_line("\t\t\t\tpokemon_fainted.emit(target)");
+		p_file->store_line("\t\t\tawait get_tree().create_timer(1.0 / animation_speed).timeout");
+		p_file->store_line("\t\t\"status\":");
+		p_file->store_line("\t\t\tvar pokemon = combatants[event.combatant]");
+		p_file->store_line("\t\t\tpokemon.take_damage(event.damage)");
+		p_file->store_line("\t\t\tif event.cured:");
+		p_file->store_line("\t\t\t\tfor effect in pokemon.status_effects.duplicate():");
+		p_file->store_line("\t\t\t\t\tif effect.effect_type == event.effect:");
+		p_file->store_line("\t\t\t\t\t\tpokemon.status_effects.erase(effect)");
+		p_file->store_line("\t\t\tif event.fainted:");
+		p_file->store_line("\t\t\t\tpokemon.faint()");
+		p_file->store_line("\t\t\t\tpokemon_fainted.emit(pokemon)");
+		p_file->store_line("\t\t\"switch\":");
+		p_file->store_line("\t\t\tvar pokemon = combatants[event.combatant]");
+		p_file->store_line("\t\t\tif event.team == 0:");
+		p_file->store_line("\t\t\t\tvar old_pokemon = current_player_pokemon");
+		p_file->store_line("\t\t\t\tcurrent_player_pokemon = pokemon");
+		p_file->store_line("\t\t\t\tpokemon_switched.emit(old_pokemon, pokemon)");
+		p_file->store_line("\t\t\t\tbattle_ui.update_player_pokemon(pokemon)");
+		p_file->store_line("\t\t\telse:");
+		p_file->store_line("\t\t\t\tcurrent_enemy_pokemon = pokemon");
+		p_file->store_line("\t\t\t\tbattle_ui.setup_battle(current_player_pokemon, current_enemy_pokemon)");
+		p_file->store_line("");
 		p_file->store_line("func _next_turn():");
 		p_file->store_line("\tif current_state == BattleState.ENDED:");
 		p_file->store_line("\t\treturn");
@@ -170,21 +298,8 @@ void PokemonBattleSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tif _check_battle_end():");
 		p_file->store_line("\t\treturn");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Process enemy turn if it's their turn");
-		p_file->store_line("\tif current_state == BattleState.PLAYER_TURN:");
-		p_file->store_line("\t\t_process_enemy_turn()");
-		p_file->store_line("\telse:");
-		p_file->store_line("\t\t_start_turn()");
-		p_file->store_line("");
-		p_file->store_line("func _process_enemy_turn():");
-		p_file->store_line("\tcurrent_state = BattleState.ENEMY_TURN");
-		p_file->store_line("\tturn_started.emit(current_enemy_pokemon)");
-		p_file->store_line("\t");
-		p_file->store_line("\t# AI chooses move");
-		p_file->store_line("\tvar chosen_move = battle_ai.choose_move(current_enemy_pokemon, current_player_pokemon)");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Use the move");
-		p_file->store_line("\tuse_move(current_enemy_pokemon, current_player_pokemon, chosen_move)");
+		p_file->store_line("\t# Both sides have acted; the simulator already ran the enemy's move");
+		p_file->store_line("\t_start_turn()");
 		p_file->store_line("");
 		p_file->store_line("func _check_battle_end() -> bool:");
 		p_file->store_line("\t# Check if all player Pokemon are fainted");
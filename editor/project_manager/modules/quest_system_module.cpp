@@ -22,6 +22,16 @@ void QuestSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("var active_quests: Dictionary = {}");
 		p_file->store_line("var completed_quests: Array[String] = []");
 		p_file->store_line("var failed_quests: Array[String] = []");
+		p_file->store_line("var runtime := QuestRuntime.new()");
+		p_file->store_line("");
+		p_file->store_line("# Gameplay events and the objective types they progress");
+		p_file->store_line("const EVENT_OBJECTIVE_TYPES = {");
+		p_file->store_line("\t\"enemy_killed\": QuestRuntime.OBJECTIVE_KILL,");
+		p_file->store_line("\t\"item_collected\": QuestRuntime.OBJECTIVE_COLLECT,");
+		p_file->store_line("\t\"npc_talked\": QuestRuntime.OBJECTIVE_INTERACT,");
+		p_file->store_line("\t\"location_reached\": QuestRuntime.OBJECTIVE_REACH_LOCATION,");
+		p_file->store_line("\t\"escort_progress\": QuestRuntime.OBJECTIVE_ESCORT");
+		p_file->store_line("}");
 		p_file->store_line("");
 		p_file->store_line("# Tracking");
 		p_file->store_line("var tracked_quest: String = \"\"");
@@ -30,6 +40,10 @@ void QuestSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("");
 		p_file->store_line("func _ready():");
 		p_file->store_line("\t_load_quest_database()");
+		p_file->store_line("\truntime.load_quests(quest_database)");
+		p_file->store_line("\truntime.objective_progressed.connect(_on_objective_progressed)");
+		p_file->store_line("\truntime.objective_completed.connect(_on_objective_completed)");
+		p_file->store_line("\truntime.quest_completed.connect(_on_quest_completed)");
 		p_file->store_line("\t_setup_ui()");
 		p_file->store_line("");
 		p_file->store_line("func start_quest(quest_id: String) -> bool:");
@@ -37,8 +51,8 @@ void QuestSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\tprint(\"Quest not found: \", quest_id)");
 		p_file->store_line("\t\treturn false");
 		p_file->store_line("\t");
-		p_file->store_line("\tif active_quests.has(quest_id) or is_quest_completed(quest_id):");
-		p_file->store_line("\t\tprint(\"Quest already active or completed: \", quest_id)");
+		p_file->store_line("\tif not runtime.can_start_quest(quest_id):");
+		p_file->store_line("\t\tprint(\"Quest already active, completed or locked: \", quest_id)");
 		p_file->store_line("\t\treturn false");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Create quest instance");
@@ -52,6 +66,7 @@ void QuestSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\tobjective.completed = false");
 		p_file->store_line("\t");
 		p_file->store_line("\tactive_quests[quest_id] = quest_data");
+		p_file->store_line("\truntime.start_quest(quest_id)");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Auto-track if no quest is currently tracked");
 		p_file->store_line("\tif tracked_quest == \"\":");
@@ -65,7 +80,14 @@ void QuestSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t");
 		p_file->store_line("\treturn true");
 		p_file->store_line("");
+		p_file->store_line("func unlock_quest(quest_id: String):");
+		p_file->store_line("\truntime.unlock_quest(quest_id)");
+		p_file->store_line("");
 		p_file->store_line("func complete_quest(quest_id: String):");
+		p_file->store_line("\t# Completes the quest regardless of its objectives");
+		p_file->store_line("\truntime.complete_quest(quest_id)");
+		p_file->store_line("");
+		p_file->store_line("func _on_quest_completed(quest_id: String):");
 		p_file->store_line("\tif not active_quests.has(quest_id):");
 		p_file->store_line("\t\treturn");
 		p_file->store_line("\t");
@@ -91,54 +113,32 @@ void QuestSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\tPopupManager.show_quest_notification(\"Quest Complete!\", quest.title)");
 		p_file->store_line("");
 		p_file->store_line("func update_objective_progress(quest_id: String, objective_type: String, target_id: String = \"\", amount: int = 1):");
-		p_file->store_line("\tif not active_quests.has(quest_id):");
+		p_file->store_line("\t# Only objectives waiting for this event are visited; an empty quest_id updates all active quests");
+		p_file->store_line("\tif not EVENT_OBJECTIVE_TYPES.has(objective_type):");
 		p_file->store_line("\t\treturn");
 		p_file->store_line("\t");
-		p_file->store_line("\tvar quest = active_quests[quest_id]");
-		p_file->store_line("\tvar quest_updated = false");
-		p_file->store_line("\t");
-		p_file->store_line("\tfor objective in quest.objectives:");
-		p_file->store_line("\t\tif objective.completed:");
-		p_file->store_line("\t\t\tcontinue");
-		p_file->store_line("\t\t");
-		p_file->store_line("\t\tvar matches = false");
-		p_file->store_line("\t\tmatch objective.type:");
-		p_file->store_line("\t\t\t\"kill\":");
-		p_file->store_line("\t\t\t\tmatches = objective_type == \"enemy_killed\" and (target_id == \"\" or objective.target == target_id)");
-		p_file->store_line("\t\t\t\"collect\":");
-		p_file->store_line("\t\t\t\tmatches = objective_type == \"item_collected\" and objective.target == target_id");
-		p_file->store_line("\t\t\t\"interact\":");
-		p_file->store_line("\t\t\t\tmatches = objective_type == \"npc_talked\" and objective.target == target_id");
-		p_file->store_line("\t\t\t\"reach\":");
-		p_file->store_line("\t\t\t\tmatches = objective_type == \"location_reached\" and objective.target == target_id");
-		p_file->store_line("\t\t\t\"escort\":");
-		p_file->store_line("\t\t\t\tmatches = objective_type == \"escort_progress\" and objective.target == target_id");
-		p_file->store_line("\t\t");
-		p_file->store_line("\t\tif matches:");
-		p_file->store_line("\t\t\tobjective.current_progress = min(objective.current_progress + amount, objective.target_amount)");
-		p_file->store_line("\t\t\tquest_updated = true");
-		p_file->store_line("\t\t\t");
-		p_file->store_line("\t\t\tquest_progress_updated.emit(quest_id, objective.id, objective.current_progress, objective.target_amount)");
-		p_file->store_line("\t\t\t");
-		p_file->store_line("\t\t\tif objective.current_progress >= objective.target_amount:");
-		p_file->store_line("\t\t\t\tobjective.completed = true");
-		p_file->store_line("\t\t\t\tobjective_completed.emit(quest_id, objective.id)");
-		p_file->store_line("\t");
-		p_file->store_line("\tif quest_updated:");
-		p_file->store_line("\t\t_check_quest_completion(quest_id)");
+		p_file->store_line("\tif runtime.post_event(EVENT_OBJECTIVE_TYPES[objective_type], target_id, amount, quest_id) > 0:");
 		p_file->store_line("\t\t_update_quest_tracker()");
 		p_file->store_line("");
-		p_file->store_line("func _check_quest_completion(quest_id: String):");
-		p_file->store_line("\tvar quest = active_quests[quest_id]");
-		p_file->store_line("\tvar all_completed = true");
+		p_file->store_line("func _find_objective(quest_id: String, objective_id: String) -> Dictionary:");
+		p_file->store_line("\tfor objective in active_quests[quest_id].objectives:");
+		p_file->store_line("\t\tif objective.id == objective_id:");
+		p_file->store_line("\t\t\treturn objective");
+		p_file->store_line("\treturn {}");
+		p_file->store_line("");
+		p_file->store_line("func _on_objective_progressed(quest_id: String, objective_id: String, progress: int, target: int):");
+		p_file->store_line("\tif not active_quests.has(quest_id):");
+		p_file->store_line("\t\treturn");
 		p_file->store_line("\t");
-		p_file->store_line("\tfor objective in quest.objectives:");
-		p_file->store_line("\t\tif not objective.completed:");
-		p_file->store_line("\t\t\tall_completed = false");
-		p_file->store_line("\t\t\tbreak");
+		p_file->store_line("\t_find_objective(quest_id, objective_id).current_progress = progress");
+		p_file->store_line("\tquest_progress_updated.emit(quest_id, objective_id, progress, target)");
+		p_file->store_line("");
+		p_file->store_line("func _on_objective_completed(quest_id: String, objective_id: String):");
+		p_file->store_line("\tif not active_quests.has(quest_id):");
+		p_file->store_line("\t\treturn");
 		p_file->store_line("\t");
-		p_file->store_line("\tif all_completed:");
-		p_file->store_line("\t\tcomplete_quest(quest_id)");
+		p_file->store_line("\t_find_objective(quest_id, objective_id).completed = true");
+		p_file->store_line("\tobjective_completed.emit(quest_id, objective_id)");
 		p_file->store_line("");
 		p_file->store_line("func track_quest(quest_id: String):");
 		p_file->store_line("\tif active_quests.has(quest_id):");
@@ -153,7 +153,7 @@ void QuestSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\treturn active_quests.has(quest_id)");
 		p_file->store_line("");
 		p_file->store_line("func is_quest_completed(quest_id: String) -> bool:");
-		p_file->store_line("\treturn completed_quests.has(quest_id)");
+		p_file->store_line("\treturn runtime.get_quest_status(quest_id) == QuestRuntime.STATUS_COMPLETED");
 		p_file->store_line("");
 		p_file->store_line("func get_quest_data(quest_id: String) -> Dictionary:");
 		p_file->store_line("\tif active_quests.has(quest_id):");
@@ -166,13 +166,13 @@ void QuestSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\t\tmatch reward.type:");
 		p_file->store_line("\t\t\t\t\"experience\":");
 		p_file->store_line("\t\t\t\t\tif PlayerStats:");
-		p_file->store_line("\t\t\t\t\t\tPlayerStats.add_experience(reward.amount)");
+		p_file->store_line("\t\t\t\t\t\tPlayerStats.add_experience(reward.get(\"amount\", reward.get(\"quantity\", 0)))");
 		p_file->store_line("\t\t\t\t\"item\":");
 		p_file->store_line("\t\t\t\t\tif InventorySystem:");
-		p_file->store_line("\t\t\t\t\t\tInventorySystem.add_item(reward.item_id, reward.amount)");
+		p_file->store_line("\t\t\t\t\t\tInventorySystem.add_item(reward.item_id, reward.get(\"amount\", reward.get(\"quantity\", 1)))");
 		p_file->store_line("\t\t\t\t\"gold\":");
 		p_file->store_line("\t\t\t\t\tif PlayerStats:");
-		p_file->store_line("\t\t\t\t\t\tPlayerStats.add_gold(reward.amount)");
+		p_file->store_line("\t\t\t\t\t\tPlayerStats.add_gold(reward.get(\"amount\", reward.get(\"quantity\", 0)))");
 		p_file->store_line("");
 		p_file->store_line("func _auto_track_next_quest():");
 		p_file->store_line("\tif active_quests.size() > 0:");
@@ -201,7 +201,7 @@ void QuestSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\t\tquest_tracker_ui.update_display({})");
 		p_file->store_line("");
 		p_file->store_line("func _load_quest_database():");
-		p_file->store_line("\t# Load quest data from JSON");
+		p_file->store_line("\t# Load quest data from JSON, as exported by the quest designer");
 		p_file->store_line("\tvar file_path = \"res://data/quests.json\"");
 		p_file->store_line("\tvar file = FileAccess.open(file_path, FileAccess.READ)");
 		p_file->store_line("\tif file:");
@@ -20,15 +20,10 @@ void RelationshipSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("");
 		p_file->store_line("# Relationship data");
 		p_file->store_line("var characters: Dictionary = {}  # character_id -> Character");
-		p_file->store_line("var relationships: Dictionary = {}  # \"char1_char2\" -> Relationship");
+		p_file->store_line("var graph := RelationshipGraph.new()  # Friendship points between pairs of characters");
 		p_file->store_line("var factions: Dictionary = {}  # faction_id -> FactionReputation");
 		p_file->store_line("var support_conversations: Dictionary = {}  # \"char1_char2_rank\" -> SupportConversation");
 		p_file->store_line("");
-		p_file->store_line("# Interaction tracking");
-		p_file->store_line("var daily_interactions: Dictionary = {}  # character_id -> count");
-		p_file->store_line("var last_interaction_date: Dictionary = {}  # character_id -> date");
-		p_file->store_line("var interaction_cooldowns: Dictionary = {}  # character_id -> cooldown_time");
-		p_file->store_line("");
 		p_file->store_line("# System settings");
 		p_file->store_line("@export var max_daily_interactions: int = 3");
 		p_file->store_line("@export var friendship_decay_enabled: bool = true");
@@ -48,7 +43,28 @@ void RelationshipSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tMARRIED = 1500");
 		p_file->store_line("}");
 		p_file->store_line("");
+		p_file->store_line("# Relationship levels in increasing order, indexed by RelationshipGraph levels");
+		p_file->store_line("const LEVELS = [");
+		p_file->store_line("\tRelationshipLevel.STRANGER,");
+		p_file->store_line("\tRelationshipLevel.ACQUAINTANCE,");
+		p_file->store_line("\tRelationshipLevel.FRIEND,");
+		p_file->store_line("\tRelationshipLevel.CLOSE_FRIEND,");
+		p_file->store_line("\tRelationshipLevel.BEST_FRIEND,");
+		p_file->store_line("\tRelationshipLevel.ROMANCE_INTEREST,");
+		p_file->store_line("\tRelationshipLevel.ROMANCE_PARTNER,");
+		p_file->store_line("\tRelationshipLevel.MARRIED");
+		p_file->store_line("]");
+		p_file->store_line("");
 		p_file->store_line("func _ready():");
+		p_file->store_line("\t# Interaction limits, cooldowns and decay are handled by the graph");
+		p_file->store_line("\tgraph.level_thresholds = PackedInt32Array(LEVELS)");
+		p_file->store_line("\tgraph.max_daily_interactions = max_daily_interactions");
+		p_file->store_line("\tgraph.interaction_cooldown = 300.0");
+		p_file->store_line("\tgraph.decay_rate = friendship_decay_rate if friendship_decay_enabled else 0.0");
+		p_file->store_line("\tgraph.decay_grace_days = 7");
+		p_file->store_line("\tgraph.add_character(\"player\")");
+		p_file->store_line("\tgraph.level_changed.connect(_on_level_changed)");
+		p_file->store_line("\t");
 		p_file->store_line("\t# Load relationship data");
 		p_file->store_line("\tload_characters_data()");
 		p_file->store_line("\tload_factions_data()");
@@ -77,56 +93,49 @@ void RelationshipSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\tvar character = Character.new()");
 		p_file->store_line("\t\tcharacter.initialize_from_data(char_data)");
 		p_file->store_line("\t\tcharacters[character.character_id] = character");
+		p_file->store_line("\t\tgraph.add_character(character.character_id)");
 		p_file->store_line("");
 		p_file->store_line("func get_character(character_id: String) -> Character:");
 		p_file->store_line("\treturn characters.get(character_id, null)");
 		p_file->store_line("");
-		p_file->store_line("func get_relationship(char1_id: String, char2_id: String) -> Relationship:");
-		p_file->store_line("\tvar key = _get_relationship_key(char1_id, char2_id)");
-		p_file->store_line("\tif not relationships.has(key):");
-		p_file->store_line("\t\t# Create new relationship");
-		p_file->store_line("\t\tvar relationship = Relationship.new()");
-		p_file->store_line("\t\trelationship.character1_id = char1_id");
-		p_file->store_line("\t\trelationship.character2_id = char2_id");
-		p_file->store_line("\t\trelationships[key] = relationship");
-		p_file->store_line("\treturn relationships[key]");
-		p_file->store_line("");
-		p_file->store_line("func _get_relationship_key(char1_id: String, char2_id: String) -> String:");
-		p_file->store_line("\t# Always use alphabetical order for consistency");
-		p_file->store_line("\tif char1_id < char2_id:");
-		p_file->store_line("\t\treturn char1_id + \"_\" + char2_id");
-		p_file->store_line("\telse:");
-		p_file->store_line("\t\treturn char2_id + \"_\" + char1_id");
+		p_file->store_line("func get_friendship_points(char1_id: String, char2_id: String) -> int:");
+		p_file->store_line("\treturn graph.get_points(char1_id, char2_id)");
+		p_file->store_line("");
+		p_file->store_line("func get_closest_characters(character_id: String, count: int = 5) -> PackedStringArray:");
+		p_file->store_line("\treturn graph.get_top_relationships(character_id, count)");
 		p_file->store_line("");
 		p_file->store_line("func increase_relationship(character_id: String, points: int, interaction_type: String = \"\"):");
-		p_file->store_line("\t# Check daily interaction limits");
-		p_file->store_line("\tif not can_interact_with_character(character_id):");
-		p_file->store_line("\t\treturn");
-		p_file->store_line("\t");
 		p_file->store_line("\tvar player_id = \"player\"");
-		p_file->store_line("\tvar relationship = get_relationship(player_id, character_id)");
-		p_file->store_line("\tvar old_level = get_relationship_level(relationship.friendship_points)");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Apply character-specific modifiers");
 		p_file->store_line("\tvar character = get_character(character_id)");
 		p_file->store_line("\tif character:");
 		p_file->store_line("\t\tpoints = character.apply_interaction_modifier(points, interaction_type)");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Add points");
-		p_file->store_line("\trelationship.friendship_points += points");
-		p_file->store_line("\trelationship.friendship_points = max(0, relationship.friendship_points)");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Track interaction");
-		p_file->store_line("\t_track_interaction(character_id, interaction_type)");
+		p_file->store_line("\t# Checks the daily interaction limit and cooldown, and reports level changes through _on_level_changed()");
+		p_file->store_line("\tif not graph.interact(player_id, character_id, points):");
+		p_file->store_line("\t\treturn");
 		p_file->store_line("\t");
-		p_file->store_line("\t# Check for level changes");
-		p_file->store_line("\tvar new_level = get_relationship_level(relationship.friendship_points)");
-		p_file->store_line("\tif new_level != old_level:");
+		p_file->store_line("\tcharacter_interaction.emit(character_id, interaction_type)");
+		p_file->store_line("");
+		p_file->store_line("func _on_level_changed(char1_id: String, char2_id: String, old_index: int, new_index: int):");
+		p_file->store_line("\tvar old_level = LEVELS[max(old_index, 0)]");
+		p_file->store_line("\tvar new_level = LEVELS[max(new_index, 0)]");
+		p_file->store_line("\tvar character_id = char2_id if char1_id == \"player\" else char1_id");
+		p_file->store_line("\tif char1_id == \"player\" or char2_id == \"player\":");
 		p_file->store_line("\t\trelationship_changed.emit(character_id, old_level, new_level)");
-		p_file->store_line("\t\t_check_support_conversation_unlock(player_id, character_id)");
-		p_file->store_line("\t\t_check_relationship_milestones(character_id, new_level)");
+		p_file->store_line("\t\tif new_level > old_level:");
+		p_file->store_line("\t\t\t_check_relationship_milestones(character_id, new_level)");
 		p_file->store_line("\t");
-		p_file->store_line("\tcharacter_interaction.emit(character_id, interaction_type)");
+		p_file->store_line("\tif new_level > old_level:");
+		p_file->store_line("\t\tsupport_conversation_unlocked.emit(char1_id, char2_id, RelationshipLevel.find_key(new_level))");
+		p_file->store_line("");
+		p_file->store_line("func _check_relationship_milestones(character_id: String, level: int):");
+		p_file->store_line("\tif level >= RelationshipLevel.ROMANCE_INTEREST:");
+		p_file->store_line("\t\tif romance_enabled:");
+		p_file->store_line("\t\t\tromance_milestone.emit(character_id, RelationshipLevel.find_key(level))");
+		p_file->store_line("\telse:");
+		p_file->store_line("\t\tfriendship_milestone.emit(character_id, RelationshipLevel.find_key(level))");
 		p_file->store_line("");
 		p_file->store_line("func get_relationship_level(points: int) -> int:");
 		p_file->store_line("\tif points >= RelationshipLevel.MARRIED:");
@@ -147,50 +156,18 @@ void RelationshipSystemModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\treturn RelationshipLevel.STRANGER");
 		p_file->store_line("");
 		p_file->store_line("func can_interact_with_character(character_id: String) -> bool:");
-		p_file->store_line("\t# Check daily interaction limit");
-		p_file->store_line("\tvar today_interactions = daily_interactions.get(character_id, 0)");
-		p_file->store_line("\tif today_interactions >= max_daily_interactions:");
-		p_file->store_line("\t\treturn false");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Check cooldown");
-		p_file->store_line("\tif interaction_cooldowns.has(character_id):");
-		p_file->store_line("\t\tvar cooldown_end = interaction_cooldowns[character_id]");
-		p_file->store_line("\t\tif Time.get_ticks_msec() < cooldown_end:");
-		p_file->store_line("\t\t\treturn false");
-		p_file->store_line("\t");
-		p_file->store_line("\treturn true");
-		p_file->store_line("");
-		p_file->store_line("func _track_interaction(character_id: String, interaction_type: String):");
-		p_file->store_line("\t# Update daily interaction count");
-		p_file->store_line("\tdaily_interactions[character_id] = daily_interactions.get(character_id, 0) + 1");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Set interaction cooldown (5 minutes)");
-		p_file->store_line("\tinteraction_cooldowns[character_id] = Time.get_ticks_msec() + 300000");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Update last interaction date");
-		p_file->store_line("\tif GameTime:");
-		p_file->store_line("\t\tlast_interaction_date[character_id] = GameTime.get_current_date()");
+		p_file->store_line("\treturn graph.can_interact(\"player\", character_id)");
 		p_file->store_line("");
 		p_file->store_line("func _on_day_changed():");
-		p_file->store_line("\t# Reset daily interactions");
-		p_file->store_line("\tdaily_interactions.clear()");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Apply friendship decay");
-		p_file->store_line("\tif friendship_decay_enabled:");
-		p_file->store_line("\t\t_apply_friendship_decay()");
-		p_file->store_line("");
-		p_file->store_line("func _apply_friendship_decay():");
-		p_file->store_line("\tfor character_id in characters.keys():");
-		p_file->store_line("\t\tif character_id == \"player\":");
-		p_file->store_line("\t\t\tcontinue");
-		p_file->store_line("\t\t");
-		p_file->store_line("\t\t# Check if player interacted recently");
-		p_file->store_line("\t\tvar last_date = last_interaction_date.get(character_id, null)");
-		p_file->store_line("\t\tif last_date and GameTime:");
-		p_file->store_line("\t\t\tvar days_since = GameTime.get_days_since(last_date)");
-		p_file->store_line("\t\t\tif days_since > 7:  # No interaction for a week");
-		p_file->store_line("\t\t\t\tvar decay_amount = int(friendship_decay_rate * days_since)");
-		p_file->store_line("\t\t\t\tincrease_relationship(character_id, -decay_amount, \"decay\")");
+		p_file->store_line("\t# Resets daily interactions and applies friendship decay to all pairs at once");
+		p_file->store_line("\tgraph.advance_day()");
+		p_file->store_line("");
+		p_file->store_line("func get_relationship_data() -> Dictionary:");
+		p_file->store_line("\treturn graph.get_state()");
+		p_file->store_line("");
+		p_file->store_line("func load_relationship_data(data: Dictionary):");
+		p_file->store_line("\tgraph.set_state(data)");
+		p_file->store_line("\tgraph.add_character(\"player\")");
 		p_file->store_line("");
 		p_file->store_line("func get_faction_reputation(faction_id: String) -> int:");
 		p_file->store_line("\tif factions.has(faction_id):");
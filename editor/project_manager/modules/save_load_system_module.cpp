@@ -21,8 +21,9 @@ void SaveLoadSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("const SAVE_FILE_EXTENSION = \".vnsave\"");
 	p_file->store_line("const SAVE_DIRECTORY = \"user://saves/\"");
 	p_file->store_line("");
-	p_file->store_line("# Current game state");
-	p_file->store_line("var current_save_data = {}");
+	p_file->store_line("# Current game state, split into sections so a save only re-encodes what changed");
+	p_file->store_line("var save_state := SaveGameState.new()");
+	p_file->store_line("var pending_save = {}");
 	p_file->store_line("var auto_save_enabled = true");
 	p_file->store_line("var auto_save_interval = 300.0  # 5 minutes");
 	p_file->store_line("var auto_save_timer = 0.0");
@@ -33,6 +34,9 @@ void SaveLoadSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\tif not dir.dir_exists(\"saves\"):");
 	p_file->store_line("\t\tdir.make_dir(\"saves\")");
 	p_file->store_line("\t");
+	p_file->store_line("\t# Saves are written in the background and reported back here");
+	p_file->store_line("\tsave_state.save_completed.connect(_on_save_completed)");
+	p_file->store_line("\t");
 	p_file->store_line("\t# Connect to other systems for state tracking");
 	p_file->store_line("\tif VNScriptParser:");
 	p_file->store_line("\t\tVNScriptParser.dialogue_started.connect(_on_dialogue_started)");
@@ -57,68 +61,97 @@ void SaveLoadSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t\t\tauto_save()");
 	p_file->store_line("\t\t\tauto_save_timer = 0.0");
 	p_file->store_line("");
+	p_file->store_line("func _exit_tree():");
+	p_file->store_line("\t# Don't lose a save that is still being written");
+	p_file->store_line("\tsave_state.wait_for_save()");
+	p_file->store_line("");
 	p_file->store_line("# Track game state changes");
 	p_file->store_line("func _on_dialogue_started(character: String, text: String):");
-	p_file->store_line("\tcurrent_save_data[\"current_dialogue\"] = {");
+	p_file->store_line("\tsave_state.set_section(\"current_dialogue\", {");
 	p_file->store_line("\t\t\"character\": character,");
 	p_file->store_line("\t\t\"text\": text,");
 	p_file->store_line("\t\t\"timestamp\": Time.get_unix_time_from_system()");
-	p_file->store_line("\t}");
+	p_file->store_line("\t})");
 	p_file->store_line("");
 	p_file->store_line("func _on_variable_changed(var_name: String, value):");
-	p_file->store_line("\tif not current_save_data.has(\"variables\"):");
-	p_file->store_line("\t\tcurrent_save_data[\"variables\"] = {}");
-	p_file->store_line("\tcurrent_save_data[\"variables\"][var_name] = value");
+	p_file->store_line("\tvar variables = save_state.get_section(\"variables\")");
+	p_file->store_line("\tif variables == null:");
+	p_file->store_line("\t\tvariables = {}");
+	p_file->store_line("\t\tsave_state.set_section(\"variables\", variables)");
+	p_file->store_line("\tvariables[var_name] = value");
+	p_file->store_line("\tsave_state.mark_dirty(\"variables\")");
 	p_file->store_line("");
 	p_file->store_line("func _on_portrait_changed(position: String, character: String, emotion: String):");
-	p_file->store_line("\tif not current_save_data.has(\"portraits\"):");
-	p_file->store_line("\t\tcurrent_save_data[\"portraits\"] = {}");
-	p_file->store_line("\tcurrent_save_data[\"portraits\"][position] = {");
+	p_file->store_line("\tvar portraits = save_state.get_section(\"portraits\")");
+	p_file->store_line("\tif portraits == null:");
+	p_file->store_line("\t\tportraits = {}");
+	p_file->store_line("\t\tsave_state.set_section(\"portraits\", portraits)");
+	p_file->store_line("\tportraits[position] = {");
 	p_file->store_line("\t\t\"character\": character,");
 	p_file->store_line("\t\t\"emotion\": emotion");
 	p_file->store_line("\t}");
+	p_file->store_line("\tsave_state.mark_dirty(\"portraits\")");
 	p_file->store_line("");
 	p_file->store_line("func _on_background_changed(background_name: String):");
-	p_file->store_line("\tcurrent_save_data[\"background\"] = background_name");
+	p_file->store_line("\tsave_state.set_section(\"background\", background_name)");
 	p_file->store_line("");
 	p_file->store_line("func _on_music_started(track_name: String):");
-	p_file->store_line("\tcurrent_save_data[\"music\"] = track_name");
+	p_file->store_line("\tsave_state.set_section(\"music\", track_name)");
 	p_file->store_line("");
 	p_file->store_line("# Save game to specific slot");
+	p_file->store_line("# The file is written on a worker thread; game_saved or save_failed is emitted when it's done");
 	p_file->store_line("func save_game(slot: int, save_name: String = \"\") -> bool:");
 	p_file->store_line("\tif slot < AUTO_SAVE_SLOT or slot >= MAX_SAVE_SLOTS:");
 	p_file->store_line("\t\tprint(\"Invalid save slot: \", slot)");
 	p_file->store_line("\t\tsave_failed.emit(slot, \"Invalid save slot\")");
 	p_file->store_line("\t\treturn false");
 	p_file->store_line("\t");
-	p_file->store_line("\t# Prepare save data");
-	p_file->store_line("\tvar save_data = current_save_data.duplicate(true)");
-	p_file->store_line("\tsave_data[\"save_name\"] = save_name if not save_name.is_empty() else \"Save \" + str(slot)");
-	p_file->store_line("\tsave_data[\"save_time\"] = Time.get_datetime_string_from_system()");
-	p_file->store_line("\tsave_data[\"save_timestamp\"] = Time.get_unix_time_from_system()");
-	p_file->store_line("\tsave_data[\"game_version\"] = ProjectSettings.get_setting(\"application/config/version\", \"1.0\")");
+	p_file->store_line("\t# Only one save can be written at a time");
+	p_file->store_line("\tif save_state.is_saving():");
+	p_file->store_line("\t\tsave_state.wait_for_save()");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Get current script state");
 	p_file->store_line("\tif VNScriptParser:");
-	p_file->store_line("\t\tsave_data[\"script_state\"] = {");
+	p_file->store_line("\t\tsave_state.set_section(\"script_state\", {");
 	p_file->store_line("\t\t\t\"current_node\": VNScriptParser.current_node_id,");
 	p_file->store_line("\t\t\t\"variables\": VNScriptParser.script_variables.duplicate()");
-	p_file->store_line("\t\t}");
+	p_file->store_line("\t\t})");
+	p_file->store_line("\t");
+	p_file->store_line("\t# Slot information, readable without loading the whole save");
+	p_file->store_line("\tvar current_dialogue = save_state.get_section(\"current_dialogue\")");
+	p_file->store_line("\tsave_state.metadata = {");
+	p_file->store_line("\t\t\"save_name\": save_name if not save_name.is_empty() else \"Save \" + str(slot),");
+	p_file->store_line("\t\t\"save_time\": Time.get_datetime_string_from_system(),");
+	p_file->store_line("\t\t\"save_timestamp\": Time.get_unix_time_from_system(),");
+	p_file->store_line("\t\t\"game_version\": ProjectSettings.get_setting(\"application/config/version\", \"1.0\"),");
+	p_file->store_line("\t\t\"current_dialogue\": current_dialogue if current_dialogue != null else {}");
+	p_file->store_line("\t}");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Write save file");
 	p_file->store_line("\tvar file_path = get_save_file_path(slot)");
-	p_file->store_line("\tvar file = FileAccess.open(file_path, FileAccess.WRITE)");
-	p_file->store_line("\tif not file:");
+	p_file->store_line("\tvar error = save_state.save_async(file_path)");
+	p_file->store_line("\tif error != OK:");
 	p_file->store_line("\t\tprint(\"Failed to create save file: \", file_path)");
 	p_file->store_line("\t\tsave_failed.emit(slot, \"Failed to create save file\")");
 	p_file->store_line("\t\treturn false");
 	p_file->store_line("\t");
-	p_file->store_line("\tfile.store_string(JSON.stringify(save_data))");
-	p_file->store_line("\tfile.close()");
+	p_file->store_line("\tpending_save = {\"slot\": slot, \"save_name\": save_name}");
+	p_file->store_line("\treturn true");
+	p_file->store_line("");
+	p_file->store_line("func _on_save_completed(path: String, error: int):");
+	p_file->store_line("\tvar slot = pending_save.get(\"slot\", AUTO_SAVE_SLOT)");
+	p_file->store_line("\tvar save_name = pending_save.get(\"save_name\", \"\")");
+	p_file->store_line("\tpending_save = {}");
+	p_file->store_line("\t");
+	p_file->store_line("\tif error != OK:");
+	p_file->store_line("\t\tprint(\"Failed to write save file: \", path, \" (\", error_string(error), \")\")");
+	p_file->store_line("\t\tsave_failed.emit(slot, \"Failed to write save file\")");
+	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
 	p_file->store_line("\tprint(\"Game saved to slot \", slot, \": \", save_name)");
 	p_file->store_line("\tgame_saved.emit(slot, save_name)");
-	p_file->store_line("\treturn true");
+	p_file->store_line("\tif slot == AUTO_SAVE_SLOT:");
+	p_file->store_line("\t\tauto_save_completed.emit()");
 	p_file->store_line("");
 	p_file->store_line("# Load game from specific slot");
 	p_file->store_line("func load_game(slot: int) -> bool:");
@@ -133,49 +166,45 @@ void SaveLoadSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t\tload_failed.emit(slot, \"Save file not found\")");
 	p_file->store_line("\t\treturn false");
 	p_file->store_line("\t");
-	p_file->store_line("\t# Read save file");
-	p_file->store_line("\tvar file = FileAccess.open(file_path, FileAccess.READ)");
-	p_file->store_line("\tif not file:");
-	p_file->store_line("\t\tprint(\"Failed to open save file: \", file_path)");
-	p_file->store_line("\t\tload_failed.emit(slot, \"Failed to open save file\")");
-	p_file->store_line("\t\treturn false");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar json_string = file.get_as_text()");
-	p_file->store_line("\tfile.close()");
+	p_file->store_line("\t# Finish any save in progress, it may be writing this very slot");
+	p_file->store_line("\tif save_state.is_saving():");
+	p_file->store_line("\t\tsave_state.wait_for_save()");
 	p_file->store_line("\t");
-	p_file->store_line("\t# Parse save data");
-	p_file->store_line("\tvar json = JSON.new()");
-	p_file->store_line("\tvar parse_result = json.parse(json_string)");
-	p_file->store_line("\tif parse_result != OK:");
+	p_file->store_line("\t# Read save file");
+	p_file->store_line("\tvar error = save_state.load(file_path)");
+	p_file->store_line("\tif error == ERR_FILE_CORRUPT or error == ERR_FILE_UNRECOGNIZED:");
 	p_file->store_line("\t\tprint(\"Failed to parse save file: \", file_path)");
 	p_file->store_line("\t\tload_failed.emit(slot, \"Corrupted save file\")");
 	p_file->store_line("\t\treturn false");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar save_data = json.data");
+	p_file->store_line("\telif error != OK:");
+	p_file->store_line("\t\tprint(\"Failed to open save file: \", file_path)");
+	p_file->store_line("\t\tload_failed.emit(slot, \"Failed to open save file\")");
+	p_file->store_line("\t\treturn false");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Restore game state");
-	p_file->store_line("\trestore_game_state(save_data)");
+	p_file->store_line("\trestore_game_state()");
 	p_file->store_line("\t");
-	p_file->store_line("\tvar save_name = save_data.get(\"save_name\", \"Unknown\")");
+	p_file->store_line("\tvar save_name = save_state.metadata.get(\"save_name\", \"Unknown\")");
 	p_file->store_line("\tprint(\"Game loaded from slot \", slot, \": \", save_name)");
 	p_file->store_line("\tgame_loaded.emit(slot, save_name)");
 	p_file->store_line("\treturn true");
 	p_file->store_line("");
-	p_file->store_line("# Restore game state from save data");
-	p_file->store_line("func restore_game_state(save_data: Dictionary):");
+	p_file->store_line("# Restore game state from the loaded save sections");
+	p_file->store_line("func restore_game_state():");
 	p_file->store_line("\t# Restore script state");
-	p_file->store_line("\tif save_data.has(\"script_state\") and VNScriptParser:");
-	p_file->store_line("\t\tvar script_state = save_data[\"script_state\"]");
+	p_file->store_line("\tvar script_state = save_state.get_section(\"script_state\")");
+	p_file->store_line("\tif script_state != null and VNScriptParser:");
 	p_file->store_line("\t\tVNScriptParser.current_node_id = script_state.get(\"current_node\", \"\")");
-	p_file->store_line("\t\tVNScriptParser.script_variables = script_state.get(\"variables\", {})");
+	p_file->store_line("\t\tVNScriptParser.script_variables = script_state.get(\"variables\", {}).duplicate()");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Restore background");
-	p_file->store_line("\tif save_data.has(\"background\") and BackgroundManager:");
-	p_file->store_line("\t\tBackgroundManager.set_background(save_data[\"background\"], \"none\")");
+	p_file->store_line("\tvar background = save_state.get_section(\"background\")");
+	p_file->store_line("\tif background != null and BackgroundManager:");
+	p_file->store_line("\t\tBackgroundManager.set_background(background, \"none\")");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Restore portraits");
-	p_file->store_line("\tif save_data.has(\"portraits\") and CharacterPortraitSystem:");
-	p_file->store_line("\t\tvar portraits = save_data[\"portraits\"]");
+	p_file->store_line("\tvar portraits = save_state.get_section(\"portraits\")");
+	p_file->store_line("\tif portraits != null and CharacterPortraitSystem:");
 	p_file->store_line("\t\tfor position in portraits.keys():");
 	p_file->store_line("\t\t\tvar portrait_data = portraits[position]");
 	p_file->store_line("\t\t\tvar character_emotion = portrait_data[\"character\"]");
@@ -184,16 +213,13 @@ void SaveLoadSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t\t\tCharacterPortraitSystem.set_portrait(position, character_emotion)");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Restore music");
-	p_file->store_line("\tif save_data.has(\"music\") and AudioManager:");
-	p_file->store_line("\t\tAudioManager.play_music(save_data[\"music\"])");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Update current save data");
-	p_file->store_line("\tcurrent_save_data = save_data.duplicate(true)");
+	p_file->store_line("\tvar music = save_state.get_section(\"music\")");
+	p_file->store_line("\tif music != null and AudioManager:");
+	p_file->store_line("\t\tAudioManager.play_music(music)");
 	p_file->store_line("");
 	p_file->store_line("# Auto-save functionality");
 	p_file->store_line("func auto_save():");
-	p_file->store_line("\tif save_game(AUTO_SAVE_SLOT, \"Auto Save\"):");
-	p_file->store_line("\t\tauto_save_completed.emit()");
+	p_file->store_line("\tsave_game(AUTO_SAVE_SLOT, \"Auto Save\")");
 	p_file->store_line("");
 	p_file->store_line("# Quick save/load");
 	p_file->store_line("func quick_save() -> bool:");
@@ -216,18 +242,11 @@ void SaveLoadSystemModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\tif not FileAccess.file_exists(file_path):");
 	p_file->store_line("\t\treturn {}");
 	p_file->store_line("\t");
-	p_file->store_line("\tvar file = FileAccess.open(file_path, FileAccess.READ)");
-	p_file->store_line("\tif not file:");
-	p_file->store_line("\t\treturn {}");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar json_string = file.get_as_text()");
-	p_file->store_line("\tfile.close()");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar json = JSON.new()");
-	p_file->store_line("\tif json.parse(json_string) != OK:");
+	p_file->store_line("\t# Only the slot information at the start of the file is read");
+	p_file->store_line("\tvar save_data = SaveGameState.read_metadata(file_path)");
+	p_file->store_line("\tif save_data.is_empty():");
 	p_file->store_line("\t\treturn {}");
 	p_file->store_line("\t");
-	p_file->store_line("\tvar save_data = json.data");
 	p_file->store_line("\treturn {");
 	p_file->store_line("\t\t\"save_name\": save_data.get(\"save_name\", \"Unknown\"),");
 	p_file->store_line("\t\t\"save_time\": save_data.get(\"save_time\", \"\"),");
@@ -103,98 +103,37 @@ void ScreenEffectsModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("# ScreenOverlay.gd");
 		p_file->store_line("# Generated by Lupine Engine - Screen Overlay");
 		p_file->store_line("# Handles screen-wide visual effects and overlays");
+		p_file->store_line("# All effects are composited natively in one full-screen pass; only shader");
+		p_file->store_line("# uniforms change from frame to frame");
 		p_file->store_line("");
-		p_file->store_line("extends Control");
+		p_file->store_line("extends ScreenEffectsCompositor");
 		p_file->store_line("");
 		p_file->store_line("# Signals");
 		p_file->store_line("signal fade_completed()");
 		p_file->store_line("");
-		p_file->store_line("# Components");
-		p_file->store_line("@onready var color_overlay: ColorRect = $ColorOverlay");
-		p_file->store_line("@onready var flash_overlay: ColorRect = $FlashOverlay");
-		p_file->store_line("@onready var vignette_overlay: ColorRect = $VignetteOverlay");
-		p_file->store_line("");
-		p_file->store_line("# CRT filter shader");
-		p_file->store_line("var crt_shader: Shader");
-		p_file->store_line("var crt_material: ShaderMaterial");
-		p_file->store_line("");
 		p_file->store_line("func _ready():");
-		p_file->store_line("\t# Setup initial state");
-		p_file->store_line("\tcolor_overlay.color = Color.TRANSPARENT");
-		p_file->store_line("\tflash_overlay.color = Color.TRANSPARENT");
-		p_file->store_line("\tvignette_overlay.color = Color.TRANSPARENT");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Load CRT shader");
-		p_file->store_line("\t_setup_crt_shader()");
+		p_file->store_line("\tfade_finished.connect(fade_completed.emit)");
 		p_file->store_line("");
 		p_file->store_line("func flash_effect(color: Color, duration: float):");
-		p_file->store_line("\tflash_overlay.color = color");
-		p_file->store_line("\t");
-		p_file->store_line("\tvar tween = create_tween()");
-		p_file->store_line("\ttween.tween_property(flash_overlay, \"color:a\", 0.0, duration)");
+		p_file->store_line("\tflash(color, duration)");
 		p_file->store_line("");
 		p_file->store_line("func fade_to_color(color: Color, duration: float) -> Signal:");
-		p_file->store_line("\tcolor_overlay.color = Color(color.r, color.g, color.b, 0.0)");
-		p_file->store_line("\t");
-		p_file->store_line("\tvar tween = create_tween()");
-		p_file->store_line("\ttween.tween_property(color_overlay, \"color:a\", color.a if color.a > 0 else 1.0, duration)");
-		p_file->store_line("\ttween.tween_callback(fade_completed.emit)");
-		p_file->store_line("\t");
+		p_file->store_line("\tfade_to(color, duration)");
 		p_file->store_line("\treturn fade_completed");
 		p_file->store_line("");
 		p_file->store_line("func fade_from_color(color: Color, duration: float) -> Signal:");
-		p_file->store_line("\tcolor_overlay.color = color");
-		p_file->store_line("\t");
-		p_file->store_line("\tvar tween = create_tween()");
-		p_file->store_line("\ttween.tween_property(color_overlay, \"color:a\", 0.0, duration)");
-		p_file->store_line("\ttween.tween_callback(fade_completed.emit)");
-		p_file->store_line("\t");
+		p_file->store_line("\tfade_from(color, duration)");
 		p_file->store_line("\treturn fade_completed");
 		p_file->store_line("");
 		p_file->store_line("func vignette_effect(intensity: float, duration: float):");
-		p_file->store_line("\tvar vignette_color = Color.BLACK");
-		p_file->store_line("\tvignette_color.a = intensity");
-		p_file->store_line("\t");
-		p_file->store_line("\tvar tween = create_tween()");
-		p_file->store_line("\ttween.tween_property(vignette_overlay, \"color\", vignette_color, duration * 0.5)");
-		p_file->store_line("\ttween.tween_property(vignette_overlay, \"color\", Color.TRANSPARENT, duration * 0.5)");
+		p_file->store_line("\tpulse_vignette(intensity, duration)");
+		p_file->store_line("");
+		p_file->store_line("func chromatic_aberration(intensity: float, duration: float):");
+		p_file->store_line("\t# Intensity is the channel offset at the screen edges, in screen fractions");
+		p_file->store_line("\tpulse_chromatic_aberration(intensity, duration)");
 		p_file->store_line("");
 		p_file->store_line("func set_crt_filter(enable: bool):");
-		p_file->store_line("\tif enable and crt_material:");
-		p_file->store_line("\t\tmaterial = crt_material");
-		p_file->store_line("\telse:");
-		p_file->store_line("\t\tmaterial = null");
-		p_file->store_line("");
-		p_file->store_line("func _setup_crt_shader():");
-		p_file->store_line("\t# Create a simple CRT shader");
-		p_file->store_line("\tcrt_shader = Shader.new()");
-		p_file->store_line("\tcrt_shader.code = \"\"\"");
-		p_file->store_line("shader_type canvas_item;");
-		p_file->store_line("");
-		p_file->store_line("uniform float scanline_intensity : hint_range(0.0, 1.0) = 0.1;");
-		p_file->store_line("uniform float curvature : hint_range(0.0, 0.1) = 0.02;");
-		p_file->store_line("");
-		p_file->store_line("void fragment() {");
-		p_file->store_line("\tvec2 uv = SCREEN_UV;");
-		p_file->store_line("\t");
-		p_file->store_line("\t// Apply curvature");
-		p_file->store_line("\tuv = uv * 2.0 - 1.0;");
-		p_file->store_line("\tuv *= 1.0 + curvature * length(uv);");
-		p_file->store_line("\tuv = uv * 0.5 + 0.5;");
-		p_file->store_line("\t");
-		p_file->store_line("\t// Sample texture");
-		p_file->store_line("\tvec4 color = texture(SCREEN_TEXTURE, uv);");
-		p_file->store_line("\t");
-		p_file->store_line("\t// Add scanlines");
-		p_file->store_line("\tfloat scanline = sin(uv.y * 800.0) * scanline_intensity;");
-		p_file->store_line("\tcolor.rgb -= scanline;");
-		p_file->store_line("\t");
-		p_file->store_line("\tCOLOR = color;");
-		p_file->store_line("}");
-		p_file->store_line("\"\"\";");
-		p_file->store_line("\t");
-		p_file->store_line("\tcrt_material = ShaderMaterial.new()");
-		p_file->store_line("\tcrt_material.shader = crt_shader");
+		p_file->store_line("\tcrt_enabled = enable");
 	}
 }
 
@@ -204,36 +143,12 @@ void ScreenEffectsModule::generate_scene(Ref<FileAccess> p_file, const String &p
 		p_file->store_line("");
 		p_file->store_line("[ext_resource type=\"Script\" path=\"res://scripts/effects/ScreenOverlay.gd\" id=\"1_overlay_script\"]");
 		p_file->store_line("");
-		p_file->store_line("[node name=\"ScreenOverlay\" type=\"Control\"]");
+		p_file->store_line("[node name=\"ScreenOverlay\" type=\"ScreenEffectsCompositor\"]");
 		p_file->store_line("layout_mode = 3");
 		p_file->store_line("anchors_preset = 15");
 		p_file->store_line("anchor_right = 1.0");
 		p_file->store_line("anchor_bottom = 1.0");
 		p_file->store_line("mouse_filter = 2");
 		p_file->store_line("script = ExtResource(\"1_overlay_script\")");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"ColorOverlay\" type=\"ColorRect\" parent=\".\"]");
-		p_file->store_line("layout_mode = 1");
-		p_file->store_line("anchors_preset = 15");
-		p_file->store_line("anchor_right = 1.0");
-		p_file->store_line("anchor_bottom = 1.0");
-		p_file->store_line("mouse_filter = 2");
-		p_file->store_line("color = Color(0, 0, 0, 0)");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"FlashOverlay\" type=\"ColorRect\" parent=\".\"]");
-		p_file->store_line("layout_mode = 1");
-		p_file->store_line("anchors_preset = 15");
-		p_file->store_line("anchor_right = 1.0");
-		p_file->store_line("anchor_bottom = 1.0");
-		p_file->store_line("mouse_filter = 2");
-		p_file->store_line("color = Color(1, 0, 0, 0)");
-		p_file->store_line("");
-		p_file->store_line("[node name=\"VignetteOverlay\" type=\"ColorRect\" parent=\".\"]");
-		p_file->store_line("layout_mode = 1");
-		p_file->store_line("anchors_preset = 15");
-		p_file->store_line("anchor_right = 1.0");
-		p_file->store_line("anchor_bottom = 1.0");
-		p_file->store_line("mouse_filter = 2");
-		p_file->store_line("color = Color(0, 0, 0, 0)");
 	}
 }
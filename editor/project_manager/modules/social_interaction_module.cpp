@@ -138,8 +138,7 @@ void SocialInteractionModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t");
 		p_file->store_line("\t# Check relationship level");
 		p_file->store_line("\tif RelationshipManager:");
-		p_file->store_line("\t\tvar relationship = RelationshipManager.get_relationship(\"player\", character_id)");
-		p_file->store_line("\t\tvar level = RelationshipManager.get_relationship_level(relationship.friendship_points)");
+		p_file->store_line("\t\tvar level = RelationshipManager.get_relationship_level(RelationshipManager.get_friendship_points(\"player\", character_id))");
 		p_file->store_line("\t\tif level < RelationshipManager.RelationshipLevel.ROMANCE_INTEREST:");
 		p_file->store_line("\t\t\treturn {\"success\": false, \"reason\": \"relationship_too_low\"}");
 		p_file->store_line("\t");
@@ -162,8 +161,7 @@ void SocialInteractionModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t");
 		p_file->store_line("\t# Check relationship level");
 		p_file->store_line("\tif RelationshipManager:");
-		p_file->store_line("\t\tvar relationship = RelationshipManager.get_relationship(\"player\", character_id)");
-		p_file->store_line("\t\tvar level = RelationshipManager.get_relationship_level(relationship.friendship_points)");
+		p_file->store_line("\t\tvar level = RelationshipManager.get_relationship_level(RelationshipManager.get_friendship_points(\"player\", character_id))");
 		p_file->store_line("\t\tif level < RelationshipManager.RelationshipLevel.ROMANCE_PARTNER:");
 		p_file->store_line("\t\t\treturn {\"success\": false, \"reason\": \"relationship_too_low\"}");
 		p_file->store_line("\t");
@@ -207,8 +205,7 @@ void SocialInteractionModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tif not RelationshipManager:");
 		p_file->store_line("\t\treturn");
 		p_file->store_line("\t");
-		p_file->store_line("\tvar relationship = RelationshipManager.get_relationship(\"player\", character_id)");
-		p_file->store_line("\tvar friendship_level = RelationshipManager.get_relationship_level(relationship.friendship_points)");
+		p_file->store_line("\tvar friendship_level = RelationshipManager.get_relationship_level(RelationshipManager.get_friendship_points(\"player\", character_id))");
 		p_file->store_line("\t");
 		p_file->store_line("\tfor event_id in friendship_events.keys():");
 		p_file->store_line("\t\tvar event = friendship_events[event_id]");
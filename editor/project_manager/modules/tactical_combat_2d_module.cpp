@@ -29,9 +29,14 @@ void TacticalCombat2DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("# Battle components");
 		p_file->store_line("var battlefield: TacticalGrid2D");
 		p_file->store_line("var tactical_ui: Control");
-		p_file->store_line("var movement_calculator: MovementCalculator");
 		p_file->store_line("var attack_calculator: AttackCalculator");
-		p_file->store_line("var tactical_ai: TacticalAI");
+		p_file->store_line("");
+		p_file->store_line("# Native grid used for movement ranges, attack ranges and AI planning.");
+		p_file->store_line("# Players and allies share a team so they can move through each other.");
+		p_file->store_line("const TEAMS = { \"player\": 0, \"ally\": 0, \"enemy\": 1 }");
+		p_file->store_line("var grid := TacticalGrid.new()");
+		p_file->store_line("var unit_grid_ids: Dictionary = {}");
+		p_file->store_line("var grid_units: Dictionary = {}");
 		p_file->store_line("");
 		p_file->store_line("# Unit management");
 		p_file->store_line("var player_units: Array[TacticalUnit2D] = []");
@@ -47,9 +52,7 @@ void TacticalCombat2DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("");
 		p_file->store_line("func _ready():");
 		p_file->store_line("\t# Initialize systems");
-		p_file->store_line("\tmovement_calculator = MovementCalculator.new()");
 		p_file->store_line("\tattack_calculator = AttackCalculator.new()");
-		p_file->store_line("\ttactical_ai = TacticalAI.new()");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Load UI");
 		p_file->store_line("\tvar ui_scene = preload(\"res://scenes/ui/TacticalUI.tscn\")");
@@ -104,8 +107,42 @@ void TacticalCombat2DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t");
 		p_file->store_line("\tcurrent_phase = CombatPhase.PLAYER_TURN");
 		p_file->store_line("\tcurrent_turn = 1");
+		p_file->store_line("\t_build_grid()");
 		p_file->store_line("\t_start_player_turn()");
 		p_file->store_line("");
+		p_file->store_line("func _build_grid():");
+		p_file->store_line("\tgrid.clear_units()");
+		p_file->store_line("\tunit_grid_ids.clear()");
+		p_file->store_line("\tgrid_units.clear()");
+		p_file->store_line("\tgrid.size = grid_size");
+		p_file->store_line("\tgrid.update()");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Battlefields can provide terrain costs, where 0 or less is impassable");
+		p_file->store_line("\tif battlefield.has_method(\"get_tile_cost\"):");
+		p_file->store_line("\t\tfor x in range(grid_size.x):");
+		p_file->store_line("\t\t\tfor y in range(grid_size.y):");
+		p_file->store_line("\t\t\t\tvar cost = battlefield.get_tile_cost(Vector2i(x, y))");
+		p_file->store_line("\t\t\t\tif cost <= 0:");
+		p_file->store_line("\t\t\t\t\tgrid.set_point_solid(Vector2i(x, y))");
+		p_file->store_line("\t\t\t\telse:");
+		p_file->store_line("\t\t\t\t\tgrid.set_point_weight_scale(Vector2i(x, y), cost)");
+		p_file->store_line("\t");
+		p_file->store_line("\tfor unit in player_units + ally_units + enemy_units:");
+		p_file->store_line("\t\t_register_unit(unit)");
+		p_file->store_line("");
+		p_file->store_line("func _register_unit(unit: TacticalUnit2D):");
+		p_file->store_line("\tvar id = grid.add_unit(unit.grid_position, TEAMS.get(unit.faction, 1), _unit_stat(unit, \"movement\", 5), _unit_stat(unit, \"min_range\", 1), _unit_stat(unit, \"max_range\", 1))");
+		p_file->store_line("\tif id < 0:");
+		p_file->store_line("\t\treturn");
+		p_file->store_line("\tgrid.set_unit_damage(id, _unit_stat(unit, \"attack\", 0))");
+		p_file->store_line("\tgrid.set_unit_health(id, _unit_stat(unit, \"health\", 1))");
+		p_file->store_line("\tunit_grid_ids[unit] = id");
+		p_file->store_line("\tgrid_units[id] = unit");
+		p_file->store_line("");
+		p_file->store_line("func _unit_stat(unit: TacticalUnit2D, stat: String, default_value):");
+		p_file->store_line("\tvar value = unit.get(stat)");
+		p_file->store_line("\treturn default_value if value == null else value");
+		p_file->store_line("");
 		p_file->store_line("func _start_player_turn():");
 		p_file->store_line("\tcurrent_phase = CombatPhase.PLAYER_TURN");
 		p_file->store_line("\tunits_acted_this_turn.clear()");
@@ -173,11 +210,11 @@ void TacticalCombat2DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tselected_unit = unit");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Show movement range");
-		p_file->store_line("\tvar movement_range = movement_calculator.calculate_movement_range(unit, battlefield)");
+		p_file->store_line("\tvar movement_range = grid.get_movement_range(unit_grid_ids[unit])");
 		p_file->store_line("\tbattlefield.highlight_tiles(movement_range, \"movement\")");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Show attack range");
-		p_file->store_line("\tvar attack_range = attack_calculator.calculate_attack_range(unit, battlefield)");
+		p_file->store_line("\tvar attack_range = grid.get_attack_range(unit_grid_ids[unit])");
 		p_file->store_line("\tbattlefield.highlight_tiles(attack_range, \"attack\")");
 		p_file->store_line("\t");
 		p_file->store_line("\tunit_selected.emit(unit)");
@@ -187,52 +224,67 @@ void TacticalCombat2DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\treturn false");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Check if movement is valid");
-		p_file->store_line("\tvar movement_range = movement_calculator.calculate_movement_range(unit, battlefield)");
-		p_file->store_line("\tif not movement_range.has(target_position):");
+		p_file->store_line("\tif grid.get_move_path(unit_grid_ids[unit], target_position).is_empty():");
 		p_file->store_line("\t\treturn false");
 		p_file->store_line("\t");
+		p_file->store_line("\t_apply_move(unit, target_position)");
+		p_file->store_line("\treturn true");
+		p_file->store_line("");
+		p_file->store_line("func _apply_move(unit: TacticalUnit2D, target_position: Vector2i):");
 		p_file->store_line("\tvar old_position = unit.grid_position");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Move unit");
 		p_file->store_line("\tbattlefield.move_unit(unit, target_position)");
+		p_file->store_line("\tgrid.set_unit_cell(unit_grid_ids[unit], target_position)");
 		p_file->store_line("\tunit.grid_position = target_position");
 		p_file->store_line("\tunit.has_moved = true");
 		p_file->store_line("\t");
 		p_file->store_line("\tunit_moved.emit(unit, old_position, target_position)");
-		p_file->store_line("\treturn true");
 		p_file->store_line("");
 		p_file->store_line("func attack_unit(attacker: TacticalUnit2D, target: TacticalUnit2D) -> bool:");
 		p_file->store_line("\tif attacker != selected_unit or units_acted_this_turn.has(attacker):");
 		p_file->store_line("\t\treturn false");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Check if attack is valid");
-		p_file->store_line("\tvar attack_range = attack_calculator.calculate_attack_range(attacker, battlefield)");
-		p_file->store_line("\tif not attack_range.has(target.grid_position):");
+		p_file->store_line("\tif not _can_attack(attacker, target):");
 		p_file->store_line("\t\treturn false");
 		p_file->store_line("\t");
+		p_file->store_line("\t_apply_attack(attacker, target)");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Mark unit as acted");
+		p_file->store_line("\tunits_acted_this_turn.append(attacker)");
+		p_file->store_line("\tselected_unit = null");
+		p_file->store_line("\tbattlefield.clear_highlights()");
+		p_file->store_line("\t");
+		p_file->store_line("\treturn true");
+		p_file->store_line("");
+		p_file->store_line("func _can_attack(attacker: TacticalUnit2D, target: TacticalUnit2D) -> bool:");
+		p_file->store_line("\tif not unit_grid_ids.has(attacker) or not unit_grid_ids.has(target):");
+		p_file->store_line("\t\treturn false");
+		p_file->store_line("\treturn grid.get_targets_in_range(unit_grid_ids[attacker], attacker.grid_position).has(unit_grid_ids[target])");
+		p_file->store_line("");
+		p_file->store_line("func _apply_attack(attacker: TacticalUnit2D, target: TacticalUnit2D):");
 		p_file->store_line("\t# Calculate damage");
 		p_file->store_line("\tvar damage = attack_calculator.calculate_damage(attacker, target)");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Apply damage");
 		p_file->store_line("\ttarget.take_damage(damage)");
 		p_file->store_line("\tattacker.has_attacked = true");
+		p_file->store_line("\tgrid.set_unit_health(unit_grid_ids[target], _unit_stat(target, \"health\", 0))");
 		p_file->store_line("\t");
 		p_file->store_line("\tunit_attacked.emit(attacker, target, damage)");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Check if target died");
 		p_file->store_line("\tif target.is_dead():");
 		p_file->store_line("\t\t_handle_unit_death(target)");
-		p_file->store_line("\t");
-		p_file->store_line("\t# Mark unit as acted");
-		p_file->store_line("\tunits_acted_this_turn.append(attacker)");
-		p_file->store_line("\tselected_unit = null");
-		p_file->store_line("\tbattlefield.clear_highlights()");
-		p_file->store_line("\t");
-		p_file->store_line("\treturn true");
 		p_file->store_line("");
 		p_file->store_line("func _handle_unit_death(unit: TacticalUnit2D):");
 		p_file->store_line("\t# Remove from battlefield");
 		p_file->store_line("\tbattlefield.remove_unit(unit)");
+		p_file->store_line("\tif unit_grid_ids.has(unit):");
+		p_file->store_line("\t\tgrid.remove_unit(unit_grid_ids[unit])");
+		p_file->store_line("\t\tgrid_units.erase(unit_grid_ids[unit])");
+		p_file->store_line("\t\tunit_grid_ids.erase(unit)");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Remove from unit arrays");
 		p_file->store_line("\tplayer_units.erase(unit)");
@@ -260,13 +312,16 @@ void TacticalCombat2DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\treturn false");
 		p_file->store_line("");
 		p_file->store_line("func _process_ai_turn(units: Array[TacticalUnit2D]):");
-		p_file->store_line("\tfor unit in units:");
-		p_file->store_line("\t\tif unit.is_dead():");
+		p_file->store_line("\tif units.is_empty():");
+		p_file->store_line("\t\treturn");
+		p_file->store_line("\t");
+		p_file->store_line("\t# AI plans the whole team at once, then actions play out in order");
+		p_file->store_line("\tvar plan = grid.plan_turn(TEAMS.get(units[0].faction, 1))");
+		p_file->store_line("\tfor action in plan:");
+		p_file->store_line("\t\tvar unit = grid_units.get(action.unit)");
+		p_file->store_line("\t\tif unit == null or not units.has(unit) or unit.is_dead():");
 		p_file->store_line("\t\t\tcontinue");
 		p_file->store_line("\t\t");
-		p_file->store_line("\t\t# AI decides action");
-		p_file->store_line("\t\tvar action = tactical_ai.decide_action(unit, battlefield, player_units, enemy_units)");
-		p_file->store_line("\t\t");
 		p_file->store_line("\t\t# Execute action");
 		p_file->store_line("\t\tawait _execute_ai_action(unit, action)");
 		p_file->store_line("\t\t");
@@ -274,13 +329,13 @@ void TacticalCombat2DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\tawait get_tree().create_timer(0.5).timeout");
 		p_file->store_line("");
 		p_file->store_line("func _execute_ai_action(unit: TacticalUnit2D, action: Dictionary):");
-		p_file->store_line("\tmatch action.type:");
-		p_file->store_line("\t\t\"move\":");
-		p_file->store_line("\t\t\tmove_unit(unit, action.target_position)");
-		p_file->store_line("\t\t\"attack\":");
-		p_file->store_line("\t\t\tattack_unit(unit, action.target_unit)");
-		p_file->store_line("\t\t\"wait\":");
-		p_file->store_line("\t\t\tpass  # Do nothing");
+		p_file->store_line("\tif action.cell != unit.grid_position:");
+		p_file->store_line("\t\t_apply_move(unit, action.cell)");
+		p_file->store_line("\t");
+		p_file->store_line("\t# Earlier actions this turn may have already defeated the target");
+		p_file->store_line("\tvar target = grid_units.get(action.target)");
+		p_file->store_line("\tif target != null and not target.is_dead() and _can_attack(unit, target):");
+		p_file->store_line("\t\t_apply_attack(unit, target)");
 		p_file->store_line("\t");
 		p_file->store_line("\t# Animation delay");
 		p_file->store_line("\tawait get_tree().create_timer(0.3).timeout");
@@ -16,6 +16,7 @@ void TacticalCombat3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("@export var tile_size: float = 2.0");
 		p_file->store_line("@export var height_levels: int = 5");
 		p_file->store_line("@export var height_step: float = 1.0");
+		p_file->store_line("@export var climb_cost: float = 1.0");
 		p_file->store_line("");
 		p_file->store_line("# Visual components");
 		p_file->store_line("@onready var grid_mesh: MeshInstance3D = $GridMesh");
@@ -27,6 +28,13 @@ void TacticalCombat3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("var deployment_zones: Dictionary = {}");
 		p_file->store_line("var highlight_tiles: Array[MeshInstance3D] = []");
 		p_file->store_line("");
+		p_file->store_line("# Native grid for movement, attack ranges and AI planning. Higher tiles cost");
+		p_file->store_line("# more movement to enter. Players and allies share a team.");
+		p_file->store_line("const TEAMS = { \"player\": 0, \"ally\": 0, \"enemy\": 1 }");
+		p_file->store_line("var tactics := TacticalGrid.new()");
+		p_file->store_line("var unit_ids: Dictionary = {}");
+		p_file->store_line("var id_units: Dictionary = {}");
+		p_file->store_line("");
 		p_file->store_line("# Materials");
 		p_file->store_line("var movement_material: StandardMaterial3D");
 		p_file->store_line("var attack_material: StandardMaterial3D");
@@ -65,6 +73,9 @@ void TacticalCombat3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\t\t\t# Default height is 0, can be customized");
 		p_file->store_line("\t\t\tgrid_heights[x][y] = 0");
 		p_file->store_line("\t");
+		p_file->store_line("\ttactics.size = grid_size");
+		p_file->store_line("\ttactics.update()");
+		p_file->store_line("\t");
 		p_file->store_line("\t# Generate visual grid");
 		p_file->store_line("\t_create_grid_mesh()");
 		p_file->store_line("");
@@ -122,6 +133,7 @@ void TacticalCombat3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tif not is_valid_position(grid_pos):");
 		p_file->store_line("\t\treturn");
 		p_file->store_line("\tgrid_heights[grid_pos.x][grid_pos.y] = clamp(height, 0, height_levels - 1)");
+		p_file->store_line("\ttactics.set_point_weight_scale(grid_pos, 1.0 + grid_heights[grid_pos.x][grid_pos.y] * climb_cost)");
 		p_file->store_line("");
 		p_file->store_line("func is_valid_position(grid_pos: Vector2i) -> bool:");
 		p_file->store_line("\treturn grid_pos.x >= 0 and grid_pos.x < grid_size.x and grid_pos.y >= 0 and grid_pos.y < grid_size.y");
@@ -137,6 +149,16 @@ void TacticalCombat3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tvar world_pos = grid_to_world(grid_pos, get_tile_height(grid_pos))");
 		p_file->store_line("\tunit.global_position = world_pos");
 		p_file->store_line("\tunit.grid_position = grid_pos");
+		p_file->store_line("\t");
+		p_file->store_line("\tif unit_ids.has(unit):");
+		p_file->store_line("\t\ttactics.set_unit_cell(unit_ids[unit], grid_pos)");
+		p_file->store_line("\telse:");
+		p_file->store_line("\t\tvar id = tactics.add_unit(grid_pos, TEAMS.get(unit.faction, 1), _unit_stat(unit, \"movement\", 5), _unit_stat(unit, \"min_range\", 1), _unit_stat(unit, \"max_range\", 1))");
+		p_file->store_line("\t\tif id >= 0:");
+		p_file->store_line("\t\t\ttactics.set_unit_damage(id, _unit_stat(unit, \"attack\", 0))");
+		p_file->store_line("\t\t\ttactics.set_unit_health(id, _unit_stat(unit, \"health\", 1))");
+		p_file->store_line("\t\t\tunit_ids[unit] = id");
+		p_file->store_line("\t\t\tid_units[id] = unit");
 		p_file->store_line("");
 		p_file->store_line("func move_unit(unit: TacticalUnit3D, new_grid_pos: Vector2i):");
 		p_file->store_line("\tif not is_valid_position(new_grid_pos) or is_tile_occupied(new_grid_pos):");
@@ -150,6 +172,49 @@ void TacticalCombat3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("");
 		p_file->store_line("func remove_unit(unit: TacticalUnit3D):");
 		p_file->store_line("\toccupied_tiles.erase(unit.grid_position)");
+		p_file->store_line("\tif unit_ids.has(unit):");
+		p_file->store_line("\t\ttactics.remove_unit(unit_ids[unit])");
+		p_file->store_line("\t\tid_units.erase(unit_ids[unit])");
+		p_file->store_line("\t\tunit_ids.erase(unit)");
+		p_file->store_line("");
+		p_file->store_line("func _unit_stat(unit: TacticalUnit3D, stat: String, default_value):");
+		p_file->store_line("\tvar value = unit.get(stat)");
+		p_file->store_line("\treturn default_value if value == null else value");
+		p_file->store_line("");
+		p_file->store_line("func update_unit_health(unit: TacticalUnit3D):");
+		p_file->store_line("\tif unit_ids.has(unit):");
+		p_file->store_line("\t\ttactics.set_unit_health(unit_ids[unit], _unit_stat(unit, \"health\", 0))");
+		p_file->store_line("");
+		p_file->store_line("func get_movement_range(unit: TacticalUnit3D) -> Array[Vector2i]:");
+		p_file->store_line("\tif not unit_ids.has(unit):");
+		p_file->store_line("\t\treturn []");
+		p_file->store_line("\treturn tactics.get_movement_range(unit_ids[unit])");
+		p_file->store_line("");
+		p_file->store_line("func get_attack_range(unit: TacticalUnit3D) -> Array[Vector2i]:");
+		p_file->store_line("\tif not unit_ids.has(unit):");
+		p_file->store_line("\t\treturn []");
+		p_file->store_line("\treturn tactics.get_attack_range(unit_ids[unit])");
+		p_file->store_line("");
+		p_file->store_line("func get_units_in_range(unit: TacticalUnit3D, from: Vector2i) -> Array[TacticalUnit3D]:");
+		p_file->store_line("\tvar targets: Array[TacticalUnit3D] = []");
+		p_file->store_line("\tif unit_ids.has(unit):");
+		p_file->store_line("\t\tfor id in tactics.get_targets_in_range(unit_ids[unit], from):");
+		p_file->store_line("\t\t\ttargets.append(id_units[id])");
+		p_file->store_line("\treturn targets");
+		p_file->store_line("");
+		p_file->store_line("func plan_turn(faction: String) -> Array[Dictionary]:");
+		p_file->store_line("\t# Returns { unit, cell, target } for every unit of the faction");
+		p_file->store_line("\tvar actions: Array[Dictionary] = []");
+		p_file->store_line("\tfor action in tactics.plan_turn(TEAMS.get(faction, 1)):");
+		p_file->store_line("\t\tvar unit = id_units[action.unit]");
+		p_file->store_line("\t\tif unit.faction != faction:");
+		p_file->store_line("\t\t\tcontinue");
+		p_file->store_line("\t\tactions.append({");
+		p_file->store_line("\t\t\t\"unit\": unit,");
+		p_file->store_line("\t\t\t\"cell\": action.cell,");
+		p_file->store_line("\t\t\t\"target\": id_units.get(action.target)");
+		p_file->store_line("\t\t})");
+		p_file->store_line("\treturn actions");
 		p_file->store_line("");
 		p_file->store_line("func highlight_tiles(positions: Array[Vector2i], highlight_type: String):");
 		p_file->store_line("\tclear_highlights()");
@@ -16,10 +16,15 @@ void VisualNovelScriptParserModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("signal variable_changed(var_name: String, value)");
 	p_file->store_line("");
 	p_file->store_line("# Current script state");
-	p_file->store_line("var current_script: Dictionary = {}");
+	p_file->store_line("# .vn files are compiled to VNScript resources on import, so nothing is parsed at runtime");
+	p_file->store_line("var current_script: VNScript = null");
 	p_file->store_line("var current_node_id: String = \"\"");
+	p_file->store_line("var current_node: int = VNScript.TARGET_END");
 	p_file->store_line("var script_variables: Dictionary = {}");
-	p_file->store_line("var script_functions: Dictionary = {}");
+	p_file->store_line("");
+	p_file->store_line("# Shared by the background and portrait systems; textures used by the next");
+	p_file->store_line("# nodes are loaded in the background while the current one is on screen");
+	p_file->store_line("var asset_streamer := VNAssetStreamer.new()");
 	p_file->store_line("");
 	p_file->store_line("# Asset paths for automatic discovery");
 	p_file->store_line("var asset_paths = {");
@@ -33,156 +38,32 @@ void VisualNovelScriptParserModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\t# Initialize script parser");
 	p_file->store_line("\tprint(\"VN Script Parser initialized\")");
 	p_file->store_line("");
-	p_file->store_line("# Load and parse a visual novel script file");
+	p_file->store_line("func _process(_delta):");
+	p_file->store_line("\t# Collect prefetched textures as they finish loading");
+	p_file->store_line("\tif asset_streamer.get_pending_count() > 0:");
+	p_file->store_line("\t\tasset_streamer.poll()");
+	p_file->store_line("");
+	p_file->store_line("# Load a compiled visual novel script");
 	p_file->store_line("func load_script(script_path: String) -> bool:");
-	p_file->store_line("\tvar file = FileAccess.open(script_path, FileAccess.READ)");
-	p_file->store_line("\tif not file:");
+	p_file->store_line("\tif not script_path.contains(\"://\"):");
+	p_file->store_line("\t\tscript_path = \"res://\" + script_path");
+	p_file->store_line("\t");
+	p_file->store_line("\tvar compiled = load(script_path) as VNScript");
+	p_file->store_line("\tif not compiled:");
 	p_file->store_line("\t\tprint(\"Failed to load script: \", script_path)");
 	p_file->store_line("\t\treturn false");
 	p_file->store_line("\t");
-	p_file->store_line("\tvar content = file.get_as_text()");
-	p_file->store_line("\tfile.close()");
-	p_file->store_line("\t");
-	p_file->store_line("\tcurrent_script = parse_script_content(content)");
-	p_file->store_line("\treturn current_script.size() > 0");
-	p_file->store_line("");
-	p_file->store_line("# Parse script content into node structure");
-	p_file->store_line("func parse_script_content(content: String) -> Dictionary:");
-	p_file->store_line("\tvar script_data = {}");
-	p_file->store_line("\tvar lines = content.split(\"\\n\")");
-	p_file->store_line("\tvar current_function = \"\"");
-	p_file->store_line("\tvar i = 0");
-	p_file->store_line("\t");
-	p_file->store_line("\twhile i < lines.size():");
-	p_file->store_line("\t\tvar line = lines[i].strip_edges()");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Skip empty lines and comments");
-	p_file->store_line("\t\tif line.is_empty() or line.begins_with(\"#\"):");
-	p_file->store_line("\t\t\ti += 1");
-	p_file->store_line("\t\t\tcontinue");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Function declaration (FN : FunctionName)");
-	p_file->store_line("\t\tif line.begins_with(\"FN :\"):");
-	p_file->store_line("\t\t\tcurrent_function = line.substr(4).strip_edges()");
-	p_file->store_line("\t\t\tscript_functions[current_function] = {}");
-	p_file->store_line("\t\t\ti += 1");
-	p_file->store_line("\t\t\tcontinue");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Commands [[command args]]");
-	p_file->store_line("\t\tif line.begins_with(\"[[\") and line.ends_with(\"]]\"):");
-	p_file->store_line("\t\t\t# Handle commands in current function context");
-	p_file->store_line("\t\t\ti += 1");
-	p_file->store_line("\t\t\tcontinue");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Node definition (NodeID or NodeID if condition)");
-	p_file->store_line("\t\tif not line.contains(\" \") or line.split(\" \")[0].is_valid_identifier():");
-	p_file->store_line("\t\t\tvar node_data = parse_node(lines, i)");
-	p_file->store_line("\t\t\tif current_function.is_empty():");
-	p_file->store_line("\t\t\t\tscript_data[node_data.id] = node_data");
-	p_file->store_line("\t\t\telse:");
-	p_file->store_line("\t\t\t\tscript_functions[current_function][node_data.id] = node_data");
-	p_file->store_line("\t\t\ti = node_data.end_line");
-	p_file->store_line("\t\t\tcontinue");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\ti += 1");
-	p_file->store_line("\t");
-	p_file->store_line("\treturn script_data");
-	p_file->store_line("");
-	p_file->store_line("# Parse a single dialogue node");
-	p_file->store_line("func parse_node(lines: PackedStringArray, start_index: int) -> Dictionary:");
-	p_file->store_line("\tvar node = {");
-	p_file->store_line("\t\t\"id\": \"\",");
-	p_file->store_line("\t\t\"condition\": \"\",");
-	p_file->store_line("\t\t\"speaker\": \"\",");
-	p_file->store_line("\t\t\"dialogue\": [],");
-	p_file->store_line("\t\t\"commands\": [],");
-	p_file->store_line("\t\t\"choices\": [],");
-	p_file->store_line("\t\t\"next_node\": \"\",");
-	p_file->store_line("\t\t\"end_line\": start_index");
-	p_file->store_line("\t}");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar line = lines[start_index].strip_edges()");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Parse node ID and condition");
-	p_file->store_line("\tif \" if \" in line:");
-	p_file->store_line("\t\tvar parts = line.split(\" if \", false, 1)");
-	p_file->store_line("\t\tnode.id = parts[0].strip_edges()");
-	p_file->store_line("\t\tnode.condition = parts[1].strip_edges()");
-	p_file->store_line("\telse:");
-	p_file->store_line("\t\tnode.id = line");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar i = start_index + 1");
-	p_file->store_line("\tvar parsing_dialogue = false");
-	p_file->store_line("\t");
-	p_file->store_line("\twhile i < lines.size():");
-	p_file->store_line("\t\tline = lines[i].strip_edges()");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Empty line or next node - end parsing");
-	p_file->store_line("\t\tif line.is_empty() or (not parsing_dialogue and line.split(\" \")[0].is_valid_identifier()):");
-	p_file->store_line("\t\t\tbreak");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Commands");
-	p_file->store_line("\t\tif line.begins_with(\"[[\") and line.ends_with(\"]]\"):");
-	p_file->store_line("\t\t\tnode.commands.append(line.substr(2, line.length() - 4))");
-	p_file->store_line("\t\t\ti += 1");
-	p_file->store_line("\t\t\tcontinue");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Choices [Choice|NodeID]");
-	p_file->store_line("\t\tif line.begins_with(\"[\") and \"|\" in line and line.ends_with(\"]\"):");
-	p_file->store_line("\t\t\tvar choice_content = line.substr(1, line.length() - 2)");
-	p_file->store_line("\t\t\tvar choice_parts = choice_content.split(\"|\", false, 1)");
-	p_file->store_line("\t\t\tnode.choices.append({");
-	p_file->store_line("\t\t\t\t\"text\": choice_parts[0].strip_edges(),");
-	p_file->store_line("\t\t\t\t\"target\": choice_parts[1].strip_edges()");
-	p_file->store_line("\t\t\t})");
-	p_file->store_line("\t\t\ti += 1");
-	p_file->store_line("\t\t\tcontinue");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Simple node connection [NodeID]");
-	p_file->store_line("\t\tif line.begins_with(\"[\") and line.ends_with(\"]\") and not \"|\" in line:");
-	p_file->store_line("\t\t\tnode.next_node = line.substr(1, line.length() - 2)");
-	p_file->store_line("\t\t\ti += 1");
-	p_file->store_line("\t\t\tcontinue");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# End marker");
-	p_file->store_line("\t\tif line == \"[end]\":");
-	p_file->store_line("\t\t\tnode.next_node = \"end\"");
-	p_file->store_line("\t\t\ti += 1");
-	p_file->store_line("\t\t\tbreak");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\t# Speaker or dialogue");
-	p_file->store_line("\t\tif not parsing_dialogue:");
-	p_file->store_line("\t\t\t# First non-command line is speaker");
-	p_file->store_line("\t\t\tnode.speaker = format_character_name(line)");
-	p_file->store_line("\t\t\tparsing_dialogue = true");
-	p_file->store_line("\t\telse:");
-	p_file->store_line("\t\t\t# Subsequent lines are dialogue");
-	p_file->store_line("\t\t\tnode.dialogue.append(line)");
-	p_file->store_line("\t\t");
-	p_file->store_line("\t\ti += 1");
-	p_file->store_line("\t");
-	p_file->store_line("\tnode.end_line = i");
-	p_file->store_line("\treturn node");
+	p_file->store_line("\tcurrent_script = compiled");
+	p_file->store_line("\tcurrent_node = VNScript.TARGET_END");
+	p_file->store_line("\treturn current_script.get_node_count() > 0");
 	p_file->store_line("");
-	p_file->store_line("# Format character names (DamienWayne_happy -> Damien Wayne)");
-	p_file->store_line("func format_character_name(name: String) -> String:");
-	p_file->store_line("\tif name.is_empty():");
-	p_file->store_line("\t\treturn \"\"");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Remove emotion suffix");
-	p_file->store_line("\tvar clean_name = name");
-	p_file->store_line("\tif \"_\" in clean_name:");
-	p_file->store_line("\t\tclean_name = clean_name.split(\"_\")[0]");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Convert PascalCase to spaced name");
-	p_file->store_line("\tvar result = \"\"");
-	p_file->store_line("\tfor i in range(clean_name.length()):");
-	p_file->store_line("\t\tvar char = clean_name[i]");
-	p_file->store_line("\t\tif i > 0 and char.to_upper() == char and char.is_valid_identifier():");
-	p_file->store_line("\t\t\tresult += \" \"");
-	p_file->store_line("\t\tresult += char");
-	p_file->store_line("\t");
-	p_file->store_line("\treturn result");
+	p_file->store_line("# Compile script source at runtime (for generated or user-made content)");
+	p_file->store_line("func parse_script_content(content: String) -> VNScript:");
+	p_file->store_line("\tvar compiled = VNScript.new()");
+	p_file->store_line("\tif compiled.compile(content) != OK:");
+	p_file->store_line("\t\tprint(\"Script error on line \", compiled.get_error_line(), \": \", compiled.get_error_string())");
+	p_file->store_line("\t\treturn null");
+	p_file->store_line("\treturn compiled");
 	p_file->store_line("");
 	p_file->store_line("# Execute a script starting from a specific node");
 	p_file->store_line("func start_script(start_node: String = \"1_1\"):");
@@ -191,152 +72,86 @@ void VisualNovelScriptParserModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("");
 	p_file->store_line("# Execute the current node");
 	p_file->store_line("func execute_current_node():");
-	p_file->store_line("\tif current_node_id == \"end\":");
+	p_file->store_line("\tif current_node_id == \"end\" or not current_script:");
 	p_file->store_line("\t\tscript_finished.emit()");
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Find the appropriate node (check conditions)");
-	p_file->store_line("\tvar node = find_valid_node(current_node_id)");
-	p_file->store_line("\tif not node:");
+	p_file->store_line("\tcurrent_node = find_valid_node(current_node_id)");
+	p_file->store_line("\tif current_node == VNScript.TARGET_END:");
 	p_file->store_line("\t\tprint(\"Node not found: \", current_node_id)");
 	p_file->store_line("\t\tscript_finished.emit()");
 	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
+	p_file->store_line("\t# Start loading what this node and the next ones show");
+	p_file->store_line("\tasset_streamer.prefetch_script(current_script, current_node, script_variables)");
+	p_file->store_line("\t");
 	p_file->store_line("\t# Execute commands");
-	p_file->store_line("\tfor command in node.commands:");
-	p_file->store_line("\t\texecute_command(command)");
+	p_file->store_line("\tfor i in current_script.get_node_command_count(current_node):");
+	p_file->store_line("\t\texecute_command(current_script.get_node_command_name(current_node, i), current_script.get_node_command_text(current_node, i), current_script.get_node_command_args(current_node, i))");
 	p_file->store_line("\t");
 	p_file->store_line("\t# Handle dialogue");
-	p_file->store_line("\tif node.dialogue.size() > 0:");
-	p_file->store_line("\t\tvar full_dialogue = \"\"");
-	p_file->store_line("\t\tfor line in node.dialogue:");
-	p_file->store_line("\t\t\tfull_dialogue += line + \"\\n\"");
-	p_file->store_line("\t\tfull_dialogue = full_dialogue.strip_edges()");
-	p_file->store_line("\t\tdialogue_started.emit(node.speaker, full_dialogue)");
+	p_file->store_line("\tvar text = current_script.get_node_text(current_node)");
+	p_file->store_line("\tif not text.is_empty():");
+	p_file->store_line("\t\tdialogue_started.emit(current_script.get_node_speaker(current_node), text)");
 	p_file->store_line("\t");
-	p_file->store_line("\t# Handle choices or auto-advance");
-	p_file->store_line("\tif node.choices.size() > 0:");
-	p_file->store_line("\t\tchoice_presented.emit(node.choices)");
-	p_file->store_line("\telse:");
-	p_file->store_line("\t\t# Auto-advance to next node");
-	p_file->store_line("\t\tif not node.next_node.is_empty():");
-	p_file->store_line("\t\t\tcurrent_node_id = node.next_node");
-	p_file->store_line("\t\telse:");
-	p_file->store_line("\t\t\tscript_finished.emit()");
+	p_file->store_line("\t# Present choices, otherwise wait for continue_script()");
+	p_file->store_line("\tif current_script.get_node_choice_count(current_node) > 0:");
+	p_file->store_line("\t\tchoice_presented.emit(current_script.get_node_choices(current_node))");
 	p_file->store_line("");
 	p_file->store_line("# Continue to next node (called after dialogue display)");
 	p_file->store_line("func continue_script():");
-	p_file->store_line("\tvar node = find_valid_node(current_node_id)");
-	p_file->store_line("\tif node and node.choices.size() == 0:");
-	p_file->store_line("\t\tif not node.next_node.is_empty():");
-	p_file->store_line("\t\t\tcurrent_node_id = node.next_node");
-	p_file->store_line("\t\t\texecute_current_node()");
-	p_file->store_line("\t\telse:");
-	p_file->store_line("\t\t\tscript_finished.emit()");
+	p_file->store_line("\tif not current_script or current_node == VNScript.TARGET_END:");
+	p_file->store_line("\t\treturn");
+	p_file->store_line("\tif current_script.get_node_choice_count(current_node) == 0:");
+	p_file->store_line("\t\t_go_to_label(current_script.get_node_next(current_node))");
 	p_file->store_line("");
 	p_file->store_line("# Make a choice and continue");
 	p_file->store_line("func make_choice(choice_index: int):");
-	p_file->store_line("\tvar node = find_valid_node(current_node_id)");
-	p_file->store_line("\tif node and choice_index < node.choices.size():");
-	p_file->store_line("\t\tcurrent_node_id = node.choices[choice_index].target");
-	p_file->store_line("\t\texecute_current_node()");
+	p_file->store_line("\tif not current_script or current_node == VNScript.TARGET_END:");
+	p_file->store_line("\t\treturn");
+	p_file->store_line("\tif choice_index >= 0 and choice_index < current_script.get_node_choice_count(current_node):");
+	p_file->store_line("\t\t_go_to_label(current_script.get_node_choice_target(current_node, choice_index))");
 	p_file->store_line("");
-	p_file->store_line("# Find a valid node considering conditions");
-	p_file->store_line("func find_valid_node(node_id: String) -> Dictionary:");
-	p_file->store_line("\t# Check main script first");
-	p_file->store_line("\tfor key in current_script.keys():");
-	p_file->store_line("\t\tif key == node_id or key.begins_with(node_id + \" if \"):");
-	p_file->store_line("\t\t\tvar node = current_script[key]");
-	p_file->store_line("\t\t\tif node.condition.is_empty() or evaluate_condition(node.condition):");
-	p_file->store_line("\t\t\t\treturn node");
-	p_file->store_line("\t");
-	p_file->store_line("\t# Check functions");
-	p_file->store_line("\tfor func_name in script_functions.keys():");
-	p_file->store_line("\t\tvar func_nodes = script_functions[func_name]");
-	p_file->store_line("\t\tfor key in func_nodes.keys():");
-	p_file->store_line("\t\t\tif key == node_id or key.begins_with(node_id + \" if \"):");
-	p_file->store_line("\t\t\t\tvar node = func_nodes[key]");
-	p_file->store_line("\t\t\t\tif node.condition.is_empty() or evaluate_condition(node.condition):");
-	p_file->store_line("\t\t\t\t\treturn node");
+	p_file->store_line("func _go_to_label(label: int):");
+	p_file->store_line("\tif label == VNScript.TARGET_END:");
+	p_file->store_line("\t\tcurrent_node_id = \"end\"");
+	p_file->store_line("\t\tcurrent_node = VNScript.TARGET_END");
+	p_file->store_line("\t\tscript_finished.emit()");
+	p_file->store_line("\t\treturn");
 	p_file->store_line("\t");
-	p_file->store_line("\treturn {}");
+	p_file->store_line("\tcurrent_node_id = current_script.get_label_name(label)");
+	p_file->store_line("\texecute_current_node()");
+	p_file->store_line("");
+	p_file->store_line("# Find a valid node considering conditions");
+	p_file->store_line("func find_valid_node(node_id: String) -> int:");
+	p_file->store_line("\tif not current_script:");
+	p_file->store_line("\t\treturn VNScript.TARGET_END");
+	p_file->store_line("\treturn current_script.resolve_label(current_script.find_label(node_id), script_variables)");
 	p_file->store_line("");
 	p_file->store_line("# Evaluate conditional expressions");
+	p_file->store_line("# Supports: =, !=, >, <, >=, <=, and, or, not, parentheses");
 	p_file->store_line("func evaluate_condition(condition: String) -> bool:");
-	p_file->store_line("\t# Simple condition evaluation - can be expanded");
-	p_file->store_line("\t# Supports: var = value, var > value, var < value, var >= value, var <= value");
-	p_file->store_line("\t# Also supports: and, or operators");
-	p_file->store_line("\t");
-	p_file->store_line("\tvar parts = condition.split(\" and \")");
-	p_file->store_line("\tfor part in parts:");
-	p_file->store_line("\t\tif not evaluate_single_condition(part.strip_edges()):");
-	p_file->store_line("\t\t\treturn false");
-	p_file->store_line("\treturn true");
-	p_file->store_line("");
-	p_file->store_line("func evaluate_single_condition(condition: String) -> bool:");
-	p_file->store_line("\t# Parse single condition");
-	p_file->store_line("\tvar operators = [\">=\", \"<=\", \"=\", \">\", \"<\"]");
-	p_file->store_line("\t");
-	p_file->store_line("\tfor op in operators:");
-	p_file->store_line("\t\tif op in condition:");
-	p_file->store_line("\t\t\tvar parts = condition.split(op, false, 1)");
-	p_file->store_line("\t\t\tif parts.size() == 2:");
-	p_file->store_line("\t\t\t\tvar var_name = parts[0].strip_edges()");
-	p_file->store_line("\t\t\t\tvar value = parts[1].strip_edges()");
-	p_file->store_line("\t\t\t\treturn compare_values(get_variable(var_name), value, op)");
-	p_file->store_line("\t");
-	p_file->store_line("\treturn false");
-	p_file->store_line("");
-	p_file->store_line("func compare_values(var_value, target_value: String, operator: String) -> bool:");
-	p_file->store_line("\t# Convert target value to appropriate type");
-	p_file->store_line("\tvar target");
-	p_file->store_line("\tif target_value.is_valid_int():");
-	p_file->store_line("\t\ttarget = target_value.to_int()");
-	p_file->store_line("\telif target_value.is_valid_float():");
-	p_file->store_line("\t\ttarget = target_value.to_float()");
-	p_file->store_line("\telse:");
-	p_file->store_line("\t\ttarget = target_value");
-	p_file->store_line("\t");
-	p_file->store_line("\tmatch operator:");
-	p_file->store_line("\t\t\"=\":");
-	p_file->store_line("\t\t\treturn var_value == target");
-	p_file->store_line("\t\t\">\":");
-	p_file->store_line("\t\t\treturn var_value > target");
-	p_file->store_line("\t\t\"<\":");
-	p_file->store_line("\t\t\treturn var_value < target");
-	p_file->store_line("\t\t\">=\":");
-	p_file->store_line("\t\t\treturn var_value >= target");
-	p_file->store_line("\t\t\"<=\":");
-	p_file->store_line("\t\t\treturn var_value <= target");
-	p_file->store_line("\t\t_:");
-	p_file->store_line("\t\t\treturn false");
+	p_file->store_line("\treturn VNScript.evaluate_condition(condition, script_variables)");
 	p_file->store_line("");
 	p_file->store_line("# Execute script commands");
-	p_file->store_line("func execute_command(command: String):");
-	p_file->store_line("\tvar parts = command.split(\" \", false, 1)");
-	p_file->store_line("\tvar cmd = parts[0]");
-	p_file->store_line("\tvar args = []");
-	p_file->store_line("\tif parts.size() > 1:");
-	p_file->store_line("\t\targs = parts[1].split(\" \")");
-	p_file->store_line("\t");
+	p_file->store_line("func execute_command(cmd: String, text: String, args: PackedStringArray):");
 	p_file->store_line("\tmatch cmd:");
 	p_file->store_line("\t\t\"var\":");
-	p_file->store_line("\t\t\tif args.size() >= 1 and \"=\" in args[0]:");
-	p_file->store_line("\t\t\t\tvar assignment = parts[1]");
-	p_file->store_line("\t\t\t\tvar assign_parts = assignment.split(\"=\", false, 1)");
-	p_file->store_line("\t\t\t\tif assign_parts.size() == 2:");
-	p_file->store_line("\t\t\t\t\tvar var_name = assign_parts[0].strip_edges()");
-	p_file->store_line("\t\t\t\t\tvar value = assign_parts[1].strip_edges()");
-	p_file->store_line("\t\t\t\t\tset_variable(var_name, value)");
+	p_file->store_line("\t\t\tvar assign_parts = text.split(\"=\", false, 1)");
+	p_file->store_line("\t\t\tif assign_parts.size() == 2:");
+	p_file->store_line("\t\t\t\tvar var_name = assign_parts[0].strip_edges()");
+	p_file->store_line("\t\t\t\tvar value = assign_parts[1].strip_edges()");
+	p_file->store_line("\t\t\t\tset_variable(var_name, value)");
 	p_file->store_line("\t\t\"signal\":");
 	p_file->store_line("\t\t\tif args.size() > 0:");
 	p_file->store_line("\t\t\t\t# Emit global signal");
 	p_file->store_line("\t\t\t\tvar signal_name = args[0]");
-	p_file->store_line("\t\t\t\tvar signal_args = args.slice(1) if args.size() > 1 else []");
+	p_file->store_line("\t\t\t\tvar signal_args = Array(args.slice(1))");
 	p_file->store_line("\t\t\t\tget_tree().call_group(\"vn_listeners\", \"_on_vn_signal\", signal_name, signal_args)");
 	p_file->store_line("\t\t_:");
 	p_file->store_line("\t\t\t# Other commands handled by external systems");
-	p_file->store_line("\t\t\tcommand_executed.emit(cmd, args)");
+	p_file->store_line("\t\t\tcommand_executed.emit(cmd, Array(args))");
 	p_file->store_line("");
 	p_file->store_line("# Variable management");
 	p_file->store_line("func set_variable(name: String, value):");
@@ -363,6 +178,11 @@ void VisualNovelScriptParserModule::generate_script(Ref<FileAccess> p_file) {
 	p_file->store_line("\tif base_path.is_empty():");
 	p_file->store_line("\t\treturn \"\"");
 	p_file->store_line("\t");
+	p_file->store_line("\t# Indexed images resolve without touching the file system");
+	p_file->store_line("\tvar indexed_path = asset_streamer.find_asset(asset_type, asset_name)");
+	p_file->store_line("\tif not indexed_path.is_empty():");
+	p_file->store_line("\t\treturn indexed_path");
+	p_file->store_line("\t");
 	p_file->store_line("\t# Common extensions by type");
 	p_file->store_line("\tvar extensions = []");
 	p_file->store_line("\tmatch asset_type:");
@@ -7,6 +7,8 @@ void WorldState3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("# WorldState3D.gd");
 		p_file->store_line("# Generated by Lupine Engine - 3D World State Manager");
 		p_file->store_line("# Manages persistent world variables and state");
+		p_file->store_line("# Variables and flags live in the native WorldState singleton, which compiles");
+		p_file->store_line("# conditions and journals every change for save systems and UI");
 		p_file->store_line("");
 		p_file->store_line("extends Node");
 		p_file->store_line("");
@@ -16,141 +18,91 @@ void WorldState3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("signal puzzle_completed(puzzle_id: String)");
 		p_file->store_line("signal trigger_activated(trigger_id: String)");
 		p_file->store_line("");
-		p_file->store_line("# World state data");
-		p_file->store_line("var world_variables: Dictionary = {}");
-		p_file->store_line("var discovered_locations: Array[String] = []");
-		p_file->store_line("var completed_puzzles: Array[String] = []");
-		p_file->store_line("var activated_triggers: Array[String] = []");
-		p_file->store_line("var collected_items: Array[String] = []");
-		p_file->store_line("");
 		p_file->store_line("# Current world state");
 		p_file->store_line("var current_location: String = \"\"");
 		p_file->store_line("var player_spawn_point: String = \"default\"");
 		p_file->store_line("");
 		p_file->store_line("func _ready():");
+		p_file->store_line("\tWorldState.variable_changed.connect(_on_world_state_variable_changed)");
 		p_file->store_line("\t_initialize_default_variables()");
 		p_file->store_line("");
+		p_file->store_line("func _on_world_state_variable_changed(var_name: StringName, old_value, new_value):");
+		p_file->store_line("\tworld_variable_changed.emit(String(var_name), old_value, new_value)");
+		p_file->store_line("");
 		p_file->store_line("func set_variable(var_name: String, value):");
-		p_file->store_line("\tvar old_value = world_variables.get(var_name, null)");
-		p_file->store_line("\tworld_variables[var_name] = value");
-		p_file->store_line("\tworld_variable_changed.emit(var_name, old_value, value)");
+		p_file->store_line("\tWorldState.set_variable(var_name, value)");
 		p_file->store_line("");
 		p_file->store_line("func get_variable(var_name: String, default_value = null):");
-		p_file->store_line("\treturn world_variables.get(var_name, default_value)");
+		p_file->store_line("\treturn WorldState.get_variable(var_name, default_value)");
 		p_file->store_line("");
 		p_file->store_line("func has_variable(var_name: String) -> bool:");
-		p_file->store_line("\treturn world_variables.has(var_name)");
+		p_file->store_line("\treturn WorldState.has_variable(var_name)");
 		p_file->store_line("");
 		p_file->store_line("func increment_variable(var_name: String, amount: float = 1.0):");
-		p_file->store_line("\tvar current_value = get_variable(var_name, 0.0)");
-		p_file->store_line("\tset_variable(var_name, current_value + amount)");
+		p_file->store_line("\tWorldState.increment_variable(var_name, amount)");
 		p_file->store_line("");
 		p_file->store_line("func discover_location(location_name: String):");
-		p_file->store_line("\tif not discovered_locations.has(location_name):");
-		p_file->store_line("\t\tdiscovered_locations.append(location_name)");
+		p_file->store_line("\tif WorldState.set_flag(WorldState.FLAG_LOCATION_DISCOVERED, location_name):");
 		p_file->store_line("\t\tlocation_discovered.emit(location_name)");
 		p_file->store_line("\t\tif PopupManager:");
 		p_file->store_line("\t\t\tPopupManager.show_notification(\"Location Discovered\", location_name)");
 		p_file->store_line("");
 		p_file->store_line("func is_location_discovered(location_name: String) -> bool:");
-		p_file->store_line("\treturn discovered_locations.has(location_name)");
+		p_file->store_line("\treturn WorldState.has_flag(WorldState.FLAG_LOCATION_DISCOVERED, location_name)");
 		p_file->store_line("");
 		p_file->store_line("func complete_puzzle(puzzle_id: String):");
-		p_file->store_line("\tif not completed_puzzles.has(puzzle_id):");
-		p_file->store_line("\t\tcompleted_puzzles.append(puzzle_id)");
+		p_file->store_line("\tif WorldState.set_flag(WorldState.FLAG_PUZZLE_COMPLETED, puzzle_id):");
 		p_file->store_line("\t\tpuzzle_completed.emit(puzzle_id)");
 		p_file->store_line("\t\tif PopupManager:");
 		p_file->store_line("\t\t\tPopupManager.show_notification(\"Puzzle Solved!\", \"Well done!\")");
 		p_file->store_line("");
 		p_file->store_line("func is_puzzle_completed(puzzle_id: String) -> bool:");
-		p_file->store_line("\treturn completed_puzzles.has(puzzle_id)");
+		p_file->store_line("\treturn WorldState.has_flag(WorldState.FLAG_PUZZLE_COMPLETED, puzzle_id)");
 		p_file->store_line("");
 		p_file->store_line("func activate_trigger(trigger_id: String, persistent: bool = true):");
-		p_file->store_line("\tif persistent and not activated_triggers.has(trigger_id):");
-		p_file->store_line("\t\tactivated_triggers.append(trigger_id)");
+		p_file->store_line("\tif persistent:");
+		p_file->store_line("\t\tWorldState.set_flag(WorldState.FLAG_TRIGGER_ACTIVATED, trigger_id)");
 		p_file->store_line("\ttrigger_activated.emit(trigger_id)");
 		p_file->store_line("");
 		p_file->store_line("func is_trigger_activated(trigger_id: String) -> bool:");
-		p_file->store_line("\treturn activated_triggers.has(trigger_id)");
+		p_file->store_line("\treturn WorldState.has_flag(WorldState.FLAG_TRIGGER_ACTIVATED, trigger_id)");
 		p_file->store_line("");
 		p_file->store_line("func collect_item(item_id: String):");
-		p_file->store_line("\tif not collected_items.has(item_id):");
-		p_file->store_line("\t\tcollected_items.append(item_id)");
+		p_file->store_line("\tWorldState.set_flag(WorldState.FLAG_ITEM_COLLECTED, item_id)");
 		p_file->store_line("");
 		p_file->store_line("func is_item_collected(item_id: String) -> bool:");
-		p_file->store_line("\treturn collected_items.has(item_id)");
+		p_file->store_line("\treturn WorldState.has_flag(WorldState.FLAG_ITEM_COLLECTED, item_id)");
+		p_file->store_line("");
+		p_file->store_line("# Compile a condition (or an Array of conditions that all have to pass) once,");
+		p_file->store_line("# then check it with is_condition_met()");
+		p_file->store_line("func compile_condition(condition) -> WorldStateCondition:");
+		p_file->store_line("\treturn WorldState.compile_condition(condition)");
+		p_file->store_line("");
+		p_file->store_line("func is_condition_met(compiled: WorldStateCondition) -> bool:");
+		p_file->store_line("\treturn WorldState.evaluate(compiled)");
 		p_file->store_line("");
 		p_file->store_line("func check_condition(condition: Dictionary) -> bool:");
 		p_file->store_line("\t# Check various world state conditions");
-		p_file->store_line("\tmatch condition.type:");
-		p_file->store_line("\t\t\"variable\":");
-		p_file->store_line("\t\t\treturn _check_variable_condition(condition)");
-		p_file->store_line("\t\t\"location\":");
-		p_file->store_line("\t\t\treturn is_location_discovered(condition.location)");
-		p_file->store_line("\t\t\"puzzle\":");
-		p_file->store_line("\t\t\treturn is_puzzle_completed(condition.puzzle_id)");
-		p_file->store_line("\t\t\"trigger\":");
-		p_file->store_line("\t\t\treturn is_trigger_activated(condition.trigger_id)");
-		p_file->store_line("\t\t\"item\":");
-		p_file->store_line("\t\t\treturn is_item_collected(condition.item_id)");
-		p_file->store_line("\t\t\"and\":");
-		p_file->store_line("\t\t\treturn _check_and_condition(condition.conditions)");
-		p_file->store_line("\t\t\"or\":");
-		p_file->store_line("\t\t\treturn _check_or_condition(condition.conditions)");
-		p_file->store_line("\t\t\"not\":");
-		p_file->store_line("\t\t\treturn not check_condition(condition.condition)");
-		p_file->store_line("\treturn false");
-		p_file->store_line("");
-		p_file->store_line("func _check_variable_condition(condition: Dictionary) -> bool:");
-		p_file->store_line("\tvar var_name = condition.variable");
-		p_file->store_line("\tvar operator = condition.get(\"operator\", \"==\")");
-		p_file->store_line("\tvar expected_value = condition.value");
-		p_file->store_line("\tvar current_value = get_variable(var_name)");
-		p_file->store_line("\t");
-		p_file->store_line("\tmatch operator:");
-		p_file->store_line("\t\t\"==\":");
-		p_file->store_line("\t\t\treturn current_value == expected_value");
-		p_file->store_line("\t\t\"!=\":");
-		p_file->store_line("\t\t\treturn current_value != expected_value");
-		p_file->store_line("\t\t\">\":");
-		p_file->store_line("\t\t\treturn current_value > expected_value");
-		p_file->store_line("\t\t\">=\":");
-		p_file->store_line("\t\t\treturn current_value >= expected_value");
-		p_file->store_line("\t\t\"<\":");
-		p_file->store_line("\t\t\treturn current_value < expected_value");
-		p_file->store_line("\t\t\"<=\":");
-		p_file->store_line("\t\t\treturn current_value <= expected_value");
-		p_file->store_line("\treturn false");
-		p_file->store_line("");
-		p_file->store_line("func _check_and_condition(conditions: Array) -> bool:");
-		p_file->store_line("\tfor condition in conditions:");
-		p_file->store_line("\t\tif not check_condition(condition):");
-		p_file->store_line("\t\t\treturn false");
-		p_file->store_line("\treturn true");
-		p_file->store_line("");
-		p_file->store_line("func _check_or_condition(conditions: Array) -> bool:");
-		p_file->store_line("\tfor condition in conditions:");
-		p_file->store_line("\t\tif check_condition(condition):");
-		p_file->store_line("\t\t\treturn true");
-		p_file->store_line("\treturn false");
+		p_file->store_line("\treturn WorldState.check_condition(condition)");
 		p_file->store_line("");
 		p_file->store_line("func get_save_data() -> Dictionary:");
-		p_file->store_line("\treturn {");
-		p_file->store_line("\t\t\"world_variables\": world_variables,");
-		p_file->store_line("\t\t\"discovered_locations\": discovered_locations,");
-		p_file->store_line("\t\t\"completed_puzzles\": completed_puzzles,");
-		p_file->store_line("\t\t\"activated_triggers\": activated_triggers,");
-		p_file->store_line("\t\t\"collected_items\": collected_items,");
-		p_file->store_line("\t\t\"current_location\": current_location,");
-		p_file->store_line("\t\t\"player_spawn_point\": player_spawn_point");
-		p_file->store_line("\t}");
+		p_file->store_line("\tvar data = WorldState.get_state()");
+		p_file->store_line("\tdata[\"current_location\"] = current_location");
+		p_file->store_line("\tdata[\"player_spawn_point\"] = player_spawn_point");
+		p_file->store_line("\treturn data");
 		p_file->store_line("");
 		p_file->store_line("func load_save_data(data: Dictionary):");
-		p_file->store_line("\tworld_variables = data.get(\"world_variables\", {})");
-		p_file->store_line("\tdiscovered_locations = data.get(\"discovered_locations\", [])");
-		p_file->store_line("\tcompleted_puzzles = data.get(\"completed_puzzles\", [])");
-		p_file->store_line("\tactivated_triggers = data.get(\"activated_triggers\", [])");
-		p_file->store_line("\tcollected_items = data.get(\"collected_items\", [])");
+		p_file->store_line("\tif data.has(\"world_variables\"):");
+		p_file->store_line("\t\t# Saves from before the native world state");
+		p_file->store_line("\t\tWorldState.set_state({");
+		p_file->store_line("\t\t\t\"variables\": data.get(\"world_variables\", {}),");
+		p_file->store_line("\t\t\t\"location_discovered\": data.get(\"discovered_locations\", []),");
+		p_file->store_line("\t\t\t\"puzzle_completed\": data.get(\"completed_puzzles\", []),");
+		p_file->store_line("\t\t\t\"trigger_activated\": data.get(\"activated_triggers\", []),");
+		p_file->store_line("\t\t\t\"item_collected\": data.get(\"collected_items\", [])");
+		p_file->store_line("\t\t})");
+		p_file->store_line("\telse:");
+		p_file->store_line("\t\tWorldState.set_state(data)");
 		p_file->store_line("\tcurrent_location = data.get(\"current_location\", \"\")");
 		p_file->store_line("\tplayer_spawn_point = data.get(\"player_spawn_point\", \"default\")");
 		p_file->store_line("");
@@ -180,8 +132,12 @@ void WorldState3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("");
 		p_file->store_line("# State");
 		p_file->store_line("var has_triggered: bool = false");
+		p_file->store_line("var compiled_conditions: WorldStateCondition");
 		p_file->store_line("");
 		p_file->store_line("func _ready():");
+		p_file->store_line("\t# Conditions are compiled once instead of being walked on every check");
+		p_file->store_line("\tcompiled_conditions = WorldState.compile_condition(activation_conditions)");
+		p_file->store_line("\t");
 		p_file->store_line("\tbody_entered.connect(_on_body_entered)");
 		p_file->store_line("\tbody_exited.connect(_on_body_exited)");
 		p_file->store_line("\t");
@@ -207,10 +163,7 @@ void WorldState3DModule::generate_script(Ref<FileAccess> p_file) {
 		p_file->store_line("\tpass");
 		p_file->store_line("");
 		p_file->store_line("func _check_conditions() -> bool:");
-		p_file->store_line("\tfor condition in activation_conditions:");
-		p_file->store_line("\t\tif not WorldState3D.check_condition(condition):");
-		p_file->store_line("\t\t\treturn false");
-		p_file->store_line("\treturn true");
+		p_file->store_line("\treturn WorldState.evaluate(compiled_conditions)");
 		p_file->store_line("");
 		p_file->store_line("func _trigger_actions():");
 		p_file->store_line("\thas_triggered = true");
@@ -2110,23 +2110,7 @@ void ProjectDialog::_create_template_project() {
 	_create_template_files(path, selected_template_id);
 
 	// Create module files for selected modules
-	for (const String &module_id : selected_modules) {
-		for (const ProjectModule &mod : available_modules) {
-			if (mod.id == module_id) {
-				for (const String &file_path : mod.files_to_create) {
-					String full_path = path.path_join(file_path);
-					String dir_path = full_path.get_base_dir();
-
-					// Ensure directory exists
-					dir->make_dir_recursive(dir_path);
-
-					// Create specialized file content based on module type
-					_create_module_file(full_path, mod.id, file_path);
-				}
-				break;
-			}
-		}
-	}
+	module_manager->create_module_files(path, selected_modules);
 
 	// Register autoloads for global scripts
 	module_manager->register_autoloads(path, selected_modules);
@@ -2228,11 +2212,6 @@ void ProjectDialog::_create_template_files(const String &p_project_path, const S
 	}
 }
 
-void ProjectDialog::_create_module_file(const String &p_file_path, const String &p_module_id, const String &p_relative_path) {
-	// Use the module manager to create the file
-	module_manager->create_module_file(p_file_path, p_module_id, p_relative_path);
-}
-
 // Old PlayerStats method removed - now handled by module system
 
 void ProjectDialog::_create_2d_topdown_controller(Ref<FileAccess> p_file) {
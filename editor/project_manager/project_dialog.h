@@ -174,7 +174,6 @@ private:
 	void _create_template_project();
 	Vector<String> _get_template_folder_structure(const String &p_template_id);
 	void _create_template_files(const String &p_project_path, const String &p_template_id);
-	void _create_module_file(const String &p_file_path, const String &p_module_id, const String &p_relative_path);
 
 	// Player controller creation helpers
 	void _create_2d_topdown_controller(Ref<FileAccess> p_file);
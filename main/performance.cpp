@@ -31,6 +31,7 @@
 #include "performance.h"
 
 #include "core/os/os.h"
+#include "core/os/small_allocator.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
@@ -129,6 +130,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(OBJECT_STRING_NAME_CONTENTION);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOCATOR_RESERVED);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -209,6 +212,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("object/string_name_contention"),
+		PNAME("memory/small_allocator_reserved"),
 	};
 	static_assert(std::size(names) == MONITOR_MAX);
 
@@ -432,6 +437,14 @@ double Performance::get_monitor(Monitor p_monitor) const {
 		case NAVIGATION_3D_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+		case OBJECT_STRING_NAME_CONTENTION:
+			return StringName::get_contention_count();
+		case MEMORY_SMALL_ALLOCATOR_RESERVED:
+#ifdef SMALL_ALLOCATOR_ENABLED
+			return SmallAllocator::get_reserved_bytes();
+#else
+			return 0;
+#endif
 
 		default: {
 		}
@@ -503,6 +516,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
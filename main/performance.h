@@ -125,6 +125,8 @@ public:
 		NAVIGATION_3D_EDGE_CONNECTION_COUNT,
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
+		OBJECT_STRING_NAME_CONTENTION,
+		MEMORY_SMALL_ALLOCATOR_RESERVED,
 		MONITOR_MAX
 	};
 
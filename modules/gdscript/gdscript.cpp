@@ -748,6 +748,9 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 	reloading = true;
 
+	static const uint32_t memory_tag = Memory::register_tag("GDScript");
+	MemoryTagScope memory_tag_scope(memory_tag);
+
 	bool has_instances;
 	{
 		MutexLock lock(GDScriptLanguage::singleton->mutex);
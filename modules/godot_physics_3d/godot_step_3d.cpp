@@ -40,6 +40,7 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define ISLAND_BATCH_COUNT 4
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,8 +113,8 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
-void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
-	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
+void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, uint32_t p_first_constraint) {
+	GodotConstraint3D *constraint = all_constraints[p_first_constraint + p_constraint_index];
 	constraint->setup(delta);
 }
 
@@ -130,8 +131,8 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
-	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+void GodotStep3D::_solve_island(uint32_t p_island_index, uint32_t p_first_island) {
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_first_island + p_island_index];
 
 	int current_priority = 1;
 
@@ -341,35 +342,59 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
-	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
-
-	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
+	/* SETUP, PRE-SOLVE AND SOLVE CONSTRAINT ISLANDS */
+
+	// Islands are processed in batches, so that setting up the next batches and solving the previous
+	// ones overlap with pre-solving. The constraints of an island are contiguous in `all_constraints`,
+	// in island order, and different islands share no bodies that are written to, except static ones.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	uint32_t batch_count = MIN(island_count, (uint32_t)ISLAND_BATCH_COUNT);
+	uint32_t batch_first_island[ISLAND_BATCH_COUNT + 1];
+	WorkerThreadPool::GroupID setup_tasks[ISLAND_BATCH_COUNT];
+	WorkerThreadPool::GroupID solve_tasks[ISLAND_BATCH_COUNT];
+
+	uint32_t first_constraint = 0;
+	batch_first_island[0] = 0;
+	for (uint32_t batch = 0; batch < batch_count; ++batch) {
+		uint32_t first_island = batch_first_island[batch];
+		uint32_t end_island = (uint64_t)island_count * (batch + 1) / batch_count;
+		uint32_t constraint_count = 0;
+		for (uint32_t island_index = first_island; island_index < end_island; ++island_index) {
+			constraint_count += constraint_islands[island_index].size();
+		}
+		batch_first_island[batch + 1] = end_island;
+		setup_tasks[batch] = pool->add_template_group_task(this, &GodotStep3D::_setup_constraint, first_constraint, constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+		first_constraint += constraint_count;
 	}
+	DEV_ASSERT(first_constraint == all_constraints.size());
+
+	uint64_t setup_wait_time = 0;
+	for (uint32_t batch = 0; batch < batch_count; ++batch) {
+		uint64_t wait_begtime = OS::get_singleton()->get_ticks_usec();
+		pool->wait_for_group_task_completion(setup_tasks[batch]);
+		setup_wait_time += OS::get_singleton()->get_ticks_usec() - wait_begtime;
+
+		// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
+		uint32_t first_island = batch_first_island[batch];
+		uint32_t end_island = batch_first_island[batch + 1];
+		for (uint32_t island_index = first_island; island_index < end_island; ++island_index) {
+			_pre_solve_island(constraint_islands[island_index]);
+		}
 
-	/* PRE-SOLVE CONSTRAINT ISLANDS */
-
-	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+		// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
+		// their content is not reliable after these calls and shouldn't be used anymore.
+		solve_tasks[batch] = pool->add_template_group_task(this, &GodotStep3D::_solve_island, first_island, end_island - first_island, -1, true, SNAME("Physics3DConstraintSolveIslands"));
 	}
 
-	/* SOLVE CONSTRAINT ISLANDS */
-
-	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
-	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	for (uint32_t batch = 0; batch < batch_count; ++batch) {
+		pool->wait_for_group_task_completion(solve_tasks[batch]);
+	}
 
 	{ //profile
+		// The stages overlap, so setup is timed as how long this thread waited for it.
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, setup_wait_time);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime - setup_wait_time);
 		profile_begtime = profile_endtime;
 	}
 
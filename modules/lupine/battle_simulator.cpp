@@ -0,0 +1,818 @@
+/**************************************************************************/
+/*  battle_simulator.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "battle_simulator.h"
+
+#include "core/object/worker_thread_pool.h"
+
+#define ERR_FAIL_NOT_STARTED_V(m_retval) ERR_FAIL_COND_V_MSG(!started, m_retval, "The battle hasn't been started. Call start() first.")
+#define ERR_FAIL_NOT_STARTED() ERR_FAIL_COND_MSG(!started, "The battle hasn't been started. Call start() first.")
+
+int32_t BattleSimulator::_type_index(const StringName &p_type, bool p_create) {
+	if (p_type == StringName()) {
+		return -1;
+	}
+	const int32_t *index = type_indices.getptr(p_type);
+	if (index) {
+		return *index;
+	}
+	if (!p_create) {
+		return -1;
+	}
+	ERR_FAIL_COND_V_MSG(type_names.size() >= MAX_TYPES, -1, vformat("Can't add type '%s', the limit is %d types.", p_type, MAX_TYPES));
+	type_indices.insert(p_type, type_names.size());
+	type_names.push_back(p_type);
+	return type_names.size() - 1;
+}
+
+BattleSimulator::MoveCategory BattleSimulator::_parse_category(const Variant &p_value) {
+	if (p_value.get_type() == Variant::INT) {
+		return MoveCategory(CLAMP(int(p_value), 0, int(CATEGORY_STATUS)));
+	}
+	const String category = p_value;
+	if (category == "special") {
+		return CATEGORY_SPECIAL;
+	} else if (category == "status") {
+		return CATEGORY_STATUS;
+	}
+	return CATEGORY_PHYSICAL;
+}
+
+float BattleSimulator::_get_effectiveness(const Move &p_move, int32_t p_target) const {
+	if (p_move.type < 0) {
+		return 1.0;
+	}
+	float multiplier = 1.0;
+	if (type1s[p_target] >= 0) {
+		multiplier *= type_chart[p_move.type * MAX_TYPES + type1s[p_target]];
+	}
+	if (type2s[p_target] >= 0 && type2s[p_target] != type1s[p_target]) {
+		multiplier *= type_chart[p_move.type * MAX_TYPES + type2s[p_target]];
+	}
+	return multiplier;
+}
+
+int32_t BattleSimulator::_get_speed(const BattleState &p_state, int32_t p_combatant) const {
+	const int32_t status = p_state.status[p_combatant];
+	return status >= 0 ? int32_t(speeds[p_combatant] * effects[status].speed_scale) : speeds[p_combatant];
+}
+
+float BattleSimulator::_score_move(const BattleState &p_state, int32_t p_user, int32_t p_slot, int32_t p_target) const {
+	const Move &move = _get_move(p_user, p_slot);
+	if (move.heal > 0.0) {
+		// On the scale of attacks: restoring half the health scores 100, a
+		// neutral 40 power attack 54, so badly hurt combatants heal first.
+		const float missing = 1.0 - float(p_state.hp[p_target]) / max_hps[p_target];
+		return MIN(move.heal, missing) * 200.0;
+	}
+
+	float score = 0.0;
+	if (move.category == CATEGORY_STATUS) {
+		if (move.effect >= 0 && p_state.status[p_target] < 0) {
+			score = 30.0 * move.effect_chance;
+		}
+	} else {
+		score = move.power * 0.1 + _get_effectiveness(move, p_target) * 50.0;
+		if (move.type >= 0 && (move.type == type1s[p_user] || move.type == type2s[p_user])) {
+			score += 25.0;
+		}
+	}
+	return score * move.accuracy / 100.0;
+}
+
+int32_t BattleSimulator::_choose_target(const BattleState &p_state, int32_t p_user, int32_t p_slot) const {
+	const Move &move = _get_move(p_user, p_slot);
+	if (move.target == TARGET_SELF) {
+		return p_user;
+	}
+
+	const uint8_t enemy_team = 1 - teams[p_user];
+	if (mode == MODE_SINGLES) {
+		return p_state.active[enemy_team];
+	}
+
+	// The enemy the move scores best against, preferring the weakest one.
+	int32_t best = -1;
+	float best_score = 0.0;
+	for (uint32_t i = 0; i < teams.size(); i++) {
+		if (teams[i] != enemy_team || p_state.hp[i] <= 0) {
+			continue;
+		}
+		const float score = _score_move(p_state, p_user, p_slot, i);
+		if (best < 0 || score > best_score || (score == best_score && p_state.hp[i] < p_state.hp[best])) {
+			best = i;
+			best_score = score;
+		}
+	}
+	return best;
+}
+
+int32_t BattleSimulator::_choose_slot(const BattleState &p_state, int32_t p_user) const {
+	// Without a usable move, the combatant struggles (slot -1).
+	int32_t best = -1;
+	float best_score = 0.0;
+	for (int32_t slot = 0; slot < MAX_MOVES; slot++) {
+		if (move_slots[p_user * MAX_MOVES + slot] < 0 || p_state.pp[p_user * MAX_MOVES + slot] <= 0) {
+			continue;
+		}
+		const int32_t target = _choose_target(p_state, p_user, slot);
+		if (target < 0) {
+			continue;
+		}
+		const float score = _score_move(p_state, p_user, slot, target);
+		if (best < 0 || score > best_score) {
+			best = slot;
+			best_score = score;
+		}
+	}
+	return best;
+}
+
+void BattleSimulator::_build_actions(const BattleState &p_state, RandomPCG &p_rng, LocalVector<Action> &r_actions) const {
+	r_actions.clear();
+	for (uint32_t i = 0; i < teams.size(); i++) {
+		if (p_state.hp[i] <= 0 || (mode == MODE_SINGLES && p_state.active[teams[i]] != int32_t(i))) {
+			continue;
+		}
+
+		Action action;
+		action.combatant = i;
+		const int32_t choice = p_state.choices[i];
+		if (choice >= 0 && move_slots[i * MAX_MOVES + choice] >= 0 && p_state.pp[i * MAX_MOVES + choice] > 0) {
+			action.slot = choice;
+		} else {
+			action.slot = _choose_slot(p_state, i);
+		}
+		action.priority = _get_move(i, action.slot).priority;
+		action.speed = _get_speed(p_state, i);
+		action.tiebreak = p_rng.rand();
+		r_actions.push_back(action);
+	}
+	r_actions.sort();
+}
+
+void BattleSimulator::_reset(BattleState &r_state, uint64_t p_seed) const {
+	const uint32_t count = teams.size();
+	r_state.hp.resize(count);
+	r_state.pp.resize(count * MAX_MOVES);
+	r_state.status.resize(count);
+	r_state.status_turns.resize(count);
+	r_state.choices.resize(count);
+	r_state.choice_targets.resize(count);
+	r_state.active[0] = -1;
+	r_state.active[1] = -1;
+
+	for (uint32_t i = 0; i < count; i++) {
+		r_state.hp[i] = max_hps[i];
+		r_state.status[i] = -1;
+		r_state.status_turns[i] = 0;
+		r_state.choices[i] = -1;
+		r_state.choice_targets[i] = -1;
+		for (int32_t slot = 0; slot < MAX_MOVES; slot++) {
+			const int32_t move = move_slots[i * MAX_MOVES + slot];
+			r_state.pp[i * MAX_MOVES + slot] = move >= 0 ? moves[move].pp : 0;
+		}
+		if (mode == MODE_SINGLES && r_state.active[teams[i]] < 0) {
+			r_state.active[teams[i]] = i;
+		}
+	}
+
+	r_state.turn = 0;
+	r_state.winner = -1;
+	r_state.finished = false;
+	r_state.rng = RandomPCG(p_seed);
+	_check_winner(r_state);
+}
+
+void BattleSimulator::_use_move(BattleState &r_state, int32_t p_user, int32_t p_slot, int32_t p_target, Array *r_events) const {
+	const Move &move = _get_move(p_user, p_slot);
+	const int32_t status = r_state.status[p_user];
+	bool skipped = false;
+	bool missed = false;
+	bool critical = false;
+	float effectiveness = 1.0;
+	int32_t damage = 0;
+	int32_t heal = 0;
+	int32_t applied = -1;
+
+	if (status >= 0 && _roll(r_state.rng, effects[status].skip_chance)) {
+		skipped = true;
+	} else {
+		if (p_slot >= 0) {
+			r_state.pp[p_user * MAX_MOVES + p_slot]--;
+		}
+		if (move.accuracy < 100 && int32_t(r_state.rng.rand(100)) >= move.accuracy) {
+			missed = true;
+		} else {
+			if (move.category != CATEGORY_STATUS && move.power > 0) {
+				effectiveness = _get_effectiveness(move, p_target);
+			}
+			if (move.category != CATEGORY_STATUS && move.power > 0 && effectiveness > 0.0) {
+				critical = _roll(r_state.rng, crit_chance);
+				const bool special = move.category == CATEGORY_SPECIAL;
+				int64_t attack = special ? sp_attacks[p_user] : attacks[p_user];
+				if (!special && status >= 0) {
+					attack = int64_t(attack * effects[status].attack_scale);
+				}
+				const int64_t defense = MAX(1, special ? sp_defenses[p_target] : defenses[p_target]);
+
+				float amount;
+				if (damage_formula == DAMAGE_FORMULA_LEVEL_SCALED) {
+					amount = ((2 * levels[p_user] / 5 + 2) * move.power * attack / defense) / 50 + 2;
+					amount *= r_state.rng.random(85, 100) / 100.0f;
+				} else {
+					amount = MAX(int64_t(1), attack * move.power / 100 - defense / 2);
+					amount *= r_state.rng.random(85, 115) / 100.0f;
+				}
+				if (critical) {
+					amount *= crit_multiplier;
+				}
+				if (move.type >= 0 && (move.type == type1s[p_user] || move.type == type2s[p_user])) {
+					amount *= stab_multiplier;
+				}
+				damage = MAX(1, int32_t(amount * effectiveness));
+				r_state.hp[p_target] = MAX(0, r_state.hp[p_target] - damage);
+			}
+
+			if (move.heal > 0.0 && r_state.hp[p_target] > 0) {
+				heal = MIN(int32_t(max_hps[p_target] * move.heal), max_hps[p_target] - r_state.hp[p_target]);
+				r_state.hp[p_target] += heal;
+			}
+
+			if (move.effect >= 0 && r_state.hp[p_target] > 0 && r_state.status[p_target] < 0 && _roll(r_state.rng, move.effect_chance)) {
+				const Effect &effect = effects[move.effect];
+				applied = move.effect;
+				r_state.status[p_target] = move.effect;
+				r_state.status_turns[p_target] = effect.max_turns > 0 ? r_state.rng.random(effect.min_turns, effect.max_turns) : -1;
+			}
+		}
+	}
+
+	if (r_state.hp[p_target] <= 0) {
+		r_state.status[p_target] = -1;
+	}
+
+	if (r_events) {
+		Dictionary event;
+		event["type"] = "move";
+		event["user"] = p_user;
+		event["target"] = p_target;
+		event["slot"] = p_slot;
+		event["move"] = move.name;
+		event["damage"] = damage;
+		event["heal"] = heal;
+		event["effectiveness"] = effectiveness;
+		event["critical"] = critical;
+		event["missed"] = missed;
+		event["skipped"] = skipped;
+		event["effect"] = applied >= 0 ? effects[applied].name : StringName();
+		event["fainted"] = r_state.hp[p_target] <= 0;
+		r_events->push_back(event);
+	}
+}
+
+void BattleSimulator::_replace_fainted(BattleState &r_state, Array *r_events) const {
+	for (int32_t team = 0; team < 2; team++) {
+		const int32_t active = r_state.active[team];
+		if (active >= 0 && r_state.hp[active] > 0) {
+			continue;
+		}
+		r_state.active[team] = -1;
+		for (uint32_t i = 0; i < teams.size(); i++) {
+			if (teams[i] == team && r_state.hp[i] > 0) {
+				r_state.active[team] = i;
+				break;
+			}
+		}
+		if (r_events && r_state.active[team] >= 0) {
+			Dictionary event;
+			event["type"] = "switch";
+			event["team"] = team;
+			event["combatant"] = r_state.active[team];
+			r_events->push_back(event);
+		}
+	}
+}
+
+void BattleSimulator::_check_winner(BattleState &r_state) const {
+	bool alive[2] = { false, false };
+	for (uint32_t i = 0; i < teams.size(); i++) {
+		if (r_state.hp[i] > 0) {
+			alive[teams[i]] = true;
+		}
+	}
+	if (!alive[0] || !alive[1]) {
+		r_state.finished = true;
+		r_state.winner = alive[0] ? 0 : (alive[1] ? 1 : -1);
+	}
+}
+
+void BattleSimulator::_end_turn(BattleState &r_state, Array *r_events) const {
+	for (uint32_t i = 0; i < teams.size(); i++) {
+		const int32_t status = r_state.status[i];
+		if (status < 0 || r_state.hp[i] <= 0 || (mode == MODE_SINGLES && r_state.active[teams[i]] != int32_t(i))) {
+			continue;
+		}
+
+		const Effect &effect = effects[status];
+		int32_t damage = 0;
+		if (effect.damage > 0.0) {
+			damage = MAX(1, int32_t(max_hps[i] * effect.damage));
+			r_state.hp[i] = MAX(0, r_state.hp[i] - damage);
+		}
+		bool cured = false;
+		if (r_state.status_turns[i] > 0 && --r_state.status_turns[i] == 0) {
+			cured = true;
+		}
+		if (cured || r_state.hp[i] <= 0) {
+			r_state.status[i] = -1;
+		}
+
+		if (r_events) {
+			Dictionary event;
+			event["type"] = "status";
+			event["combatant"] = i;
+			event["effect"] = effect.name;
+			event["damage"] = damage;
+			event["cured"] = cured;
+			event["fainted"] = r_state.hp[i] <= 0;
+			r_events->push_back(event);
+		}
+	}
+
+	for (uint32_t i = 0; i < teams.size(); i++) {
+		r_state.choices[i] = -1;
+		r_state.choice_targets[i] = -1;
+	}
+	r_state.turn++;
+
+	if (mode == MODE_SINGLES) {
+		_replace_fainted(r_state, r_events);
+	}
+	_check_winner(r_state);
+	if (!r_state.finished && r_state.turn >= max_turns) {
+		r_state.finished = true;
+		r_state.winner = -1;
+	}
+}
+
+void BattleSimulator::_run_turn(BattleState &r_state, Array *r_events) const {
+	LocalVector<Action> actions;
+	_build_actions(r_state, r_state.rng, actions);
+
+	for (const Action &action : actions) {
+		const int32_t user = action.combatant;
+		if (r_state.hp[user] <= 0) {
+			continue;
+		}
+
+		int32_t target = r_state.choice_targets[user];
+		if (r_state.choices[user] != action.slot || target < 0 || r_state.hp[target] <= 0 || (mode == MODE_SINGLES && target != user && target != r_state.active[1 - teams[user]])) {
+			target = _choose_target(r_state, user, action.slot);
+		}
+		// A target that fainted earlier in the turn makes the move fail.
+		if (target < 0 || r_state.hp[target] <= 0) {
+			continue;
+		}
+		_use_move(r_state, user, action.slot, target, r_events);
+	}
+
+	_end_turn(r_state, r_events);
+}
+
+void BattleSimulator::_simulate_task(uint32_t p_index, SimulationBatch *p_batch) {
+	BattleState state;
+	_reset(state, p_batch->seed + p_index);
+	while (!state.finished) {
+		_run_turn(state, nullptr);
+	}
+	p_batch->winners[p_index] = state.winner;
+	p_batch->turns[p_index] = state.turn;
+}
+
+void BattleSimulator::set_type_effectiveness(const StringName &p_attacking, const StringName &p_defending, float p_multiplier) {
+	ERR_FAIL_COND(p_multiplier < 0.0);
+	const int32_t attacking = _type_index(p_attacking, true);
+	const int32_t defending = _type_index(p_defending, true);
+	ERR_FAIL_COND(attacking < 0 || defending < 0);
+	type_chart[attacking * MAX_TYPES + defending] = p_multiplier;
+}
+
+float BattleSimulator::get_type_effectiveness(const StringName &p_attacking, const StringName &p_defending) const {
+	const int32_t *attacking = type_indices.getptr(p_attacking);
+	const int32_t *defending = type_indices.getptr(p_defending);
+	return attacking && defending ? type_chart[*attacking * MAX_TYPES + *defending] : 1.0;
+}
+
+int BattleSimulator::add_effect(const StringName &p_name, const Dictionary &p_data) {
+	ERR_FAIL_COND_V(p_name == StringName(), -1);
+
+	Effect effect;
+	effect.name = p_name;
+	effect.damage = p_data.get("damage", 0.0);
+	effect.min_turns = MAX(0, int(p_data.get("min_turns", 0)));
+	effect.max_turns = MAX(effect.min_turns, int(p_data.get("max_turns", effect.min_turns)));
+	effect.skip_chance = p_data.get("skip_chance", 0.0);
+	effect.attack_scale = p_data.get("attack_scale", 1.0);
+	effect.speed_scale = p_data.get("speed_scale", 1.0);
+
+	// Redefining an effect keeps its index, so moves using it stay valid.
+	const int32_t *index = effect_indices.getptr(p_name);
+	if (index) {
+		effects[*index] = effect;
+		return *index;
+	}
+	effect_indices.insert(p_name, effects.size());
+	effects.push_back(effect);
+	return effects.size() - 1;
+}
+
+int BattleSimulator::add_move(const StringName &p_name, const Dictionary &p_data) {
+	ERR_FAIL_COND_V(p_name == StringName(), -1);
+
+	Move move;
+	move.name = p_name;
+	move.type = _type_index(p_data.get("type", StringName()), true);
+	move.power = MAX(0, int(p_data.get("power", 0)));
+	move.accuracy = CLAMP(int(p_data.get("accuracy", 100)), 0, 100);
+	move.priority = p_data.get("priority", 0);
+	move.pp = MAX(1, int(p_data.get("pp", 10)));
+	move.category = _parse_category(p_data.get("category", "physical"));
+	const Variant target = p_data.get("target", "enemy");
+	move.target = (target.get_type() == Variant::INT ? int(target) == TARGET_SELF : String(target) == "self") ? TARGET_SELF : TARGET_ENEMY;
+	move.heal = MAX(0.0, float(p_data.get("heal", 0.0)));
+
+	const StringName effect = p_data.get("effect", StringName());
+	if (effect != StringName()) {
+		const int32_t *effect_index = effect_indices.getptr(effect);
+		ERR_FAIL_NULL_V_MSG(effect_index, -1, vformat("Unknown effect '%s' in move '%s'.", effect, p_name));
+		move.effect = *effect_index;
+		move.effect_chance = CLAMP(float(p_data.get("effect_chance", 1.0)), 0.0f, 1.0f);
+	}
+
+	const int32_t *index = move_indices.getptr(p_name);
+	if (index) {
+		moves[*index] = move;
+		return *index;
+	}
+	move_indices.insert(p_name, moves.size());
+	moves.push_back(move);
+	return moves.size() - 1;
+}
+
+int BattleSimulator::add_combatant(int p_team, const Dictionary &p_data) {
+	ERR_FAIL_COND_V_MSG(p_team != 0 && p_team != 1, -1, "The team must be 0 or 1.");
+
+	const Array move_names = p_data.get("moves", Array());
+	ERR_FAIL_COND_V_MSG(move_names.size() > MAX_MOVES, -1, vformat("A combatant can't have more than %d moves.", MAX_MOVES));
+	int32_t slots[MAX_MOVES] = { -1, -1, -1, -1 };
+	for (int i = 0; i < move_names.size(); i++) {
+		const int32_t *index = move_indices.getptr(move_names[i]);
+		ERR_FAIL_NULL_V_MSG(index, -1, vformat("Unknown move '%s'.", move_names[i]));
+		slots[i] = *index;
+	}
+
+	teams.push_back(p_team);
+	levels.push_back(MAX(1, int(p_data.get("level", 1))));
+	max_hps.push_back(MAX(1, int(p_data.get("hp", 100))));
+	attacks.push_back(MAX(0, int(p_data.get("attack", 50))));
+	defenses.push_back(MAX(0, int(p_data.get("defense", 50))));
+	sp_attacks.push_back(MAX(0, int(p_data.get("sp_attack", 50))));
+	sp_defenses.push_back(MAX(0, int(p_data.get("sp_defense", 50))));
+	speeds.push_back(MAX(0, int(p_data.get("speed", 50))));
+	type1s.push_back(_type_index(p_data.get("type1", StringName()), true));
+	type2s.push_back(_type_index(p_data.get("type2", StringName()), true));
+	for (int32_t slot = 0; slot < MAX_MOVES; slot++) {
+		move_slots.push_back(slots[slot]);
+	}
+
+	started = false;
+	return teams.size() - 1;
+}
+
+void BattleSimulator::clear_combatants() {
+	teams.clear();
+	levels.clear();
+	max_hps.clear();
+	attacks.clear();
+	defenses.clear();
+	sp_attacks.clear();
+	sp_defenses.clear();
+	speeds.clear();
+	type1s.clear();
+	type2s.clear();
+	move_slots.clear();
+	started = false;
+}
+
+int BattleSimulator::get_combatant_team(int p_combatant) const {
+	ERR_FAIL_COND_V(!_is_valid_combatant(p_combatant), -1);
+	return teams[p_combatant];
+}
+
+int BattleSimulator::get_combatant_max_hp(int p_combatant) const {
+	ERR_FAIL_COND_V(!_is_valid_combatant(p_combatant), 0);
+	return max_hps[p_combatant];
+}
+
+StringName BattleSimulator::get_combatant_move(int p_combatant, int p_slot) const {
+	ERR_FAIL_COND_V(!_is_valid_combatant(p_combatant), StringName());
+	ERR_FAIL_INDEX_V(p_slot, MAX_MOVES, StringName());
+	const int32_t move = move_slots[p_combatant * MAX_MOVES + p_slot];
+	return move >= 0 ? moves[move].name : StringName();
+}
+
+void BattleSimulator::start(uint64_t p_seed) {
+	_reset(battle, p_seed);
+	started = true;
+}
+
+int BattleSimulator::get_combatant_hp(int p_combatant) const {
+	ERR_FAIL_COND_V(!_is_valid_combatant(p_combatant), 0);
+	return started ? battle.hp[p_combatant] : max_hps[p_combatant];
+}
+
+void BattleSimulator::set_combatant_hp(int p_combatant, int p_hp) {
+	ERR_FAIL_NOT_STARTED();
+	ERR_FAIL_COND(!_is_valid_combatant(p_combatant));
+	battle.hp[p_combatant] = CLAMP(p_hp, 0, max_hps[p_combatant]);
+	if (battle.hp[p_combatant] == 0) {
+		battle.status[p_combatant] = -1;
+	}
+	_check_winner(battle);
+}
+
+StringName BattleSimulator::get_combatant_status(int p_combatant) const {
+	ERR_FAIL_COND_V(!_is_valid_combatant(p_combatant), StringName());
+	return started && battle.status[p_combatant] >= 0 ? effects[battle.status[p_combatant]].name : StringName();
+}
+
+int BattleSimulator::get_move_pp(int p_combatant, int p_slot) const {
+	ERR_FAIL_COND_V(!_is_valid_combatant(p_combatant), 0);
+	ERR_FAIL_INDEX_V(p_slot, MAX_MOVES, 0);
+	if (started) {
+		return battle.pp[p_combatant * MAX_MOVES + p_slot];
+	}
+	const int32_t move = move_slots[p_combatant * MAX_MOVES + p_slot];
+	return move >= 0 ? moves[move].pp : 0;
+}
+
+int BattleSimulator::get_active_combatant(int p_team) const {
+	ERR_FAIL_INDEX_V(p_team, 2, -1);
+	return started ? battle.active[p_team] : -1;
+}
+
+void BattleSimulator::set_active_combatant(int p_team, int p_combatant) {
+	ERR_FAIL_NOT_STARTED();
+	ERR_FAIL_INDEX(p_team, 2);
+	ERR_FAIL_COND_MSG(mode != MODE_SINGLES, "Only singles battles have active combatants.");
+	ERR_FAIL_COND(!_is_valid_combatant(p_combatant));
+	ERR_FAIL_COND_MSG(teams[p_combatant] != p_team, vformat("Combatant %d isn't in team %d.", p_combatant, p_team));
+	ERR_FAIL_COND_MSG(battle.hp[p_combatant] <= 0, vformat("Combatant %d has fainted.", p_combatant));
+	battle.active[p_team] = p_combatant;
+}
+
+void BattleSimulator::set_choice(int p_combatant, int p_slot, int p_target) {
+	ERR_FAIL_NOT_STARTED();
+	ERR_FAIL_COND(!_is_valid_combatant(p_combatant));
+	ERR_FAIL_COND(p_slot < -1 || p_slot >= MAX_MOVES);
+	ERR_FAIL_COND(p_target < -1 || p_target >= int(teams.size()));
+	battle.choices[p_combatant] = p_slot;
+	battle.choice_targets[p_combatant] = p_target;
+}
+
+int BattleSimulator::choose_move(int p_combatant) const {
+	ERR_FAIL_NOT_STARTED_V(-1);
+	ERR_FAIL_COND_V(!_is_valid_combatant(p_combatant), -1);
+	return _choose_slot(battle, p_combatant);
+}
+
+int BattleSimulator::choose_target(int p_combatant, int p_slot) const {
+	ERR_FAIL_NOT_STARTED_V(-1);
+	ERR_FAIL_COND_V(!_is_valid_combatant(p_combatant), -1);
+	ERR_FAIL_COND_V(p_slot < -1 || p_slot >= MAX_MOVES, -1);
+	ERR_FAIL_COND_V(p_slot >= 0 && move_slots[p_combatant * MAX_MOVES + p_slot] < 0, -1);
+	return _choose_target(battle, p_combatant, p_slot);
+}
+
+PackedInt32Array BattleSimulator::get_turn_order() const {
+	ERR_FAIL_NOT_STARTED_V(PackedInt32Array());
+	// Ties are broken with a copy of the battle's generator, so looking at
+	// the order doesn't change the battle.
+	RandomPCG rng = battle.rng;
+	LocalVector<Action> actions;
+	_build_actions(battle, rng, actions);
+
+	PackedInt32Array order;
+	for (const Action &action : actions) {
+		order.push_back(action.combatant);
+	}
+	return order;
+}
+
+Dictionary BattleSimulator::use_move(int p_user, int p_slot, int p_target) {
+	ERR_FAIL_NOT_STARTED_V(Dictionary());
+	ERR_FAIL_COND_V(!_is_valid_combatant(p_user) || !_is_valid_combatant(p_target), Dictionary());
+	ERR_FAIL_COND_V(p_slot < -1 || p_slot >= MAX_MOVES, Dictionary());
+	ERR_FAIL_COND_V_MSG(p_slot >= 0 && move_slots[p_user * MAX_MOVES + p_slot] < 0, Dictionary(), vformat("Combatant %d has no move in slot %d.", p_user, p_slot));
+	ERR_FAIL_COND_V_MSG(battle.hp[p_user] <= 0, Dictionary(), vformat("Combatant %d has fainted.", p_user));
+
+	Array events;
+	_use_move(battle, p_user, p_slot, p_target, &events);
+	_check_winner(battle);
+	return events[0];
+}
+
+Array BattleSimulator::end_turn() {
+	ERR_FAIL_NOT_STARTED_V(Array());
+	Array events;
+	_end_turn(battle, &events);
+	return events;
+}
+
+Array BattleSimulator::step_turn() {
+	ERR_FAIL_NOT_STARTED_V(Array());
+	ERR_FAIL_COND_V_MSG(battle.finished, Array(), "The battle is over.");
+	Array events;
+	_run_turn(battle, &events);
+	return events;
+}
+
+Dictionary BattleSimulator::simulate(uint64_t p_seed) const {
+	BattleState state;
+	_reset(state, p_seed);
+	while (!state.finished) {
+		_run_turn(state, nullptr);
+	}
+
+	PackedInt32Array hp;
+	hp.resize(state.hp.size());
+	for (uint32_t i = 0; i < state.hp.size(); i++) {
+		hp.write[i] = state.hp[i];
+	}
+
+	Dictionary result;
+	result["winner"] = state.winner;
+	result["turns"] = state.turn;
+	result["hp"] = hp;
+	return result;
+}
+
+Dictionary BattleSimulator::simulate_batch(int p_count, uint64_t p_seed) {
+	ERR_FAIL_COND_V(p_count <= 0, Dictionary());
+
+	PackedInt32Array winners;
+	PackedInt32Array turns;
+	winners.resize(p_count);
+	turns.resize(p_count);
+
+	SimulationBatch batch;
+	batch.seed = p_seed;
+	batch.winners = winners.ptrw();
+	batch.turns = turns.ptrw();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BattleSimulator::_simulate_task, &batch, p_count, -1, true, SNAME("BattleSimulatorBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	PackedInt32Array wins = { 0, 0 };
+	int draws = 0;
+	int64_t total_turns = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (winners[i] < 0) {
+			draws++;
+		} else {
+			wins.write[winners[i]]++;
+		}
+		total_turns += turns[i];
+	}
+
+	Dictionary result;
+	result["wins"] = wins;
+	result["draws"] = draws;
+	result["average_turns"] = double(total_turns) / p_count;
+	result["winners"] = winners;
+	result["turns"] = turns;
+	return result;
+}
+
+void BattleSimulator::set_mode(Mode p_mode) {
+	ERR_FAIL_INDEX(p_mode, MODE_PARTY + 1);
+	mode = p_mode;
+	started = false;
+}
+
+#undef ERR_FAIL_NOT_STARTED_V
+#undef ERR_FAIL_NOT_STARTED
+
+void BattleSimulator::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_type_effectiveness", "attacking_type", "defending_type", "multiplier"), &BattleSimulator::set_type_effectiveness);
+	ClassDB::bind_method(D_METHOD("get_type_effectiveness", "attacking_type", "defending_type"), &BattleSimulator::get_type_effectiveness);
+
+	ClassDB::bind_method(D_METHOD("add_effect", "name", "data"), &BattleSimulator::add_effect);
+	ClassDB::bind_method(D_METHOD("has_effect", "name"), &BattleSimulator::has_effect);
+	ClassDB::bind_method(D_METHOD("add_move", "name", "data"), &BattleSimulator::add_move);
+	ClassDB::bind_method(D_METHOD("has_move", "name"), &BattleSimulator::has_move);
+
+	ClassDB::bind_method(D_METHOD("add_combatant", "team", "data"), &BattleSimulator::add_combatant);
+	ClassDB::bind_method(D_METHOD("get_combatant_count"), &BattleSimulator::get_combatant_count);
+	ClassDB::bind_method(D_METHOD("clear_combatants"), &BattleSimulator::clear_combatants);
+	ClassDB::bind_method(D_METHOD("get_combatant_team", "combatant"), &BattleSimulator::get_combatant_team);
+	ClassDB::bind_method(D_METHOD("get_combatant_max_hp", "combatant"), &BattleSimulator::get_combatant_max_hp);
+	ClassDB::bind_method(D_METHOD("get_combatant_move", "combatant", "slot"), &BattleSimulator::get_combatant_move);
+
+	ClassDB::bind_method(D_METHOD("start", "seed"), &BattleSimulator::start);
+	ClassDB::bind_method(D_METHOD("is_started"), &BattleSimulator::is_started);
+	ClassDB::bind_method(D_METHOD("is_finished"), &BattleSimulator::is_finished);
+	ClassDB::bind_method(D_METHOD("get_winner"), &BattleSimulator::get_winner);
+	ClassDB::bind_method(D_METHOD("get_turn"), &BattleSimulator::get_turn);
+
+	ClassDB::bind_method(D_METHOD("get_combatant_hp", "combatant"), &BattleSimulator::get_combatant_hp);
+	ClassDB::bind_method(D_METHOD("set_combatant_hp", "combatant", "hp"), &BattleSimulator::set_combatant_hp);
+	ClassDB::bind_method(D_METHOD("is_combatant_fainted", "combatant"), &BattleSimulator::is_combatant_fainted);
+	ClassDB::bind_method(D_METHOD("get_combatant_status", "combatant"), &BattleSimulator::get_combatant_status);
+	ClassDB::bind_method(D_METHOD("get_move_pp", "combatant", "slot"), &BattleSimulator::get_move_pp);
+	ClassDB::bind_method(D_METHOD("get_active_combatant", "team"), &BattleSimulator::get_active_combatant);
+	ClassDB::bind_method(D_METHOD("set_active_combatant", "team", "combatant"), &BattleSimulator::set_active_combatant);
+
+	ClassDB::bind_method(D_METHOD("set_choice", "combatant", "slot", "target"), &BattleSimulator::set_choice, DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("choose_move", "combatant"), &BattleSimulator::choose_move);
+	ClassDB::bind_method(D_METHOD("choose_target", "combatant", "slot"), &BattleSimulator::choose_target);
+	ClassDB::bind_method(D_METHOD("get_turn_order"), &BattleSimulator::get_turn_order);
+	ClassDB::bind_method(D_METHOD("use_move", "user", "slot", "target"), &BattleSimulator::use_move);
+	ClassDB::bind_method(D_METHOD("end_turn"), &BattleSimulator::end_turn);
+	ClassDB::bind_method(D_METHOD("step_turn"), &BattleSimulator::step_turn);
+
+	ClassDB::bind_method(D_METHOD("simulate", "seed"), &BattleSimulator::simulate);
+	ClassDB::bind_method(D_METHOD("simulate_batch", "count", "seed"), &BattleSimulator::simulate_batch);
+
+	ClassDB::bind_method(D_METHOD("set_mode", "mode"), &BattleSimulator::set_mode);
+	ClassDB::bind_method(D_METHOD("get_mode"), &BattleSimulator::get_mode);
+	ClassDB::bind_method(D_METHOD("set_damage_formula", "formula"), &BattleSimulator::set_damage_formula);
+	ClassDB::bind_method(D_METHOD("get_damage_formula"), &BattleSimulator::get_damage_formula);
+	ClassDB::bind_method(D_METHOD("set_crit_chance", "chance"), &BattleSimulator::set_crit_chance);
+	ClassDB::bind_method(D_METHOD("get_crit_chance"), &BattleSimulator::get_crit_chance);
+	ClassDB::bind_method(D_METHOD("set_crit_multiplier", "multiplier"), &BattleSimulator::set_crit_multiplier);
+	ClassDB::bind_method(D_METHOD("get_crit_multiplier"), &BattleSimulator::get_crit_multiplier);
+	ClassDB::bind_method(D_METHOD("set_stab_multiplier", "multiplier"), &BattleSimulator::set_stab_multiplier);
+	ClassDB::bind_method(D_METHOD("get_stab_multiplier"), &BattleSimulator::get_stab_multiplier);
+	ClassDB::bind_method(D_METHOD("set_max_turns", "turns"), &BattleSimulator::set_max_turns);
+	ClassDB::bind_method(D_METHOD("get_max_turns"), &BattleSimulator::get_max_turns);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "mode", PROPERTY_HINT_ENUM, "Singles,Party"), "set_mode", "get_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "damage_formula", PROPERTY_HINT_ENUM, "Level Scaled,Subtractive"), "set_damage_formula", "get_damage_formula");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "crit_chance", PROPERTY_HINT_RANGE, "0,1,0.001"), "set_crit_chance", "get_crit_chance");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "crit_multiplier", PROPERTY_HINT_RANGE, "0,4,0.01,or_greater"), "set_crit_multiplier", "get_crit_multiplier");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "stab_multiplier", PROPERTY_HINT_RANGE, "0,4,0.01,or_greater"), "set_stab_multiplier", "get_stab_multiplier");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_turns", PROPERTY_HINT_RANGE, "1,1000,1,or_greater"), "set_max_turns", "get_max_turns");
+
+	BIND_ENUM_CONSTANT(MODE_SINGLES);
+	BIND_ENUM_CONSTANT(MODE_PARTY);
+
+	BIND_ENUM_CONSTANT(DAMAGE_FORMULA_LEVEL_SCALED);
+	BIND_ENUM_CONSTANT(DAMAGE_FORMULA_SUBTRACTIVE);
+
+	BIND_ENUM_CONSTANT(CATEGORY_PHYSICAL);
+	BIND_ENUM_CONSTANT(CATEGORY_SPECIAL);
+	BIND_ENUM_CONSTANT(CATEGORY_STATUS);
+
+	BIND_ENUM_CONSTANT(TARGET_ENEMY);
+	BIND_ENUM_CONSTANT(TARGET_SELF);
+
+	BIND_CONSTANT(MAX_MOVES);
+}
+
+BattleSimulator::BattleSimulator() {
+	type_chart.resize(MAX_TYPES * MAX_TYPES);
+	for (float &multiplier : type_chart) {
+		multiplier = 1.0;
+	}
+
+	struggle.name = "struggle";
+	struggle.power = 50;
+	struggle.pp = 1;
+}
@@ -0,0 +1,265 @@
+/**************************************************************************/
+/*  battle_simulator.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "core/math/random_pcg.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Resolves turn-based battles between two teams without any nodes, for
+// balance testing (millions of simulated battles) and for driving the battle
+// scenes of the Pokemon and JRPG templates. Moves, status effects and the
+// type chart are data tables, combatants are stored as parallel arrays, and
+// everything a battle changes lives in a BattleState, so batches of battles
+// run in parallel on the WorkerThreadPool while reading the same tables.
+// All randomness comes from one RandomPCG per battle, and the AI and turn
+// order use no other state, so a seed always replays the same battle.
+class BattleSimulator : public RefCounted {
+	GDCLASS(BattleSimulator, RefCounted);
+
+public:
+	enum Mode {
+		MODE_SINGLES,
+		MODE_PARTY,
+	};
+
+	enum DamageFormula {
+		DAMAGE_FORMULA_LEVEL_SCALED,
+		DAMAGE_FORMULA_SUBTRACTIVE,
+	};
+
+	enum MoveCategory {
+		CATEGORY_PHYSICAL,
+		CATEGORY_SPECIAL,
+		CATEGORY_STATUS,
+	};
+
+	enum MoveTarget {
+		TARGET_ENEMY,
+		TARGET_SELF,
+	};
+
+	static constexpr int MAX_MOVES = 4;
+	static constexpr int MAX_TYPES = 32;
+
+private:
+	struct Move {
+		StringName name;
+		int32_t type = -1;
+		int32_t power = 0;
+		int32_t accuracy = 100;
+		int32_t priority = 0;
+		int32_t pp = 10;
+		MoveCategory category = CATEGORY_PHYSICAL;
+		MoveTarget target = TARGET_ENEMY;
+		int32_t effect = -1;
+		float effect_chance = 0.0;
+		float heal = 0.0;
+	};
+
+	struct Effect {
+		StringName name;
+		float damage = 0.0;
+		int32_t min_turns = 0;
+		int32_t max_turns = 0;
+		float skip_chance = 0.0;
+		float attack_scale = 1.0;
+		float speed_scale = 1.0;
+	};
+
+	struct BattleState {
+		LocalVector<int32_t> hp;
+		LocalVector<int32_t> pp;
+		LocalVector<int32_t> status;
+		LocalVector<int32_t> status_turns;
+		LocalVector<int32_t> choices;
+		LocalVector<int32_t> choice_targets;
+		int32_t active[2] = { -1, -1 };
+		int32_t turn = 0;
+		int32_t winner = -1;
+		bool finished = false;
+		RandomPCG rng;
+	};
+
+	struct Action {
+		int32_t combatant = 0;
+		int32_t slot = -1;
+		int32_t priority = 0;
+		int32_t speed = 0;
+		uint32_t tiebreak = 0;
+
+		bool operator<(const Action &p_other) const {
+			if (priority != p_other.priority) {
+				return priority > p_other.priority;
+			}
+			if (speed != p_other.speed) {
+				return speed > p_other.speed;
+			}
+			if (tiebreak != p_other.tiebreak) {
+				return tiebreak < p_other.tiebreak;
+			}
+			return combatant < p_other.combatant;
+		}
+	};
+
+	struct SimulationBatch {
+		uint64_t seed = 0;
+		int32_t *winners = nullptr;
+		int32_t *turns = nullptr;
+	};
+
+	LocalVector<StringName> type_names;
+	HashMap<StringName, int32_t> type_indices;
+	LocalVector<float> type_chart;
+
+	LocalVector<Move> moves;
+	HashMap<StringName, int32_t> move_indices;
+	LocalVector<Effect> effects;
+	HashMap<StringName, int32_t> effect_indices;
+	Move struggle;
+
+	// Combatant data, indexed by combatant. Moves are MAX_MOVES slots each.
+	LocalVector<uint8_t> teams;
+	LocalVector<int32_t> levels;
+	LocalVector<int32_t> max_hps;
+	LocalVector<int32_t> attacks;
+	LocalVector<int32_t> defenses;
+	LocalVector<int32_t> sp_attacks;
+	LocalVector<int32_t> sp_defenses;
+	LocalVector<int32_t> speeds;
+	LocalVector<int32_t> type1s;
+	LocalVector<int32_t> type2s;
+	LocalVector<int32_t> move_slots;
+
+	BattleState battle;
+	bool started = false;
+
+	Mode mode = MODE_SINGLES;
+	DamageFormula damage_formula = DAMAGE_FORMULA_LEVEL_SCALED;
+	float crit_chance = 1.0 / 24.0;
+	float crit_multiplier = 1.5;
+	float stab_multiplier = 1.5;
+	int max_turns = 200;
+
+	_FORCE_INLINE_ static bool _roll(RandomPCG &p_rng, float p_chance) {
+		return p_chance >= 1.0 || (p_chance > 0.0 && p_rng.randf() < p_chance);
+	}
+
+	int32_t _type_index(const StringName &p_type, bool p_create);
+	static MoveCategory _parse_category(const Variant &p_value);
+
+	_FORCE_INLINE_ const Move &_get_move(int32_t p_combatant, int32_t p_slot) const {
+		return p_slot < 0 ? struggle : moves[move_slots[p_combatant * MAX_MOVES + p_slot]];
+	}
+	_FORCE_INLINE_ bool _is_valid_combatant(int p_combatant) const {
+		return p_combatant >= 0 && p_combatant < int(teams.size());
+	}
+
+	float _get_effectiveness(const Move &p_move, int32_t p_target) const;
+	int32_t _get_speed(const BattleState &p_state, int32_t p_combatant) const;
+	float _score_move(const BattleState &p_state, int32_t p_user, int32_t p_slot, int32_t p_target) const;
+	int32_t _choose_target(const BattleState &p_state, int32_t p_user, int32_t p_slot) const;
+	int32_t _choose_slot(const BattleState &p_state, int32_t p_user) const;
+	void _build_actions(const BattleState &p_state, RandomPCG &p_rng, LocalVector<Action> &r_actions) const;
+
+	void _reset(BattleState &r_state, uint64_t p_seed) const;
+	void _use_move(BattleState &r_state, int32_t p_user, int32_t p_slot, int32_t p_target, Array *r_events) const;
+	void _replace_fainted(BattleState &r_state, Array *r_events) const;
+	void _check_winner(BattleState &r_state) const;
+	void _end_turn(BattleState &r_state, Array *r_events) const;
+	void _run_turn(BattleState &r_state, Array *r_events) const;
+	void _simulate_task(uint32_t p_index, SimulationBatch *p_batch);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_type_effectiveness(const StringName &p_attacking, const StringName &p_defending, float p_multiplier);
+	float get_type_effectiveness(const StringName &p_attacking, const StringName &p_defending) const;
+
+	int add_effect(const StringName &p_name, const Dictionary &p_data);
+	bool has_effect(const StringName &p_name) const { return effect_indices.has(p_name); }
+	int add_move(const StringName &p_name, const Dictionary &p_data);
+	bool has_move(const StringName &p_name) const { return move_indices.has(p_name); }
+
+	int add_combatant(int p_team, const Dictionary &p_data);
+	int get_combatant_count() const { return teams.size(); }
+	void clear_combatants();
+
+	int get_combatant_team(int p_combatant) const;
+	int get_combatant_max_hp(int p_combatant) const;
+	StringName get_combatant_move(int p_combatant, int p_slot) const;
+
+	void start(uint64_t p_seed);
+	bool is_started() const { return started; }
+	bool is_finished() const { return !started || battle.finished; }
+	int get_winner() const { return started ? battle.winner : -1; }
+	int get_turn() const { return started ? battle.turn : 0; }
+
+	int get_combatant_hp(int p_combatant) const;
+	void set_combatant_hp(int p_combatant, int p_hp);
+	bool is_combatant_fainted(int p_combatant) const { return get_combatant_hp(p_combatant) <= 0; }
+	StringName get_combatant_status(int p_combatant) const;
+	int get_move_pp(int p_combatant, int p_slot) const;
+	int get_active_combatant(int p_team) const;
+	void set_active_combatant(int p_team, int p_combatant);
+
+	void set_choice(int p_combatant, int p_slot, int p_target = -1);
+	int choose_move(int p_combatant) const;
+	int choose_target(int p_combatant, int p_slot) const;
+	PackedInt32Array get_turn_order() const;
+	Dictionary use_move(int p_user, int p_slot, int p_target);
+	Array end_turn();
+	Array step_turn();
+
+	Dictionary simulate(uint64_t p_seed) const;
+	Dictionary simulate_batch(int p_count, uint64_t p_seed);
+
+	void set_mode(Mode p_mode);
+	Mode get_mode() const { return mode; }
+	void set_damage_formula(DamageFormula p_formula) { damage_formula = p_formula; }
+	DamageFormula get_damage_formula() const { return damage_formula; }
+	void set_crit_chance(float p_chance) { crit_chance = CLAMP(p_chance, 0.0, 1.0); }
+	float get_crit_chance() const { return crit_chance; }
+	void set_crit_multiplier(float p_multiplier) { crit_multiplier = MAX(0.0, p_multiplier); }
+	float get_crit_multiplier() const { return crit_multiplier; }
+	void set_stab_multiplier(float p_multiplier) { stab_multiplier = MAX(0.0, p_multiplier); }
+	float get_stab_multiplier() const { return stab_multiplier; }
+	void set_max_turns(int p_turns) { max_turns = MAX(1, p_turns); }
+	int get_max_turns() const { return max_turns; }
+
+	BattleSimulator();
+};
+
+VARIANT_ENUM_CAST(BattleSimulator::Mode);
+VARIANT_ENUM_CAST(BattleSimulator::DamageFormula);
+VARIANT_ENUM_CAST(BattleSimulator::MoveCategory);
+VARIANT_ENUM_CAST(BattleSimulator::MoveTarget);
@@ -0,0 +1,590 @@
+/**************************************************************************/
+/*  collectible_field.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "collectible_field.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "scene/main/scene_tree.h"
+#include "servers/rendering_server.h"
+
+template <typename F>
+void CollectibleField::_query_radius(const Vector2 &p_center, real_t p_radius, F &&p_func) const {
+	const real_t radius_squared = p_radius * p_radius;
+	const Vector2i from = _cell_of(p_center - Vector2(p_radius, p_radius));
+	const Vector2i to = _cell_of(p_center + Vector2(p_radius, p_radius));
+
+	// Radii spanning more cells than there are collectibles are cheaper to
+	// answer by checking every collectible.
+	if (int64_t(to.x - from.x + 1) * (to.y - from.y + 1) > int64_t(positions.size())) {
+		for (uint32_t i = 0; i < positions.size(); i++) {
+			if (collect_times[i] < 0.0 && positions[i].distance_squared_to(p_center) <= radius_squared) {
+				p_func(collectible_ids[i]);
+			}
+		}
+		return;
+	}
+
+	for (int32_t y = from.y; y <= to.y; y++) {
+		for (int32_t x = from.x; x <= to.x; x++) {
+			const LocalVector<int32_t> *cell = cells.getptr(_cell_key(x, y));
+			if (!cell) {
+				continue;
+			}
+			for (const int32_t id : *cell) {
+				if (positions[id_indices[id]].distance_squared_to(p_center) <= radius_squared) {
+					p_func(id);
+				}
+			}
+		}
+	}
+}
+
+void CollectibleField::_cell_insert(int32_t p_id, const Vector2 &p_position) {
+	const Vector2i cell = _cell_of(p_position);
+	const uint64_t key = _cell_key(cell.x, cell.y);
+	LocalVector<int32_t> *ids = cells.getptr(key);
+	if (ids) {
+		ids->push_back(p_id);
+	} else {
+		LocalVector<int32_t> new_ids;
+		new_ids.push_back(p_id);
+		cells.insert(key, new_ids);
+	}
+}
+
+void CollectibleField::_cell_remove(int32_t p_id, const Vector2 &p_position) {
+	const Vector2i cell = _cell_of(p_position);
+	const uint64_t key = _cell_key(cell.x, cell.y);
+	LocalVector<int32_t> *ids = cells.getptr(key);
+	ERR_FAIL_NULL(ids);
+	ids->erase(p_id);
+	if (ids->is_empty()) {
+		cells.erase(key);
+	}
+}
+
+void CollectibleField::_rebuild_cells() {
+	cells.clear();
+	for (uint32_t i = 0; i < positions.size(); i++) {
+		if (collect_times[i] < 0.0) {
+			_cell_insert(collectible_ids[i], positions[i]);
+		}
+	}
+}
+
+void CollectibleField::_update_mesh() {
+	const Vector2 half = instance_size * 0.5;
+	Vector<Vector2> vertices = {
+		-half,
+		Vector2(half.x, -half.y),
+		half,
+		Vector2(-half.x, half.y)
+	};
+	Vector<Vector2> uvs = {
+		Vector2(0, 0),
+		Vector2(1, 0),
+		Vector2(1, 1),
+		Vector2(0, 1)
+	};
+	Vector<int> indices = { 0, 1, 2, 2, 3, 0 };
+
+	Array arr;
+	arr.resize(RS::ARRAY_MAX);
+	arr[RS::ARRAY_VERTEX] = vertices;
+	arr[RS::ARRAY_TEX_UV] = uvs;
+	arr[RS::ARRAY_INDEX] = indices;
+
+	RS::get_singleton()->mesh_clear(mesh);
+	RS::get_singleton()->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arr);
+}
+
+void CollectibleField::_update_bounds() {
+	// A custom AABB keeps the renderer from recomputing the bounds of every
+	// instance on each buffer upload. It covers the bob and the collect
+	// animation, and only grows until the field is cleared.
+	const real_t margin = instance_size.length() * 0.5 * (1.0 + COLLECT_GROWTH) + Math::abs(bob_height);
+	const Rect2 rect = bounds.grow(margin);
+	RS::get_singleton()->multimesh_set_custom_aabb(multimesh, AABB(Vector3(rect.position.x, rect.position.y, 0), Vector3(rect.size.x, rect.size.y, 0)));
+}
+
+void CollectibleField::_reserve(uint32_t p_count) {
+	if (p_count <= capacity) {
+		return;
+	}
+
+	// Reallocating discards the instance data, so the whole buffer is
+	// uploaded again on the next step or draw.
+	capacity = MAX(64u, next_power_of_2(p_count));
+	RS::get_singleton()->multimesh_allocate_data(multimesh, capacity, RS::MULTIMESH_TRANSFORM_2D, true);
+	buffer.resize(capacity * INSTANCE_STRIDE);
+	_update_bounds();
+	buffer_dirty = true;
+	queue_redraw();
+}
+
+void CollectibleField::_write_instance(uint32_t p_index, float *p_dest) const {
+	const real_t angle = Math::deg_to_rad(spin_speed) * time;
+	real_t scale = 1.0;
+	real_t alpha = color.a;
+	if (collect_times[p_index] >= 0.0) {
+		const real_t t = collect_duration > 0.0 ? MIN((time - collect_times[p_index]) / collect_duration, 1.0) : 1.0;
+		scale += COLLECT_GROWTH * t;
+		alpha *= 1.0 - t;
+	}
+	const real_t c = Math::cos(angle) * scale;
+	const real_t s = Math::sin(angle) * scale;
+	const Vector2 &position = positions[p_index];
+	const real_t bob = Math::sin(time * bob_speed + phases[p_index]) * bob_height;
+
+	p_dest[0] = c;
+	p_dest[1] = -s;
+	p_dest[2] = 0.0;
+	p_dest[3] = position.x;
+	p_dest[4] = s;
+	p_dest[5] = c;
+	p_dest[6] = 0.0;
+	p_dest[7] = position.y + bob;
+	p_dest[8] = color.r;
+	p_dest[9] = color.g;
+	p_dest[10] = color.b;
+	p_dest[11] = alpha;
+}
+
+void CollectibleField::_write_batch(uint32_t p_batch, float *p_dest) {
+	const uint32_t from = p_batch * BATCH_SIZE;
+	const uint32_t to = MIN(from + BATCH_SIZE, collectible_ids.size());
+	for (uint32_t i = from; i < to; i++) {
+		_write_instance(i, p_dest + i * INSTANCE_STRIDE);
+	}
+}
+
+void CollectibleField::_update_instance(uint32_t p_index) {
+	// A full upload pending anyway rewrites this slot with everything else.
+	if (buffer_dirty) {
+		return;
+	}
+	if (_is_animated()) {
+		// Every slot changes with the animation, so leave it to a full
+		// upload. Requested here in case the field isn't stepping.
+		buffer_dirty = true;
+		queue_redraw();
+		return;
+	}
+
+	float *dest = buffer.ptrw() + p_index * INSTANCE_STRIDE;
+	_write_instance(p_index, dest);
+
+	Transform2D xform;
+	xform.columns[0] = Vector2(dest[0], dest[4]);
+	xform.columns[1] = Vector2(dest[1], dest[5]);
+	xform.columns[2] = Vector2(dest[3], dest[7]);
+	RS::get_singleton()->multimesh_instance_set_transform_2d(multimesh, p_index, xform);
+	RS::get_singleton()->multimesh_instance_set_color(multimesh, p_index, Color(dest[8], dest[9], dest[10], dest[11]));
+}
+
+void CollectibleField::_upload() {
+	buffer_dirty = false;
+	if (collectible_ids.is_empty()) {
+		return;
+	}
+
+	float *dest = buffer.ptrw();
+	const uint32_t batches = (collectible_ids.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+	if (batches > 1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CollectibleField::_write_batch, dest, batches, -1, true, SNAME("CollectibleFieldUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		_write_batch(0, dest);
+	}
+	RS::get_singleton()->multimesh_set_buffer(multimesh, buffer);
+}
+
+void CollectibleField::_remove_index(uint32_t p_index) {
+	const int32_t id = collectible_ids[p_index];
+	if (collect_times[p_index] < 0.0) {
+		_cell_remove(id, positions[p_index]);
+	} else {
+		collecting_count--;
+	}
+
+	// Keep the arrays packed by moving the last collectible into the hole;
+	// only that one instance slot has to be rewritten.
+	positions.remove_at_unordered(p_index);
+	phases.remove_at_unordered(p_index);
+	values.remove_at_unordered(p_index);
+	collect_times.remove_at_unordered(p_index);
+	collectible_ids.remove_at_unordered(p_index);
+	if (p_index < collectible_ids.size()) {
+		id_indices[collectible_ids[p_index]] = p_index;
+		_update_instance(p_index);
+	}
+
+	id_indices[id] = -1;
+	free_ids.push_back(id);
+	RS::get_singleton()->multimesh_set_visible_instances(multimesh, collectible_ids.size());
+}
+
+void CollectibleField::_gather_targets() {
+	step_targets.clear();
+	target_positions.clear();
+
+	// Targets are tested in the field's local space, where the collectibles
+	// are stored.
+	const Transform2D to_local = get_global_transform().affine_inverse();
+	for (uint32_t i = 0; i < targets.size(); i++) {
+		Node2D *target = ObjectDB::get_instance<Node2D>(targets[i]);
+		if (!target) {
+			targets.remove_at_unordered(i--);
+			continue;
+		}
+		step_targets.push_back(targets[i]);
+		target_positions.push_back(to_local.xform(target->get_global_position()));
+	}
+
+	if (target_group != StringName() && is_inside_tree()) {
+		List<Node *> group_nodes;
+		get_tree()->get_nodes_in_group(target_group, &group_nodes);
+		for (Node *node : group_nodes) {
+			Node2D *target = Object::cast_to<Node2D>(node);
+			if (target && !targets.has(target->get_instance_id())) {
+				step_targets.push_back(target->get_instance_id());
+				target_positions.push_back(to_local.xform(target->get_global_position()));
+			}
+		}
+	}
+}
+
+void CollectibleField::step(double p_delta) {
+	time += p_delta;
+
+	if (auto_collect && !cells.is_empty()) {
+		_gather_targets();
+		for (uint32_t t = 0; t < step_targets.size(); t++) {
+			found.clear();
+			_query_radius(target_positions[t], pickup_radius, [&](int32_t p_id) {
+				found.push_back(p_id);
+			});
+			// Collecting emits a signal, so the hash can't be walked while
+			// handlers run.
+			for (const int32_t id : found) {
+				if (has_collectible(id)) {
+					collect(id, ObjectDB::get_instance<Node2D>(step_targets[t]));
+				}
+			}
+		}
+	}
+
+	if (collecting_count > 0) {
+		// Walk backwards so the collectible swapped into a removed slot has
+		// already been visited.
+		for (int64_t i = int64_t(collectible_ids.size()) - 1; i >= 0; i--) {
+			if (collect_times[i] >= 0.0 && time - collect_times[i] >= collect_duration) {
+				_remove_index(i);
+			}
+		}
+	}
+
+	if (buffer_dirty || _is_animated()) {
+		_upload();
+	}
+}
+
+int CollectibleField::add_collectible(const Vector2 &p_position, int p_value) {
+	int32_t id;
+	if (free_ids.is_empty()) {
+		id = id_indices.size();
+		id_indices.push_back(-1);
+	} else {
+		id = free_ids[free_ids.size() - 1];
+		free_ids.remove_at(free_ids.size() - 1);
+	}
+	const uint32_t index = collectible_ids.size();
+	id_indices[id] = index;
+	collectible_ids.push_back(id);
+
+	positions.push_back(p_position);
+	// Derived from the position, so a field looks the same on every run.
+	phases.push_back((HashMapHasherDefault::hash(p_position) & 0xFFFF) / 65536.0 * Math::TAU);
+	values.push_back(p_value);
+	collect_times.push_back(-1.0);
+	_cell_insert(id, p_position);
+
+	if (index == 0 || !bounds.has_point(p_position)) {
+		bounds = index == 0 ? Rect2(p_position, Size2()) : bounds.expand(p_position);
+		_update_bounds();
+	}
+	_reserve(index + 1);
+	RS::get_singleton()->multimesh_set_visible_instances(multimesh, collectible_ids.size());
+	_update_instance(index);
+	return id;
+}
+
+void CollectibleField::remove_collectible(int p_id) {
+	const int32_t index = _index_of(p_id);
+	ERR_FAIL_COND_MSG(index < 0, vformat("Collectible %d doesn't exist.", p_id));
+	_remove_index(index);
+}
+
+bool CollectibleField::has_collectible(int p_id) const {
+	const int32_t index = _index_of(p_id);
+	return index >= 0 && collect_times[index] < 0.0;
+}
+
+void CollectibleField::clear_collectibles() {
+	positions.clear();
+	phases.clear();
+	values.clear();
+	collect_times.clear();
+	collectible_ids.clear();
+	id_indices.clear();
+	free_ids.clear();
+	cells.clear();
+	collecting_count = 0;
+	bounds = Rect2();
+	RS::get_singleton()->multimesh_set_visible_instances(multimesh, 0);
+}
+
+Vector2 CollectibleField::get_collectible_position(int p_id) const {
+	const int32_t index = _index_of(p_id);
+	ERR_FAIL_COND_V_MSG(index < 0, Vector2(), vformat("Collectible %d doesn't exist.", p_id));
+	return positions[index];
+}
+
+void CollectibleField::set_collectible_position(int p_id, const Vector2 &p_position) {
+	const int32_t index = _index_of(p_id);
+	ERR_FAIL_COND_MSG(index < 0, vformat("Collectible %d doesn't exist.", p_id));
+	if (collect_times[index] < 0.0) {
+		_cell_remove(p_id, positions[index]);
+		_cell_insert(p_id, p_position);
+	}
+	positions[index] = p_position;
+	if (!bounds.has_point(p_position)) {
+		bounds = bounds.expand(p_position);
+		_update_bounds();
+	}
+	_update_instance(index);
+}
+
+int CollectibleField::get_collectible_value(int p_id) const {
+	const int32_t index = _index_of(p_id);
+	ERR_FAIL_COND_V_MSG(index < 0, 0, vformat("Collectible %d doesn't exist.", p_id));
+	return values[index];
+}
+
+void CollectibleField::set_collectible_value(int p_id, int p_value) {
+	const int32_t index = _index_of(p_id);
+	ERR_FAIL_COND_MSG(index < 0, vformat("Collectible %d doesn't exist.", p_id));
+	values[index] = p_value;
+}
+
+bool CollectibleField::collect(int p_id, Node2D *p_collector) {
+	const int32_t index = _index_of(p_id);
+	ERR_FAIL_COND_V_MSG(index < 0, false, vformat("Collectible %d doesn't exist.", p_id));
+	if (collect_times[index] >= 0.0) {
+		return false;
+	}
+
+	const Vector2 position = positions[index];
+	const int value = values[index];
+	if (collect_duration > 0.0) {
+		// Stays drawn while the collect animation plays, and is removed by
+		// the step that finishes it.
+		_cell_remove(p_id, position);
+		collect_times[index] = time;
+		collecting_count++;
+	} else {
+		_remove_index(index);
+	}
+
+	emit_signal(SNAME("collected"), p_collector, p_id, value, position);
+	return true;
+}
+
+PackedInt32Array CollectibleField::get_collectibles_in_radius(const Vector2 &p_position, real_t p_radius) const {
+	PackedInt32Array ids;
+	_query_radius(p_position, p_radius, [&](int32_t p_id) {
+		ids.push_back(p_id);
+	});
+	return ids;
+}
+
+void CollectibleField::add_target(Node2D *p_target) {
+	ERR_FAIL_NULL(p_target);
+	if (!targets.has(p_target->get_instance_id())) {
+		targets.push_back(p_target->get_instance_id());
+	}
+}
+
+void CollectibleField::remove_target(Node2D *p_target) {
+	ERR_FAIL_NULL(p_target);
+	targets.erase(p_target->get_instance_id());
+}
+
+void CollectibleField::clear_targets() {
+	targets.clear();
+}
+
+void CollectibleField::set_active(bool p_active) {
+	active = p_active;
+	if (is_inside_tree()) {
+		set_process_internal(active);
+	}
+}
+
+void CollectibleField::set_texture(const Ref<Texture2D> &p_texture) {
+	texture = p_texture;
+	queue_redraw();
+}
+
+void CollectibleField::set_instance_size(const Size2 &p_size) {
+	instance_size = p_size;
+	_update_mesh();
+	_update_bounds();
+}
+
+void CollectibleField::set_color(const Color &p_color) {
+	color = p_color;
+	buffer_dirty = true;
+	queue_redraw();
+}
+
+void CollectibleField::set_cell_size(real_t p_size) {
+	ERR_FAIL_COND(p_size <= 0.0);
+	cell_size = p_size;
+	_rebuild_cells();
+}
+
+void CollectibleField::set_bob_height(real_t p_height) {
+	bob_height = p_height;
+	buffer_dirty = true;
+	_update_bounds();
+	queue_redraw();
+}
+
+void CollectibleField::set_spin_speed(real_t p_speed) {
+	spin_speed = p_speed;
+	buffer_dirty = true;
+	queue_redraw();
+}
+
+void CollectibleField::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_READY: {
+			set_process_internal(active);
+		} break;
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			step(get_process_delta_time());
+		} break;
+		case NOTIFICATION_DRAW: {
+			if (buffer_dirty) {
+				_upload();
+			}
+			RS::get_singleton()->canvas_item_add_multimesh(get_canvas_item(), multimesh, texture.is_valid() ? texture->get_rid() : RID());
+		} break;
+	}
+}
+
+void CollectibleField::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_collectible", "position", "value"), &CollectibleField::add_collectible, DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("remove_collectible", "id"), &CollectibleField::remove_collectible);
+	ClassDB::bind_method(D_METHOD("has_collectible", "id"), &CollectibleField::has_collectible);
+	ClassDB::bind_method(D_METHOD("get_collectible_count"), &CollectibleField::get_collectible_count);
+	ClassDB::bind_method(D_METHOD("clear_collectibles"), &CollectibleField::clear_collectibles);
+
+	ClassDB::bind_method(D_METHOD("get_collectible_position", "id"), &CollectibleField::get_collectible_position);
+	ClassDB::bind_method(D_METHOD("set_collectible_position", "id", "position"), &CollectibleField::set_collectible_position);
+	ClassDB::bind_method(D_METHOD("get_collectible_value", "id"), &CollectibleField::get_collectible_value);
+	ClassDB::bind_method(D_METHOD("set_collectible_value", "id", "value"), &CollectibleField::set_collectible_value);
+
+	ClassDB::bind_method(D_METHOD("collect", "id", "collector"), &CollectibleField::collect, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("get_collectibles_in_radius", "position", "radius"), &CollectibleField::get_collectibles_in_radius);
+
+	ClassDB::bind_method(D_METHOD("add_target", "target"), &CollectibleField::add_target);
+	ClassDB::bind_method(D_METHOD("remove_target", "target"), &CollectibleField::remove_target);
+	ClassDB::bind_method(D_METHOD("clear_targets"), &CollectibleField::clear_targets);
+
+	ClassDB::bind_method(D_METHOD("step", "delta"), &CollectibleField::step);
+
+	ClassDB::bind_method(D_METHOD("set_active", "active"), &CollectibleField::set_active);
+	ClassDB::bind_method(D_METHOD("is_active"), &CollectibleField::is_active);
+	ClassDB::bind_method(D_METHOD("set_texture", "texture"), &CollectibleField::set_texture);
+	ClassDB::bind_method(D_METHOD("get_texture"), &CollectibleField::get_texture);
+	ClassDB::bind_method(D_METHOD("set_instance_size", "size"), &CollectibleField::set_instance_size);
+	ClassDB::bind_method(D_METHOD("get_instance_size"), &CollectibleField::get_instance_size);
+	ClassDB::bind_method(D_METHOD("set_color", "color"), &CollectibleField::set_color);
+	ClassDB::bind_method(D_METHOD("get_color"), &CollectibleField::get_color);
+	ClassDB::bind_method(D_METHOD("set_collectible_type", "type"), &CollectibleField::set_collectible_type);
+	ClassDB::bind_method(D_METHOD("get_collectible_type"), &CollectibleField::get_collectible_type);
+	ClassDB::bind_method(D_METHOD("set_target_group", "group"), &CollectibleField::set_target_group);
+	ClassDB::bind_method(D_METHOD("get_target_group"), &CollectibleField::get_target_group);
+	ClassDB::bind_method(D_METHOD("set_pickup_radius", "radius"), &CollectibleField::set_pickup_radius);
+	ClassDB::bind_method(D_METHOD("get_pickup_radius"), &CollectibleField::get_pickup_radius);
+	ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &CollectibleField::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &CollectibleField::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_bob_height", "height"), &CollectibleField::set_bob_height);
+	ClassDB::bind_method(D_METHOD("get_bob_height"), &CollectibleField::get_bob_height);
+	ClassDB::bind_method(D_METHOD("set_bob_speed", "speed"), &CollectibleField::set_bob_speed);
+	ClassDB::bind_method(D_METHOD("get_bob_speed"), &CollectibleField::get_bob_speed);
+	ClassDB::bind_method(D_METHOD("set_spin_speed", "speed"), &CollectibleField::set_spin_speed);
+	ClassDB::bind_method(D_METHOD("get_spin_speed"), &CollectibleField::get_spin_speed);
+	ClassDB::bind_method(D_METHOD("set_collect_duration", "duration"), &CollectibleField::set_collect_duration);
+	ClassDB::bind_method(D_METHOD("get_collect_duration"), &CollectibleField::get_collect_duration);
+	ClassDB::bind_method(D_METHOD("set_auto_collect", "enabled"), &CollectibleField::set_auto_collect);
+	ClassDB::bind_method(D_METHOD("is_auto_collect_enabled"), &CollectibleField::is_auto_collect_enabled);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "is_active");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "texture", PROPERTY_HINT_RESOURCE_TYPE, "Texture2D"), "set_texture", "get_texture");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "instance_size", PROPERTY_HINT_NONE, "suffix:px"), "set_instance_size", "get_instance_size");
+	ADD_PROPERTY(PropertyInfo(Variant::COLOR, "color"), "set_color", "get_color");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "collectible_type"), "set_collectible_type", "get_collectible_type");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "target_group"), "set_target_group", "get_target_group");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "pickup_radius", PROPERTY_HINT_RANGE, "0,256,0.1,or_greater,suffix:px"), "set_pickup_radius", "get_pickup_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size", PROPERTY_HINT_RANGE, "1,1024,1,or_greater,suffix:px"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bob_height", PROPERTY_HINT_RANGE, "0,64,0.1,or_greater,suffix:px"), "set_bob_height", "get_bob_height");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bob_speed", PROPERTY_HINT_RANGE, "0,20,0.01,or_greater"), "set_bob_speed", "get_bob_speed");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "spin_speed", PROPERTY_HINT_RANGE, "-720,720,0.1,or_less,or_greater,suffix:°/s"), "set_spin_speed", "get_spin_speed");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "collect_duration", PROPERTY_HINT_RANGE, "0,2,0.01,or_greater,suffix:s"), "set_collect_duration", "get_collect_duration");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_collect"), "set_auto_collect", "is_auto_collect_enabled");
+
+	ADD_SIGNAL(MethodInfo("collected", PropertyInfo(Variant::OBJECT, "collector", PROPERTY_HINT_RESOURCE_TYPE, "Node2D"), PropertyInfo(Variant::INT, "id"), PropertyInfo(Variant::INT, "value"), PropertyInfo(Variant::VECTOR2, "position")));
+}
+
+CollectibleField::CollectibleField() {
+	target_group = "player";
+	mesh = RS::get_singleton()->mesh_create();
+	multimesh = RS::get_singleton()->multimesh_create();
+	RS::get_singleton()->multimesh_set_mesh(multimesh, mesh);
+	_update_mesh();
+}
+
+CollectibleField::~CollectibleField() {
+	ERR_FAIL_NULL(RenderingServer::get_singleton());
+	RS::get_singleton()->free(multimesh);
+	RS::get_singleton()->free(mesh);
+}
@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  collectible_field.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/2d/node_2d.h"
+#include "scene/resources/texture.h"
+
+// Draws and collects many identical pickups (coins, gems) from one node
+// instead of one scene with a script and an Area2D per pickup. Collectibles
+// live in dense parallel arrays and are drawn as a single MultiMesh; the
+// per-frame bob and spin is written into the instance buffer in one pass and
+// uploaded at once. Pickups are found by querying a spatial hash around each
+// target (usually the player), and a collected instance is swapped with the
+// last one, so only the moved slot is rewritten.
+class CollectibleField : public Node2D {
+	GDCLASS(CollectibleField, Node2D);
+
+	static constexpr uint32_t BATCH_SIZE = 1024;
+	static constexpr uint32_t INSTANCE_STRIDE = 12; // Transform2D (8) and color (4).
+	static constexpr real_t COLLECT_GROWTH = 0.5;
+
+	// Collectible data, indexed by dense index.
+	LocalVector<Vector2> positions;
+	LocalVector<float> phases;
+	LocalVector<int32_t> values;
+	LocalVector<double> collect_times; // Negative until collected.
+
+	// Stable IDs map to dense indices and back.
+	LocalVector<int32_t> collectible_ids;
+	LocalVector<int32_t> id_indices;
+	LocalVector<int32_t> free_ids;
+
+	// Collectible IDs by cell. Collectibles don't move, so the hash is kept
+	// up to date incrementally instead of being rebuilt.
+	AHashMap<uint64_t, LocalVector<int32_t>> cells;
+
+	LocalVector<ObjectID> targets;
+	LocalVector<ObjectID> step_targets;
+	LocalVector<Vector2> target_positions;
+	LocalVector<int32_t> found;
+
+	RID mesh;
+	RID multimesh;
+	uint32_t capacity = 0;
+	Vector<float> buffer;
+	bool buffer_dirty = false;
+	Rect2 bounds;
+	uint32_t collecting_count = 0;
+	double time = 0.0;
+
+	bool active = true;
+	Ref<Texture2D> texture;
+	Size2 instance_size = Size2(24, 24);
+	Color color = Color(1, 1, 1);
+	StringName collectible_type = "coin";
+	StringName target_group;
+	real_t pickup_radius = 16.0;
+	real_t cell_size = 64.0;
+	real_t bob_height = 10.0;
+	real_t bob_speed = 2.0;
+	real_t spin_speed = 90.0;
+	real_t collect_duration = 0.2;
+	bool auto_collect = true;
+
+	_FORCE_INLINE_ uint64_t _cell_key(int32_t p_x, int32_t p_y) const {
+		return (uint64_t(uint32_t(p_x)) << 32) | uint32_t(p_y);
+	}
+	_FORCE_INLINE_ Vector2i _cell_of(const Vector2 &p_position) const {
+		return Vector2i(Math::floor(p_position.x / cell_size), Math::floor(p_position.y / cell_size));
+	}
+	_FORCE_INLINE_ int32_t _index_of(int p_id) const {
+		return p_id >= 0 && p_id < int(id_indices.size()) ? id_indices[p_id] : -1;
+	}
+	_FORCE_INLINE_ bool _is_animated() const {
+		return bob_height != 0.0 || spin_speed != 0.0 || collecting_count > 0;
+	}
+
+	template <typename F>
+	void _query_radius(const Vector2 &p_center, real_t p_radius, F &&p_func) const;
+
+	void _cell_insert(int32_t p_id, const Vector2 &p_position);
+	void _cell_remove(int32_t p_id, const Vector2 &p_position);
+	void _rebuild_cells();
+	void _update_mesh();
+	void _update_bounds();
+	void _reserve(uint32_t p_count);
+	void _write_instance(uint32_t p_index, float *p_dest) const;
+	void _write_batch(uint32_t p_batch, float *p_dest);
+	void _update_instance(uint32_t p_index);
+	void _upload();
+	void _remove_index(uint32_t p_index);
+	void _gather_targets();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	int add_collectible(const Vector2 &p_position, int p_value = 1);
+	void remove_collectible(int p_id);
+	bool has_collectible(int p_id) const;
+	int get_collectible_count() const { return collectible_ids.size() - collecting_count; }
+	void clear_collectibles();
+
+	Vector2 get_collectible_position(int p_id) const;
+	void set_collectible_position(int p_id, const Vector2 &p_position);
+	int get_collectible_value(int p_id) const;
+	void set_collectible_value(int p_id, int p_value);
+
+	bool collect(int p_id, Node2D *p_collector = nullptr);
+	PackedInt32Array get_collectibles_in_radius(const Vector2 &p_position, real_t p_radius) const;
+
+	void add_target(Node2D *p_target);
+	void remove_target(Node2D *p_target);
+	void clear_targets();
+
+	void step(double p_delta);
+
+	void set_active(bool p_active);
+	bool is_active() const { return active; }
+	void set_texture(const Ref<Texture2D> &p_texture);
+	Ref<Texture2D> get_texture() const { return texture; }
+	void set_instance_size(const Size2 &p_size);
+	Size2 get_instance_size() const { return instance_size; }
+	void set_color(const Color &p_color);
+	Color get_color() const { return color; }
+	void set_collectible_type(const StringName &p_type) { collectible_type = p_type; }
+	StringName get_collectible_type() const { return collectible_type; }
+	void set_target_group(const StringName &p_group) { target_group = p_group; }
+	StringName get_target_group() const { return target_group; }
+	void set_pickup_radius(real_t p_radius) { pickup_radius = MAX(0.0, p_radius); }
+	real_t get_pickup_radius() const { return pickup_radius; }
+	void set_cell_size(real_t p_size);
+	real_t get_cell_size() const { return cell_size; }
+	void set_bob_height(real_t p_height);
+	real_t get_bob_height() const { return bob_height; }
+	void set_bob_speed(real_t p_speed) { bob_speed = p_speed; }
+	real_t get_bob_speed() const { return bob_speed; }
+	void set_spin_speed(real_t p_speed);
+	real_t get_spin_speed() const { return spin_speed; }
+	void set_collect_duration(real_t p_duration) { collect_duration = MAX(0.0, p_duration); }
+	real_t get_collect_duration() const { return collect_duration; }
+	void set_auto_collect(bool p_enabled) { auto_collect = p_enabled; }
+	bool is_auto_collect_enabled() const { return auto_collect; }
+
+	CollectibleField();
+	~CollectibleField();
+};
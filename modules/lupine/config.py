@@ -0,0 +1,33 @@
+def can_build(env, platform):
+    return True
+
+
+def configure(env):
+    pass
+
+
+def get_doc_classes():
+    return [
+        "BattleSimulator",
+        "CollectibleField",
+        "Crowd2D",
+        "DialogueProgram",
+        "DialogueVariables",
+        "EffectScheduler",
+        "HUDDataModel",
+        "InventoryContainer",
+        "QuestRuntime",
+        "RelationshipGraph",
+        "ResourceImporterVNScript",
+        "SaveGameState",
+        "ScreenEffectsCompositor",
+        "TacticalGrid",
+        "VNAssetStreamer",
+        "VNScript",
+        "WorldState",
+        "WorldStateCondition",
+    ]
+
+
+def get_doc_path():
+    return "doc_classes"
@@ -0,0 +1,682 @@
+/**************************************************************************/
+/*  crowd_2d.cpp                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "crowd_2d.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_tree.h"
+
+template <typename F>
+void Crowd2D::_query_radius(const Vector2 &p_center, real_t p_radius, F &&p_func) const {
+	const real_t radius_squared = p_radius * p_radius;
+	const Vector2i from = _cell_of(p_center - Vector2(p_radius, p_radius));
+	const Vector2i to = _cell_of(p_center + Vector2(p_radius, p_radius));
+
+	// Radii spanning more cells than there are agents are cheaper to answer
+	// by checking every agent.
+	if (int64_t(to.x - from.x + 1) * (to.y - from.y + 1) > int64_t(positions.size())) {
+		for (uint32_t i = 0; i < positions.size(); i++) {
+			const real_t distance_squared = positions[i].distance_squared_to(p_center);
+			if (distance_squared <= radius_squared) {
+				p_func(i, distance_squared);
+			}
+		}
+		return;
+	}
+
+	for (int32_t y = from.y; y <= to.y; y++) {
+		for (int32_t x = from.x; x <= to.x; x++) {
+			const CellRange *range = cells.getptr(_cell_key(x, y));
+			if (!range) {
+				continue;
+			}
+			for (uint32_t i = range->start; i < range->start + range->count; i++) {
+				const uint32_t agent = cell_entries[i].agent;
+				const real_t distance_squared = positions[agent].distance_squared_to(p_center);
+				if (distance_squared <= radius_squared) {
+					p_func(agent, distance_squared);
+				}
+			}
+		}
+	}
+}
+
+void Crowd2D::_rebuild_cells() {
+	// Agents sorted by cell key, so each cell is one contiguous range.
+	cell_entries.resize(positions.size());
+	for (uint32_t i = 0; i < positions.size(); i++) {
+		const Vector2i cell = _cell_of(positions[i]);
+		cell_entries[i].key = _cell_key(cell.x, cell.y);
+		cell_entries[i].agent = i;
+	}
+	cell_entries.sort();
+
+	cells.clear();
+	cells_dirty = false;
+	uint32_t start = 0;
+	while (start < cell_entries.size()) {
+		uint32_t end = start + 1;
+		while (end < cell_entries.size() && cell_entries[end].key == cell_entries[start].key) {
+			end++;
+		}
+		cells.insert(cell_entries[start].key, { start, end - start });
+		start = end;
+	}
+}
+
+void Crowd2D::_gather_targets() {
+	step_targets.clear();
+	target_positions.clear();
+
+	for (uint32_t i = 0; i < targets.size(); i++) {
+		Node2D *target = ObjectDB::get_instance<Node2D>(targets[i]);
+		if (!target) {
+			targets.remove_at_unordered(i--);
+			continue;
+		}
+		step_targets.push_back(targets[i]);
+		target_positions.push_back(target->get_global_position());
+	}
+
+	if (target_group != StringName() && is_inside_tree()) {
+		List<Node *> group_nodes;
+		get_tree()->get_nodes_in_group(target_group, &group_nodes);
+		for (Node *node : group_nodes) {
+			Node2D *target = Object::cast_to<Node2D>(node);
+			if (target && !targets.has(target->get_instance_id())) {
+				step_targets.push_back(target->get_instance_id());
+				target_positions.push_back(target->get_global_position());
+			}
+		}
+	}
+}
+
+void Crowd2D::_perceive() {
+	max_perception = 0.0;
+	for (uint32_t i = 0; i < perceived_targets.size(); i++) {
+		perceived_targets[i] = -1;
+		target_distances[i] = INFINITY;
+		max_perception = MAX(max_perception, perception_radii[i]);
+	}
+
+	// Each target visits the agents around it, and every agent keeps the
+	// closest target within its own perception radius.
+	for (uint32_t t = 0; t < target_positions.size(); t++) {
+		_query_radius(target_positions[t], max_perception, [&](uint32_t p_agent, real_t p_distance_squared) {
+			const float distance = Math::sqrt(p_distance_squared);
+			if (distance <= perception_radii[p_agent] && distance < target_distances[p_agent]) {
+				perceived_targets[p_agent] = t;
+				target_distances[p_agent] = distance;
+			}
+		});
+	}
+}
+
+void Crowd2D::_choose_wander_target(uint32_t p_index) {
+	RandomPCG &rng = rngs[p_index];
+	const real_t angle = rng.randf() * Math::TAU;
+	const real_t distance = rng.randf() * wander_radii[p_index];
+	wander_targets[p_index] = homes[p_index] + Vector2(Math::cos(angle), Math::sin(angle)) * distance;
+	wander_timers[p_index] = rng.random(2.0f, 5.0f);
+}
+
+void Crowd2D::_step_agent(uint32_t p_index, float p_delta) {
+	// Reads shared state (positions, targets, the cell hash) and writes only
+	// this agent's entries, so agents can be stepped in any order.
+	const Vector2 position = positions[p_index];
+	const uint8_t old_state = states[p_index];
+	uint8_t state = old_state;
+	Vector2 velocity;
+	Vector2 facing;
+	bool engaged = false;
+
+	const int32_t target = perceived_targets[p_index];
+	if (target >= 0) {
+		const Vector2 target_position = target_positions[target];
+		switch (reactions[p_index]) {
+			case REACTION_NONE: {
+				state = STATE_ALERT;
+				facing = target_position - position;
+				engaged = true;
+			} break;
+			case REACTION_FLEE: {
+				state = STATE_FLEE;
+				velocity = (position - target_position).normalized() * speeds[p_index] * flee_speed_scale;
+				engaged = true;
+			} break;
+			case REACTION_CHASE: {
+				if (leash_radius > 0.0 && homes[p_index].distance_to(target_position) > leash_radius) {
+					break;
+				}
+				engaged = true;
+				if (target_distances[p_index] <= reaches[p_index]) {
+					state = STATE_ATTACK;
+					facing = target_position - position;
+				} else {
+					state = STATE_CHASE;
+					velocity = (target_position - position).normalized() * speeds[p_index];
+				}
+			} break;
+		}
+	}
+
+	if (!engaged) {
+		if (state != STATE_IDLE && state != STATE_WANDER) {
+			state = STATE_RETURN;
+		}
+		if (state == STATE_RETURN) {
+			const Vector2 to_home = homes[p_index] - position;
+			if (to_home.length() <= wander_radii[p_index] + ARRIVE_DISTANCE) {
+				state = STATE_IDLE;
+				wander_timers[p_index] = 0.0;
+			} else {
+				velocity = to_home.normalized() * speeds[p_index];
+			}
+		}
+		if (state != STATE_RETURN) {
+			wander_timers[p_index] -= p_delta;
+			if (wander_timers[p_index] <= 0.0) {
+				_choose_wander_target(p_index);
+			}
+			const Vector2 to_target = wander_targets[p_index] - position;
+			if (to_target.length() > ARRIVE_DISTANCE) {
+				state = STATE_WANDER;
+				velocity = to_target.normalized() * speeds[p_index];
+			} else {
+				state = STATE_IDLE;
+			}
+		}
+	}
+
+	if (separation_radius > 0.0 && speeds[p_index] > 0.0) {
+		Vector2 push;
+		_query_radius(position, separation_radius, [&](uint32_t p_agent, real_t p_distance_squared) {
+			if (p_agent == p_index || p_distance_squared == 0.0) {
+				return;
+			}
+			const real_t distance = Math::sqrt(p_distance_squared);
+			push += (position - positions[p_agent]) / distance * (1.0 - distance / separation_radius);
+		});
+		velocity += push * speeds[p_index];
+	}
+
+	next_positions[p_index] = position + velocity * p_delta;
+	velocities[p_index] = velocity;
+
+	if (facing == Vector2()) {
+		facing = velocity;
+	}
+	uint8_t agent_flags = flags[p_index];
+	const bool was_left = agent_flags & FLAG_FACING_LEFT;
+	const bool left = Math::abs(facing.x) > CMP_EPSILON ? facing.x < 0.0 : was_left;
+	agent_flags = left ? (agent_flags | FLAG_FACING_LEFT) : (agent_flags & ~FLAG_FACING_LEFT);
+	if (state != old_state || left != was_left) {
+		agent_flags |= FLAG_CHANGED;
+	}
+	flags[p_index] = agent_flags;
+	states[p_index] = state;
+}
+
+void Crowd2D::_step_batch(uint32_t p_batch, float p_delta) {
+	const uint32_t end = MIN((p_batch + 1) * BATCH_SIZE, positions.size());
+	for (uint32_t i = p_batch * BATCH_SIZE; i < end; i++) {
+		_step_agent(i, p_delta);
+	}
+}
+
+void Crowd2D::_write_back() {
+	struct Event {
+		int32_t agent = -1;
+		uint8_t state = STATE_IDLE;
+		bool facing_left = false;
+	};
+
+	// Callbacks run last, as they may add or remove agents.
+	LocalVector<int32_t> stale;
+	LocalVector<Event> events;
+	for (uint32_t i = 0; i < positions.size(); i++) {
+		if (nodes[i].is_valid()) {
+			Node2D *node = ObjectDB::get_instance<Node2D>(nodes[i]);
+			if (node) {
+				node->set_global_position(positions[i]);
+			} else {
+				stale.push_back(agent_ids[i]);
+			}
+		}
+		if (flags[i] & FLAG_CHANGED) {
+			flags[i] &= ~FLAG_CHANGED;
+			if (callbacks[i].is_valid()) {
+				events.push_back({ agent_ids[i], states[i], bool(flags[i] & FLAG_FACING_LEFT) });
+			}
+		}
+	}
+
+	for (const int32_t agent : stale) {
+		remove_agent(agent);
+	}
+	for (const Event &event : events) {
+		const int32_t index = _index_of(event.agent);
+		if (index >= 0) {
+			callbacks[index].call(event.state, event.facing_left);
+		}
+	}
+}
+
+void Crowd2D::step(double p_delta) {
+	if (agent_ids.is_empty()) {
+		return;
+	}
+
+	_gather_targets();
+	_rebuild_cells();
+	_perceive();
+
+	const uint32_t batches = (positions.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+	if (batches > 1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Crowd2D::_step_batch, float(p_delta), batches, -1, true, SNAME("Crowd2DStep"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		_step_batch(0, p_delta);
+	}
+	SWAP(positions, next_positions);
+	cells_dirty = true;
+
+	_write_back();
+}
+
+int Crowd2D::add_agent(const Vector2 &p_position, Reaction p_reaction, Node2D *p_node) {
+	ERR_FAIL_INDEX_V(p_reaction, REACTION_CHASE + 1, -1);
+
+	int32_t id;
+	if (free_ids.is_empty()) {
+		id = id_indices.size();
+		id_indices.push_back(-1);
+	} else {
+		id = free_ids[free_ids.size() - 1];
+		free_ids.remove_at(free_ids.size() - 1);
+	}
+	id_indices[id] = agent_ids.size();
+	agent_ids.push_back(id);
+
+	positions.push_back(p_position);
+	next_positions.push_back(p_position);
+	velocities.push_back(Vector2());
+	homes.push_back(p_position);
+	wander_targets.push_back(p_position);
+	wander_timers.push_back(0.0);
+	speeds.push_back(50.0);
+	perception_radii.push_back(100.0);
+	reaches.push_back(24.0);
+	wander_radii.push_back(100.0);
+	target_distances.push_back(INFINITY);
+	perceived_targets.push_back(-1);
+	reactions.push_back(p_reaction);
+	states.push_back(STATE_IDLE);
+	flags.push_back(0);
+	rngs.push_back(RandomPCG(seed, id));
+	nodes.push_back(p_node ? p_node->get_instance_id() : ObjectID());
+	callbacks.push_back(Callable());
+	cells_dirty = true;
+	return id;
+}
+
+void Crowd2D::remove_agent(int p_agent) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_MSG(index < 0, vformat("Agent %d doesn't exist.", p_agent));
+
+	// Keep the arrays packed by moving the last agent into the hole.
+	positions.remove_at_unordered(index);
+	next_positions.remove_at_unordered(index);
+	velocities.remove_at_unordered(index);
+	homes.remove_at_unordered(index);
+	wander_targets.remove_at_unordered(index);
+	wander_timers.remove_at_unordered(index);
+	speeds.remove_at_unordered(index);
+	perception_radii.remove_at_unordered(index);
+	reaches.remove_at_unordered(index);
+	wander_radii.remove_at_unordered(index);
+	target_distances.remove_at_unordered(index);
+	perceived_targets.remove_at_unordered(index);
+	reactions.remove_at_unordered(index);
+	states.remove_at_unordered(index);
+	flags.remove_at_unordered(index);
+	rngs.remove_at_unordered(index);
+	nodes.remove_at_unordered(index);
+	callbacks.remove_at_unordered(index);
+	agent_ids.remove_at_unordered(index);
+	if (uint32_t(index) < agent_ids.size()) {
+		id_indices[agent_ids[index]] = index;
+	}
+
+	id_indices[p_agent] = -1;
+	free_ids.push_back(p_agent);
+	cells_dirty = true;
+}
+
+void Crowd2D::clear_agents() {
+	positions.clear();
+	next_positions.clear();
+	velocities.clear();
+	homes.clear();
+	wander_targets.clear();
+	wander_timers.clear();
+	speeds.clear();
+	perception_radii.clear();
+	reaches.clear();
+	wander_radii.clear();
+	target_distances.clear();
+	perceived_targets.clear();
+	reactions.clear();
+	states.clear();
+	flags.clear();
+	rngs.clear();
+	nodes.clear();
+	callbacks.clear();
+	agent_ids.clear();
+	id_indices.clear();
+	free_ids.clear();
+	cell_entries.clear();
+	cells.clear();
+	cells_dirty = true;
+}
+
+void Crowd2D::set_agent_node(int p_agent, Node2D *p_node) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND(index < 0);
+	nodes[index] = p_node ? p_node->get_instance_id() : ObjectID();
+}
+
+Node2D *Crowd2D::get_agent_node(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, nullptr);
+	return ObjectDB::get_instance<Node2D>(nodes[index]);
+}
+
+void Crowd2D::set_agent_callback(int p_agent, const Callable &p_callback) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND(index < 0);
+	callbacks[index] = p_callback;
+}
+
+Callable Crowd2D::get_agent_callback(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, Callable());
+	return callbacks[index];
+}
+
+void Crowd2D::set_agent_reaction(int p_agent, Reaction p_reaction) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND(index < 0);
+	ERR_FAIL_INDEX(p_reaction, REACTION_CHASE + 1);
+	reactions[index] = p_reaction;
+}
+
+Crowd2D::Reaction Crowd2D::get_agent_reaction(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, REACTION_NONE);
+	return Reaction(reactions[index]);
+}
+
+void Crowd2D::set_agent_position(int p_agent, const Vector2 &p_position) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND(index < 0);
+	positions[index] = p_position;
+	cells_dirty = true;
+}
+
+Vector2 Crowd2D::get_agent_position(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, Vector2());
+	return positions[index];
+}
+
+void Crowd2D::set_agent_home(int p_agent, const Vector2 &p_home) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND(index < 0);
+	homes[index] = p_home;
+	wander_timers[index] = 0.0;
+}
+
+Vector2 Crowd2D::get_agent_home(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, Vector2());
+	return homes[index];
+}
+
+void Crowd2D::set_agent_speed(int p_agent, real_t p_speed) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND(index < 0);
+	speeds[index] = MAX(0.0, p_speed);
+}
+
+real_t Crowd2D::get_agent_speed(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, 0.0);
+	return speeds[index];
+}
+
+void Crowd2D::set_agent_perception_radius(int p_agent, real_t p_radius) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND(index < 0);
+	perception_radii[index] = MAX(0.0, p_radius);
+}
+
+real_t Crowd2D::get_agent_perception_radius(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, 0.0);
+	return perception_radii[index];
+}
+
+void Crowd2D::set_agent_reach(int p_agent, real_t p_reach) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND(index < 0);
+	reaches[index] = MAX(0.0, p_reach);
+}
+
+real_t Crowd2D::get_agent_reach(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, 0.0);
+	return reaches[index];
+}
+
+void Crowd2D::set_agent_wander_radius(int p_agent, real_t p_radius) {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND(index < 0);
+	wander_radii[index] = MAX(0.0, p_radius);
+	wander_timers[index] = 0.0;
+}
+
+real_t Crowd2D::get_agent_wander_radius(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, 0.0);
+	return wander_radii[index];
+}
+
+Vector2 Crowd2D::get_agent_velocity(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, Vector2());
+	return velocities[index];
+}
+
+Crowd2D::State Crowd2D::get_agent_state(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, STATE_IDLE);
+	return State(states[index]);
+}
+
+bool Crowd2D::is_agent_facing_left(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, false);
+	return flags[index] & FLAG_FACING_LEFT;
+}
+
+Node2D *Crowd2D::get_agent_target(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, nullptr);
+	const int32_t target = perceived_targets[index];
+	return target >= 0 && target < int32_t(step_targets.size()) ? ObjectDB::get_instance<Node2D>(step_targets[target]) : nullptr;
+}
+
+real_t Crowd2D::get_agent_target_distance(int p_agent) const {
+	const int32_t index = _index_of(p_agent);
+	ERR_FAIL_COND_V(index < 0, INFINITY);
+	return target_distances[index];
+}
+
+void Crowd2D::add_target(Node2D *p_target) {
+	ERR_FAIL_NULL(p_target);
+	if (!targets.has(p_target->get_instance_id())) {
+		targets.push_back(p_target->get_instance_id());
+	}
+}
+
+void Crowd2D::remove_target(Node2D *p_target) {
+	ERR_FAIL_NULL(p_target);
+	targets.erase(p_target->get_instance_id());
+}
+
+void Crowd2D::clear_targets() {
+	targets.clear();
+}
+
+PackedInt32Array Crowd2D::get_agents_in_radius(const Vector2 &p_position, real_t p_radius) {
+	if (cells_dirty) {
+		_rebuild_cells();
+	}
+	PackedInt32Array agents;
+	_query_radius(p_position, p_radius, [&](uint32_t p_agent, real_t p_distance_squared) {
+		agents.push_back(agent_ids[p_agent]);
+	});
+	return agents;
+}
+
+void Crowd2D::set_active(bool p_active) {
+	active = p_active;
+	if (is_inside_tree()) {
+		set_physics_process_internal(active);
+	}
+}
+
+void Crowd2D::set_cell_size(real_t p_size) {
+	ERR_FAIL_COND(p_size <= 0.0);
+	cell_size = p_size;
+	cells_dirty = true;
+}
+
+void Crowd2D::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_READY: {
+			set_physics_process_internal(active);
+		} break;
+		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
+			step(get_physics_process_delta_time());
+		} break;
+	}
+}
+
+void Crowd2D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_agent", "position", "reaction", "node"), &Crowd2D::add_agent, DEFVAL(REACTION_NONE), DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("remove_agent", "agent"), &Crowd2D::remove_agent);
+	ClassDB::bind_method(D_METHOD("has_agent", "agent"), &Crowd2D::has_agent);
+	ClassDB::bind_method(D_METHOD("get_agent_count"), &Crowd2D::get_agent_count);
+	ClassDB::bind_method(D_METHOD("clear_agents"), &Crowd2D::clear_agents);
+
+	ClassDB::bind_method(D_METHOD("set_agent_node", "agent", "node"), &Crowd2D::set_agent_node);
+	ClassDB::bind_method(D_METHOD("get_agent_node", "agent"), &Crowd2D::get_agent_node);
+	ClassDB::bind_method(D_METHOD("set_agent_callback", "agent", "callback"), &Crowd2D::set_agent_callback);
+	ClassDB::bind_method(D_METHOD("get_agent_callback", "agent"), &Crowd2D::get_agent_callback);
+	ClassDB::bind_method(D_METHOD("set_agent_reaction", "agent", "reaction"), &Crowd2D::set_agent_reaction);
+	ClassDB::bind_method(D_METHOD("get_agent_reaction", "agent"), &Crowd2D::get_agent_reaction);
+	ClassDB::bind_method(D_METHOD("set_agent_position", "agent", "position"), &Crowd2D::set_agent_position);
+	ClassDB::bind_method(D_METHOD("get_agent_position", "agent"), &Crowd2D::get_agent_position);
+	ClassDB::bind_method(D_METHOD("set_agent_home", "agent", "home"), &Crowd2D::set_agent_home);
+	ClassDB::bind_method(D_METHOD("get_agent_home", "agent"), &Crowd2D::get_agent_home);
+	ClassDB::bind_method(D_METHOD("set_agent_speed", "agent", "speed"), &Crowd2D::set_agent_speed);
+	ClassDB::bind_method(D_METHOD("get_agent_speed", "agent"), &Crowd2D::get_agent_speed);
+	ClassDB::bind_method(D_METHOD("set_agent_perception_radius", "agent", "radius"), &Crowd2D::set_agent_perception_radius);
+	ClassDB::bind_method(D_METHOD("get_agent_perception_radius", "agent"), &Crowd2D::get_agent_perception_radius);
+	ClassDB::bind_method(D_METHOD("set_agent_reach", "agent", "reach"), &Crowd2D::set_agent_reach);
+	ClassDB::bind_method(D_METHOD("get_agent_reach", "agent"), &Crowd2D::get_agent_reach);
+	ClassDB::bind_method(D_METHOD("set_agent_wander_radius", "agent", "radius"), &Crowd2D::set_agent_wander_radius);
+	ClassDB::bind_method(D_METHOD("get_agent_wander_radius", "agent"), &Crowd2D::get_agent_wander_radius);
+
+	ClassDB::bind_method(D_METHOD("get_agent_velocity", "agent"), &Crowd2D::get_agent_velocity);
+	ClassDB::bind_method(D_METHOD("get_agent_state", "agent"), &Crowd2D::get_agent_state);
+	ClassDB::bind_method(D_METHOD("is_agent_facing_left", "agent"), &Crowd2D::is_agent_facing_left);
+	ClassDB::bind_method(D_METHOD("get_agent_target", "agent"), &Crowd2D::get_agent_target);
+	ClassDB::bind_method(D_METHOD("get_agent_target_distance", "agent"), &Crowd2D::get_agent_target_distance);
+
+	ClassDB::bind_method(D_METHOD("add_target", "target"), &Crowd2D::add_target);
+	ClassDB::bind_method(D_METHOD("remove_target", "target"), &Crowd2D::remove_target);
+	ClassDB::bind_method(D_METHOD("clear_targets"), &Crowd2D::clear_targets);
+
+	ClassDB::bind_method(D_METHOD("get_agents_in_radius", "position", "radius"), &Crowd2D::get_agents_in_radius);
+	ClassDB::bind_method(D_METHOD("step", "delta"), &Crowd2D::step);
+
+	ClassDB::bind_method(D_METHOD("set_active", "active"), &Crowd2D::set_active);
+	ClassDB::bind_method(D_METHOD("is_active"), &Crowd2D::is_active);
+	ClassDB::bind_method(D_METHOD("set_target_group", "group"), &Crowd2D::set_target_group);
+	ClassDB::bind_method(D_METHOD("get_target_group"), &Crowd2D::get_target_group);
+	ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &Crowd2D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &Crowd2D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_separation_radius", "radius"), &Crowd2D::set_separation_radius);
+	ClassDB::bind_method(D_METHOD("get_separation_radius"), &Crowd2D::get_separation_radius);
+	ClassDB::bind_method(D_METHOD("set_flee_speed_scale", "scale"), &Crowd2D::set_flee_speed_scale);
+	ClassDB::bind_method(D_METHOD("get_flee_speed_scale"), &Crowd2D::get_flee_speed_scale);
+	ClassDB::bind_method(D_METHOD("set_leash_radius", "radius"), &Crowd2D::set_leash_radius);
+	ClassDB::bind_method(D_METHOD("get_leash_radius"), &Crowd2D::get_leash_radius);
+	ClassDB::bind_method(D_METHOD("set_seed", "seed"), &Crowd2D::set_seed);
+	ClassDB::bind_method(D_METHOD("get_seed"), &Crowd2D::get_seed);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "is_active");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "target_group"), "set_target_group", "get_target_group");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size", PROPERTY_HINT_RANGE, "1,1024,1,or_greater,suffix:px"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "separation_radius", PROPERTY_HINT_RANGE, "0,256,0.1,or_greater,suffix:px"), "set_separation_radius", "get_separation_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "flee_speed_scale", PROPERTY_HINT_RANGE, "0,4,0.01,or_greater"), "set_flee_speed_scale", "get_flee_speed_scale");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "leash_radius", PROPERTY_HINT_RANGE, "0,4096,1,or_greater,suffix:px"), "set_leash_radius", "get_leash_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+
+	BIND_ENUM_CONSTANT(REACTION_NONE);
+	BIND_ENUM_CONSTANT(REACTION_FLEE);
+	BIND_ENUM_CONSTANT(REACTION_CHASE);
+
+	BIND_ENUM_CONSTANT(STATE_IDLE);
+	BIND_ENUM_CONSTANT(STATE_WANDER);
+	BIND_ENUM_CONSTANT(STATE_ALERT);
+	BIND_ENUM_CONSTANT(STATE_FLEE);
+	BIND_ENUM_CONSTANT(STATE_CHASE);
+	BIND_ENUM_CONSTANT(STATE_ATTACK);
+	BIND_ENUM_CONSTANT(STATE_RETURN);
+}
+
+Crowd2D::Crowd2D() {
+	target_group = "player";
+}
@@ -0,0 +1,213 @@
+/**************************************************************************/
+/*  crowd_2d.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_pcg.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+
+class Node2D;
+
+// Simulates many simple agents (wandering animals, patrolling enemies) in
+// one place instead of one physics body per agent. Agent data is stored in
+// dense parallel arrays, compacted on removal, and stepped in batches on the
+// WorkerThreadPool. Targets (usually the player) are found through a spatial
+// hash of the agents, rebuilt every step, and the only thing written back to
+// the agents' nodes is their global position.
+class Crowd2D : public Node {
+	GDCLASS(Crowd2D, Node);
+
+public:
+	enum Reaction {
+		REACTION_NONE,
+		REACTION_FLEE,
+		REACTION_CHASE,
+	};
+
+	enum State {
+		STATE_IDLE,
+		STATE_WANDER,
+		STATE_ALERT,
+		STATE_FLEE,
+		STATE_CHASE,
+		STATE_ATTACK,
+		STATE_RETURN,
+	};
+
+private:
+	static constexpr uint32_t BATCH_SIZE = 128;
+	static constexpr real_t ARRIVE_DISTANCE = 10.0;
+
+	enum {
+		FLAG_FACING_LEFT = 1,
+		FLAG_CHANGED = 2,
+	};
+
+	struct CellRange {
+		uint32_t start = 0;
+		uint32_t count = 0;
+	};
+
+	struct CellEntry {
+		uint64_t key = 0;
+		uint32_t agent = 0;
+
+		bool operator<(const CellEntry &p_other) const { return key < p_other.key; }
+	};
+
+	// Agent data, indexed by dense agent index.
+	LocalVector<Vector2> positions;
+	LocalVector<Vector2> next_positions;
+	LocalVector<Vector2> velocities;
+	LocalVector<Vector2> homes;
+	LocalVector<Vector2> wander_targets;
+	LocalVector<float> wander_timers;
+	LocalVector<float> speeds;
+	LocalVector<float> perception_radii;
+	LocalVector<float> reaches;
+	LocalVector<float> wander_radii;
+	LocalVector<float> target_distances;
+	LocalVector<int32_t> perceived_targets;
+	LocalVector<uint8_t> reactions;
+	LocalVector<uint8_t> states;
+	LocalVector<uint8_t> flags;
+	LocalVector<RandomPCG> rngs;
+	LocalVector<ObjectID> nodes;
+	LocalVector<Callable> callbacks;
+
+	// Stable IDs map to dense indices and back.
+	LocalVector<int32_t> agent_ids;
+	LocalVector<int32_t> id_indices;
+	LocalVector<int32_t> free_ids;
+
+	LocalVector<ObjectID> targets;
+	LocalVector<ObjectID> step_targets;
+	LocalVector<Vector2> target_positions;
+
+	LocalVector<CellEntry> cell_entries;
+	AHashMap<uint64_t, CellRange> cells;
+	float max_perception = 0.0;
+	bool cells_dirty = true;
+
+	bool active = true;
+	StringName target_group;
+	real_t cell_size = 64.0;
+	real_t separation_radius = 12.0;
+	real_t flee_speed_scale = 1.5;
+	real_t leash_radius = 400.0;
+	uint64_t seed = 0;
+
+	_FORCE_INLINE_ uint64_t _cell_key(int32_t p_x, int32_t p_y) const {
+		return (uint64_t(uint32_t(p_x)) << 32) | uint32_t(p_y);
+	}
+	_FORCE_INLINE_ Vector2i _cell_of(const Vector2 &p_position) const {
+		return Vector2i(Math::floor(p_position.x / cell_size), Math::floor(p_position.y / cell_size));
+	}
+	_FORCE_INLINE_ int32_t _index_of(int p_agent) const {
+		return p_agent >= 0 && p_agent < int(id_indices.size()) ? id_indices[p_agent] : -1;
+	}
+
+	template <typename F>
+	void _query_radius(const Vector2 &p_center, real_t p_radius, F &&p_func) const;
+
+	void _rebuild_cells();
+	void _gather_targets();
+	void _perceive();
+	void _choose_wander_target(uint32_t p_index);
+	void _step_agent(uint32_t p_index, float p_delta);
+	void _step_batch(uint32_t p_batch, float p_delta);
+	void _write_back();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	int add_agent(const Vector2 &p_position, Reaction p_reaction = REACTION_NONE, Node2D *p_node = nullptr);
+	void remove_agent(int p_agent);
+	bool has_agent(int p_agent) const { return _index_of(p_agent) >= 0; }
+	int get_agent_count() const { return agent_ids.size(); }
+	void clear_agents();
+
+	void set_agent_node(int p_agent, Node2D *p_node);
+	Node2D *get_agent_node(int p_agent) const;
+	void set_agent_callback(int p_agent, const Callable &p_callback);
+	Callable get_agent_callback(int p_agent) const;
+	void set_agent_reaction(int p_agent, Reaction p_reaction);
+	Reaction get_agent_reaction(int p_agent) const;
+	void set_agent_position(int p_agent, const Vector2 &p_position);
+	Vector2 get_agent_position(int p_agent) const;
+	void set_agent_home(int p_agent, const Vector2 &p_home);
+	Vector2 get_agent_home(int p_agent) const;
+	void set_agent_speed(int p_agent, real_t p_speed);
+	real_t get_agent_speed(int p_agent) const;
+	void set_agent_perception_radius(int p_agent, real_t p_radius);
+	real_t get_agent_perception_radius(int p_agent) const;
+	void set_agent_reach(int p_agent, real_t p_reach);
+	real_t get_agent_reach(int p_agent) const;
+	void set_agent_wander_radius(int p_agent, real_t p_radius);
+	real_t get_agent_wander_radius(int p_agent) const;
+
+	Vector2 get_agent_velocity(int p_agent) const;
+	State get_agent_state(int p_agent) const;
+	bool is_agent_facing_left(int p_agent) const;
+	Node2D *get_agent_target(int p_agent) const;
+	real_t get_agent_target_distance(int p_agent) const;
+
+	void add_target(Node2D *p_target);
+	void remove_target(Node2D *p_target);
+	void clear_targets();
+
+	PackedInt32Array get_agents_in_radius(const Vector2 &p_position, real_t p_radius);
+
+	void step(double p_delta);
+
+	void set_active(bool p_active);
+	bool is_active() const { return active; }
+	void set_target_group(const StringName &p_group) { target_group = p_group; }
+	StringName get_target_group() const { return target_group; }
+	void set_cell_size(real_t p_size);
+	real_t get_cell_size() const { return cell_size; }
+	void set_separation_radius(real_t p_radius) { separation_radius = MAX(0.0, p_radius); }
+	real_t get_separation_radius() const { return separation_radius; }
+	void set_flee_speed_scale(real_t p_scale) { flee_speed_scale = MAX(0.0, p_scale); }
+	real_t get_flee_speed_scale() const { return flee_speed_scale; }
+	void set_leash_radius(real_t p_radius) { leash_radius = MAX(0.0, p_radius); }
+	real_t get_leash_radius() const { return leash_radius; }
+	void set_seed(uint64_t p_seed) { seed = p_seed; }
+	uint64_t get_seed() const { return seed; }
+
+	Crowd2D();
+};
+
+VARIANT_ENUM_CAST(Crowd2D::Reaction);
+VARIANT_ENUM_CAST(Crowd2D::State);
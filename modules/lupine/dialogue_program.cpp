@@ -0,0 +1,851 @@
+/**************************************************************************/
+/*  dialogue_program.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "dialogue_program.h"
+
+#include "core/io/marshalls.h"
+
+uint32_t DialogueVariables::get_slot(const StringName &p_name) {
+	const uint32_t *slot = slots.getptr(p_name);
+	if (slot) {
+		return *slot;
+	}
+	const uint32_t new_slot = values.size();
+	slots.insert_new(p_name, new_slot);
+	names.push_back(p_name);
+	values.push_back(Variant());
+	return new_slot;
+}
+
+const uint32_t *DialogueVariables::_get_program_slots(uint64_t p_compile_id, const LocalVector<StringName> &p_names) {
+	LocalVector<uint32_t> *program = program_slots.getptr(p_compile_id);
+	if (program) {
+		return program->ptr();
+	}
+	LocalVector<uint32_t> new_slots;
+	new_slots.resize(p_names.size());
+	for (uint32_t i = 0; i < p_names.size(); i++) {
+		new_slots[i] = get_slot(p_names[i]);
+	}
+	return program_slots.insert(p_compile_id, new_slots)->value.ptr();
+}
+
+void DialogueVariables::set_value(const StringName &p_name, const Variant &p_value) {
+	values[get_slot(p_name)] = p_value;
+}
+
+Variant DialogueVariables::get_value(const StringName &p_name, const Variant &p_default) const {
+	const uint32_t *slot = slots.getptr(p_name);
+	if (!slot || values[*slot].get_type() == Variant::NIL) {
+		return p_default;
+	}
+	return values[*slot];
+}
+
+bool DialogueVariables::has_value(const StringName &p_name) const {
+	const uint32_t *slot = slots.getptr(p_name);
+	return slot && values[*slot].get_type() != Variant::NIL;
+}
+
+PackedStringArray DialogueVariables::get_names() const {
+	PackedStringArray result;
+	for (uint32_t i = 0; i < names.size(); i++) {
+		if (values[i].get_type() != Variant::NIL) {
+			result.push_back(names[i]);
+		}
+	}
+	return result;
+}
+
+void DialogueVariables::clear() {
+	// Slots stay assigned, as programs may have resolved names to them.
+	for (Variant &value : values) {
+		value = Variant();
+	}
+}
+
+void DialogueVariables::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_value", "name", "value"), &DialogueVariables::set_value);
+	ClassDB::bind_method(D_METHOD("get_value", "name", "default"), &DialogueVariables::get_value, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("has_value", "name"), &DialogueVariables::has_value);
+	ClassDB::bind_method(D_METHOD("get_names"), &DialogueVariables::get_names);
+	ClassDB::bind_method(D_METHOD("clear"), &DialogueVariables::clear);
+}
+
+static const int MAX_CONDITION_DEPTH = 64;
+static const char *DIALOGUE_PROGRAM_MAGIC = "DLGP";
+static const int LINE_FIELDS = 7;
+static const int CHOICE_FIELDS = 3;
+
+static SafeNumeric<uint64_t> last_compile_id;
+
+void DialogueProgram::_clear() {
+	names.clear();
+	strings.clear();
+	constants.clear();
+	lines.clear();
+	choices.clear();
+	code.clear();
+	variable_names.clear();
+	line_ids.clear();
+	string_lookup.clear();
+	compile_id = last_compile_id.increment();
+	error_string = String();
+}
+
+Error DialogueProgram::_set_error(const String &p_error) {
+	error_string = p_error;
+	return ERR_PARSE_ERROR;
+}
+
+uint32_t DialogueProgram::_add_name(const StringName &p_name) {
+	for (uint32_t i = 0; i < names.size(); i++) {
+		if (names[i] == p_name) {
+			return i;
+		}
+	}
+	names.push_back(p_name);
+	variable_names.push_back(p_name);
+	return names.size() - 1;
+}
+
+uint32_t DialogueProgram::_add_string(const String &p_string) {
+	// Speakers and short replies repeat a lot, so each text is stored once.
+	const uint32_t *index = string_lookup.getptr(p_string);
+	if (index) {
+		return *index;
+	}
+	strings.push_back(p_string);
+	string_lookup.insert(p_string, strings.size() - 1);
+	return strings.size() - 1;
+}
+
+uint32_t DialogueProgram::_add_constant(const Variant &p_constant) {
+	constants.push_back(p_constant);
+	return constants.size() - 1;
+}
+
+Error DialogueProgram::_compile_condition(const Variant &p_condition, int p_depth) {
+	if (p_depth > MAX_CONDITION_DEPTH) {
+		return _set_error("Condition is nested too deeply.");
+	}
+	if (p_condition.get_type() != Variant::DICTIONARY) {
+		return _set_error(vformat("Invalid condition: %s.", p_condition));
+	}
+
+	const Dictionary condition = p_condition;
+	const String type = condition.get("type", String());
+
+	if (type == "and" || type == "or") {
+		const Array children = condition.get("conditions", Array());
+		if (children.is_empty()) {
+			code.push_back(OP_TRUE);
+			return OK;
+		}
+		LocalVector<uint32_t> patches;
+		for (int i = 0; i < children.size(); i++) {
+			Error err = _compile_condition(children[i], p_depth + 1);
+			if (err != OK) {
+				return err;
+			}
+			if (i < children.size() - 1) {
+				// The accumulator already holds the result when short-circuiting.
+				code.push_back(type == "and" ? OP_JUMP_IF_FALSE : OP_JUMP_IF_TRUE);
+				patches.push_back(code.size());
+				code.push_back(0);
+			}
+		}
+		for (uint32_t patch : patches) {
+			code[patch] = code.size();
+		}
+		return OK;
+	}
+
+	if (type == "not") {
+		Error err = _compile_condition(condition.get("condition", Variant()), p_depth + 1);
+		if (err != OK) {
+			return err;
+		}
+		code.push_back(OP_NOT);
+		return OK;
+	}
+
+	StringName variable;
+	Variant::Operator op = Variant::OP_EQUAL;
+	Variant value;
+
+	if (type == "variable") {
+		static const char *operators[] = { "==", "!=", "<", "<=", ">", ">=" };
+		static const Variant::Operator variant_operators[] = { Variant::OP_EQUAL, Variant::OP_NOT_EQUAL, Variant::OP_LESS, Variant::OP_LESS_EQUAL, Variant::OP_GREATER, Variant::OP_GREATER_EQUAL };
+
+		variable = condition.get("variable", String());
+		if (variable.is_empty()) {
+			return _set_error("Variable condition has no \"variable\".");
+		}
+		if (!condition.has("value")) {
+			code.push_back(OP_TEST);
+			code.push_back(_add_name(variable));
+			return OK;
+		}
+		const String op_string = condition.get("operator", "==");
+		int op_index = 0;
+		while (op_index < 6 && op_string != operators[op_index]) {
+			op_index++;
+		}
+		if (op_index == 6) {
+			return _set_error(vformat("Unknown condition operator \"%s\".", op_string));
+		}
+		op = variant_operators[op_index];
+		value = condition["value"];
+	} else if (type == "quest_completed") {
+		code.push_back(OP_TEST);
+		code.push_back(_add_name("quest_completed:" + String(condition.get("quest_id", String()))));
+		return OK;
+	} else if (type == "has_item") {
+		variable = "item_count:" + String(condition.get("item_id", String()));
+		op = Variant::OP_GREATER_EQUAL;
+		value = condition.get("quantity", 1);
+	} else if (type == "player_level") {
+		variable = "level";
+		op = Variant::OP_GREATER_EQUAL;
+		value = condition.get("level", 0);
+	} else {
+		// Unknown conditions don't block the line, as in the interpreted version.
+		code.push_back(OP_TRUE);
+		return OK;
+	}
+
+	code.push_back(OP_COMPARE);
+	code.push_back(_add_name(variable));
+	code.push_back(op);
+	code.push_back(_add_constant(value));
+	return OK;
+}
+
+Error DialogueProgram::_compile_action(const Variant &p_action) {
+	if (p_action.get_type() == Variant::ARRAY) {
+		const Array actions = p_action;
+		for (const Variant &action : actions) {
+			Error err = _compile_action(action);
+			if (err != OK) {
+				return err;
+			}
+		}
+		return OK;
+	}
+	if (p_action.get_type() != Variant::DICTIONARY) {
+		return _set_error(vformat("Invalid action: %s.", p_action));
+	}
+
+	const Dictionary action = p_action;
+	const String type = action.get("type", String());
+	if (type == "set_variable" || type == "add_variable") {
+		const String variable = action.get("variable", String());
+		if (variable.is_empty()) {
+			return _set_error(vformat("Action \"%s\" has no \"variable\".", type));
+		}
+		code.push_back(type == "set_variable" ? OP_SET : OP_ADD);
+		code.push_back(_add_name(variable));
+		code.push_back(_add_constant(type == "set_variable" ? action.get("value", Variant()) : action.get("amount", 1)));
+		return OK;
+	}
+	if (type.is_empty()) {
+		return _set_error("Action has no \"type\".");
+	}
+
+	// Everything else is handed to the game, with the type already interned.
+	code.push_back(OP_CALL);
+	code.push_back(_add_constant(StringName(type)));
+	code.push_back(_add_constant(action.duplicate(true)));
+	return OK;
+}
+
+int32_t DialogueProgram::_compile_text(const String &p_text) {
+	const int32_t offset = code.size();
+	const int length = p_text.length();
+	int literal_from = 0;
+	int pos = 0;
+	while (pos < length) {
+		if (p_text[pos] != '{') {
+			pos++;
+			continue;
+		}
+		const int close = p_text.find_char('}', pos + 1);
+		if (close == -1) {
+			break;
+		}
+		const String name = p_text.substr(pos + 1, close - pos - 1);
+		if (name.is_empty() || name.contains_char('{') || name.contains_char('\n')) {
+			pos++;
+			continue;
+		}
+		if (pos > literal_from) {
+			code.push_back(OP_TEXT);
+			code.push_back(_add_string(p_text.substr(literal_from, pos - literal_from)));
+		}
+		code.push_back(OP_VARIABLE);
+		code.push_back(_add_name(name));
+		pos = close + 1;
+		literal_from = pos;
+	}
+	if (literal_from < length || code.size() == (uint32_t)offset) {
+		code.push_back(OP_TEXT);
+		code.push_back(_add_string(p_text.substr(literal_from)));
+	}
+	code.push_back(OP_END);
+	return offset;
+}
+
+Error DialogueProgram::_resolve_line(const Variant &p_target, int32_t p_default, int32_t &r_line) {
+	switch (p_target.get_type()) {
+		case Variant::NIL: {
+			r_line = p_default;
+		} break;
+		case Variant::INT:
+		case Variant::FLOAT: {
+			// JSON numbers are floats.
+			const int64_t line = p_target;
+			if (line != LINE_END && (line < 0 || line >= (int64_t)lines.size())) {
+				return _set_error(vformat("Line index %d is out of range.", line));
+			}
+			r_line = line;
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			const int32_t *line = line_ids.getptr(p_target);
+			if (!line) {
+				return _set_error(vformat("Unknown line id \"%s\".", p_target));
+			}
+			r_line = *line;
+		} break;
+		default: {
+			return _set_error(vformat("Invalid line reference: %s.", p_target));
+		}
+	}
+	return OK;
+}
+
+void DialogueProgram::_update_line_ids() {
+	line_ids.clear();
+	for (uint32_t i = 0; i < lines.size(); i++) {
+		if (lines[i].id != -1) {
+			line_ids.insert(strings[lines[i].id], i);
+		}
+	}
+}
+
+bool DialogueProgram::_check_code(int32_t p_offset) const {
+	if (p_offset < 0) {
+		return false;
+	}
+	uint32_t ip = p_offset;
+	while (ip < code.size()) {
+		const uint32_t operands = code.size() - ip - 1;
+		switch (code[ip]) {
+			case OP_END: {
+				return true;
+			}
+			case OP_TRUE:
+			case OP_NOT: {
+				ip++;
+			} break;
+			case OP_TEST:
+			case OP_VARIABLE: {
+				if (operands < 1 || code[ip + 1] >= names.size()) {
+					return false;
+				}
+				ip += 2;
+			} break;
+			case OP_TEXT: {
+				if (operands < 1 || code[ip + 1] >= strings.size()) {
+					return false;
+				}
+				ip += 2;
+			} break;
+			case OP_JUMP_IF_FALSE:
+			case OP_JUMP_IF_TRUE: {
+				if (operands < 1 || code[ip + 1] <= ip || code[ip + 1] >= code.size()) {
+					return false;
+				}
+				ip += 2;
+			} break;
+			case OP_COMPARE: {
+				if (operands < 3 || code[ip + 1] >= names.size() || code[ip + 2] >= Variant::OP_MAX || code[ip + 3] >= constants.size()) {
+					return false;
+				}
+				ip += 4;
+			} break;
+			case OP_SET:
+			case OP_ADD: {
+				if (operands < 2 || code[ip + 1] >= names.size() || code[ip + 2] >= constants.size()) {
+					return false;
+				}
+				ip += 3;
+			} break;
+			case OP_CALL: {
+				if (operands < 2 || code[ip + 1] >= constants.size() || code[ip + 2] >= constants.size()) {
+					return false;
+				}
+				ip += 3;
+			} break;
+			default: {
+				return false;
+			}
+		}
+	}
+	return false;
+}
+
+Error DialogueProgram::compile(const Dictionary &p_dialogue) {
+	_clear();
+
+	const Array source_lines = p_dialogue.get("lines", Array());
+	lines.resize(source_lines.size());
+
+	// Ids are collected first so that lines can refer to later ones.
+	for (int i = 0; i < source_lines.size(); i++) {
+		if (source_lines[i].get_type() != Variant::DICTIONARY) {
+			_clear();
+			return _set_error(vformat("Line %d is not a Dictionary.", i));
+		}
+		const Dictionary line = source_lines[i];
+		const String id = line.get("id", String());
+		if (id.is_empty()) {
+			continue;
+		}
+		if (line_ids.has(id)) {
+			_clear();
+			return _set_error(vformat("Line %d: Duplicate line id \"%s\".", i, id));
+		}
+		lines[i].id = _add_string(id);
+		line_ids.insert(id, i);
+	}
+
+	for (int i = 0; i < source_lines.size(); i++) {
+		const Dictionary line = source_lines[i];
+		LineData &data = lines[i];
+		data.speaker = _add_string(line.get("speaker", String()));
+		data.text = _compile_text(line.get("text", String()));
+
+		Error err = _resolve_line(line.get("next", Variant()), i + 1 < source_lines.size() ? i + 1 : LINE_END, data.next);
+		if (err == OK && line.has("condition")) {
+			data.condition = code.size();
+			err = _compile_condition(line["condition"], 0);
+			code.push_back(OP_END);
+		}
+
+		const Array line_choices = line.get("choices", Array());
+		data.choice_from = choices.size();
+		data.choice_count = line_choices.size();
+		for (int j = 0; j < line_choices.size() && err == OK; j++) {
+			if (line_choices[j].get_type() != Variant::DICTIONARY) {
+				err = _set_error(vformat("Choice %d is not a Dictionary.", j));
+				break;
+			}
+			const Dictionary choice = line_choices[j];
+			ChoiceData choice_data;
+			choice_data.text = _compile_text(choice.get("text", String()));
+			err = _resolve_line(choice.get("jump_to", Variant()), LINE_END, choice_data.jump_to);
+			if (err == OK && choice.has("action")) {
+				choice_data.action = code.size();
+				err = _compile_action(choice["action"]);
+				code.push_back(OP_END);
+			}
+			choices.push_back(choice_data);
+		}
+
+		if (err != OK) {
+			const String message = vformat("Line %d: %s", i, error_string);
+			_clear();
+			error_string = message;
+			return err;
+		}
+	}
+
+	string_lookup.clear();
+	emit_changed();
+	return OK;
+}
+
+void DialogueProgram::_set_data(const PackedByteArray &p_data) {
+	_clear();
+	if (p_data.is_empty()) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(p_data.size() < 8 || memcmp(p_data.ptr(), DIALOGUE_PROGRAM_MAGIC, 4) != 0, "Invalid compiled dialogue data.");
+	const uint32_t version = decode_uint32(p_data.ptr() + 4);
+	ERR_FAIL_COND_MSG(version != FORMAT_VERSION, vformat("Unsupported compiled dialogue format version %d, export the dialogue again.", version));
+
+	Variant decoded;
+	Error err = decode_variant(decoded, p_data.ptr() + 8, p_data.size() - 8);
+	ERR_FAIL_COND_MSG(err != OK || decoded.get_type() != Variant::ARRAY, "Invalid compiled dialogue data.");
+	const Array tables = decoded;
+	ERR_FAIL_COND_MSG(tables.size() != 6, "Invalid compiled dialogue data.");
+
+	const PackedStringArray packed_names = tables[0];
+	const PackedStringArray packed_strings = tables[1];
+	const Array packed_constants = tables[2];
+	const PackedInt32Array packed_lines = tables[3];
+	const PackedInt32Array packed_choices = tables[4];
+	const PackedInt32Array packed_code = tables[5];
+	ERR_FAIL_COND_MSG(packed_lines.size() % LINE_FIELDS != 0 || packed_choices.size() % CHOICE_FIELDS != 0, "Invalid compiled dialogue data.");
+
+	names.resize(packed_names.size());
+	for (int i = 0; i < packed_names.size(); i++) {
+		names[i] = packed_names[i];
+	}
+	variable_names = packed_names;
+	strings.resize(packed_strings.size());
+	for (int i = 0; i < packed_strings.size(); i++) {
+		strings[i] = packed_strings[i];
+	}
+	constants.resize(packed_constants.size());
+	for (int i = 0; i < packed_constants.size(); i++) {
+		constants[i] = packed_constants[i];
+	}
+	code.resize(packed_code.size());
+	if (!code.is_empty()) {
+		memcpy(code.ptr(), packed_code.ptr(), code.size() * sizeof(uint32_t));
+	}
+
+	// Everything is checked once here so the runtime can trust the tables.
+	const int32_t string_count = strings.size();
+	const int32_t line_count = packed_lines.size() / LINE_FIELDS;
+	const int32_t choice_count = packed_choices.size() / CHOICE_FIELDS;
+	bool valid = true;
+
+	choices.resize(choice_count);
+	const int32_t *choice_ptr = packed_choices.ptr();
+	for (int32_t i = 0; i < choice_count && valid; i++, choice_ptr += CHOICE_FIELDS) {
+		ChoiceData &choice = choices[i];
+		choice.text = choice_ptr[0];
+		choice.action = choice_ptr[1];
+		choice.jump_to = choice_ptr[2];
+		valid = _check_code(choice.text) && (choice.action == -1 || _check_code(choice.action)) && choice.jump_to >= LINE_END && choice.jump_to < line_count;
+	}
+
+	lines.resize(line_count);
+	const int32_t *line_ptr = packed_lines.ptr();
+	for (int32_t i = 0; i < line_count && valid; i++, line_ptr += LINE_FIELDS) {
+		LineData &line = lines[i];
+		line.id = line_ptr[0];
+		line.speaker = line_ptr[1];
+		line.text = line_ptr[2];
+		line.condition = line_ptr[3];
+		line.choice_from = line_ptr[4];
+		line.choice_count = line_ptr[5];
+		line.next = line_ptr[6];
+		valid = line.id >= -1 && line.id < string_count && line.speaker >= 0 && line.speaker < string_count && _check_code(line.text) && (line.condition == -1 || _check_code(line.condition)) && line.choice_from <= (uint32_t)choice_count && line.choice_count <= choice_count - line.choice_from && line.next >= LINE_END && line.next < line_count;
+	}
+
+	if (!valid) {
+		_clear();
+		ERR_FAIL_MSG("Invalid compiled dialogue data.");
+	}
+	_update_line_ids();
+}
+
+PackedByteArray DialogueProgram::_get_data() const {
+	if (lines.is_empty()) {
+		return PackedByteArray();
+	}
+
+	PackedStringArray packed_strings;
+	packed_strings.resize(strings.size());
+	for (uint32_t i = 0; i < strings.size(); i++) {
+		packed_strings.set(i, strings[i]);
+	}
+	Array packed_constants;
+	packed_constants.resize(constants.size());
+	for (uint32_t i = 0; i < constants.size(); i++) {
+		packed_constants[i] = constants[i];
+	}
+
+	PackedInt32Array packed_lines;
+	packed_lines.resize(lines.size() * LINE_FIELDS);
+	int32_t *line_ptr = packed_lines.ptrw();
+	for (const LineData &line : lines) {
+		line_ptr[0] = line.id;
+		line_ptr[1] = line.speaker;
+		line_ptr[2] = line.text;
+		line_ptr[3] = line.condition;
+		line_ptr[4] = line.choice_from;
+		line_ptr[5] = line.choice_count;
+		line_ptr[6] = line.next;
+		line_ptr += LINE_FIELDS;
+	}
+	PackedInt32Array packed_choices;
+	packed_choices.resize(choices.size() * CHOICE_FIELDS);
+	int32_t *choice_ptr = packed_choices.ptrw();
+	for (const ChoiceData &choice : choices) {
+		choice_ptr[0] = choice.text;
+		choice_ptr[1] = choice.action;
+		choice_ptr[2] = choice.jump_to;
+		choice_ptr += CHOICE_FIELDS;
+	}
+	PackedInt32Array packed_code;
+	packed_code.resize(code.size());
+	if (!code.is_empty()) {
+		memcpy(packed_code.ptrw(), code.ptr(), code.size() * sizeof(uint32_t));
+	}
+
+	Array tables;
+	tables.push_back(variable_names);
+	tables.push_back(packed_strings);
+	tables.push_back(packed_constants);
+	tables.push_back(packed_lines);
+	tables.push_back(packed_choices);
+	tables.push_back(packed_code);
+
+	int len = 0;
+	Error err = encode_variant(tables, nullptr, len);
+	ERR_FAIL_COND_V(err != OK, PackedByteArray());
+	PackedByteArray data;
+	data.resize(8 + len);
+	memcpy(data.ptrw(), DIALOGUE_PROGRAM_MAGIC, 4);
+	encode_uint32(FORMAT_VERSION, data.ptrw() + 4);
+	encode_variant(tables, data.ptrw() + 8, len);
+	return data;
+}
+
+const uint32_t *DialogueProgram::_bind(DialogueVariables *p_variables) const {
+	return p_variables->_get_program_slots(compile_id, names);
+}
+
+bool DialogueProgram::_run_condition(int32_t p_offset, const DialogueVariables *p_variables, const uint32_t *p_slots) const {
+	const uint32_t *ip = code.ptr() + p_offset;
+	bool acc = true;
+	while (true) {
+		switch (ip[0]) {
+			case OP_END: {
+				return acc;
+			}
+			case OP_TRUE: {
+				acc = true;
+				ip++;
+			} break;
+			case OP_TEST: {
+				acc = p_variables->get_slot_value(p_slots[ip[1]]).booleanize();
+				ip += 2;
+			} break;
+			case OP_COMPARE: {
+				Variant result;
+				bool valid = false;
+				Variant::evaluate(Variant::Operator(ip[2]), p_variables->get_slot_value(p_slots[ip[1]]), constants[ip[3]], result, valid);
+				acc = valid && result.booleanize();
+				ip += 4;
+			} break;
+			case OP_NOT: {
+				acc = !acc;
+				ip++;
+			} break;
+			case OP_JUMP_IF_FALSE: {
+				ip = acc ? ip + 2 : code.ptr() + ip[1];
+			} break;
+			case OP_JUMP_IF_TRUE: {
+				ip = acc ? code.ptr() + ip[1] : ip + 2;
+			} break;
+			default: {
+				ERR_FAIL_V_MSG(false, "Invalid dialogue condition bytecode.");
+			}
+		}
+	}
+}
+
+String DialogueProgram::_run_text(int32_t p_offset, const DialogueVariables *p_variables, const uint32_t *p_slots) const {
+	const uint32_t *ip = code.ptr() + p_offset;
+	// Plain text is returned as is, without copying.
+	if (ip[0] == OP_TEXT && ip[2] == OP_END) {
+		return strings[ip[1]];
+	}
+
+	String result;
+	while (ip[0] != OP_END) {
+		if (ip[0] == OP_TEXT) {
+			result += strings[ip[1]];
+		} else {
+			const Variant &value = p_variables->get_slot_value(p_slots[ip[1]]);
+			result += value.get_type() == Variant::STRING ? value.operator String() : value.stringify();
+		}
+		ip += 2;
+	}
+	return result;
+}
+
+const DialogueProgram::ChoiceData *DialogueProgram::_get_choice(int p_line, int p_choice) const {
+	const LineData *line = _get_line(p_line);
+	ERR_FAIL_NULL_V(line, nullptr);
+	ERR_FAIL_INDEX_V(p_choice, (int)line->choice_count, nullptr);
+	return &choices[line->choice_from + p_choice];
+}
+
+int DialogueProgram::find_line(const StringName &p_id) const {
+	const int32_t *line = line_ids.getptr(p_id);
+	return line ? *line : LINE_END;
+}
+
+String DialogueProgram::get_line_id(int p_line) const {
+	const LineData *line = _get_line(p_line);
+	ERR_FAIL_NULL_V(line, String());
+	return line->id == -1 ? String() : strings[line->id];
+}
+
+int DialogueProgram::get_line_next(int p_line) const {
+	const LineData *line = _get_line(p_line);
+	ERR_FAIL_NULL_V(line, LINE_END);
+	return line->next;
+}
+
+String DialogueProgram::get_line_speaker(int p_line) const {
+	const LineData *line = _get_line(p_line);
+	ERR_FAIL_NULL_V(line, String());
+	return strings[line->speaker];
+}
+
+bool DialogueProgram::has_line_condition(int p_line) const {
+	const LineData *line = _get_line(p_line);
+	ERR_FAIL_NULL_V(line, false);
+	return line->condition != -1;
+}
+
+bool DialogueProgram::check_line_condition(int p_line, const Ref<DialogueVariables> &p_variables) const {
+	const LineData *line = _get_line(p_line);
+	ERR_FAIL_NULL_V(line, false);
+	if (line->condition == -1) {
+		return true;
+	}
+	ERR_FAIL_COND_V(p_variables.is_null(), false);
+	return _run_condition(line->condition, p_variables.ptr(), _bind(p_variables.ptr()));
+}
+
+int DialogueProgram::find_next_line(int p_from, const Ref<DialogueVariables> &p_variables) const {
+	ERR_FAIL_COND_V(p_from < 0, LINE_END);
+	ERR_FAIL_COND_V(p_variables.is_null(), LINE_END);
+	const uint32_t *slots = _bind(p_variables.ptr());
+	for (uint32_t i = p_from; i < lines.size(); i++) {
+		if (lines[i].condition == -1 || _run_condition(lines[i].condition, p_variables.ptr(), slots)) {
+			return i;
+		}
+	}
+	return LINE_END;
+}
+
+String DialogueProgram::format_line_text(int p_line, const Ref<DialogueVariables> &p_variables) const {
+	const LineData *line = _get_line(p_line);
+	ERR_FAIL_NULL_V(line, String());
+	ERR_FAIL_COND_V(p_variables.is_null(), String());
+	return _run_text(line->text, p_variables.ptr(), _bind(p_variables.ptr()));
+}
+
+int DialogueProgram::get_line_choice_count(int p_line) const {
+	const LineData *line = _get_line(p_line);
+	ERR_FAIL_NULL_V(line, 0);
+	return line->choice_count;
+}
+
+String DialogueProgram::format_choice_text(int p_line, int p_choice, const Ref<DialogueVariables> &p_variables) const {
+	const ChoiceData *choice = _get_choice(p_line, p_choice);
+	ERR_FAIL_NULL_V(choice, String());
+	ERR_FAIL_COND_V(p_variables.is_null(), String());
+	return _run_text(choice->text, p_variables.ptr(), _bind(p_variables.ptr()));
+}
+
+int DialogueProgram::get_choice_jump(int p_line, int p_choice) const {
+	const ChoiceData *choice = _get_choice(p_line, p_choice);
+	ERR_FAIL_NULL_V(choice, LINE_END);
+	return choice->jump_to;
+}
+
+void DialogueProgram::run_choice_action(int p_line, int p_choice, const Ref<DialogueVariables> &p_variables, const Callable &p_handler) const {
+	const ChoiceData *choice = _get_choice(p_line, p_choice);
+	ERR_FAIL_NULL(choice);
+	if (choice->action == -1) {
+		return;
+	}
+	ERR_FAIL_COND(p_variables.is_null());
+	DialogueVariables *variables = p_variables.ptr();
+	const uint32_t *slots = _bind(variables);
+	const uint32_t *ip = code.ptr() + choice->action;
+	while (ip[0] != OP_END) {
+		switch (ip[0]) {
+			case OP_SET: {
+				variables->set_slot_value(slots[ip[1]], constants[ip[2]]);
+				ip += 3;
+			} break;
+			case OP_ADD: {
+				const uint32_t slot = slots[ip[1]];
+				const Variant &current = variables->get_slot_value(slot);
+				Variant result;
+				bool valid = false;
+				Variant::evaluate(Variant::OP_ADD, current.get_type() == Variant::NIL ? Variant(0) : current, constants[ip[2]], result, valid);
+				ERR_FAIL_COND_MSG(!valid, vformat("Dialogue variable \"%s\" is not a number.", names[ip[1]]));
+				variables->set_slot_value(slot, result);
+				ip += 3;
+			} break;
+			case OP_CALL: {
+				if (p_handler.is_valid()) {
+					p_handler.call(constants[ip[1]], constants[ip[2]]);
+				}
+				ip += 3;
+			} break;
+			default: {
+				ERR_FAIL_MSG("Invalid dialogue action bytecode.");
+			}
+		}
+	}
+}
+
+void DialogueProgram::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("compile", "dialogue"), &DialogueProgram::compile);
+	ClassDB::bind_method(D_METHOD("get_error_string"), &DialogueProgram::get_error_string);
+	ClassDB::bind_method(D_METHOD("get_variable_names"), &DialogueProgram::get_variable_names);
+
+	ClassDB::bind_method(D_METHOD("_set_data", "data"), &DialogueProgram::_set_data);
+	ClassDB::bind_method(D_METHOD("_get_data"), &DialogueProgram::_get_data);
+
+	ClassDB::bind_method(D_METHOD("get_line_count"), &DialogueProgram::get_line_count);
+	ClassDB::bind_method(D_METHOD("find_line", "id"), &DialogueProgram::find_line);
+	ClassDB::bind_method(D_METHOD("get_line_id", "line"), &DialogueProgram::get_line_id);
+	ClassDB::bind_method(D_METHOD("get_line_next", "line"), &DialogueProgram::get_line_next);
+	ClassDB::bind_method(D_METHOD("get_line_speaker", "line"), &DialogueProgram::get_line_speaker);
+	ClassDB::bind_method(D_METHOD("has_line_condition", "line"), &DialogueProgram::has_line_condition);
+	ClassDB::bind_method(D_METHOD("check_line_condition", "line", "variables"), &DialogueProgram::check_line_condition);
+	ClassDB::bind_method(D_METHOD("find_next_line", "from", "variables"), &DialogueProgram::find_next_line);
+	ClassDB::bind_method(D_METHOD("format_line_text", "line", "variables"), &DialogueProgram::format_line_text);
+
+	ClassDB::bind_method(D_METHOD("get_line_choice_count", "line"), &DialogueProgram::get_line_choice_count);
+	ClassDB::bind_method(D_METHOD("format_choice_text", "line", "choice", "variables"), &DialogueProgram::format_choice_text);
+	ClassDB::bind_method(D_METHOD("get_choice_jump", "line", "choice"), &DialogueProgram::get_choice_jump);
+	ClassDB::bind_method(D_METHOD("run_choice_action", "line", "choice", "variables", "handler"), &DialogueProgram::run_choice_action, DEFVAL(Callable()));
+
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_BYTE_ARRAY, "_data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "_set_data", "_get_data");
+
+	BIND_CONSTANT(LINE_END);
+}
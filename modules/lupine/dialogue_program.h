@@ -0,0 +1,193 @@
+/**************************************************************************/
+/*  dialogue_program.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/resource.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Table of dialogue variables, addressed by slot.
+// Slots are assigned the first time a name is seen and never move, so
+// DialogueProgram can resolve its names to slots once and then read values
+// by index. The resolved slots are kept here, per program, so a shared
+// program holds no state about the tables it runs against.
+class DialogueVariables : public RefCounted {
+	GDCLASS(DialogueVariables, RefCounted);
+
+	AHashMap<StringName, uint32_t> slots;
+	LocalVector<StringName> names;
+	LocalVector<Variant> values;
+
+	// Compile id of a program -> slot of each of its names. A HashMap, as
+	// its values must not move while a program runs actions that can bind
+	// other programs to this table.
+	HashMap<uint64_t, LocalVector<uint32_t>> program_slots;
+
+	const uint32_t *_get_program_slots(uint64_t p_compile_id, const LocalVector<StringName> &p_names);
+
+	friend class DialogueProgram;
+
+protected:
+	static void _bind_methods();
+
+public:
+	uint32_t get_slot(const StringName &p_name);
+	_FORCE_INLINE_ const Variant &get_slot_value(uint32_t p_slot) const { return values[p_slot]; }
+	_FORCE_INLINE_ void set_slot_value(uint32_t p_slot, const Variant &p_value) { values[p_slot] = p_value; }
+
+	void set_value(const StringName &p_name, const Variant &p_value);
+	Variant get_value(const StringName &p_name, const Variant &p_default = Variant()) const;
+	bool has_value(const StringName &p_name) const;
+	PackedStringArray get_names() const;
+	void clear();
+};
+
+// Dialogue compiled from the Lupine dialogue Dictionary format.
+// Line conditions and choice actions are lowered to a word bytecode and
+// `{variable}` placeholders to text segments, all of which refer to variables
+// by name index. Running the program against a DialogueVariables table maps
+// those names to table slots once, after which checking conditions and
+// formatting lines never parses or allocates anything but the result text.
+// Line ids are resolved to line indices when compiling, and the flat tables
+// are saved as a single packed blob, so a compiled dialogue loads without
+// parsing and is shared through the resource cache.
+class DialogueProgram : public Resource {
+	GDCLASS(DialogueProgram, Resource);
+
+public:
+	enum {
+		LINE_END = -1,
+	};
+
+	static constexpr uint32_t FORMAT_VERSION = 1;
+
+	enum Opcode : uint32_t {
+		OP_END,
+		OP_TRUE, // acc = true.
+		OP_TEST, // Operand: name. acc = bool(variable).
+		OP_COMPARE, // Operands: name, operator, constant. acc = variable <op> constant.
+		OP_NOT, // acc = !acc.
+		OP_JUMP_IF_FALSE, // Operand: code offset.
+		OP_JUMP_IF_TRUE, // Operand: code offset.
+		OP_SET, // Operands: name, constant.
+		OP_ADD, // Operands: name, constant.
+		OP_CALL, // Operand: constant holding the action Dictionary.
+		OP_TEXT, // Operand: string index.
+		OP_VARIABLE, // Operand: name. Appends the variable as text.
+		OP_MAX,
+	};
+
+	struct LineData {
+		int32_t id = -1; // String index.
+		int32_t speaker = -1; // String index.
+		int32_t text = -1; // Code offset of the text segments.
+		int32_t condition = -1; // Code offset.
+		uint32_t choice_from = 0;
+		uint32_t choice_count = 0;
+		int32_t next = LINE_END;
+	};
+
+	struct ChoiceData {
+		int32_t text = -1; // Code offset of the text segments.
+		int32_t action = -1; // Code offset.
+		int32_t jump_to = LINE_END;
+	};
+
+private:
+	LocalVector<StringName> names;
+	LocalVector<String> strings;
+	LocalVector<Variant> constants;
+	LocalVector<LineData> lines;
+	LocalVector<ChoiceData> choices;
+	LocalVector<uint32_t> code;
+	PackedStringArray variable_names;
+	HashMap<StringName, int32_t> line_ids;
+
+	// Only used while compiling, to intern repeated strings.
+	HashMap<String, uint32_t> string_lookup;
+
+	// Unique to each compile or load, as DialogueVariables keys the slots
+	// it resolved for the program by it.
+	uint64_t compile_id = 0;
+
+	String error_string;
+
+	void _clear();
+	Error _set_error(const String &p_error);
+	uint32_t _add_name(const StringName &p_name);
+	uint32_t _add_string(const String &p_string);
+	uint32_t _add_constant(const Variant &p_constant);
+	Error _compile_condition(const Variant &p_condition, int p_depth);
+	Error _compile_action(const Variant &p_action);
+	int32_t _compile_text(const String &p_text);
+	Error _resolve_line(const Variant &p_target, int32_t p_default, int32_t &r_line);
+	void _update_line_ids();
+	bool _check_code(int32_t p_offset) const;
+
+	// Returns the slot in `p_variables` of each name index.
+	const uint32_t *_bind(DialogueVariables *p_variables) const;
+	bool _run_condition(int32_t p_offset, const DialogueVariables *p_variables, const uint32_t *p_slots) const;
+	String _run_text(int32_t p_offset, const DialogueVariables *p_variables, const uint32_t *p_slots) const;
+
+	_FORCE_INLINE_ const LineData *_get_line(int p_line) const {
+		ERR_FAIL_INDEX_V(p_line, (int)lines.size(), nullptr);
+		return &lines[p_line];
+	}
+	const ChoiceData *_get_choice(int p_line, int p_choice) const;
+
+protected:
+	static void _bind_methods();
+
+	void _set_data(const PackedByteArray &p_data);
+	PackedByteArray _get_data() const;
+
+public:
+	Error compile(const Dictionary &p_dialogue);
+	String get_error_string() const { return error_string; }
+	PackedStringArray get_variable_names() const { return variable_names; }
+
+	int get_line_count() const { return lines.size(); }
+	int find_line(const StringName &p_id) const;
+	String get_line_id(int p_line) const;
+	int get_line_next(int p_line) const;
+	String get_line_speaker(int p_line) const;
+	bool has_line_condition(int p_line) const;
+	bool check_line_condition(int p_line, const Ref<DialogueVariables> &p_variables) const;
+	int find_next_line(int p_from, const Ref<DialogueVariables> &p_variables) const;
+	String format_line_text(int p_line, const Ref<DialogueVariables> &p_variables) const;
+
+	int get_line_choice_count(int p_line) const;
+	String format_choice_text(int p_line, int p_choice, const Ref<DialogueVariables> &p_variables) const;
+	int get_choice_jump(int p_line, int p_choice) const;
+	void run_choice_action(int p_line, int p_choice, const Ref<DialogueVariables> &p_variables, const Callable &p_handler) const;
+};
@@ -0,0 +1,79 @@
+/**************************************************************************/
+/*  vn_asset_index_export_plugin.cpp                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "vn_asset_index_export_plugin.h"
+
+#include "../vn_asset_streamer.h"
+
+#include "core/io/marshalls.h"
+#include "editor/editor_file_system.h"
+
+void VNAssetIndexExportPlugin::_index_directory(EditorFileSystemDirectory *p_dir, Dictionary &r_directories, bool &r_has_scripts) {
+	Dictionary names;
+	for (int i = 0; i < p_dir->get_file_count(); i++) {
+		const StringName type = p_dir->get_file_type(i);
+		if (type == SNAME("VNScript")) {
+			r_has_scripts = true;
+		} else if (ClassDB::is_parent_class(type, "Texture2D")) {
+			names[p_dir->get_file(i).get_basename()] = p_dir->get_file_path(i);
+		}
+	}
+	if (!names.is_empty()) {
+		r_directories[p_dir->get_path().simplify_path()] = names;
+	}
+
+	for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+		_index_directory(p_dir->get_subdir(i), r_directories, r_has_scripts);
+	}
+}
+
+void VNAssetIndexExportPlugin::_export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	ERR_FAIL_NULL(efs);
+
+	Dictionary directories;
+	bool has_scripts = false;
+	_index_directory(efs->get_filesystem(), directories, has_scripts);
+	if (!has_scripts || directories.is_empty()) {
+		return; // Not a VN project, nothing would look the index up.
+	}
+
+	Dictionary index;
+	index["version"] = VNAssetStreamer::INDEX_VERSION;
+	index["directories"] = directories;
+
+	int len = 0;
+	Error err = encode_variant(index, nullptr, len);
+	ERR_FAIL_COND(err != OK);
+	Vector<uint8_t> data;
+	data.resize(len);
+	encode_variant(index, data.ptrw(), len);
+	add_file(VNAssetStreamer::INDEX_PATH, data, false);
+}
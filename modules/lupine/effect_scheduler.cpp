@@ -0,0 +1,497 @@
+/**************************************************************************/
+/*  effect_scheduler.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "effect_scheduler.h"
+
+uint64_t EffectScheduler::_to_ticks(double p_seconds) const {
+	return MAX(uint64_t(1), uint64_t(Math::ceil(p_seconds * tick_rate - CMP_EPSILON)));
+}
+
+double EffectScheduler::_remaining(int32_t p_index) const {
+	const Timer &timer = timers[p_index];
+	uint64_t expires = timer.expires;
+	if (timer.type == TIMER_DOT) {
+		expires += uint64_t(timer.interval) * (timer.hits_left - 1);
+	}
+	return MAX(0.0, double(expires - tick) / tick_rate - time_accumulator);
+}
+
+int32_t EffectScheduler::_alloc_timer(TimerType p_type, const StringName &p_name, Object *p_target, uint64_t p_ticks) {
+	int32_t index;
+	if (free_timers.is_empty()) {
+		index = timers.size();
+		timers.push_back(Timer());
+	} else {
+		index = free_timers[free_timers.size() - 1];
+		free_timers.resize(free_timers.size() - 1);
+	}
+
+	Timer &timer = timers[index];
+	timer.alive = true;
+	timer.type = p_type;
+	timer.name = p_name;
+	timer.target = p_target ? p_target->get_instance_id() : ObjectID();
+	timer.expires = tick + p_ticks;
+	timer_count++;
+	_link(index);
+	return index;
+}
+
+void EffectScheduler::_free_timer(int32_t p_index) {
+	Timer &timer = timers[p_index];
+	if (timer.slot >= 0) {
+		_unlink(p_index);
+	}
+	timer.alive = false;
+	// Stale IDs stop matching once the slot is reused.
+	if (++timer.generation == 0) {
+		timer.generation = 1;
+	}
+	timer.name = StringName();
+	timer.target = ObjectID();
+	timer.modifiers.clear();
+	free_timers.push_back(p_index);
+	timer_count--;
+}
+
+void EffectScheduler::_link(int32_t p_index) {
+	Timer &timer = timers[p_index];
+	const uint64_t delta = timer.expires - tick;
+
+	// File the timer in the lowest level whose range reaches it. Slots are
+	// picked from the absolute expiry tick, so a slot is visited (or
+	// cascaded) exactly when its timers are due.
+	uint32_t slot = OVERFLOW_SLOT;
+	if (delta < SLOTS) {
+		slot = timer.expires & SLOT_MASK;
+	} else {
+		for (uint32_t level = 1; level < LEVELS; level++) {
+			if (delta < (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+				slot = level * SLOTS + ((timer.expires >> (SLOT_BITS * level)) & SLOT_MASK);
+				break;
+			}
+		}
+	}
+
+	timer.slot = slot;
+	timer.prev = -1;
+	timer.next = heads[slot];
+	if (heads[slot] >= 0) {
+		timers[heads[slot]].prev = p_index;
+	}
+	heads[slot] = p_index;
+}
+
+void EffectScheduler::_unlink(int32_t p_index) {
+	Timer &timer = timers[p_index];
+	if (timer.prev >= 0) {
+		timers[timer.prev].next = timer.next;
+	} else {
+		heads[timer.slot] = timer.next;
+	}
+	if (timer.next >= 0) {
+		timers[timer.next].prev = timer.prev;
+	}
+	timer.slot = -1;
+	timer.prev = -1;
+	timer.next = -1;
+}
+
+void EffectScheduler::_cascade(uint32_t p_slot) {
+	int32_t index = heads[p_slot];
+	heads[p_slot] = -1;
+	while (index >= 0) {
+		const int32_t next = timers[index].next;
+		_link(index);
+		index = next;
+	}
+}
+
+void EffectScheduler::_collect_slot(uint32_t p_slot) {
+	int32_t index = heads[p_slot];
+	heads[p_slot] = -1;
+	while (index >= 0) {
+		Timer &timer = timers[index];
+		const int32_t next = timer.next;
+		timer.slot = -1;
+		timer.prev = -1;
+		timer.next = -1;
+		if (timer.expires > tick) {
+			_link(index);
+		} else {
+			expired.push_back(_make_id(index));
+		}
+		index = next;
+	}
+}
+
+void EffectScheduler::_fire(int32_t p_index) {
+	Timer &timer = timers[p_index];
+	const int64_t id = _make_id(p_index);
+	const StringName name = timer.name;
+	Object *target = _get_target(p_index);
+
+	switch (timer.type) {
+		case TIMER_COOLDOWN: {
+			cooldowns.erase(CooldownKey{ timer.target, name });
+			_free_timer(p_index);
+			emit_signal(SNAME("cooldown_finished"), name, target);
+		} break;
+		case TIMER_BUFF: {
+			_remove_effect(p_index);
+			emit_signal(SNAME("effect_expired"), id, name, target);
+		} break;
+		case TIMER_DOT: {
+			if (!target) {
+				_free_timer(p_index);
+				emit_signal(SNAME("effect_expired"), id, name, target);
+				break;
+			}
+			const float damage = timer.value;
+			const bool last = --timer.hits_left == 0;
+			if (!last) {
+				timer.expires += timer.interval;
+				_link(p_index);
+			}
+			emit_signal(SNAME("effect_ticked"), id, name, target, damage);
+			if (last) {
+				// The handler may have removed the effect already.
+				const int32_t index = _index_of(id);
+				if (index >= 0) {
+					_free_timer(index);
+					emit_signal(SNAME("effect_expired"), id, name, target);
+				}
+			}
+		} break;
+	}
+}
+
+void EffectScheduler::_apply_modifiers(int32_t p_index, float p_sign) {
+	const Timer &timer = timers[p_index];
+	if (timer.modifiers.is_empty()) {
+		return;
+	}
+
+	TargetStats &stats = target_stats[timer.target];
+	for (const Modifier &modifier : timer.modifiers) {
+		stats.totals[modifier.stat] += p_sign * modifier.value;
+		stats.changes[modifier.stat] += p_sign * modifier.value;
+	}
+	if (!stats.queued) {
+		stats.queued = true;
+		changed_targets.push_back(timer.target);
+	}
+}
+
+void EffectScheduler::_remove_effect(int32_t p_index) {
+	_apply_modifiers(p_index, -1.0);
+	_free_timer(p_index);
+}
+
+void EffectScheduler::start_cooldown(Object *p_owner, const StringName &p_ability, double p_duration) {
+	const CooldownKey key{ p_owner ? p_owner->get_instance_id() : ObjectID(), p_ability };
+	const int32_t *existing = cooldowns.getptr(key);
+	if (existing) {
+		_free_timer(*existing);
+		cooldowns.erase(key);
+	}
+	if (p_duration <= 0.0) {
+		return;
+	}
+	cooldowns.insert(key, _alloc_timer(TIMER_COOLDOWN, p_ability, p_owner, _to_ticks(p_duration)));
+}
+
+bool EffectScheduler::is_on_cooldown(Object *p_owner, const StringName &p_ability) const {
+	return cooldowns.has(CooldownKey{ p_owner ? p_owner->get_instance_id() : ObjectID(), p_ability });
+}
+
+double EffectScheduler::get_cooldown_remaining(Object *p_owner, const StringName &p_ability) const {
+	const int32_t *index = cooldowns.getptr(CooldownKey{ p_owner ? p_owner->get_instance_id() : ObjectID(), p_ability });
+	return index ? _remaining(*index) : 0.0;
+}
+
+void EffectScheduler::cancel_cooldown(Object *p_owner, const StringName &p_ability) {
+	start_cooldown(p_owner, p_ability, 0.0);
+}
+
+int64_t EffectScheduler::add_buff(Object *p_target, const StringName &p_effect, double p_duration, const Dictionary &p_modifiers) {
+	ERR_FAIL_NULL_V(p_target, 0);
+	ERR_FAIL_COND_V(p_duration <= 0.0, 0);
+
+	const int32_t index = _alloc_timer(TIMER_BUFF, p_effect, p_target, _to_ticks(p_duration));
+	Timer &timer = timers[index];
+	for (const KeyValue<Variant, Variant> &E : p_modifiers) {
+		ERR_CONTINUE_MSG(E.value.get_type() != Variant::FLOAT && E.value.get_type() != Variant::INT, vformat("Modifier \"%s\" must be a number.", E.key));
+		Modifier modifier;
+		modifier.stat = E.key;
+		modifier.value = E.value;
+		timer.modifiers.push_back(modifier);
+	}
+	_apply_modifiers(index, 1.0);
+	return _make_id(index);
+}
+
+int64_t EffectScheduler::add_dot(Object *p_target, const StringName &p_effect, double p_duration, double p_interval, float p_damage) {
+	ERR_FAIL_NULL_V(p_target, 0);
+	ERR_FAIL_COND_V(p_duration <= 0.0, 0);
+	ERR_FAIL_COND_V(p_interval <= 0.0, 0);
+
+	const uint64_t interval = _to_ticks(p_interval);
+	ERR_FAIL_COND_V(interval > UINT32_MAX, 0);
+	const int32_t index = _alloc_timer(TIMER_DOT, p_effect, p_target, interval);
+	Timer &timer = timers[index];
+	timer.interval = interval;
+	timer.hits_left = MAX(1, int(Math::floor(p_duration / p_interval + CMP_EPSILON)));
+	timer.value = p_damage;
+	return _make_id(index);
+}
+
+bool EffectScheduler::remove_effect(int64_t p_id) {
+	const int32_t index = _index_of(p_id);
+	if (index < 0 || timers[index].type == TIMER_COOLDOWN) {
+		return false;
+	}
+	_remove_effect(index);
+	return true;
+}
+
+bool EffectScheduler::has_effect(int64_t p_id) const {
+	const int32_t index = _index_of(p_id);
+	return index >= 0 && timers[index].type != TIMER_COOLDOWN;
+}
+
+double EffectScheduler::get_effect_remaining(int64_t p_id) const {
+	const int32_t index = _index_of(p_id);
+	ERR_FAIL_COND_V(index < 0 || timers[index].type == TIMER_COOLDOWN, 0.0);
+	return _remaining(index);
+}
+
+StringName EffectScheduler::get_effect_name(int64_t p_id) const {
+	const int32_t index = _index_of(p_id);
+	ERR_FAIL_COND_V(index < 0 || timers[index].type == TIMER_COOLDOWN, StringName());
+	return timers[index].name;
+}
+
+Object *EffectScheduler::get_effect_target(int64_t p_id) const {
+	const int32_t index = _index_of(p_id);
+	ERR_FAIL_COND_V(index < 0 || timers[index].type == TIMER_COOLDOWN, nullptr);
+	return _get_target(index);
+}
+
+float EffectScheduler::get_stat_modifier(Object *p_target, const StringName &p_stat) const {
+	ERR_FAIL_NULL_V(p_target, 0.0);
+	const TargetStats *stats = target_stats.getptr(p_target->get_instance_id());
+	if (!stats) {
+		return 0.0;
+	}
+	const float *total = stats->totals.getptr(p_stat);
+	return total ? *total : 0.0;
+}
+
+Dictionary EffectScheduler::get_stat_modifiers(Object *p_target) const {
+	ERR_FAIL_NULL_V(p_target, Dictionary());
+	Dictionary result;
+	const TargetStats *stats = target_stats.getptr(p_target->get_instance_id());
+	if (stats) {
+		for (const KeyValue<StringName, float> &E : stats->totals) {
+			if (!Math::is_zero_approx(E.value)) {
+				result[E.key] = E.value;
+			}
+		}
+	}
+	return result;
+}
+
+void EffectScheduler::flush_stat_modifiers() {
+	// Handlers may start or end buffs, which queues their targets again.
+	LocalVector<ObjectID> targets;
+	SWAP(targets, changed_targets);
+
+	for (const ObjectID &target_id : targets) {
+		HashMap<ObjectID, TargetStats>::Iterator E = target_stats.find(target_id);
+		if (!E) {
+			continue;
+		}
+		TargetStats &stats = E->value;
+		stats.queued = false;
+
+		Dictionary changes;
+		for (const KeyValue<StringName, float> &change : stats.changes) {
+			if (!Math::is_zero_approx(change.value)) {
+				changes[change.key] = change.value;
+			}
+		}
+		stats.changes.clear();
+
+		bool neutral = true;
+		for (const KeyValue<StringName, float> &total : stats.totals) {
+			if (!Math::is_zero_approx(total.value)) {
+				neutral = false;
+				break;
+			}
+		}
+
+		Object *target = ObjectDB::get_instance(target_id);
+		if (!target || neutral) {
+			// Also drops the rounding error left by buffs that cancel out.
+			target_stats.remove(E);
+		}
+		if (target && !changes.is_empty()) {
+			emit_signal(SNAME("stat_modifiers_changed"), target, changes);
+		}
+	}
+}
+
+void EffectScheduler::advance(double p_delta) {
+	ERR_FAIL_COND(p_delta < 0.0);
+	ERR_FAIL_COND_MSG(advancing, "Can't advance an EffectScheduler from one of its own signals.");
+	advancing = true;
+
+	// Handlers see the time of the tick that fires, not the end of the frame.
+	double time = time_accumulator + p_delta;
+	uint64_t ticks = uint64_t(Math::floor(time * tick_rate + CMP_EPSILON));
+	time = MAX(0.0, time - double(ticks) / tick_rate);
+	time_accumulator = 0.0;
+
+	while (ticks > 0) {
+		if (timer_count == 0) {
+			// Nothing can fire, so the wheel can jump ahead.
+			tick += ticks;
+			break;
+		}
+		tick++;
+		ticks--;
+
+		// When a level wraps, move the next slot of the level above down.
+		uint32_t index = tick & SLOT_MASK;
+		for (uint32_t level = 1; index == 0 && level <= LEVELS; level++) {
+			if (level == LEVELS) {
+				_cascade(OVERFLOW_SLOT);
+				break;
+			}
+			index = (tick >> (SLOT_BITS * level)) & SLOT_MASK;
+			_cascade(level * SLOTS + index);
+		}
+
+		_collect_slot(tick & SLOT_MASK);
+		for (uint32_t i = 0; i < expired.size(); i++) {
+			const int32_t timer = _index_of(expired[i]);
+			if (timer >= 0) {
+				_fire(timer);
+			}
+		}
+		expired.clear();
+	}
+
+	time_accumulator = time;
+	flush_stat_modifiers();
+	advancing = false;
+}
+
+void EffectScheduler::clear() {
+	for (uint32_t i = 0; i < timers.size(); i++) {
+		if (timers[i].alive) {
+			_free_timer(i);
+		}
+	}
+	cooldowns.clear();
+	target_stats.clear();
+	changed_targets.clear();
+}
+
+void EffectScheduler::set_active(bool p_active) {
+	active = p_active;
+	if (is_inside_tree()) {
+		set_process_internal(active);
+	}
+}
+
+void EffectScheduler::set_tick_rate(int p_rate) {
+	ERR_FAIL_COND(p_rate < 1);
+	ERR_FAIL_COND_MSG(timer_count > 0, "Can't change the tick rate while timers are running.");
+	const double time = get_time();
+	tick_rate = p_rate;
+	tick = uint64_t(time * tick_rate);
+	time_accumulator = MAX(0.0, time - double(tick) / tick_rate);
+}
+
+void EffectScheduler::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_READY: {
+			set_process_internal(active);
+		} break;
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			advance(get_process_delta_time());
+		} break;
+	}
+}
+
+void EffectScheduler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("start_cooldown", "owner", "ability", "duration"), &EffectScheduler::start_cooldown);
+	ClassDB::bind_method(D_METHOD("is_on_cooldown", "owner", "ability"), &EffectScheduler::is_on_cooldown);
+	ClassDB::bind_method(D_METHOD("get_cooldown_remaining", "owner", "ability"), &EffectScheduler::get_cooldown_remaining);
+	ClassDB::bind_method(D_METHOD("cancel_cooldown", "owner", "ability"), &EffectScheduler::cancel_cooldown);
+
+	ClassDB::bind_method(D_METHOD("add_buff", "target", "effect", "duration", "modifiers"), &EffectScheduler::add_buff, DEFVAL(Dictionary()));
+	ClassDB::bind_method(D_METHOD("add_dot", "target", "effect", "duration", "interval", "damage"), &EffectScheduler::add_dot);
+	ClassDB::bind_method(D_METHOD("remove_effect", "id"), &EffectScheduler::remove_effect);
+	ClassDB::bind_method(D_METHOD("has_effect", "id"), &EffectScheduler::has_effect);
+	ClassDB::bind_method(D_METHOD("get_effect_remaining", "id"), &EffectScheduler::get_effect_remaining);
+	ClassDB::bind_method(D_METHOD("get_effect_name", "id"), &EffectScheduler::get_effect_name);
+	ClassDB::bind_method(D_METHOD("get_effect_target", "id"), &EffectScheduler::get_effect_target);
+
+	ClassDB::bind_method(D_METHOD("get_stat_modifier", "target", "stat"), &EffectScheduler::get_stat_modifier);
+	ClassDB::bind_method(D_METHOD("get_stat_modifiers", "target"), &EffectScheduler::get_stat_modifiers);
+	ClassDB::bind_method(D_METHOD("flush_stat_modifiers"), &EffectScheduler::flush_stat_modifiers);
+
+	ClassDB::bind_method(D_METHOD("advance", "delta"), &EffectScheduler::advance);
+	ClassDB::bind_method(D_METHOD("clear"), &EffectScheduler::clear);
+	ClassDB::bind_method(D_METHOD("get_timer_count"), &EffectScheduler::get_timer_count);
+	ClassDB::bind_method(D_METHOD("get_time"), &EffectScheduler::get_time);
+
+	ClassDB::bind_method(D_METHOD("set_active", "active"), &EffectScheduler::set_active);
+	ClassDB::bind_method(D_METHOD("is_active"), &EffectScheduler::is_active);
+	ClassDB::bind_method(D_METHOD("set_tick_rate", "rate"), &EffectScheduler::set_tick_rate);
+	ClassDB::bind_method(D_METHOD("get_tick_rate"), &EffectScheduler::get_tick_rate);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "is_active");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "tick_rate", PROPERTY_HINT_RANGE, "1,1000,1,or_greater,suffix:Hz"), "set_tick_rate", "get_tick_rate");
+
+	ADD_SIGNAL(MethodInfo("cooldown_finished", PropertyInfo(Variant::STRING_NAME, "ability"), PropertyInfo(Variant::OBJECT, "owner")));
+	ADD_SIGNAL(MethodInfo("effect_ticked", PropertyInfo(Variant::INT, "id"), PropertyInfo(Variant::STRING_NAME, "effect"), PropertyInfo(Variant::OBJECT, "target"), PropertyInfo(Variant::FLOAT, "damage")));
+	ADD_SIGNAL(MethodInfo("effect_expired", PropertyInfo(Variant::INT, "id"), PropertyInfo(Variant::STRING_NAME, "effect"), PropertyInfo(Variant::OBJECT, "target")));
+	ADD_SIGNAL(MethodInfo("stat_modifiers_changed", PropertyInfo(Variant::OBJECT, "target"), PropertyInfo(Variant::DICTIONARY, "changes")));
+}
+
+EffectScheduler::EffectScheduler() {
+	for (uint32_t i = 0; i <= OVERFLOW_SLOT; i++) {
+		heads[i] = -1;
+	}
+}
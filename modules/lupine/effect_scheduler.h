@@ -0,0 +1,184 @@
+/**************************************************************************/
+/*  effect_scheduler.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object_id.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+
+// Keeps ability cooldowns, buff durations and damage-over-time ticks in a
+// hierarchical timer wheel, so the cost of a frame depends on the timers that
+// fire in it rather than on every running timer. Time is quantized to ticks
+// (tick_rate per second). Each level has 64 slots covering 64 times the range
+// of the level below; a timer is filed by how far away it is, and the slots of
+// the upper levels are cascaded down as the wheel turns. Timers live in a pool
+// with generation-tagged IDs and intrusive slot lists, so cancelling is O(1).
+//
+// Buffs carry stat modifiers. Their running totals per target are updated as
+// buffs start and end, and the net change of a frame is reported once per
+// target through stat_modifiers_changed instead of once per buff.
+class EffectScheduler : public Node {
+	GDCLASS(EffectScheduler, Node);
+
+	enum TimerType {
+		TIMER_COOLDOWN,
+		TIMER_BUFF,
+		TIMER_DOT,
+	};
+
+	static constexpr uint32_t LEVELS = 4;
+	static constexpr uint32_t SLOT_BITS = 6;
+	static constexpr uint32_t SLOTS = 1 << SLOT_BITS;
+	static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+
+	// Slot lists of all levels, followed by one list for timers beyond the
+	// range of the top level.
+	static constexpr uint32_t OVERFLOW_SLOT = LEVELS * SLOTS;
+
+	struct Modifier {
+		StringName stat;
+		float value = 0.0;
+	};
+
+	struct Timer {
+		uint64_t expires = 0; // Absolute tick.
+		uint32_t generation = 1;
+		int32_t prev = -1;
+		int32_t next = -1;
+		int32_t slot = -1; // -1 when unlinked.
+		bool alive = false;
+		TimerType type = TIMER_COOLDOWN;
+		StringName name;
+		ObjectID target;
+		uint32_t interval = 0; // DOT ticks between hits.
+		uint32_t hits_left = 0;
+		float value = 0.0; // DOT damage per hit.
+		LocalVector<Modifier> modifiers;
+	};
+
+	struct CooldownKey {
+		ObjectID owner;
+		StringName ability;
+
+		bool operator==(const CooldownKey &p_other) const { return owner == p_other.owner && ability == p_other.ability; }
+	};
+
+	struct CooldownKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const CooldownKey &p_key) { return hash_murmur3_one_64(uint64_t(p_key.owner), p_key.ability.hash()); }
+	};
+
+	struct TargetStats {
+		HashMap<StringName, float> totals;
+		HashMap<StringName, float> changes; // Not yet reported.
+		bool queued = false;
+	};
+
+	LocalVector<Timer> timers;
+	LocalVector<int32_t> free_timers;
+	int32_t heads[OVERFLOW_SLOT + 1];
+	uint32_t timer_count = 0;
+
+	HashMap<CooldownKey, int32_t, CooldownKeyHasher> cooldowns;
+	HashMap<ObjectID, TargetStats> target_stats;
+	LocalVector<ObjectID> changed_targets;
+	LocalVector<int64_t> expired;
+
+	uint64_t tick = 0;
+	double time_accumulator = 0.0; // Time since the last tick.
+	bool advancing = false;
+
+	bool active = true;
+	int tick_rate = 60;
+
+	_FORCE_INLINE_ int64_t _make_id(int32_t p_index) const {
+		return (int64_t(timers[p_index].generation) << 32) | p_index;
+	}
+	_FORCE_INLINE_ int32_t _index_of(int64_t p_id) const {
+		const int32_t index = int32_t(p_id & 0xFFFFFFFF);
+		if (p_id <= 0 || index >= int32_t(timers.size()) || !timers[index].alive || timers[index].generation != uint32_t(p_id >> 32)) {
+			return -1;
+		}
+		return index;
+	}
+	_FORCE_INLINE_ Object *_get_target(int32_t p_index) const {
+		return ObjectDB::get_instance(timers[p_index].target);
+	}
+
+	uint64_t _to_ticks(double p_seconds) const;
+	double _remaining(int32_t p_index) const;
+
+	int32_t _alloc_timer(TimerType p_type, const StringName &p_name, Object *p_target, uint64_t p_ticks);
+	void _free_timer(int32_t p_index);
+	void _link(int32_t p_index);
+	void _unlink(int32_t p_index);
+	void _cascade(uint32_t p_slot);
+	void _collect_slot(uint32_t p_slot);
+	void _fire(int32_t p_index);
+
+	void _apply_modifiers(int32_t p_index, float p_sign);
+	void _remove_effect(int32_t p_index);
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void start_cooldown(Object *p_owner, const StringName &p_ability, double p_duration);
+	bool is_on_cooldown(Object *p_owner, const StringName &p_ability) const;
+	double get_cooldown_remaining(Object *p_owner, const StringName &p_ability) const;
+	void cancel_cooldown(Object *p_owner, const StringName &p_ability);
+
+	int64_t add_buff(Object *p_target, const StringName &p_effect, double p_duration, const Dictionary &p_modifiers);
+	int64_t add_dot(Object *p_target, const StringName &p_effect, double p_duration, double p_interval, float p_damage);
+	bool remove_effect(int64_t p_id);
+	bool has_effect(int64_t p_id) const;
+	double get_effect_remaining(int64_t p_id) const;
+	StringName get_effect_name(int64_t p_id) const;
+	Object *get_effect_target(int64_t p_id) const;
+
+	float get_stat_modifier(Object *p_target, const StringName &p_stat) const;
+	Dictionary get_stat_modifiers(Object *p_target) const;
+	void flush_stat_modifiers();
+
+	void advance(double p_delta);
+	void clear();
+
+	int get_timer_count() const { return timer_count; }
+	double get_time() const { return double(tick) / tick_rate + time_accumulator; }
+
+	void set_active(bool p_active);
+	bool is_active() const { return active; }
+	void set_tick_rate(int p_rate);
+	int get_tick_rate() const { return tick_rate; }
+
+	EffectScheduler();
+};
@@ -0,0 +1,261 @@
+/**************************************************************************/
+/*  hud_data_model.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "hud_data_model.h"
+
+int32_t HUDDataModel::_get_key(const StringName &p_key, bool p_create) {
+	const int32_t *index = key_indices.getptr(p_key);
+	if (index) {
+		return *index;
+	}
+	if (!p_create) {
+		return -1;
+	}
+	const int32_t key = key_names.size();
+	key_indices.insert(p_key, key);
+	key_names.push_back(p_key);
+	values.push_back(Variant());
+	dirty.push_back(0);
+	key_bindings.push_back(LocalVector<int32_t>());
+	return key;
+}
+
+int HUDDataModel::_add_binding(const StringName &p_key, Object *p_target, const Vector<StringName> &p_property, const Callable &p_callable) {
+	const int32_t key = _get_key(p_key, true);
+
+	int32_t index;
+	if (free_bindings.is_empty()) {
+		index = bindings.size();
+		bindings.push_back(Binding());
+	} else {
+		index = free_bindings[free_bindings.size() - 1];
+		free_bindings.resize(free_bindings.size() - 1);
+	}
+
+	Binding &binding = bindings[index];
+	binding.key = key;
+	binding.target = p_target ? p_target->get_instance_id() : ObjectID();
+	binding.property = p_property;
+	binding.callable = p_callable;
+	key_bindings[key].push_back(index);
+	binding_count++;
+
+	// Widgets bound late start from the current value.
+	if (values[key].get_type() != Variant::NIL) {
+		_push(index, values[key]);
+	}
+	return index;
+}
+
+void HUDDataModel::_remove_binding(int32_t p_binding) {
+	Binding &binding = bindings[p_binding];
+	key_bindings[binding.key].erase(p_binding);
+	binding.key = -1;
+	binding.target = ObjectID();
+	binding.property.clear();
+	binding.callable = Callable();
+	free_bindings.push_back(p_binding);
+	binding_count--;
+}
+
+bool HUDDataModel::_push(int32_t p_binding, const Variant &p_value) {
+	const Binding &binding = bindings[p_binding];
+	if (binding.callable.is_valid()) {
+		binding.callable.call(p_value);
+		return true;
+	}
+	if (binding.callable.is_null()) {
+		Object *target = ObjectDB::get_instance(binding.target);
+		if (target) {
+			target->set_indexed(binding.property, p_value);
+			return true;
+		}
+	}
+	// The target was freed.
+	return false;
+}
+
+void HUDDataModel::set_value(const StringName &p_key, const Variant &p_value) {
+	const int32_t key = _get_key(p_key, true);
+	Variant &value = values[key];
+	if (value.get_type() == p_value.get_type() && value == p_value) {
+		return;
+	}
+	value = p_value;
+	mark_dirty(p_key);
+}
+
+Variant HUDDataModel::get_value(const StringName &p_key, const Variant &p_default) const {
+	const int32_t *key = key_indices.getptr(p_key);
+	return key ? values[*key] : p_default;
+}
+
+bool HUDDataModel::has_value(const StringName &p_key) const {
+	const int32_t *key = key_indices.getptr(p_key);
+	return key && values[*key].get_type() != Variant::NIL;
+}
+
+PackedStringArray HUDDataModel::get_keys() const {
+	PackedStringArray keys;
+	for (uint32_t i = 0; i < key_names.size(); i++) {
+		if (values[i].get_type() != Variant::NIL) {
+			keys.push_back(key_names[i]);
+		}
+	}
+	return keys;
+}
+
+void HUDDataModel::mark_dirty(const StringName &p_key) {
+	const int32_t key = _get_key(p_key, false);
+	ERR_FAIL_COND_MSG(key < 0, vformat("HUD value \"%s\" doesn't exist.", p_key));
+	if (dirty[key]) {
+		return;
+	}
+	dirty[key] = 1;
+	dirty_keys.push_back(key);
+	if (!flush_queued) {
+		flush_queued = true;
+		callable_mp(this, &HUDDataModel::flush).call_deferred();
+	}
+}
+
+int HUDDataModel::bind_property(const StringName &p_key, Object *p_target, const NodePath &p_property) {
+	ERR_FAIL_NULL_V(p_target, -1);
+	const NodePath path = p_property.get_as_property_path();
+	ERR_FAIL_COND_V(path.get_subname_count() == 0, -1);
+	return _add_binding(p_key, p_target, path.get_subnames(), Callable());
+}
+
+int HUDDataModel::bind_callable(const StringName &p_key, const Callable &p_callable) {
+	ERR_FAIL_COND_V(!p_callable.is_valid(), -1);
+	return _add_binding(p_key, p_callable.get_object(), Vector<StringName>(), p_callable);
+}
+
+void HUDDataModel::unbind(int p_binding) {
+	ERR_FAIL_INDEX(p_binding, int(bindings.size()));
+	ERR_FAIL_COND(bindings[p_binding].key < 0);
+	_remove_binding(p_binding);
+}
+
+void HUDDataModel::unbind_object(Object *p_target) {
+	ERR_FAIL_NULL(p_target);
+	const ObjectID target = p_target->get_instance_id();
+	for (uint32_t i = 0; i < bindings.size(); i++) {
+		if (bindings[i].key >= 0 && bindings[i].target == target) {
+			_remove_binding(i);
+		}
+	}
+}
+
+void HUDDataModel::flush() {
+	flush_queued = false;
+	if (dirty_keys.is_empty()) {
+		return;
+	}
+	flush_count++;
+
+	// Bindings may set values while being updated; those are flushed by
+	// another deferred call instead of extending this one. It still runs
+	// in the same frame if queued while the message queue is flushing.
+	LocalVector<int32_t> keys;
+	SWAP(keys, dirty_keys);
+	for (const int32_t key : keys) {
+		dirty[key] = 0;
+	}
+
+	// A binding may also clear everything, leaving nothing of these to update.
+	const uint64_t cleared = clear_count;
+	LocalVector<int32_t> stale;
+	for (const int32_t key : keys) {
+		const Variant value = values[key];
+		// Copied, so bindings can be added or removed by the callables.
+		const LocalVector<int32_t> key_binding_list = key_bindings[key];
+		for (const int32_t binding : key_binding_list) {
+			if (bindings[binding].key != key) {
+				continue;
+			}
+			if (_push(binding, value)) {
+				update_count++;
+			} else {
+				stale.push_back(binding);
+			}
+			if (clear_count != cleared) {
+				return;
+			}
+		}
+		emit_signal(SNAME("value_changed"), key_names[key], value);
+		if (clear_count != cleared) {
+			return;
+		}
+	}
+
+	for (const int32_t binding : stale) {
+		if (bindings[binding].key >= 0) {
+			_remove_binding(binding);
+		}
+	}
+}
+
+void HUDDataModel::clear() {
+	key_indices.clear();
+	key_names.clear();
+	values.clear();
+	dirty.clear();
+	key_bindings.clear();
+	bindings.clear();
+	free_bindings.clear();
+	binding_count = 0;
+	dirty_keys.clear();
+	clear_count++;
+}
+
+void HUDDataModel::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_value", "key", "value"), &HUDDataModel::set_value);
+	ClassDB::bind_method(D_METHOD("get_value", "key", "default"), &HUDDataModel::get_value, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("has_value", "key"), &HUDDataModel::has_value);
+	ClassDB::bind_method(D_METHOD("get_keys"), &HUDDataModel::get_keys);
+	ClassDB::bind_method(D_METHOD("mark_dirty", "key"), &HUDDataModel::mark_dirty);
+
+	ClassDB::bind_method(D_METHOD("bind_property", "key", "target", "property"), &HUDDataModel::bind_property);
+	ClassDB::bind_method(D_METHOD("bind_callable", "key", "callable"), &HUDDataModel::bind_callable);
+	ClassDB::bind_method(D_METHOD("unbind", "binding"), &HUDDataModel::unbind);
+	ClassDB::bind_method(D_METHOD("unbind_object", "target"), &HUDDataModel::unbind_object);
+	ClassDB::bind_method(D_METHOD("get_binding_count"), &HUDDataModel::get_binding_count);
+
+	ClassDB::bind_method(D_METHOD("flush"), &HUDDataModel::flush);
+	ClassDB::bind_method(D_METHOD("is_flush_queued"), &HUDDataModel::is_flush_queued);
+	ClassDB::bind_method(D_METHOD("get_pending_count"), &HUDDataModel::get_pending_count);
+	ClassDB::bind_method(D_METHOD("get_flush_count"), &HUDDataModel::get_flush_count);
+	ClassDB::bind_method(D_METHOD("get_update_count"), &HUDDataModel::get_update_count);
+
+	ClassDB::bind_method(D_METHOD("clear"), &HUDDataModel::clear);
+
+	ADD_SIGNAL(MethodInfo("value_changed", PropertyInfo(Variant::STRING_NAME, "key"), PropertyInfo(Variant::NIL, "value", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT)));
+}
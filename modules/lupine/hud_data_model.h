@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  hud_data_model.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object_id.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+
+// An observable store of HUD values (health, gold, quest state) that
+// Controls bind their properties to, so the HUD is pushed changes instead of
+// polling every frame. Setting a value only marks its key dirty; all dirty
+// keys are flushed together once per frame from a deferred call, and each
+// flush touches only the bindings of the keys that changed. Values equal to
+// the stored one are dropped, so widgets whose data didn't change are never
+// written to and never relayout.
+class HUDDataModel : public Node {
+	GDCLASS(HUDDataModel, Node);
+
+	struct Binding {
+		int32_t key = -1; // -1 when unused.
+		ObjectID target;
+		Vector<StringName> property;
+		Callable callable;
+	};
+
+	// Values, indexed by key index.
+	HashMap<StringName, int32_t> key_indices;
+	LocalVector<StringName> key_names;
+	LocalVector<Variant> values;
+	LocalVector<uint8_t> dirty;
+	LocalVector<LocalVector<int32_t>> key_bindings;
+
+	LocalVector<Binding> bindings;
+	LocalVector<int32_t> free_bindings;
+	uint32_t binding_count = 0;
+
+	LocalVector<int32_t> dirty_keys;
+	bool flush_queued = false;
+	uint64_t flush_count = 0;
+	uint64_t update_count = 0;
+	uint64_t clear_count = 0; // Lets a flush notice it was cleared by a binding.
+
+	int32_t _get_key(const StringName &p_key, bool p_create);
+	int _add_binding(const StringName &p_key, Object *p_target, const Vector<StringName> &p_property, const Callable &p_callable);
+	void _remove_binding(int32_t p_binding);
+	bool _push(int32_t p_binding, const Variant &p_value);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_value(const StringName &p_key, const Variant &p_value);
+	Variant get_value(const StringName &p_key, const Variant &p_default = Variant()) const;
+	bool has_value(const StringName &p_key) const;
+	PackedStringArray get_keys() const;
+	void mark_dirty(const StringName &p_key);
+
+	int bind_property(const StringName &p_key, Object *p_target, const NodePath &p_property);
+	int bind_callable(const StringName &p_key, const Callable &p_callable);
+	void unbind(int p_binding);
+	void unbind_object(Object *p_target);
+	int get_binding_count() const { return binding_count; }
+
+	void flush();
+	bool is_flush_queued() const { return flush_queued; }
+	int get_pending_count() const { return dirty_keys.size(); }
+	int64_t get_flush_count() const { return flush_count; }
+	int64_t get_update_count() const { return update_count; }
+
+	void clear();
+};
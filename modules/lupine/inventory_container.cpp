@@ -0,0 +1,669 @@
+/**************************************************************************/
+/*  inventory_container.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "inventory_container.h"
+
+#include "core/io/marshalls.h"
+#include "core/templates/hash_set.h"
+
+static const char *INVENTORY_MAGIC = "LINV";
+
+uint32_t InventoryContainer::_intern_item(const StringName &p_id) {
+	const uint32_t *index = item_indices.getptr(p_id);
+	if (index) {
+		return *index;
+	}
+	const uint32_t new_index = item_ids.size();
+	item_indices.insert_new(p_id, new_index);
+	item_ids.push_back(p_id);
+	item_max_stacks.push_back(0);
+	item_totals.push_back(0);
+	item_slots.push_back(LocalVector<uint32_t>());
+	return new_index;
+}
+
+int32_t InventoryContainer::_find_item(const StringName &p_id) const {
+	const uint32_t *index = item_indices.getptr(p_id);
+	return index ? int32_t(*index) : EMPTY;
+}
+
+void InventoryContainer::_set_free(uint32_t p_slot, bool p_free) {
+	const uint64_t bit = uint64_t(1) << (p_slot & 63);
+	if (p_free) {
+		free_slots[p_slot >> 6] |= bit;
+		free_count++;
+	} else {
+		free_slots[p_slot >> 6] &= ~bit;
+		free_count--;
+	}
+}
+
+int32_t InventoryContainer::_find_free() const {
+	if (free_count == 0) {
+		return EMPTY;
+	}
+	for (uint32_t word = 0; word < free_slots.size(); word++) {
+		const uint64_t bits = free_slots[word];
+		if (bits == 0) {
+			continue;
+		}
+		uint32_t bit = 0;
+		while (!(bits & (uint64_t(1) << bit))) {
+			bit++;
+		}
+		return (word << 6) + bit;
+	}
+	return EMPTY;
+}
+
+void InventoryContainer::_link_slot(uint32_t p_item, uint32_t p_slot) {
+	LocalVector<uint32_t> &slots = item_slots[p_item];
+	// Slots are kept sorted, so stacks fill up and empty in slot order.
+	uint32_t pos = slots.size();
+	while (pos > 0 && slots[pos - 1] > p_slot) {
+		pos--;
+	}
+	slots.insert(pos, p_slot);
+}
+
+void InventoryContainer::_unlink_slot(uint32_t p_item, uint32_t p_slot) {
+	LocalVector<uint32_t> &slots = item_slots[p_item];
+	uint32_t low = 0;
+	uint32_t high = slots.size();
+	while (low < high) {
+		const uint32_t mid = (low + high) / 2;
+		if (slots[mid] < p_slot) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	ERR_FAIL_COND(low >= slots.size() || slots[low] != p_slot);
+	slots.remove_at(low);
+}
+
+void InventoryContainer::_fill_slot(uint32_t p_slot, uint32_t p_item, int32_t p_count) {
+	slot_items[p_slot] = p_item;
+	slot_counts[p_slot] = p_count;
+	item_totals[p_item] += p_count;
+	_set_free(p_slot, false);
+	_link_slot(p_item, p_slot);
+	_mark_changed(p_slot);
+}
+
+void InventoryContainer::_empty_slot(uint32_t p_slot) {
+	const int32_t item = slot_items[p_slot];
+	item_totals[item] -= slot_counts[p_slot];
+	_unlink_slot(item, p_slot);
+	slot_items[p_slot] = EMPTY;
+	slot_counts[p_slot] = 0;
+	slot_flags[p_slot] = 0;
+	_set_free(p_slot, true);
+	_mark_changed(p_slot);
+}
+
+void InventoryContainer::_mark_changed(uint32_t p_slot) {
+	changed_slots.push_back(p_slot);
+}
+
+void InventoryContainer::_begin_batch() {
+	batch_depth++;
+}
+
+void InventoryContainer::_end_batch() {
+	batch_depth--;
+	if (batch_depth > 0 || changed_slots.is_empty()) {
+		return;
+	}
+
+	// One notification per operation, however many slots it touched.
+	changed_slots.sort();
+	PackedInt32Array slots;
+	for (uint32_t i = 0; i < changed_slots.size(); i++) {
+		if (i == 0 || changed_slots[i] != changed_slots[i - 1]) {
+			slots.push_back(changed_slots[i]);
+		}
+	}
+	changed_slots.clear();
+	emit_signal(SNAME("slots_changed"), slots);
+}
+
+int64_t InventoryContainer::_get_capacity(uint32_t p_item) const {
+	const int64_t max_stack = _get_max_stack(p_item);
+	int64_t capacity = int64_t(free_count) * max_stack;
+	for (uint32_t slot : item_slots[p_item]) {
+		capacity += MAX(0, max_stack - slot_counts[slot]);
+	}
+	return capacity;
+}
+
+int InventoryContainer::_add(uint32_t p_item, int p_quantity) {
+	const int32_t max_stack = _get_max_stack(p_item);
+
+	// Top up existing stacks first.
+	for (uint32_t slot : item_slots[p_item]) {
+		if (p_quantity == 0) {
+			return 0;
+		}
+		const int32_t amount = MIN(p_quantity, max_stack - slot_counts[slot]);
+		if (amount > 0) {
+			slot_counts[slot] += amount;
+			item_totals[p_item] += amount;
+			p_quantity -= amount;
+			_mark_changed(slot);
+		}
+	}
+
+	while (p_quantity > 0) {
+		const int32_t slot = _find_free();
+		if (slot == EMPTY) {
+			break;
+		}
+		const int32_t amount = MIN(p_quantity, max_stack);
+		_fill_slot(slot, p_item, amount);
+		p_quantity -= amount;
+	}
+	return p_quantity;
+}
+
+int InventoryContainer::_remove(uint32_t p_item, int p_quantity) {
+	int removed = 0;
+	LocalVector<uint32_t> &slots = item_slots[p_item];
+	while (removed < p_quantity && !slots.is_empty()) {
+		const uint32_t slot = slots[0];
+		const int32_t amount = MIN(p_quantity - removed, slot_counts[slot]);
+		removed += amount;
+		if (amount == slot_counts[slot]) {
+			_empty_slot(slot);
+		} else {
+			slot_counts[slot] -= amount;
+			item_totals[p_item] -= amount;
+			_mark_changed(slot);
+		}
+	}
+	return removed;
+}
+
+void InventoryContainer::set_slot_count(int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+	const uint32_t old_count = slot_items.size();
+	const uint32_t new_count = p_count;
+	if (new_count == old_count) {
+		return;
+	}
+
+	_begin_batch();
+	// Items in removed slots are dropped.
+	for (uint32_t slot = new_count; slot < old_count; slot++) {
+		if (slot_items[slot] != EMPTY) {
+			_empty_slot(slot);
+		}
+		_set_free(slot, false);
+	}
+
+	const uint32_t old_words = free_slots.size();
+	free_slots.resize((new_count + 63) / 64);
+	for (uint32_t word = old_words; word < free_slots.size(); word++) {
+		free_slots[word] = 0;
+	}
+	slot_items.resize(new_count);
+	slot_counts.resize(new_count);
+	slot_flags.resize(new_count);
+	for (uint32_t slot = old_count; slot < new_count; slot++) {
+		slot_items[slot] = EMPTY;
+		slot_counts[slot] = 0;
+		slot_flags[slot] = 0;
+		_set_free(slot, true);
+	}
+	_end_batch();
+}
+
+void InventoryContainer::set_default_max_stack(int p_max_stack) {
+	ERR_FAIL_COND(p_max_stack < 1);
+	default_max_stack = p_max_stack;
+}
+
+void InventoryContainer::set_item_max_stack(const StringName &p_id, int p_max_stack) {
+	ERR_FAIL_COND(p_max_stack < 0);
+	item_max_stacks[_intern_item(p_id)] = p_max_stack;
+}
+
+int InventoryContainer::get_item_max_stack(const StringName &p_id) const {
+	const int32_t item = _find_item(p_id);
+	return item == EMPTY ? default_max_stack : _get_max_stack(item);
+}
+
+int InventoryContainer::add_item(const StringName &p_id, int p_quantity) {
+	ERR_FAIL_COND_V(p_quantity < 0, p_quantity);
+	ERR_FAIL_COND_V(p_id == StringName(), p_quantity);
+	_begin_batch();
+	const int leftover = _add(_intern_item(p_id), p_quantity);
+	_end_batch();
+	return leftover;
+}
+
+int InventoryContainer::remove_item(const StringName &p_id, int p_quantity) {
+	ERR_FAIL_COND_V(p_quantity < 0, 0);
+	const int32_t item = _find_item(p_id);
+	if (item == EMPTY) {
+		return 0;
+	}
+	_begin_batch();
+	const int removed = _remove(item, p_quantity);
+	_end_batch();
+	return removed;
+}
+
+int64_t InventoryContainer::get_item_count(const StringName &p_id) const {
+	const int32_t item = _find_item(p_id);
+	return item == EMPTY ? 0 : item_totals[item];
+}
+
+bool InventoryContainer::has_item(const StringName &p_id, int p_quantity) const {
+	return get_item_count(p_id) >= p_quantity;
+}
+
+int64_t InventoryContainer::get_free_capacity(const StringName &p_id) const {
+	const int32_t item = _find_item(p_id);
+	if (item == EMPTY) {
+		return int64_t(free_count) * default_max_stack;
+	}
+	return _get_capacity(item);
+}
+
+PackedInt32Array InventoryContainer::get_item_slots(const StringName &p_id) const {
+	PackedInt32Array result;
+	const int32_t item = _find_item(p_id);
+	if (item == EMPTY) {
+		return result;
+	}
+	const LocalVector<uint32_t> &slots = item_slots[item];
+	result.resize(slots.size());
+	int32_t *w = result.ptrw();
+	for (uint32_t i = 0; i < slots.size(); i++) {
+		w[i] = slots[i];
+	}
+	return result;
+}
+
+PackedStringArray InventoryContainer::get_item_ids() const {
+	PackedStringArray result;
+	for (uint32_t i = 0; i < item_ids.size(); i++) {
+		if (item_totals[i] > 0) {
+			result.push_back(item_ids[i]);
+		}
+	}
+	return result;
+}
+
+Dictionary InventoryContainer::add_items(const Dictionary &p_items) {
+	Dictionary leftovers;
+	_begin_batch();
+	for (const KeyValue<Variant, Variant> &kv : p_items) {
+		const StringName id = kv.key;
+		const int quantity = kv.value;
+		ERR_CONTINUE(quantity < 0 || id == StringName());
+		const int leftover = _add(_intern_item(id), quantity);
+		if (leftover > 0) {
+			leftovers[kv.key] = leftover;
+		}
+	}
+	_end_batch();
+	return leftovers;
+}
+
+bool InventoryContainer::has_items(const Dictionary &p_items) const {
+	for (const KeyValue<Variant, Variant> &kv : p_items) {
+		if (get_item_count(kv.key) < int64_t(kv.value)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool InventoryContainer::remove_items(const Dictionary &p_items) {
+	// All or nothing, as needed for crafting and trading.
+	if (!has_items(p_items)) {
+		return false;
+	}
+	_begin_batch();
+	for (const KeyValue<Variant, Variant> &kv : p_items) {
+		const int32_t item = _find_item(kv.key);
+		if (item != EMPTY) {
+			_remove(item, kv.value);
+		}
+	}
+	_end_batch();
+	return true;
+}
+
+int InventoryContainer::transfer_item(const Ref<InventoryContainer> &p_target, const StringName &p_id, int p_quantity) {
+	ERR_FAIL_COND_V(p_target.is_null(), 0);
+	ERR_FAIL_COND_V(p_target.ptr() == this, 0);
+	ERR_FAIL_COND_V(p_quantity < 0, 0);
+	const int32_t item = _find_item(p_id);
+	if (item == EMPTY) {
+		return 0;
+	}
+
+	InventoryContainer *target = p_target.ptr();
+	const uint32_t target_item = target->_intern_item(p_id);
+	const int amount = MIN(int64_t(p_quantity), MIN(item_totals[item], target->_get_capacity(target_item)));
+	if (amount == 0) {
+		return 0;
+	}
+
+	_begin_batch();
+	target->_begin_batch();
+	_remove(item, amount);
+	target->_add(target_item, amount);
+	target->_end_batch();
+	_end_batch();
+	return amount;
+}
+
+int InventoryContainer::transfer_all(const Ref<InventoryContainer> &p_target) {
+	ERR_FAIL_COND_V(p_target.is_null(), 0);
+	ERR_FAIL_COND_V(p_target.ptr() == this, 0);
+
+	int moved = 0;
+	_begin_batch();
+	p_target->_begin_batch();
+	for (uint32_t item = 0; item < item_ids.size(); item++) {
+		if (item_totals[item] > 0) {
+			moved += transfer_item(p_target, item_ids[item], MIN(item_totals[item], int64_t(INT32_MAX)));
+		}
+	}
+	p_target->_end_batch();
+	_end_batch();
+	return moved;
+}
+
+bool InventoryContainer::is_slot_empty(int p_slot) const {
+	ERR_FAIL_INDEX_V(p_slot, (int)slot_items.size(), true);
+	return slot_items[p_slot] == EMPTY;
+}
+
+StringName InventoryContainer::get_slot_item(int p_slot) const {
+	ERR_FAIL_INDEX_V(p_slot, (int)slot_items.size(), StringName());
+	return slot_items[p_slot] == EMPTY ? StringName() : item_ids[slot_items[p_slot]];
+}
+
+int InventoryContainer::get_slot_quantity(int p_slot) const {
+	ERR_FAIL_INDEX_V(p_slot, (int)slot_items.size(), 0);
+	return slot_counts[p_slot];
+}
+
+void InventoryContainer::set_slot(int p_slot, const StringName &p_id, int p_quantity) {
+	ERR_FAIL_INDEX(p_slot, (int)slot_items.size());
+	if (p_id == StringName() || p_quantity <= 0) {
+		clear_slot(p_slot);
+		return;
+	}
+
+	_begin_batch();
+	const uint32_t flags = slot_flags[p_slot];
+	if (slot_items[p_slot] != EMPTY) {
+		_empty_slot(p_slot);
+	}
+	_fill_slot(p_slot, _intern_item(p_id), p_quantity);
+	slot_flags[p_slot] = flags;
+	_end_batch();
+}
+
+void InventoryContainer::clear_slot(int p_slot) {
+	ERR_FAIL_INDEX(p_slot, (int)slot_items.size());
+	if (slot_items[p_slot] == EMPTY) {
+		return;
+	}
+	_begin_batch();
+	_empty_slot(p_slot);
+	_end_batch();
+}
+
+void InventoryContainer::set_slot_flags(int p_slot, int p_flags) {
+	ERR_FAIL_INDEX(p_slot, (int)slot_items.size());
+	ERR_FAIL_COND_MSG(slot_items[p_slot] == EMPTY, "Flags can only be set on occupied slots.");
+	_begin_batch();
+	slot_flags[p_slot] = p_flags;
+	_mark_changed(p_slot);
+	_end_batch();
+}
+
+int InventoryContainer::get_slot_flags(int p_slot) const {
+	ERR_FAIL_INDEX_V(p_slot, (int)slot_items.size(), 0);
+	return slot_flags[p_slot];
+}
+
+void InventoryContainer::move_slot(int p_from, int p_to) {
+	ERR_FAIL_INDEX(p_from, (int)slot_items.size());
+	ERR_FAIL_INDEX(p_to, (int)slot_items.size());
+	if (p_from == p_to || slot_items[p_from] == EMPTY) {
+		return;
+	}
+
+	_begin_batch();
+	const int32_t from_item = slot_items[p_from];
+	const int32_t from_count = slot_counts[p_from];
+	const uint32_t from_flags = slot_flags[p_from];
+	const int32_t to_item = slot_items[p_to];
+
+	if (to_item == from_item) {
+		// Merge into the target stack.
+		const int32_t amount = MIN(from_count, _get_max_stack(to_item) - slot_counts[p_to]);
+		if (amount > 0) {
+			slot_counts[p_to] += amount;
+			slot_counts[p_from] -= amount;
+			_mark_changed(p_to);
+			_mark_changed(p_from);
+			if (slot_counts[p_from] == 0) {
+				_empty_slot(p_from);
+			}
+		}
+	} else {
+		const int32_t to_count = slot_counts[p_to];
+		const uint32_t to_flags = slot_flags[p_to];
+		_empty_slot(p_from);
+		if (to_item != EMPTY) {
+			_empty_slot(p_to);
+			_fill_slot(p_from, to_item, to_count);
+			slot_flags[p_from] = to_flags;
+		}
+		_fill_slot(p_to, from_item, from_count);
+		slot_flags[p_to] = from_flags;
+	}
+	_end_batch();
+}
+
+int InventoryContainer::find_empty_slot() const {
+	return _find_free();
+}
+
+void InventoryContainer::clear() {
+	_begin_batch();
+	for (uint32_t slot = 0; slot < slot_items.size(); slot++) {
+		if (slot_items[slot] != EMPTY) {
+			_empty_slot(slot);
+		}
+	}
+	_end_batch();
+}
+
+// Layout, all little-endian 32-bit words:
+//   "LINV", version, slot count, item count, default max stack,
+//   item index per slot (-1 when empty), count per slot, flags per slot,
+//   then per item: max stack, UTF-8 byte length, bytes padded to 4.
+// The slot arrays start at a fixed offset, so they can be read in place.
+PackedByteArray InventoryContainer::to_bytes() const {
+	const uint32_t slot_count = slot_items.size();
+	LocalVector<CharString> names;
+	names.resize(item_ids.size());
+	uint32_t size = 20 + slot_count * 12;
+	for (uint32_t i = 0; i < item_ids.size(); i++) {
+		names[i] = String(item_ids[i]).utf8();
+		size += 8 + ((names[i].length() + 3) & ~3);
+	}
+
+	PackedByteArray bytes;
+	bytes.resize(size);
+	uint8_t *w = bytes.ptrw();
+	memset(w, 0, size);
+
+	memcpy(w, INVENTORY_MAGIC, 4);
+	encode_uint32(FORMAT_VERSION, w + 4);
+	encode_uint32(slot_count, w + 8);
+	encode_uint32(item_ids.size(), w + 12);
+	encode_uint32(default_max_stack, w + 16);
+	w += 20;
+
+	for (uint32_t slot = 0; slot < slot_count; slot++) {
+		encode_uint32(slot_items[slot], w + slot * 4);
+		encode_uint32(slot_counts[slot], w + (slot_count + slot) * 4);
+		encode_uint32(slot_flags[slot], w + (slot_count * 2 + slot) * 4);
+	}
+	w += slot_count * 12;
+
+	for (uint32_t i = 0; i < names.size(); i++) {
+		const uint32_t length = names[i].length();
+		encode_uint32(item_max_stacks[i], w);
+		encode_uint32(length, w + 4);
+		memcpy(w + 8, names[i].get_data(), length);
+		w += 8 + ((length + 3) & ~3);
+	}
+	return bytes;
+}
+
+Error InventoryContainer::from_bytes(const PackedByteArray &p_bytes) {
+	const uint8_t *r = p_bytes.ptr();
+	const uint64_t size = p_bytes.size();
+	ERR_FAIL_COND_V(size < 20 || memcmp(r, INVENTORY_MAGIC, 4) != 0, ERR_FILE_UNRECOGNIZED);
+	ERR_FAIL_COND_V(decode_uint32(r + 4) > FORMAT_VERSION, ERR_FILE_UNRECOGNIZED);
+
+	const uint32_t slot_count = decode_uint32(r + 8);
+	const uint32_t item_count = decode_uint32(r + 12);
+	const int32_t max_stack = decode_uint32(r + 16);
+	ERR_FAIL_COND_V(max_stack < 1, ERR_FILE_CORRUPT);
+	ERR_FAIL_COND_V(20 + uint64_t(slot_count) * 12 + uint64_t(item_count) * 8 > size, ERR_FILE_CORRUPT);
+	const uint8_t *slot_data = r + 20;
+
+	// Read the item table before touching the current contents.
+	LocalVector<StringName> ids;
+	LocalVector<int32_t> max_stacks;
+	HashSet<StringName> seen_ids;
+	ids.resize(item_count);
+	max_stacks.resize(item_count);
+	uint64_t offset = 20 + uint64_t(slot_count) * 12;
+	for (uint32_t i = 0; i < item_count; i++) {
+		ERR_FAIL_COND_V(offset + 8 > size, ERR_FILE_CORRUPT);
+		max_stacks[i] = decode_uint32(r + offset);
+		const uint32_t length = decode_uint32(r + offset + 4);
+		ERR_FAIL_COND_V(max_stacks[i] < 0 || offset + 8 + length > size, ERR_FILE_CORRUPT);
+		ids[i] = String::utf8(reinterpret_cast<const char *>(r + offset + 8), length);
+		ERR_FAIL_COND_V_MSG(seen_ids.has(ids[i]), ERR_FILE_CORRUPT, vformat("Duplicate item \"%s\" in inventory data.", ids[i]));
+		seen_ids.insert(ids[i]);
+		offset += 8 + ((uint64_t(length) + 3) & ~uint64_t(3));
+	}
+	for (uint32_t slot = 0; slot < slot_count; slot++) {
+		const int32_t item = decode_uint32(slot_data + slot * 4);
+		const int32_t count = decode_uint32(slot_data + (slot_count + slot) * 4);
+		ERR_FAIL_COND_V(item < EMPTY || item >= int32_t(item_count), ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(item != EMPTY && count <= 0, ERR_FILE_CORRUPT);
+	}
+
+	_begin_batch();
+	clear();
+	item_indices.clear();
+	item_ids.clear();
+	item_max_stacks.clear();
+	item_totals.clear();
+	item_slots.clear();
+	default_max_stack = max_stack;
+	for (uint32_t i = 0; i < item_count; i++) {
+		// Ids are unique, so they get interned in order.
+		item_max_stacks[_intern_item(ids[i])] = max_stacks[i];
+	}
+
+	set_slot_count(slot_count);
+	for (uint32_t slot = 0; slot < slot_count; slot++) {
+		const int32_t item = decode_uint32(slot_data + slot * 4);
+		if (item == EMPTY) {
+			continue;
+		}
+		_fill_slot(slot, item, decode_uint32(slot_data + (slot_count + slot) * 4));
+		slot_flags[slot] = decode_uint32(slot_data + (slot_count * 2 + slot) * 4);
+	}
+	_end_batch();
+	return OK;
+}
+
+void InventoryContainer::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_slot_count", "count"), &InventoryContainer::set_slot_count);
+	ClassDB::bind_method(D_METHOD("get_slot_count"), &InventoryContainer::get_slot_count);
+	ClassDB::bind_method(D_METHOD("set_default_max_stack", "max_stack"), &InventoryContainer::set_default_max_stack);
+	ClassDB::bind_method(D_METHOD("get_default_max_stack"), &InventoryContainer::get_default_max_stack);
+	ClassDB::bind_method(D_METHOD("set_item_max_stack", "id", "max_stack"), &InventoryContainer::set_item_max_stack);
+	ClassDB::bind_method(D_METHOD("get_item_max_stack", "id"), &InventoryContainer::get_item_max_stack);
+
+	ClassDB::bind_method(D_METHOD("add_item", "id", "quantity"), &InventoryContainer::add_item, DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("remove_item", "id", "quantity"), &InventoryContainer::remove_item, DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("get_item_count", "id"), &InventoryContainer::get_item_count);
+	ClassDB::bind_method(D_METHOD("has_item", "id", "quantity"), &InventoryContainer::has_item, DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("get_free_capacity", "id"), &InventoryContainer::get_free_capacity);
+	ClassDB::bind_method(D_METHOD("get_item_slots", "id"), &InventoryContainer::get_item_slots);
+	ClassDB::bind_method(D_METHOD("get_item_ids"), &InventoryContainer::get_item_ids);
+
+	ClassDB::bind_method(D_METHOD("add_items", "items"), &InventoryContainer::add_items);
+	ClassDB::bind_method(D_METHOD("remove_items", "items"), &InventoryContainer::remove_items);
+	ClassDB::bind_method(D_METHOD("has_items", "items"), &InventoryContainer::has_items);
+	ClassDB::bind_method(D_METHOD("transfer_item", "target", "id", "quantity"), &InventoryContainer::transfer_item);
+	ClassDB::bind_method(D_METHOD("transfer_all", "target"), &InventoryContainer::transfer_all);
+
+	ClassDB::bind_method(D_METHOD("is_slot_empty", "slot"), &InventoryContainer::is_slot_empty);
+	ClassDB::bind_method(D_METHOD("get_slot_item", "slot"), &InventoryContainer::get_slot_item);
+	ClassDB::bind_method(D_METHOD("get_slot_quantity", "slot"), &InventoryContainer::get_slot_quantity);
+	ClassDB::bind_method(D_METHOD("set_slot", "slot", "id", "quantity"), &InventoryContainer::set_slot);
+	ClassDB::bind_method(D_METHOD("clear_slot", "slot"), &InventoryContainer::clear_slot);
+	ClassDB::bind_method(D_METHOD("set_slot_flags", "slot", "flags"), &InventoryContainer::set_slot_flags);
+	ClassDB::bind_method(D_METHOD("get_slot_flags", "slot"), &InventoryContainer::get_slot_flags);
+	ClassDB::bind_method(D_METHOD("move_slot", "from", "to"), &InventoryContainer::move_slot);
+	ClassDB::bind_method(D_METHOD("find_empty_slot"), &InventoryContainer::find_empty_slot);
+	ClassDB::bind_method(D_METHOD("get_empty_slot_count"), &InventoryContainer::get_empty_slot_count);
+	ClassDB::bind_method(D_METHOD("clear"), &InventoryContainer::clear);
+
+	ClassDB::bind_method(D_METHOD("to_bytes"), &InventoryContainer::to_bytes);
+	ClassDB::bind_method(D_METHOD("from_bytes", "bytes"), &InventoryContainer::from_bytes);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "slot_count", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_slot_count", "get_slot_count");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "default_max_stack", PROPERTY_HINT_RANGE, "1,999,1,or_greater"), "set_default_max_stack", "get_default_max_stack");
+
+	ADD_SIGNAL(MethodInfo("slots_changed", PropertyInfo(Variant::PACKED_INT32_ARRAY, "slots")));
+
+	BIND_CONSTANT(EMPTY);
+}
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  inventory_container.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Slot-based item container with struct-of-arrays storage.
+// Slots only store an index into the item table, a count and flags. Every
+// item keeps the list of slots holding it and its total count, so lookups,
+// stacking and removal never scan the whole container.
+class InventoryContainer : public RefCounted {
+	GDCLASS(InventoryContainer, RefCounted);
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 1;
+	static constexpr int32_t EMPTY = -1;
+
+private:
+	// Per slot.
+	LocalVector<int32_t> slot_items; // Item index, or EMPTY.
+	LocalVector<int32_t> slot_counts;
+	LocalVector<uint32_t> slot_flags;
+	LocalVector<uint64_t> free_slots; // Bitset of empty slots.
+	uint32_t free_count = 0;
+
+	// Per item.
+	AHashMap<StringName, uint32_t> item_indices;
+	LocalVector<StringName> item_ids;
+	LocalVector<int32_t> item_max_stacks; // 0 means default_max_stack.
+	LocalVector<int64_t> item_totals;
+	LocalVector<LocalVector<uint32_t>> item_slots; // Sorted.
+
+	int32_t default_max_stack = 1;
+
+	LocalVector<uint32_t> changed_slots;
+	int batch_depth = 0;
+
+	uint32_t _intern_item(const StringName &p_id);
+	int32_t _find_item(const StringName &p_id) const;
+	_FORCE_INLINE_ int32_t _get_max_stack(uint32_t p_item) const {
+		return item_max_stacks[p_item] > 0 ? item_max_stacks[p_item] : default_max_stack;
+	}
+
+	void _set_free(uint32_t p_slot, bool p_free);
+	int32_t _find_free() const;
+	void _link_slot(uint32_t p_item, uint32_t p_slot);
+	void _unlink_slot(uint32_t p_item, uint32_t p_slot);
+	void _fill_slot(uint32_t p_slot, uint32_t p_item, int32_t p_count);
+	void _empty_slot(uint32_t p_slot);
+	void _mark_changed(uint32_t p_slot);
+	void _begin_batch();
+	void _end_batch();
+
+	int64_t _get_capacity(uint32_t p_item) const;
+	int _add(uint32_t p_item, int p_quantity);
+	int _remove(uint32_t p_item, int p_quantity);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_slot_count(int p_count);
+	int get_slot_count() const { return slot_items.size(); }
+	void set_default_max_stack(int p_max_stack);
+	int get_default_max_stack() const { return default_max_stack; }
+
+	void set_item_max_stack(const StringName &p_id, int p_max_stack);
+	int get_item_max_stack(const StringName &p_id) const;
+
+	int add_item(const StringName &p_id, int p_quantity = 1);
+	int remove_item(const StringName &p_id, int p_quantity = 1);
+	int64_t get_item_count(const StringName &p_id) const;
+	bool has_item(const StringName &p_id, int p_quantity = 1) const;
+	int64_t get_free_capacity(const StringName &p_id) const;
+	PackedInt32Array get_item_slots(const StringName &p_id) const;
+	PackedStringArray get_item_ids() const;
+
+	Dictionary add_items(const Dictionary &p_items);
+	bool remove_items(const Dictionary &p_items);
+	bool has_items(const Dictionary &p_items) const;
+	int transfer_item(const Ref<InventoryContainer> &p_target, const StringName &p_id, int p_quantity);
+	int transfer_all(const Ref<InventoryContainer> &p_target);
+
+	bool is_slot_empty(int p_slot) const;
+	StringName get_slot_item(int p_slot) const;
+	int get_slot_quantity(int p_slot) const;
+	void set_slot(int p_slot, const StringName &p_id, int p_quantity);
+	void clear_slot(int p_slot);
+	void set_slot_flags(int p_slot, int p_flags);
+	int get_slot_flags(int p_slot) const;
+	void move_slot(int p_from, int p_to);
+	int find_empty_slot() const;
+	int get_empty_slot_count() const { return free_count; }
+	void clear();
+
+	PackedByteArray to_bytes() const;
+	Error from_bytes(const PackedByteArray &p_bytes);
+};
@@ -0,0 +1,561 @@
+/**************************************************************************/
+/*  quest_runtime.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "quest_runtime.h"
+
+static const char *objective_type_names[QuestRuntime::OBJECTIVE_MAX] = {
+	"talk",
+	"kill",
+	"collect",
+	"deliver",
+	"escort",
+	"reach_location",
+	"interact",
+	"custom",
+};
+
+int32_t QuestRuntime::_find_quest(const StringName &p_id) const {
+	const uint32_t *index = quest_indices.getptr(p_id);
+	return index ? int32_t(*index) : -1;
+}
+
+int32_t QuestRuntime::_find_objective(const StringName &p_quest, const StringName &p_objective) const {
+	const int32_t quest = _find_quest(p_quest);
+	if (quest < 0) {
+		return -1;
+	}
+	const Quest &q = quests[quest];
+	for (uint32_t i = q.first_objective; i < q.first_objective + q.objective_count; i++) {
+		if (objectives[i].id == p_objective) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+int QuestRuntime::_parse_objective_type(const Variant &p_type) {
+	if (p_type.get_type() == Variant::INT || p_type.get_type() == Variant::FLOAT) {
+		const int type = p_type;
+		return type >= 0 && type < OBJECTIVE_MAX ? type : -1;
+	}
+	const String name = String(p_type).to_lower();
+	if (name == "reach") {
+		return OBJECTIVE_REACH_LOCATION;
+	}
+	for (int i = 0; i < OBJECTIVE_MAX; i++) {
+		if (name == objective_type_names[i]) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void QuestRuntime::_listen(uint32_t p_objective) {
+	Objective &objective = objectives[p_objective];
+	if (objective.listener >= 0) {
+		return;
+	}
+	LocalVector<uint32_t> &list = listeners[objective.type][objective.target];
+	objective.listener = list.size();
+	list.push_back(p_objective);
+}
+
+void QuestRuntime::_unlisten(uint32_t p_objective) {
+	Objective &objective = objectives[p_objective];
+	if (objective.listener < 0) {
+		return;
+	}
+	LocalVector<uint32_t> *list = listeners[objective.type].getptr(objective.target);
+	ERR_FAIL_NULL(list);
+
+	// Swap with the last listener to keep removal O(1).
+	const uint32_t last = (*list)[list->size() - 1];
+	(*list)[objective.listener] = last;
+	objectives[last].listener = objective.listener;
+	list->resize(list->size() - 1);
+	objective.listener = -1;
+}
+
+void QuestRuntime::_reset_objectives(uint32_t p_quest) {
+	Quest &quest = quests[p_quest];
+	quest.remaining = 0;
+	for (uint32_t i = quest.first_objective; i < quest.first_objective + quest.objective_count; i++) {
+		_unlisten(i);
+		Objective &objective = objectives[i];
+		objective.progress = 0;
+		objective.completed = false;
+		objective.pending_prerequisites = objective.prerequisite_count;
+		if (!objective.optional) {
+			quest.remaining++;
+		}
+	}
+}
+
+void QuestRuntime::_stop_quest(uint32_t p_quest, QuestStatus p_status) {
+	Quest &quest = quests[p_quest];
+	for (uint32_t i = quest.first_objective; i < quest.first_objective + quest.objective_count; i++) {
+		_unlisten(i);
+	}
+	quest.status = p_status;
+
+	const StringName id = quest.id;
+	if (p_status == STATUS_COMPLETED) {
+		emit_signal(SNAME("quest_completed"), id);
+	} else if (p_status == STATUS_FAILED) {
+		emit_signal(SNAME("quest_failed"), id);
+	}
+}
+
+void QuestRuntime::_complete_objective(uint32_t p_objective) {
+	Objective &objective = objectives[p_objective];
+	const uint32_t quest_index = objective.quest;
+	Quest &quest = quests[quest_index];
+
+	objective.completed = true;
+	_unlisten(p_objective);
+	for (uint32_t dependent : objective.dependents) {
+		Objective &next = objectives[dependent];
+		next.pending_prerequisites--;
+		if (next.pending_prerequisites == 0 && !next.completed) {
+			_listen(dependent);
+		}
+	}
+
+	bool finished = false;
+	if (!objective.optional) {
+		quest.remaining--;
+		finished = quest.remaining == 0;
+	}
+
+	// Signal handlers may change the runtime, so only use copies from here.
+	const StringName quest_id = quest.id;
+	emit_signal(SNAME("objective_completed"), quest_id, objective.id);
+	if (finished && quest_index < quests.size() && quests[quest_index].id == quest_id && quests[quest_index].status == STATUS_ACTIVE && quests[quest_index].remaining == 0) {
+		_stop_quest(quest_index, STATUS_COMPLETED);
+	}
+}
+
+Error QuestRuntime::add_quest(const Dictionary &p_quest) {
+	const StringName id = p_quest.get("id", String());
+	ERR_FAIL_COND_V_MSG(id == StringName(), ERR_INVALID_DATA, "Quest has no id.");
+	ERR_FAIL_COND_V_MSG(quest_indices.has(id), ERR_ALREADY_EXISTS, vformat("Quest \"%s\" already exists.", id));
+
+	Quest quest;
+	quest.id = id;
+	quest.first_objective = objectives.size();
+	if (int(p_quest.get("status", STATUS_INACTIVE)) == STATUS_AVAILABLE) {
+		quest.status = STATUS_AVAILABLE;
+	}
+	const Array prerequisites = p_quest.get("prerequisites", Array());
+	for (int i = 0; i < prerequisites.size(); i++) {
+		quest.prerequisites.push_back(prerequisites[i]);
+	}
+
+	// Build the objectives aside, so invalid data leaves the runtime unchanged.
+	const Array data = p_quest.get("objectives", Array());
+	LocalVector<Objective> new_objectives;
+	AHashMap<StringName, uint32_t> local_indices;
+	new_objectives.resize(data.size());
+	for (int i = 0; i < data.size(); i++) {
+		const Dictionary entry = data[i];
+		const Dictionary parameters = entry.get("parameters", Dictionary());
+		Objective &objective = new_objectives[i];
+
+		objective.id = entry.get("id", vformat("objective_%d", i));
+		ERR_FAIL_COND_V_MSG(local_indices.has(objective.id), ERR_INVALID_DATA, vformat("Quest \"%s\" has several objectives named \"%s\".", id, objective.id));
+		local_indices.insert(objective.id, i);
+
+		const int type = _parse_objective_type(entry.get("type", OBJECTIVE_CUSTOM));
+		ERR_FAIL_COND_V_MSG(type < 0, ERR_INVALID_DATA, vformat("Objective \"%s\" of quest \"%s\" has an unknown type.", objective.id, id));
+		objective.type = ObjectiveType(type);
+		objective.quest = quests.size();
+		objective.target = parameters.get("target", entry.get("target", String()));
+		objective.amount = MAX(1, int(parameters.get("amount", entry.get("target_amount", 1))));
+		objective.optional = entry.get("is_optional", entry.get("optional", false));
+	}
+	for (int i = 0; i < data.size(); i++) {
+		const Dictionary entry = data[i];
+		const Array objective_prerequisites = entry.get("prerequisites", Array());
+		for (int j = 0; j < objective_prerequisites.size(); j++) {
+			const uint32_t *prerequisite = local_indices.getptr(objective_prerequisites[j]);
+			ERR_FAIL_NULL_V_MSG(prerequisite, ERR_INVALID_DATA, vformat("Objective \"%s\" of quest \"%s\" requires unknown objective \"%s\".", new_objectives[i].id, id, objective_prerequisites[j]));
+			new_objectives[*prerequisite].dependents.push_back(quest.first_objective + i);
+			new_objectives[i].prerequisite_count++;
+		}
+	}
+
+	quest.objective_count = new_objectives.size();
+	for (Objective &objective : new_objectives) {
+		objectives.push_back(objective);
+	}
+	quest_indices.insert(id, quests.size());
+	quests.push_back(quest);
+	_reset_objectives(quests.size() - 1);
+	return OK;
+}
+
+Error QuestRuntime::load_quests(const Variant &p_quests) {
+	ERR_FAIL_COND_V(p_quests.get_type() != Variant::DICTIONARY && p_quests.get_type() != Variant::ARRAY, ERR_INVALID_PARAMETER);
+	clear();
+
+	Error error = OK;
+	if (p_quests.get_type() == Variant::DICTIONARY) {
+		// Quest databases keyed by id, as exported by the quest designer.
+		const Dictionary database = p_quests;
+		for (const KeyValue<Variant, Variant> &kv : database) {
+			Dictionary quest = kv.value;
+			if (!quest.has("id")) {
+				quest = quest.duplicate();
+				quest["id"] = kv.key;
+			}
+			const Error err = add_quest(quest);
+			if (err != OK) {
+				error = err;
+			}
+		}
+	} else {
+		const Array list = p_quests;
+		for (int i = 0; i < list.size(); i++) {
+			const Error err = add_quest(list[i]);
+			if (err != OK) {
+				error = err;
+			}
+		}
+	}
+	return error;
+}
+
+bool QuestRuntime::has_quest(const StringName &p_quest) const {
+	return quest_indices.has(p_quest);
+}
+
+PackedStringArray QuestRuntime::get_quest_ids() const {
+	PackedStringArray ids;
+	for (const Quest &quest : quests) {
+		ids.push_back(quest.id);
+	}
+	return ids;
+}
+
+void QuestRuntime::clear() {
+	quests.clear();
+	objectives.clear();
+	quest_indices.clear();
+	for (int i = 0; i < OBJECTIVE_MAX; i++) {
+		listeners[i].clear();
+	}
+}
+
+bool QuestRuntime::can_start_quest(const StringName &p_quest) const {
+	const int32_t index = _find_quest(p_quest);
+	if (index < 0) {
+		return false;
+	}
+	const Quest &quest = quests[index];
+	if (quest.status != STATUS_INACTIVE && quest.status != STATUS_AVAILABLE) {
+		return false;
+	}
+	for (const StringName &prerequisite : quest.prerequisites) {
+		if (get_quest_status(prerequisite) != STATUS_COMPLETED) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool QuestRuntime::unlock_quest(const StringName &p_quest) {
+	const int32_t index = _find_quest(p_quest);
+	ERR_FAIL_COND_V_MSG(index < 0, false, vformat("Unknown quest \"%s\".", p_quest));
+	if (quests[index].status != STATUS_INACTIVE) {
+		return false;
+	}
+	quests[index].status = STATUS_AVAILABLE;
+	return true;
+}
+
+bool QuestRuntime::start_quest(const StringName &p_quest) {
+	ERR_FAIL_COND_V_MSG(!has_quest(p_quest), false, vformat("Unknown quest \"%s\".", p_quest));
+	if (!can_start_quest(p_quest)) {
+		return false;
+	}
+
+	const uint32_t index = quest_indices[p_quest];
+	_reset_objectives(index);
+	Quest &quest = quests[index];
+	quest.status = STATUS_ACTIVE;
+	for (uint32_t i = quest.first_objective; i < quest.first_objective + quest.objective_count; i++) {
+		if (objectives[i].pending_prerequisites == 0) {
+			_listen(i);
+		}
+	}
+	emit_signal(SNAME("quest_started"), p_quest);
+	return true;
+}
+
+bool QuestRuntime::complete_quest(const StringName &p_quest) {
+	const int32_t index = _find_quest(p_quest);
+	if (index < 0 || quests[index].status != STATUS_ACTIVE) {
+		return false;
+	}
+	_stop_quest(index, STATUS_COMPLETED);
+	return true;
+}
+
+bool QuestRuntime::fail_quest(const StringName &p_quest) {
+	const int32_t index = _find_quest(p_quest);
+	if (index < 0 || quests[index].status != STATUS_ACTIVE) {
+		return false;
+	}
+	_stop_quest(index, STATUS_FAILED);
+	return true;
+}
+
+bool QuestRuntime::reset_quest(const StringName &p_quest) {
+	const int32_t index = _find_quest(p_quest);
+	if (index < 0) {
+		return false;
+	}
+	_reset_objectives(index);
+	quests[index].status = STATUS_INACTIVE;
+	return true;
+}
+
+QuestRuntime::QuestStatus QuestRuntime::get_quest_status(const StringName &p_quest) const {
+	const int32_t index = _find_quest(p_quest);
+	return index < 0 ? STATUS_INACTIVE : quests[index].status;
+}
+
+PackedStringArray QuestRuntime::get_quests_with_status(QuestStatus p_status) const {
+	PackedStringArray ids;
+	for (const Quest &quest : quests) {
+		if (quest.status == p_status) {
+			ids.push_back(quest.id);
+		}
+	}
+	return ids;
+}
+
+int QuestRuntime::post_event(ObjectiveType p_type, const StringName &p_target, int p_amount, const StringName &p_quest) {
+	ERR_FAIL_INDEX_V(p_type, OBJECTIVE_MAX, 0);
+	if (p_amount <= 0) {
+		return 0;
+	}
+
+	// Objectives with an empty target listen to every target.
+	LocalVector<uint32_t> matches;
+	const LocalVector<uint32_t> *list = listeners[p_type].getptr(p_target);
+	if (list) {
+		matches = *list;
+	}
+	if (p_target != StringName()) {
+		list = listeners[p_type].getptr(StringName());
+		if (list) {
+			for (uint32_t objective : *list) {
+				matches.push_back(objective);
+			}
+		}
+	}
+
+	int updated = 0;
+	for (uint32_t index : matches) {
+		// Earlier signal handlers may have changed the runtime.
+		if (index >= objectives.size() || objectives[index].listener < 0) {
+			continue;
+		}
+		Objective &objective = objectives[index];
+		const StringName quest_id = quests[objective.quest].id;
+		if (p_quest != StringName() && quest_id != p_quest) {
+			continue;
+		}
+
+		objective.progress = MIN(objective.amount, objective.progress + p_amount);
+		updated++;
+		const bool done = objective.progress >= objective.amount;
+		emit_signal(SNAME("objective_progressed"), quest_id, objective.id, objective.progress, objective.amount);
+		if (done && index < objectives.size() && objectives[index].listener >= 0 && objectives[index].progress >= objectives[index].amount) {
+			_complete_objective(index);
+		}
+	}
+	return updated;
+}
+
+int QuestRuntime::get_listener_count(ObjectiveType p_type, const StringName &p_target) const {
+	ERR_FAIL_INDEX_V(p_type, OBJECTIVE_MAX, 0);
+	const LocalVector<uint32_t> *list = listeners[p_type].getptr(p_target);
+	return list ? list->size() : 0;
+}
+
+PackedStringArray QuestRuntime::get_objective_ids(const StringName &p_quest) const {
+	PackedStringArray ids;
+	const int32_t index = _find_quest(p_quest);
+	if (index < 0) {
+		return ids;
+	}
+	const Quest &quest = quests[index];
+	for (uint32_t i = quest.first_objective; i < quest.first_objective + quest.objective_count; i++) {
+		ids.push_back(objectives[i].id);
+	}
+	return ids;
+}
+
+int QuestRuntime::get_objective_progress(const StringName &p_quest, const StringName &p_objective) const {
+	const int32_t index = _find_objective(p_quest, p_objective);
+	return index < 0 ? 0 : objectives[index].progress;
+}
+
+int QuestRuntime::get_objective_amount(const StringName &p_quest, const StringName &p_objective) const {
+	const int32_t index = _find_objective(p_quest, p_objective);
+	return index < 0 ? 0 : objectives[index].amount;
+}
+
+bool QuestRuntime::is_objective_completed(const StringName &p_quest, const StringName &p_objective) const {
+	const int32_t index = _find_objective(p_quest, p_objective);
+	return index >= 0 && objectives[index].completed;
+}
+
+bool QuestRuntime::is_objective_listening(const StringName &p_quest, const StringName &p_objective) const {
+	const int32_t index = _find_objective(p_quest, p_objective);
+	return index >= 0 && objectives[index].listener >= 0;
+}
+
+Dictionary QuestRuntime::get_state() const {
+	Dictionary state;
+	for (const Quest &quest : quests) {
+		if (quest.status == STATUS_INACTIVE) {
+			continue;
+		}
+		PackedInt32Array progress;
+		progress.resize(quest.objective_count);
+		int32_t *w = progress.ptrw();
+		for (uint32_t i = 0; i < quest.objective_count; i++) {
+			const Objective &objective = objectives[quest.first_objective + i];
+			// Completed objectives can be behind on progress when completed by hand.
+			w[i] = objective.completed ? objective.amount : objective.progress;
+		}
+		Dictionary entry;
+		entry["status"] = quest.status;
+		entry["progress"] = progress;
+		state[quest.id] = entry;
+	}
+	return state;
+}
+
+void QuestRuntime::set_state(const Dictionary &p_state) {
+	for (uint32_t index = 0; index < quests.size(); index++) {
+		_reset_objectives(index);
+		Quest &quest = quests[index];
+		quest.status = STATUS_INACTIVE;
+
+		const Dictionary entry = p_state.get(quest.id, Dictionary());
+		if (entry.is_empty()) {
+			continue;
+		}
+		quest.status = QuestStatus(CLAMP(int(entry.get("status", STATUS_INACTIVE)), int(STATUS_INACTIVE), int(STATUS_FAILED)));
+
+		const PackedInt32Array progress = entry.get("progress", PackedInt32Array());
+		const uint32_t first = quest.first_objective;
+		for (uint32_t i = 0; i < quest.objective_count && i < (uint32_t)progress.size(); i++) {
+			Objective &objective = objectives[first + i];
+			objective.progress = CLAMP(progress[i], 0, objective.amount);
+			objective.completed = objective.progress >= objective.amount;
+		}
+		for (uint32_t i = first; i < first + quest.objective_count; i++) {
+			const Objective &objective = objectives[i];
+			if (!objective.completed) {
+				continue;
+			}
+			for (uint32_t dependent : objective.dependents) {
+				objectives[dependent].pending_prerequisites--;
+			}
+			if (!objective.optional) {
+				quest.remaining--;
+			}
+		}
+		if (quest.status != STATUS_ACTIVE) {
+			continue;
+		}
+		for (uint32_t i = first; i < first + quest.objective_count; i++) {
+			if (!objectives[i].completed && objectives[i].pending_prerequisites == 0) {
+				_listen(i);
+			}
+		}
+	}
+}
+
+void QuestRuntime::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_quest", "quest"), &QuestRuntime::add_quest);
+	ClassDB::bind_method(D_METHOD("load_quests", "quests"), &QuestRuntime::load_quests);
+	ClassDB::bind_method(D_METHOD("has_quest", "quest"), &QuestRuntime::has_quest);
+	ClassDB::bind_method(D_METHOD("get_quest_ids"), &QuestRuntime::get_quest_ids);
+	ClassDB::bind_method(D_METHOD("clear"), &QuestRuntime::clear);
+
+	ClassDB::bind_method(D_METHOD("can_start_quest", "quest"), &QuestRuntime::can_start_quest);
+	ClassDB::bind_method(D_METHOD("unlock_quest", "quest"), &QuestRuntime::unlock_quest);
+	ClassDB::bind_method(D_METHOD("start_quest", "quest"), &QuestRuntime::start_quest);
+	ClassDB::bind_method(D_METHOD("complete_quest", "quest"), &QuestRuntime::complete_quest);
+	ClassDB::bind_method(D_METHOD("fail_quest", "quest"), &QuestRuntime::fail_quest);
+	ClassDB::bind_method(D_METHOD("reset_quest", "quest"), &QuestRuntime::reset_quest);
+	ClassDB::bind_method(D_METHOD("get_quest_status", "quest"), &QuestRuntime::get_quest_status);
+	ClassDB::bind_method(D_METHOD("get_quests_with_status", "status"), &QuestRuntime::get_quests_with_status);
+
+	ClassDB::bind_method(D_METHOD("post_event", "type", "target", "amount", "quest"), &QuestRuntime::post_event, DEFVAL(1), DEFVAL(StringName()));
+	ClassDB::bind_method(D_METHOD("get_listener_count", "type", "target"), &QuestRuntime::get_listener_count);
+
+	ClassDB::bind_method(D_METHOD("get_objective_ids", "quest"), &QuestRuntime::get_objective_ids);
+	ClassDB::bind_method(D_METHOD("get_objective_progress", "quest", "objective"), &QuestRuntime::get_objective_progress);
+	ClassDB::bind_method(D_METHOD("get_objective_amount", "quest", "objective"), &QuestRuntime::get_objective_amount);
+	ClassDB::bind_method(D_METHOD("is_objective_completed", "quest", "objective"), &QuestRuntime::is_objective_completed);
+	ClassDB::bind_method(D_METHOD("is_objective_listening", "quest", "objective"), &QuestRuntime::is_objective_listening);
+
+	ClassDB::bind_method(D_METHOD("get_state"), &QuestRuntime::get_state);
+	ClassDB::bind_method(D_METHOD("set_state", "state"), &QuestRuntime::set_state);
+
+	ADD_SIGNAL(MethodInfo("quest_started", PropertyInfo(Variant::STRING_NAME, "quest")));
+	ADD_SIGNAL(MethodInfo("quest_completed", PropertyInfo(Variant::STRING_NAME, "quest")));
+	ADD_SIGNAL(MethodInfo("quest_failed", PropertyInfo(Variant::STRING_NAME, "quest")));
+	ADD_SIGNAL(MethodInfo("objective_progressed", PropertyInfo(Variant::STRING_NAME, "quest"), PropertyInfo(Variant::STRING_NAME, "objective"), PropertyInfo(Variant::INT, "progress"), PropertyInfo(Variant::INT, "amount")));
+	ADD_SIGNAL(MethodInfo("objective_completed", PropertyInfo(Variant::STRING_NAME, "quest"), PropertyInfo(Variant::STRING_NAME, "objective")));
+
+	BIND_ENUM_CONSTANT(OBJECTIVE_TALK);
+	BIND_ENUM_CONSTANT(OBJECTIVE_KILL);
+	BIND_ENUM_CONSTANT(OBJECTIVE_COLLECT);
+	BIND_ENUM_CONSTANT(OBJECTIVE_DELIVER);
+	BIND_ENUM_CONSTANT(OBJECTIVE_ESCORT);
+	BIND_ENUM_CONSTANT(OBJECTIVE_REACH_LOCATION);
+	BIND_ENUM_CONSTANT(OBJECTIVE_INTERACT);
+	BIND_ENUM_CONSTANT(OBJECTIVE_CUSTOM);
+	BIND_ENUM_CONSTANT(OBJECTIVE_MAX);
+
+	BIND_ENUM_CONSTANT(STATUS_INACTIVE);
+	BIND_ENUM_CONSTANT(STATUS_AVAILABLE);
+	BIND_ENUM_CONSTANT(STATUS_ACTIVE);
+	BIND_ENUM_CONSTANT(STATUS_COMPLETED);
+	BIND_ENUM_CONSTANT(STATUS_FAILED);
+}
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  quest_runtime.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Quest progress tracking driven by gameplay events.
+// Objectives of active quests are indexed by (type, target), so an event
+// only visits the objectives listening for it, and quest completion is
+// tracked with a counter of remaining required objectives instead of
+// rescanning every quest.
+// Quest data uses the field names of the editor's LupineQuest structures,
+// and the enums below match their values.
+class QuestRuntime : public RefCounted {
+	GDCLASS(QuestRuntime, RefCounted);
+
+public:
+	enum ObjectiveType {
+		OBJECTIVE_TALK,
+		OBJECTIVE_KILL,
+		OBJECTIVE_COLLECT,
+		OBJECTIVE_DELIVER,
+		OBJECTIVE_ESCORT,
+		OBJECTIVE_REACH_LOCATION,
+		OBJECTIVE_INTERACT,
+		OBJECTIVE_CUSTOM,
+		OBJECTIVE_MAX,
+	};
+
+	enum QuestStatus {
+		STATUS_INACTIVE,
+		STATUS_AVAILABLE,
+		STATUS_ACTIVE,
+		STATUS_COMPLETED,
+		STATUS_FAILED,
+	};
+
+private:
+	struct Objective {
+		StringName id;
+		StringName target; // Empty matches any target.
+		uint32_t quest = 0;
+		ObjectiveType type = OBJECTIVE_CUSTOM;
+		int32_t amount = 1;
+		int32_t progress = 0;
+		bool optional = false;
+		bool completed = false;
+		uint32_t prerequisite_count = 0;
+		uint32_t pending_prerequisites = 0;
+		LocalVector<uint32_t> dependents;
+		int32_t listener = -1; // Position in the event index, -1 when not listening.
+	};
+
+	struct Quest {
+		StringName id;
+		QuestStatus status = STATUS_INACTIVE;
+		LocalVector<StringName> prerequisites;
+		uint32_t first_objective = 0;
+		uint32_t objective_count = 0;
+		uint32_t remaining = 0; // Required objectives left.
+	};
+
+	LocalVector<Quest> quests;
+	LocalVector<Objective> objectives;
+	AHashMap<StringName, uint32_t> quest_indices;
+	// Listening objectives, per type and target.
+	AHashMap<StringName, LocalVector<uint32_t>> listeners[OBJECTIVE_MAX];
+
+	int32_t _find_quest(const StringName &p_id) const;
+	int32_t _find_objective(const StringName &p_quest, const StringName &p_objective) const;
+	static int _parse_objective_type(const Variant &p_type);
+
+	void _listen(uint32_t p_objective);
+	void _unlisten(uint32_t p_objective);
+	void _reset_objectives(uint32_t p_quest);
+	void _stop_quest(uint32_t p_quest, QuestStatus p_status);
+	void _complete_objective(uint32_t p_objective);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error add_quest(const Dictionary &p_quest);
+	Error load_quests(const Variant &p_quests);
+	bool has_quest(const StringName &p_quest) const;
+	PackedStringArray get_quest_ids() const;
+	void clear();
+
+	bool can_start_quest(const StringName &p_quest) const;
+	bool unlock_quest(const StringName &p_quest);
+	bool start_quest(const StringName &p_quest);
+	bool complete_quest(const StringName &p_quest);
+	bool fail_quest(const StringName &p_quest);
+	bool reset_quest(const StringName &p_quest);
+	QuestStatus get_quest_status(const StringName &p_quest) const;
+	PackedStringArray get_quests_with_status(QuestStatus p_status) const;
+
+	int post_event(ObjectiveType p_type, const StringName &p_target, int p_amount = 1, const StringName &p_quest = StringName());
+	int get_listener_count(ObjectiveType p_type, const StringName &p_target) const;
+
+	PackedStringArray get_objective_ids(const StringName &p_quest) const;
+	int get_objective_progress(const StringName &p_quest, const StringName &p_objective) const;
+	int get_objective_amount(const StringName &p_quest, const StringName &p_objective) const;
+	bool is_objective_completed(const StringName &p_quest, const StringName &p_objective) const;
+	bool is_objective_listening(const StringName &p_quest, const StringName &p_objective) const;
+
+	Dictionary get_state() const;
+	void set_state(const Dictionary &p_state);
+};
+
+VARIANT_ENUM_CAST(QuestRuntime::ObjectiveType);
+VARIANT_ENUM_CAST(QuestRuntime::QuestStatus);
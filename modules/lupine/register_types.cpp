@@ -0,0 +1,127 @@
+/**************************************************************************/
+/*  register_types.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "register_types.h"
+
+#include "battle_simulator.h"
+#include "collectible_field.h"
+#include "crowd_2d.h"
+#include "dialogue_program.h"
+#include "effect_scheduler.h"
+#include "hud_data_model.h"
+#include "inventory_container.h"
+#include "quest_runtime.h"
+#include "relationship_graph.h"
+#include "save_game_state.h"
+#include "screen_effects_compositor.h"
+#include "tactical_grid.h"
+#include "vn_asset_streamer.h"
+#include "vn_script.h"
+#include "world_state.h"
+
+#include "core/config/engine.h"
+#include "core/object/class_db.h"
+
+#ifdef TOOLS_ENABLED
+#include "editor/editor_node.h"
+#include "editor/export/editor_export.h"
+#include "editor/resource_importer_vn_script.h"
+#include "editor/vn_asset_index_export_plugin.h"
+
+static void _editor_init() {
+	Ref<ResourceImporterVNScript> vn_script_import;
+	vn_script_import.instantiate();
+	ResourceFormatImporter::get_singleton()->add_importer(vn_script_import);
+
+	Ref<VNAssetIndexExportPlugin> vn_asset_index_export;
+	vn_asset_index_export.instantiate();
+	EditorExport::get_singleton()->add_export_plugin(vn_asset_index_export);
+}
+#endif
+
+static Ref<ResourceFormatLoaderVNScript> resource_loader_vn_script;
+static Ref<ResourceFormatSaverVNScript> resource_saver_vn_script;
+
+static WorldState *world_state = nullptr;
+
+void initialize_lupine_module(ModuleInitializationLevel p_level) {
+	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
+		GDREGISTER_CLASS(BattleSimulator);
+		GDREGISTER_CLASS(CollectibleField);
+		GDREGISTER_CLASS(Crowd2D);
+		GDREGISTER_CLASS(DialogueProgram);
+		GDREGISTER_CLASS(DialogueVariables);
+		GDREGISTER_CLASS(EffectScheduler);
+		GDREGISTER_CLASS(HUDDataModel);
+		GDREGISTER_CLASS(InventoryContainer);
+		GDREGISTER_CLASS(QuestRuntime);
+		GDREGISTER_CLASS(RelationshipGraph);
+		GDREGISTER_CLASS(SaveGameState);
+		GDREGISTER_CLASS(ScreenEffectsCompositor);
+		GDREGISTER_CLASS(TacticalGrid);
+		GDREGISTER_CLASS(VNAssetStreamer);
+		GDREGISTER_CLASS(VNScript);
+		GDREGISTER_CLASS(WorldStateCondition);
+
+		world_state = memnew(WorldState);
+		GDREGISTER_CLASS(WorldState);
+		Engine::get_singleton()->add_singleton(Engine::Singleton("WorldState", WorldState::get_singleton()));
+
+		resource_loader_vn_script.instantiate();
+		ResourceLoader::add_resource_format_loader(resource_loader_vn_script);
+		resource_saver_vn_script.instantiate();
+		ResourceSaver::add_resource_format_saver(resource_saver_vn_script);
+	}
+
+#ifdef TOOLS_ENABLED
+	if (p_level == MODULE_INITIALIZATION_LEVEL_EDITOR) {
+		GDREGISTER_CLASS(ResourceImporterVNScript);
+
+		EditorNode::add_init_callback(_editor_init);
+	}
+#endif
+}
+
+void uninitialize_lupine_module(ModuleInitializationLevel p_level) {
+	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
+		return;
+	}
+
+	ResourceLoader::remove_resource_format_loader(resource_loader_vn_script);
+	resource_loader_vn_script.unref();
+	ResourceSaver::remove_resource_format_saver(resource_saver_vn_script);
+	resource_saver_vn_script.unref();
+	VNScript::clear_condition_cache();
+
+	if (world_state) {
+		memdelete(world_state);
+		world_state = nullptr;
+	}
+}
@@ -0,0 +1,409 @@
+/**************************************************************************/
+/*  relationship_graph.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "relationship_graph.h"
+
+#include "core/os/os.h"
+
+struct RelationshipNeighbor {
+	int32_t points = 0;
+	uint32_t character = 0;
+
+	// Highest points first, then in the order characters were added.
+	bool operator<(const RelationshipNeighbor &p_other) const {
+		return points != p_other.points ? points > p_other.points : character < p_other.character;
+	}
+};
+
+int32_t RelationshipGraph::_find_edge(const StringName &p_a, const StringName &p_b) const {
+	const uint32_t *a = character_indices.getptr(p_a);
+	const uint32_t *b = character_indices.getptr(p_b);
+	if (!a || !b) {
+		return -1;
+	}
+	const uint32_t *edge = pair_edges.getptr(_pair_key(*a, *b));
+	return edge ? int32_t(*edge) : -1;
+}
+
+uint32_t RelationshipGraph::_get_edge(const StringName &p_a, const StringName &p_b) {
+	const uint32_t a = add_character(p_a);
+	const uint32_t b = add_character(p_b);
+	const uint64_t key = _pair_key(a, b);
+	const uint32_t *existing = pair_edges.getptr(key);
+	if (existing) {
+		return *existing;
+	}
+
+	const uint32_t edge = edge_points.size();
+	pair_edges.insert_new(key, edge);
+	edge_first.push_back(MIN(a, b));
+	edge_second.push_back(MAX(a, b));
+	edge_points.push_back(MAX(0, min_points));
+	edge_last_day.push_back(current_day);
+	edge_daily.push_back(0);
+	edge_cooldown_end.push_back(0);
+	character_edges[a].push_back(edge);
+	character_edges[b].push_back(edge);
+	return edge;
+}
+
+int RelationshipGraph::_level_for(int p_points) const {
+	// Index of the highest threshold reached, or -1 below the first one.
+	int low = 0;
+	int high = level_thresholds.size();
+	const int32_t *r = level_thresholds.ptr();
+	while (low < high) {
+		const int mid = (low + high) / 2;
+		if (r[mid] <= p_points) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low - 1;
+}
+
+void RelationshipGraph::_set_edge_points(uint32_t p_edge, int p_points) {
+	const int points = MAX(p_points, min_points);
+	const int old_level = _level_for(edge_points[p_edge]);
+	edge_points[p_edge] = points;
+
+	const int new_level = _level_for(points);
+	if (new_level != old_level) {
+		emit_signal(SNAME("level_changed"), character_ids[edge_first[p_edge]], character_ids[edge_second[p_edge]], old_level, new_level);
+	}
+}
+
+int RelationshipGraph::add_character(const StringName &p_id) {
+	ERR_FAIL_COND_V(p_id == StringName(), -1);
+	const uint32_t *index = character_indices.getptr(p_id);
+	if (index) {
+		return *index;
+	}
+	const uint32_t new_index = character_ids.size();
+	character_indices.insert_new(p_id, new_index);
+	character_ids.push_back(p_id);
+	character_edges.push_back(LocalVector<uint32_t>());
+	return new_index;
+}
+
+bool RelationshipGraph::has_character(const StringName &p_id) const {
+	return character_indices.has(p_id);
+}
+
+int RelationshipGraph::get_character_index(const StringName &p_id) const {
+	const uint32_t *index = character_indices.getptr(p_id);
+	return index ? int(*index) : -1;
+}
+
+StringName RelationshipGraph::get_character_id(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)character_ids.size(), StringName());
+	return character_ids[p_index];
+}
+
+bool RelationshipGraph::has_relationship(const StringName &p_a, const StringName &p_b) const {
+	return _find_edge(p_a, p_b) >= 0;
+}
+
+int RelationshipGraph::get_points(const StringName &p_a, const StringName &p_b) const {
+	const int32_t edge = _find_edge(p_a, p_b);
+	return edge < 0 ? MAX(0, min_points) : edge_points[edge];
+}
+
+void RelationshipGraph::set_points(const StringName &p_a, const StringName &p_b, int p_points) {
+	ERR_FAIL_COND_MSG(p_a == p_b, "A character can't have a relationship with itself.");
+	_set_edge_points(_get_edge(p_a, p_b), p_points);
+}
+
+int RelationshipGraph::add_points(const StringName &p_a, const StringName &p_b, int p_delta) {
+	ERR_FAIL_COND_V_MSG(p_a == p_b, 0, "A character can't have a relationship with itself.");
+	const uint32_t edge = _get_edge(p_a, p_b);
+	_set_edge_points(edge, CLAMP(int64_t(edge_points[edge]) + p_delta, int64_t(INT32_MIN), int64_t(INT32_MAX)));
+	return edge_points[edge];
+}
+
+int RelationshipGraph::get_level(const StringName &p_a, const StringName &p_b) const {
+	return _level_for(get_points(p_a, p_b));
+}
+
+bool RelationshipGraph::can_interact(const StringName &p_a, const StringName &p_b) const {
+	const int32_t edge = _find_edge(p_a, p_b);
+	if (edge < 0) {
+		return p_a != p_b;
+	}
+	if (max_daily_interactions > 0 && edge_daily[edge] >= max_daily_interactions) {
+		return false;
+	}
+	return OS::get_singleton()->get_ticks_msec() >= edge_cooldown_end[edge];
+}
+
+bool RelationshipGraph::interact(const StringName &p_a, const StringName &p_b, int p_points) {
+	if (!can_interact(p_a, p_b)) {
+		return false;
+	}
+	const uint32_t edge = _get_edge(p_a, p_b);
+	edge_daily[edge]++;
+	edge_last_day[edge] = current_day;
+	edge_cooldown_end[edge] = OS::get_singleton()->get_ticks_msec() + uint64_t(interaction_cooldown * 1000.0);
+	_set_edge_points(edge, CLAMP(int64_t(edge_points[edge]) + p_points, int64_t(INT32_MIN), int64_t(INT32_MAX)));
+	return true;
+}
+
+int RelationshipGraph::get_daily_interactions(const StringName &p_a, const StringName &p_b) const {
+	const int32_t edge = _find_edge(p_a, p_b);
+	return edge < 0 ? 0 : edge_daily[edge];
+}
+
+int RelationshipGraph::get_last_interaction_day(const StringName &p_a, const StringName &p_b) const {
+	const int32_t edge = _find_edge(p_a, p_b);
+	return edge < 0 ? -1 : edge_last_day[edge];
+}
+
+void RelationshipGraph::advance_day(int p_days) {
+	ERR_FAIL_COND(p_days < 0);
+	const int first_day = current_day + 1;
+	current_day += p_days;
+
+	const uint32_t edge_count = edge_points.size();
+	for (uint32_t edge = 0; edge < edge_count; edge++) {
+		edge_daily[edge] = 0;
+	}
+	if (decay_rate <= 0.0) {
+		return;
+	}
+
+	// Friendships fade once a pair hasn't interacted for the grace period,
+	// faster the longer it has been.
+	for (uint32_t edge = 0; edge < edge_count; edge++) {
+		const int points = edge_points[edge];
+		if (points <= 0) {
+			continue;
+		}
+		int64_t decay = 0;
+		for (int day = MAX(first_day, edge_last_day[edge] + decay_grace_days + 1); day <= current_day; day++) {
+			decay += int64_t(decay_rate * (day - edge_last_day[edge]));
+		}
+		if (decay > 0) {
+			_set_edge_points(edge, MAX(int64_t(0), points - decay));
+		}
+	}
+}
+
+PackedStringArray RelationshipGraph::get_neighbors(const StringName &p_id, int p_min_points) const {
+	PackedStringArray result;
+	const uint32_t *index = character_indices.getptr(p_id);
+	if (!index) {
+		return result;
+	}
+
+	LocalVector<RelationshipNeighbor> neighbors;
+	for (uint32_t edge : character_edges[*index]) {
+		if (edge_points[edge] >= p_min_points) {
+			RelationshipNeighbor neighbor;
+			neighbor.points = edge_points[edge];
+			neighbor.character = edge_first[edge] == *index ? edge_second[edge] : edge_first[edge];
+			neighbors.push_back(neighbor);
+		}
+	}
+	neighbors.sort();
+	result.resize(neighbors.size());
+	String *w = result.ptrw();
+	for (uint32_t i = 0; i < neighbors.size(); i++) {
+		w[i] = character_ids[neighbors[i].character];
+	}
+	return result;
+}
+
+PackedStringArray RelationshipGraph::get_top_relationships(const StringName &p_id, int p_count) const {
+	ERR_FAIL_COND_V(p_count < 0, PackedStringArray());
+	PackedStringArray result = get_neighbors(p_id, INT32_MIN);
+	if (result.size() > p_count) {
+		result.resize(p_count);
+	}
+	return result;
+}
+
+int RelationshipGraph::get_rank(const StringName &p_id, const StringName &p_other) const {
+	const int32_t pair = _find_edge(p_id, p_other);
+	if (pair < 0) {
+		return -1;
+	}
+
+	// Count the neighbors sorted before p_other, without sorting them all.
+	const uint32_t index = character_indices[p_id];
+	RelationshipNeighbor target;
+	target.points = edge_points[pair];
+	target.character = character_indices[p_other];
+	int rank = 0;
+	for (uint32_t edge : character_edges[index]) {
+		RelationshipNeighbor neighbor;
+		neighbor.points = edge_points[edge];
+		neighbor.character = edge_first[edge] == index ? edge_second[edge] : edge_first[edge];
+		if (neighbor < target) {
+			rank++;
+		}
+	}
+	return rank;
+}
+
+Array RelationshipGraph::get_pairs_at_level(int p_level) const {
+	Array pairs;
+	for (uint32_t edge = 0; edge < edge_points.size(); edge++) {
+		if (_level_for(edge_points[edge]) == p_level) {
+			PackedStringArray pair;
+			pair.push_back(character_ids[edge_first[edge]]);
+			pair.push_back(character_ids[edge_second[edge]]);
+			pairs.push_back(pair);
+		}
+	}
+	return pairs;
+}
+
+void RelationshipGraph::set_level_thresholds(const PackedInt32Array &p_thresholds) {
+	for (int i = 1; i < p_thresholds.size(); i++) {
+		ERR_FAIL_COND_MSG(p_thresholds[i] <= p_thresholds[i - 1], "Level thresholds must be in increasing order.");
+	}
+	level_thresholds = p_thresholds;
+}
+
+Dictionary RelationshipGraph::get_state() const {
+	PackedStringArray characters;
+	for (const StringName &id : character_ids) {
+		characters.push_back(id);
+	}
+
+	// Five values per pair. Cooldowns are short-lived and not saved.
+	PackedInt32Array pairs;
+	pairs.resize(edge_points.size() * 5);
+	int32_t *w = pairs.ptrw();
+	for (uint32_t edge = 0; edge < edge_points.size(); edge++) {
+		w[edge * 5 + 0] = edge_first[edge];
+		w[edge * 5 + 1] = edge_second[edge];
+		w[edge * 5 + 2] = edge_points[edge];
+		w[edge * 5 + 3] = edge_last_day[edge];
+		w[edge * 5 + 4] = edge_daily[edge];
+	}
+
+	Dictionary state;
+	state["day"] = current_day;
+	state["characters"] = characters;
+	state["pairs"] = pairs;
+	return state;
+}
+
+void RelationshipGraph::set_state(const Dictionary &p_state) {
+	clear();
+	current_day = p_state.get("day", 0);
+
+	const PackedStringArray characters = p_state.get("characters", PackedStringArray());
+	for (int i = 0; i < characters.size(); i++) {
+		add_character(characters[i]);
+	}
+
+	const PackedInt32Array pairs = p_state.get("pairs", PackedInt32Array());
+	ERR_FAIL_COND_MSG(pairs.size() % 5 != 0, "Invalid relationship state.");
+	const int32_t *r = pairs.ptr();
+	for (int i = 0; i < pairs.size(); i += 5) {
+		ERR_CONTINUE(r[i] < 0 || r[i] >= (int)character_ids.size() || r[i + 1] < 0 || r[i + 1] >= (int)character_ids.size() || r[i] == r[i + 1]);
+		const uint32_t edge = _get_edge(character_ids[r[i]], character_ids[r[i + 1]]);
+		edge_points[edge] = MAX(r[i + 2], min_points);
+		edge_last_day[edge] = r[i + 3];
+		edge_daily[edge] = r[i + 4];
+	}
+}
+
+void RelationshipGraph::clear() {
+	character_indices.clear();
+	character_ids.clear();
+	character_edges.clear();
+	pair_edges.clear();
+	edge_first.clear();
+	edge_second.clear();
+	edge_points.clear();
+	edge_last_day.clear();
+	edge_daily.clear();
+	edge_cooldown_end.clear();
+	current_day = 0;
+}
+
+void RelationshipGraph::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_character", "id"), &RelationshipGraph::add_character);
+	ClassDB::bind_method(D_METHOD("has_character", "id"), &RelationshipGraph::has_character);
+	ClassDB::bind_method(D_METHOD("get_character_index", "id"), &RelationshipGraph::get_character_index);
+	ClassDB::bind_method(D_METHOD("get_character_id", "index"), &RelationshipGraph::get_character_id);
+	ClassDB::bind_method(D_METHOD("get_character_count"), &RelationshipGraph::get_character_count);
+	ClassDB::bind_method(D_METHOD("get_relationship_count"), &RelationshipGraph::get_relationship_count);
+
+	ClassDB::bind_method(D_METHOD("has_relationship", "a", "b"), &RelationshipGraph::has_relationship);
+	ClassDB::bind_method(D_METHOD("get_points", "a", "b"), &RelationshipGraph::get_points);
+	ClassDB::bind_method(D_METHOD("set_points", "a", "b", "points"), &RelationshipGraph::set_points);
+	ClassDB::bind_method(D_METHOD("add_points", "a", "b", "delta"), &RelationshipGraph::add_points);
+	ClassDB::bind_method(D_METHOD("get_level", "a", "b"), &RelationshipGraph::get_level);
+
+	ClassDB::bind_method(D_METHOD("can_interact", "a", "b"), &RelationshipGraph::can_interact);
+	ClassDB::bind_method(D_METHOD("interact", "a", "b", "points"), &RelationshipGraph::interact);
+	ClassDB::bind_method(D_METHOD("get_daily_interactions", "a", "b"), &RelationshipGraph::get_daily_interactions);
+	ClassDB::bind_method(D_METHOD("get_last_interaction_day", "a", "b"), &RelationshipGraph::get_last_interaction_day);
+	ClassDB::bind_method(D_METHOD("advance_day", "days"), &RelationshipGraph::advance_day, DEFVAL(1));
+
+	ClassDB::bind_method(D_METHOD("get_neighbors", "id", "min_points"), &RelationshipGraph::get_neighbors, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_top_relationships", "id", "count"), &RelationshipGraph::get_top_relationships);
+	ClassDB::bind_method(D_METHOD("get_rank", "id", "other"), &RelationshipGraph::get_rank);
+	ClassDB::bind_method(D_METHOD("get_pairs_at_level", "level"), &RelationshipGraph::get_pairs_at_level);
+
+	ClassDB::bind_method(D_METHOD("set_level_thresholds", "thresholds"), &RelationshipGraph::set_level_thresholds);
+	ClassDB::bind_method(D_METHOD("get_level_thresholds"), &RelationshipGraph::get_level_thresholds);
+	ClassDB::bind_method(D_METHOD("set_current_day", "day"), &RelationshipGraph::set_current_day);
+	ClassDB::bind_method(D_METHOD("get_current_day"), &RelationshipGraph::get_current_day);
+	ClassDB::bind_method(D_METHOD("set_max_daily_interactions", "max"), &RelationshipGraph::set_max_daily_interactions);
+	ClassDB::bind_method(D_METHOD("get_max_daily_interactions"), &RelationshipGraph::get_max_daily_interactions);
+	ClassDB::bind_method(D_METHOD("set_interaction_cooldown", "seconds"), &RelationshipGraph::set_interaction_cooldown);
+	ClassDB::bind_method(D_METHOD("get_interaction_cooldown"), &RelationshipGraph::get_interaction_cooldown);
+	ClassDB::bind_method(D_METHOD("set_decay_rate", "rate"), &RelationshipGraph::set_decay_rate);
+	ClassDB::bind_method(D_METHOD("get_decay_rate"), &RelationshipGraph::get_decay_rate);
+	ClassDB::bind_method(D_METHOD("set_decay_grace_days", "days"), &RelationshipGraph::set_decay_grace_days);
+	ClassDB::bind_method(D_METHOD("get_decay_grace_days"), &RelationshipGraph::get_decay_grace_days);
+	ClassDB::bind_method(D_METHOD("set_min_points", "points"), &RelationshipGraph::set_min_points);
+	ClassDB::bind_method(D_METHOD("get_min_points"), &RelationshipGraph::get_min_points);
+
+	ClassDB::bind_method(D_METHOD("get_state"), &RelationshipGraph::get_state);
+	ClassDB::bind_method(D_METHOD("set_state", "state"), &RelationshipGraph::set_state);
+	ClassDB::bind_method(D_METHOD("clear"), &RelationshipGraph::clear);
+
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_INT32_ARRAY, "level_thresholds"), "set_level_thresholds", "get_level_thresholds");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "current_day"), "set_current_day", "get_current_day");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_daily_interactions", PROPERTY_HINT_RANGE, "0,100,1,or_greater"), "set_max_daily_interactions", "get_max_daily_interactions");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interaction_cooldown", PROPERTY_HINT_RANGE, "0,3600,0.1,or_greater,suffix:s"), "set_interaction_cooldown", "get_interaction_cooldown");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "decay_rate", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), "set_decay_rate", "get_decay_rate");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "decay_grace_days", PROPERTY_HINT_RANGE, "0,365,1,or_greater"), "set_decay_grace_days", "get_decay_grace_days");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "min_points"), "set_min_points", "get_min_points");
+
+	ADD_SIGNAL(MethodInfo("level_changed", PropertyInfo(Variant::STRING_NAME, "a"), PropertyInfo(Variant::STRING_NAME, "b"), PropertyInfo(Variant::INT, "old_level"), PropertyInfo(Variant::INT, "new_level")));
+}
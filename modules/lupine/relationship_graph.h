@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*  relationship_graph.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Symmetric, weighted relationships between characters.
+// Characters get dense indices, and only pairs that have interacted are
+// stored: one edge per pair, found through a hash of the packed index pair
+// and listed per character for neighbor queries. Edge data is kept in
+// parallel arrays so daily resets and decay run as one pass over all pairs.
+class RelationshipGraph : public RefCounted {
+	GDCLASS(RelationshipGraph, RefCounted);
+
+	AHashMap<StringName, uint32_t> character_indices;
+	LocalVector<StringName> character_ids;
+	LocalVector<LocalVector<uint32_t>> character_edges;
+
+	AHashMap<uint64_t, uint32_t> pair_edges;
+	LocalVector<uint32_t> edge_first;
+	LocalVector<uint32_t> edge_second;
+	LocalVector<int32_t> edge_points;
+	LocalVector<int32_t> edge_last_day;
+	LocalVector<int32_t> edge_daily;
+	LocalVector<uint64_t> edge_cooldown_end; // Ticks in msec.
+
+	PackedInt32Array level_thresholds;
+	int current_day = 0;
+	int max_daily_interactions = 3;
+	double interaction_cooldown = 300.0;
+	double decay_rate = 0.1;
+	int decay_grace_days = 7;
+	int min_points = 0;
+
+	_FORCE_INLINE_ static uint64_t _pair_key(uint32_t p_a, uint32_t p_b) {
+		return p_a < p_b ? (uint64_t(p_a) << 32) | p_b : (uint64_t(p_b) << 32) | p_a;
+	}
+
+	int32_t _find_edge(const StringName &p_a, const StringName &p_b) const;
+	uint32_t _get_edge(const StringName &p_a, const StringName &p_b);
+	int _level_for(int p_points) const;
+	void _set_edge_points(uint32_t p_edge, int p_points);
+	void _sort_edges(uint32_t p_character, LocalVector<uint32_t> &r_edges) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	int add_character(const StringName &p_id);
+	bool has_character(const StringName &p_id) const;
+	int get_character_index(const StringName &p_id) const;
+	StringName get_character_id(int p_index) const;
+	int get_character_count() const { return character_ids.size(); }
+	int get_relationship_count() const { return edge_points.size(); }
+
+	bool has_relationship(const StringName &p_a, const StringName &p_b) const;
+	int get_points(const StringName &p_a, const StringName &p_b) const;
+	void set_points(const StringName &p_a, const StringName &p_b, int p_points);
+	int add_points(const StringName &p_a, const StringName &p_b, int p_delta);
+	int get_level(const StringName &p_a, const StringName &p_b) const;
+
+	bool can_interact(const StringName &p_a, const StringName &p_b) const;
+	bool interact(const StringName &p_a, const StringName &p_b, int p_points);
+	int get_daily_interactions(const StringName &p_a, const StringName &p_b) const;
+	int get_last_interaction_day(const StringName &p_a, const StringName &p_b) const;
+
+	void advance_day(int p_days = 1);
+
+	PackedStringArray get_neighbors(const StringName &p_id, int p_min_points = 0) const;
+	PackedStringArray get_top_relationships(const StringName &p_id, int p_count) const;
+	int get_rank(const StringName &p_id, const StringName &p_other) const;
+	Array get_pairs_at_level(int p_level) const;
+
+	void set_level_thresholds(const PackedInt32Array &p_thresholds);
+	PackedInt32Array get_level_thresholds() const { return level_thresholds; }
+	void set_current_day(int p_day) { current_day = p_day; }
+	int get_current_day() const { return current_day; }
+	void set_max_daily_interactions(int p_max) { max_daily_interactions = p_max; }
+	int get_max_daily_interactions() const { return max_daily_interactions; }
+	void set_interaction_cooldown(double p_seconds) { interaction_cooldown = MAX(0.0, p_seconds); }
+	double get_interaction_cooldown() const { return interaction_cooldown; }
+	void set_decay_rate(double p_rate) { decay_rate = MAX(0.0, p_rate); }
+	double get_decay_rate() const { return decay_rate; }
+	void set_decay_grace_days(int p_days) { decay_grace_days = MAX(0, p_days); }
+	int get_decay_grace_days() const { return decay_grace_days; }
+	void set_min_points(int p_points) { min_points = p_points; }
+	int get_min_points() const { return min_points; }
+
+	Dictionary get_state() const;
+	void set_state(const Dictionary &p_state);
+	void clear();
+};
@@ -0,0 +1,401 @@
+/**************************************************************************/
+/*  save_game_state.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "save_game_state.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/marshalls.h"
+
+static const char *SAVE_GAME_MAGIC = "LSAV";
+
+Error SaveGameState::_encode_section(const Variant &p_data, Compression::Mode p_mode, Vector<uint8_t> &r_blob, uint32_t &r_raw_size) {
+	int len = 0;
+	Error err = encode_variant(p_data, nullptr, len);
+	ERR_FAIL_COND_V(err != OK, err);
+	ERR_FAIL_COND_V_MSG(uint32_t(len) > MAX_SECTION_SIZE, ERR_OUT_OF_MEMORY, "Save section is too large to be loaded back.");
+
+	Vector<uint8_t> raw;
+	raw.resize(len);
+	encode_variant(p_data, raw.ptrw(), len);
+
+	r_blob.resize(Compression::get_max_compressed_buffer_size(len, p_mode));
+	const int compressed_size = Compression::compress(r_blob.ptrw(), raw.ptr(), len, p_mode);
+	ERR_FAIL_COND_V(compressed_size < 0, ERR_CANT_CREATE);
+	r_blob.resize(compressed_size);
+	r_raw_size = len;
+	return OK;
+}
+
+Error SaveGameState::_run_job(SaveJob *p_job) {
+	for (SaveJob::Entry &entry : p_job->entries) {
+		if (entry.data.get_type() == Variant::NIL && !entry.blob.is_empty()) {
+			continue; // Unchanged section, reuse the cached blob.
+		}
+		Error err = _encode_section(entry.data, p_job->compression_mode, entry.blob, entry.raw_size);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Failed to encode save section \"%s\".", entry.name));
+		entry.data = Variant();
+	}
+
+	int metadata_len = 0;
+	Error err = encode_variant(p_job->metadata, nullptr, metadata_len);
+	ERR_FAIL_COND_V(err != OK, err);
+	Vector<uint8_t> metadata_buffer;
+	metadata_buffer.resize(metadata_len);
+	encode_variant(p_job->metadata, metadata_buffer.ptrw(), metadata_len);
+
+	// Write next to the target and swap it in, so a crash mid-save never leaves a truncated slot behind.
+	const String temp_path = p_job->path + ".tmp";
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot create save file \"%s\".", temp_path));
+
+		f->store_buffer(reinterpret_cast<const uint8_t *>(SAVE_GAME_MAGIC), 4);
+		f->store_32(FORMAT_VERSION);
+		f->store_32(p_job->compression_mode);
+		f->store_32(metadata_len);
+		f->store_buffer(metadata_buffer);
+
+		f->store_32(p_job->entries.size());
+		for (const SaveJob::Entry &entry : p_job->entries) {
+			f->store_pascal_string(entry.name);
+			f->store_32(entry.raw_size);
+			f->store_32(entry.blob.size());
+		}
+		for (const SaveJob::Entry &entry : p_job->entries) {
+			f->store_buffer(entry.blob);
+		}
+
+		if (f->get_error() != OK) {
+			f.unref();
+			DirAccess::remove_absolute(temp_path);
+			ERR_FAIL_V_MSG(ERR_FILE_CANT_WRITE, vformat("Failed to write save file \"%s\".", temp_path));
+		}
+	}
+
+	// Renaming over the previous file replaces it atomically, so the slot is never left without one.
+	err = DirAccess::rename_absolute(temp_path, p_job->path);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot move save file into place at \"%s\".", p_job->path));
+	return OK;
+}
+
+SaveGameState::SaveJob *SaveGameState::_create_job(const String &p_path, bool p_snapshot) {
+	MutexLock lock(mutex);
+
+	SaveJob *new_job = memnew(SaveJob);
+	new_job->path = p_path;
+	new_job->metadata = p_snapshot ? metadata.duplicate(true) : metadata;
+	new_job->compression_mode = compression_mode;
+	new_job->entries.reserve(sections.size());
+
+	for (const KeyValue<StringName, Section> &E : sections) {
+		SaveJob::Entry entry;
+		entry.name = E.key;
+		entry.version = E.value.version;
+		if (E.value.encoded_version == E.value.version) {
+			entry.raw_size = E.value.raw_size;
+			entry.blob = E.value.blob; // Copy-on-write, no actual copy.
+		} else {
+			// Background saves work on a copy, so the game can keep mutating its state meanwhile.
+			entry.data = p_snapshot ? E.value.data.duplicate(true) : E.value.data;
+		}
+		new_job->entries.push_back(entry);
+	}
+	return new_job;
+}
+
+void SaveGameState::_apply_job(SaveJob *p_job) {
+	MutexLock lock(mutex);
+	if (p_job->error != OK) {
+		return;
+	}
+	for (const SaveJob::Entry &entry : p_job->entries) {
+		HashMap<StringName, Section>::Iterator E = sections.find(entry.name);
+		// Sections changed while saving keep their old blob and stay dirty.
+		if (E && E->value.version == entry.version && E->value.encoded_version != entry.version) {
+			E->value.blob = entry.blob;
+			E->value.raw_size = entry.raw_size;
+			E->value.encoded_version = entry.version;
+		}
+	}
+}
+
+void SaveGameState::_save_task(SaveJob *p_job) {
+	p_job->error = _run_job(p_job);
+	callable_mp(this, &SaveGameState::_save_finished).call_deferred();
+}
+
+void SaveGameState::_save_finished() {
+	if (task_id == WorkerThreadPool::INVALID_TASK_ID) {
+		return; // Already collected by wait_for_save().
+	}
+	wait_for_save();
+}
+
+void SaveGameState::set_section(const StringName &p_name, const Variant &p_data) {
+	MutexLock lock(mutex);
+	Section &section = sections[p_name];
+	section.data = p_data;
+	section.version = ++last_version;
+}
+
+Variant SaveGameState::get_section(const StringName &p_name) const {
+	MutexLock lock(mutex);
+	HashMap<StringName, Section>::ConstIterator E = sections.find(p_name);
+	return E ? E->value.data : Variant();
+}
+
+bool SaveGameState::has_section(const StringName &p_name) const {
+	MutexLock lock(mutex);
+	return sections.has(p_name);
+}
+
+void SaveGameState::erase_section(const StringName &p_name) {
+	MutexLock lock(mutex);
+	sections.erase(p_name);
+}
+
+void SaveGameState::mark_dirty(const StringName &p_name) {
+	MutexLock lock(mutex);
+	HashMap<StringName, Section>::Iterator E = sections.find(p_name);
+	ERR_FAIL_COND_MSG(!E, vformat("Save section \"%s\" does not exist.", p_name));
+	E->value.version = ++last_version;
+}
+
+bool SaveGameState::is_section_dirty(const StringName &p_name) const {
+	MutexLock lock(mutex);
+	HashMap<StringName, Section>::ConstIterator E = sections.find(p_name);
+	return E && E->value.encoded_version != E->value.version;
+}
+
+PackedStringArray SaveGameState::get_section_names() const {
+	MutexLock lock(mutex);
+	PackedStringArray names;
+	for (const KeyValue<StringName, Section> &E : sections) {
+		names.push_back(E.key);
+	}
+	return names;
+}
+
+void SaveGameState::clear() {
+	MutexLock lock(mutex);
+	sections.clear();
+	metadata.clear();
+}
+
+void SaveGameState::set_metadata(const Dictionary &p_metadata) {
+	MutexLock lock(mutex);
+	metadata = p_metadata;
+}
+
+Dictionary SaveGameState::get_metadata() const {
+	MutexLock lock(mutex);
+	return metadata;
+}
+
+void SaveGameState::set_compression_mode(FileAccess::CompressionMode p_mode) {
+	ERR_FAIL_COND_MSG(p_mode == FileAccess::COMPRESSION_BROTLI, "Brotli can only be used for decompression.");
+	MutexLock lock(mutex);
+	if (compression_mode == Compression::Mode(p_mode)) {
+		return;
+	}
+	compression_mode = Compression::Mode(p_mode);
+	// Cached blobs were compressed with the previous mode.
+	for (KeyValue<StringName, Section> &E : sections) {
+		E.value.encoded_version = 0;
+		E.value.blob.clear();
+	}
+}
+
+FileAccess::CompressionMode SaveGameState::get_compression_mode() const {
+	return FileAccess::CompressionMode(compression_mode);
+}
+
+Error SaveGameState::save(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(is_saving(), ERR_BUSY, "A background save is still in progress.");
+
+	SaveJob *sync_job = _create_job(p_path, false);
+	sync_job->error = _run_job(sync_job);
+	_apply_job(sync_job);
+	Error err = sync_job->error;
+	memdelete(sync_job);
+	return err;
+}
+
+Error SaveGameState::save_async(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(is_saving(), ERR_BUSY, "A background save is still in progress.");
+
+	job = _create_job(p_path, true);
+	task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &SaveGameState::_save_task, job, false, "Save game state");
+	return OK;
+}
+
+bool SaveGameState::is_saving() const {
+	return task_id != WorkerThreadPool::INVALID_TASK_ID;
+}
+
+Error SaveGameState::wait_for_save() {
+	if (task_id == WorkerThreadPool::INVALID_TASK_ID) {
+		return OK;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	task_id = WorkerThreadPool::INVALID_TASK_ID;
+
+	_apply_job(job);
+	const Error err = job->error;
+	const String path = job->path;
+	memdelete(job);
+	job = nullptr;
+
+	emit_signal(SNAME("save_completed"), path, err);
+	return err;
+}
+
+Error SaveGameState::load(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(is_saving(), ERR_BUSY, "A background save is still in progress.");
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot open save file \"%s\".", p_path));
+
+	uint8_t magic[4] = {};
+	f->get_buffer(magic, 4);
+	ERR_FAIL_COND_V_MSG(memcmp(magic, SAVE_GAME_MAGIC, 4) != 0, ERR_FILE_UNRECOGNIZED, vformat("\"%s\" is not a save file.", p_path));
+	const uint32_t version = f->get_32();
+	ERR_FAIL_COND_V_MSG(version > FORMAT_VERSION, ERR_FILE_UNRECOGNIZED, vformat("Save file \"%s\" was written by a newer version.", p_path));
+	const Compression::Mode mode = Compression::Mode(f->get_32());
+	ERR_FAIL_COND_V(mode > Compression::MODE_BROTLI, ERR_FILE_CORRUPT);
+
+	const uint64_t file_length = f->get_length();
+
+	const uint32_t metadata_len = f->get_32();
+	ERR_FAIL_COND_V(metadata_len > file_length, ERR_FILE_CORRUPT);
+	Vector<uint8_t> buffer = f->get_buffer(metadata_len);
+	ERR_FAIL_COND_V(uint32_t(buffer.size()) != metadata_len, ERR_FILE_CORRUPT);
+	Variant loaded_metadata;
+	err = decode_variant(loaded_metadata, buffer.ptr(), metadata_len);
+	ERR_FAIL_COND_V(err != OK || loaded_metadata.get_type() != Variant::DICTIONARY, ERR_FILE_CORRUPT);
+
+	const uint32_t section_count = f->get_32();
+	ERR_FAIL_COND_V(section_count > file_length, ERR_FILE_CORRUPT);
+	LocalVector<Pair<StringName, Section>> loaded;
+	loaded.resize(section_count);
+	LocalVector<uint32_t> blob_sizes;
+	blob_sizes.resize(section_count);
+	for (uint32_t i = 0; i < section_count; i++) {
+		loaded[i].first = f->get_pascal_string();
+		loaded[i].second.raw_size = f->get_32();
+		blob_sizes[i] = f->get_32();
+		ERR_FAIL_COND_V(blob_sizes[i] > file_length, ERR_FILE_CORRUPT);
+		// Checked before anything is allocated for it.
+		ERR_FAIL_COND_V(loaded[i].second.raw_size > MAX_SECTION_SIZE, ERR_FILE_CORRUPT);
+	}
+
+	Vector<uint8_t> raw;
+	for (uint32_t i = 0; i < section_count; i++) {
+		Section &section = loaded[i].second;
+		section.blob = f->get_buffer(blob_sizes[i]);
+		ERR_FAIL_COND_V(uint32_t(section.blob.size()) != blob_sizes[i], ERR_FILE_CORRUPT);
+
+		raw.resize(section.raw_size);
+		const int decompressed = Compression::decompress(raw.ptrw(), section.raw_size, section.blob.ptr(), section.blob.size(), mode);
+		ERR_FAIL_COND_V_MSG(decompressed != int(section.raw_size), ERR_FILE_CORRUPT, vformat("Corrupt section \"%s\" in save file \"%s\".", loaded[i].first, p_path));
+		err = decode_variant(section.data, raw.ptr(), raw.size());
+		ERR_FAIL_COND_V_MSG(err != OK, ERR_FILE_CORRUPT, vformat("Corrupt section \"%s\" in save file \"%s\".", loaded[i].first, p_path));
+	}
+
+	MutexLock lock(mutex);
+	sections.clear();
+	for (Pair<StringName, Section> &E : loaded) {
+		// What was just read is exactly what would be written back.
+		E.second.version = ++last_version;
+		E.second.encoded_version = mode == compression_mode ? E.second.version : 0;
+		sections.insert(E.first, E.second);
+	}
+	metadata = loaded_metadata;
+	return OK;
+}
+
+Dictionary SaveGameState::read_metadata(const String &p_path) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return Dictionary();
+	}
+
+	uint8_t magic[4] = {};
+	f->get_buffer(magic, 4);
+	if (memcmp(magic, SAVE_GAME_MAGIC, 4) != 0 || f->get_32() > FORMAT_VERSION) {
+		return Dictionary();
+	}
+	f->get_32(); // Compression mode, only needed for sections.
+
+	const uint32_t metadata_len = f->get_32();
+	ERR_FAIL_COND_V(metadata_len > f->get_length(), Dictionary());
+	Vector<uint8_t> buffer = f->get_buffer(metadata_len);
+	Variant metadata;
+	if (uint32_t(buffer.size()) != metadata_len || decode_variant(metadata, buffer.ptr(), metadata_len) != OK) {
+		return Dictionary();
+	}
+	return metadata;
+}
+
+void SaveGameState::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_section", "name", "data"), &SaveGameState::set_section);
+	ClassDB::bind_method(D_METHOD("get_section", "name"), &SaveGameState::get_section);
+	ClassDB::bind_method(D_METHOD("has_section", "name"), &SaveGameState::has_section);
+	ClassDB::bind_method(D_METHOD("erase_section", "name"), &SaveGameState::erase_section);
+	ClassDB::bind_method(D_METHOD("mark_dirty", "name"), &SaveGameState::mark_dirty);
+	ClassDB::bind_method(D_METHOD("is_section_dirty", "name"), &SaveGameState::is_section_dirty);
+	ClassDB::bind_method(D_METHOD("get_section_names"), &SaveGameState::get_section_names);
+	ClassDB::bind_method(D_METHOD("clear"), &SaveGameState::clear);
+
+	ClassDB::bind_method(D_METHOD("set_metadata", "metadata"), &SaveGameState::set_metadata);
+	ClassDB::bind_method(D_METHOD("get_metadata"), &SaveGameState::get_metadata);
+	ClassDB::bind_method(D_METHOD("set_compression_mode", "mode"), &SaveGameState::set_compression_mode);
+	ClassDB::bind_method(D_METHOD("get_compression_mode"), &SaveGameState::get_compression_mode);
+
+	ClassDB::bind_method(D_METHOD("save", "path"), &SaveGameState::save);
+	ClassDB::bind_method(D_METHOD("save_async", "path"), &SaveGameState::save_async);
+	ClassDB::bind_method(D_METHOD("is_saving"), &SaveGameState::is_saving);
+	ClassDB::bind_method(D_METHOD("wait_for_save"), &SaveGameState::wait_for_save);
+	ClassDB::bind_method(D_METHOD("load", "path"), &SaveGameState::load);
+	ClassDB::bind_static_method("SaveGameState", D_METHOD("read_metadata", "path"), &SaveGameState::read_metadata);
+
+	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "metadata"), "set_metadata", "get_metadata");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "FastLZ,Deflate,Zstd,GZip"), "set_compression_mode", "get_compression_mode");
+
+	ADD_SIGNAL(MethodInfo("save_completed", PropertyInfo(Variant::STRING, "path"), PropertyInfo(Variant::INT, "error", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_CLASS_IS_ENUM, "Error")));
+}
+
+SaveGameState::~SaveGameState() {
+	if (task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+		memdelete(job);
+	}
+}
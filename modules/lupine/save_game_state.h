@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*  save_game_state.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/compression.h"
+#include "core/io/file_access.h"
+#include "core/object/ref_counted.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Binary save-game writer.
+// The game state is split into named sections. Each section keeps the
+// compressed blob it was last saved as, so a save only encodes and compresses
+// the sections that changed since, and can run on a WorkerThreadPool task.
+// Slot metadata is stored uncompressed ahead of the payload, so save menus can
+// read it without decoding any section.
+class SaveGameState : public RefCounted {
+	GDCLASS(SaveGameState, RefCounted);
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 1;
+	static constexpr uint32_t MAX_SECTION_SIZE = 256 * 1024 * 1024; // Decoded, larger ones are taken for corruption.
+
+private:
+	struct Section {
+		Variant data;
+		uint64_t version = 0; // Taken from last_version.
+		uint64_t encoded_version = 0; // Version `blob` was encoded from.
+		uint32_t raw_size = 0;
+		Vector<uint8_t> blob;
+	};
+
+	struct SaveJob {
+		struct Entry {
+			StringName name;
+			Variant data; // Only set when the section has to be encoded.
+			uint64_t version = 0;
+			uint32_t raw_size = 0;
+			Vector<uint8_t> blob;
+		};
+
+		String path;
+		Dictionary metadata;
+		Compression::Mode compression_mode = Compression::MODE_ZSTD;
+		LocalVector<Entry> entries;
+		Error error = OK;
+	};
+
+	mutable Mutex mutex;
+	HashMap<StringName, Section> sections;
+	Dictionary metadata;
+	Compression::Mode compression_mode = Compression::MODE_ZSTD;
+	// Every change takes the next version, so a section erased and set again
+	// can't match a version a background save was started with.
+	uint64_t last_version = 0;
+
+	SaveJob *job = nullptr;
+	WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+
+	static Error _encode_section(const Variant &p_data, Compression::Mode p_mode, Vector<uint8_t> &r_blob, uint32_t &r_raw_size);
+	static Error _run_job(SaveJob *p_job);
+
+	SaveJob *_create_job(const String &p_path, bool p_snapshot);
+	void _apply_job(SaveJob *p_job);
+	void _save_task(SaveJob *p_job);
+	void _save_finished();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_section(const StringName &p_name, const Variant &p_data);
+	Variant get_section(const StringName &p_name) const;
+	bool has_section(const StringName &p_name) const;
+	void erase_section(const StringName &p_name);
+	void mark_dirty(const StringName &p_name);
+	bool is_section_dirty(const StringName &p_name) const;
+	PackedStringArray get_section_names() const;
+	void clear();
+
+	void set_metadata(const Dictionary &p_metadata);
+	Dictionary get_metadata() const;
+
+	void set_compression_mode(FileAccess::CompressionMode p_mode);
+	FileAccess::CompressionMode get_compression_mode() const;
+
+	Error save(const String &p_path);
+	Error save_async(const String &p_path);
+	bool is_saving() const;
+	Error wait_for_save();
+
+	Error load(const String &p_path);
+	static Dictionary read_metadata(const String &p_path);
+
+	~SaveGameState();
+};
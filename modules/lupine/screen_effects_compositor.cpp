@@ -0,0 +1,424 @@
+/**************************************************************************/
+/*  screen_effects_compositor.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "screen_effects_compositor.h"
+
+// Shared by both shader variants. blend_over() and overlay() must match
+// _blend_over() and _shade_overlay().
+static const char *SHADER_COMMON = R"(
+uniform vec4 fade_color;
+uniform vec4 flash_color;
+uniform float vignette;
+uniform float vignette_radius;
+uniform float vignette_softness;
+
+vec4 blend_over(vec4 dst, vec4 src) {
+	float a = src.a + dst.a * (1.0 - src.a);
+	vec3 rgb = a > 0.0 ? (src.rgb * src.a + dst.rgb * dst.a * (1.0 - src.a)) / a : vec3(0.0);
+	return vec4(rgb, a);
+}
+
+vec4 overlay(vec2 uv) {
+	vec2 centered = uv * 2.0 - 1.0;
+	float dist = length(centered) * 0.70710678;
+	vec4 result = vec4(0.0, 0.0, 0.0, vignette * smoothstep(vignette_radius, vignette_radius + vignette_softness, dist));
+	result = blend_over(result, flash_color);
+	return blend_over(result, fade_color);
+}
+)";
+
+static const char *SHADER_OVERLAY_FRAGMENT = R"(
+void fragment() {
+	COLOR = overlay(SCREEN_UV);
+}
+)";
+
+// Must match the screen path of render_reference().
+static const char *SHADER_SCREEN_FRAGMENT = R"(
+uniform sampler2D screen_texture : hint_screen_texture, filter_linear, repeat_disable;
+uniform float aberration;
+uniform float scanline_intensity;
+uniform float scanline_count;
+uniform float curvature;
+
+void fragment() {
+	vec2 centered = SCREEN_UV * 2.0 - 1.0;
+	centered *= 1.0 + curvature * dot(centered, centered);
+	vec2 uv = centered * 0.5 + 0.5;
+	vec3 color = vec3(0.0);
+	if (uv.x >= 0.0 && uv.x <= 1.0 && uv.y >= 0.0 && uv.y <= 1.0) {
+		vec2 offset = centered * aberration;
+		color = vec3(texture(screen_texture, uv + offset).r, texture(screen_texture, uv).g, texture(screen_texture, uv - offset).b);
+		color *= 1.0 - scanline_intensity * (0.5 + 0.5 * sin(uv.y * scanline_count * TAU));
+	}
+	vec4 over = overlay(SCREEN_UV);
+	COLOR = vec4(mix(color, over.rgb, over.a), 1.0);
+}
+)";
+
+float ScreenEffectsCompositor::Envelope::get_value() const {
+	const float weight = duration > 0.0 ? CLAMP(time / duration, 0.0f, 1.0f) : 1.0f;
+	if (pulse) {
+		return Math::lerp(from, to, 1.0f - Math::abs(2.0f * weight - 1.0f));
+	}
+	return Math::lerp(from, to, weight);
+}
+
+String ScreenEffectsCompositor::_get_shader_code(bool p_reads_screen) {
+	return String("shader_type canvas_item;\nrender_mode unshaded;\n") + SHADER_COMMON + (p_reads_screen ? SHADER_SCREEN_FRAGMENT : SHADER_OVERLAY_FRAGMENT);
+}
+
+Color ScreenEffectsCompositor::_blend_over(const Color &p_dst, const Color &p_src) {
+	const float a = p_src.a + p_dst.a * (1.0f - p_src.a);
+	if (a <= 0.0f) {
+		return Color(0, 0, 0, 0);
+	}
+	const float dst_weight = p_dst.a * (1.0f - p_src.a);
+	return Color((p_src.r * p_src.a + p_dst.r * dst_weight) / a, (p_src.g * p_src.a + p_dst.g * dst_weight) / a, (p_src.b * p_src.a + p_dst.b * dst_weight) / a, a);
+}
+
+Color ScreenEffectsCompositor::_sample(const Ref<Image> &p_image, const Vector2 &p_uv) {
+	// Bilinear, clamped to the edges, like a filter_linear, repeat_disable sampler.
+	const int width = p_image->get_width();
+	const int height = p_image->get_height();
+	const float x = p_uv.x * width - 0.5f;
+	const float y = p_uv.y * height - 0.5f;
+	const int x0 = Math::floor(x);
+	const int y0 = Math::floor(y);
+	const float tx = x - x0;
+	const float ty = y - y0;
+	const int xa = CLAMP(x0, 0, width - 1);
+	const int xb = CLAMP(x0 + 1, 0, width - 1);
+	const int ya = CLAMP(y0, 0, height - 1);
+	const int yb = CLAMP(y0 + 1, 0, height - 1);
+	const Color top = p_image->get_pixel(xa, ya).lerp(p_image->get_pixel(xb, ya), tx);
+	const Color bottom = p_image->get_pixel(xa, yb).lerp(p_image->get_pixel(xb, yb), tx);
+	return top.lerp(bottom, ty);
+}
+
+Color ScreenEffectsCompositor::_shade_overlay(const Params &p_params, const Vector2 &p_uv) {
+	const Vector2 centered = p_uv * 2.0 - Vector2(1, 1);
+	const float dist = centered.length() * Math::SQRT12;
+	Color result(0, 0, 0, p_params.vignette * Math::smoothstep(p_params.vignette_radius, p_params.vignette_radius + p_params.vignette_softness, dist));
+	result = _blend_over(result, p_params.flash);
+	return _blend_over(result, p_params.fade);
+}
+
+ScreenEffectsCompositor::Params ScreenEffectsCompositor::_get_params() const {
+	Params params;
+	params.fade = Color(fade_color.r, fade_color.g, fade_color.b, fade_envelope.get_value());
+	params.flash = Color(flash_color.r, flash_color.g, flash_color.b, flash_envelope.get_value());
+	params.vignette = MAX(vignette_intensity, vignette_envelope.get_value());
+	params.vignette_radius = vignette_radius;
+	params.vignette_softness = vignette_softness;
+	params.aberration = MAX(chromatic_aberration, aberration_envelope.get_value());
+	if (crt_enabled) {
+		params.scanline_intensity = scanline_intensity;
+		params.scanline_count = scanline_count;
+		params.curvature = curvature;
+	}
+	return params;
+}
+
+bool ScreenEffectsCompositor::_is_animating() const {
+	return flash_envelope.is_running() || fade_envelope.is_running() || vignette_envelope.is_running() || aberration_envelope.is_running();
+}
+
+void ScreenEffectsCompositor::_update() {
+	const Params params = _get_params();
+	const bool visible = params.is_visible();
+	if (visible != drawing) {
+		drawing = visible;
+		queue_redraw();
+	}
+
+	if (visible) {
+		const Ref<ShaderMaterial> &target = params.reads_screen() ? screen_material : overlay_material;
+		if (active_material != target) {
+			// Set on the canvas item directly, so the `material` property (and
+			// what gets saved with the scene) stays the user's.
+			active_material = target;
+			RS::get_singleton()->canvas_item_set_material(get_canvas_item(), target->get_rid());
+			has_uploaded = false;
+		}
+
+#define UPLOAD_PARAM(m_field)                                        \
+	if (!has_uploaded || params.m_field != uploaded.m_field) {       \
+		target->set_shader_parameter(SNAME(#m_field), params.m_field); \
+	}
+		UPLOAD_PARAM(fade);
+		UPLOAD_PARAM(flash);
+		UPLOAD_PARAM(vignette);
+		UPLOAD_PARAM(vignette_radius);
+		UPLOAD_PARAM(vignette_softness);
+		if (target == screen_material) {
+			UPLOAD_PARAM(aberration);
+			UPLOAD_PARAM(scanline_intensity);
+			UPLOAD_PARAM(scanline_count);
+			UPLOAD_PARAM(curvature);
+		}
+#undef UPLOAD_PARAM
+
+		uploaded = params;
+		has_uploaded = true;
+	}
+
+	set_process_internal(_is_animating());
+}
+
+void ScreenEffectsCompositor::flash(const Color &p_color, float p_duration) {
+	flash_color = p_color;
+	flash_envelope = Envelope();
+	flash_envelope.from = p_color.a;
+	flash_envelope.duration = MAX(0.0f, p_duration);
+	_update();
+}
+
+void ScreenEffectsCompositor::fade_to(const Color &p_color, float p_duration) {
+	// Starts from the current fade, so reversing a fade halfway doesn't jump.
+	const float alpha = get_fade_alpha();
+	fade_color = p_color;
+	fade_envelope = Envelope();
+	fade_envelope.from = alpha;
+	fade_envelope.to = p_color.a > 0.0f ? p_color.a : 1.0f;
+	fade_envelope.duration = MAX(0.0f, p_duration);
+	fade_signal_pending = true;
+	_update();
+}
+
+void ScreenEffectsCompositor::fade_from(const Color &p_color, float p_duration) {
+	fade_color = p_color;
+	fade_envelope = Envelope();
+	fade_envelope.from = p_color.a > 0.0f ? p_color.a : 1.0f;
+	fade_envelope.duration = MAX(0.0f, p_duration);
+	fade_signal_pending = true;
+	_update();
+}
+
+void ScreenEffectsCompositor::pulse_vignette(float p_intensity, float p_duration) {
+	vignette_envelope = Envelope();
+	vignette_envelope.to = CLAMP(p_intensity, 0.0f, 1.0f);
+	vignette_envelope.duration = MAX(0.0f, p_duration);
+	vignette_envelope.pulse = true;
+	_update();
+}
+
+void ScreenEffectsCompositor::pulse_chromatic_aberration(float p_intensity, float p_duration) {
+	aberration_envelope = Envelope();
+	aberration_envelope.from = MAX(0.0f, p_intensity);
+	aberration_envelope.duration = MAX(0.0f, p_duration);
+	_update();
+}
+
+void ScreenEffectsCompositor::clear_effects() {
+	flash_envelope = Envelope();
+	fade_envelope = Envelope();
+	fade_signal_pending = false;
+	vignette_envelope = Envelope();
+	aberration_envelope = Envelope();
+	_update();
+}
+
+void ScreenEffectsCompositor::step(double p_delta) {
+	Envelope *envelopes[] = { &flash_envelope, &fade_envelope, &vignette_envelope, &aberration_envelope };
+	for (Envelope *envelope : envelopes) {
+		envelope->time = MIN(envelope->time + float(p_delta), envelope->duration);
+	}
+	_update();
+
+	if (fade_signal_pending && !fade_envelope.is_running()) {
+		fade_signal_pending = false;
+		emit_signal(SNAME("fade_finished"));
+	}
+}
+
+Ref<Image> ScreenEffectsCompositor::render_reference(const Ref<Image> &p_screen) const {
+	ERR_FAIL_COND_V(p_screen.is_null() || p_screen->is_empty(), Ref<Image>());
+	ERR_FAIL_COND_V_MSG(p_screen->is_compressed(), Ref<Image>(), "The screen image can't be compressed.");
+
+	const Params params = _get_params();
+	const int width = p_screen->get_width();
+	const int height = p_screen->get_height();
+	Ref<Image> result = Image::create_empty(width, height, false, Image::FORMAT_RGBAF);
+
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			const Vector2 screen_uv((x + 0.5f) / width, (y + 0.5f) / height);
+			const Color over = _shade_overlay(params, screen_uv);
+			const Color screen = p_screen->get_pixel(x, y);
+
+			if (!params.is_visible()) {
+				result->set_pixel(x, y, screen);
+			} else if (!params.reads_screen()) {
+				// Blended by the canvas, with the "mix" blend mode.
+				Color color = screen.lerp(over, over.a);
+				color.a = over.a + screen.a * (1.0f - over.a);
+				result->set_pixel(x, y, color);
+			} else {
+				Vector2 centered = screen_uv * 2.0 - Vector2(1, 1);
+				centered *= 1.0f + params.curvature * centered.dot(centered);
+				const Vector2 uv = centered * 0.5 + Vector2(0.5, 0.5);
+				Color color(0, 0, 0);
+				if (uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f) {
+					const Vector2 offset = centered * params.aberration;
+					color.r = _sample(p_screen, uv + offset).r;
+					color.g = _sample(p_screen, uv).g;
+					color.b = _sample(p_screen, uv - offset).b;
+					const float scanline = 1.0f - params.scanline_intensity * (0.5f + 0.5f * Math::sin(uv.y * params.scanline_count * float(Math::TAU)));
+					color.r *= scanline;
+					color.g *= scanline;
+					color.b *= scanline;
+				}
+				color = color.lerp(over, over.a);
+				color.a = 1.0;
+				result->set_pixel(x, y, color);
+			}
+		}
+	}
+	return result;
+}
+
+void ScreenEffectsCompositor::set_vignette_intensity(float p_intensity) {
+	vignette_intensity = CLAMP(p_intensity, 0.0f, 1.0f);
+	_update();
+}
+
+void ScreenEffectsCompositor::set_vignette_radius(float p_radius) {
+	vignette_radius = CLAMP(p_radius, 0.0f, 1.0f);
+	_update();
+}
+
+void ScreenEffectsCompositor::set_vignette_softness(float p_softness) {
+	vignette_softness = CLAMP(p_softness, 0.01f, 1.0f);
+	_update();
+}
+
+void ScreenEffectsCompositor::set_chromatic_aberration(float p_amount) {
+	chromatic_aberration = MAX(0.0f, p_amount);
+	_update();
+}
+
+void ScreenEffectsCompositor::set_crt_enabled(bool p_enabled) {
+	crt_enabled = p_enabled;
+	_update();
+}
+
+void ScreenEffectsCompositor::set_scanline_intensity(float p_intensity) {
+	scanline_intensity = CLAMP(p_intensity, 0.0f, 1.0f);
+	_update();
+}
+
+void ScreenEffectsCompositor::set_scanline_count(float p_count) {
+	scanline_count = MAX(1.0f, p_count);
+	_update();
+}
+
+void ScreenEffectsCompositor::set_curvature(float p_curvature) {
+	curvature = CLAMP(p_curvature, 0.0f, 1.0f);
+	_update();
+}
+
+void ScreenEffectsCompositor::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_READY: {
+			_update();
+		} break;
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			step(get_process_delta_time());
+		} break;
+		case NOTIFICATION_DRAW: {
+			if (drawing) {
+				draw_rect(Rect2(Point2(), get_size()), Color(1, 1, 1));
+			}
+		} break;
+	}
+}
+
+void ScreenEffectsCompositor::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("flash", "color", "duration"), &ScreenEffectsCompositor::flash);
+	ClassDB::bind_method(D_METHOD("fade_to", "color", "duration"), &ScreenEffectsCompositor::fade_to);
+	ClassDB::bind_method(D_METHOD("fade_from", "color", "duration"), &ScreenEffectsCompositor::fade_from);
+	ClassDB::bind_method(D_METHOD("pulse_vignette", "intensity", "duration"), &ScreenEffectsCompositor::pulse_vignette);
+	ClassDB::bind_method(D_METHOD("pulse_chromatic_aberration", "intensity", "duration"), &ScreenEffectsCompositor::pulse_chromatic_aberration);
+	ClassDB::bind_method(D_METHOD("clear_effects"), &ScreenEffectsCompositor::clear_effects);
+
+	ClassDB::bind_method(D_METHOD("get_fade_alpha"), &ScreenEffectsCompositor::get_fade_alpha);
+	ClassDB::bind_method(D_METHOD("is_fading"), &ScreenEffectsCompositor::is_fading);
+	ClassDB::bind_method(D_METHOD("is_effect_visible"), &ScreenEffectsCompositor::is_effect_visible);
+	ClassDB::bind_method(D_METHOD("is_reading_screen"), &ScreenEffectsCompositor::is_reading_screen);
+
+	ClassDB::bind_method(D_METHOD("step", "delta"), &ScreenEffectsCompositor::step);
+	ClassDB::bind_method(D_METHOD("render_reference", "screen"), &ScreenEffectsCompositor::render_reference);
+
+	ClassDB::bind_method(D_METHOD("set_vignette_intensity", "intensity"), &ScreenEffectsCompositor::set_vignette_intensity);
+	ClassDB::bind_method(D_METHOD("get_vignette_intensity"), &ScreenEffectsCompositor::get_vignette_intensity);
+	ClassDB::bind_method(D_METHOD("set_vignette_radius", "radius"), &ScreenEffectsCompositor::set_vignette_radius);
+	ClassDB::bind_method(D_METHOD("get_vignette_radius"), &ScreenEffectsCompositor::get_vignette_radius);
+	ClassDB::bind_method(D_METHOD("set_vignette_softness", "softness"), &ScreenEffectsCompositor::set_vignette_softness);
+	ClassDB::bind_method(D_METHOD("get_vignette_softness"), &ScreenEffectsCompositor::get_vignette_softness);
+	ClassDB::bind_method(D_METHOD("set_chromatic_aberration", "amount"), &ScreenEffectsCompositor::set_chromatic_aberration);
+	ClassDB::bind_method(D_METHOD("get_chromatic_aberration"), &ScreenEffectsCompositor::get_chromatic_aberration);
+	ClassDB::bind_method(D_METHOD("set_crt_enabled", "enabled"), &ScreenEffectsCompositor::set_crt_enabled);
+	ClassDB::bind_method(D_METHOD("is_crt_enabled"), &ScreenEffectsCompositor::is_crt_enabled);
+	ClassDB::bind_method(D_METHOD("set_scanline_intensity", "intensity"), &ScreenEffectsCompositor::set_scanline_intensity);
+	ClassDB::bind_method(D_METHOD("get_scanline_intensity"), &ScreenEffectsCompositor::get_scanline_intensity);
+	ClassDB::bind_method(D_METHOD("set_scanline_count", "count"), &ScreenEffectsCompositor::set_scanline_count);
+	ClassDB::bind_method(D_METHOD("get_scanline_count"), &ScreenEffectsCompositor::get_scanline_count);
+	ClassDB::bind_method(D_METHOD("set_curvature", "curvature"), &ScreenEffectsCompositor::set_curvature);
+	ClassDB::bind_method(D_METHOD("get_curvature"), &ScreenEffectsCompositor::get_curvature);
+
+	ADD_GROUP("Vignette", "vignette_");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "vignette_intensity", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_vignette_intensity", "get_vignette_intensity");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "vignette_radius", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_vignette_radius", "get_vignette_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "vignette_softness", PROPERTY_HINT_RANGE, "0.01,1,0.01"), "set_vignette_softness", "get_vignette_softness");
+	ADD_GROUP("", "");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "chromatic_aberration", PROPERTY_HINT_RANGE, "0,0.05,0.001,or_greater"), "set_chromatic_aberration", "get_chromatic_aberration");
+	ADD_GROUP("CRT", "");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "crt_enabled"), "set_crt_enabled", "is_crt_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "scanline_intensity", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_scanline_intensity", "get_scanline_intensity");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "scanline_count", PROPERTY_HINT_RANGE, "1,1080,1,or_greater"), "set_scanline_count", "get_scanline_count");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "curvature", PROPERTY_HINT_RANGE, "0,0.2,0.001"), "set_curvature", "get_curvature");
+
+	ADD_SIGNAL(MethodInfo("fade_finished"));
+}
+
+ScreenEffectsCompositor::ScreenEffectsCompositor() {
+	set_mouse_filter(MOUSE_FILTER_IGNORE);
+
+	overlay_shader.instantiate();
+	overlay_shader->set_code(_get_shader_code(false));
+	overlay_material.instantiate();
+	overlay_material->set_shader(overlay_shader);
+
+	screen_shader.instantiate();
+	screen_shader->set_code(_get_shader_code(true));
+	screen_material.instantiate();
+	screen_material->set_shader(screen_shader);
+}
@@ -0,0 +1,151 @@
+/**************************************************************************/
+/*  screen_effects_compositor.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/image.h"
+#include "scene/gui/control.h"
+#include "scene/resources/material.h"
+
+// Draws every screen effect (flashes, fades, vignette, chromatic aberration
+// and the CRT filter) in a single full-screen pass, instead of one overlay
+// per effect. The effect state is kept on the CPU and reaches the shader as
+// uniforms, and only changed uniforms are sent. Nothing is drawn while no
+// effect is visible, and the screen is only copied for the effects that
+// distort it: flashes, fades and the vignette use a shader variant that
+// doesn't read the screen texture.
+//
+// render_reference() runs the same math on the CPU over an Image, so effect
+// output can be checked without a GPU.
+class ScreenEffectsCompositor : public Control {
+	GDCLASS(ScreenEffectsCompositor, Control);
+
+	// Uniform values; compared against the last upload to only send changes.
+	struct Params {
+		Color fade = Color(0, 0, 0, 0);
+		Color flash = Color(0, 0, 0, 0);
+		float vignette = 0.0;
+		float vignette_radius = 0.5;
+		float vignette_softness = 0.5;
+		float aberration = 0.0;
+		float scanline_intensity = 0.0;
+		float scanline_count = 240.0;
+		float curvature = 0.0;
+
+		bool reads_screen() const { return aberration > 0.0 || scanline_intensity > 0.0 || curvature > 0.0; }
+		bool is_visible() const { return fade.a > 0.0 || flash.a > 0.0 || vignette > 0.0 || reads_screen(); }
+	};
+
+	// A value that eases from one amount to another over a duration.
+	struct Envelope {
+		float from = 0.0;
+		float to = 0.0;
+		float time = 0.0;
+		float duration = 0.0;
+		bool pulse = false; // Goes from `from` to `to` and back.
+
+		bool is_running() const { return time < duration; }
+		float get_value() const;
+	};
+
+	Ref<Shader> overlay_shader;
+	Ref<Shader> screen_shader;
+	Ref<ShaderMaterial> overlay_material;
+	Ref<ShaderMaterial> screen_material;
+	Ref<ShaderMaterial> active_material; // Variant set on the canvas item.
+	Params uploaded;
+	bool has_uploaded = false;
+	bool drawing = false;
+
+	Color flash_color = Color(1, 0, 0, 0);
+	Envelope flash_envelope;
+	Color fade_color = Color(0, 0, 0);
+	Envelope fade_envelope;
+	bool fade_signal_pending = false;
+	Envelope vignette_envelope;
+	Envelope aberration_envelope;
+
+	float vignette_intensity = 0.0;
+	float vignette_radius = 0.5;
+	float vignette_softness = 0.5;
+	float chromatic_aberration = 0.0;
+	bool crt_enabled = false;
+	float scanline_intensity = 0.1;
+	float scanline_count = 240.0;
+	float curvature = 0.02;
+
+	static String _get_shader_code(bool p_reads_screen);
+	static Color _blend_over(const Color &p_dst, const Color &p_src);
+	static Color _sample(const Ref<Image> &p_image, const Vector2 &p_uv);
+	static Color _shade_overlay(const Params &p_params, const Vector2 &p_uv);
+
+	Params _get_params() const;
+	bool _is_animating() const;
+	void _update();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void flash(const Color &p_color, float p_duration);
+	void fade_to(const Color &p_color, float p_duration);
+	void fade_from(const Color &p_color, float p_duration);
+	void pulse_vignette(float p_intensity, float p_duration);
+	void pulse_chromatic_aberration(float p_intensity, float p_duration);
+	void clear_effects();
+
+	float get_fade_alpha() const { return fade_envelope.get_value(); }
+	bool is_fading() const { return fade_envelope.is_running(); }
+	bool is_effect_visible() const { return _get_params().is_visible(); }
+	bool is_reading_screen() const { return _get_params().reads_screen(); }
+
+	void step(double p_delta);
+	Ref<Image> render_reference(const Ref<Image> &p_screen) const;
+
+	void set_vignette_intensity(float p_intensity);
+	float get_vignette_intensity() const { return vignette_intensity; }
+	void set_vignette_radius(float p_radius);
+	float get_vignette_radius() const { return vignette_radius; }
+	void set_vignette_softness(float p_softness);
+	float get_vignette_softness() const { return vignette_softness; }
+	void set_chromatic_aberration(float p_amount);
+	float get_chromatic_aberration() const { return chromatic_aberration; }
+	void set_crt_enabled(bool p_enabled);
+	bool is_crt_enabled() const { return crt_enabled; }
+	void set_scanline_intensity(float p_intensity);
+	float get_scanline_intensity() const { return scanline_intensity; }
+	void set_scanline_count(float p_count);
+	float get_scanline_count() const { return scanline_count; }
+	void set_curvature(float p_curvature);
+	float get_curvature() const { return curvature; }
+
+	ScreenEffectsCompositor();
+};
@@ -0,0 +1,630 @@
+/**************************************************************************/
+/*  tactical_grid.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tactical_grid.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
+
+static const Vector2i tactical_grid_directions[4] = { Vector2i(1, 0), Vector2i(-1, 0), Vector2i(0, 1), Vector2i(0, -1) };
+
+_FORCE_INLINE_ static int _manhattan(const Vector2i &p_a, const Vector2i &p_b) {
+	return Math::abs(p_a.x - p_b.x) + Math::abs(p_a.y - p_b.y);
+}
+
+void TacticalGrid::Flood::resize(uint32_t p_cells) {
+	cost.resize(p_cells);
+	prev.resize(p_cells);
+	mark.resize(p_cells);
+	for (uint32_t i = 0; i < p_cells; i++) {
+		cost[i] = INFINITY;
+		prev[i] = -1;
+		mark[i] = 0;
+	}
+	mark_pass = 0;
+	visited.clear();
+	stops.clear();
+	heap.clear();
+}
+
+void TacticalGrid::Flood::reset() {
+	for (const uint32_t cell : visited) {
+		cost[cell] = INFINITY;
+		prev[cell] = -1;
+	}
+	visited.clear();
+	stops.clear();
+	heap.clear();
+}
+
+bool TacticalGrid::_sync_occupancy() {
+	ERR_FAIL_COND_V_MSG(is_dirty(), false, "Grid is not initialized. Call the update method.");
+
+	const Rect2i region = get_region();
+	if (region == occupancy_region && occupancy.size() == uint32_t(region.get_area())) {
+		return true;
+	}
+
+	// The region changed since the last query: rebuild the occupancy grid.
+	// Units left outside the region are kept but ignored until it grows back.
+	occupancy_region = region;
+	occupancy.resize(region.get_area());
+	for (int32_t &occupant : occupancy) {
+		occupant = -1;
+	}
+	for (uint32_t i = 0; i < units.size(); i++) {
+		if (units[i].active && region.has_point(units[i].cell)) {
+			int32_t &occupant = occupancy[_cell_index(units[i].cell)];
+			if (occupant < 0) {
+				occupant = i;
+			}
+		}
+	}
+	flood.resize(occupancy.size());
+	return true;
+}
+
+void TacticalGrid::_flood(const uint32_t *p_sources, uint32_t p_source_count, int32_t p_unit, Flood &r_flood) const {
+	// Dijkstra over the four orthogonal neighbors. With a unit, opponents
+	// block, the unit's movement caps the cost and cells it could end its
+	// move on are collected as stops in order of increasing cost. Without a
+	// unit this is a plain terrain distance field from the sources.
+	r_flood.reset();
+
+	const Unit *unit = p_unit >= 0 ? &units[p_unit] : nullptr;
+	const real_t max_cost = unit ? unit->movement : real_t(INFINITY);
+	SortArray<HeapEntry, HeapCompare> sorter;
+
+	for (uint32_t i = 0; i < p_source_count; i++) {
+		const uint32_t source = p_sources[i];
+		if (r_flood.cost[source] == 0.0) {
+			continue;
+		}
+		r_flood.cost[source] = 0.0;
+		r_flood.visited.push_back(source);
+		r_flood.heap.push_back({ 0.0, source });
+	}
+
+	while (!r_flood.heap.is_empty()) {
+		sorter.pop_heap(0, r_flood.heap.size(), r_flood.heap.ptr());
+		const HeapEntry entry = r_flood.heap[r_flood.heap.size() - 1];
+		r_flood.heap.remove_at(r_flood.heap.size() - 1);
+		if (entry.cost > r_flood.cost[entry.cell]) {
+			continue; // Stale entry, the cell was reached more cheaply since.
+		}
+
+		if (unit) {
+			const int32_t occupant = occupancy[entry.cell];
+			if (occupant < 0 || occupant == p_unit) {
+				r_flood.stops.push_back(entry.cell);
+			}
+		}
+
+		const Vector2i cell = _index_cell(entry.cell);
+		for (const Vector2i &direction : tactical_grid_directions) {
+			const Vector2i next = cell + direction;
+			if (!occupancy_region.has_point(next) || is_point_solid(next)) {
+				continue;
+			}
+			const uint32_t next_index = _cell_index(next);
+			if (unit) {
+				const int32_t occupant = occupancy[next_index];
+				if (occupant >= 0 && units[occupant].team != unit->team) {
+					continue;
+				}
+			}
+
+			const real_t cost = entry.cost + get_point_weight_scale(next);
+			if (cost > max_cost || cost >= r_flood.cost[next_index]) {
+				continue;
+			}
+			if (r_flood.cost[next_index] == real_t(INFINITY)) {
+				r_flood.visited.push_back(next_index);
+			}
+			r_flood.cost[next_index] = cost;
+			r_flood.prev[next_index] = entry.cell;
+			r_flood.heap.push_back({ cost, next_index });
+			sorter.push_heap(0, r_flood.heap.size() - 1, 0, r_flood.heap[r_flood.heap.size() - 1], r_flood.heap.ptr());
+		}
+	}
+}
+
+void TacticalGrid::_flood_movement(uint32_t p_unit, Flood &r_flood) const {
+	if (!occupancy_region.has_point(units[p_unit].cell)) {
+		r_flood.reset();
+		return;
+	}
+	const uint32_t start = _cell_index(units[p_unit].cell);
+	_flood(&start, 1, p_unit, r_flood);
+}
+
+void TacticalGrid::_collect_attack_cells(uint32_t p_unit, bool p_exclude_stops, Flood &r_flood, LocalVector<uint32_t> &r_cells) const {
+	// Stamps the attack ring of every stop, using the mark pass to add each
+	// cell once without clearing the mark array between calls.
+	const Unit &unit = units[p_unit];
+	r_flood.mark_pass++;
+	if (r_flood.mark_pass == 0) {
+		for (uint32_t &mark : r_flood.mark) {
+			mark = 0;
+		}
+		r_flood.mark_pass = 1;
+	}
+	const uint32_t pass = r_flood.mark_pass;
+
+	if (p_exclude_stops) {
+		for (const uint32_t stop : r_flood.stops) {
+			r_flood.mark[stop] = pass;
+		}
+	}
+
+	for (const uint32_t stop : r_flood.stops) {
+		const Vector2i cell = _index_cell(stop);
+		for (int dy = -unit.max_range; dy <= unit.max_range; dy++) {
+			const int reach = unit.max_range - Math::abs(dy);
+			for (int dx = -reach; dx <= reach; dx++) {
+				if (Math::abs(dx) + Math::abs(dy) < unit.min_range) {
+					continue;
+				}
+				const Vector2i target = cell + Vector2i(dx, dy);
+				if (!occupancy_region.has_point(target)) {
+					continue;
+				}
+				const uint32_t index = _cell_index(target);
+				if (r_flood.mark[index] == pass || is_point_solid(target)) {
+					continue;
+				}
+				r_flood.mark[index] = pass;
+				r_cells.push_back(index);
+			}
+		}
+	}
+}
+
+TacticalGrid::Flood &TacticalGrid::_get_thread_flood() {
+	// Only the owning thread touches its slot, so it can be resized here.
+	Flood &local = thread_floods[WorkerThreadPool::get_singleton()->get_thread_index() + 1];
+	if (local.cost.size() != occupancy.size()) {
+		local.resize(occupancy.size());
+	}
+	return local;
+}
+
+void TacticalGrid::_threat_task(uint32_t p_index, PlanData *p_data) {
+	Flood &local = _get_thread_flood();
+	_flood_movement(p_data->threats[p_index], local);
+	_collect_attack_cells(p_data->threats[p_index], false, local, p_data->attack_cells[p_index]);
+}
+
+void TacticalGrid::_compute_threat(PlanData &r_data) {
+	thread_floods.resize(WorkerThreadPool::get_singleton()->get_thread_count() + 1);
+	r_data.attack_cells.resize(r_data.threats.size());
+	if (r_data.threats.size() > 1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TacticalGrid::_threat_task, &r_data, r_data.threats.size(), -1, true, SNAME("TacticalGridThreat"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else if (r_data.threats.size() == 1) {
+		_threat_task(0, &r_data);
+	}
+
+	r_data.threat.resize(occupancy.size());
+	for (int32_t &threat : r_data.threat) {
+		threat = 0;
+	}
+	for (const LocalVector<uint32_t> &cells : r_data.attack_cells) {
+		for (const uint32_t cell : cells) {
+			r_data.threat[cell]++;
+		}
+	}
+}
+
+TacticalGrid::Action TacticalGrid::_evaluate(uint32_t p_unit, const PlanData &p_data, const LocalVector<uint8_t> *p_claimed, Flood &r_flood) const {
+	// Every stop is scored as the best attack available from it, minus the
+	// threat of standing there and the terrain distance to the nearest
+	// opponent. Ties keep the cheaper move, since stops come in cost order.
+	const Unit &unit = units[p_unit];
+	_flood_movement(p_unit, r_flood);
+
+	Action best;
+	for (const uint32_t stop : r_flood.stops) {
+		if (p_claimed && (*p_claimed)[stop]) {
+			continue;
+		}
+
+		const Vector2i cell = _index_cell(stop);
+		int32_t target = -1;
+		real_t value = 0.0;
+		if (unit.damage > 0) {
+			for (const uint32_t opponent : p_data.opponents) {
+				const Unit &other = units[opponent];
+				if (!_can_attack(unit, _manhattan(cell, other.cell))) {
+					continue;
+				}
+				real_t attack_value = MIN(unit.damage, other.health);
+				if (unit.damage >= other.health) {
+					attack_value += kill_bonus;
+				}
+				if (attack_value > value) {
+					value = attack_value;
+					target = opponent;
+				}
+			}
+		}
+
+		real_t score = value - threat_weight * p_data.threat[stop];
+		if (p_data.approach[stop] != real_t(INFINITY)) {
+			score -= approach_weight * p_data.approach[stop];
+		}
+		if (best.cell < 0 || score > best.score) {
+			best.cell = stop;
+			best.target = target;
+			best.score = score;
+		}
+	}
+	return best;
+}
+
+void TacticalGrid::_plan_task(uint32_t p_index, PlanData *p_data) {
+	Flood &local = _get_thread_flood();
+	p_data->actions[p_index] = _evaluate(p_data->units[p_index], *p_data, nullptr, local);
+}
+
+int TacticalGrid::add_unit(const Vector2i &p_cell, int p_team, real_t p_movement, int p_min_range, int p_max_range) {
+	ERR_FAIL_COND_V(!_sync_occupancy(), -1);
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_cell), -1, vformat("Can't add unit. Cell %s out of bounds %s.", p_cell, occupancy_region));
+	ERR_FAIL_COND_V_MSG(occupancy[_cell_index(p_cell)] >= 0, -1, vformat("Can't add unit. Cell %s is already occupied.", p_cell));
+	ERR_FAIL_COND_V(p_min_range < 0 || p_max_range < p_min_range, -1);
+
+	uint32_t id;
+	if (free_units.is_empty()) {
+		id = units.size();
+		units.push_back(Unit());
+	} else {
+		id = free_units[free_units.size() - 1];
+		free_units.remove_at(free_units.size() - 1);
+		units[id] = Unit();
+	}
+
+	Unit &unit = units[id];
+	unit.cell = p_cell;
+	unit.team = p_team;
+	unit.movement = MAX(0.0, p_movement);
+	unit.min_range = p_min_range;
+	unit.max_range = p_max_range;
+	unit.active = true;
+	occupancy[_cell_index(p_cell)] = id;
+	return id;
+}
+
+void TacticalGrid::remove_unit(int p_unit) {
+	ERR_FAIL_COND(!_is_unit(p_unit));
+	const Vector2i cell = units[p_unit].cell;
+	if (occupancy_region.has_point(cell) && occupancy.size() == uint32_t(occupancy_region.get_area()) && occupancy[_cell_index(cell)] == p_unit) {
+		occupancy[_cell_index(cell)] = -1;
+	}
+	units[p_unit].active = false;
+	free_units.push_back(p_unit);
+}
+
+int TacticalGrid::get_unit_at(const Vector2i &p_cell) {
+	ERR_FAIL_COND_V(!_sync_occupancy(), -1);
+	if (!occupancy_region.has_point(p_cell)) {
+		return -1;
+	}
+	return occupancy[_cell_index(p_cell)];
+}
+
+void TacticalGrid::clear_units() {
+	units.clear();
+	free_units.clear();
+	for (int32_t &occupant : occupancy) {
+		occupant = -1;
+	}
+}
+
+bool TacticalGrid::set_unit_cell(int p_unit, const Vector2i &p_cell) {
+	ERR_FAIL_COND_V(!_is_unit(p_unit), false);
+	ERR_FAIL_COND_V(!_sync_occupancy(), false);
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_cell), false, vformat("Can't move unit. Cell %s out of bounds %s.", p_cell, occupancy_region));
+
+	Unit &unit = units[p_unit];
+	const int32_t occupant = occupancy[_cell_index(p_cell)];
+	if (occupant >= 0) {
+		return occupant == p_unit;
+	}
+	if (occupancy_region.has_point(unit.cell) && occupancy[_cell_index(unit.cell)] == p_unit) {
+		occupancy[_cell_index(unit.cell)] = -1;
+	}
+	unit.cell = p_cell;
+	occupancy[_cell_index(p_cell)] = p_unit;
+	return true;
+}
+
+Vector2i TacticalGrid::get_unit_cell(int p_unit) const {
+	ERR_FAIL_COND_V(!_is_unit(p_unit), Vector2i());
+	return units[p_unit].cell;
+}
+
+void TacticalGrid::set_unit_team(int p_unit, int p_team) {
+	ERR_FAIL_COND(!_is_unit(p_unit));
+	units[p_unit].team = p_team;
+}
+
+int TacticalGrid::get_unit_team(int p_unit) const {
+	ERR_FAIL_COND_V(!_is_unit(p_unit), -1);
+	return units[p_unit].team;
+}
+
+void TacticalGrid::set_unit_movement(int p_unit, real_t p_movement) {
+	ERR_FAIL_COND(!_is_unit(p_unit));
+	units[p_unit].movement = MAX(0.0, p_movement);
+}
+
+real_t TacticalGrid::get_unit_movement(int p_unit) const {
+	ERR_FAIL_COND_V(!_is_unit(p_unit), 0.0);
+	return units[p_unit].movement;
+}
+
+void TacticalGrid::set_unit_attack_range(int p_unit, int p_min_range, int p_max_range) {
+	ERR_FAIL_COND(!_is_unit(p_unit));
+	ERR_FAIL_COND(p_min_range < 0 || p_max_range < p_min_range);
+	units[p_unit].min_range = p_min_range;
+	units[p_unit].max_range = p_max_range;
+}
+
+Vector2i TacticalGrid::get_unit_attack_range(int p_unit) const {
+	ERR_FAIL_COND_V(!_is_unit(p_unit), Vector2i());
+	return Vector2i(units[p_unit].min_range, units[p_unit].max_range);
+}
+
+void TacticalGrid::set_unit_damage(int p_unit, int p_damage) {
+	ERR_FAIL_COND(!_is_unit(p_unit));
+	units[p_unit].damage = p_damage;
+}
+
+int TacticalGrid::get_unit_damage(int p_unit) const {
+	ERR_FAIL_COND_V(!_is_unit(p_unit), 0);
+	return units[p_unit].damage;
+}
+
+void TacticalGrid::set_unit_health(int p_unit, int p_health) {
+	ERR_FAIL_COND(!_is_unit(p_unit));
+	units[p_unit].health = p_health;
+}
+
+int TacticalGrid::get_unit_health(int p_unit) const {
+	ERR_FAIL_COND_V(!_is_unit(p_unit), 0);
+	return units[p_unit].health;
+}
+
+TypedArray<Vector2i> TacticalGrid::get_movement_range(int p_unit) {
+	TypedArray<Vector2i> cells;
+	ERR_FAIL_COND_V(!_is_unit(p_unit), cells);
+	ERR_FAIL_COND_V(!_sync_occupancy(), cells);
+
+	_flood_movement(p_unit, flood);
+	cells.resize(flood.stops.size());
+	for (uint32_t i = 0; i < flood.stops.size(); i++) {
+		cells[i] = _index_cell(flood.stops[i]);
+	}
+	return cells;
+}
+
+TypedArray<Vector2i> TacticalGrid::get_move_path(int p_unit, const Vector2i &p_to) {
+	TypedArray<Vector2i> path;
+	ERR_FAIL_COND_V(!_is_unit(p_unit), path);
+	ERR_FAIL_COND_V(!_sync_occupancy(), path);
+	if (!occupancy_region.has_point(p_to)) {
+		return path;
+	}
+
+	_flood_movement(p_unit, flood);
+	const uint32_t end = _cell_index(p_to);
+	const int32_t occupant = occupancy[end];
+	if (flood.cost[end] == real_t(INFINITY) || (occupant >= 0 && occupant != p_unit)) {
+		return path;
+	}
+
+	LocalVector<uint32_t> cells;
+	for (int32_t cell = end; cell >= 0; cell = flood.prev[cell]) {
+		cells.push_back(cell);
+	}
+	path.resize(cells.size());
+	for (uint32_t i = 0; i < cells.size(); i++) {
+		path[i] = _index_cell(cells[cells.size() - 1 - i]);
+	}
+	return path;
+}
+
+TypedArray<Vector2i> TacticalGrid::get_attack_range(int p_unit) {
+	TypedArray<Vector2i> cells;
+	ERR_FAIL_COND_V(!_is_unit(p_unit), cells);
+	ERR_FAIL_COND_V(!_sync_occupancy(), cells);
+
+	LocalVector<uint32_t> attack_cells;
+	_flood_movement(p_unit, flood);
+	_collect_attack_cells(p_unit, true, flood, attack_cells);
+	cells.resize(attack_cells.size());
+	for (uint32_t i = 0; i < attack_cells.size(); i++) {
+		cells[i] = _index_cell(attack_cells[i]);
+	}
+	return cells;
+}
+
+PackedInt32Array TacticalGrid::get_targets_in_range(int p_unit, const Vector2i &p_from) {
+	PackedInt32Array targets;
+	ERR_FAIL_COND_V(!_is_unit(p_unit), targets);
+
+	const Unit &unit = units[p_unit];
+	for (uint32_t i = 0; i < units.size(); i++) {
+		const Unit &other = units[i];
+		if (other.active && other.team != unit.team && _can_attack(unit, _manhattan(p_from, other.cell))) {
+			targets.push_back(i);
+		}
+	}
+	return targets;
+}
+
+PackedInt32Array TacticalGrid::get_threat_map(int p_team) {
+	PackedInt32Array map;
+	ERR_FAIL_COND_V(!_sync_occupancy(), map);
+
+	PlanData data;
+	data.team = p_team;
+	for (uint32_t i = 0; i < units.size(); i++) {
+		const Unit &unit = units[i];
+		if (unit.active && unit.team != p_team && unit.damage > 0 && occupancy_region.has_point(unit.cell)) {
+			data.threats.push_back(i);
+		}
+	}
+	_compute_threat(data);
+
+	map.resize(data.threat.size());
+	int32_t *map_ptr = map.ptrw();
+	for (uint32_t i = 0; i < data.threat.size(); i++) {
+		map_ptr[i] = data.threat[i];
+	}
+	return map;
+}
+
+TypedArray<Dictionary> TacticalGrid::plan_turn(int p_team) {
+	TypedArray<Dictionary> plan;
+	ERR_FAIL_COND_V(!_sync_occupancy(), plan);
+
+	PlanData data;
+	data.team = p_team;
+	for (uint32_t i = 0; i < units.size(); i++) {
+		const Unit &unit = units[i];
+		if (!unit.active || !occupancy_region.has_point(unit.cell)) {
+			continue;
+		}
+		if (unit.team == p_team) {
+			data.units.push_back(i);
+		} else {
+			data.opponents.push_back(i);
+			if (unit.damage > 0) {
+				data.threats.push_back(i);
+			}
+		}
+	}
+	if (data.units.is_empty()) {
+		return plan;
+	}
+
+	_compute_threat(data);
+
+	LocalVector<uint32_t> sources;
+	for (const uint32_t opponent : data.opponents) {
+		sources.push_back(_cell_index(units[opponent].cell));
+	}
+	_flood(sources.ptr(), sources.size(), -1, flood);
+	data.approach = flood.cost;
+
+	// Units are scored independently against the state at the start of the
+	// turn, then destinations are resolved in unit order: a unit whose cell
+	// was already claimed is rescored without the claimed cells.
+	data.actions.resize(data.units.size());
+	if (data.units.size() > 1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TacticalGrid::_plan_task, &data, data.units.size(), -1, true, SNAME("TacticalGridPlan"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		_plan_task(0, &data);
+	}
+
+	LocalVector<uint8_t> claimed;
+	claimed.resize(occupancy.size());
+	for (uint8_t &cell : claimed) {
+		cell = 0;
+	}
+
+	plan.resize(data.units.size());
+	for (uint32_t i = 0; i < data.units.size(); i++) {
+		const uint32_t unit = data.units[i];
+		Action action = data.actions[i];
+		if (action.cell >= 0 && claimed[action.cell]) {
+			action = _evaluate(unit, data, &claimed, flood);
+		}
+		if (action.cell >= 0) {
+			claimed[action.cell] = 1;
+		}
+
+		Dictionary entry;
+		entry["unit"] = unit;
+		entry["cell"] = action.cell >= 0 ? _index_cell(action.cell) : units[unit].cell;
+		entry["target"] = action.target;
+		entry["score"] = action.score;
+		plan[i] = entry;
+	}
+	return plan;
+}
+
+void TacticalGrid::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_unit", "cell", "team", "movement", "min_range", "max_range"), &TacticalGrid::add_unit, DEFVAL(1), DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("remove_unit", "unit"), &TacticalGrid::remove_unit);
+	ClassDB::bind_method(D_METHOD("has_unit", "unit"), &TacticalGrid::has_unit);
+	ClassDB::bind_method(D_METHOD("get_unit_at", "cell"), &TacticalGrid::get_unit_at);
+	ClassDB::bind_method(D_METHOD("clear_units"), &TacticalGrid::clear_units);
+
+	ClassDB::bind_method(D_METHOD("set_unit_cell", "unit", "cell"), &TacticalGrid::set_unit_cell);
+	ClassDB::bind_method(D_METHOD("get_unit_cell", "unit"), &TacticalGrid::get_unit_cell);
+	ClassDB::bind_method(D_METHOD("set_unit_team", "unit", "team"), &TacticalGrid::set_unit_team);
+	ClassDB::bind_method(D_METHOD("get_unit_team", "unit"), &TacticalGrid::get_unit_team);
+	ClassDB::bind_method(D_METHOD("set_unit_movement", "unit", "movement"), &TacticalGrid::set_unit_movement);
+	ClassDB::bind_method(D_METHOD("get_unit_movement", "unit"), &TacticalGrid::get_unit_movement);
+	ClassDB::bind_method(D_METHOD("set_unit_attack_range", "unit", "min_range", "max_range"), &TacticalGrid::set_unit_attack_range);
+	ClassDB::bind_method(D_METHOD("get_unit_attack_range", "unit"), &TacticalGrid::get_unit_attack_range);
+	ClassDB::bind_method(D_METHOD("set_unit_damage", "unit", "damage"), &TacticalGrid::set_unit_damage);
+	ClassDB::bind_method(D_METHOD("get_unit_damage", "unit"), &TacticalGrid::get_unit_damage);
+	ClassDB::bind_method(D_METHOD("set_unit_health", "unit", "health"), &TacticalGrid::set_unit_health);
+	ClassDB::bind_method(D_METHOD("get_unit_health", "unit"), &TacticalGrid::get_unit_health);
+
+	ClassDB::bind_method(D_METHOD("get_movement_range", "unit"), &TacticalGrid::get_movement_range);
+	ClassDB::bind_method(D_METHOD("get_move_path", "unit", "to"), &TacticalGrid::get_move_path);
+	ClassDB::bind_method(D_METHOD("get_attack_range", "unit"), &TacticalGrid::get_attack_range);
+	ClassDB::bind_method(D_METHOD("get_targets_in_range", "unit", "from"), &TacticalGrid::get_targets_in_range);
+	ClassDB::bind_method(D_METHOD("get_threat_map", "team"), &TacticalGrid::get_threat_map);
+	ClassDB::bind_method(D_METHOD("plan_turn", "team"), &TacticalGrid::plan_turn);
+
+	ClassDB::bind_method(D_METHOD("set_threat_weight", "weight"), &TacticalGrid::set_threat_weight);
+	ClassDB::bind_method(D_METHOD("get_threat_weight"), &TacticalGrid::get_threat_weight);
+	ClassDB::bind_method(D_METHOD("set_approach_weight", "weight"), &TacticalGrid::set_approach_weight);
+	ClassDB::bind_method(D_METHOD("get_approach_weight"), &TacticalGrid::get_approach_weight);
+	ClassDB::bind_method(D_METHOD("set_kill_bonus", "bonus"), &TacticalGrid::set_kill_bonus);
+	ClassDB::bind_method(D_METHOD("get_kill_bonus"), &TacticalGrid::get_kill_bonus);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "threat_weight"), "set_threat_weight", "get_threat_weight");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "approach_weight"), "set_approach_weight", "get_approach_weight");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "kill_bonus"), "set_kill_bonus", "get_kill_bonus");
+}
+
+TacticalGrid::TacticalGrid() {
+	// Units move orthogonally, so paths from the base class should as well.
+	set_diagonal_mode(DIAGONAL_MODE_NEVER);
+	set_default_compute_heuristic(HEURISTIC_MANHATTAN);
+	set_default_estimate_heuristic(HEURISTIC_MANHATTAN);
+}
@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  tactical_grid.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/a_star_grid_2d.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/typed_array.h"
+
+// Grid tactics on top of AStarGrid2D: solid points are walls and point
+// weight scales are the terrain cost of entering a cell. Units occupy cells
+// and belong to teams; a unit may pass through its own team but not through
+// opponents. Movement ranges are Dijkstra flood fills over the four
+// orthogonal neighbors, attack ranges are Manhattan rings around every cell
+// the unit can stop on, and threat maps count how many opponents can strike
+// each cell next turn. AI turn planning scores every reachable cell for each
+// unit of a team, one unit per WorkerThreadPool element.
+class TacticalGrid : public AStarGrid2D {
+	GDCLASS(TacticalGrid, AStarGrid2D);
+
+	struct Unit {
+		Vector2i cell;
+		int team = 0;
+		real_t movement = 0.0;
+		int min_range = 1;
+		int max_range = 1;
+		int damage = 0;
+		int health = 1;
+		bool active = false;
+	};
+
+	struct HeapEntry {
+		real_t cost = 0.0;
+		uint32_t cell = 0;
+	};
+
+	struct HeapCompare {
+		_FORCE_INLINE_ bool operator()(const HeapEntry &p_a, const HeapEntry &p_b) const {
+			return p_a.cost > p_b.cost;
+		}
+	};
+
+	// Scratch for flood fills. Costs are left at INFINITY for
+	// unvisited cells and reset through the visited list, so a flood only
+	// touches the cells it reached.
+	struct Flood {
+		LocalVector<real_t> cost;
+		LocalVector<int32_t> prev;
+		LocalVector<uint32_t> visited;
+		LocalVector<uint32_t> stops;
+		LocalVector<HeapEntry> heap;
+		LocalVector<uint32_t> mark;
+		uint32_t mark_pass = 0;
+
+		void resize(uint32_t p_cells);
+		void reset();
+	};
+
+	struct Action {
+		int32_t cell = -1;
+		int32_t target = -1;
+		real_t score = 0.0;
+	};
+
+	struct PlanData {
+		int team = 0;
+		LocalVector<uint32_t> units;
+		LocalVector<uint32_t> opponents;
+		LocalVector<uint32_t> threats;
+		LocalVector<int32_t> threat;
+		LocalVector<real_t> approach;
+		LocalVector<Action> actions;
+		LocalVector<LocalVector<uint32_t>> attack_cells;
+	};
+
+	LocalVector<Unit> units;
+	LocalVector<uint32_t> free_units;
+	LocalVector<int32_t> occupancy;
+	Rect2i occupancy_region;
+	Flood flood;
+	// Indexed by worker thread, after the calling thread at 0. Kept between
+	// plans so tasks only resize them when the grid changes.
+	LocalVector<Flood> thread_floods;
+
+	real_t threat_weight = 2.0;
+	real_t approach_weight = 1.0;
+	real_t kill_bonus = 50.0;
+
+	_FORCE_INLINE_ uint32_t _cell_index(const Vector2i &p_cell) const {
+		return (p_cell.y - occupancy_region.position.y) * occupancy_region.size.x + p_cell.x - occupancy_region.position.x;
+	}
+	_FORCE_INLINE_ Vector2i _index_cell(uint32_t p_index) const {
+		return occupancy_region.position + Vector2i(p_index % occupancy_region.size.x, p_index / occupancy_region.size.x);
+	}
+	_FORCE_INLINE_ bool _is_unit(int p_unit) const {
+		return p_unit >= 0 && p_unit < int(units.size()) && units[p_unit].active;
+	}
+
+	bool _sync_occupancy();
+	bool _can_attack(const Unit &p_unit, int p_distance) const {
+		return p_distance >= p_unit.min_range && p_distance <= p_unit.max_range;
+	}
+
+	void _flood(const uint32_t *p_sources, uint32_t p_source_count, int32_t p_unit, Flood &r_flood) const;
+	void _flood_movement(uint32_t p_unit, Flood &r_flood) const;
+	void _collect_attack_cells(uint32_t p_unit, bool p_exclude_stops, Flood &r_flood, LocalVector<uint32_t> &r_cells) const;
+	void _compute_threat(PlanData &r_data);
+	Action _evaluate(uint32_t p_unit, const PlanData &p_data, const LocalVector<uint8_t> *p_claimed, Flood &r_flood) const;
+
+	Flood &_get_thread_flood();
+	void _threat_task(uint32_t p_index, PlanData *p_data);
+	void _plan_task(uint32_t p_index, PlanData *p_data);
+
+protected:
+	static void _bind_methods();
+
+public:
+	int add_unit(const Vector2i &p_cell, int p_team, real_t p_movement, int p_min_range = 1, int p_max_range = 1);
+	void remove_unit(int p_unit);
+	bool has_unit(int p_unit) const { return _is_unit(p_unit); }
+	int get_unit_at(const Vector2i &p_cell);
+	void clear_units();
+
+	bool set_unit_cell(int p_unit, const Vector2i &p_cell);
+	Vector2i get_unit_cell(int p_unit) const;
+	void set_unit_team(int p_unit, int p_team);
+	int get_unit_team(int p_unit) const;
+	void set_unit_movement(int p_unit, real_t p_movement);
+	real_t get_unit_movement(int p_unit) const;
+	void set_unit_attack_range(int p_unit, int p_min_range, int p_max_range);
+	Vector2i get_unit_attack_range(int p_unit) const;
+	void set_unit_damage(int p_unit, int p_damage);
+	int get_unit_damage(int p_unit) const;
+	void set_unit_health(int p_unit, int p_health);
+	int get_unit_health(int p_unit) const;
+
+	TypedArray<Vector2i> get_movement_range(int p_unit);
+	TypedArray<Vector2i> get_move_path(int p_unit, const Vector2i &p_to);
+	TypedArray<Vector2i> get_attack_range(int p_unit);
+	PackedInt32Array get_targets_in_range(int p_unit, const Vector2i &p_from);
+	PackedInt32Array get_threat_map(int p_team);
+	TypedArray<Dictionary> plan_turn(int p_team);
+
+	void set_threat_weight(real_t p_weight) { threat_weight = p_weight; }
+	real_t get_threat_weight() const { return threat_weight; }
+	void set_approach_weight(real_t p_weight) { approach_weight = p_weight; }
+	real_t get_approach_weight() const { return approach_weight; }
+	void set_kill_bonus(real_t p_bonus) { kill_bonus = p_bonus; }
+	real_t get_kill_bonus() const { return kill_bonus; }
+
+	TacticalGrid();
+};
@@ -0,0 +1,231 @@
+/**************************************************************************/
+/*  test_battle_simulator.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "../battle_simulator.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBattleSimulator {
+
+static Ref<BattleSimulator> _create_simulator() {
+	Ref<BattleSimulator> simulator;
+	simulator.instantiate();
+	simulator->set_type_effectiveness("water", "fire", 2.0);
+	simulator->set_type_effectiveness("fire", "water", 0.5);
+	simulator->set_type_effectiveness("normal", "ghost", 0.0);
+
+	Dictionary sleep;
+	sleep["min_turns"] = 1;
+	sleep["max_turns"] = 3;
+	sleep["skip_chance"] = 1.0;
+	simulator->add_effect("sleep", sleep);
+
+	Dictionary tackle;
+	tackle["type"] = "normal";
+	tackle["power"] = 40;
+	simulator->add_move("tackle", tackle);
+
+	Dictionary water_gun;
+	water_gun["type"] = "water";
+	water_gun["power"] = 40;
+	water_gun["category"] = "special";
+	simulator->add_move("water_gun", water_gun);
+
+	Dictionary ember;
+	ember["type"] = "fire";
+	ember["power"] = 40;
+	ember["category"] = "special";
+	simulator->add_move("ember", ember);
+
+	Dictionary hypnosis;
+	hypnosis["category"] = "status";
+	hypnosis["effect"] = "sleep";
+	hypnosis["accuracy"] = 60;
+	simulator->add_move("hypnosis", hypnosis);
+	return simulator;
+}
+
+static Dictionary _combatant(const String &p_type, const Array &p_moves, int p_speed = 50) {
+	Dictionary data;
+	data["level"] = 20;
+	data["hp"] = 60;
+	data["speed"] = p_speed;
+	data["type1"] = p_type;
+	data["moves"] = p_moves;
+	return data;
+}
+
+TEST_CASE("[BattleSimulator] Tables and combatants") {
+	Ref<BattleSimulator> simulator = _create_simulator();
+	CHECK(simulator->get_type_effectiveness("water", "fire") == 2.0);
+	CHECK(simulator->get_type_effectiveness("fire", "grass") == 1.0);
+	CHECK(simulator->has_move("tackle"));
+	CHECK(simulator->has_effect("sleep"));
+
+	const int squirtle = simulator->add_combatant(0, _combatant("water", { "tackle", "water_gun" }));
+	const int charmander = simulator->add_combatant(1, _combatant("fire", { "tackle", "ember" }));
+	CHECK(simulator->get_combatant_count() == 2);
+	CHECK(simulator->get_combatant_team(charmander) == 1);
+	CHECK(simulator->get_combatant_move(squirtle, 1) == StringName("water_gun"));
+	CHECK(simulator->get_combatant_move(squirtle, 2) == StringName());
+	CHECK(simulator->get_move_pp(squirtle, 0) == 10);
+
+	ERR_PRINT_OFF;
+	CHECK(simulator->add_combatant(2, Dictionary()) == -1);
+	CHECK(simulator->add_combatant(0, _combatant("water", { "surf" })) == -1);
+	Dictionary bad_move;
+	bad_move["effect"] = "burn";
+	CHECK(simulator->add_move("flame_wheel", bad_move) == -1);
+	CHECK(simulator->step_turn().is_empty());
+	ERR_PRINT_ON;
+	CHECK(simulator->get_combatant_count() == 2);
+}
+
+TEST_CASE("[BattleSimulator] AI and turns") {
+	Ref<BattleSimulator> simulator = _create_simulator();
+	const int squirtle = simulator->add_combatant(0, _combatant("water", { "tackle", "water_gun" }, 40));
+	const int charmander = simulator->add_combatant(1, _combatant("fire", { "tackle", "ember" }, 60));
+	simulator->start(7);
+
+	CHECK(simulator->get_active_combatant(0) == squirtle);
+	CHECK(simulator->get_active_combatant(1) == charmander);
+	// Super effective beats a neutral move of the same power.
+	CHECK(simulator->choose_move(squirtle) == 1);
+	CHECK(simulator->choose_target(squirtle, 1) == charmander);
+	CHECK(simulator->get_turn_order() == PackedInt32Array({ charmander, squirtle }));
+
+	simulator->set_choice(squirtle, 0);
+	const Array events = simulator->step_turn();
+	REQUIRE(events.size() >= 2);
+	const Dictionary first = events[0];
+	const Dictionary second = events[1];
+	CHECK(first["user"] == Variant(charmander));
+	CHECK(second["user"] == Variant(squirtle));
+	CHECK(second["move"] == Variant(StringName("tackle")));
+	CHECK(simulator->get_move_pp(squirtle, 0) == 9);
+	CHECK(simulator->get_turn() == 1);
+
+	if (!bool(first["missed"])) {
+		CHECK(simulator->get_combatant_hp(squirtle) == 60 - int(first["damage"]));
+	}
+}
+
+TEST_CASE("[BattleSimulator] Immunity and status effects") {
+	Ref<BattleSimulator> simulator = _create_simulator();
+	const int gastly = simulator->add_combatant(0, _combatant("ghost", { "hypnosis" }));
+	const int rattata = simulator->add_combatant(1, _combatant("normal", { "tackle" }));
+	simulator->start(1);
+
+	const Dictionary hit = simulator->use_move(rattata, 0, gastly);
+	CHECK(hit["damage"] == Variant(0));
+	CHECK(hit["effectiveness"] == Variant(0.0));
+	CHECK(simulator->get_combatant_hp(gastly) == 60);
+
+	// Retry until the 60% accurate move lands.
+	for (int i = 0; i < 20 && simulator->get_combatant_status(rattata) == StringName(); i++) {
+		simulator->use_move(gastly, 0, rattata);
+	}
+	CHECK(simulator->get_combatant_status(rattata) == StringName("sleep"));
+
+	const Dictionary skipped = simulator->use_move(rattata, 0, gastly);
+	CHECK(bool(skipped["skipped"]));
+
+	for (int i = 0; i < 3 && simulator->get_combatant_status(rattata) != StringName(); i++) {
+		simulator->end_turn();
+	}
+	CHECK(simulator->get_combatant_status(rattata) == StringName());
+}
+
+TEST_CASE("[BattleSimulator] Seeds replay battles") {
+	Ref<BattleSimulator> simulator = _create_simulator();
+	simulator->add_combatant(0, _combatant("water", { "tackle", "water_gun" }));
+	simulator->add_combatant(0, _combatant("normal", { "tackle", "hypnosis" }));
+	simulator->add_combatant(1, _combatant("fire", { "tackle", "ember" }));
+	simulator->add_combatant(1, _combatant("ghost", { "hypnosis" }));
+
+	const Dictionary result = simulator->simulate(42);
+	CHECK(result == simulator->simulate(42));
+	CHECK(int(result["turns"]) > 0);
+	CHECK(int(result["turns"]) <= simulator->get_max_turns());
+
+	// Playing the battle turn by turn gives the same result.
+	simulator->start(42);
+	while (!simulator->is_finished()) {
+		simulator->step_turn();
+	}
+	CHECK(simulator->get_winner() == int(result["winner"]));
+	CHECK(simulator->get_turn() == int(result["turns"]));
+
+	const Dictionary batch = simulator->simulate_batch(200, 100);
+	const PackedInt32Array winners = batch["winners"];
+	const PackedInt32Array wins = batch["wins"];
+	REQUIRE(winners.size() == 200);
+	CHECK(wins[0] + wins[1] + int(batch["draws"]) == 200);
+	const Dictionary replay = simulator->simulate(100 + 57);
+	CHECK(winners[57] == int(replay["winner"]));
+	CHECK(simulator->simulate_batch(200, 100) == batch);
+}
+
+TEST_CASE("[BattleSimulator] Party battles") {
+	Ref<BattleSimulator> simulator = _create_simulator();
+	simulator->set_mode(BattleSimulator::MODE_PARTY);
+	simulator->set_damage_formula(BattleSimulator::DAMAGE_FORMULA_SUBTRACTIVE);
+
+	Dictionary heal;
+	heal["category"] = "status";
+	heal["target"] = "self";
+	heal["heal"] = 0.5;
+	simulator->add_move("heal", heal);
+
+	const int hero = simulator->add_combatant(0, _combatant("normal", { "tackle", "heal" }, 80));
+	const int mage = simulator->add_combatant(0, _combatant("fire", { "ember" }, 70));
+	const int slime = simulator->add_combatant(1, _combatant("water", { "tackle" }, 10));
+	const int bat = simulator->add_combatant(1, _combatant("normal", { "tackle" }, 20));
+	simulator->start(3);
+
+	CHECK(simulator->get_active_combatant(0) == -1);
+	CHECK(simulator->get_turn_order() == PackedInt32Array({ hero, mage, bat, slime }));
+	// Fire is resisted by the slime, so the mage goes for the bat.
+	CHECK(simulator->choose_target(mage, 0) == bat);
+
+	simulator->set_combatant_hp(hero, 10);
+	CHECK(simulator->choose_move(hero) == 1);
+	const Dictionary healed = simulator->use_move(hero, 1, hero);
+	CHECK(healed["target"] == Variant(hero));
+	CHECK(simulator->get_combatant_hp(hero) == 10 + int(healed["heal"]));
+
+	simulator->set_combatant_hp(slime, 0);
+	simulator->set_combatant_hp(bat, 0);
+	CHECK(simulator->is_finished());
+	CHECK(simulator->get_winner() == 0);
+}
+
+} // namespace TestBattleSimulator
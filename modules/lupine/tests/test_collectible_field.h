@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  test_collectible_field.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "../collectible_field.h"
+
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#include "tests/test_macros.h"
+
+namespace TestCollectibleField {
+
+static int collected_count = 0;
+static int collected_value = 0;
+static Node2D *last_collector = nullptr;
+
+static void _on_collected(Node2D *p_collector, int p_id, int p_value, const Vector2 &p_position) {
+	collected_count++;
+	collected_value += p_value;
+	last_collector = p_collector;
+}
+
+TEST_CASE("[SceneTree][CollectibleField] Collectibles stay packed") {
+	CollectibleField *field = memnew(CollectibleField);
+
+	const int a = field->add_collectible(Vector2(0, 0));
+	const int b = field->add_collectible(Vector2(20, 0), 5);
+	const int c = field->add_collectible(Vector2(500, 0));
+	CHECK(field->get_collectible_count() == 3);
+	CHECK(field->get_collectible_value(b) == 5);
+
+	PackedInt32Array nearby = field->get_collectibles_in_radius(Vector2(), 30.0);
+	CHECK(nearby.size() == 2);
+	CHECK(nearby.has(a));
+	CHECK(nearby.has(b));
+
+	field->remove_collectible(a);
+	CHECK_FALSE(field->has_collectible(a));
+	CHECK(field->get_collectible_count() == 2);
+	CHECK(field->get_collectible_position(c) == Vector2(500, 0));
+	CHECK(field->get_collectibles_in_radius(Vector2(), 30.0) == PackedInt32Array({ b }));
+
+	field->set_collectible_position(c, Vector2(10, 10));
+	CHECK(field->get_collectibles_in_radius(Vector2(), 30.0).size() == 2);
+
+	CHECK(field->add_collectible(Vector2(1000, 1000)) == a);
+
+	ERR_PRINT_OFF;
+	field->remove_collectible(42);
+	CHECK_FALSE(field->collect(42));
+	ERR_PRINT_ON;
+	CHECK(field->get_collectible_count() == 3);
+
+	field->clear_collectibles();
+	CHECK(field->get_collectible_count() == 0);
+	CHECK(field->get_collectibles_in_radius(Vector2(), 10000.0).is_empty());
+
+	memdelete(field);
+}
+
+TEST_CASE("[SceneTree][CollectibleField] Targets pick up collectibles") {
+	CollectibleField *field = memnew(CollectibleField);
+	field->set_position(Vector2(100, 0));
+	field->set_active(false);
+	SceneTree::get_singleton()->get_root()->add_child(field);
+
+	Node2D *player = memnew(Node2D);
+	player->set_position(Vector2(100, 0));
+	SceneTree::get_singleton()->get_root()->add_child(player);
+	field->add_target(player);
+
+	collected_count = 0;
+	collected_value = 0;
+	last_collector = nullptr;
+	field->connect("collected", callable_mp_static(&_on_collected));
+
+	// Positions are local to the field, so only the first is under the player.
+	const int near = field->add_collectible(Vector2(5, 0), 10);
+	const int far = field->add_collectible(Vector2(200, 0), 10);
+
+	field->step(0.1);
+	CHECK(collected_count == 1);
+	CHECK(collected_value == 10);
+	CHECK(last_collector == player);
+	CHECK_FALSE(field->has_collectible(near));
+	CHECK(field->has_collectible(far));
+	CHECK(field->get_collectible_count() == 1);
+
+	SUBCASE("Collected instances are removed after the animation") {
+		field->step(field->get_collect_duration() + 0.01);
+		CHECK(collected_count == 1);
+		CHECK(field->get_collectibles_in_radius(Vector2(5, 0), 10.0).is_empty());
+		CHECK(field->add_collectible(Vector2(300, 0)) == near);
+	}
+
+	SUBCASE("Manual collection") {
+		field->set_auto_collect(false);
+		field->set_collect_duration(0.0);
+		player->set_position(Vector2(300, 0));
+		field->step(0.1);
+		CHECK(collected_count == 1);
+
+		CHECK(field->collect(far, player));
+		CHECK_FALSE(field->collect(far, player));
+		CHECK(collected_count == 2);
+		CHECK(field->get_collectible_count() == 0);
+	}
+
+	memdelete(player);
+	memdelete(field);
+}
+
+} // namespace TestCollectibleField
@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  test_crowd_2d.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../crowd_2d.h"
+
+#include "scene/2d/node_2d.h"
+#include "tests/test_macros.h"
+
+namespace TestCrowd2D {
+
+static int event_count = 0;
+static int last_event_state = -1;
+
+static void _on_agent_event(int p_state, bool p_facing_left) {
+	event_count++;
+	last_event_state = p_state;
+}
+
+TEST_CASE("[Crowd2D] Agents stay packed") {
+	Crowd2D *crowd = memnew(Crowd2D);
+
+	const int a = crowd->add_agent(Vector2(0, 0));
+	const int b = crowd->add_agent(Vector2(50, 0));
+	const int c = crowd->add_agent(Vector2(500, 0));
+	CHECK(crowd->get_agent_count() == 3);
+
+	PackedInt32Array nearby = crowd->get_agents_in_radius(Vector2(), 60.0);
+	CHECK(nearby.size() == 2);
+	CHECK(nearby.has(a));
+	CHECK(nearby.has(b));
+
+	crowd->remove_agent(a);
+	CHECK_FALSE(crowd->has_agent(a));
+	CHECK(crowd->get_agent_count() == 2);
+	CHECK(crowd->get_agent_position(c) == Vector2(500, 0));
+	CHECK(crowd->get_agents_in_radius(Vector2(), 60.0) == PackedInt32Array({ b }));
+
+	CHECK(crowd->add_agent(Vector2(10, 10)) == a);
+
+	ERR_PRINT_OFF;
+	crowd->remove_agent(42);
+	ERR_PRINT_ON;
+	CHECK(crowd->get_agent_count() == 3);
+
+	memdelete(crowd);
+}
+
+TEST_CASE("[Crowd2D] Wandering stays near home") {
+	Crowd2D *crowd = memnew(Crowd2D);
+	crowd->set_separation_radius(0.0);
+	const int agent = crowd->add_agent(Vector2(100, 100));
+	crowd->set_agent_wander_radius(agent, 200.0);
+
+	bool wandered = false;
+	for (int i = 0; i < 200; i++) {
+		crowd->step(0.05);
+		wandered = wandered || crowd->get_agent_state(agent) == Crowd2D::STATE_WANDER;
+		CHECK(crowd->get_agent_position(agent).distance_to(Vector2(100, 100)) <= 200.0 + 10.0);
+	}
+	CHECK(wandered);
+
+	memdelete(crowd);
+}
+
+TEST_CASE("[Crowd2D] Chase, attack and return") {
+	Crowd2D *crowd = memnew(Crowd2D);
+	Node2D *player = memnew(Node2D);
+	player->set_position(Vector2(100, 0));
+	crowd->add_target(player);
+
+	const int agent = crowd->add_agent(Vector2(), Crowd2D::REACTION_CHASE);
+	crowd->set_agent_speed(agent, 100.0);
+	crowd->set_agent_perception_radius(agent, 150.0);
+	crowd->set_agent_reach(agent, 20.0);
+	crowd->set_agent_wander_radius(agent, 0.0);
+
+	crowd->step(0.1);
+	CHECK(crowd->get_agent_state(agent) == Crowd2D::STATE_CHASE);
+	CHECK(crowd->get_agent_target(agent) == player);
+	CHECK(crowd->get_agent_position(agent).x > 0.0);
+	CHECK_FALSE(crowd->is_agent_facing_left(agent));
+
+	for (int i = 0; i < 10; i++) {
+		crowd->step(0.1);
+	}
+	CHECK(crowd->get_agent_state(agent) == Crowd2D::STATE_ATTACK);
+	CHECK(crowd->get_agent_target_distance(agent) <= 20.0);
+
+	player->set_position(Vector2(1000, 0));
+	crowd->step(0.1);
+	CHECK(crowd->get_agent_state(agent) == Crowd2D::STATE_RETURN);
+	CHECK(crowd->get_agent_target(agent) == nullptr);
+	CHECK(crowd->is_agent_facing_left(agent));
+
+	memdelete(player);
+	memdelete(crowd);
+}
+
+TEST_CASE("[Crowd2D] Nodes and callbacks") {
+	Crowd2D *crowd = memnew(Crowd2D);
+	Node2D *player = memnew(Node2D);
+	player->set_position(Vector2(10, 0));
+	crowd->add_target(player);
+
+	Node2D *mob = memnew(Node2D);
+	const int agent = crowd->add_agent(Vector2(), Crowd2D::REACTION_FLEE, mob);
+	crowd->set_agent_callback(agent, callable_mp_static(&_on_agent_event));
+	event_count = 0;
+
+	crowd->step(0.1);
+	CHECK(crowd->get_agent_state(agent) == Crowd2D::STATE_FLEE);
+	CHECK(mob->get_position() == crowd->get_agent_position(agent));
+	CHECK(mob->get_position().x < 0.0);
+	CHECK(event_count == 1);
+	CHECK(last_event_state == Crowd2D::STATE_FLEE);
+
+	crowd->step(0.1);
+	CHECK(event_count == 1);
+
+	memdelete(mob);
+	crowd->step(0.1);
+	CHECK_FALSE(crowd->has_agent(agent));
+
+	memdelete(player);
+	memdelete(crowd);
+}
+
+TEST_CASE("[Crowd2D] Batched steps") {
+	Crowd2D *crowd = memnew(Crowd2D);
+	Node2D *player = memnew(Node2D);
+	crowd->add_target(player);
+
+	for (int i = 0; i < 300; i++) {
+		const int agent = crowd->add_agent(Vector2(i % 20 - 10, i / 20 - 7) * 20.0, Crowd2D::REACTION_FLEE);
+		crowd->set_agent_perception_radius(agent, 1000.0);
+	}
+	crowd->step(0.1);
+
+	for (int i = 0; i < 300; i++) {
+		CHECK(crowd->get_agent_state(i) == Crowd2D::STATE_FLEE);
+	}
+	CHECK(crowd->get_agent_position(0).length() > Vector2(-10, -7).length() * 20.0);
+
+	memdelete(player);
+	memdelete(crowd);
+}
+
+} // namespace TestCrowd2D
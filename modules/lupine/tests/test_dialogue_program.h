@@ -0,0 +1,287 @@
+/**************************************************************************/
+/*  test_dialogue_program.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../dialogue_program.h"
+
+#include "core/io/json.h"
+#include "tests/test_macros.h"
+
+namespace TestDialogueProgram {
+
+static const char *dialogue_json = R"({
+	"lines": [
+		{ "speaker": "Guard", "text": "Welcome back, {player_name}!", "condition": { "type": "quest_completed", "quest_id": "rescue" } },
+		{ "speaker": "Guard", "text": "You look strong.", "condition": { "type": "and", "conditions": [
+			{ "type": "player_level", "level": 5 },
+			{ "type": "not", "condition": { "type": "has_item", "item_id": "pass" } }
+		] } },
+		{ "speaker": "Guard", "text": "Halt! You have {gold} gold.", "choices": [
+			{ "text": "Pay {toll} gold", "action": [
+				{ "type": "add_variable", "variable": "gold", "amount": -5 },
+				{ "type": "set_variable", "variable": "paid", "value": true },
+				{ "type": "start_quest", "quest_id": "smuggler" }
+			], "jump_to": 0 },
+			{ "text": "Leave" }
+		] }
+	]
+})";
+
+static Ref<DialogueProgram> _compile_test_dialogue() {
+	Ref<DialogueProgram> program;
+	program.instantiate();
+	const Dictionary dialogue = JSON::parse_string(dialogue_json);
+	REQUIRE(program->compile(dialogue) == OK);
+	return program;
+}
+
+TEST_CASE("[DialogueProgram] Line conditions") {
+	Ref<DialogueProgram> program = _compile_test_dialogue();
+	Ref<DialogueVariables> variables;
+	variables.instantiate();
+
+	CHECK(program->get_line_count() == 3);
+	CHECK(program->get_line_speaker(0) == "Guard");
+	CHECK(program->has_line_condition(1));
+	CHECK_FALSE(program->has_line_condition(2));
+
+	CHECK(program->find_next_line(0, variables) == 2);
+
+	variables->set_value("level", 6);
+	CHECK(program->find_next_line(0, variables) == 1);
+	variables->set_value("item_count:pass", 1);
+	CHECK(program->find_next_line(0, variables) == 2);
+
+	variables->set_value("quest_completed:rescue", true);
+	CHECK(program->find_next_line(0, variables) == 0);
+	CHECK(program->find_next_line(3, variables) == DialogueProgram::LINE_END);
+
+	const PackedStringArray names = program->get_variable_names();
+	CHECK(names.has("quest_completed:rescue"));
+	CHECK(names.has("item_count:pass"));
+	CHECK(names.has("gold"));
+}
+
+TEST_CASE("[DialogueProgram] Text interpolation") {
+	Ref<DialogueProgram> program = _compile_test_dialogue();
+	Ref<DialogueVariables> variables;
+	variables.instantiate();
+	variables->set_value("player_name", "Ada");
+	variables->set_value("gold", 12);
+	variables->set_value("toll", 5);
+
+	CHECK(program->format_line_text(0, variables) == "Welcome back, Ada!");
+	CHECK(program->format_line_text(1, variables) == "You look strong.");
+	CHECK(program->format_line_text(2, variables) == "Halt! You have 12 gold.");
+	CHECK(program->format_choice_text(2, 0, variables) == "Pay 5 gold");
+
+	// The table is bound once; later values are still picked up.
+	variables->set_value("player_name", "Grace");
+	CHECK(program->format_line_text(0, variables) == "Welcome back, Grace!");
+
+	Ref<DialogueProgram> braces;
+	braces.instantiate();
+	Dictionary line;
+	line["text"] = "{} and {unclosed";
+	Array lines;
+	lines.push_back(line);
+	Dictionary dialogue;
+	dialogue["lines"] = lines;
+	REQUIRE(braces->compile(dialogue) == OK);
+	CHECK(braces->format_line_text(0, variables) == "{} and {unclosed");
+}
+
+TEST_CASE("[DialogueProgram] Several variable tables") {
+	Ref<DialogueProgram> program = _compile_test_dialogue();
+
+	// Names are added in a different order, so each table has its own slots.
+	Ref<DialogueVariables> guard;
+	guard.instantiate();
+	guard->set_value("player_name", "Ada");
+	guard->set_value("gold", 12);
+	Ref<DialogueVariables> merchant;
+	merchant.instantiate();
+	merchant->set_value("gold", 30);
+	merchant->set_value("quest_completed:rescue", true);
+	merchant->set_value("player_name", "Grace");
+
+	for (int i = 0; i < 2; i++) {
+		CHECK(program->find_next_line(0, guard) == 2);
+		CHECK(program->find_next_line(0, merchant) == 0);
+		CHECK(program->format_line_text(2, guard) == "Halt! You have 12 gold.");
+		CHECK(program->format_line_text(2, merchant) == "Halt! You have 30 gold.");
+	}
+
+	// Compiling again may change the names, and so their slots.
+	Dictionary line;
+	line["text"] = "{player_name} has {gold} gold.";
+	Array lines;
+	lines.push_back(line);
+	Dictionary dialogue;
+	dialogue["lines"] = lines;
+	REQUIRE(program->compile(dialogue) == OK);
+	CHECK(program->format_line_text(0, guard) == "Ada has 12 gold.");
+	CHECK(program->format_line_text(0, merchant) == "Grace has 30 gold.");
+}
+
+static int handler_calls = 0;
+static StringName handler_type;
+static String handler_quest;
+
+static void _action_handler(const StringName &p_type, const Dictionary &p_action) {
+	handler_calls++;
+	handler_type = p_type;
+	handler_quest = p_action["quest_id"];
+}
+
+TEST_CASE("[DialogueProgram] Choice actions") {
+	Ref<DialogueProgram> program = _compile_test_dialogue();
+	Ref<DialogueVariables> variables;
+	variables.instantiate();
+	variables->set_value("gold", 12);
+
+	CHECK(program->get_line_choice_count(2) == 2);
+	CHECK(program->get_choice_jump(2, 0) == 0);
+	CHECK(program->get_choice_jump(2, 1) == DialogueProgram::LINE_END);
+
+	handler_calls = 0;
+	program->run_choice_action(2, 0, variables, callable_mp_static(&_action_handler));
+	CHECK(variables->get_value("gold") == Variant(7.0));
+	CHECK(variables->get_value("paid") == Variant(true));
+	CHECK(handler_calls == 1);
+	CHECK(handler_type == StringName("start_quest"));
+	CHECK(handler_quest == "smuggler");
+
+	// Choices without an action do nothing.
+	program->run_choice_action(2, 1, variables, callable_mp_static(&_action_handler));
+	CHECK(handler_calls == 1);
+}
+
+TEST_CASE("[DialogueProgram] Compilation errors") {
+	Ref<DialogueProgram> program;
+	program.instantiate();
+
+	Dictionary condition;
+	condition["type"] = "variable";
+	condition["variable"] = "mood";
+	condition["operator"] = "~=";
+	condition["value"] = "good";
+	Dictionary line;
+	line["text"] = "Hello";
+	line["condition"] = condition;
+	Array lines;
+	lines.push_back(line);
+	Dictionary dialogue;
+	dialogue["lines"] = lines;
+
+	CHECK(program->compile(dialogue) == ERR_PARSE_ERROR);
+	CHECK(program->get_error_string().contains("~="));
+	CHECK(program->get_line_count() == 0);
+
+	lines[0] = "not a line";
+	CHECK(program->compile(dialogue) == ERR_PARSE_ERROR);
+
+	lines[0] = JSON::parse_string(R"({ "id": "start", "text": "Hi", "next": "missing" })");
+	CHECK(program->compile(dialogue) == ERR_PARSE_ERROR);
+	CHECK(program->get_error_string().contains("missing"));
+
+	lines[0] = JSON::parse_string(R"({ "text": "Hi", "choices": [ { "text": "Bye", "jump_to": 4 } ] })");
+	CHECK(program->compile(dialogue) == ERR_PARSE_ERROR);
+
+	lines[0] = JSON::parse_string(R"({ "id": "start", "text": "Hi" })");
+	lines.push_back(lines[0]);
+	CHECK(program->compile(dialogue) == ERR_PARSE_ERROR);
+	CHECK(program->get_error_string().contains("Duplicate"));
+}
+
+TEST_CASE("[DialogueProgram] Line ids") {
+	Ref<DialogueProgram> program;
+	program.instantiate();
+	const Dictionary dialogue = JSON::parse_string(R"({
+		"lines": [
+			{ "id": "greet", "speaker": "Smith", "text": "Need a blade?", "next": "offer" },
+			{ "id": "farewell", "speaker": "Smith", "text": "Come back soon.", "next": -1 },
+			{ "id": "offer", "speaker": "Smith", "text": "Best steel in town.", "choices": [
+				{ "text": "Buy", "jump_to": "farewell" },
+				{ "text": "Haggle", "jump_to": "offer" }
+			] }
+		]
+	})");
+	REQUIRE(program->compile(dialogue) == OK);
+
+	CHECK(program->find_line("greet") == 0);
+	CHECK(program->find_line("offer") == 2);
+	CHECK(program->find_line("missing") == DialogueProgram::LINE_END);
+	CHECK(program->get_line_id(1) == "farewell");
+
+	CHECK(program->get_line_next(0) == 2);
+	CHECK(program->get_line_next(1) == DialogueProgram::LINE_END);
+	// The last line ends the dialogue unless it says otherwise.
+	CHECK(program->get_line_next(2) == DialogueProgram::LINE_END);
+	CHECK(program->get_choice_jump(2, 0) == 1);
+	CHECK(program->get_choice_jump(2, 1) == 2);
+}
+
+TEST_CASE("[DialogueProgram] Packed data") {
+	Ref<DialogueProgram> program = _compile_test_dialogue();
+	const PackedByteArray data = program->call("_get_data");
+	REQUIRE(data.size() > 8);
+
+	Ref<DialogueProgram> loaded;
+	loaded.instantiate();
+	loaded->call("_set_data", data);
+	REQUIRE(loaded->get_line_count() == 3);
+	CHECK(loaded->get_variable_names() == program->get_variable_names());
+
+	Ref<DialogueVariables> variables;
+	variables.instantiate();
+	variables->set_value("player_name", "Ada");
+	variables->set_value("quest_completed:rescue", true);
+	variables->set_value("gold", 12);
+	CHECK(loaded->find_next_line(0, variables) == 0);
+	CHECK(loaded->format_line_text(0, variables) == "Welcome back, Ada!");
+	CHECK(loaded->get_line_speaker(2) == "Guard");
+	CHECK(loaded->format_line_text(2, variables) == "Halt! You have 12 gold.");
+	CHECK(loaded->get_choice_jump(2, 0) == 0);
+
+	loaded->run_choice_action(2, 0, variables, Callable());
+	CHECK(int(variables->get_value("gold")) == 7);
+
+	// Corrupted data is rejected instead of trusted.
+	PackedByteArray corrupted = data;
+	corrupted.resize(corrupted.size() - 4);
+	ERR_PRINT_OFF;
+	loaded->call("_set_data", corrupted);
+	ERR_PRINT_ON;
+	CHECK(loaded->get_line_count() == 0);
+}
+
+} // namespace TestDialogueProgram
@@ -0,0 +1,209 @@
+/**************************************************************************/
+/*  test_effect_scheduler.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../effect_scheduler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestEffectScheduler {
+
+static EffectScheduler *scheduler = nullptr;
+static Dictionary finished_times;
+static int expired_count = 0;
+static float dot_damage = 0.0;
+static Array stat_changes;
+
+static void _on_cooldown_finished(const StringName &p_ability, Object *p_owner) {
+	finished_times[p_ability] = scheduler->get_time();
+}
+
+static void _on_effect_ticked(int64_t p_id, const StringName &p_effect, Object *p_target, float p_damage) {
+	dot_damage += p_damage;
+}
+
+static void _on_effect_expired(int64_t p_id, const StringName &p_effect, Object *p_target) {
+	expired_count++;
+}
+
+static void _on_stat_modifiers_changed(Object *p_target, const Dictionary &p_changes) {
+	stat_changes.push_back(p_changes);
+}
+
+static EffectScheduler *_create_scheduler() {
+	scheduler = memnew(EffectScheduler);
+	finished_times.clear();
+	expired_count = 0;
+	dot_damage = 0.0;
+	stat_changes.clear();
+	scheduler->connect("cooldown_finished", callable_mp_static(&_on_cooldown_finished));
+	scheduler->connect("effect_ticked", callable_mp_static(&_on_effect_ticked));
+	scheduler->connect("effect_expired", callable_mp_static(&_on_effect_expired));
+	scheduler->connect("stat_modifiers_changed", callable_mp_static(&_on_stat_modifiers_changed));
+	return scheduler;
+}
+
+TEST_CASE("[EffectScheduler] Cooldowns") {
+	EffectScheduler *effects = _create_scheduler();
+	Object *owner = memnew(Object);
+
+	effects->start_cooldown(nullptr, "fireball", 1.0);
+	effects->start_cooldown(owner, "fireball", 2.0);
+	CHECK(effects->is_on_cooldown(nullptr, "fireball"));
+	CHECK(effects->is_on_cooldown(owner, "fireball"));
+	CHECK_FALSE(effects->is_on_cooldown(nullptr, "slash"));
+	CHECK(effects->get_timer_count() == 2);
+
+	effects->advance(0.5);
+	CHECK(effects->get_cooldown_remaining(nullptr, "fireball") == doctest::Approx(0.5));
+	CHECK(finished_times.is_empty());
+
+	effects->advance(0.5);
+	CHECK_FALSE(effects->is_on_cooldown(nullptr, "fireball"));
+	CHECK(effects->is_on_cooldown(owner, "fireball"));
+	CHECK(finished_times.size() == 1);
+	CHECK(double(finished_times["fireball"]) == doctest::Approx(1.0));
+
+	// Restarting replaces the running cooldown; cancelling doesn't report it.
+	effects->start_cooldown(owner, "fireball", 3.0);
+	CHECK(effects->get_timer_count() == 1);
+	CHECK(effects->get_cooldown_remaining(owner, "fireball") == doctest::Approx(3.0));
+	effects->cancel_cooldown(owner, "fireball");
+	CHECK(effects->get_timer_count() == 0);
+	effects->advance(5.0);
+	CHECK(finished_times.size() == 1);
+	CHECK(effects->get_time() == doctest::Approx(6.0));
+
+	memdelete(owner);
+	memdelete(effects);
+}
+
+TEST_CASE("[EffectScheduler] Buffs batch their stat modifiers") {
+	EffectScheduler *effects = _create_scheduler();
+	Object *target = memnew(Object);
+
+	Dictionary haste;
+	haste["speed"] = 5;
+	Dictionary might;
+	might["attack"] = 3;
+	might["speed"] = 1;
+	const int64_t haste_id = effects->add_buff(target, "haste", 2.0, haste);
+	const int64_t might_id = effects->add_buff(target, "might", 1.0, might);
+	CHECK(effects->has_effect(haste_id));
+	CHECK(effects->get_effect_name(might_id) == StringName("might"));
+	CHECK(effects->get_effect_target(might_id) == target);
+	CHECK(effects->get_stat_modifier(target, "speed") == doctest::Approx(6.0));
+	CHECK(effects->get_stat_modifier(target, "attack") == doctest::Approx(3.0));
+
+	// Both buffs are reported together on the next frame.
+	CHECK(stat_changes.is_empty());
+	effects->advance(0.0);
+	REQUIRE(stat_changes.size() == 1);
+	Dictionary changes = stat_changes[0];
+	CHECK(float(changes["speed"]) == doctest::Approx(6.0));
+	CHECK(float(changes["attack"]) == doctest::Approx(3.0));
+
+	effects->advance(1.0);
+	CHECK_FALSE(effects->has_effect(might_id));
+	CHECK(expired_count == 1);
+	REQUIRE(stat_changes.size() == 2);
+	changes = stat_changes[1];
+	CHECK(float(changes["speed"]) == doctest::Approx(-1.0));
+	CHECK(float(changes["attack"]) == doctest::Approx(-3.0));
+	CHECK(effects->get_effect_remaining(haste_id) == doctest::Approx(1.0));
+
+	// Removing an effect reverts it without an expiry.
+	CHECK(effects->remove_effect(haste_id));
+	CHECK_FALSE(effects->remove_effect(haste_id));
+	effects->advance(0.0);
+	CHECK(expired_count == 1);
+	CHECK(effects->get_stat_modifiers(target).is_empty());
+	CHECK(stat_changes.size() == 3);
+
+	// A stale ID doesn't match the timer that reuses its slot.
+	const int64_t next_id = effects->add_buff(target, "haste", 1.0, haste);
+	CHECK(next_id != haste_id);
+	CHECK_FALSE(effects->has_effect(haste_id));
+
+	memdelete(target);
+	memdelete(effects);
+}
+
+TEST_CASE("[EffectScheduler] Damage over time") {
+	EffectScheduler *effects = _create_scheduler();
+	Object *target = memnew(Object);
+
+	const int64_t poison = effects->add_dot(target, "poison", 3.0, 1.0, 4.0);
+	CHECK(effects->get_effect_remaining(poison) == doctest::Approx(3.0));
+
+	effects->advance(1.5);
+	CHECK(dot_damage == doctest::Approx(4.0));
+	CHECK(effects->get_effect_remaining(poison) == doctest::Approx(1.5));
+
+	effects->advance(2.0);
+	CHECK(dot_damage == doctest::Approx(12.0));
+	CHECK(expired_count == 1);
+	CHECK_FALSE(effects->has_effect(poison));
+	CHECK(effects->get_timer_count() == 0);
+
+	ERR_PRINT_OFF;
+	CHECK(effects->add_dot(target, "burn", 1.0, 0.0, 1.0) == 0);
+	CHECK(effects->add_buff(nullptr, "haste", 1.0, Dictionary()) == 0);
+	ERR_PRINT_ON;
+
+	memdelete(target);
+	memdelete(effects);
+}
+
+TEST_CASE("[EffectScheduler] Timers cascade through every level") {
+	EffectScheduler *effects = _create_scheduler();
+	effects->set_tick_rate(1000);
+
+	// From the first level to beyond the top one (2^24 ticks).
+	const double durations[] = { 0.001, 0.063, 0.064, 0.5, 4.095, 4.096, 61.0, 262.143, 262.144, 5000.0, 16777.216, 20000.0 };
+	for (const double duration : durations) {
+		effects->start_cooldown(nullptr, rtos(duration), duration);
+	}
+	effects->advance(0.0105);
+	effects->start_cooldown(nullptr, "late", 100.0);
+
+	effects->advance(25000.0);
+	CHECK(effects->get_timer_count() == 0);
+	REQUIRE(finished_times.size() == 13);
+	for (const double duration : durations) {
+		CHECK(double(finished_times[rtos(duration)]) == doctest::Approx(duration).epsilon(0.0001));
+	}
+	CHECK(double(finished_times["late"]) == doctest::Approx(100.01));
+
+	memdelete(effects);
+}
+
+} // namespace TestEffectScheduler
@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  test_hud_data_model.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../hud_data_model.h"
+
+#include "core/object/message_queue.h"
+#include "tests/test_macros.h"
+
+namespace TestHUDDataModel {
+
+static int refresh_count = 0;
+static Variant last_value;
+
+static void _on_refresh(const Variant &p_value) {
+	refresh_count++;
+	last_value = p_value;
+}
+
+TEST_CASE("[HUDDataModel] Changes are coalesced into one flush") {
+	HUDDataModel *model = memnew(HUDDataModel);
+	Node *health_widget = memnew(Node);
+	Node *gold_widget = memnew(Node);
+	refresh_count = 0;
+
+	model->set_value("health", 100);
+	CHECK(model->bind_property("health", health_widget, NodePath("process_priority")) >= 0);
+	CHECK(health_widget->get_process_priority() == 100);
+	model->bind_property("gold", gold_widget, NodePath("process_priority"));
+	model->bind_callable("gold", callable_mp_static(&_on_refresh));
+	CHECK(model->get_binding_count() == 3);
+	MessageQueue::get_singleton()->flush();
+
+	// Several writes in one frame reach the widgets once, with the last value.
+	const int64_t flushes = model->get_flush_count();
+	model->set_value("gold", 10);
+	model->set_value("gold", 25);
+	model->set_value("health", 100);
+	CHECK(model->is_flush_queued());
+	CHECK(model->get_pending_count() == 1);
+	CHECK(gold_widget->get_process_priority() == 0);
+
+	MessageQueue::get_singleton()->flush();
+	CHECK(model->get_flush_count() == flushes + 1);
+	CHECK(gold_widget->get_process_priority() == 25);
+	CHECK(refresh_count == 1);
+	CHECK(int(last_value) == 25);
+	CHECK(health_widget->get_process_priority() == 100);
+
+	// Unchanged values don't queue anything.
+	model->set_value("gold", 25);
+	CHECK_FALSE(model->is_flush_queued());
+
+	memdelete(gold_widget);
+	memdelete(health_widget);
+	memdelete(model);
+}
+
+TEST_CASE("[HUDDataModel] Bindings") {
+	HUDDataModel *model = memnew(HUDDataModel);
+	Node *widget = memnew(Node);
+	Node *other = memnew(Node);
+
+	const int binding = model->bind_property("level", widget, NodePath("process_priority"));
+	model->bind_property("level", other, NodePath("process_priority"));
+	model->bind_property("quest", other, NodePath("editor_description"));
+	model->set_value("level", 3);
+	model->set_value("quest", "Find the key");
+	model->flush();
+	CHECK(widget->get_process_priority() == 3);
+	CHECK(other->get_editor_description() == "Find the key");
+	CHECK(model->get_update_count() == 3);
+
+	model->unbind(binding);
+	model->unbind_object(other);
+	CHECK(model->get_binding_count() == 0);
+	model->set_value("level", 4);
+	model->flush();
+	CHECK(widget->get_process_priority() == 3);
+	CHECK(other->get_process_priority() == 3);
+
+	// Bindings of freed targets are dropped on the next flush.
+	model->bind_property("level", other, NodePath("process_priority"));
+	memdelete(other);
+	model->set_value("level", 5);
+	model->flush();
+	CHECK(model->get_binding_count() == 0);
+
+	// Values changed in place are pushed with mark_dirty().
+	Array items;
+	model->set_value("items", items);
+	model->bind_callable("items", callable_mp_static(&_on_refresh));
+	model->flush();
+	refresh_count = 0;
+	items.push_back(1);
+	model->set_value("items", items);
+	CHECK_FALSE(model->is_flush_queued());
+	model->mark_dirty("items");
+	model->flush();
+	CHECK(refresh_count == 1);
+
+	CHECK(model->has_value("quest"));
+	CHECK(model->get_value("missing", 7) == Variant(7));
+	CHECK(model->get_keys().size() == 3);
+
+	ERR_PRINT_OFF;
+	model->mark_dirty("missing");
+	CHECK(model->bind_property("level", nullptr, NodePath("value")) == -1);
+	ERR_PRINT_ON;
+
+	memdelete(widget);
+	memdelete(model);
+}
+
+static HUDDataModel *clearing_model = nullptr;
+
+static void _on_clear(const Variant &p_value) {
+	refresh_count++;
+	clearing_model->clear();
+}
+
+TEST_CASE("[HUDDataModel] Clearing from a binding") {
+	HUDDataModel *model = memnew(HUDDataModel);
+	clearing_model = model;
+	refresh_count = 0;
+
+	model->bind_callable("health", callable_mp_static(&_on_clear));
+	model->bind_callable("health", callable_mp_static(&_on_refresh));
+	model->bind_callable("gold", callable_mp_static(&_on_refresh));
+	model->set_value("health", 50);
+	model->set_value("gold", 10);
+	model->flush();
+	CHECK_MESSAGE(refresh_count == 1,
+			"Nothing should be updated after the model is cleared.");
+	CHECK(model->get_keys().is_empty());
+	CHECK(model->get_binding_count() == 0);
+
+	// Still usable afterwards.
+	model->bind_callable("gold", callable_mp_static(&_on_refresh));
+	model->set_value("gold", 20);
+	model->flush();
+	CHECK(refresh_count == 2);
+	CHECK(int(last_value) == 20);
+
+	clearing_model = nullptr;
+	memdelete(model);
+}
+
+} // namespace TestHUDDataModel
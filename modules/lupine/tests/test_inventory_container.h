@@ -0,0 +1,225 @@
+/**************************************************************************/
+/*  test_inventory_container.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../inventory_container.h"
+
+#include "tests/test_macros.h"
+
+namespace TestInventoryContainer {
+
+static Ref<InventoryContainer> _make_container(int p_slots) {
+	Ref<InventoryContainer> container;
+	container.instantiate();
+	container->set_slot_count(p_slots);
+	container->set_item_max_stack("potion", 10);
+	return container;
+}
+
+TEST_CASE("[InventoryContainer] Stacking") {
+	Ref<InventoryContainer> container = _make_container(4);
+
+	CHECK(container->add_item("potion", 25) == 0);
+	CHECK(container->get_item_count("potion") == 25);
+	CHECK(container->get_slot_quantity(0) == 10);
+	CHECK(container->get_slot_quantity(1) == 10);
+	CHECK(container->get_slot_quantity(2) == 5);
+	CHECK(container->get_empty_slot_count() == 1);
+
+	// Existing stacks are topped up before using empty slots.
+	CHECK(container->add_item("potion", 3) == 0);
+	CHECK(container->get_slot_quantity(2) == 8);
+
+	// Items without a max stack use the default of 1.
+	CHECK(container->add_item("sword", 2) == 1);
+	CHECK(container->get_slot_item(3) == StringName("sword"));
+	CHECK(container->find_empty_slot() == InventoryContainer::EMPTY);
+	CHECK(container->get_free_capacity("potion") == 2);
+	CHECK(container->add_item("potion", 5) == 3);
+	CHECK(container->get_item_count("potion") == 30);
+}
+
+TEST_CASE("[InventoryContainer] Removal") {
+	Ref<InventoryContainer> container = _make_container(4);
+	container->add_item("potion", 25);
+
+	CHECK(container->remove_item("potion", 12) == 12);
+	CHECK(container->is_slot_empty(0));
+	CHECK(container->get_slot_quantity(1) == 8);
+	CHECK(container->get_item_slots("potion") == PackedInt32Array({ 1, 2 }));
+	CHECK(container->remove_item("potion", 100) == 13);
+	CHECK_FALSE(container->has_item("potion"));
+	CHECK(container->get_item_ids().is_empty());
+	CHECK(container->get_empty_slot_count() == 4);
+	CHECK(container->remove_item("missing", 1) == 0);
+}
+
+TEST_CASE("[InventoryContainer] Bulk operations") {
+	Ref<InventoryContainer> container = _make_container(3);
+	container->set_item_max_stack("herb", 5);
+
+	Dictionary items;
+	items["potion"] = 4;
+	items["herb"] = 20;
+	Dictionary leftovers = container->add_items(items);
+	CHECK(leftovers.size() == 1);
+	CHECK(int(leftovers["herb"]) == 10);
+
+	Dictionary recipe;
+	recipe["potion"] = 2;
+	recipe["herb"] = 11;
+	CHECK_FALSE(container->has_items(recipe));
+	CHECK_FALSE(container->remove_items(recipe));
+	CHECK(container->get_item_count("potion") == 4);
+	CHECK(container->get_item_count("herb") == 10);
+
+	recipe["herb"] = 6;
+	CHECK(container->remove_items(recipe));
+	CHECK(container->get_item_count("potion") == 2);
+	CHECK(container->get_item_count("herb") == 4);
+}
+
+TEST_CASE("[InventoryContainer] Transfers") {
+	Ref<InventoryContainer> chest = _make_container(2);
+	Ref<InventoryContainer> bag = _make_container(1);
+	chest->add_item("potion", 15);
+
+	CHECK(chest->transfer_item(bag, "potion", 12) == 10);
+	CHECK(bag->get_item_count("potion") == 10);
+	CHECK(chest->get_item_count("potion") == 5);
+	CHECK(chest->transfer_all(bag) == 0);
+
+	bag->clear();
+	CHECK(chest->transfer_all(bag) == 5);
+	CHECK(chest->get_empty_slot_count() == 2);
+}
+
+TEST_CASE("[InventoryContainer] Slots") {
+	Ref<InventoryContainer> container = _make_container(4);
+	container->set_slot(0, "potion", 6);
+	container->set_slot(2, "potion", 7);
+	container->set_slot_flags(2, 1);
+
+	// Merging keeps the overflow in the source slot.
+	container->move_slot(2, 0);
+	CHECK(container->get_slot_quantity(0) == 10);
+	CHECK(container->get_slot_quantity(2) == 3);
+
+	container->set_slot(1, "sword", 1);
+	container->move_slot(2, 1);
+	CHECK(container->get_slot_item(1) == StringName("potion"));
+	CHECK(container->get_slot_flags(1) == 1);
+	CHECK(container->get_slot_item(2) == StringName("sword"));
+
+	container->move_slot(2, 3);
+	CHECK(container->is_slot_empty(2));
+	CHECK(container->get_item_slots("potion") == PackedInt32Array({ 0, 1 }));
+	CHECK(container->get_item_count("potion") == 13);
+
+	container->set_slot_count(2);
+	CHECK_FALSE(container->has_item("sword"));
+	CHECK(container->get_empty_slot_count() == 0);
+	container->set_slot_count(100);
+	CHECK(container->find_empty_slot() == 2);
+	CHECK(container->get_empty_slot_count() == 98);
+}
+
+TEST_CASE("[InventoryContainer] Serialization") {
+	Ref<InventoryContainer> container = _make_container(70);
+	container->set_default_max_stack(99);
+	container->add_item("potion", 25);
+	container->set_slot(65, "sword", 1);
+	container->set_slot_flags(65, 4);
+
+	Ref<InventoryContainer> loaded;
+	loaded.instantiate();
+	CHECK(loaded->from_bytes(container->to_bytes()) == OK);
+	CHECK(loaded->get_slot_count() == 70);
+	CHECK(loaded->get_default_max_stack() == 99);
+	CHECK(loaded->get_item_max_stack("potion") == 10);
+	CHECK(loaded->get_item_count("potion") == 25);
+	CHECK(loaded->get_slot_item(65) == StringName("sword"));
+	CHECK(loaded->get_slot_flags(65) == 4);
+	CHECK(loaded->get_empty_slot_count() == 66);
+	CHECK(loaded->to_bytes() == container->to_bytes());
+
+	ERR_PRINT_OFF;
+	PackedByteArray bytes = container->to_bytes();
+	bytes.resize(30);
+	CHECK(loaded->from_bytes(bytes) != OK);
+	ERR_PRINT_ON;
+	CHECK(loaded->get_item_count("potion") == 25);
+}
+
+TEST_CASE("[InventoryContainer] Reject duplicate item ids") {
+	Ref<InventoryContainer> container = _make_container(4);
+	container->add_item("aa", 1);
+	container->add_item("bb", 2);
+
+	// Rename "bb" to "aa" in the item table.
+	PackedByteArray bytes = container->to_bytes();
+	uint8_t *w = bytes.ptrw();
+	for (int64_t i = bytes.size() - 2; i >= 0; i--) {
+		if (w[i] == 'b' && w[i + 1] == 'b') {
+			w[i] = 'a';
+			w[i + 1] = 'a';
+			break;
+		}
+	}
+
+	Ref<InventoryContainer> loaded = _make_container(4);
+	loaded->add_item("potion", 5);
+	ERR_PRINT_OFF;
+	CHECK(loaded->from_bytes(bytes) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(loaded->get_item_count("potion") == 5,
+			"Rejected data should leave the contents untouched.");
+	CHECK(loaded->get_item_count("aa") == 0);
+}
+
+TEST_CASE("[InventoryContainer] Change notifications") {
+	Ref<InventoryContainer> container = _make_container(4);
+	SIGNAL_WATCH(container.ptr(), SNAME("slots_changed"));
+
+	container->add_item("potion", 25);
+	Array args;
+	args.push_back(PackedInt32Array({ 0, 1, 2 }));
+	Array expected;
+	expected.push_back(args);
+	SIGNAL_CHECK("slots_changed", expected);
+
+	CHECK(container->remove_item("sword") == 0);
+	SIGNAL_CHECK_FALSE("slots_changed");
+
+	SIGNAL_UNWATCH(container.ptr(), SNAME("slots_changed"));
+}
+
+} // namespace TestInventoryContainer
@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*  test_quest_runtime.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../quest_runtime.h"
+
+#include "tests/test_macros.h"
+
+namespace TestQuestRuntime {
+
+static Dictionary _objective(const String &p_id, QuestRuntime::ObjectiveType p_type, const String &p_target, int p_amount) {
+	Dictionary parameters;
+	parameters["target"] = p_target;
+	parameters["amount"] = p_amount;
+	Dictionary objective;
+	objective["id"] = p_id;
+	objective["type"] = p_type;
+	objective["parameters"] = parameters;
+	return objective;
+}
+
+static Dictionary _quest(const String &p_id, const Array &p_objectives) {
+	Dictionary quest;
+	quest["id"] = p_id;
+	quest["objectives"] = p_objectives;
+	return quest;
+}
+
+TEST_CASE("[QuestRuntime] Indexed event dispatch") {
+	Ref<QuestRuntime> runtime;
+	runtime.instantiate();
+
+	Array hunt;
+	hunt.push_back(_objective("wolves", QuestRuntime::OBJECTIVE_KILL, "wolf", 3));
+	hunt.push_back(_objective("pelts", QuestRuntime::OBJECTIVE_COLLECT, "pelt", 2));
+	REQUIRE(runtime->add_quest(_quest("hunt", hunt)) == OK);
+
+	Array cull;
+	cull.push_back(_objective("anything", QuestRuntime::OBJECTIVE_KILL, "", 2));
+	REQUIRE(runtime->add_quest(_quest("cull", cull)) == OK);
+
+	// Only active quests listen.
+	CHECK(runtime->post_event(QuestRuntime::OBJECTIVE_KILL, "wolf") == 0);
+	CHECK(runtime->start_quest("hunt"));
+	CHECK(runtime->start_quest("cull"));
+	CHECK(runtime->get_listener_count(QuestRuntime::OBJECTIVE_KILL, "wolf") == 1);
+
+	// Objectives with no target match every target.
+	CHECK(runtime->post_event(QuestRuntime::OBJECTIVE_KILL, "wolf") == 2);
+	CHECK(runtime->post_event(QuestRuntime::OBJECTIVE_KILL, "bat") == 1);
+	CHECK(runtime->get_quest_status("cull") == QuestRuntime::STATUS_COMPLETED);
+	CHECK(runtime->get_objective_progress("hunt", "wolves") == 1);
+
+	// Events can be limited to one quest.
+	CHECK(runtime->post_event(QuestRuntime::OBJECTIVE_KILL, "wolf", 5, "cull") == 0);
+	CHECK(runtime->post_event(QuestRuntime::OBJECTIVE_KILL, "wolf", 5, "hunt") == 1);
+	CHECK(runtime->get_objective_progress("hunt", "wolves") == 3);
+	CHECK(runtime->is_objective_completed("hunt", "wolves"));
+	CHECK(runtime->get_listener_count(QuestRuntime::OBJECTIVE_KILL, "wolf") == 0);
+
+	CHECK(runtime->get_quest_status("hunt") == QuestRuntime::STATUS_ACTIVE);
+	runtime->post_event(QuestRuntime::OBJECTIVE_COLLECT, "pelt", 2);
+	CHECK(runtime->get_quest_status("hunt") == QuestRuntime::STATUS_COMPLETED);
+	CHECK(runtime->get_listener_count(QuestRuntime::OBJECTIVE_COLLECT, "pelt") == 0);
+}
+
+TEST_CASE("[QuestRuntime] Prerequisites and optional objectives") {
+	Ref<QuestRuntime> runtime;
+	runtime.instantiate();
+
+	Array objectives;
+	objectives.push_back(_objective("talk", QuestRuntime::OBJECTIVE_TALK, "elder", 1));
+	Dictionary deliver = _objective("deliver", QuestRuntime::OBJECTIVE_DELIVER, "letter", 1);
+	Array objective_prerequisites;
+	objective_prerequisites.push_back("talk");
+	deliver["prerequisites"] = objective_prerequisites;
+	objectives.push_back(deliver);
+	Dictionary bonus = _objective("bonus", QuestRuntime::OBJECTIVE_COLLECT, "flower", 1);
+	bonus["is_optional"] = true;
+	objectives.push_back(bonus);
+	REQUIRE(runtime->add_quest(_quest("errand", objectives)) == OK);
+
+	Dictionary sequel = _quest("sequel", Array());
+	Array quest_prerequisites;
+	quest_prerequisites.push_back("errand");
+	sequel["prerequisites"] = quest_prerequisites;
+	REQUIRE(runtime->add_quest(sequel) == OK);
+
+	CHECK_FALSE(runtime->can_start_quest("sequel"));
+	CHECK(runtime->start_quest("errand"));
+	CHECK_FALSE(runtime->start_quest("errand"));
+	CHECK_FALSE(runtime->is_objective_listening("errand", "deliver"));
+	CHECK(runtime->post_event(QuestRuntime::OBJECTIVE_DELIVER, "letter") == 0);
+
+	runtime->post_event(QuestRuntime::OBJECTIVE_TALK, "elder");
+	CHECK(runtime->is_objective_listening("errand", "deliver"));
+	runtime->post_event(QuestRuntime::OBJECTIVE_DELIVER, "letter");
+	CHECK(runtime->get_quest_status("errand") == QuestRuntime::STATUS_COMPLETED);
+	CHECK_FALSE(runtime->is_objective_completed("errand", "bonus"));
+	CHECK(runtime->can_start_quest("sequel"));
+}
+
+TEST_CASE("[QuestRuntime] Loading databases") {
+	Ref<QuestRuntime> runtime;
+	runtime.instantiate();
+
+	// The layout generated by QuestSystem.gd, keyed by quest id.
+	Dictionary objective;
+	objective["id"] = "talk_to_npc";
+	objective["type"] = "interact";
+	objective["target"] = "village_elder";
+	objective["target_amount"] = 1.0;
+	Array objectives;
+	objectives.push_back(objective);
+	Dictionary quest;
+	quest["objectives"] = objectives;
+	Dictionary database;
+	database["tutorial_quest"] = quest;
+
+	CHECK(runtime->load_quests(database) == OK);
+	CHECK(runtime->has_quest("tutorial_quest"));
+	CHECK(runtime->get_objective_amount("tutorial_quest", "talk_to_npc") == 1);
+	CHECK(runtime->start_quest("tutorial_quest"));
+	CHECK(runtime->get_listener_count(QuestRuntime::OBJECTIVE_INTERACT, "village_elder") == 1);
+
+	ERR_PRINT_OFF;
+	objective["type"] = "dance";
+	CHECK(runtime->add_quest(_quest("broken", objectives)) == ERR_INVALID_DATA);
+	CHECK(runtime->add_quest(_quest("tutorial_quest", Array())) == ERR_ALREADY_EXISTS);
+	ERR_PRINT_ON;
+	CHECK_FALSE(runtime->has_quest("broken"));
+}
+
+TEST_CASE("[QuestRuntime] State") {
+	Ref<QuestRuntime> runtime;
+	runtime.instantiate();
+
+	Array objectives;
+	objectives.push_back(_objective("slimes", QuestRuntime::OBJECTIVE_KILL, "slime", 5));
+	objectives.push_back(_objective("gel", QuestRuntime::OBJECTIVE_COLLECT, "gel", 1));
+	REQUIRE(runtime->add_quest(_quest("slime_trouble", objectives)) == OK);
+	runtime->start_quest("slime_trouble");
+	runtime->post_event(QuestRuntime::OBJECTIVE_KILL, "slime", 2);
+	runtime->post_event(QuestRuntime::OBJECTIVE_COLLECT, "gel");
+
+	const Dictionary state = runtime->get_state();
+	runtime->reset_quest("slime_trouble");
+	CHECK(runtime->get_listener_count(QuestRuntime::OBJECTIVE_KILL, "slime") == 0);
+
+	runtime->set_state(state);
+	CHECK(runtime->get_quest_status("slime_trouble") == QuestRuntime::STATUS_ACTIVE);
+	CHECK(runtime->get_objective_progress("slime_trouble", "slimes") == 2);
+	CHECK(runtime->is_objective_completed("slime_trouble", "gel"));
+	CHECK(runtime->get_listener_count(QuestRuntime::OBJECTIVE_COLLECT, "gel") == 0);
+
+	SIGNAL_WATCH(runtime.ptr(), SNAME("quest_completed"));
+	runtime->post_event(QuestRuntime::OBJECTIVE_KILL, "slime", 3);
+	Array args;
+	args.push_back(StringName("slime_trouble"));
+	Array expected;
+	expected.push_back(args);
+	SIGNAL_CHECK("quest_completed", expected);
+	SIGNAL_UNWATCH(runtime.ptr(), SNAME("quest_completed"));
+}
+
+} // namespace TestQuestRuntime
@@ -0,0 +1,149 @@
+/**************************************************************************/
+/*  test_relationship_graph.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../relationship_graph.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRelationshipGraph {
+
+TEST_CASE("[RelationshipGraph] Symmetric pairs") {
+	Ref<RelationshipGraph> graph;
+	graph.instantiate();
+
+	CHECK(graph->add_points("player", "alice", 30) == 30);
+	CHECK(graph->get_points("alice", "player") == 30);
+	CHECK(graph->add_points("alice", "player", -50) == 0);
+	graph->set_points("bob", "alice", 20);
+
+	CHECK(graph->get_character_count() == 3);
+	CHECK(graph->get_relationship_count() == 2);
+	CHECK(graph->has_relationship("alice", "bob"));
+	CHECK_FALSE(graph->has_relationship("player", "bob"));
+	CHECK(graph->get_points("player", "nobody") == 0);
+
+	ERR_PRINT_OFF;
+	graph->set_points("alice", "alice", 10);
+	ERR_PRINT_ON;
+	CHECK_FALSE(graph->has_relationship("alice", "alice"));
+}
+
+TEST_CASE("[RelationshipGraph] Levels") {
+	Ref<RelationshipGraph> graph;
+	graph.instantiate();
+	graph->set_level_thresholds(PackedInt32Array({ 0, 100, 250 }));
+	SIGNAL_WATCH(graph.ptr(), SNAME("level_changed"));
+
+	graph->add_points("player", "alice", 50);
+	SIGNAL_CHECK_FALSE("level_changed");
+	CHECK(graph->get_level("player", "alice") == 0);
+
+	graph->add_points("player", "alice", 150);
+	Array args;
+	args.push_back(StringName("player"));
+	args.push_back(StringName("alice"));
+	args.push_back(0);
+	args.push_back(1);
+	Array expected;
+	expected.push_back(args);
+	SIGNAL_CHECK("level_changed", expected);
+	CHECK(graph->get_pairs_at_level(1).size() == 1);
+
+	SIGNAL_UNWATCH(graph.ptr(), SNAME("level_changed"));
+}
+
+TEST_CASE("[RelationshipGraph] Interaction limits and decay") {
+	Ref<RelationshipGraph> graph;
+	graph.instantiate();
+	graph->set_max_daily_interactions(2);
+	graph->set_interaction_cooldown(0.0);
+	graph->set_decay_rate(1.0);
+	graph->set_decay_grace_days(2);
+
+	CHECK(graph->interact("player", "alice", 10));
+	CHECK(graph->interact("player", "alice", 10));
+	CHECK_FALSE(graph->interact("player", "alice", 10));
+	CHECK(graph->get_points("player", "alice") == 20);
+
+	// Days 1 and 2 are within the grace period, day 3 decays by 3.
+	graph->advance_day(2);
+	CHECK(graph->can_interact("player", "alice"));
+	CHECK(graph->get_points("player", "alice") == 20);
+	graph->advance_day();
+	CHECK(graph->get_points("player", "alice") == 17);
+
+	// Advancing several days at once matches advancing one at a time.
+	graph->advance_day(2);
+	CHECK(graph->get_points("player", "alice") == 8);
+
+	graph->set_interaction_cooldown(3600.0);
+	CHECK(graph->interact("player", "alice", 1));
+	CHECK_FALSE(graph->can_interact("player", "alice"));
+	CHECK(graph->get_last_interaction_day("player", "alice") == 5);
+}
+
+TEST_CASE("[RelationshipGraph] Neighbor queries") {
+	Ref<RelationshipGraph> graph;
+	graph.instantiate();
+	graph->set_points("player", "alice", 40);
+	graph->set_points("player", "bob", 90);
+	graph->set_points("player", "carol", 40);
+	graph->set_points("player", "dave", 5);
+	graph->set_points("alice", "bob", 70);
+
+	CHECK(graph->get_neighbors("player", 10) == PackedStringArray({ "bob", "alice", "carol" }));
+	CHECK(graph->get_top_relationships("player", 2) == PackedStringArray({ "bob", "alice" }));
+	CHECK(graph->get_neighbors("alice") == PackedStringArray({ "bob", "player" }));
+	CHECK(graph->get_rank("player", "bob") == 0);
+	CHECK(graph->get_rank("player", "carol") == 2);
+	CHECK(graph->get_rank("player", "dave") == 3);
+	CHECK(graph->get_rank("carol", "bob") == -1);
+}
+
+TEST_CASE("[RelationshipGraph] State") {
+	Ref<RelationshipGraph> graph;
+	graph.instantiate();
+	graph->set_interaction_cooldown(0.0);
+	graph->interact("player", "alice", 25);
+	graph->set_points("alice", "bob", 60);
+	graph->advance_day(3);
+
+	Ref<RelationshipGraph> loaded;
+	loaded.instantiate();
+	loaded->set_state(graph->get_state());
+	CHECK(loaded->get_current_day() == 3);
+	CHECK(loaded->get_relationship_count() == 2);
+	CHECK(loaded->get_points("bob", "alice") == 60);
+	CHECK(loaded->get_last_interaction_day("player", "alice") == 0);
+}
+
+} // namespace TestRelationshipGraph
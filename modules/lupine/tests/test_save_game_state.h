@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  test_save_game_state.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../save_game_state.h"
+
+#include "core/io/marshalls.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestSaveGameState {
+
+static Ref<SaveGameState> _make_state() {
+	Ref<SaveGameState> state;
+	state.instantiate();
+
+	Dictionary variables;
+	variables["mood"] = "good";
+	variables["score"] = 12;
+	state->set_section("variables", variables);
+	state->set_section("current_dialogue", "2_1");
+
+	Dictionary metadata;
+	metadata["save_name"] = "Chapter 2";
+	metadata["save_timestamp"] = 1700000000;
+	state->set_metadata(metadata);
+	return state;
+}
+
+TEST_CASE("[SaveGameState] Dirty tracking") {
+	Ref<SaveGameState> state = _make_state();
+	CHECK(state->is_section_dirty("variables"));
+	CHECK_FALSE(state->is_section_dirty("missing"));
+
+	const String path = TestUtils::get_temp_path("dirty.save");
+	REQUIRE(state->save(path) == OK);
+	CHECK_FALSE(state->is_section_dirty("variables"));
+	CHECK_FALSE(state->is_section_dirty("current_dialogue"));
+
+	state->set_section("current_dialogue", "3_1");
+	CHECK(state->is_section_dirty("current_dialogue"));
+	CHECK_FALSE(state->is_section_dirty("variables"));
+
+	Dictionary variables = state->get_section("variables");
+	variables["mood"] = "bad";
+	state->mark_dirty("variables");
+	CHECK(state->is_section_dirty("variables"));
+
+	state->set_compression_mode(FileAccess::COMPRESSION_DEFLATE);
+	REQUIRE(state->save(path) == OK);
+	CHECK_FALSE(state->is_section_dirty("variables"));
+}
+
+TEST_CASE("[SaveGameState] Save and load") {
+	Ref<SaveGameState> state = _make_state();
+	const String path = TestUtils::get_temp_path("slot.save");
+	REQUIRE(state->save(path) == OK);
+
+	// Unchanged sections are written from their cached blobs.
+	state->set_section("current_dialogue", "3_1");
+	REQUIRE(state->save(path) == OK);
+
+	Ref<SaveGameState> loaded;
+	loaded.instantiate();
+	REQUIRE(loaded->load(path) == OK);
+	CHECK(loaded->get_section_names().size() == 2);
+	CHECK(loaded->get_section("current_dialogue") == Variant("3_1"));
+	Dictionary variables = loaded->get_section("variables");
+	CHECK(variables["mood"] == Variant("good"));
+	CHECK(variables["score"] == Variant(12));
+	CHECK_FALSE(loaded->is_section_dirty("variables"));
+	CHECK(loaded->get_metadata()["save_name"] == Variant("Chapter 2"));
+
+	Dictionary metadata = SaveGameState::read_metadata(path);
+	CHECK(metadata["save_timestamp"] == Variant(1700000000));
+	CHECK(SaveGameState::read_metadata(TestUtils::get_temp_path("missing.save")).is_empty());
+}
+
+TEST_CASE("[SaveGameState] Asynchronous save") {
+	Ref<SaveGameState> state = _make_state();
+	const String path = TestUtils::get_temp_path("async.save");
+
+	REQUIRE(state->save_async(path) == OK);
+	ERR_PRINT_OFF;
+	CHECK(state->save_async(path) == ERR_BUSY);
+	ERR_PRINT_ON;
+
+	// Changes made while saving must not leak into the file being written.
+	state->set_section("current_dialogue", "3_1");
+	CHECK(state->wait_for_save() == OK);
+	CHECK_FALSE(state->is_saving());
+	CHECK(state->is_section_dirty("current_dialogue"));
+	CHECK_FALSE(state->is_section_dirty("variables"));
+
+	Ref<SaveGameState> loaded;
+	loaded.instantiate();
+	REQUIRE(loaded->load(path) == OK);
+	CHECK(loaded->get_section("current_dialogue") == Variant("2_1"));
+}
+
+TEST_CASE("[SaveGameState] Replace a section while saving") {
+	Ref<SaveGameState> state = _make_state();
+	const String path = TestUtils::get_temp_path("replaced.save");
+
+	REQUIRE(state->save_async(path) == OK);
+	// The new section must not be taken for the one being saved.
+	state->erase_section("current_dialogue");
+	state->set_section("current_dialogue", "3_1");
+	CHECK(state->wait_for_save() == OK);
+	CHECK(state->is_section_dirty("current_dialogue"));
+
+	REQUIRE(state->save(path) == OK);
+	Ref<SaveGameState> loaded;
+	loaded.instantiate();
+	REQUIRE(loaded->load(path) == OK);
+	CHECK(loaded->get_section("current_dialogue") == Variant("3_1"));
+}
+
+TEST_CASE("[SaveGameState] Invalid files") {
+	const String path = TestUtils::get_temp_path("invalid.save");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("not a save file");
+	}
+
+	Ref<SaveGameState> state;
+	state.instantiate();
+	ERR_PRINT_OFF;
+	CHECK(state->load(path) == ERR_FILE_UNRECOGNIZED);
+	ERR_PRINT_ON;
+	CHECK(SaveGameState::read_metadata(path).is_empty());
+}
+
+TEST_CASE("[SaveGameState] Oversized sections") {
+	const String path = TestUtils::get_temp_path("oversized.save");
+	REQUIRE(_make_state()->save(path) == OK);
+
+	// Claim a huge decoded size for the first section, which must be rejected before allocating it.
+	Vector<uint8_t> bytes = FileAccess::get_file_as_bytes(path);
+	REQUIRE(bytes.size() > 16);
+	const uint32_t metadata_len = decode_uint32(bytes.ptr() + 12);
+	const uint32_t name_offset = 16 + metadata_len + 4;
+	REQUIRE(uint32_t(bytes.size()) > name_offset + 4);
+	const uint32_t raw_size_offset = name_offset + 4 + decode_uint32(bytes.ptr() + name_offset);
+	REQUIRE(uint32_t(bytes.size()) > raw_size_offset + 4);
+	encode_uint32(UINT32_MAX, bytes.ptrw() + raw_size_offset);
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(bytes);
+	}
+
+	Ref<SaveGameState> state;
+	state.instantiate();
+	ERR_PRINT_OFF;
+	CHECK(state->load(path) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestSaveGameState
@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  test_screen_effects_compositor.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../screen_effects_compositor.h"
+
+#include "tests/test_macros.h"
+
+namespace TestScreenEffectsCompositor {
+
+static int fade_finished_count = 0;
+
+static void _on_fade_finished() {
+	fade_finished_count++;
+}
+
+static Ref<Image> _make_screen(int p_width, int p_height, const Color &p_left, const Color &p_right) {
+	Ref<Image> screen = Image::create_empty(p_width, p_height, false, Image::FORMAT_RGBAF);
+	for (int y = 0; y < p_height; y++) {
+		for (int x = 0; x < p_width; x++) {
+			screen->set_pixel(x, y, x < p_width / 2 ? p_left : p_right);
+		}
+	}
+	return screen;
+}
+
+static bool _is_color_approx(const Color &p_a, const Color &p_b) {
+	return Math::is_equal_approx(p_a.r, p_b.r, 0.001f) && Math::is_equal_approx(p_a.g, p_b.g, 0.001f) && Math::is_equal_approx(p_a.b, p_b.b, 0.001f) && Math::is_equal_approx(p_a.a, p_b.a, 0.001f);
+}
+
+TEST_CASE("[SceneTree][ScreenEffectsCompositor] Effects run on a timeline") {
+	ScreenEffectsCompositor *effects = memnew(ScreenEffectsCompositor);
+	effects->connect("fade_finished", callable_mp_static(&_on_fade_finished));
+	fade_finished_count = 0;
+	CHECK_FALSE(effects->is_effect_visible());
+
+	effects->fade_to(Color(0, 0, 0), 1.0);
+	effects->step(0.5);
+	CHECK(effects->get_fade_alpha() == doctest::Approx(0.5));
+	CHECK(effects->is_fading());
+	CHECK(effects->is_effect_visible());
+	CHECK_FALSE(effects->is_reading_screen());
+	effects->step(0.5);
+	CHECK(effects->get_fade_alpha() == doctest::Approx(1.0));
+	CHECK(fade_finished_count == 1);
+	effects->step(0.5);
+	CHECK(fade_finished_count == 1);
+
+	effects->fade_from(Color(0, 0, 0), 1.0);
+	effects->step(1.0);
+	CHECK(effects->get_fade_alpha() == doctest::Approx(0.0));
+	CHECK(fade_finished_count == 2);
+	CHECK_FALSE(effects->is_effect_visible());
+
+	effects->flash(Color(1, 0, 0, 0.5), 0.2);
+	CHECK(effects->is_effect_visible());
+	effects->step(0.25);
+	CHECK_FALSE(effects->is_effect_visible());
+
+	// Distortions need the screen texture; overlays don't.
+	effects->pulse_chromatic_aberration(0.01, 1.0);
+	CHECK(effects->is_reading_screen());
+	effects->step(1.0);
+	CHECK_FALSE(effects->is_reading_screen());
+	effects->set_crt_enabled(true);
+	CHECK(effects->is_reading_screen());
+
+	memdelete(effects);
+}
+
+TEST_CASE("[SceneTree][ScreenEffectsCompositor] CPU reference of the overlays") {
+	ScreenEffectsCompositor *effects = memnew(ScreenEffectsCompositor);
+	const Ref<Image> white = _make_screen(8, 8, Color(1, 1, 1), Color(1, 1, 1));
+
+	Ref<Image> result = effects->render_reference(white);
+	CHECK(_is_color_approx(result->get_pixel(3, 3), Color(1, 1, 1)));
+
+	effects->fade_to(Color(0, 0, 0), 1.0);
+	effects->step(0.5);
+	result = effects->render_reference(white);
+	CHECK(_is_color_approx(result->get_pixel(0, 0), Color(0.5, 0.5, 0.5)));
+	CHECK(_is_color_approx(result->get_pixel(7, 7), Color(0.5, 0.5, 0.5)));
+
+	// Flash and fade are blended in one pass, fade on top.
+	effects->flash(Color(1, 0, 0, 1), 1.0);
+	result = effects->render_reference(white);
+	CHECK(_is_color_approx(result->get_pixel(4, 4), Color(0.5, 0, 0)));
+	effects->clear_effects();
+
+	effects->set_vignette_intensity(1.0);
+	effects->set_vignette_radius(0.2);
+	effects->set_vignette_softness(0.5);
+	result = effects->render_reference(white);
+	const Color center = result->get_pixel(4, 4);
+	const Color edge = result->get_pixel(0, 4);
+	const Color corner = result->get_pixel(0, 0);
+	CHECK(_is_color_approx(center, Color(1, 1, 1)));
+	CHECK(edge.r < center.r);
+	CHECK(corner.r < edge.r);
+	CHECK(corner.a == doctest::Approx(1.0));
+
+	memdelete(effects);
+}
+
+TEST_CASE("[SceneTree][ScreenEffectsCompositor] CPU reference of the screen distortions") {
+	ScreenEffectsCompositor *effects = memnew(ScreenEffectsCompositor);
+	const Ref<Image> split = _make_screen(16, 4, Color(0, 0, 0), Color(1, 1, 1));
+
+	// Without aberration, each channel comes from the same place.
+	effects->set_chromatic_aberration(0.0);
+	effects->set_crt_enabled(true);
+	effects->set_curvature(0.0);
+	effects->set_scanline_intensity(0.0);
+	CHECK_FALSE(effects->is_reading_screen());
+	effects->set_scanline_intensity(0.5);
+	effects->set_scanline_count(2.0);
+	Ref<Image> result = effects->render_reference(split);
+	CHECK(result->get_pixel(12, 0).r != doctest::Approx(result->get_pixel(12, 1).r));
+	CHECK(result->get_pixel(12, 0).r == doctest::Approx(result->get_pixel(12, 0).b));
+	CHECK(result->get_pixel(2, 0).r == doctest::Approx(0.0));
+
+	// Red is pulled from further out and blue from further in, so the
+	// channels split around the edge.
+	effects->set_crt_enabled(false);
+	effects->set_chromatic_aberration(0.2);
+	result = effects->render_reference(split);
+	const Color near_edge = result->get_pixel(8, 2);
+	CHECK(near_edge.r > near_edge.b);
+	CHECK(result->get_pixel(15, 2).r == doctest::Approx(1.0));
+
+	// Strong curvature pushes the corners off the screen.
+	effects->set_chromatic_aberration(0.0);
+	effects->set_crt_enabled(true);
+	effects->set_scanline_intensity(0.0);
+	effects->set_curvature(1.0);
+	result = effects->render_reference(split);
+	CHECK(_is_color_approx(result->get_pixel(15, 0), Color(0, 0, 0)));
+	CHECK(result->get_pixel(12, 2).r > 0.5);
+
+	ERR_PRINT_OFF;
+	CHECK(effects->render_reference(Ref<Image>()).is_null());
+	ERR_PRINT_ON;
+
+	memdelete(effects);
+}
+
+} // namespace TestScreenEffectsCompositor
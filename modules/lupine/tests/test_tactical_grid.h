@@ -0,0 +1,149 @@
+/**************************************************************************/
+/*  test_tactical_grid.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../tactical_grid.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTacticalGrid {
+
+static Ref<TacticalGrid> _make_grid(const Size2i &p_size) {
+	Ref<TacticalGrid> grid;
+	grid.instantiate();
+	grid->set_size(p_size);
+	grid->update();
+	return grid;
+}
+
+TEST_CASE("[TacticalGrid] Units and occupancy") {
+	Ref<TacticalGrid> grid = _make_grid(Size2i(5, 5));
+
+	const int a = grid->add_unit(Vector2i(0, 0), 0, 3);
+	const int b = grid->add_unit(Vector2i(1, 0), 1, 3);
+	CHECK(a >= 0);
+	CHECK(b >= 0);
+	CHECK(grid->get_unit_at(Vector2i(1, 0)) == b);
+	CHECK(grid->get_unit_at(Vector2i(2, 2)) == -1);
+
+	ERR_PRINT_OFF;
+	CHECK(grid->add_unit(Vector2i(0, 0), 0, 3) == -1);
+	CHECK(grid->add_unit(Vector2i(9, 9), 0, 3) == -1);
+	ERR_PRINT_ON;
+
+	CHECK_FALSE(grid->set_unit_cell(a, Vector2i(1, 0)));
+	CHECK(grid->set_unit_cell(a, Vector2i(2, 2)));
+	CHECK(grid->get_unit_at(Vector2i(0, 0)) == -1);
+	CHECK(grid->get_unit_at(Vector2i(2, 2)) == a);
+
+	grid->remove_unit(b);
+	CHECK_FALSE(grid->has_unit(b));
+	CHECK(grid->get_unit_at(Vector2i(1, 0)) == -1);
+	CHECK(grid->add_unit(Vector2i(4, 4), 1, 2) == b);
+}
+
+TEST_CASE("[TacticalGrid] Movement range with terrain and blockers") {
+	Ref<TacticalGrid> grid = _make_grid(Size2i(5, 5));
+	const int unit = grid->add_unit(Vector2i(0, 0), 0, 2);
+
+	grid->set_point_weight_scale(Vector2i(1, 0), 2.0);
+	TypedArray<Vector2i> range = grid->get_movement_range(unit);
+	CHECK(range.size() == 5);
+	CHECK(range[0] == Variant(Vector2i(0, 0)));
+	CHECK(range.has(Vector2i(1, 0)));
+	CHECK_FALSE(range.has(Vector2i(2, 0)));
+
+	// Opponents block, teammates can be passed through but not stopped on.
+	grid->set_point_weight_scale(Vector2i(1, 0), 1.0);
+	grid->add_unit(Vector2i(1, 0), 1, 2);
+	grid->add_unit(Vector2i(0, 1), 0, 2);
+	range = grid->get_movement_range(unit);
+	CHECK(range.size() == 3);
+	CHECK(range.has(Vector2i(1, 1)));
+	CHECK(range.has(Vector2i(0, 2)));
+	CHECK_FALSE(range.has(Vector2i(0, 1)));
+
+	TypedArray<Vector2i> path = grid->get_move_path(unit, Vector2i(1, 1));
+	REQUIRE(path.size() == 3);
+	CHECK(path[1] == Variant(Vector2i(0, 1)));
+	CHECK(path[2] == Variant(Vector2i(1, 1)));
+	CHECK(grid->get_move_path(unit, Vector2i(2, 0)).is_empty());
+
+	grid->set_point_solid(Vector2i(0, 2));
+	CHECK(grid->get_movement_range(unit).size() == 2);
+}
+
+TEST_CASE("[TacticalGrid] Attack ranges and threat maps") {
+	Ref<TacticalGrid> grid = _make_grid(Size2i(5, 5));
+	const int archer = grid->add_unit(Vector2i(2, 2), 0, 0, 2, 2);
+	CHECK(grid->get_attack_range(archer).size() == 8);
+	grid->set_unit_attack_range(archer, 1, 1);
+	CHECK(grid->get_attack_range(archer).size() == 4);
+
+	const int enemy = grid->add_unit(Vector2i(4, 4), 1, 1);
+	grid->set_unit_damage(enemy, 5);
+	const int other = grid->add_unit(Vector2i(4, 0), 1, 0);
+	grid->set_unit_damage(other, 5);
+	CHECK(grid->get_targets_in_range(enemy, Vector2i(3, 3)).is_empty());
+	CHECK(grid->get_targets_in_range(enemy, Vector2i(2, 3)) == PackedInt32Array({ archer }));
+
+	const PackedInt32Array threat = grid->get_threat_map(0);
+	REQUIRE(threat.size() == 25);
+	CHECK(threat[3 * 5 + 3] == 1);
+	CHECK(threat[0 * 5 + 3] == 1);
+	CHECK(threat[2 * 5 + 4] == 1);
+	CHECK(threat[0] == 0);
+	CHECK(threat[2 * 5 + 2] == 0);
+}
+
+TEST_CASE("[TacticalGrid] Turn planning") {
+	Ref<TacticalGrid> grid = _make_grid(Size2i(6, 4));
+	const int player = grid->add_unit(Vector2i(3, 0), 0, 3);
+	grid->set_unit_health(player, 5);
+	const int first = grid->add_unit(Vector2i(0, 0), 1, 3);
+	const int second = grid->add_unit(Vector2i(0, 1), 1, 3);
+	grid->set_unit_damage(first, 10);
+	grid->set_unit_damage(second, 10);
+
+	const TypedArray<Dictionary> plan = grid->plan_turn(1);
+	REQUIRE(plan.size() == 2);
+	const Dictionary first_action = plan[0];
+	const Dictionary second_action = plan[1];
+	CHECK(int(first_action["unit"]) == first);
+	CHECK(first_action["cell"] == Variant(Vector2i(2, 0)));
+	CHECK(int(first_action["target"]) == player);
+	CHECK(int(second_action["target"]) == player);
+	CHECK(second_action["cell"] != first_action["cell"]);
+
+	CHECK(grid->plan_turn(2).is_empty());
+}
+
+} // namespace TestTacticalGrid
@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  test_vn_asset_streamer.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../vn_asset_streamer.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/image.h"
+#include "core/io/resource_saver.h"
+#include "scene/resources/image_texture.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestVNAssetStreamer {
+
+static const char *vn_source = R"(1_1
+Alice
+Good morning.
+[[background courtyard]]
+[[setLeft Alice_happy]]
+[2_1]
+
+2_1
+Alice
+See you tonight.
+[[background night]]
+[end]
+)";
+
+static String _make_asset_directory() {
+	const String directory = TestUtils::get_temp_path("vn_assets");
+	Ref<DirAccess> dir = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	dir->make_dir_recursive(directory);
+
+	const char *names[] = { "courtyard", "night", "Alice_happy" };
+	for (const char *name : names) {
+		Ref<ImageTexture> texture = ImageTexture::create_from_image(Image::create_empty(16, 8, false, Image::FORMAT_RGBA8));
+		REQUIRE(ResourceSaver::save(texture, directory.path_join(String(name) + ".res")) == OK);
+	}
+	Ref<FileAccess> f = FileAccess::open(directory.path_join("notes.txt"), FileAccess::WRITE);
+	f->store_string("Not an asset.");
+	return directory;
+}
+
+TEST_CASE("[VNAssetStreamer] Name index") {
+	const String directory = _make_asset_directory();
+	Ref<VNAssetStreamer> streamer;
+	streamer.instantiate();
+	REQUIRE(streamer->add_directory("backgrounds", directory) == OK);
+
+	CHECK(streamer->get_asset_names("backgrounds").size() == 3);
+	CHECK(streamer->has_asset("backgrounds", "courtyard"));
+	CHECK(streamer->find_asset("backgrounds", "night") == directory.path_join("night.res"));
+	CHECK_FALSE(streamer->has_asset("backgrounds", "notes"));
+	CHECK_FALSE(streamer->has_asset("portraits", "courtyard"));
+
+	ERR_PRINT_OFF;
+	CHECK(streamer->add_directory("portraits", directory.path_join("missing")) == ERR_FILE_NOT_FOUND);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[VNAssetStreamer] Memory budget") {
+	const String directory = _make_asset_directory();
+	Ref<VNAssetStreamer> streamer;
+	streamer.instantiate();
+	REQUIRE(streamer->add_directory("backgrounds", directory) == OK);
+	const int64_t texture_size = Image::get_image_data_size(16, 8, Image::FORMAT_RGBA8, false);
+
+	Ref<Texture2D> courtyard = streamer->get_texture("backgrounds", "courtyard");
+	REQUIRE(courtyard.is_valid());
+	CHECK(courtyard->get_width() == 16);
+	CHECK(streamer->get_memory_usage() == texture_size);
+	CHECK(streamer->get_texture("backgrounds", "courtyard") == courtyard);
+
+	streamer->set_memory_budget(texture_size * 2);
+	streamer->get_texture("backgrounds", "night");
+	// Using a texture again makes it the most recent one.
+	streamer->get_texture("backgrounds", "courtyard");
+	streamer->get_texture("backgrounds", "Alice_happy");
+	CHECK(streamer->get_memory_usage() == texture_size * 2);
+	CHECK(streamer->is_loaded("backgrounds", "courtyard"));
+	CHECK(streamer->is_loaded("backgrounds", "Alice_happy"));
+	CHECK_FALSE(streamer->is_loaded("backgrounds", "night"));
+
+	streamer->clear_cache();
+	CHECK(streamer->get_memory_usage() == 0);
+	CHECK_FALSE(streamer->is_loaded("backgrounds", "courtyard"));
+}
+
+TEST_CASE("[VNAssetStreamer] Script prefetch") {
+	const String directory = _make_asset_directory();
+	Ref<VNAssetStreamer> streamer;
+	streamer.instantiate();
+	REQUIRE(streamer->add_directory("backgrounds", directory) == OK);
+	REQUIRE(streamer->add_directory("portraits", directory) == OK);
+	streamer->set_command_category("background", "backgrounds");
+	streamer->set_command_category("setLeft", "portraits");
+
+	Ref<VNScript> script;
+	script.instantiate();
+	REQUIRE(script->compile(vn_source) == OK);
+	const int start = script->resolve_label(script->find_label("1_1"), Dictionary());
+
+	// Only the first node is within a lookahead of one.
+	streamer->set_lookahead(1);
+	streamer->prefetch_script(script, start);
+	CHECK(streamer->get_pending_count() + int(streamer->is_loaded("backgrounds", "courtyard")) + int(streamer->is_loaded("portraits", "Alice_happy")) == 2);
+	CHECK_FALSE(streamer->is_loaded("backgrounds", "night"));
+
+	streamer->set_lookahead(8);
+	streamer->prefetch_script(script, start);
+	CHECK(streamer->get_texture("backgrounds", "night").is_valid());
+	CHECK(streamer->get_texture("backgrounds", "courtyard").is_valid());
+	CHECK(streamer->get_texture("portraits", "Alice_happy").is_valid());
+	streamer->poll();
+	CHECK(streamer->get_pending_count() == 0);
+}
+
+} // namespace TestVNAssetStreamer
@@ -0,0 +1,237 @@
+/**************************************************************************/
+/*  test_vn_script.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../vn_script.h"
+
+#include "core/io/file_access.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestVNScript {
+
+static const char *vn_source = R"(# Test script
+FN : Conversation
+
+[[background school_courtyard]]
+
+1_1
+Char2
+Hey Char1! How are you doing?
+[Good!|2_1]
+[Bad!|2_2]
+
+2_1
+Char2_happy
+That's great!
+[[var mood = good]]
+[3_1]
+
+2_2
+DamienWayne_sad
+Oh, I'm sorry
+Really.
+[[var mood = bad]]
+[3_1]
+
+3_1 if mood = good
+Char2_happy
+I'm doing good as well!
+[[signal char2Happy]]
+[end]
+
+3_1 if mood = bad and not (score >= 10 or lucky)
+Char2_sad
+At least I'm doing better...
+[end]
+)";
+
+TEST_CASE("[VNScript] Compilation") {
+	Ref<VNScript> script;
+	script.instantiate();
+	REQUIRE(script->compile(vn_source) == OK);
+
+	CHECK(script->get_node_count() == 5);
+	CHECK(script->get_label_count() == 4);
+	CHECK(script->get_function_count() == 1);
+	CHECK(script->get_function_name(0) == "Conversation");
+	CHECK(script->get_function_entry(0) == script->find_label("1_1"));
+	CHECK(script->get_function_commands(0) == PackedStringArray({ "background school_courtyard" }));
+
+	const int start = script->resolve_label(script->find_label("1_1"), Dictionary());
+	REQUIRE(start >= 0);
+	CHECK(script->get_node_speaker(start) == "Char2");
+	CHECK(script->get_node_text(start) == "Hey Char1! How are you doing?");
+	CHECK(script->get_node_choice_count(start) == 2);
+	CHECK(script->get_node_choice_text(start, 1) == "Bad!");
+	CHECK(script->get_node_choice_target(start, 1) == script->find_label("2_2"));
+
+	const int sad = script->resolve_label(script->find_label("2_2"), Dictionary());
+	CHECK(script->get_node_speaker(sad) == "Damien Wayne");
+	CHECK(script->get_node_speaker_id(sad) == "DamienWayne_sad");
+	CHECK(script->get_node_emotion(sad) == "sad");
+	CHECK(script->get_node_text(sad) == "Oh, I'm sorry\nReally.");
+	CHECK(script->get_node_command_count(sad) == 1);
+	CHECK(script->get_node_command_name(sad, 0) == "var");
+	CHECK(script->get_node_command_text(sad, 0) == "mood = bad");
+	CHECK(script->get_node_command_args(sad, 0) == PackedStringArray({ "mood", "=", "bad" }));
+	CHECK(script->get_node_next(sad) == script->find_label("3_1"));
+
+	CHECK(script->find_label("missing") == VNScript::TARGET_END);
+}
+
+TEST_CASE("[VNScript] Conditional nodes") {
+	Ref<VNScript> script;
+	script.instantiate();
+	REQUIRE(script->compile(vn_source) == OK);
+	const int label = script->find_label("3_1");
+
+	Dictionary variables;
+	CHECK(script->resolve_label(label, variables) == VNScript::TARGET_END);
+
+	variables["mood"] = "good";
+	int node = script->resolve_label(label, variables);
+	CHECK(script->get_node_text(node) == "I'm doing good as well!");
+	CHECK(script->get_node_next(node) == VNScript::TARGET_END);
+
+	variables["mood"] = "bad";
+	node = script->resolve_label(label, variables);
+	CHECK(script->get_node_text(node) == "At least I'm doing better...");
+
+	variables["score"] = 12;
+	CHECK(script->resolve_label(label, variables) == VNScript::TARGET_END);
+	variables["score"] = 2;
+	variables["lucky"] = true;
+	CHECK(script->resolve_label(label, variables) == VNScript::TARGET_END);
+	variables["lucky"] = false;
+	CHECK(script->resolve_label(label, variables) == node);
+}
+
+TEST_CASE("[VNScript] Condition evaluation") {
+	Dictionary variables;
+	variables["gold"] = 15;
+	variables["name"] = "Ana";
+	variables["met"] = true;
+
+	CHECK(VNScript::evaluate_condition("gold >= 10", variables));
+	CHECK(VNScript::evaluate_condition("gold == 15.0", variables));
+	CHECK_FALSE(VNScript::evaluate_condition("gold < 10", variables));
+	CHECK(VNScript::evaluate_condition("name = Ana && met", variables));
+	CHECK(VNScript::evaluate_condition("name != \"Bob\"", variables));
+	CHECK(VNScript::evaluate_condition("!unknown || gold > 100", variables));
+	// Comparing against a missing variable is false rather than an error.
+	CHECK_FALSE(VNScript::evaluate_condition("unknown > 3", variables));
+
+	ERR_PRINT_OFF;
+	CHECK_FALSE(VNScript::evaluate_condition("gold >=", variables));
+	CHECK_FALSE(VNScript::evaluate_condition("(gold > 1", variables));
+	ERR_PRINT_ON;
+
+	// Conditions are compiled once, but always read the current values.
+	variables["gold"] = 5;
+	CHECK_FALSE(VNScript::evaluate_condition("gold >= 10", variables));
+	CHECK(VNScript::evaluate_condition("gold < 10", variables));
+
+	// More conditions than are kept, so the cache starts over on the way.
+	bool all_true = true;
+	for (int i = 0; i < 300; i++) {
+		// Reduce number of check messages.
+		all_true &= VNScript::evaluate_condition(vformat("gold < %d", 6 + i), variables);
+	}
+	CHECK(all_true);
+	CHECK(VNScript::evaluate_condition("gold < 10", variables));
+}
+
+TEST_CASE("[VNScript] Compilation errors") {
+	Ref<VNScript> script;
+	script.instantiate();
+
+	CHECK(script->compile("start\nNarrator\nHello.\n[nowhere]\n") == ERR_PARSE_ERROR);
+	CHECK(script->get_error_line() == 4);
+	CHECK(script->get_node_count() == 0);
+
+	CHECK(script->compile("start if (a and\nNarrator\n") == ERR_PARSE_ERROR);
+	CHECK(script->get_error_line() == 1);
+}
+
+TEST_CASE("[VNScript] Save and load compiled script") {
+	Ref<VNScript> script;
+	script.instantiate();
+	REQUIRE(script->compile(vn_source) == OK);
+
+	const String path = TestUtils::get_temp_path("test.vnscript");
+	REQUIRE(script->save_compiled(path) == OK);
+
+	Ref<VNScript> loaded;
+	loaded.instantiate();
+	REQUIRE(loaded->load_compiled(path) == OK);
+
+	CHECK(loaded->get_node_count() == script->get_node_count());
+	CHECK(loaded->get_label_count() == script->get_label_count());
+	for (int i = 0; i < script->get_node_count(); i++) {
+		CHECK(loaded->get_node_label(i) == script->get_node_label(i));
+		CHECK(loaded->get_node_speaker(i) == script->get_node_speaker(i));
+		CHECK(loaded->get_node_text(i) == script->get_node_text(i));
+		CHECK(loaded->get_node_choices(i) == script->get_node_choices(i));
+	}
+
+	Dictionary variables;
+	variables["mood"] = "good";
+	const int label = loaded->find_label("3_1");
+	CHECK(loaded->resolve_label(label, variables) == script->resolve_label(label, variables));
+
+	// Point the first node at function -2, which must be rejected.
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ_WRITE);
+		REQUIRE(f.is_valid());
+		f->seek(8); // Magic and version.
+		for (int table = 0; table < 2; table++) { // Names and strings.
+			const uint32_t count = f->get_32();
+			for (uint32_t i = 0; i < count; i++) {
+				(void)f->get_pascal_string();
+			}
+		}
+		const uint32_t constant_count = f->get_32();
+		for (uint32_t i = 0; i < constant_count; i++) {
+			const uint32_t len = f->get_32();
+			f->seek(f->get_position() + len);
+		}
+		REQUIRE(f->get_32() > 0);
+		f->seek(f->get_position() + offsetof(VNScript::NodeData, function));
+		f->store_32(uint32_t(-2));
+	}
+	ERR_PRINT_OFF;
+	CHECK(loaded->load_compiled(path) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestVNScript
@@ -0,0 +1,202 @@
+/**************************************************************************/
+/*  test_world_state.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../world_state.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorldState {
+
+static Dictionary _variable_condition(const String &p_variable, const String &p_operator, const Variant &p_value) {
+	Dictionary condition;
+	condition["type"] = "variable";
+	condition["variable"] = p_variable;
+	condition["operator"] = p_operator;
+	condition["value"] = p_value;
+	return condition;
+}
+
+TEST_CASE("[WorldState] Variables") {
+	WorldState *state = WorldState::get_singleton();
+	REQUIRE(state);
+	state->clear();
+
+	state->set_variable("stars_collected", 2);
+	CHECK(state->has_variable("stars_collected"));
+	CHECK(state->get_variable("stars_collected") == Variant(2));
+	CHECK(state->get_variable("missing", 7) == Variant(7));
+
+	state->increment_variable("stars_collected", 1.5);
+	CHECK(state->get_variable("stars_collected") == Variant(3.5));
+	state->increment_variable("secrets_found");
+	CHECK(state->get_variable("secrets_found") == Variant(1.0));
+
+	state->erase_variable("stars_collected");
+	CHECK_FALSE(state->has_variable("stars_collected"));
+	CHECK(state->get_variable_names().size() == 1);
+
+	state->clear();
+}
+
+TEST_CASE("[WorldState] Flags") {
+	WorldState *state = WorldState::get_singleton();
+	state->clear();
+
+	CHECK(state->set_flag(WorldState::FLAG_LOCATION_DISCOVERED, "cave"));
+	CHECK_FALSE(state->set_flag(WorldState::FLAG_LOCATION_DISCOVERED, "cave"));
+	CHECK(state->has_flag(WorldState::FLAG_LOCATION_DISCOVERED, "cave"));
+	CHECK_FALSE(state->has_flag(WorldState::FLAG_ITEM_COLLECTED, "cave"));
+	CHECK_FALSE(state->has_flag(WorldState::FLAG_LOCATION_DISCOVERED, "forest"));
+
+	// Spread ids over several bitset words.
+	for (int i = 0; i < 200; i++) {
+		state->set_flag(WorldState::FLAG_ITEM_COLLECTED, vformat("coin_%d", i), i % 3 == 0);
+	}
+	CHECK(state->get_flag_count(WorldState::FLAG_ITEM_COLLECTED) == 67);
+	CHECK(state->has_flag(WorldState::FLAG_ITEM_COLLECTED, "coin_198"));
+	CHECK_FALSE(state->has_flag(WorldState::FLAG_ITEM_COLLECTED, "coin_199"));
+
+	CHECK(state->set_flag(WorldState::FLAG_LOCATION_DISCOVERED, "cave", false));
+	CHECK(state->get_flags(WorldState::FLAG_LOCATION_DISCOVERED).is_empty());
+
+	state->clear();
+}
+
+TEST_CASE("[WorldState] Conditions") {
+	WorldState *state = WorldState::get_singleton();
+	state->clear();
+
+	Dictionary trigger;
+	trigger["type"] = "trigger";
+	trigger["trigger_id"] = "gate_lever";
+
+	Dictionary not_trigger;
+	not_trigger["type"] = "not";
+	not_trigger["condition"] = trigger;
+
+	Array any;
+	any.push_back(_variable_condition("coins_collected", ">=", 10));
+	any.push_back(not_trigger);
+	Dictionary or_condition;
+	or_condition["type"] = "or";
+	or_condition["conditions"] = any;
+
+	Array all;
+	all.push_back(_variable_condition("tutorial_completed", "==", true));
+	all.push_back(or_condition);
+
+	Ref<WorldStateCondition> condition = state->compile_condition(all);
+	REQUIRE(condition.is_valid());
+	CHECK_FALSE(state->evaluate(condition));
+
+	state->set_variable("tutorial_completed", true);
+	CHECK(state->evaluate(condition));
+
+	state->set_flag(WorldState::FLAG_TRIGGER_ACTIVATED, "gate_lever");
+	CHECK_FALSE(state->evaluate(condition));
+
+	state->set_variable("coins_collected", 12);
+	CHECK(state->evaluate(condition));
+	CHECK(state->check_condition(trigger));
+
+	// Comparing against a missing variable fails instead of erroring.
+	CHECK_FALSE(state->check_condition(_variable_condition("missing", ">", 1)));
+
+	ERR_PRINT_OFF;
+	Dictionary unknown;
+	unknown["type"] = "weather";
+	CHECK_FALSE(state->check_condition(unknown));
+	ERR_PRINT_ON;
+
+	state->clear();
+}
+
+TEST_CASE("[WorldState] Change journal") {
+	WorldState *state = WorldState::get_singleton();
+	state->clear();
+	const int capacity = state->get_journal_capacity();
+
+	const uint64_t start = state->get_journal_serial();
+	state->set_variable("mood", "good");
+	state->set_variable("mood", "good"); // Unchanged, not recorded.
+	state->set_flag(WorldState::FLAG_PUZZLE_COMPLETED, "switches");
+
+	Array changes = state->get_changes_since(start);
+	REQUIRE(changes.size() == 2);
+	Dictionary first = changes[0];
+	CHECK(first["key"] == Variant("mood"));
+	CHECK(first["flag"] == Variant(WorldState::CHANGE_VARIABLE));
+	CHECK(first["old_value"].get_type() == Variant::NIL);
+	CHECK(first["new_value"] == Variant("good"));
+	Dictionary second = changes[1];
+	CHECK(second["flag"] == Variant(WorldState::FLAG_PUZZLE_COMPLETED));
+	CHECK(second["new_value"] == Variant(true));
+	CHECK(state->get_changes_since(state->get_journal_serial()).is_empty());
+
+	// Only the most recent changes are kept.
+	state->set_journal_capacity(4);
+	const uint64_t before = state->get_journal_serial();
+	for (int i = 0; i < 10; i++) {
+		state->set_variable("counter", i);
+	}
+	changes = state->get_changes_since(before);
+	REQUIRE(changes.size() == 4);
+	CHECK(Dictionary(changes[0])["new_value"] == Variant(6));
+	CHECK(Dictionary(changes[3])["new_value"] == Variant(9));
+
+	state->set_journal_capacity(capacity);
+	state->clear();
+}
+
+TEST_CASE("[WorldState] State roundtrip") {
+	WorldState *state = WorldState::get_singleton();
+	state->clear();
+
+	state->set_variable("game_started", true);
+	state->set_flag(WorldState::FLAG_LOCATION_DISCOVERED, "village");
+	state->set_flag(WorldState::FLAG_ITEM_COLLECTED, "key");
+	const Dictionary saved = state->get_state();
+
+	state->clear();
+	CHECK_FALSE(state->has_variable("game_started"));
+	CHECK_FALSE(state->has_flag(WorldState::FLAG_ITEM_COLLECTED, "key"));
+
+	state->set_state(saved);
+	CHECK(state->get_variable("game_started") == Variant(true));
+	CHECK(state->has_flag(WorldState::FLAG_LOCATION_DISCOVERED, "village"));
+	CHECK(state->has_flag(WorldState::FLAG_ITEM_COLLECTED, "key"));
+	CHECK_FALSE(state->has_flag(WorldState::FLAG_ITEM_COLLECTED, "village"));
+
+	state->clear();
+}
+
+} // namespace TestWorldState
@@ -0,0 +1,361 @@
+/**************************************************************************/
+/*  vn_asset_streamer.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "vn_asset_streamer.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "scene/resources/compressed_texture.h"
+#include "scene/resources/image_texture.h"
+
+uint64_t VNAssetStreamer::_get_texture_size(const Ref<Texture2D> &p_texture) {
+	// Only an estimate of the video memory used, as textures don't report it.
+	Image::Format format = Image::FORMAT_RGBA8;
+	Ref<CompressedTexture2D> compressed = p_texture;
+	Ref<ImageTexture> image_texture = p_texture;
+	if (compressed.is_valid()) {
+		format = compressed->get_format();
+	} else if (image_texture.is_valid()) {
+		format = image_texture->get_format();
+	}
+	return Image::get_image_data_size(p_texture->get_width(), p_texture->get_height(), format, false);
+}
+
+const Dictionary *VNAssetStreamer::_get_export_index() {
+	if (export_index_loaded) {
+		return has_export_index ? &export_index : nullptr;
+	}
+	export_index_loaded = true;
+
+	if (!FileAccess::exists(INDEX_PATH)) {
+		return nullptr;
+	}
+	const Vector<uint8_t> data = FileAccess::get_file_as_bytes(INDEX_PATH);
+	Variant decoded;
+	Error err = decode_variant(decoded, data.ptr(), data.size());
+	ERR_FAIL_COND_V_MSG(err != OK || decoded.get_type() != Variant::DICTIONARY, nullptr, vformat("Invalid VN asset index \"%s\".", INDEX_PATH));
+	const Dictionary index = decoded;
+	ERR_FAIL_COND_V_MSG(int(index.get("version", 0)) != INDEX_VERSION, nullptr, vformat("Unsupported VN asset index version in \"%s\".", INDEX_PATH));
+	export_index = index.get("directories", Dictionary());
+	has_export_index = true;
+	return &export_index;
+}
+
+void VNAssetStreamer::_touch(Entry &p_entry) {
+	if (p_entry.lru) {
+		lru.move_to_front(p_entry.lru);
+	}
+}
+
+Ref<Texture2D> VNAssetStreamer::_finish_load(const String &p_path, const Ref<Resource> &p_resource) {
+	Ref<Texture2D> texture = p_resource;
+	if (texture.is_null()) {
+		entries.erase(p_path);
+		ERR_FAIL_V_MSG(Ref<Texture2D>(), vformat("Failed to load VN asset \"%s\".", p_path));
+	}
+
+	Entry &entry = entries[p_path];
+	entry.texture = texture;
+	entry.pending = false;
+	entry.size = _get_texture_size(texture);
+	entry.lru = lru.push_front(p_path);
+	memory_usage += entry.size;
+
+	_evict();
+	return texture;
+}
+
+void VNAssetStreamer::_evict() {
+	// Dropping a texture only releases the streamer's reference; textures
+	// still on screen stay alive through their display nodes. The most
+	// recent texture is always kept, even if it's over budget on its own.
+	while (memory_usage > memory_budget && lru.size() > 1) {
+		List<String>::Element *oldest = lru.back();
+		const Entry *entry = entries.getptr(oldest->get());
+		memory_usage -= entry->size;
+		entries.erase(oldest->get());
+		lru.erase(oldest);
+	}
+}
+
+void VNAssetStreamer::_prefetch_path(const String &p_path) {
+	Entry *entry = entries.getptr(p_path);
+	if (entry) {
+		_touch(*entry);
+		return;
+	}
+
+	Ref<Resource> cached = ResourceCache::get_ref(p_path);
+	if (cached.is_valid()) {
+		_finish_load(p_path, cached);
+		return;
+	}
+
+	if (ResourceLoader::load_threaded_request(p_path, "Texture2D") != OK) {
+		return;
+	}
+	entries[p_path].pending = true;
+	pending.push_back(p_path);
+}
+
+void VNAssetStreamer::_prefetch_node(const Ref<VNScript> &p_script, int p_node) {
+	for (int i = 0; i < p_script->get_node_command_count(p_node); i++) {
+		const StringName *category = command_categories.getptr(p_script->get_node_command_name(p_node, i));
+		if (!category) {
+			continue;
+		}
+		const PackedStringArray args = p_script->get_node_command_args(p_node, i);
+		if (args.is_empty()) {
+			continue;
+		}
+		const String path = find_asset(*category, args[0]);
+		if (!path.is_empty()) {
+			_prefetch_path(path);
+		}
+	}
+}
+
+Error VNAssetStreamer::add_directory(const StringName &p_category, const String &p_directory) {
+	ERR_FAIL_COND_V(p_category == StringName(), ERR_INVALID_PARAMETER);
+	const String directory = (p_directory.is_relative_path() ? "res://" + p_directory : p_directory).simplify_path();
+	HashMap<String, String> &names = categories[p_category];
+
+	const Dictionary *index = _get_export_index();
+	if (index) {
+		const Dictionary directory_index = index->get(directory, Dictionary());
+		for (const KeyValue<Variant, Variant> &E : directory_index) {
+			names[E.key] = E.value;
+		}
+		return OK;
+	}
+
+	// Without an index (running from the editor, or exported without .vn
+	// scripts), list the directory instead.
+	Ref<DirAccess> dir = DirAccess::open(directory);
+	ERR_FAIL_COND_V_MSG(dir.is_null(), ERR_FILE_NOT_FOUND, vformat("VN asset directory \"%s\" not found.", directory));
+
+	List<String> extensions;
+	ResourceLoader::get_recognized_extensions_for_type("Texture2D", &extensions);
+	HashSet<String> texture_extensions;
+	for (const String &extension : extensions) {
+		texture_extensions.insert(extension.to_lower());
+	}
+
+	for (const String &file : dir->get_files()) {
+		const String resource = file.trim_suffix(".remap").trim_suffix(".import");
+		if (texture_extensions.has(resource.get_extension().to_lower())) {
+			names[resource.get_basename()] = directory.path_join(resource);
+		}
+	}
+	return OK;
+}
+
+PackedStringArray VNAssetStreamer::get_asset_names(const StringName &p_category) const {
+	PackedStringArray result;
+	const HashMap<String, String> *names = categories.getptr(p_category);
+	if (names) {
+		for (const KeyValue<String, String> &E : *names) {
+			result.push_back(E.key);
+		}
+	}
+	return result;
+}
+
+String VNAssetStreamer::find_asset(const StringName &p_category, const String &p_name) const {
+	const HashMap<String, String> *names = categories.getptr(p_category);
+	if (names) {
+		const String *path = names->getptr(p_name);
+		if (path) {
+			return *path;
+		}
+	}
+	// Full paths are accepted as is.
+	if (p_name.contains("://") && ResourceLoader::exists(p_name)) {
+		return p_name;
+	}
+	return String();
+}
+
+bool VNAssetStreamer::has_asset(const StringName &p_category, const String &p_name) const {
+	return !find_asset(p_category, p_name).is_empty();
+}
+
+void VNAssetStreamer::set_command_category(const StringName &p_command, const StringName &p_category) {
+	if (p_category == StringName()) {
+		command_categories.erase(p_command);
+	} else {
+		command_categories[p_command] = p_category;
+	}
+}
+
+StringName VNAssetStreamer::get_command_category(const StringName &p_command) const {
+	const StringName *category = command_categories.getptr(p_command);
+	return category ? *category : StringName();
+}
+
+void VNAssetStreamer::prefetch(const StringName &p_category, const String &p_name) {
+	const String path = find_asset(p_category, p_name);
+	if (!path.is_empty()) {
+		_prefetch_path(path);
+	}
+}
+
+void VNAssetStreamer::prefetch_script(const Ref<VNScript> &p_script, int p_from_node, const Dictionary &p_variables) {
+	ERR_FAIL_COND(p_script.is_null());
+	if (p_from_node == VNScript::TARGET_END) {
+		return;
+	}
+	ERR_FAIL_INDEX(p_from_node, p_script->get_node_count());
+
+	// Walk the nodes the script can reach next, nearest first. Labels are
+	// resolved with the current variables, which is what the script will do
+	// unless a command changes them on the way.
+	LocalVector<int> queue;
+	HashSet<int> visited;
+	queue.push_back(p_from_node);
+	visited.insert(p_from_node);
+	for (uint32_t i = 0; i < queue.size() && i < (uint32_t)lookahead; i++) {
+		const int node = queue[i];
+		_prefetch_node(p_script, node);
+
+		const int choice_count = p_script->get_node_choice_count(node);
+		for (int j = 0; j <= choice_count; j++) {
+			int label;
+			if (j < choice_count) {
+				label = p_script->get_node_choice_target(node, j);
+			} else if (choice_count == 0) {
+				label = p_script->get_node_next(node);
+			} else {
+				break;
+			}
+			const int next = p_script->resolve_label(label, p_variables);
+			if (next != VNScript::TARGET_END && !visited.has(next)) {
+				visited.insert(next);
+				queue.push_back(next);
+			}
+		}
+	}
+}
+
+void VNAssetStreamer::poll() {
+	for (uint32_t i = 0; i < pending.size();) {
+		const String path = pending[i];
+		if (ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_IN_PROGRESS) {
+			i++;
+			continue;
+		}
+		pending.remove_at_unordered(i);
+		_finish_load(path, ResourceLoader::load_threaded_get(path));
+	}
+}
+
+Ref<Texture2D> VNAssetStreamer::get_texture(const StringName &p_category, const String &p_name) {
+	const String path = find_asset(p_category, p_name);
+	if (path.is_empty()) {
+		return Ref<Texture2D>();
+	}
+
+	Entry *entry = entries.getptr(path);
+	if (entry && !entry->pending) {
+		_touch(*entry);
+		return entry->texture;
+	}
+
+	if (entry) {
+		// Already loading; waiting for it is still cheaper than starting over.
+		pending.erase(path);
+		return _finish_load(path, ResourceLoader::load_threaded_get(path));
+	}
+	return _finish_load(path, ResourceLoader::load(path, "Texture2D"));
+}
+
+bool VNAssetStreamer::is_loaded(const StringName &p_category, const String &p_name) const {
+	const Entry *entry = entries.getptr(find_asset(p_category, p_name));
+	return entry && !entry->pending;
+}
+
+void VNAssetStreamer::clear_cache() {
+	// Threaded requests have to be collected, or the loader keeps them.
+	for (const String &path : pending) {
+		ResourceLoader::load_threaded_get(path);
+	}
+	pending.clear();
+	entries.clear();
+	lru.clear();
+	memory_usage = 0;
+}
+
+void VNAssetStreamer::set_memory_budget(int64_t p_bytes) {
+	ERR_FAIL_COND(p_bytes < 0);
+	memory_budget = p_bytes;
+	_evict();
+}
+
+void VNAssetStreamer::set_lookahead(int p_nodes) {
+	ERR_FAIL_COND(p_nodes < 1);
+	lookahead = p_nodes;
+}
+
+void VNAssetStreamer::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_directory", "category", "directory"), &VNAssetStreamer::add_directory);
+	ClassDB::bind_method(D_METHOD("get_asset_names", "category"), &VNAssetStreamer::get_asset_names);
+	ClassDB::bind_method(D_METHOD("find_asset", "category", "name"), &VNAssetStreamer::find_asset);
+	ClassDB::bind_method(D_METHOD("has_asset", "category", "name"), &VNAssetStreamer::has_asset);
+
+	ClassDB::bind_method(D_METHOD("set_command_category", "command", "category"), &VNAssetStreamer::set_command_category);
+	ClassDB::bind_method(D_METHOD("get_command_category", "command"), &VNAssetStreamer::get_command_category);
+
+	ClassDB::bind_method(D_METHOD("prefetch", "category", "name"), &VNAssetStreamer::prefetch);
+	ClassDB::bind_method(D_METHOD("prefetch_script", "script", "from_node", "variables"), &VNAssetStreamer::prefetch_script, DEFVAL(Dictionary()));
+	ClassDB::bind_method(D_METHOD("poll"), &VNAssetStreamer::poll);
+
+	ClassDB::bind_method(D_METHOD("get_texture", "category", "name"), &VNAssetStreamer::get_texture);
+	ClassDB::bind_method(D_METHOD("is_loaded", "category", "name"), &VNAssetStreamer::is_loaded);
+	ClassDB::bind_method(D_METHOD("clear_cache"), &VNAssetStreamer::clear_cache);
+
+	ClassDB::bind_method(D_METHOD("set_memory_budget", "bytes"), &VNAssetStreamer::set_memory_budget);
+	ClassDB::bind_method(D_METHOD("get_memory_budget"), &VNAssetStreamer::get_memory_budget);
+	ClassDB::bind_method(D_METHOD("get_memory_usage"), &VNAssetStreamer::get_memory_usage);
+	ClassDB::bind_method(D_METHOD("get_pending_count"), &VNAssetStreamer::get_pending_count);
+
+	ClassDB::bind_method(D_METHOD("set_lookahead", "nodes"), &VNAssetStreamer::set_lookahead);
+	ClassDB::bind_method(D_METHOD("get_lookahead"), &VNAssetStreamer::get_lookahead);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "memory_budget", PROPERTY_HINT_NONE, "suffix:B"), "set_memory_budget", "get_memory_budget");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lookahead", PROPERTY_HINT_RANGE, "1,64,1,or_greater"), "set_lookahead", "get_lookahead");
+}
+
+VNAssetStreamer::~VNAssetStreamer() {
+	for (const String &path : pending) {
+		ResourceLoader::load_threaded_get(path);
+	}
+}
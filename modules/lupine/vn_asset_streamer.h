@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  vn_asset_streamer.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "vn_script.h"
+
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/texture.h"
+
+// Streams the portraits and backgrounds a VNScript is about to show.
+// Asset names are resolved through a name -> path index per category, which
+// is precomputed at export time for projects with .vn scripts (see
+// VNAssetIndexExportPlugin) and otherwise built by listing directories. Upcoming commands are
+// read from the compiled script and their textures requested from the
+// threaded loader, and loaded textures are kept in an LRU within a memory
+// budget.
+class VNAssetStreamer : public RefCounted {
+	GDCLASS(VNAssetStreamer, RefCounted);
+
+public:
+	static constexpr const char *INDEX_PATH = "res://.vn_asset_index";
+	static constexpr uint32_t INDEX_VERSION = 1;
+
+private:
+	struct Entry {
+		Ref<Texture2D> texture;
+		uint64_t size = 0;
+		bool pending = false;
+		List<String>::Element *lru = nullptr;
+	};
+
+	HashMap<StringName, HashMap<String, String>> categories;
+	HashMap<StringName, StringName> command_categories;
+
+	HashMap<String, Entry> entries; // By path.
+	List<String> lru; // Most recently used first.
+	LocalVector<String> pending;
+
+	uint64_t memory_budget = 256 * 1024 * 1024;
+	uint64_t memory_usage = 0;
+	int lookahead = 8;
+
+	Dictionary export_index; // Directory -> name -> path, read on first use.
+	bool export_index_loaded = false;
+	bool has_export_index = false;
+
+	static uint64_t _get_texture_size(const Ref<Texture2D> &p_texture);
+	const Dictionary *_get_export_index();
+
+	void _touch(Entry &p_entry);
+	Ref<Texture2D> _finish_load(const String &p_path, const Ref<Resource> &p_resource);
+	void _evict();
+	void _prefetch_path(const String &p_path);
+	void _prefetch_node(const Ref<VNScript> &p_script, int p_node);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error add_directory(const StringName &p_category, const String &p_directory);
+	PackedStringArray get_asset_names(const StringName &p_category) const;
+	String find_asset(const StringName &p_category, const String &p_name) const;
+	bool has_asset(const StringName &p_category, const String &p_name) const;
+
+	void set_command_category(const StringName &p_command, const StringName &p_category);
+	StringName get_command_category(const StringName &p_command) const;
+
+	void prefetch(const StringName &p_category, const String &p_name);
+	void prefetch_script(const Ref<VNScript> &p_script, int p_from_node, const Dictionary &p_variables = Dictionary());
+	void poll();
+
+	Ref<Texture2D> get_texture(const StringName &p_category, const String &p_name);
+	bool is_loaded(const StringName &p_category, const String &p_name) const;
+	void clear_cache();
+
+	void set_memory_budget(int64_t p_bytes);
+	int64_t get_memory_budget() const { return memory_budget; }
+	int64_t get_memory_usage() const { return memory_usage; }
+	int get_pending_count() const { return pending.size(); }
+
+	void set_lookahead(int p_nodes);
+	int get_lookahead() const { return lookahead; }
+
+	~VNAssetStreamer();
+};
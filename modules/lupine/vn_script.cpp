@@ -0,0 +1,1243 @@
+/**************************************************************************/
+/*  vn_script.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "vn_script.h"
+
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/os/rw_lock.h"
+#include "core/templates/local_vector.h"
+
+static const char *VN_SCRIPT_MAGIC = "VNSC";
+
+/* Compiler */
+
+class VNScriptCompiler {
+	enum TokenType {
+		TK_WORD,
+		TK_CONSTANT,
+		TK_EQUAL,
+		TK_NOT_EQUAL,
+		TK_LESS,
+		TK_LESS_EQUAL,
+		TK_GREATER,
+		TK_GREATER_EQUAL,
+		TK_AND,
+		TK_OR,
+		TK_NOT,
+		TK_PAREN_OPEN,
+		TK_PAREN_CLOSE,
+		TK_EOF,
+		TK_ERROR,
+	};
+
+	struct Token {
+		TokenType type = TK_EOF;
+		Variant value;
+	};
+
+	struct PendingNode {
+		VNScript::NodeData data;
+		StringName label;
+		LocalVector<VNScript::CommandData> commands;
+		LocalVector<VNScript::ChoiceData> choices;
+		LocalVector<String> text_lines;
+		bool has_speaker = false;
+	};
+
+	struct PendingFunction {
+		VNScript::FunctionData data;
+		LocalVector<VNScript::CommandData> commands;
+	};
+
+	VNScript *script = nullptr;
+
+	HashMap<StringName, uint32_t> name_map;
+	HashMap<String, uint32_t> string_map;
+	HashMap<StringName, int> label_map;
+	LocalVector<LocalVector<uint32_t>> label_node_lists;
+	LocalVector<int> label_first_reference;
+	LocalVector<PendingFunction> functions;
+
+	// Condition tokenizer state.
+	Vector<Token> tokens;
+	int token_pos = 0;
+	int stack_depth = 0;
+	int max_stack_depth = 0;
+
+	String error;
+	int error_line = 0;
+
+	uint32_t _intern_name(const StringName &p_name) {
+		HashMap<StringName, uint32_t>::Iterator E = name_map.find(p_name);
+		if (E) {
+			return E->value;
+		}
+		uint32_t idx = script->names.size();
+		script->names.push_back(p_name);
+		name_map.insert(p_name, idx);
+		return idx;
+	}
+
+	uint32_t _intern_string(const String &p_string) {
+		HashMap<String, uint32_t>::Iterator E = string_map.find(p_string);
+		if (E) {
+			return E->value;
+		}
+		uint32_t idx = script->strings.size();
+		script->strings.push_back(p_string);
+		string_map.insert(p_string, idx);
+		return idx;
+	}
+
+	uint32_t _add_constant(const Variant &p_value) {
+		for (int i = 0; i < script->constants.size(); i++) {
+			if (script->constants[i].get_type() == p_value.get_type() && script->constants[i] == p_value) {
+				return i;
+			}
+		}
+		script->constants.push_back(p_value);
+		return script->constants.size() - 1;
+	}
+
+	int _reference_label(const StringName &p_label, int p_line) {
+		HashMap<StringName, int>::Iterator E = label_map.find(p_label);
+		if (E) {
+			return E->value;
+		}
+		int idx = label_node_lists.size();
+		label_map.insert(p_label, idx);
+		label_node_lists.push_back(LocalVector<uint32_t>());
+		label_first_reference.push_back(p_line);
+
+		VNScript::LabelData label;
+		label.name = _intern_name(p_label);
+		script->labels.push_back(label);
+		return idx;
+	}
+
+	int _parse_target(const String &p_target, int p_line) {
+		if (p_target == "end") {
+			return VNScript::TARGET_END;
+		}
+		return _reference_label(p_target, p_line);
+	}
+
+	void _set_error(const String &p_error, int p_line) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+		error_line = p_line;
+	}
+
+	static String _format_character_name(const String &p_name) {
+		// DamienWayne -> Damien Wayne.
+		String result;
+		for (int i = 0; i < p_name.length(); i++) {
+			char32_t c = p_name[i];
+			if (i > 0 && is_unicode_upper_case(c)) {
+				result += " ";
+			}
+			result += c;
+		}
+		return result;
+	}
+
+	VNScript::CommandData _parse_command(const String &p_command) {
+		VNScript::CommandData command;
+		String body = p_command.strip_edges();
+		int space = body.find_char(' ');
+		String name = space == -1 ? body : body.substr(0, space);
+		command.name = _intern_name(name);
+		if (space != -1) {
+			String text = body.substr(space + 1).strip_edges();
+			command.text = _intern_string(text);
+			Vector<String> args = text.split(" ", false);
+			command.arg_from = script->command_args.size();
+			command.arg_count = args.size();
+			for (const String &arg : args) {
+				script->command_args.push_back(_intern_string(arg));
+			}
+		}
+		return command;
+	}
+
+	/* Conditions */
+
+	static bool _is_word_char(char32_t p_char) {
+		switch (p_char) {
+			case '=':
+			case '!':
+			case '<':
+			case '>':
+			case '(':
+			case ')':
+			case '"':
+			case '\'':
+			case '&':
+			case '|':
+				return false;
+			default:
+				return !is_whitespace(p_char);
+		}
+	}
+
+	bool _tokenize(const String &p_condition) {
+		tokens.clear();
+		token_pos = 0;
+		int pos = 0;
+		const int len = p_condition.length();
+		while (pos < len) {
+			char32_t c = p_condition[pos];
+			char32_t n = pos + 1 < len ? p_condition[pos + 1] : 0;
+			Token tk;
+			if (is_whitespace(c)) {
+				pos++;
+				continue;
+			}
+			switch (c) {
+				case '(':
+					tk.type = TK_PAREN_OPEN;
+					pos++;
+					break;
+				case ')':
+					tk.type = TK_PAREN_CLOSE;
+					pos++;
+					break;
+				case '=':
+					tk.type = TK_EQUAL;
+					pos += n == '=' ? 2 : 1;
+					break;
+				case '!':
+					tk.type = n == '=' ? TK_NOT_EQUAL : TK_NOT;
+					pos += n == '=' ? 2 : 1;
+					break;
+				case '<':
+					tk.type = n == '=' ? TK_LESS_EQUAL : TK_LESS;
+					pos += n == '=' ? 2 : 1;
+					break;
+				case '>':
+					tk.type = n == '=' ? TK_GREATER_EQUAL : TK_GREATER;
+					pos += n == '=' ? 2 : 1;
+					break;
+				case '&':
+				case '|':
+					if (n != c) {
+						error = vformat("Unexpected '%s' in condition.", String::chr(c));
+						return false;
+					}
+					tk.type = c == '&' ? TK_AND : TK_OR;
+					pos += 2;
+					break;
+				case '"':
+				case '\'': {
+					int end = p_condition.find_char(c, pos + 1);
+					if (end == -1) {
+						error = "Unterminated string in condition.";
+						return false;
+					}
+					tk.type = TK_CONSTANT;
+					tk.value = p_condition.substr(pos + 1, end - pos - 1);
+					pos = end + 1;
+				} break;
+				default: {
+					int from = pos;
+					while (pos < len && _is_word_char(p_condition[pos])) {
+						pos++;
+					}
+					String word = p_condition.substr(from, pos - from);
+					if (word == "and") {
+						tk.type = TK_AND;
+					} else if (word == "or") {
+						tk.type = TK_OR;
+					} else if (word == "not") {
+						tk.type = TK_NOT;
+					} else if (word == "true" || word == "false") {
+						tk.type = TK_CONSTANT;
+						tk.value = word == "true";
+					} else if (word.is_valid_int()) {
+						tk.type = TK_CONSTANT;
+						tk.value = word.to_int();
+					} else if (word.is_valid_float()) {
+						tk.type = TK_CONSTANT;
+						tk.value = word.to_float();
+					} else {
+						tk.type = TK_WORD;
+						tk.value = word;
+					}
+				} break;
+			}
+			tokens.push_back(tk);
+		}
+		tokens.push_back(Token());
+		return true;
+	}
+
+	void _emit(uint32_t p_word) {
+		script->code.push_back(p_word);
+	}
+
+	void _push() {
+		stack_depth++;
+		max_stack_depth = MAX(max_stack_depth, stack_depth);
+	}
+
+	const Token &_peek() const {
+		return tokens[token_pos];
+	}
+
+	bool _parse_operand(bool p_as_literal) {
+		const Token &tk = tokens[token_pos];
+		if (tk.type != TK_EOF) {
+			token_pos++;
+		}
+		switch (tk.type) {
+			case TK_PAREN_OPEN: {
+				if (p_as_literal) {
+					return _fail("Expected a value.");
+				}
+				if (!_parse_or()) {
+					return false;
+				}
+				if (_peek().type != TK_PAREN_CLOSE) {
+					return _fail("Expected ')'.");
+				}
+				token_pos++;
+			} break;
+			case TK_WORD: {
+				if (p_as_literal) {
+					// Bare words on the right-hand side are string literals (`mood = good`).
+					_emit(VNScript::OP_PUSH_CONSTANT);
+					_emit(_add_constant(tk.value));
+				} else {
+					_emit(VNScript::OP_PUSH_VARIABLE);
+					_emit(_intern_name(tk.value));
+				}
+				_push();
+			} break;
+			case TK_CONSTANT: {
+				_emit(VNScript::OP_PUSH_CONSTANT);
+				_emit(_add_constant(tk.value));
+				_push();
+			} break;
+			default: {
+				return _fail("Expected a variable or value.");
+			}
+		}
+		return true;
+	}
+
+	bool _parse_comparison() {
+		if (!_parse_operand(false)) {
+			return false;
+		}
+		VNScript::Opcode op = VNScript::OP_MAX;
+		switch (_peek().type) {
+			case TK_EQUAL:
+				op = VNScript::OP_EQUAL;
+				break;
+			case TK_NOT_EQUAL:
+				op = VNScript::OP_NOT_EQUAL;
+				break;
+			case TK_LESS:
+				op = VNScript::OP_LESS;
+				break;
+			case TK_LESS_EQUAL:
+				op = VNScript::OP_LESS_EQUAL;
+				break;
+			case TK_GREATER:
+				op = VNScript::OP_GREATER;
+				break;
+			case TK_GREATER_EQUAL:
+				op = VNScript::OP_GREATER_EQUAL;
+				break;
+			default:
+				return true;
+		}
+		token_pos++;
+		if (!_parse_operand(true)) {
+			return false;
+		}
+		_emit(op);
+		stack_depth--;
+		return true;
+	}
+
+	bool _parse_not() {
+		if (_peek().type == TK_NOT) {
+			token_pos++;
+			if (!_parse_not()) {
+				return false;
+			}
+			_emit(VNScript::OP_NOT);
+			return true;
+		}
+		return _parse_comparison();
+	}
+
+	bool _parse_and() {
+		if (!_parse_not()) {
+			return false;
+		}
+		while (_peek().type == TK_AND) {
+			token_pos++;
+			if (!_parse_not()) {
+				return false;
+			}
+			_emit(VNScript::OP_AND);
+			stack_depth--;
+		}
+		return true;
+	}
+
+	bool _parse_or() {
+		if (!_parse_and()) {
+			return false;
+		}
+		while (_peek().type == TK_OR) {
+			token_pos++;
+			if (!_parse_and()) {
+				return false;
+			}
+			_emit(VNScript::OP_OR);
+			stack_depth--;
+		}
+		return true;
+	}
+
+	bool _fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+		return false;
+	}
+
+	void _close_node(PendingNode &p_node, int p_function) {
+		VNScript::NodeData &data = p_node.data;
+		data.function = p_function;
+		if (!p_node.text_lines.is_empty()) {
+			String text;
+			for (uint32_t i = 0; i < p_node.text_lines.size(); i++) {
+				if (i > 0) {
+					text += "\n";
+				}
+				text += p_node.text_lines[i];
+			}
+			data.text = _intern_string(text);
+		}
+		data.command_from = script->commands.size();
+		data.command_count = p_node.commands.size();
+		for (const VNScript::CommandData &command : p_node.commands) {
+			script->commands.push_back(command);
+		}
+		data.choice_from = script->choices.size();
+		data.choice_count = p_node.choices.size();
+		for (const VNScript::ChoiceData &choice : p_node.choices) {
+			script->choices.push_back(choice);
+		}
+
+		uint32_t node_index = script->nodes.size();
+		script->nodes.push_back(data);
+		label_node_lists[data.label].push_back(node_index);
+
+		if (p_function >= 0 && functions[p_function].data.entry == VNScript::TARGET_END) {
+			functions[p_function].data.entry = data.label;
+		}
+	}
+
+public:
+	int32_t compile_condition(const String &p_condition) {
+		stack_depth = 0;
+		max_stack_depth = 0;
+		if (!_tokenize(p_condition)) {
+			return -1;
+		}
+		int32_t offset = script->code.size();
+		if (!_parse_or()) {
+			return -1;
+		}
+		if (_peek().type != TK_EOF) {
+			_fail("Unexpected token after the end of the condition.");
+			return -1;
+		}
+		if (max_stack_depth > VNScript::MAX_STACK) {
+			_fail("Condition is too deeply nested.");
+			return -1;
+		}
+		_emit(VNScript::OP_END);
+		return offset;
+	}
+
+	String get_error() const { return error; }
+	int get_error_line() const { return error_line; }
+
+	Error compile(const String &p_source) {
+		Vector<String> lines = p_source.split("\n");
+		PendingNode node;
+		bool in_node = false;
+		int function = -1;
+
+		for (int i = 0; i <= lines.size(); i++) {
+			const int line_number = i + 1;
+			String line = i < lines.size() ? lines[i].strip_edges() : String();
+
+			if (in_node && line.is_empty()) {
+				_close_node(node, function);
+				in_node = false;
+				continue;
+			}
+			if (line.is_empty() || line.begins_with("#")) {
+				continue;
+			}
+
+			const bool is_command = line.begins_with("[[") && line.ends_with("]]");
+
+			if (!in_node) {
+				if (line.begins_with("FN ") || line.begins_with("FN:")) {
+					String name = line.substr(2).strip_edges().trim_prefix(":").strip_edges();
+					if (name.is_empty()) {
+						_set_error("Expected a function name after 'FN :'.", line_number);
+						return ERR_PARSE_ERROR;
+					}
+					PendingFunction pf;
+					pf.data.name = _intern_name(name);
+					functions.push_back(pf);
+					function = functions.size() - 1;
+				} else if (is_command) {
+					// Commands outside of a node run when the function is entered.
+					if (function >= 0) {
+						functions[function].commands.push_back(_parse_command(line.substr(2, line.length() - 4)));
+					}
+				} else {
+					node = PendingNode();
+					in_node = true;
+
+					String id = line;
+					int if_pos = line.find(" if ");
+					if (if_pos != -1) {
+						id = line.substr(0, if_pos).strip_edges();
+						node.data.condition = compile_condition(line.substr(if_pos + 4).strip_edges());
+						if (node.data.condition < 0) {
+							_set_error("Invalid condition.", line_number);
+							return ERR_PARSE_ERROR;
+						}
+					}
+					node.data.label = _reference_label(id, line_number);
+				}
+				continue;
+			}
+
+			if (is_command) {
+				node.commands.push_back(_parse_command(line.substr(2, line.length() - 4)));
+			} else if (line == "[end]") {
+				node.data.next = VNScript::TARGET_END;
+			} else if (line.begins_with("[") && line.ends_with("]")) {
+				String content = line.substr(1, line.length() - 2);
+				int bar = content.find_char('|');
+				if (bar != -1) {
+					VNScript::ChoiceData choice;
+					choice.text = _intern_string(content.substr(0, bar).strip_edges());
+					choice.target = _parse_target(content.substr(bar + 1).strip_edges(), line_number);
+					node.choices.push_back(choice);
+				} else {
+					node.data.next = _parse_target(content.strip_edges(), line_number);
+				}
+			} else if (!node.has_speaker) {
+				node.has_speaker = true;
+				int underscore = line.find_char('_');
+				String base = underscore == -1 ? line : line.substr(0, underscore);
+				node.data.speaker_id = _intern_name(line);
+				node.data.speaker = _intern_name(_format_character_name(base));
+				if (underscore != -1) {
+					node.data.emotion = _intern_name(line.substr(underscore + 1));
+				}
+			} else {
+				node.text_lines.push_back(line);
+			}
+		}
+
+		for (uint32_t i = 0; i < label_node_lists.size(); i++) {
+			if (label_node_lists[i].is_empty()) {
+				_set_error(vformat("Node \"%s\" is referenced but never defined.", script->names[script->labels[i].name]), label_first_reference[i]);
+				return ERR_PARSE_ERROR;
+			}
+			script->labels.write[i].node_from = script->label_nodes.size();
+			script->labels.write[i].node_count = label_node_lists[i].size();
+			for (uint32_t node_index : label_node_lists[i]) {
+				script->label_nodes.push_back(node_index);
+			}
+		}
+
+		for (PendingFunction &pf : functions) {
+			pf.data.command_from = script->commands.size();
+			pf.data.command_count = pf.commands.size();
+			for (const VNScript::CommandData &command : pf.commands) {
+				script->commands.push_back(command);
+			}
+			script->functions.push_back(pf.data);
+		}
+
+		return OK;
+	}
+
+	VNScriptCompiler(VNScript *p_script) {
+		script = p_script;
+	}
+};
+
+/* VNScript */
+
+void VNScript::_clear() {
+	names.clear();
+	strings.clear();
+	constants.clear();
+	nodes.clear();
+	commands.clear();
+	command_args.clear();
+	choices.clear();
+	labels.clear();
+	label_nodes.clear();
+	functions.clear();
+	code.clear();
+	label_map.clear();
+}
+
+void VNScript::_build_label_map() {
+	label_map.clear();
+	label_map.reserve(labels.size());
+	for (int i = 0; i < labels.size(); i++) {
+		label_map.insert(names[labels[i].name], i);
+	}
+}
+
+Error VNScript::_validate() const {
+	const uint32_t name_count = names.size();
+	const uint32_t string_count = strings.size();
+	const int32_t label_count = labels.size();
+
+#define VALIDATE_NAME(m_idx) ERR_FAIL_COND_V((m_idx) >= 0 && uint32_t(m_idx) >= name_count, ERR_FILE_CORRUPT)
+#define VALIDATE_STRING(m_idx) ERR_FAIL_COND_V((m_idx) >= 0 && uint32_t(m_idx) >= string_count, ERR_FILE_CORRUPT)
+#define VALIDATE_TARGET(m_idx) ERR_FAIL_COND_V((m_idx) != TARGET_END && ((m_idx) < 0 || (m_idx) >= label_count), ERR_FILE_CORRUPT)
+#define VALIDATE_RANGE(m_from, m_count, m_size) ERR_FAIL_COND_V(uint64_t(m_from) + uint64_t(m_count) > uint64_t(m_size), ERR_FILE_CORRUPT)
+
+	for (const uint32_t arg : command_args) {
+		VALIDATE_STRING(int64_t(arg));
+	}
+	for (const CommandData &command : commands) {
+		VALIDATE_NAME(int64_t(command.name));
+		VALIDATE_STRING(command.text);
+		VALIDATE_RANGE(command.arg_from, command.arg_count, command_args.size());
+	}
+	for (const ChoiceData &choice : choices) {
+		VALIDATE_STRING(choice.text);
+		VALIDATE_TARGET(choice.target);
+	}
+	for (const LabelData &label : labels) {
+		VALIDATE_NAME(int64_t(label.name));
+		VALIDATE_RANGE(label.node_from, label.node_count, label_nodes.size());
+	}
+	for (const uint32_t node : label_nodes) {
+		ERR_FAIL_COND_V(node >= uint32_t(nodes.size()), ERR_FILE_CORRUPT);
+	}
+	for (const FunctionData &function : functions) {
+		VALIDATE_NAME(int64_t(function.name));
+		VALIDATE_RANGE(function.command_from, function.command_count, commands.size());
+		VALIDATE_TARGET(function.entry);
+	}
+	for (const NodeData &node : nodes) {
+		ERR_FAIL_COND_V(node.label >= uint32_t(label_count), ERR_FILE_CORRUPT);
+		VALIDATE_NAME(node.speaker);
+		VALIDATE_NAME(node.speaker_id);
+		VALIDATE_NAME(node.emotion);
+		VALIDATE_STRING(node.text);
+		VALIDATE_RANGE(node.command_from, node.command_count, commands.size());
+		VALIDATE_RANGE(node.choice_from, node.choice_count, choices.size());
+		VALIDATE_TARGET(node.next);
+		ERR_FAIL_COND_V(node.function < -1 || node.function >= functions.size(), ERR_FILE_CORRUPT);
+
+		if (node.condition < 0) {
+			continue;
+		}
+
+		// Simulate the stack so that run_condition() can skip all checks.
+		int ip = node.condition;
+		int depth = 0;
+		while (true) {
+			ERR_FAIL_COND_V(ip >= code.size(), ERR_FILE_CORRUPT);
+			const uint32_t op = code[ip++];
+			ERR_FAIL_COND_V(op >= OP_MAX, ERR_FILE_CORRUPT);
+			if (op == OP_END) {
+				ERR_FAIL_COND_V(depth != 1, ERR_FILE_CORRUPT);
+				break;
+			}
+			if (op == OP_PUSH_VARIABLE || op == OP_PUSH_CONSTANT) {
+				ERR_FAIL_COND_V(ip >= code.size(), ERR_FILE_CORRUPT);
+				ERR_FAIL_COND_V(code[ip] >= uint32_t(op == OP_PUSH_VARIABLE ? names.size() : constants.size()), ERR_FILE_CORRUPT);
+				ip++;
+				depth++;
+				ERR_FAIL_COND_V(depth > MAX_STACK, ERR_FILE_CORRUPT);
+			} else if (op == OP_NOT) {
+				ERR_FAIL_COND_V(depth < 1, ERR_FILE_CORRUPT);
+			} else {
+				ERR_FAIL_COND_V(depth < 2, ERR_FILE_CORRUPT);
+				depth--;
+			}
+		}
+	}
+
+#undef VALIDATE_NAME
+#undef VALIDATE_STRING
+#undef VALIDATE_TARGET
+#undef VALIDATE_RANGE
+
+	return OK;
+}
+
+Error VNScript::compile(const String &p_source) {
+	_clear();
+	error_string = String();
+	error_line = 0;
+
+	VNScriptCompiler compiler(this);
+	Error err = compiler.compile(p_source);
+	if (err != OK) {
+		error_string = compiler.get_error();
+		error_line = compiler.get_error_line();
+		_clear();
+		return err;
+	}
+
+	_build_label_map();
+	emit_changed();
+	return OK;
+}
+
+bool VNScript::run_condition(int32_t p_offset, const Dictionary &p_variables) const {
+	if (p_offset < 0) {
+		return true;
+	}
+
+	static const Variant::Operator operators[] = {
+		Variant::OP_EQUAL,
+		Variant::OP_NOT_EQUAL,
+		Variant::OP_LESS,
+		Variant::OP_LESS_EQUAL,
+		Variant::OP_GREATER,
+		Variant::OP_GREATER_EQUAL,
+	};
+
+	Variant stack[MAX_STACK];
+	int sp = 0;
+	const uint32_t *ip = code.ptr() + p_offset;
+
+	while (true) {
+		const uint32_t op = *ip++;
+		switch (op) {
+			case OP_END: {
+				return stack[0].booleanize();
+			}
+			case OP_PUSH_VARIABLE: {
+				const Variant *value = p_variables.getptr(names[*ip++]);
+				stack[sp++] = value ? *value : Variant();
+			} break;
+			case OP_PUSH_CONSTANT: {
+				stack[sp++] = constants[*ip++];
+			} break;
+			case OP_EQUAL:
+			case OP_NOT_EQUAL:
+			case OP_LESS:
+			case OP_LESS_EQUAL:
+			case OP_GREATER:
+			case OP_GREATER_EQUAL: {
+				sp--;
+				Variant result;
+				bool valid = false;
+				Variant::evaluate(operators[op - OP_EQUAL], stack[sp - 1], stack[sp], result, valid);
+				stack[sp - 1] = valid && result.booleanize();
+			} break;
+			case OP_AND: {
+				sp--;
+				stack[sp - 1] = stack[sp - 1].booleanize() && stack[sp].booleanize();
+			} break;
+			case OP_OR: {
+				sp--;
+				stack[sp - 1] = stack[sp - 1].booleanize() || stack[sp].booleanize();
+			} break;
+			case OP_NOT: {
+				stack[sp - 1] = !stack[sp - 1].booleanize();
+			} break;
+			default: {
+				ERR_FAIL_V_MSG(false, "Invalid VNScript opcode.");
+			}
+		}
+	}
+}
+
+// Conditions given to evaluate_condition() are compiled once each, into one
+// shared script. It starts over once it holds MAX_CACHED_CONDITIONS, so
+// conditions built from changing text can't grow it forever.
+static const int MAX_CACHED_CONDITIONS = 256;
+static VNScript *condition_script = nullptr;
+static HashMap<String, int32_t> condition_offsets;
+static RWLock condition_lock;
+
+bool VNScript::evaluate_condition(const String &p_condition, const Dictionary &p_variables) {
+	{
+		RWLockRead read_lock(condition_lock);
+		const int32_t *offset = condition_offsets.getptr(p_condition);
+		if (offset) {
+			return condition_script->run_condition(*offset, p_variables);
+		}
+	}
+
+	RWLockWrite write_lock(condition_lock);
+	// Another thread may have compiled it meanwhile.
+	const int32_t *cached = condition_offsets.getptr(p_condition);
+	if (cached) {
+		return condition_script->run_condition(*cached, p_variables);
+	}
+
+	if (!condition_script) {
+		condition_script = memnew(VNScript);
+	} else if (condition_offsets.size() >= MAX_CACHED_CONDITIONS) {
+		condition_script->_clear();
+		condition_offsets.clear();
+	}
+	VNScriptCompiler compiler(condition_script);
+	const int32_t offset = compiler.compile_condition(p_condition);
+	ERR_FAIL_COND_V_MSG(offset < 0, false, vformat("Invalid condition \"%s\": %s", p_condition, compiler.get_error()));
+	condition_offsets.insert(p_condition, offset);
+	return condition_script->run_condition(offset, p_variables);
+}
+
+void VNScript::clear_condition_cache() {
+	RWLockWrite write_lock(condition_lock);
+	if (condition_script) {
+		memdelete(condition_script);
+		condition_script = nullptr;
+	}
+	condition_offsets.clear();
+}
+
+StringName VNScript::get_label_name(int p_label) const {
+	ERR_FAIL_INDEX_V(p_label, labels.size(), StringName());
+	return names[labels[p_label].name];
+}
+
+int VNScript::find_label(const StringName &p_label) const {
+	HashMap<StringName, int>::ConstIterator E = label_map.find(p_label);
+	return E ? E->value : TARGET_END;
+}
+
+int VNScript::resolve_label(int p_label, const Dictionary &p_variables) const {
+	if (p_label == TARGET_END) {
+		return TARGET_END;
+	}
+	ERR_FAIL_INDEX_V(p_label, labels.size(), TARGET_END);
+	const LabelData &label = labels[p_label];
+	for (uint32_t i = 0; i < label.node_count; i++) {
+		const uint32_t node = label_nodes[label.node_from + i];
+		if (run_condition(nodes[node].condition, p_variables)) {
+			return node;
+		}
+	}
+	return TARGET_END;
+}
+
+int VNScript::get_node_label(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node ? int(node->label) : TARGET_END;
+}
+
+bool VNScript::has_node_condition(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node && node->condition >= 0;
+}
+
+bool VNScript::evaluate_node_condition(int p_node, const Dictionary &p_variables) const {
+	const NodeData *node = _get_node(p_node);
+	return node && run_condition(node->condition, p_variables);
+}
+
+StringName VNScript::get_node_speaker(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node ? _get_name(node->speaker) : StringName();
+}
+
+StringName VNScript::get_node_speaker_id(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node ? _get_name(node->speaker_id) : StringName();
+}
+
+StringName VNScript::get_node_emotion(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node ? _get_name(node->emotion) : StringName();
+}
+
+String VNScript::get_node_text(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node ? _get_string(node->text) : String();
+}
+
+int VNScript::get_node_next(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node ? node->next : TARGET_END;
+}
+
+StringName VNScript::get_node_function(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node && node->function >= 0 ? names[functions[node->function].name] : StringName();
+}
+
+int VNScript::get_node_command_count(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node ? int(node->command_count) : 0;
+}
+
+StringName VNScript::get_node_command_name(int p_node, int p_command) const {
+	const NodeData *node = _get_node(p_node);
+	ERR_FAIL_NULL_V(node, StringName());
+	ERR_FAIL_INDEX_V(p_command, int(node->command_count), StringName());
+	return names[commands[node->command_from + p_command].name];
+}
+
+String VNScript::get_node_command_text(int p_node, int p_command) const {
+	const NodeData *node = _get_node(p_node);
+	ERR_FAIL_NULL_V(node, String());
+	ERR_FAIL_INDEX_V(p_command, int(node->command_count), String());
+	return _get_string(commands[node->command_from + p_command].text);
+}
+
+PackedStringArray VNScript::get_node_command_args(int p_node, int p_command) const {
+	const NodeData *node = _get_node(p_node);
+	ERR_FAIL_NULL_V(node, PackedStringArray());
+	ERR_FAIL_INDEX_V(p_command, int(node->command_count), PackedStringArray());
+	const CommandData &command = commands[node->command_from + p_command];
+	PackedStringArray args;
+	args.resize(command.arg_count);
+	String *w = args.ptrw();
+	for (uint32_t i = 0; i < command.arg_count; i++) {
+		w[i] = strings[command_args[command.arg_from + i]];
+	}
+	return args;
+}
+
+int VNScript::get_node_choice_count(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	return node ? int(node->choice_count) : 0;
+}
+
+String VNScript::get_node_choice_text(int p_node, int p_choice) const {
+	const NodeData *node = _get_node(p_node);
+	ERR_FAIL_NULL_V(node, String());
+	ERR_FAIL_INDEX_V(p_choice, int(node->choice_count), String());
+	return _get_string(choices[node->choice_from + p_choice].text);
+}
+
+int VNScript::get_node_choice_target(int p_node, int p_choice) const {
+	const NodeData *node = _get_node(p_node);
+	ERR_FAIL_NULL_V(node, TARGET_END);
+	ERR_FAIL_INDEX_V(p_choice, int(node->choice_count), TARGET_END);
+	return choices[node->choice_from + p_choice].target;
+}
+
+Array VNScript::get_node_choices(int p_node) const {
+	const NodeData *node = _get_node(p_node);
+	ERR_FAIL_NULL_V(node, Array());
+	Array ret;
+	ret.resize(node->choice_count);
+	for (uint32_t i = 0; i < node->choice_count; i++) {
+		const ChoiceData &choice = choices[node->choice_from + i];
+		Dictionary d;
+		d["text"] = _get_string(choice.text);
+		d["target"] = choice.target == TARGET_END ? StringName("end") : names[labels[choice.target].name];
+		d["target_label"] = choice.target;
+		ret[i] = d;
+	}
+	return ret;
+}
+
+StringName VNScript::get_function_name(int p_function) const {
+	ERR_FAIL_INDEX_V(p_function, functions.size(), StringName());
+	return names[functions[p_function].name];
+}
+
+int VNScript::get_function_entry(int p_function) const {
+	ERR_FAIL_INDEX_V(p_function, functions.size(), TARGET_END);
+	return functions[p_function].entry;
+}
+
+PackedStringArray VNScript::get_function_commands(int p_function) const {
+	ERR_FAIL_INDEX_V(p_function, functions.size(), PackedStringArray());
+	const FunctionData &function = functions[p_function];
+	PackedStringArray ret;
+	for (uint32_t i = 0; i < function.command_count; i++) {
+		const CommandData &command = commands[function.command_from + i];
+		String text = names[command.name];
+		if (command.text >= 0) {
+			text += " " + strings[command.text];
+		}
+		ret.push_back(text);
+	}
+	return ret;
+}
+
+/* Binary format */
+
+template <typename T>
+static void _store_table(Ref<FileAccess> p_file, const Vector<T> &p_table) {
+	static_assert(sizeof(T) % sizeof(uint32_t) == 0);
+	p_file->store_32(p_table.size());
+#ifdef BIG_ENDIAN_ENABLED
+	const uint32_t *words = reinterpret_cast<const uint32_t *>(p_table.ptr());
+	for (uint64_t i = 0; i < p_table.size() * sizeof(T) / sizeof(uint32_t); i++) {
+		p_file->store_32(words[i]);
+	}
+#else
+	p_file->store_buffer(reinterpret_cast<const uint8_t *>(p_table.ptr()), p_table.size() * sizeof(T));
+#endif
+}
+
+template <typename T>
+static Error _load_table(Ref<FileAccess> p_file, Vector<T> &r_table) {
+	static_assert(sizeof(T) % sizeof(uint32_t) == 0);
+	const uint64_t count = p_file->get_32();
+	ERR_FAIL_COND_V(count * sizeof(T) > p_file->get_length() - p_file->get_position(), ERR_FILE_CORRUPT);
+	r_table.resize(count);
+	// Tables are plain words, so a whole table is read in one go.
+	const uint64_t bytes = count * sizeof(T);
+	ERR_FAIL_COND_V(p_file->get_buffer(reinterpret_cast<uint8_t *>(r_table.ptrw()), bytes) != bytes, ERR_FILE_CORRUPT);
+#ifdef BIG_ENDIAN_ENABLED
+	uint32_t *words = reinterpret_cast<uint32_t *>(r_table.ptrw());
+	for (uint64_t i = 0; i < bytes / sizeof(uint32_t); i++) {
+		words[i] = BSWAP32(words[i]);
+	}
+#endif
+	return OK;
+}
+
+Error VNScript::save_compiled(const String &p_path) const {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot save VNScript file \"%s\".", p_path));
+
+	f->store_buffer(reinterpret_cast<const uint8_t *>(VN_SCRIPT_MAGIC), 4);
+	f->store_32(FORMAT_VERSION);
+
+	f->store_32(names.size());
+	for (const StringName &name : names) {
+		f->store_pascal_string(name);
+	}
+	f->store_32(strings.size());
+	for (const String &string : strings) {
+		f->store_pascal_string(string);
+	}
+	f->store_32(constants.size());
+	for (const Variant &constant : constants) {
+		int len = 0;
+		err = encode_variant(constant, nullptr, len);
+		ERR_FAIL_COND_V(err != OK, err);
+		Vector<uint8_t> buffer;
+		buffer.resize(len);
+		encode_variant(constant, buffer.ptrw(), len);
+		f->store_32(len);
+		f->store_buffer(buffer);
+	}
+
+	_store_table(f, nodes);
+	_store_table(f, commands);
+	_store_table(f, command_args);
+	_store_table(f, choices);
+	_store_table(f, labels);
+	_store_table(f, label_nodes);
+	_store_table(f, functions);
+	_store_table(f, code);
+
+	return f->get_error() == OK || f->get_error() == ERR_FILE_EOF ? OK : ERR_CANT_CREATE;
+}
+
+Error VNScript::load_compiled(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot open VNScript file \"%s\".", p_path));
+
+	uint8_t magic[4] = {};
+	f->get_buffer(magic, 4);
+	ERR_FAIL_COND_V_MSG(memcmp(magic, VN_SCRIPT_MAGIC, 4) != 0, ERR_FILE_UNRECOGNIZED, vformat("\"%s\" is not a compiled VNScript file.", p_path));
+	const uint32_t version = f->get_32();
+	ERR_FAIL_COND_V_MSG(version != FORMAT_VERSION, ERR_FILE_UNRECOGNIZED, vformat("Unsupported VNScript format version %d in \"%s\", reimport the source script.", version, p_path));
+
+	_clear();
+
+	const uint64_t remaining = f->get_length() - f->get_position();
+
+	uint32_t count = f->get_32();
+	ERR_FAIL_COND_V(count > remaining, ERR_FILE_CORRUPT);
+	names.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		names.write[i] = f->get_pascal_string();
+	}
+
+	count = f->get_32();
+	ERR_FAIL_COND_V(count > remaining, ERR_FILE_CORRUPT);
+	strings.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		strings.write[i] = f->get_pascal_string();
+	}
+
+	count = f->get_32();
+	ERR_FAIL_COND_V(count > remaining, ERR_FILE_CORRUPT);
+	constants.resize(count);
+	Vector<uint8_t> buffer;
+	for (uint32_t i = 0; i < count; i++) {
+		const uint32_t len = f->get_32();
+		ERR_FAIL_COND_V(len > remaining, ERR_FILE_CORRUPT);
+		buffer.resize(len);
+		ERR_FAIL_COND_V(f->get_buffer(buffer.ptrw(), len) != len, ERR_FILE_CORRUPT);
+		err = decode_variant(constants.write[i], buffer.ptr(), len);
+		ERR_FAIL_COND_V(err != OK, ERR_FILE_CORRUPT);
+	}
+
+	err = _load_table(f, nodes);
+	if (err == OK) {
+		err = _load_table(f, commands);
+	}
+	if (err == OK) {
+		err = _load_table(f, command_args);
+	}
+	if (err == OK) {
+		err = _load_table(f, choices);
+	}
+	if (err == OK) {
+		err = _load_table(f, labels);
+	}
+	if (err == OK) {
+		err = _load_table(f, label_nodes);
+	}
+	if (err == OK) {
+		err = _load_table(f, functions);
+	}
+	if (err == OK) {
+		err = _load_table(f, code);
+	}
+	if (err == OK) {
+		err = _validate();
+	}
+	if (err != OK) {
+		_clear();
+		ERR_FAIL_V_MSG(err, vformat("Corrupt VNScript file \"%s\".", p_path));
+	}
+
+	_build_label_map();
+	return OK;
+}
+
+void VNScript::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("compile", "source"), &VNScript::compile);
+	ClassDB::bind_method(D_METHOD("get_error_string"), &VNScript::get_error_string);
+	ClassDB::bind_method(D_METHOD("get_error_line"), &VNScript::get_error_line);
+	ClassDB::bind_static_method("VNScript", D_METHOD("evaluate_condition", "condition", "variables"), &VNScript::evaluate_condition);
+
+	ClassDB::bind_method(D_METHOD("get_label_count"), &VNScript::get_label_count);
+	ClassDB::bind_method(D_METHOD("get_label_name", "label"), &VNScript::get_label_name);
+	ClassDB::bind_method(D_METHOD("find_label", "label"), &VNScript::find_label);
+	ClassDB::bind_method(D_METHOD("resolve_label", "label", "variables"), &VNScript::resolve_label);
+
+	ClassDB::bind_method(D_METHOD("get_node_count"), &VNScript::get_node_count);
+	ClassDB::bind_method(D_METHOD("get_node_label", "node"), &VNScript::get_node_label);
+	ClassDB::bind_method(D_METHOD("has_node_condition", "node"), &VNScript::has_node_condition);
+	ClassDB::bind_method(D_METHOD("evaluate_node_condition", "node", "variables"), &VNScript::evaluate_node_condition);
+	ClassDB::bind_method(D_METHOD("get_node_speaker", "node"), &VNScript::get_node_speaker);
+	ClassDB::bind_method(D_METHOD("get_node_speaker_id", "node"), &VNScript::get_node_speaker_id);
+	ClassDB::bind_method(D_METHOD("get_node_emotion", "node"), &VNScript::get_node_emotion);
+	ClassDB::bind_method(D_METHOD("get_node_text", "node"), &VNScript::get_node_text);
+	ClassDB::bind_method(D_METHOD("get_node_next", "node"), &VNScript::get_node_next);
+	ClassDB::bind_method(D_METHOD("get_node_function", "node"), &VNScript::get_node_function);
+
+	ClassDB::bind_method(D_METHOD("get_node_command_count", "node"), &VNScript::get_node_command_count);
+	ClassDB::bind_method(D_METHOD("get_node_command_name", "node", "command"), &VNScript::get_node_command_name);
+	ClassDB::bind_method(D_METHOD("get_node_command_text", "node", "command"), &VNScript::get_node_command_text);
+	ClassDB::bind_method(D_METHOD("get_node_command_args", "node", "command"), &VNScript::get_node_command_args);
+
+	ClassDB::bind_method(D_METHOD("get_node_choice_count", "node"), &VNScript::get_node_choice_count);
+	ClassDB::bind_method(D_METHOD("get_node_choice_text", "node", "choice"), &VNScript::get_node_choice_text);
+	ClassDB::bind_method(D_METHOD("get_node_choice_target", "node", "choice"), &VNScript::get_node_choice_target);
+	ClassDB::bind_method(D_METHOD("get_node_choices", "node"), &VNScript::get_node_choices);
+
+	ClassDB::bind_method(D_METHOD("get_function_count"), &VNScript::get_function_count);
+	ClassDB::bind_method(D_METHOD("get_function_name", "function"), &VNScript::get_function_name);
+	ClassDB::bind_method(D_METHOD("get_function_entry", "function"), &VNScript::get_function_entry);
+	ClassDB::bind_method(D_METHOD("get_function_commands", "function"), &VNScript::get_function_commands);
+
+	BIND_CONSTANT(TARGET_END);
+}
+
+/* Loader and saver */
+
+Ref<Resource> ResourceFormatLoaderVNScript::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
+	Ref<VNScript> script;
+	script.instantiate();
+	Error err = script->load_compiled(p_path);
+	if (r_error) {
+		*r_error = err;
+	}
+	if (err != OK) {
+		return Ref<Resource>();
+	}
+	return script;
+}
+
+void ResourceFormatLoaderVNScript::get_recognized_extensions(List<String> *p_extensions) const {
+	p_extensions->push_back("vnscript");
+}
+
+bool ResourceFormatLoaderVNScript::handles_type(const String &p_type) const {
+	return p_type == "VNScript";
+}
+
+String ResourceFormatLoaderVNScript::get_resource_type(const String &p_path) const {
+	return p_path.get_extension().to_lower() == "vnscript" ? "VNScript" : "";
+}
+
+Error ResourceFormatSaverVNScript::save(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags) {
+	Ref<VNScript> script = p_resource;
+	ERR_FAIL_COND_V(script.is_null(), ERR_INVALID_PARAMETER);
+	return script->save_compiled(p_path);
+}
+
+void ResourceFormatSaverVNScript::get_recognized_extensions(const Ref<Resource> &p_resource, List<String> *p_extensions) const {
+	if (Object::cast_to<VNScript>(*p_resource)) {
+		p_extensions->push_back("vnscript");
+	}
+}
+
+bool ResourceFormatSaverVNScript::recognize(const Ref<Resource> &p_resource) const {
+	return Object::cast_to<VNScript>(*p_resource) != nullptr;
+}
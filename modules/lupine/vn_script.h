@@ -0,0 +1,211 @@
+/**************************************************************************/
+/*  vn_script.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/resource.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/dictionary.h"
+
+// Compiled form of a `.vn` visual novel script.
+// Source text is compiled once (at import time in the editor) into flat tables:
+// names are interned as StringName, node labels are resolved to indices and
+// `if` conditions are lowered to a small stack bytecode, so that running a
+// script never touches the source text again.
+class VNScript : public Resource {
+	GDCLASS(VNScript, Resource);
+	RES_BASE_EXTENSION("vnscript");
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 1;
+	static constexpr int MAX_STACK = 16;
+
+	enum {
+		TARGET_END = -1,
+	};
+
+	enum Opcode : uint32_t {
+		OP_END,
+		OP_PUSH_VARIABLE, // Operand: name index.
+		OP_PUSH_CONSTANT, // Operand: constant index.
+		OP_EQUAL,
+		OP_NOT_EQUAL,
+		OP_LESS,
+		OP_LESS_EQUAL,
+		OP_GREATER,
+		OP_GREATER_EQUAL,
+		OP_AND,
+		OP_OR,
+		OP_NOT,
+		OP_MAX,
+	};
+
+	// All tables are made of 32-bit words only, so they can be stored and
+	// loaded as raw blocks.
+	struct NodeData {
+		uint32_t label = 0;
+		int32_t condition = -1; // Offset into `code`.
+		int32_t speaker = -1; // Display name (name index).
+		int32_t speaker_id = -1; // Raw speaker token, e.g. `Char2_happy` (name index).
+		int32_t emotion = -1; // Name index.
+		int32_t text = -1; // String index.
+		uint32_t command_from = 0;
+		uint32_t command_count = 0;
+		uint32_t choice_from = 0;
+		uint32_t choice_count = 0;
+		int32_t next = TARGET_END; // Label index.
+		int32_t function = -1; // Function index.
+	};
+
+	struct CommandData {
+		uint32_t name = 0; // Name index.
+		int32_t text = -1; // Everything after the command name (string index).
+		uint32_t arg_from = 0; // Offset into `command_args`.
+		uint32_t arg_count = 0;
+	};
+
+	struct ChoiceData {
+		int32_t text = -1; // String index.
+		int32_t target = TARGET_END; // Label index.
+	};
+
+	struct LabelData {
+		uint32_t name = 0; // Name index.
+		uint32_t node_from = 0; // Offset into `label_nodes`.
+		uint32_t node_count = 0;
+	};
+
+	struct FunctionData {
+		uint32_t name = 0; // Name index.
+		uint32_t command_from = 0; // Commands declared before the first node.
+		uint32_t command_count = 0;
+		int32_t entry = TARGET_END; // Label index of the first node.
+	};
+
+private:
+	Vector<StringName> names;
+	Vector<String> strings;
+	Vector<Variant> constants;
+	Vector<NodeData> nodes;
+	Vector<CommandData> commands;
+	Vector<uint32_t> command_args;
+	Vector<ChoiceData> choices;
+	Vector<LabelData> labels;
+	Vector<uint32_t> label_nodes;
+	Vector<FunctionData> functions;
+	Vector<uint32_t> code;
+
+	HashMap<StringName, int> label_map;
+
+	String error_string;
+	int error_line = 0;
+
+	void _clear();
+	void _build_label_map();
+	Error _validate() const;
+
+	_FORCE_INLINE_ const NodeData *_get_node(int p_node) const {
+		ERR_FAIL_INDEX_V(p_node, nodes.size(), nullptr);
+		return &nodes[p_node];
+	}
+	_FORCE_INLINE_ StringName _get_name(int32_t p_index) const {
+		return p_index < 0 ? StringName() : names[p_index];
+	}
+	_FORCE_INLINE_ String _get_string(int32_t p_index) const {
+		return p_index < 0 ? String() : strings[p_index];
+	}
+
+	friend class VNScriptCompiler;
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error compile(const String &p_source);
+	String get_error_string() const { return error_string; }
+	int get_error_line() const { return error_line; }
+
+	Error load_compiled(const String &p_path);
+	Error save_compiled(const String &p_path) const;
+
+	bool run_condition(int32_t p_offset, const Dictionary &p_variables) const;
+	// Compiles each distinct condition once and keeps it for later calls.
+	static bool evaluate_condition(const String &p_condition, const Dictionary &p_variables);
+	// Frees the conditions kept by evaluate_condition(), called when the module is uninitialized.
+	static void clear_condition_cache();
+
+	int get_label_count() const { return labels.size(); }
+	StringName get_label_name(int p_label) const;
+	int find_label(const StringName &p_label) const;
+	int resolve_label(int p_label, const Dictionary &p_variables) const;
+
+	int get_node_count() const { return nodes.size(); }
+	int get_node_label(int p_node) const;
+	bool has_node_condition(int p_node) const;
+	bool evaluate_node_condition(int p_node, const Dictionary &p_variables) const;
+	StringName get_node_speaker(int p_node) const;
+	StringName get_node_speaker_id(int p_node) const;
+	StringName get_node_emotion(int p_node) const;
+	String get_node_text(int p_node) const;
+	int get_node_next(int p_node) const;
+	StringName get_node_function(int p_node) const;
+
+	int get_node_command_count(int p_node) const;
+	StringName get_node_command_name(int p_node, int p_command) const;
+	String get_node_command_text(int p_node, int p_command) const;
+	PackedStringArray get_node_command_args(int p_node, int p_command) const;
+
+	int get_node_choice_count(int p_node) const;
+	String get_node_choice_text(int p_node, int p_choice) const;
+	int get_node_choice_target(int p_node, int p_choice) const;
+	Array get_node_choices(int p_node) const;
+
+	int get_function_count() const { return functions.size(); }
+	StringName get_function_name(int p_function) const;
+	int get_function_entry(int p_function) const;
+	PackedStringArray get_function_commands(int p_function) const;
+};
+
+class ResourceFormatLoaderVNScript : public ResourceFormatLoader {
+public:
+	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
+	virtual bool handles_type(const String &p_type) const override;
+	virtual String get_resource_type(const String &p_path) const override;
+};
+
+class ResourceFormatSaverVNScript : public ResourceFormatSaver {
+public:
+	virtual Error save(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags = 0) override;
+	virtual void get_recognized_extensions(const Ref<Resource> &p_resource, List<String> *p_extensions) const override;
+	virtual bool recognize(const Ref<Resource> &p_resource) const override;
+};
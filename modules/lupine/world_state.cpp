@@ -0,0 +1,473 @@
+/**************************************************************************/
+/*  world_state.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "world_state.h"
+
+WorldState *WorldState::singleton = nullptr;
+
+static const char *flag_names_by_category[WorldState::FLAG_MAX] = {
+	"location_discovered",
+	"puzzle_completed",
+	"trigger_activated",
+	"item_collected",
+};
+
+WorldState *WorldState::get_singleton() {
+	return singleton;
+}
+
+uint32_t WorldState::_intern_flag(const StringName &p_id) {
+	const uint32_t *index = flag_indices.getptr(p_id);
+	if (index) {
+		return *index;
+	}
+	const uint32_t new_index = flag_names.size();
+	flag_indices.insert_new(p_id, new_index);
+	flag_names.push_back(p_id);
+	return new_index;
+}
+
+void WorldState::_set_flag_bit(Flag p_flag, uint32_t p_index, bool p_enabled) {
+	LocalVector<uint64_t> &bits = flag_bits[p_flag];
+	const uint32_t word = p_index >> 6;
+	if (word >= bits.size()) {
+		const uint32_t old_size = bits.size();
+		bits.resize(word + 1);
+		memset(bits.ptr() + old_size, 0, (word + 1 - old_size) * sizeof(uint64_t));
+	}
+	if (p_enabled) {
+		bits[word] |= uint64_t(1) << (p_index & 63);
+	} else {
+		bits[word] &= ~(uint64_t(1) << (p_index & 63));
+	}
+}
+
+void WorldState::_record(int p_category, const StringName &p_key, const Variant &p_old, const Variant &p_new) {
+	if (journal_capacity == 0) {
+		return;
+	}
+	if (journal.size() != journal_capacity) {
+		journal.resize(journal_capacity);
+	}
+
+	Change &change = journal[journal_serial % journal_capacity];
+	change.serial = ++journal_serial;
+	change.category = p_category;
+	change.key = p_key;
+	change.old_value = p_old;
+	change.new_value = p_new;
+}
+
+void WorldState::set_variable(const StringName &p_name, const Variant &p_value) {
+	Variant *value = variables.getptr(p_name);
+	Variant old_value;
+	if (value) {
+		// Containers may have been modified in place, so always report them.
+		const Variant::Type type = value->get_type();
+		if (type == p_value.get_type() && type != Variant::ARRAY && type != Variant::DICTIONARY && *value == p_value) {
+			return;
+		}
+		old_value = *value;
+		*value = p_value;
+	} else {
+		variables.insert_new(p_name, p_value);
+	}
+
+	_record(CHANGE_VARIABLE, p_name, old_value, p_value);
+	emit_signal(SNAME("variable_changed"), p_name, old_value, p_value);
+}
+
+Variant WorldState::get_variable(const StringName &p_name, const Variant &p_default) const {
+	const Variant *value = variables.getptr(p_name);
+	return value ? *value : p_default;
+}
+
+bool WorldState::has_variable(const StringName &p_name) const {
+	return variables.has(p_name);
+}
+
+void WorldState::erase_variable(const StringName &p_name) {
+	const Variant *value = variables.getptr(p_name);
+	if (!value) {
+		return;
+	}
+	const Variant old_value = *value;
+	variables.erase(p_name);
+
+	_record(CHANGE_VARIABLE, p_name, old_value, Variant());
+	emit_signal(SNAME("variable_changed"), p_name, old_value, Variant());
+}
+
+void WorldState::increment_variable(const StringName &p_name, double p_amount) {
+	const Variant *value = variables.getptr(p_name);
+	if (!value) {
+		set_variable(p_name, p_amount);
+		return;
+	}
+
+	Variant result;
+	bool valid = false;
+	Variant::evaluate(Variant::OP_ADD, *value, p_amount, result, valid);
+	ERR_FAIL_COND_MSG(!valid, vformat("World variable \"%s\" is not a number.", p_name));
+	set_variable(p_name, result);
+}
+
+PackedStringArray WorldState::get_variable_names() const {
+	PackedStringArray names;
+	names.resize(variables.size());
+	String *w = names.ptrw();
+	int i = 0;
+	for (const KeyValue<StringName, Variant> &E : variables) {
+		w[i++] = E.key;
+	}
+	return names;
+}
+
+bool WorldState::set_flag(Flag p_flag, const StringName &p_id, bool p_enabled) {
+	ERR_FAIL_INDEX_V(p_flag, FLAG_MAX, false);
+
+	const uint32_t index = _intern_flag(p_id);
+	if (_has_flag(p_flag, index) == p_enabled) {
+		return false;
+	}
+
+	_set_flag_bit(p_flag, index, p_enabled);
+
+	_record(p_flag, p_id, !p_enabled, p_enabled);
+	emit_signal(SNAME("flag_changed"), p_flag, p_id, p_enabled);
+	return true;
+}
+
+bool WorldState::has_flag(Flag p_flag, const StringName &p_id) const {
+	ERR_FAIL_INDEX_V(p_flag, FLAG_MAX, false);
+	const uint32_t *index = flag_indices.getptr(p_id);
+	return index && _has_flag(p_flag, *index);
+}
+
+PackedStringArray WorldState::get_flags(Flag p_flag) const {
+	ERR_FAIL_INDEX_V(p_flag, FLAG_MAX, PackedStringArray());
+	PackedStringArray ids;
+	const LocalVector<uint64_t> &bits = flag_bits[p_flag];
+	for (uint32_t word = 0; word < bits.size(); word++) {
+		const uint64_t mask = bits[word];
+		if (mask == 0) {
+			continue;
+		}
+		for (uint32_t bit = 0; bit < 64; bit++) {
+			if (mask & (uint64_t(1) << bit)) {
+				ids.push_back(flag_names[(word << 6) + bit]);
+			}
+		}
+	}
+	return ids;
+}
+
+int WorldState::get_flag_count(Flag p_flag) const {
+	ERR_FAIL_INDEX_V(p_flag, FLAG_MAX, 0);
+	int count = 0;
+	for (uint64_t word : flag_bits[p_flag]) {
+		for (; word; word &= word - 1) {
+			count++;
+		}
+	}
+	return count;
+}
+
+void WorldState::_compile_node(WorldStateCondition *p_condition, const Variant &p_source) {
+	const uint32_t node_index = p_condition->nodes.size();
+	p_condition->nodes.push_back(WorldStateCondition::Node());
+
+	if (p_source.get_type() == Variant::ARRAY) {
+		// A list of conditions which all have to pass, as used by triggers.
+		const Array conditions = p_source;
+		p_condition->nodes[node_index].type = WorldStateCondition::NODE_AND;
+		for (const Variant &condition : conditions) {
+			_compile_node(p_condition, condition);
+		}
+		p_condition->nodes[node_index].end = p_condition->nodes.size();
+		return;
+	}
+
+	WorldStateCondition::Node node;
+	if (p_source.get_type() != Variant::DICTIONARY) {
+		ERR_PRINT(vformat("Invalid world state condition: %s.", p_source));
+		p_condition->nodes[node_index].end = node_index + 1;
+		return;
+	}
+
+	const Dictionary condition = p_source;
+	const String type = condition.get("type", String());
+	static const char *flag_types[FLAG_MAX][2] = {
+		{ "location", "location" },
+		{ "puzzle", "puzzle_id" },
+		{ "trigger", "trigger_id" },
+		{ "item", "item_id" },
+	};
+
+	if (type == "variable") {
+		static const char *operators[] = { "==", "!=", "<", "<=", ">", ">=" };
+		static const Variant::Operator variant_operators[] = { Variant::OP_EQUAL, Variant::OP_NOT_EQUAL, Variant::OP_LESS, Variant::OP_LESS_EQUAL, Variant::OP_GREATER, Variant::OP_GREATER_EQUAL };
+
+		node.type = WorldStateCondition::NODE_VARIABLE;
+		node.variable = condition.get("variable", String());
+		node.value = condition.get("value", Variant());
+		const String op = condition.get("operator", "==");
+		bool found = false;
+		for (int i = 0; i < 6; i++) {
+			if (op == operators[i]) {
+				node.op = variant_operators[i];
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			ERR_PRINT(vformat("Unknown world state condition operator \"%s\".", op));
+			node.type = WorldStateCondition::NODE_CONSTANT;
+		}
+	} else if (type == "and" || type == "or") {
+		p_condition->nodes[node_index].type = type == "and" ? WorldStateCondition::NODE_AND : WorldStateCondition::NODE_OR;
+		const Array conditions = condition.get("conditions", Array());
+		for (const Variant &child : conditions) {
+			_compile_node(p_condition, child);
+		}
+		p_condition->nodes[node_index].end = p_condition->nodes.size();
+		return;
+	} else if (type == "not") {
+		p_condition->nodes[node_index].type = WorldStateCondition::NODE_NOT;
+		_compile_node(p_condition, condition.get("condition", Variant()));
+		p_condition->nodes[node_index].end = p_condition->nodes.size();
+		return;
+	} else {
+		bool found = false;
+		for (int i = 0; i < FLAG_MAX; i++) {
+			if (type == flag_types[i][0]) {
+				node.type = WorldStateCondition::NODE_FLAG;
+				node.flag = i;
+				node.index = _intern_flag(condition.get(flag_types[i][1], String()));
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			ERR_PRINT(vformat("Unknown world state condition type \"%s\".", type));
+		}
+	}
+
+	node.end = node_index + 1;
+	p_condition->nodes[node_index] = node;
+}
+
+bool WorldState::_evaluate_node(const WorldStateCondition *p_condition, uint32_t p_index) const {
+	const WorldStateCondition::Node &node = p_condition->nodes[p_index];
+	switch (node.type) {
+		case WorldStateCondition::NODE_CONSTANT: {
+			return node.index != 0;
+		}
+		case WorldStateCondition::NODE_VARIABLE: {
+			const Variant *value = variables.getptr(node.variable);
+			Variant result;
+			bool valid = false;
+			Variant::evaluate(node.op, value ? *value : Variant(), node.value, result, valid);
+			return valid && result.booleanize();
+		}
+		case WorldStateCondition::NODE_FLAG: {
+			return _has_flag(Flag(node.flag), node.index);
+		}
+		case WorldStateCondition::NODE_AND: {
+			for (uint32_t i = p_index + 1; i < node.end; i = p_condition->nodes[i].end) {
+				if (!_evaluate_node(p_condition, i)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case WorldStateCondition::NODE_OR: {
+			for (uint32_t i = p_index + 1; i < node.end; i = p_condition->nodes[i].end) {
+				if (_evaluate_node(p_condition, i)) {
+					return true;
+				}
+			}
+			return false;
+		}
+		case WorldStateCondition::NODE_NOT: {
+			return p_index + 1 < node.end && !_evaluate_node(p_condition, p_index + 1);
+		}
+	}
+	return false;
+}
+
+Ref<WorldStateCondition> WorldState::compile_condition(const Variant &p_condition) {
+	Ref<WorldStateCondition> condition;
+	condition.instantiate();
+	_compile_node(condition.ptr(), p_condition);
+	return condition;
+}
+
+bool WorldState::evaluate(const Ref<WorldStateCondition> &p_condition) const {
+	ERR_FAIL_COND_V(p_condition.is_null(), false);
+	ERR_FAIL_COND_V(p_condition->nodes.is_empty(), false);
+	return _evaluate_node(p_condition.ptr(), 0);
+}
+
+bool WorldState::check_condition(const Variant &p_condition) {
+	return evaluate(compile_condition(p_condition));
+}
+
+void WorldState::set_journal_capacity(int p_capacity) {
+	ERR_FAIL_COND(p_capacity < 0);
+	journal_capacity = p_capacity;
+	// Ring positions depend on the capacity, so older changes are dropped.
+	journal.clear();
+}
+
+int WorldState::get_journal_capacity() const {
+	return journal_capacity;
+}
+
+uint64_t WorldState::get_journal_serial() const {
+	return journal_serial;
+}
+
+Array WorldState::get_changes_since(uint64_t p_serial) const {
+	Array changes;
+	if (journal.is_empty() || p_serial >= journal_serial) {
+		return changes;
+	}
+
+	uint64_t first = p_serial + 1;
+	if (journal_serial - p_serial > journal_capacity) {
+		first = journal_serial - journal_capacity + 1;
+	}
+	for (uint64_t serial = first; serial <= journal_serial; serial++) {
+		const Change &change = journal[(serial - 1) % journal_capacity];
+		if (change.serial != serial) {
+			continue; // Dropped by a capacity change or clear().
+		}
+		Dictionary entry;
+		entry["serial"] = change.serial;
+		entry["key"] = change.key;
+		entry["flag"] = change.category;
+		entry["old_value"] = change.old_value;
+		entry["new_value"] = change.new_value;
+		changes.push_back(entry);
+	}
+	return changes;
+}
+
+Dictionary WorldState::get_state() const {
+	Dictionary state;
+	Dictionary variable_state;
+	for (const KeyValue<StringName, Variant> &E : variables) {
+		variable_state[E.key] = E.value;
+	}
+	state["variables"] = variable_state;
+	for (int i = 0; i < FLAG_MAX; i++) {
+		state[flag_names_by_category[i]] = get_flags(Flag(i));
+	}
+	return state;
+}
+
+void WorldState::set_state(const Dictionary &p_state) {
+	variables.clear();
+	const Dictionary variable_state = p_state.get("variables", Dictionary());
+	variables.reserve(variable_state.size());
+	for (const KeyValue<Variant, Variant> &kv : variable_state) {
+		variables.insert(kv.key, kv.value);
+	}
+
+	for (int i = 0; i < FLAG_MAX; i++) {
+		flag_bits[i].clear();
+		const PackedStringArray ids = p_state.get(flag_names_by_category[i], PackedStringArray());
+		for (const String &id : ids) {
+			_set_flag_bit(Flag(i), _intern_flag(id), true);
+		}
+	}
+
+	journal.clear();
+	emit_signal(SNAME("state_reset"));
+}
+
+void WorldState::clear() {
+	variables.clear();
+	// Flag indices are kept, compiled conditions still refer to them.
+	for (int i = 0; i < FLAG_MAX; i++) {
+		flag_bits[i].clear();
+	}
+	journal.clear();
+	emit_signal(SNAME("state_reset"));
+}
+
+void WorldState::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_variable", "name", "value"), &WorldState::set_variable);
+	ClassDB::bind_method(D_METHOD("get_variable", "name", "default"), &WorldState::get_variable, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("has_variable", "name"), &WorldState::has_variable);
+	ClassDB::bind_method(D_METHOD("erase_variable", "name"), &WorldState::erase_variable);
+	ClassDB::bind_method(D_METHOD("increment_variable", "name", "amount"), &WorldState::increment_variable, DEFVAL(1.0));
+	ClassDB::bind_method(D_METHOD("get_variable_names"), &WorldState::get_variable_names);
+
+	ClassDB::bind_method(D_METHOD("set_flag", "flag", "id", "enabled"), &WorldState::set_flag, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("has_flag", "flag", "id"), &WorldState::has_flag);
+	ClassDB::bind_method(D_METHOD("get_flags", "flag"), &WorldState::get_flags);
+	ClassDB::bind_method(D_METHOD("get_flag_count", "flag"), &WorldState::get_flag_count);
+
+	ClassDB::bind_method(D_METHOD("compile_condition", "condition"), &WorldState::compile_condition);
+	ClassDB::bind_method(D_METHOD("evaluate", "condition"), &WorldState::evaluate);
+	ClassDB::bind_method(D_METHOD("check_condition", "condition"), &WorldState::check_condition);
+
+	ClassDB::bind_method(D_METHOD("set_journal_capacity", "capacity"), &WorldState::set_journal_capacity);
+	ClassDB::bind_method(D_METHOD("get_journal_capacity"), &WorldState::get_journal_capacity);
+	ClassDB::bind_method(D_METHOD("get_journal_serial"), &WorldState::get_journal_serial);
+	ClassDB::bind_method(D_METHOD("get_changes_since", "serial"), &WorldState::get_changes_since);
+
+	ClassDB::bind_method(D_METHOD("get_state"), &WorldState::get_state);
+	ClassDB::bind_method(D_METHOD("set_state", "state"), &WorldState::set_state);
+	ClassDB::bind_method(D_METHOD("clear"), &WorldState::clear);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "journal_capacity", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), "set_journal_capacity", "get_journal_capacity");
+
+	ADD_SIGNAL(MethodInfo("variable_changed", PropertyInfo(Variant::STRING_NAME, "name"), PropertyInfo(Variant::NIL, "old_value", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT), PropertyInfo(Variant::NIL, "new_value", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT)));
+	ADD_SIGNAL(MethodInfo("flag_changed", PropertyInfo(Variant::INT, "flag", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_CLASS_IS_ENUM, "WorldState.Flag"), PropertyInfo(Variant::STRING_NAME, "id"), PropertyInfo(Variant::BOOL, "enabled")));
+	ADD_SIGNAL(MethodInfo("state_reset"));
+
+	BIND_ENUM_CONSTANT(FLAG_LOCATION_DISCOVERED);
+	BIND_ENUM_CONSTANT(FLAG_PUZZLE_COMPLETED);
+	BIND_ENUM_CONSTANT(FLAG_TRIGGER_ACTIVATED);
+	BIND_ENUM_CONSTANT(FLAG_ITEM_COLLECTED);
+	BIND_ENUM_CONSTANT(FLAG_MAX);
+	BIND_CONSTANT(CHANGE_VARIABLE);
+}
+
+WorldState::WorldState() {
+	singleton = this;
+}
+
+WorldState::~WorldState() {
+	singleton = nullptr;
+}
@@ -0,0 +1,159 @@
+/**************************************************************************/
+/*  world_state.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/class_db.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+
+class WorldState;
+
+// A world state condition compiled into a flat, pre-order expression tree.
+// Variable names and flag ids are resolved when compiling, so evaluating it
+// only does hash lookups for variables and bit tests for flags.
+class WorldStateCondition : public RefCounted {
+	GDCLASS(WorldStateCondition, RefCounted);
+
+	friend class WorldState;
+
+	enum NodeType : uint8_t {
+		NODE_CONSTANT,
+		NODE_VARIABLE,
+		NODE_FLAG,
+		NODE_AND,
+		NODE_OR,
+		NODE_NOT,
+	};
+
+	struct Node {
+		NodeType type = NODE_CONSTANT;
+		uint8_t flag = 0;
+		Variant::Operator op = Variant::OP_EQUAL;
+		uint32_t end = 0; // Index past this node's subtree.
+		uint32_t index = 0; // Flag index, or constant value.
+		StringName variable;
+		Variant value;
+	};
+
+	LocalVector<Node> nodes;
+
+protected:
+	static void _bind_methods() {}
+};
+
+// Engine-wide store for persistent world variables and flags.
+// Flags (discovered locations, collected items, ...) are interned to dense
+// indices and kept in one bitset per category. Every change is recorded in a
+// bounded journal, which save systems and UI can poll with
+// get_changes_since() instead of diffing the whole state.
+class WorldState : public Object {
+	GDCLASS(WorldState, Object);
+
+	static WorldState *singleton;
+
+public:
+	enum Flag {
+		FLAG_LOCATION_DISCOVERED,
+		FLAG_PUZZLE_COMPLETED,
+		FLAG_TRIGGER_ACTIVATED,
+		FLAG_ITEM_COLLECTED,
+		FLAG_MAX,
+	};
+
+	static constexpr int CHANGE_VARIABLE = -1;
+
+private:
+	struct Change {
+		uint64_t serial = 0;
+		int category = CHANGE_VARIABLE;
+		StringName key;
+		Variant old_value;
+		Variant new_value;
+	};
+
+	AHashMap<StringName, Variant> variables;
+
+	AHashMap<StringName, uint32_t> flag_indices;
+	LocalVector<StringName> flag_names;
+	LocalVector<uint64_t> flag_bits[FLAG_MAX];
+
+	LocalVector<Change> journal; // Ring buffer.
+	uint32_t journal_capacity = 256;
+	uint64_t journal_serial = 0;
+
+	uint32_t _intern_flag(const StringName &p_id);
+	_FORCE_INLINE_ bool _has_flag(Flag p_flag, uint32_t p_index) const {
+		const LocalVector<uint64_t> &bits = flag_bits[p_flag];
+		return (p_index >> 6) < bits.size() && (bits[p_index >> 6] & (uint64_t(1) << (p_index & 63)));
+	}
+	void _set_flag_bit(Flag p_flag, uint32_t p_index, bool p_enabled);
+	void _record(int p_category, const StringName &p_key, const Variant &p_old, const Variant &p_new);
+
+	void _compile_node(WorldStateCondition *p_condition, const Variant &p_source);
+	bool _evaluate_node(const WorldStateCondition *p_condition, uint32_t p_index) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	static WorldState *get_singleton();
+
+	void set_variable(const StringName &p_name, const Variant &p_value);
+	Variant get_variable(const StringName &p_name, const Variant &p_default = Variant()) const;
+	bool has_variable(const StringName &p_name) const;
+	void erase_variable(const StringName &p_name);
+	void increment_variable(const StringName &p_name, double p_amount = 1.0);
+	PackedStringArray get_variable_names() const;
+
+	bool set_flag(Flag p_flag, const StringName &p_id, bool p_enabled = true);
+	bool has_flag(Flag p_flag, const StringName &p_id) const;
+	PackedStringArray get_flags(Flag p_flag) const;
+	int get_flag_count(Flag p_flag) const;
+
+	Ref<WorldStateCondition> compile_condition(const Variant &p_condition);
+	bool evaluate(const Ref<WorldStateCondition> &p_condition) const;
+	bool check_condition(const Variant &p_condition);
+
+	void set_journal_capacity(int p_capacity);
+	int get_journal_capacity() const;
+	uint64_t get_journal_serial() const;
+	Array get_changes_since(uint64_t p_serial) const;
+
+	Dictionary get_state() const;
+	void set_state(const Dictionary &p_state);
+	void clear();
+
+	WorldState();
+	~WorldState();
+};
+
+VARIANT_ENUM_CAST(WorldState::Flag);
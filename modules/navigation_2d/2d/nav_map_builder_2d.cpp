@@ -51,6 +51,9 @@ PointKey NavMapBuilder2D::get_point_key(const Vector2 &p_pos, const Vector2 &p_c
 }
 
 void NavMapBuilder2D::build_navmap_iteration(NavMapIterationBuild2D &r_build) {
+	static const uint32_t memory_tag = Memory::register_tag("Navigation");
+	MemoryTagScope memory_tag_scope(memory_tag);
+
 	PerformanceData &performance_data = r_build.performance_data;
 
 	performance_data.pm_polygon_count = 0;
@@ -311,6 +311,9 @@ void NavMeshGenerator2D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
+	static const uint32_t memory_tag = Memory::register_tag("Navigation");
+	MemoryTagScope memory_tag_scope(memory_tag);
+
 	using namespace Clipper2Lib;
 	PathsD traversable_polygon_paths;
 	PathsD obstruction_polygon_paths;
@@ -540,8 +540,7 @@ void NavMap2D::step(double p_delta_time) {
 
 	if (active_avoidance_agents.size() > 0) {
 		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap2D::compute_single_avoidance_step, active_avoidance_agents.ptr(), active_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			WorkerThreadPool::get_singleton()->parallel_for(this, &NavMap2D::compute_single_avoidance_step, active_avoidance_agents.ptr(), active_avoidance_agents.size(), 0, SNAME("RVOAvoidanceAgents2D"));
 		} else {
 			for (NavAgent2D *agent : active_avoidance_agents) {
 				agent->get_rvo_agent()->computeNeighbors(&rvo_simulation);
@@ -189,6 +189,8 @@ void NavRegion2D::update_polygons() {
 	if (!polygons_dirty) {
 		return;
 	}
+	static const uint32_t memory_tag = Memory::register_tag("Navigation");
+	MemoryTagScope memory_tag_scope(memory_tag);
 	navmesh_polygons.clear();
 	surface_area = 0.0;
 	bounds = Rect2();
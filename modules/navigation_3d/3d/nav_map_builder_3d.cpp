@@ -52,6 +52,9 @@ PointKey NavMapBuilder3D::get_point_key(const Vector3 &p_pos, const Vector3 &p_c
 }
 
 void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
+	static const uint32_t memory_tag = Memory::register_tag("Navigation");
+	MemoryTagScope memory_tag_scope(memory_tag);
+
 	PerformanceData &performance_data = r_build.performance_data;
 
 	performance_data.pm_polygon_count = 0;
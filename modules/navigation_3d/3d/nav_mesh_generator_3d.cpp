@@ -274,6 +274,9 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
+	static const uint32_t memory_tag = Memory::register_tag("Navigation");
+	MemoryTagScope memory_tag_scope(memory_tag);
+
 	Vector<float> source_geometry_vertices;
 	Vector<int> source_geometry_indices;
 	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
@@ -621,10 +621,17 @@ void NavMap3D::step(double p_delta_time) {
 	rvo_simulation_2d.setTimeStep(float(p_delta_time));
 	rvo_simulation_3d.setTimeStep(float(p_delta_time));
 
+	bool use_pool = use_threads && avoidance_use_multiple_threads;
+
+	// Agents avoid each other either in 2D or in 3D, so both simulations can run at the same time.
+	WorkerThreadPool::GroupID group_task_3d = WorkerThreadPool::INVALID_TASK_ID;
+	if (active_3d_avoidance_agents.size() > 0 && use_pool) {
+		group_task_3d = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
+	}
+
 	if (active_2d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		if (use_pool) {
+			WorkerThreadPool::get_singleton()->parallel_for(this, &NavMap3D::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), 0, SNAME("RVOAvoidanceAgents2D"));
 		} else {
 			for (NavAgent3D *agent : active_2d_avoidance_agents) {
 				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
@@ -636,9 +643,8 @@ void NavMap3D::step(double p_delta_time) {
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		if (use_pool) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task_3d);
 		} else {
 			for (NavAgent3D *agent : active_3d_avoidance_agents) {
 				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
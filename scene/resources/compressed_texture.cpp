@@ -126,6 +126,9 @@ Image::Format CompressedTexture2D::get_format() const {
 }
 
 Error CompressedTexture2D::load(const String &p_path) {
+	static const uint32_t memory_tag = Memory::register_tag("Textures");
+	MemoryTagScope memory_tag_scope(memory_tag);
+
 	int lw, lh;
 	Ref<Image> image;
 	image.instantiate();
@@ -548,6 +551,9 @@ Error CompressedTexture3D::_load_data(const String &p_path, Vector<Ref<Image>> &
 }
 
 Error CompressedTexture3D::load(const String &p_path) {
+	static const uint32_t memory_tag = Memory::register_tag("Textures");
+	MemoryTagScope memory_tag_scope(memory_tag);
+
 	Vector<Ref<Image>> data;
 
 	int tw, th, td;
@@ -737,6 +743,9 @@ Error CompressedTextureLayered::_load_data(const String &p_path, Vector<Ref<Imag
 }
 
 Error CompressedTextureLayered::load(const String &p_path) {
+	static const uint32_t memory_tag = Memory::register_tag("Textures");
+	MemoryTagScope memory_tag_scope(memory_tag);
+
 	Vector<Ref<Image>> images;
 
 	int mipmap_limit;
@@ -89,11 +89,16 @@ void ImageTexture::set_image(const Ref<Image> &p_image) {
 	format = p_image->get_format();
 	mipmaps = p_image->has_mipmaps();
 
-	if (texture.is_null()) {
-		texture = RenderingServer::get_singleton()->texture_2d_create(p_image);
-	} else {
-		RID new_texture = RenderingServer::get_singleton()->texture_2d_create(p_image);
-		RenderingServer::get_singleton()->texture_replace(texture, new_texture);
+	{
+		// Not around the signals, which may run anything.
+		static const uint32_t memory_tag = Memory::register_tag("Textures");
+		MemoryTagScope memory_tag_scope(memory_tag);
+		if (texture.is_null()) {
+			texture = RenderingServer::get_singleton()->texture_2d_create(p_image);
+		} else {
+			RID new_texture = RenderingServer::get_singleton()->texture_2d_create(p_image);
+			RenderingServer::get_singleton()->texture_replace(texture, new_texture);
+		}
 	}
 	notify_property_list_changed();
 	emit_changed();
@@ -115,7 +120,11 @@ void ImageTexture::update(const Ref<Image> &p_image) {
 	ERR_FAIL_COND_MSG(mipmaps != p_image->has_mipmaps(),
 			"The new image mipmaps configuration must match the texture's image mipmaps configuration");
 
-	RS::get_singleton()->texture_2d_update(texture, p_image);
+	{
+		static const uint32_t memory_tag = Memory::register_tag("Textures");
+		MemoryTagScope memory_tag_scope(memory_tag);
+		RS::get_singleton()->texture_2d_update(texture, p_image);
+	}
 
 	notify_property_list_changed();
 	emit_changed();
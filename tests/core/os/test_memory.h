@@ -0,0 +1,323 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/heap_profiler.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/os/small_allocator.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+TEST_CASE("[Memory] Allocation tags") {
+	const uint32_t tag = Memory::register_tag("Test");
+	CHECK_MESSAGE(
+			Memory::register_tag("Test") == tag,
+			"Registering a tag again should return the same tag.");
+	CHECK(String(Memory::get_tag_name(tag)) == "Test");
+	CHECK(Memory::get_thread_tag() == 0);
+
+	const uint64_t tag_usage = Memory::get_tag_usage(tag);
+	void *mem = nullptr;
+	{
+		MemoryTagScope scope(tag);
+		CHECK(Memory::get_thread_tag() == tag);
+		mem = memalloc(100);
+	}
+	CHECK_MESSAGE(
+			Memory::get_thread_tag() == 0,
+			"The previous tag should be restored when the scope ends.");
+
+#ifdef MEMORY_USAGE_ENABLED
+	CHECK(Memory::get_tag_usage(tag) == tag_usage + 100);
+	mem = memrealloc(mem, 3000);
+	CHECK_MESSAGE(
+			Memory::get_tag_usage(tag) == tag_usage + 3000,
+			"Reallocating should keep the tag of the allocation, even outside of the scope.");
+	memfree(mem);
+	CHECK(Memory::get_tag_usage(tag) == tag_usage);
+#else
+	memfree(mem);
+#endif
+}
+
+#ifdef MEMORY_USAGE_ENABLED
+TEST_CASE("[Memory] Array and Dictionary storage is tagged") {
+	const uint32_t arrays_tag = Memory::register_tag("Arrays");
+	const uint32_t dictionaries_tag = Memory::register_tag("Dictionaries");
+	const uint64_t arrays_usage = Memory::get_tag_usage(arrays_tag);
+	const uint64_t dictionaries_usage = Memory::get_tag_usage(dictionaries_tag);
+
+	Array array;
+	array.resize(100);
+	Dictionary dictionary;
+	dictionary[1] = 2;
+	CHECK(Memory::get_tag_usage(arrays_tag) >= arrays_usage + 100 * sizeof(Variant));
+	CHECK(Memory::get_tag_usage(dictionaries_tag) > dictionaries_usage);
+
+	array.clear();
+	CHECK(Memory::get_tag_usage(arrays_tag) == arrays_usage);
+}
+#endif
+
+static SafeNumeric<uint32_t> task_tag;
+
+static void record_task_tag() {
+	task_tag.set(Memory::get_thread_tag());
+}
+
+TEST_CASE("[Memory] Tag stack") {
+	const uint32_t outer = Memory::register_tag("TestOuter");
+	const uint32_t inner = Memory::register_tag("TestInner");
+	{
+		MemoryTagScope outer_scope(outer);
+		MemoryTagScope inner_scope(inner);
+		CHECK(Memory::get_thread_tag() == inner);
+
+		uint32_t tags[Memory::MAX_TAG_DEPTH];
+		REQUIRE(Memory::get_thread_tag_stack(tags, Memory::MAX_TAG_DEPTH) == 2);
+		CHECK(tags[0] == outer);
+		CHECK(tags[1] == inner);
+		REQUIRE(Memory::get_thread_tag_stack(tags, 1) == 1);
+		CHECK_MESSAGE(
+				tags[0] == inner,
+				"The innermost tags should be kept when the stack doesn't fit.");
+
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_task(callable_mp_static(&record_task_tag));
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		CHECK_MESSAGE(
+				task_tag.get() == inner,
+				"Tasks should run with the tag of the code that added them.");
+	}
+	CHECK(Memory::get_thread_tag() == 0);
+}
+
+TEST_CASE("[HeapProfiler] Snapshot diff and serialization") {
+	HeapProfiler::Snapshot base;
+	base.usage = 1000;
+	base.sites.push_back({ "A", 600, 2 });
+	base.sites.push_back({ "B", 400, 1 });
+
+	HeapProfiler::Snapshot snapshot;
+	snapshot.usage = 1500;
+	snapshot.sites.push_back({ "A", 600, 2 });
+	snapshot.sites.push_back({ "C", 900, 3 });
+
+	const HeapProfiler::Snapshot diff = snapshot.diff(base);
+	CHECK(diff.usage == 500);
+	REQUIRE_MESSAGE(
+			diff.sites.size() == 2,
+			"Unchanged sites should be left out.");
+	CHECK(diff.sites[0].name == "C");
+	CHECK(diff.sites[0].bytes == 900);
+	CHECK(diff.sites[1].name == "B");
+	CHECK_MESSAGE(
+			diff.sites[1].bytes == -400,
+			"Sites which are gone should be negative.");
+
+	HeapProfiler::Snapshot deserialized;
+	REQUIRE(deserialized.deserialize(snapshot.serialize()));
+	CHECK(deserialized.usage == 1500);
+	REQUIRE(deserialized.sites.size() == 2);
+	CHECK(deserialized.sites[1].name == "C");
+	CHECK(deserialized.sites[1].bytes == 900);
+	CHECK(deserialized.sites[1].count == 3);
+}
+
+#ifdef MEMORY_USAGE_ENABLED
+static int64_t get_site_bytes(const HeapProfiler::Snapshot &p_snapshot, const String &p_name) {
+	for (const HeapProfiler::Snapshot::Entry &E : p_snapshot.sites) {
+		if (E.name == p_name) {
+			return E.bytes;
+		}
+	}
+	return 0;
+}
+
+TEST_CASE("[HeapProfiler] Sample allocations") {
+	const uint32_t tag = Memory::register_tag("TestHeapProfiler");
+	HeapProfiler::set_sampling(true, 1024);
+
+	// Larger than the interval, so all of them are sampled.
+	const int count = 64;
+	void *blocks[count];
+	{
+		MemoryTagScope scope(tag);
+		for (int i = 0; i < count; i++) {
+			blocks[i] = memalloc(4096);
+		}
+		blocks[0] = memrealloc(blocks[0], 8192);
+	}
+
+	const HeapProfiler::Snapshot snapshot = HeapProfiler::take_snapshot();
+	CHECK_MESSAGE(
+			get_site_bytes(snapshot, "TestHeapProfiler") == count * 4096 + 4096,
+			"Samples should follow reallocated blocks.");
+
+	for (int i = 0; i < count; i++) {
+		memfree(blocks[i]);
+	}
+
+	const HeapProfiler::Snapshot diff = HeapProfiler::take_snapshot().diff(snapshot);
+	CHECK_MESSAGE(
+			get_site_bytes(diff, "TestHeapProfiler") == -(count * 4096 + 4096),
+			"Freed blocks should no longer be sampled.");
+
+	HeapProfiler::set_sampling(false);
+}
+#endif
+
+TEST_CASE("[SmallAllocator] Allocate and free blocks") {
+	LocalVector<uint8_t *> blocks;
+	for (uint32_t i = 1; i <= SmallAllocator::MAX_SIZE; i += 7) {
+		uint8_t *block = (uint8_t *)SmallAllocator::alloc(i);
+		REQUIRE(block != nullptr);
+		CHECK(SmallAllocator::get_block_size(i) >= i);
+		CHECK(((uintptr_t)block % 16) == 0);
+		memset(block, (uint8_t)i, i);
+		blocks.push_back(block);
+	}
+
+	bool intact = true;
+	uint32_t size = 1;
+	for (uint8_t *block : blocks) {
+		// Reduce number of check messages.
+		intact &= block[0] == (uint8_t)size && block[size - 1] == (uint8_t)size;
+		SmallAllocator::free(block, size);
+		size += 7;
+	}
+	CHECK_MESSAGE(intact, "Blocks should not overlap.");
+
+	void *block = SmallAllocator::alloc(64);
+	SmallAllocator::free(block, 64);
+	CHECK_MESSAGE(
+			SmallAllocator::alloc(64) == block,
+			"The last freed block should be reused first.");
+	SmallAllocator::free(block, 64);
+}
+
+static LocalVector<void *> shared_blocks;
+
+static void free_block_task(uint32_t p_index) {
+	SmallAllocator::free(shared_blocks[p_index], 48);
+}
+
+TEST_CASE("[SmallAllocator] Free blocks from other threads") {
+	const uint32_t count = 4096;
+	shared_blocks.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		shared_blocks[i] = SmallAllocator::alloc(48);
+	}
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_group_task(callable_mp_static(free_block_task), count, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	// Blocks given back by the workers are handed out again here.
+	bool all_valid = true;
+	for (uint32_t i = 0; i < count; i++) {
+		shared_blocks[i] = SmallAllocator::alloc(48);
+		all_valid &= shared_blocks[i] != nullptr;
+	}
+	CHECK(all_valid);
+	for (uint32_t i = 0; i < count; i++) {
+		SmallAllocator::free(shared_blocks[i], 48);
+	}
+	shared_blocks.clear();
+}
+
+#ifdef SMALL_ALLOCATOR_ENABLED
+TEST_CASE("[Memory] Switch the small allocator with blocks alive") {
+	uint8_t *small_block = (uint8_t *)memalloc(64);
+	uint8_t *moved_block = (uint8_t *)memalloc(64);
+	memset(small_block, 1, 64);
+	memset(moved_block, 2, 64);
+
+	Memory::set_small_allocator_enabled(false);
+	CHECK_FALSE(Memory::is_small_allocator_enabled());
+	uint8_t *system_block = (uint8_t *)memalloc(64);
+	memset(system_block, 3, 64);
+	// Leaves the small allocator, as it is now off.
+	moved_block = (uint8_t *)memrealloc(moved_block, 80);
+	Memory::set_small_allocator_enabled(true);
+
+	// Moves into the small allocator.
+	system_block = (uint8_t *)memrealloc(system_block, 72);
+	CHECK(small_block[63] == 1);
+	CHECK(moved_block[0] == 2);
+	CHECK(moved_block[63] == 2);
+	CHECK(system_block[0] == 3);
+	CHECK(system_block[63] == 3);
+
+	// Each block must go back where it came from, whatever the current setting.
+	memfree(small_block);
+	Memory::set_small_allocator_enabled(false);
+	memfree(moved_block);
+	memfree(system_block);
+	Memory::set_small_allocator_enabled(true);
+}
+
+static uint64_t time_alloc_static(uint32_t p_rounds, LocalVector<void *> &r_blocks) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t round = 0; round < p_rounds; round++) {
+		for (uint32_t i = 0; i < r_blocks.size(); i++) {
+			r_blocks[i] = Memory::alloc_static(16 + (i % 64) * 16);
+		}
+		for (uint32_t i = 0; i < r_blocks.size(); i++) {
+			Memory::free_static(r_blocks[i]);
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// Only reports timings, so it only runs with `--no-skip`.
+TEST_CASE("[Memory] Benchmark alloc_static with and without the small allocator" * doctest::skip(true)) {
+	const uint32_t rounds = 200;
+	LocalVector<void *> blocks;
+	blocks.resize(1000);
+
+	// Both go through the allocation header and usage stats, only the block source differs.
+	const uint64_t small_allocator_usec = time_alloc_static(rounds, blocks);
+	Memory::set_small_allocator_enabled(false);
+	const uint64_t system_usec = time_alloc_static(rounds, blocks);
+	Memory::set_small_allocator_enabled(true);
+
+	// Timings depend too much on the machine to be checked, they are only reported.
+	MESSAGE(vformat("%d alloc_static and free_static calls: small allocator %d usec, without it %d usec.", rounds * blocks.size(), small_allocator_usec, system_usec));
+	CHECK(SmallAllocator::get_reserved_bytes() > 0);
+}
+#endif // SMALL_ALLOCATOR_ENABLED
+
+} // namespace TestMemory
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning and search") {
+	const String name = "test_string_name_interning";
+	CHECK_MESSAGE(
+			StringName::search(name) == StringName(),
+			"A name that was never interned should not be found.");
+
+	{
+		const StringName from_string = StringName(name);
+		const StringName from_cstring = StringName("test_string_name_interning");
+		CHECK_MESSAGE(
+				from_string.data_unique_pointer() == from_cstring.data_unique_pointer(),
+				"Equal names should share the same interned data.");
+		CHECK_MESSAGE(
+				StringName::search(name).data_unique_pointer() == from_string.data_unique_pointer(),
+				"Search should return the interned data.");
+		CHECK_MESSAGE(
+				StringName::search(U"test_string_name_interning") == from_string,
+				"Search with a wide string should return the interned data.");
+	}
+
+	CHECK_MESSAGE(
+			StringName::search(name) == StringName(),
+			"The name should be removed from the table once the last reference is released.");
+}
+
+static LocalVector<StringName> interned;
+static SafeFlag lookup_failed;
+
+static void intern_task(uint32_t p_index) {
+	// Transient names are created and released while other threads look up the shared ones,
+	// so chains get modified under lock-free readers.
+	for (int i = 0; i < 8; i++) {
+		const StringName transient = StringName("test_string_name_transient_" + itos(p_index) + "_" + itos(i));
+		if (StringName::search(transient) != transient) {
+			lookup_failed.set();
+		}
+	}
+	interned[p_index] = StringName("test_string_name_shared_" + itos(p_index % 16));
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	const uint32_t count = 512;
+	interned.clear();
+	interned.resize(count);
+	lookup_failed.clear();
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_group_task(callable_mp_static(intern_task), count, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_shared = true;
+	for (uint32_t i = 0; i < count; i++) {
+		// Reduce number of check messages.
+		all_shared &= interned[i].data_unique_pointer() == interned[i % 16].data_unique_pointer();
+		all_shared &= interned[i] == "test_string_name_shared_" + itos(i % 16);
+	}
+	CHECK_MESSAGE(!lookup_failed.is_set(), "Names should be found while other threads modify the table.");
+	CHECK_MESSAGE(all_shared, "Names interned from several threads should share the same data.");
+
+	bool transient_released = true;
+	for (uint32_t i = 0; i < count; i++) {
+		transient_released &= StringName::search("test_string_name_transient_" + itos(i) + "_0") == StringName();
+	}
+	CHECK_MESSAGE(transient_released, "Transient names should be released once unreferenced.");
+
+	interned.clear();
+}
+
+} // namespace TestStringName
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  test_work_stealing_queue.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/work_stealing_queue.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingQueue {
+
+TEST_CASE("[WorkStealingQueue] Push, pop and steal") {
+	WorkStealingQueue<int, 4> queue;
+	int value = 0;
+	CHECK(queue.is_empty());
+	CHECK_FALSE(queue.pop(value));
+	CHECK_FALSE(queue.steal(value));
+
+	for (int i = 1; i <= 4; i++) {
+		CHECK(queue.push(i));
+	}
+	CHECK_MESSAGE(
+			!queue.push(5),
+			"Pushing to a full queue should fail.");
+
+	CHECK(queue.pop(value));
+	CHECK_MESSAGE(value == 4, "Popping should return the newest element.");
+	CHECK(queue.steal(value));
+	CHECK_MESSAGE(value == 1, "Stealing should return the oldest element.");
+	CHECK(queue.push(5));
+	CHECK(queue.push(6));
+
+	LocalVector<int> remaining;
+	while (queue.pop(value)) {
+		remaining.push_back(value);
+	}
+	REQUIRE(remaining.size() == 4);
+	CHECK(remaining[0] == 6);
+	CHECK(remaining[1] == 5);
+	CHECK(remaining[2] == 3);
+	CHECK(remaining[3] == 2);
+	CHECK(queue.is_empty());
+}
+
+static const uint32_t ELEMENT_COUNT = 200000;
+static WorkStealingQueue<uint32_t, 64> *shared_queue = nullptr;
+static LocalVector<SafeNumeric<uint32_t>> taken;
+static SafeFlag pushing_done;
+
+static void steal_elements(uint32_t p_index) {
+	uint32_t value = 0;
+	while (!pushing_done.is_set() || !shared_queue->is_empty()) {
+		if (shared_queue->steal(value)) {
+			taken[value].increment();
+		}
+	}
+}
+
+TEST_CASE("[WorkStealingQueue] Steal concurrently with the owner") {
+	WorkStealingQueue<uint32_t, 64> queue;
+	shared_queue = &queue;
+	taken.clear();
+	taken.resize(ELEMENT_COUNT);
+	pushing_done.clear();
+
+	const int thieves = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count() - 1);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_group_task(callable_mp_static(&steal_elements), thieves, thieves, true);
+
+	uint32_t value = 0;
+	uint32_t next = 0;
+	while (next < ELEMENT_COUNT) {
+		if (queue.push(next)) {
+			next++;
+		}
+		// The owner takes some back too, so pops race with steals for the last element.
+		if (next % 3 == 0 && queue.pop(value)) {
+			taken[value].increment();
+		}
+	}
+	while (queue.pop(value)) {
+		taken[value].increment();
+	}
+	pushing_done.set();
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_taken_once = true;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		// Reduce number of check messages.
+		all_taken_once &= taken[i].get() == 1;
+	}
+	CHECK_MESSAGE(all_taken_once, "Every element should have been taken exactly once.");
+	shared_queue = nullptr;
+}
+
+} // namespace TestWorkStealingQueue
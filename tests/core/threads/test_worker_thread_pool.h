@@ -172,4 +172,267 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_nested_task(void *p_arg) {
+	counter[(uintptr_t)p_arg].increment();
+}
+
+static const int NESTED_TASKS = 16;
+
+static void static_spawning_task(void *p_arg) {
+	WorkerThreadPool::TaskID task_ids[NESTED_TASKS];
+	for (int i = 0; i < NESTED_TASKS; i++) {
+		task_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_task, (void *)((uintptr_t)p_arg * NESTED_TASKS + i), true);
+	}
+	for (int i = 0; i < NESTED_TASKS; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_ids[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks added from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = WorkerThreadPool::get_singleton()->get_thread_count() * 2;
+
+		counter.clear();
+		counter.resize(count * NESTED_TASKS);
+		LocalVector<WorkerThreadPool::TaskID> task_ids;
+		for (int i = 0; i < count; i++) {
+			task_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_spawning_task, (void *)(uintptr_t)i, true));
+		}
+		for (WorkerThreadPool::TaskID task_id : task_ids) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+		}
+
+		bool all_run_once = true;
+		for (int i = 0; i < count * NESTED_TASKS; i++) {
+			// Reduce number of check messages.
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+static void static_nested_group_element(void *p_arg, uint32_t p_index) {
+	counter[(uintptr_t)p_arg * NESTED_TASKS + p_index].increment();
+}
+
+static void static_spawning_group_task(void *p_arg) {
+	WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_group_element, p_arg, NESTED_TASKS, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+}
+
+TEST_CASE("[WorkerThreadPool] Run groups added from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = WorkerThreadPool::get_singleton()->get_thread_count() * 2;
+
+		counter.clear();
+		counter.resize(count * NESTED_TASKS);
+		LocalVector<WorkerThreadPool::TaskID> task_ids;
+		for (int i = 0; i < count; i++) {
+			task_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_spawning_group_task, (void *)(uintptr_t)i, true));
+		}
+		for (WorkerThreadPool::TaskID task_id : task_ids) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+		}
+
+		bool all_run_once = true;
+		for (int i = 0; i < count * NESTED_TASKS; i++) {
+			// Reduce number of check messages.
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+static void static_single_element_group(void *p_arg, uint32_t p_index) {
+	counter[(uintptr_t)p_arg].increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Keep more groups pending than are added lock-free") {
+	// Groups whose slot is taken by one not waited for yet are added with the lock instead.
+	const int count = 1000;
+
+	counter.clear();
+	counter.resize(count);
+	LocalVector<WorkerThreadPool::GroupID> group_ids;
+	for (int i = 0; i < count; i++) {
+		group_ids.push_back(WorkerThreadPool::get_singleton()->add_native_group_task(static_single_element_group, (void *)(uintptr_t)i, 1, 1, true));
+	}
+	for (WorkerThreadPool::GroupID group_id : group_ids) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	}
+
+	bool all_run_once = true;
+	for (int i = 0; i < count; i++) {
+		// Reduce number of check messages.
+		all_run_once &= counter[i].get() == 1;
+	}
+	CHECK(all_run_once);
+}
+
+static const int STAGE_ELEMENTS = 64;
+
+static void static_first_stage(void *p_arg) {
+	OS::get_singleton()->delay_usec(1000); // Give time for the other stages to be added before this one completes.
+	counter[0].increment();
+}
+
+static void static_group_stage(void *p_arg, uint32_t p_index) {
+	if (counter[0].get() == 1) {
+		counter[1].increment();
+	}
+}
+
+static void static_join_stage(void *p_arg) {
+	if (counter[0].get() == 1 && counter[1].get() == STAGE_ELEMENTS) {
+		counter[2].increment();
+	}
+}
+
+static void static_last_stage(void *p_arg) {
+	if (counter[2].get() == 1) {
+		counter[3].increment();
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Chain tasks and groups with dependencies") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	for (int iterations = 0; iterations < 50; iterations++) {
+		counter.clear();
+		counter.resize(4);
+
+		WorkerThreadPool::TaskID first = pool->add_native_task(static_first_stage, nullptr, true);
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_group_stage, nullptr, STAGE_ELEMENTS, -1, true, String(), Span(&first, 1));
+		const WorkerThreadPool::TaskID join_dependencies[] = { first, group };
+		WorkerThreadPool::TaskID join = pool->add_native_task(static_join_stage, nullptr, iterations % 2 == 0, String(), join_dependencies);
+		// Empty groups with dependencies only complete after them too.
+		WorkerThreadPool::GroupID empty_group = pool->add_native_group_task(static_group_stage, nullptr, 0, -1, true, String(), Span(&join, 1));
+		WorkerThreadPool::TaskID last = pool->add_native_task(static_last_stage, nullptr, true, String(), Span(&empty_group, 1));
+
+		pool->wait_for_task_completion(last);
+		pool->wait_for_group_task_completion(empty_group);
+		pool->wait_for_task_completion(join);
+		pool->wait_for_group_task_completion(group);
+		pool->wait_for_task_completion(first);
+
+		CHECK_MESSAGE(counter[3].get() == 1,
+				"Every stage should run after the ones it depends on.");
+	}
+
+	// Depending on something already complete doesn't delay anything.
+	counter.clear();
+	counter.resize(4);
+	counter[2].set(1);
+	WorkerThreadPool::TaskID done = pool->add_native_task(static_test, nullptr, true);
+	while (!pool->is_task_completed(done)) {
+		OS::get_singleton()->delay_usec(100);
+	}
+	WorkerThreadPool::TaskID last = pool->add_native_task(static_last_stage, nullptr, true, String(), Span(&done, 1));
+	pool->wait_for_task_completion(last);
+	pool->wait_for_task_completion(done);
+	CHECK(counter[3].get() == 1);
+
+	// Nor does depending on something already waited for.
+	last = pool->add_native_task(static_last_stage, nullptr, true, String(), Span(&done, 1));
+	pool->wait_for_task_completion(last);
+	CHECK(counter[3].get() == 2);
+}
+
+struct ParallelForTest {
+	LocalVector<SafeNumeric<uint32_t>> processed;
+
+	void process(uint32_t p_index, uint32_t p_amount) {
+		processed[p_index].add(p_amount);
+	}
+
+	void process_nested(uint32_t p_index, uint32_t p_elements) {
+		WorkerThreadPool::get_singleton()->parallel_for(this, &ParallelForTest::process, 1u, p_elements);
+	}
+
+	bool all_processed(uint32_t p_amount) const {
+		for (const SafeNumeric<uint32_t> &amount : processed) {
+			if (amount.get() != p_amount) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Parallel for") {
+	const uint32_t element_counts[] = { 0, 1, 3, 100, 4096, 100003 };
+	const uint32_t grain_sizes[] = { 0, 1, 7, 1000, 200000 };
+
+	for (uint32_t elements : element_counts) {
+		for (uint32_t grain_size : grain_sizes) {
+			ParallelForTest test;
+			test.processed.resize(elements);
+			WorkerThreadPool::get_singleton()->parallel_for(&test, &ParallelForTest::process, 1u, elements, grain_size);
+			CHECK_MESSAGE(test.all_processed(1),
+					vformat("Each of %d elements should be processed once, with grain size %d.", elements, grain_size));
+		}
+	}
+
+	// Pool threads can run their own, processing the elements of all of them.
+	const uint32_t elements = 1000;
+	ParallelForTest test;
+	test.processed.resize(elements);
+	const uint32_t nested = WorkerThreadPool::get_singleton()->get_thread_count() * 2;
+	WorkerThreadPool::get_singleton()->parallel_for(&test, &ParallelForTest::process_nested, elements, nested, 1);
+	CHECK_MESSAGE(test.all_processed(nested),
+			"Each element should be processed once by every nested loop.");
+}
+
+static void static_small_group_task(void *p_arg, uint32_t p_index) {
+	counter[0].increment();
+}
+
+struct SmallParallelForTest {
+	void process(uint32_t p_index, void *p_userdata) {
+		counter[1].increment();
+	}
+};
+
+// Only reports timings, so it only runs with `--no-skip`.
+TEST_CASE("[WorkerThreadPool] Benchmark small tasks" * doctest::skip(true)) {
+	const int groups = 2000;
+	const int elements = 64;
+	counter.clear();
+	counter.resize(NESTED_TASKS * WorkerThreadPool::get_singleton()->get_thread_count());
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < groups; i++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_small_group_task, nullptr, elements, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	const uint64_t group_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(counter[0].get() == groups * elements);
+
+	SmallParallelForTest parallel_for_test;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < groups; i++) {
+		WorkerThreadPool::get_singleton()->parallel_for(&parallel_for_test, &SmallParallelForTest::process, nullptr, elements);
+	}
+	const uint64_t parallel_for_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(counter[1].get() == groups * elements);
+
+	const int rounds = 200;
+	const int spawning = WorkerThreadPool::get_singleton()->get_thread_count();
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	task_ids.resize(spawning);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int round = 0; round < rounds; round++) {
+		for (int i = 0; i < spawning; i++) {
+			task_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_spawning_task, (void *)(uintptr_t)i, true);
+		}
+		for (int i = 0; i < spawning; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task_ids[i]);
+		}
+	}
+	const uint64_t nested_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// Timings depend too much on the machine to be checked, they are only reported.
+	MESSAGE(vformat("%d group tasks of %d elements: %d usec. Same with parallel_for: %d usec. %d tasks added from pool threads: %d usec.", groups, elements, group_usec, parallel_for_usec, rounds * spawning * NESTED_TASKS, nested_usec));
+}
+
 } // namespace TestWorkerThreadPool